@@ -61,6 +61,7 @@
 #define DEFAULT_DEVICE		"default"
 #define DEFAULT_DEVICE_NAME	""
 #define DEFAULT_CARD_NAME	""
+#define DEFAULT_USE_MMAP	FALSE
 #define SPDIF_PERIOD_SIZE 1536
 #define SPDIF_BUFFER_SIZE 15360
 
@@ -70,6 +71,7 @@ enum
   PROP_DEVICE,
   PROP_DEVICE_NAME,
   PROP_CARD_NAME,
+  PROP_USE_MMAP,
   PROP_LAST
 };
 
@@ -198,6 +200,21 @@ gst_alsasink_class_init (GstAlsaSinkClass * klass)
       g_param_spec_string ("card-name", "Card name",
           "Human-readable name of the sound card", DEFAULT_CARD_NAME,
           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAlsaSink:use-mmap:
+   *
+   * Write samples into the device's mmap'ed sample buffer instead of going
+   * through snd_pcm_writei(), which saves a trip through the kernel for
+   * every period. Silently falls back to read/write transfers when the
+   * device cannot be mmap'ed.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_USE_MMAP,
+      g_param_spec_boolean ("use-mmap", "Use mmap",
+          "Write samples into the device's mmap'ed buffer when supported",
+          DEFAULT_USE_MMAP, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -217,6 +234,9 @@ gst_alsasink_set_property (GObject * object, guint prop_id,
         sink->device = g_strdup (DEFAULT_DEVICE);
       }
       break;
+    case PROP_USE_MMAP:
+      sink->use_mmap = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -245,6 +265,9 @@ gst_alsasink_get_property (GObject * object, guint prop_id,
           gst_alsa_find_card_name (GST_OBJECT_CAST (sink),
               sink->device, SND_PCM_STREAM_PLAYBACK));
       break;
+    case PROP_USE_MMAP:
+      g_value_set_boolean (value, sink->use_mmap);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -259,6 +282,7 @@ gst_alsasink_init (GstAlsaSink * alsasink)
   alsasink->device = g_strdup (DEFAULT_DEVICE);
   alsasink->handle = NULL;
   alsasink->cached_caps = NULL;
+  alsasink->use_mmap = DEFAULT_USE_MMAP;
   g_mutex_init (&alsasink->alsa_lock);
   g_mutex_init (&alsasink->delay_lock);
 
@@ -444,8 +468,15 @@ retry:
   /* choose all parameters */
   CHECK (snd_pcm_hw_params_any (alsa->handle, params), no_config);
   /* set the interleaved read/write format */
-  CHECK (snd_pcm_hw_params_set_access (alsa->handle, params, alsa->access),
-      wrong_access);
+  if ((err = snd_pcm_hw_params_set_access (alsa->handle, params,
+              alsa->access)) < 0 &&
+      alsa->access == SND_PCM_ACCESS_MMAP_INTERLEAVED) {
+    GST_DEBUG_OBJECT (alsa,
+        "mmap access not supported, falling back to read/write transfers");
+    alsa->access = SND_PCM_ACCESS_RW_INTERLEAVED;
+    err = snd_pcm_hw_params_set_access (alsa->handle, params, alsa->access);
+  }
+  CHECK (err, wrong_access);
   /* set the sample format */
   if (alsa->iec958) {
     /* Try to use big endian first else fallback to le and swap bytes */
@@ -819,7 +850,10 @@ alsasink_parse_spec (GstAlsaSink * alsa, GstAudioRingBufferSpec * spec)
   alsa->channels = GST_AUDIO_INFO_CHANNELS (&spec->info);
   alsa->buffer_time = spec->buffer_time;
   alsa->period_time = spec->latency_time;
-  alsa->access = SND_PCM_ACCESS_RW_INTERLEAVED;
+  if (alsa->use_mmap)
+    alsa->access = SND_PCM_ACCESS_MMAP_INTERLEAVED;
+  else
+    alsa->access = SND_PCM_ACCESS_RW_INTERLEAVED;
 
   if (spec->type == GST_AUDIO_RING_BUFFER_FORMAT_TYPE_RAW && alsa->channels < 9)
     gst_audio_ring_buffer_set_channel_positions (GST_AUDIO_BASE_SINK
@@ -1008,6 +1042,60 @@ xrun_recovery (GstAlsaSink * alsa, snd_pcm_t * handle, gint err)
   return err;
 }
 
+/* Copy samples straight into the device's mmap'ed sample buffer; committing
+ * only moves the application pointer, so the samples are not copied again
+ * by the kernel on their way to the DMA area. Returns the number of frames
+ * written or a negative error code, like snd_pcm_writei(). Must be called
+ * with the delay lock held. */
+static gint
+gst_alsasink_mmap_write (GstAlsaSink * alsa, guint8 * ptr, gint cptr)
+{
+  const snd_pcm_channel_area_t *areas;
+  snd_pcm_uframes_t offset, frames;
+  snd_pcm_sframes_t avail, committed;
+  gint err;
+
+  avail = snd_pcm_avail_update (alsa->handle);
+  if (avail < 0)
+    return avail;
+  if (avail == 0)
+    return -EAGAIN;
+
+  frames = MIN ((snd_pcm_uframes_t) avail, (snd_pcm_uframes_t) cptr);
+
+  if ((err = snd_pcm_mmap_begin (alsa->handle, &areas, &offset, &frames)) < 0)
+    return err;
+  if (frames == 0) {
+    snd_pcm_mmap_commit (alsa->handle, offset, 0);
+    return -EAGAIN;
+  }
+
+  /* with interleaved access all channels live in one contiguous area */
+  memcpy (((guint8 *) areas[0].addr) + (areas[0].first / 8) +
+      offset * alsa->bpf, ptr, frames * alsa->bpf);
+
+  committed = snd_pcm_mmap_commit (alsa->handle, offset, frames);
+  if (committed < 0)
+    return committed;
+
+  /* unlike the read/write transfer functions, committing mmap'ed samples
+   * does not start the device when the start threshold is reached, so
+   * apply the threshold configured in set_swparams() ourselves */
+  if (snd_pcm_state (alsa->handle) == SND_PCM_STATE_PREPARED) {
+    snd_pcm_uframes_t threshold =
+        (alsa->buffer_size / alsa->period_size) * alsa->period_size;
+
+    avail = snd_pcm_avail_update (alsa->handle);
+    if (avail >= 0 &&
+        alsa->buffer_size - (snd_pcm_uframes_t) avail >= threshold) {
+      if ((err = snd_pcm_start (alsa->handle)) < 0)
+        return err;
+    }
+  }
+
+  return committed;
+}
+
 static gint
 gst_alsasink_write (GstAudioSink * asink, gpointer data, guint length)
 {
@@ -1041,7 +1129,10 @@ gst_alsasink_write (GstAudioSink * asink, gpointer data, guint length)
       GST_DEBUG_OBJECT (asink, "wait error, %d", err);
     } else {
       GST_DELAY_SINK_LOCK (asink);
-      err = snd_pcm_writei (alsa->handle, ptr, cptr);
+      if (alsa->access == SND_PCM_ACCESS_MMAP_INTERLEAVED)
+        err = gst_alsasink_mmap_write (alsa, ptr, cptr);
+      else
+        err = snd_pcm_writei (alsa->handle, ptr, cptr);
       GST_DELAY_SINK_UNLOCK (asink);
     }
 
@@ -1148,30 +1239,11 @@ gst_alsasink_payload (GstAudioBaseSink * sink, GstBuffer * buf)
   alsa = GST_ALSA_SINK (sink);
 
   if (alsa->iec958) {
-    GstBuffer *out;
-    gint framesize;
-    GstMapInfo iinfo, oinfo;
-
-    framesize = gst_audio_iec61937_frame_size (&sink->ringbuffer->spec);
-    if (framesize <= 0)
-      return NULL;
-
-    out = gst_buffer_new_and_alloc (framesize);
-
-    gst_buffer_map (buf, &iinfo, GST_MAP_READ);
-    gst_buffer_map (out, &oinfo, GST_MAP_WRITE);
-
-    if (!gst_audio_iec61937_payload (iinfo.data, iinfo.size,
-            oinfo.data, oinfo.size, &sink->ringbuffer->spec, G_BIG_ENDIAN)) {
-      gst_buffer_unref (out);
-      return NULL;
-    }
-
-    gst_buffer_unmap (buf, &iinfo);
-    gst_buffer_unmap (out, &oinfo);
-
-    gst_buffer_copy_into (out, buf, GST_BUFFER_COPY_METADATA, 0, -1);
-    return out;
+    /* the payloaded buffer shares the frame data with @buf instead of
+     * copying it into a freshly allocated frame; metadata is copied
+     * along */
+    return gst_audio_iec61937_payload_buffer (gst_buffer_ref (buf),
+        &sink->ringbuffer->spec, G_BIG_ENDIAN);
   }
 
   return gst_buffer_ref (buf);
@@ -59,6 +59,8 @@ struct _GstAlsaSink {
 
   snd_pcm_t             *handle;
 
+  gboolean use_mmap;
+
   snd_pcm_access_t access;
   snd_pcm_format_t format;
   guint rate;
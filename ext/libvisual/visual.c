@@ -22,6 +22,8 @@
 #include "config.h"
 #endif
 
+#include <string.h>
+
 #include "visual.h"
 
 GST_DEBUG_CATEGORY_EXTERN (libvisual_debug);
@@ -30,6 +32,14 @@ GST_DEBUG_CATEGORY_EXTERN (libvisual_debug);
 /* amounf of samples before we can feed libvisual */
 #define VISUAL_SAMPLES  512
 
+#define DEFAULT_CPU_BUDGET 0.0
+
+enum
+{
+  PROP_0,
+  PROP_CPU_BUDGET
+};
+
 #if G_BYTE_ORDER == G_BIG_ENDIAN
 #define RGB_ORDER_CAPS "xRGB, RGB"
 #else
@@ -54,6 +64,10 @@ static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
 
 static void gst_visual_init (GstVisual * visual);
 static void gst_visual_finalize (GObject * object);
+static void gst_visual_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_visual_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
 
 static gboolean gst_visual_setup (GstAudioVisualizer * bscope);
 static gboolean gst_visual_render (GstAudioVisualizer * bscope,
@@ -98,6 +112,23 @@ gst_visual_class_init (gpointer g_class, gpointer class_data)
 
   if (class_data == NULL) {
     parent_class = g_type_class_peek_parent (g_class);
+
+    /**
+     * GstVisual:cpu-budget:
+     *
+     * Maximum fraction of real time to spend rendering, or 0 to always
+     * render at the negotiated resolution. When a render exceeds the
+     * budget the element first switches to rendering at half resolution
+     * with a cheap upscale, and repeats frames when even that does not
+     * fit, so visualization load never affects the audio.
+     *
+     * Since: 1.14
+     */
+    g_object_class_install_property (gobject_class, PROP_CPU_BUDGET,
+        g_param_spec_double ("cpu-budget", "CPU budget",
+            "Fraction of real time to spend rendering (0 = unlimited)",
+            0.0, 1.0, DEFAULT_CPU_BUDGET,
+            G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
   } else {
     gchar *longname = g_strdup_printf ("libvisual %s plugin v.%s",
         klass->plugin->info->name, klass->plugin->info->version);
@@ -114,6 +145,8 @@ gst_visual_class_init (gpointer g_class, gpointer class_data)
   }
 
   gobject_class->finalize = gst_visual_finalize;
+  gobject_class->set_property = gst_visual_set_property;
+  gobject_class->get_property = gst_visual_get_property;
 
   scope_class->setup = GST_DEBUG_FUNCPTR (gst_visual_setup);
   scope_class->render = GST_DEBUG_FUNCPTR (gst_visual_render);
@@ -122,7 +155,68 @@ gst_visual_class_init (gpointer g_class, gpointer class_data)
 static void
 gst_visual_init (GstVisual * visual)
 {
-  /* do nothing */
+  visual->cpu_budget = DEFAULT_CPU_BUDGET;
+}
+
+static void
+gst_visual_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstVisual *visual = GST_VISUAL (object);
+
+  switch (prop_id) {
+    case PROP_CPU_BUDGET:
+      GST_OBJECT_LOCK (visual);
+      visual->cpu_budget = g_value_get_double (value);
+      GST_OBJECT_UNLOCK (visual);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_visual_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVisual *visual = GST_VISUAL (object);
+
+  switch (prop_id) {
+    case PROP_CPU_BUDGET:
+      GST_OBJECT_LOCK (visual);
+      g_value_set_double (value, visual->cpu_budget);
+      GST_OBJECT_UNLOCK (visual);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/* drop everything the load control accumulated; geometry or format may
+ * have changed */
+static void
+gst_visual_reset_adaptive (GstVisual * visual)
+{
+  g_free (visual->half_pixels);
+  visual->half_pixels = NULL;
+  g_free (visual->last_pixels);
+  visual->last_pixels = NULL;
+  visual->last_size = 0;
+  visual->last_stride = 0;
+  if (visual->scale_h) {
+    gst_video_scaler_free (visual->scale_h);
+    visual->scale_h = NULL;
+  }
+  if (visual->scale_v) {
+    gst_video_scaler_free (visual->scale_v);
+    visual->scale_v = NULL;
+  }
+  visual->full_render_time = 0;
+  visual->half_render_time = 0;
+  visual->half_res = FALSE;
+  visual->skipped = 0;
 }
 
 static void
@@ -148,6 +242,7 @@ gst_visual_finalize (GObject * object)
   GstVisual *visual = GST_VISUAL (object);
 
   gst_visual_clear_actors (visual);
+  gst_visual_reset_adaptive (visual);
 
   GST_CALL_PARENT (G_OBJECT_CLASS, finalize, (object));
 }
@@ -159,6 +254,7 @@ gst_visual_setup (GstAudioVisualizer * bscope)
   gint depth;
 
   gst_visual_clear_actors (visual);
+  gst_visual_reset_adaptive (visual);
 
   /* FIXME: we need to know how many bits we actually have in memory */
   depth = bscope->vinfo.finfo->pixel_stride[0];
@@ -208,6 +304,22 @@ no_realize:
   }
 }
 
+/* formats gst_video_scaler_2d() can upscale; RGB16 is not among them, so
+ * the load control falls back to frame repeating only there */
+static gboolean
+gst_visual_scaler_supports_format (GstVideoFormat format)
+{
+  switch (format) {
+    case GST_VIDEO_FORMAT_RGB:
+    case GST_VIDEO_FORMAT_BGR:
+    case GST_VIDEO_FORMAT_BGRx:
+    case GST_VIDEO_FORMAT_xRGB:
+      return TRUE;
+    default:
+      return FALSE;
+  }
+}
+
 static gboolean
 gst_visual_render (GstAudioVisualizer * bscope, GstBuffer * audio,
     GstVideoFrame * video)
@@ -220,11 +332,81 @@ gst_visual_render (GstAudioVisualizer * bscope, GstBuffer * audio,
   VisBuffer *lbuf, *rbuf;
   guint16 ldata[VISUAL_SAMPLES], rdata[VISUAL_SAMPLES];
   VisAudioSampleRateType vrate;
+  gint width = GST_VIDEO_INFO_WIDTH (&bscope->vinfo);
+  gint height = GST_VIDEO_INFO_HEIGHT (&bscope->vinfo);
+  gboolean use_half = FALSE;
+  gint64 allowed = 0, start = 0;
+  gdouble budget;
+
+  GST_OBJECT_LOCK (visual);
+  budget = visual->cpu_budget;
+  GST_OBJECT_UNLOCK (visual);
+
+  if (budget > 0.0 && GST_VIDEO_INFO_FPS_N (&bscope->vinfo) > 0) {
+    gint64 cost;
+
+    allowed = (gint64) (budget *
+        gst_util_uint64_scale_int (G_USEC_PER_SEC,
+            GST_VIDEO_INFO_FPS_D (&bscope->vinfo),
+            GST_VIDEO_INFO_FPS_N (&bscope->vinfo)));
+    allowed = MAX (allowed, 1);
+
+    /* prefer dropping resolution before dropping renders */
+    use_half = visual->full_render_time > allowed &&
+        gst_visual_scaler_supports_format (GST_VIDEO_INFO_FORMAT
+        (&bscope->vinfo));
+
+    cost = use_half ? visual->half_render_time : visual->full_render_time;
+    if (cost > allowed) {
+      /* render only one of every interval frames, repeating the last
+       * rendered one in between */
+      guint interval = cost / allowed + 1;
+
+      if (visual->skipped + 1 < interval && visual->last_pixels != NULL &&
+          visual->last_stride == GST_VIDEO_FRAME_PLANE_STRIDE (video, 0)) {
+        memcpy (GST_VIDEO_FRAME_PLANE_DATA (video, 0), visual->last_pixels,
+            visual->last_size);
+        visual->skipped++;
+        GST_LOG_OBJECT (visual, "over budget, repeated previous frame");
+        return TRUE;
+      }
+    }
+    visual->skipped = 0;
+    start = g_get_monotonic_time ();
+  }
+
+  if (use_half && visual->half_pixels == NULL) {
+    visual->half_width = MAX (width / 2, 16);
+    visual->half_height = MAX (height / 2, 16);
+    visual->half_stride = GST_ROUND_UP_4 (visual->half_width *
+        bscope->vinfo.finfo->pixel_stride[0]);
+    visual->half_pixels = g_malloc0 (visual->half_stride *
+        visual->half_height);
+    visual->scale_h = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_NEAREST,
+        GST_VIDEO_SCALER_FLAG_NONE, 1, visual->half_width, width, NULL);
+    visual->scale_v = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_NEAREST,
+        GST_VIDEO_SCALER_FLAG_NONE, 1, visual->half_height, height, NULL);
+  }
 
-  visual_video_set_buffer (visual->video, GST_VIDEO_FRAME_PLANE_DATA (video,
-          0));
-  visual_video_set_pitch (visual->video, GST_VIDEO_FRAME_PLANE_STRIDE (video,
-          0));
+  if (use_half != visual->half_res) {
+    visual_video_set_dimension (visual->video,
+        use_half ? visual->half_width : width,
+        use_half ? visual->half_height : height);
+    visual_actor_video_negotiate (visual->actor, 0, FALSE, FALSE);
+    visual->half_res = use_half;
+    GST_DEBUG_OBJECT (visual, "now rendering at %s resolution",
+        use_half ? "half" : "full");
+  }
+
+  if (use_half) {
+    visual_video_set_buffer (visual->video, visual->half_pixels);
+    visual_video_set_pitch (visual->video, visual->half_stride);
+  } else {
+    visual_video_set_buffer (visual->video, GST_VIDEO_FRAME_PLANE_DATA (video,
+            0));
+    visual_video_set_pitch (visual->video, GST_VIDEO_FRAME_PLANE_STRIDE (video,
+            0));
+  }
 
   channels = GST_AUDIO_INFO_CHANNELS (&bscope->ainfo);
 
@@ -292,6 +474,42 @@ gst_visual_render (GstAudioVisualizer * bscope, GstBuffer * audio,
   visual_actor_run (visual->actor, visual->audio);
   visual_video_set_buffer (visual->video, NULL);
 
+  if (use_half) {
+    gst_video_scaler_2d (visual->scale_h, visual->scale_v,
+        GST_VIDEO_INFO_FORMAT (&bscope->vinfo),
+        visual->half_pixels, visual->half_stride,
+        GST_VIDEO_FRAME_PLANE_DATA (video, 0),
+        GST_VIDEO_FRAME_PLANE_STRIDE (video, 0), 0, 0, width, height);
+  }
+
+  if (start != 0) {
+    gint64 elapsed = g_get_monotonic_time () - start;
+    gint64 *cost = use_half ? &visual->half_render_time :
+        &visual->full_render_time;
+    gint stride = GST_VIDEO_FRAME_PLANE_STRIDE (video, 0);
+    gsize size = (gsize) stride * height;
+
+    if (*cost == 0)
+      *cost = elapsed;
+    else
+      *cost += (elapsed - *cost) / 4;
+
+    /* while at half resolution the full resolution estimate no longer
+     * gets samples; let it decay slowly so full resolution is retried
+     * when the load goes away */
+    if (use_half)
+      visual->full_render_time -= visual->full_render_time / 32;
+
+    /* keep a copy for repeated frames */
+    if (visual->last_pixels == NULL || visual->last_size != size) {
+      g_free (visual->last_pixels);
+      visual->last_pixels = g_malloc (size);
+      visual->last_size = size;
+    }
+    visual->last_stride = stride;
+    memcpy (visual->last_pixels, GST_VIDEO_FRAME_PLANE_DATA (video, 0), size);
+  }
+
   GST_DEBUG_OBJECT (visual, "rendered one frame");
 done:
   gst_buffer_unmap (audio, &amap);
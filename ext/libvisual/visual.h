@@ -50,6 +50,19 @@ struct _GstVisual
   VisAudio *audio;
   VisVideo *video;
   VisActor *actor;
+
+  /* adaptive render load control */
+  gdouble cpu_budget;           /* property; fraction of real time, 0 = off */
+  gint64 full_render_time;      /* EWMA of a full resolution render (us) */
+  gint64 half_render_time;      /* EWMA of a half resolution render (us) */
+  gboolean half_res;            /* actor currently set up at half size */
+  guint8 *half_pixels;          /* half resolution render target */
+  gint half_width, half_height, half_stride;
+  GstVideoScaler *scale_h, *scale_v;
+  guint skipped;                /* renders skipped since the last real one */
+  guint8 *last_pixels;          /* copy of the last rendered frame */
+  gint last_stride;
+  gsize last_size;
 };
 
 struct _GstVisualClass
@@ -48,6 +48,11 @@
 
 #define CHUNKSIZE (8500)        /* this is out of vorbisfile */
 
+/* maximum size a sequential pull-range read can ramp up to. Large linear
+ * scans are then served with a few big requests instead of a stream of
+ * CHUNKSIZE ones, while bisection probes stay small. */
+#define MAX_READ_SIZE (256 * 1024)
+
 /* we hope we get a granpos within this many bytes off the end */
 #define DURATION_CHUNK_OFFSET (128*1024)
 
@@ -2092,6 +2097,8 @@ gst_ogg_chain_new (GstOggDemux * ogg)
   chain->bytes = -1;
   chain->have_bos = FALSE;
   chain->streams = g_array_new (FALSE, TRUE, sizeof (GstOggPad *));
+  chain->granule_index =
+      g_array_new (FALSE, FALSE, sizeof (GstOggGranuleIndexEntry));
   chain->begin_time = GST_CLOCK_TIME_NONE;
   chain->segment_start = GST_CLOCK_TIME_NONE;
   chain->segment_stop = GST_CLOCK_TIME_NONE;
@@ -2111,6 +2118,7 @@ gst_ogg_chain_free (GstOggChain * chain)
     gst_object_unref (pad);
   }
   g_array_free (chain->streams, TRUE);
+  g_array_free (chain->granule_index, TRUE);
   g_slice_free (GstOggChain, chain);
 }
 
@@ -2309,6 +2317,7 @@ gst_ogg_demux_init (GstOggDemux * ogg)
   ogg->newsegment = NULL;
 
   ogg->chunk_size = CHUNKSIZE;
+  ogg->read_size = CHUNKSIZE;
   ogg->flowcombiner = gst_flow_combiner_new ();
 }
 
@@ -2360,6 +2369,7 @@ gst_ogg_demux_reset_streams (GstOggDemux * ogg)
   gst_ogg_chain_mark_discont (chain);
 
   ogg->chunk_size = CHUNKSIZE;
+  ogg->read_size = CHUNKSIZE;
 }
 
 static gboolean
@@ -2540,6 +2550,7 @@ gst_ogg_demux_seek (GstOggDemux * ogg, gint64 offset)
 
   ogg->offset = offset;
   ogg->read_offset = offset;
+  ogg->read_size = ogg->chunk_size;
   ogg_sync_reset (&ogg->sync);
 }
 
@@ -2553,6 +2564,7 @@ gst_ogg_demux_get_data (GstOggDemux * ogg, gint64 end_offset)
   GstBuffer *buffer;
   gchar *oggbuffer;
   gsize size;
+  long read_size;
 
   GST_LOG_OBJECT (ogg,
       "get data %" G_GINT64_FORMAT " %" G_GINT64_FORMAT " %" G_GINT64_FORMAT,
@@ -2564,17 +2576,26 @@ gst_ogg_demux_get_data (GstOggDemux * ogg, gint64 end_offset)
   if (ogg->read_offset == ogg->length)
     goto eos;
 
-  oggbuffer = ogg_sync_buffer (&ogg->sync, ogg->chunk_size);
+  if (end_offset > 0) {
+    /* bounded reads happen while bisecting, keep the probes small */
+    read_size = ogg->chunk_size;
+  } else {
+    /* sequential scan, double the pull size up to MAX_READ_SIZE so that
+     * local sources are read with a few large requests */
+    read_size = MAX (ogg->read_size, ogg->chunk_size);
+    ogg->read_size = MIN (read_size * 2, MAX_READ_SIZE);
+  }
+
+  oggbuffer = ogg_sync_buffer (&ogg->sync, read_size);
   if (G_UNLIKELY (oggbuffer == NULL))
     goto no_buffer;
 
   buffer =
-      gst_buffer_new_wrapped_full (0, oggbuffer, ogg->chunk_size, 0,
-      ogg->chunk_size, NULL, NULL);
+      gst_buffer_new_wrapped_full (0, oggbuffer, read_size, 0,
+      read_size, NULL, NULL);
 
   ret =
-      gst_pad_pull_range (ogg->sinkpad, ogg->read_offset, ogg->chunk_size,
-      &buffer);
+      gst_pad_pull_range (ogg->sinkpad, ogg->read_offset, read_size, &buffer);
   if (ret != GST_FLOW_OK)
     goto error;
 
@@ -3034,6 +3055,107 @@ gst_ogg_demux_activate_chain (GstOggDemux * ogg, GstOggChain * chain,
   return TRUE;
 }
 
+/* minimum byte distance between two entries in the granule index; keeps the
+ * index to at most chain->bytes / GST_OGG_INDEX_GRANULARITY entries */
+#define GST_OGG_INDEX_GRANULARITY (16 * 1024)
+
+/* remember that the page at @offset has chain time @time. The index is kept
+ * sorted by offset; entries closer than GST_OGG_INDEX_GRANULARITY to an
+ * existing one are not stored. */
+static void
+gst_ogg_chain_index_add (GstOggChain * chain, gint64 offset, GstClockTime time,
+    guint32 serialno)
+{
+  GArray *index = chain->granule_index;
+  GstOggGranuleIndexEntry entry;
+  guint lo, hi;
+
+  if (!GST_CLOCK_TIME_IS_VALID (time))
+    return;
+
+  /* find the first entry with an offset larger than @offset */
+  lo = 0;
+  hi = index->len;
+  while (lo < hi) {
+    guint mid = (lo + hi) / 2;
+
+    if (g_array_index (index, GstOggGranuleIndexEntry, mid).offset <= offset)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  /* drop the entry when a neighbour is too close */
+  if (lo > 0 && offset -
+      g_array_index (index, GstOggGranuleIndexEntry, lo - 1).offset <
+      GST_OGG_INDEX_GRANULARITY)
+    return;
+  if (lo < index->len &&
+      g_array_index (index, GstOggGranuleIndexEntry, lo).offset - offset <
+      GST_OGG_INDEX_GRANULARITY)
+    return;
+
+  entry.offset = offset;
+  entry.time = time;
+  entry.serialno = serialno;
+  g_array_insert_val (index, lo, entry);
+
+  GST_LOG_OBJECT (chain->ogg, "indexed offset %" G_GINT64_FORMAT " with time %"
+      GST_TIME_FORMAT " for %08x (%d entries)", offset, GST_TIME_ARGS (time),
+      serialno, index->len);
+}
+
+/* use the granule index to narrow the range a bisection has to search. On
+ * return, [@begin,@end] brackets @target as tightly as the index allows. */
+static gboolean
+gst_ogg_chain_index_narrow_range (GstOggChain * chain, gint64 target,
+    gboolean only_serial_no, gint serialno, gint64 * begin, gint64 * end,
+    gint64 * begintime, gint64 * endtime)
+{
+  GArray *index = chain->granule_index;
+  gboolean res = FALSE;
+  guint i;
+
+  /* the best lower bound is the entry with the largest offset whose time is
+   * still below the target */
+  for (i = 0; i < index->len; i++) {
+    GstOggGranuleIndexEntry *entry =
+        &g_array_index (index, GstOggGranuleIndexEntry, i);
+
+    if (only_serial_no && entry->serialno != (guint32) serialno)
+      continue;
+    if (entry->time >= (GstClockTime) target)
+      continue;
+    if (entry->offset <= *begin || entry->offset >= *end)
+      continue;
+
+    *begin = entry->offset;
+    *begintime = entry->time;
+    res = TRUE;
+  }
+
+  /* and the best upper bound the first entry past the lower bound whose time
+   * is at or above the target */
+  for (i = 0; i < index->len; i++) {
+    GstOggGranuleIndexEntry *entry =
+        &g_array_index (index, GstOggGranuleIndexEntry, i);
+
+    if (only_serial_no && entry->serialno != (guint32) serialno)
+      continue;
+    if (entry->time < (GstClockTime) target)
+      continue;
+    if (entry->offset <= *begin || entry->offset >= *end)
+      continue;
+
+    *end = entry->offset;
+    *endtime = entry->time;
+    res = TRUE;
+    break;
+  }
+
+  return res;
+}
+
 static gboolean
 do_binary_search (GstOggDemux * ogg, GstOggChain * chain, gint64 begin,
     gint64 end, gint64 begintime, gint64 endtime, gint64 target,
@@ -3045,6 +3167,16 @@ do_binary_search (GstOggDemux * ogg, GstOggChain * chain, gint64 begin,
 
   best = begin;
 
+  /* narrow the range with what previous reads taught us; in the best case
+   * the bisection then converges after a single page read */
+  if (gst_ogg_chain_index_narrow_range (chain, target, only_serial_no,
+          serialno, &begin, &end, &begintime, &endtime)) {
+    GST_DEBUG_OBJECT (ogg,
+        "index narrowed search range to %" G_GINT64_FORMAT " - %"
+        G_GINT64_FORMAT, begin, end);
+    best = begin;
+  }
+
   GST_DEBUG_OBJECT (ogg,
       "chain offset %" G_GINT64_FORMAT ", end offset %" G_GINT64_FORMAT,
       begin, end);
@@ -3138,6 +3270,10 @@ do_binary_search (GstOggDemux * ogg, GstOggChain * chain, gint64 begin,
             "found page with granule %" G_GINT64_FORMAT " and time %"
             GST_TIME_FORMAT, granulepos, GST_TIME_ARGS (granuletime));
 
+        /* remember this page so later seeks need fewer probes */
+        gst_ogg_chain_index_add (chain, result, granuletime,
+            ogg_page_serialno (&og));
+
         if (granuletime < target) {
           best = result;        /* raw offset of packet with granulepos */
           begin = ogg->offset;  /* raw offset of next page */
@@ -3351,6 +3487,10 @@ gst_ogg_demux_do_seek (GstOggDemux * ogg, GstSegment * segment,
         keytarget = target;
         break;
       }
+      /* feed the seek index from the pages we scan here as well */
+      if (ts >= pad->start_time)
+        gst_ogg_chain_index_add (chain, result,
+            ts - pad->start_time + chain->begin_time, pad->map.serialno);
     }
 
     /* in reverse we want to go past the page with the lower timestamp */
@@ -3533,6 +3673,14 @@ gst_ogg_demux_perform_seek_pull (GstOggDemux * ogg, GstEvent * event)
    * forever. */
   GST_PAD_STREAM_LOCK (ogg->sinkpad);
 
+  /* a real seek needs the full chain layout, finish the scan that was
+   * deferred at startup before resolving the seek position */
+  if (G_UNLIKELY (event && ogg->chains_deferred)) {
+    GST_CHAIN_LOCK (ogg);
+    gst_ogg_demux_scan_more_chains (ogg, TRUE);
+    GST_CHAIN_UNLOCK (ogg);
+  }
+
   if (event) {
     gst_segment_do_seek (&ogg->segment, rate, format, flags,
         start_type, start, stop_type, stop, &update);
@@ -3950,25 +4098,26 @@ gst_ogg_demux_perform_seek (GstOggDemux * ogg, GstEvent * event)
 }
 
 
-/* finds each bitstream link one at a time using a bisection search
- * (has to begin by knowing the offset of the lb's initial page).
- * Recurses for each link so it can alloc the link storage after
- * finding them all, then unroll and fill the cache at the same time
+/* finds where @chain, whose streams are already known, ends with a
+ * bisection search between @searched and @end (has to begin by knowing
+ * the offset of the chain's initial page). Stores the end offset on the
+ * chain and reads the last pages of each of its streams. @next is set
+ * to the offset of the first page after the chain.
  */
 static GstFlowReturn
-gst_ogg_demux_bisect_forward_serialno (GstOggDemux * ogg,
-    gint64 begin, gint64 searched, gint64 end, GstOggChain * chain, glong m)
+gst_ogg_demux_scan_chain_end (GstOggDemux * ogg, gint64 searched, gint64 end,
+    GstOggChain * chain, gint64 * next)
 {
   gint64 endsearched = end;
-  gint64 next = end;
   ogg_page og;
   GstFlowReturn ret;
   gint64 offset;
-  GstOggChain *nextchain;
 
   GST_LOG_OBJECT (ogg,
-      "bisect begin: %" G_GINT64_FORMAT ", searched: %" G_GINT64_FORMAT
-      ", end %" G_GINT64_FORMAT ", chain: %p", begin, searched, end, chain);
+      "bisect searched: %" G_GINT64_FORMAT ", end %" G_GINT64_FORMAT
+      ", chain: %p", searched, end, chain);
+
+  *next = end;
 
   /* the below guards against garbage seperating the last and
    * first pages of two links. */
@@ -3991,7 +4140,7 @@ gst_ogg_demux_bisect_forward_serialno (GstOggDemux * ogg,
 
       if (!gst_ogg_chain_has_stream (chain, serial)) {
         endsearched = bisect;
-        next = offset;
+        *next = offset;
       } else {
         searched = offset + og.header_len + og.body_len;
       }
@@ -4002,32 +4151,76 @@ gst_ogg_demux_bisect_forward_serialno (GstOggDemux * ogg,
   GST_LOG_OBJECT (ogg, "current chain ends at %" G_GINT64_FORMAT, searched);
 
   chain->end_offset = searched;
-  ret = gst_ogg_demux_read_end_chain (ogg, chain);
-  if (ret != GST_FLOW_OK)
-    return ret;
+  return gst_ogg_demux_read_end_chain (ogg, chain);
+}
 
-  GST_LOG_OBJECT (ogg, "found begin at %" G_GINT64_FORMAT, next);
+/* reads the chain starting at ogg->scan_offset, finds where it ends and
+ * appends it to the chain list. Used to discover the remaining chains one
+ * at a time once the initial scan was cut short after the first chain.
+ * Called with the chain lock held.
+ */
+static GstFlowReturn
+gst_ogg_demux_scan_next_chain (GstOggDemux * ogg)
+{
+  GstOggChain *chain = NULL;
+  gint64 next;
+  GstFlowReturn ret;
+
+  GST_DEBUG_OBJECT (ogg, "scanning next chain at %" G_GINT64_FORMAT,
+      ogg->scan_offset);
 
-  gst_ogg_demux_seek (ogg, next);
-  ret = gst_ogg_demux_read_chain (ogg, &nextchain);
-  if (ret == GST_FLOW_EOS) {
-    nextchain = NULL;
-    ret = GST_FLOW_OK;
+  gst_ogg_demux_seek (ogg, ogg->scan_offset);
+  ret = gst_ogg_demux_read_chain (ogg, &chain);
+  if (ret == GST_FLOW_EOS || (ret == GST_FLOW_OK && chain == NULL)) {
+    /* no more chains, we're done scanning */
     GST_LOG_OBJECT (ogg, "no next chain");
+    ogg->chains_deferred = FALSE;
+    gst_ogg_demux_collect_info (ogg);
+    gst_ogg_print (ogg);
+    return GST_FLOW_OK;
   } else if (ret != GST_FLOW_OK)
-    goto done;
+    return ret;
 
-  if (searched < end && nextchain != NULL) {
-    ret = gst_ogg_demux_bisect_forward_serialno (ogg, next, ogg->offset,
-        end, nextchain, m + 1);
-    if (ret != GST_FLOW_OK)
-      goto done;
+  ret = gst_ogg_demux_scan_chain_end (ogg, ogg->offset, ogg->length, chain,
+      &next);
+  if (ret != GST_FLOW_OK) {
+    gst_ogg_chain_free (chain);
+    return ret;
   }
+
   GST_LOG_OBJECT (ogg, "adding chain %p", chain);
+  g_array_append_val (ogg->chains, chain);
+  ogg->scan_offset = next;
 
-  g_array_insert_val (ogg->chains, 0, chain);
+  if (chain->end_offset >= ogg->length)
+    ogg->chains_deferred = FALSE;
+
+  /* keep begin times and the total duration up to date as chains come in */
+  gst_ogg_demux_collect_info (ogg);
+  if (!ogg->chains_deferred)
+    gst_ogg_print (ogg);
+
+  return ret;
+}
+
+/* continue a deferred chain scan, either completely or one chain at a
+ * time. Preserves the current read position so this can run between
+ * iterations of the streaming loop. Called with the chain lock held.
+ */
+static GstFlowReturn
+gst_ogg_demux_scan_more_chains (GstOggDemux * ogg, gboolean all)
+{
+  gint64 saved_offset = ogg->offset;
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  while (ogg->chains_deferred) {
+    ret = gst_ogg_demux_scan_next_chain (ogg);
+    if (ret != GST_FLOW_OK || !all)
+      break;
+  }
+
+  gst_ogg_demux_seek (ogg, saved_offset);
 
-done:
   return ret;
 }
 
@@ -4392,20 +4585,33 @@ gst_ogg_demux_find_chains (GstOggDemux * ogg)
   serialno = ogg_page_serialno (&og);
 
   if (!gst_ogg_chain_has_stream (chain, serialno)) {
-    /* the last page is not in the first stream, this means we should
-     * find all the chains in this chained ogg. */
-    ret =
-        gst_ogg_demux_bisect_forward_serialno (ogg, 0, 0, ogg->length, chain,
-        0);
+    /* the last page is not in the first stream, this is a chained ogg.
+     * Only scan the end of the first chain now so playback can start;
+     * the remaining chains are discovered from the streaming thread
+     * (or on demand for seeks). */
+    gint64 next;
+
+    ret = gst_ogg_demux_scan_chain_end (ogg, 0, ogg->length, chain, &next);
+    if (ret != GST_FLOW_OK) {
+      gst_ogg_chain_free (chain);
+      goto done;
+    }
+    g_array_append_val (ogg->chains, chain);
+    ogg->scan_offset = next;
+    ogg->chains_deferred = TRUE;
   } else {
-    /* we still call this function here but with an empty range so that
-     * we can reuse the setup code in this routine. */
-    ret =
-        gst_ogg_demux_bisect_forward_serialno (ogg, 0, ogg->length,
-        ogg->length, chain, 0);
+    /* not chained; scan an empty range so that we can reuse the
+     * end-of-chain reading code. */
+    gint64 next;
+
+    ret = gst_ogg_demux_scan_chain_end (ogg, ogg->length, ogg->length, chain,
+        &next);
+    if (ret != GST_FLOW_OK) {
+      gst_ogg_chain_free (chain);
+      goto done;
+    }
+    g_array_append_val (ogg->chains, chain);
   }
-  if (ret != GST_FLOW_OK)
-    goto done;
 
   /* all fine, collect and print */
   gst_ogg_demux_collect_info (ogg);
@@ -4464,6 +4670,8 @@ gst_ogg_demux_handle_page (GstOggDemux * ogg, ogg_page * page, gboolean discont)
   gint64 granule;
   guint32 serialno;
   GstFlowReturn result = GST_FLOW_OK;
+  ogg_page page_copy;
+  guint8 *page_copy_data = NULL;
 
   serialno = ogg_page_serialno (page);
   granule = ogg_page_granulepos (page);
@@ -4481,6 +4689,24 @@ gst_ogg_demux_handle_page (GstOggDemux * ogg, ogg_page * page, gboolean discont)
     /* first page */
     /* see if we know about the chain already */
     chain = gst_ogg_demux_find_chain (ogg, serialno);
+    if (G_UNLIKELY (chain == NULL && ogg->pullmode && ogg->chains_deferred)) {
+      /* the deferred chain scan has not caught up with playback yet,
+       * finish it so the chain this BOS page belongs to is known. The
+       * scan seeks and reads through ogg->sync, which reuses the storage
+       * that @page points into, so keep a copy of the page to submit */
+      page_copy = *page;
+      page_copy_data = g_malloc (page->header_len + page->body_len);
+      memcpy (page_copy_data, page->header, page->header_len);
+      memcpy (page_copy_data + page->header_len, page->body, page->body_len);
+      page_copy.header = page_copy_data;
+      page_copy.body = page_copy_data + page->header_len;
+      page = &page_copy;
+
+      GST_CHAIN_LOCK (ogg);
+      gst_ogg_demux_scan_more_chains (ogg, TRUE);
+      GST_CHAIN_UNLOCK (ogg);
+      chain = gst_ogg_demux_find_chain (ogg, serialno);
+    }
     if (chain) {
       GstEvent *event;
       gint64 start = 0;
@@ -4572,6 +4798,7 @@ gst_ogg_demux_handle_page (GstOggDemux * ogg, ogg_page * page, gboolean discont)
     }
     GST_PUSH_UNLOCK (ogg);
   }
+  g_free (page_copy_data);
   return result;
 
   /* ERRORS */
@@ -4579,6 +4806,7 @@ unknown_chain:
   {
     GST_ELEMENT_ERROR (ogg, STREAM, DECODE,
         (NULL), ("unknown ogg chain for serial %08x detected", serialno));
+    g_free (page_copy_data);
     return GST_FLOW_ERROR;
   }
 }
@@ -4823,6 +5051,12 @@ gst_ogg_demux_loop (GstOggPad * pad)
 
     if (!res)
       goto seek_failed;
+  } else if (G_UNLIKELY (ogg->chains_deferred)) {
+    /* playback is running, discover one more chain per iteration until
+     * the whole file is mapped */
+    GST_CHAIN_LOCK (ogg);
+    gst_ogg_demux_scan_more_chains (ogg, FALSE);
+    GST_CHAIN_UNLOCK (ogg);
   }
 
   if (ogg->segment.rate >= 0.0)
@@ -5058,6 +5292,8 @@ gst_ogg_demux_sink_activate_mode (GstPad * sinkpad, GstObject * parent,
     case GST_PAD_MODE_PULL:
       if (active) {
         ogg->need_chains = TRUE;
+        ogg->chains_deferred = FALSE;
+        ogg->scan_offset = 0;
         ogg->pullmode = TRUE;
 
         res = gst_pad_start_task (sinkpad, (GstTaskFunction) gst_ogg_demux_loop,
@@ -52,6 +52,15 @@ typedef struct _GstOggDemux GstOggDemux;
 typedef struct _GstOggDemuxClass GstOggDemuxClass;
 typedef struct _GstOggChain GstOggChain;
 
+/* one entry of the incrementally built seek index, mapping the byte offset
+ * of a page to the stream time of its granulepos */
+typedef struct _GstOggGranuleIndexEntry
+{
+  gint64 offset;                /* byte offset of the page */
+  GstClockTime time;            /* chain time of the page granulepos */
+  guint32 serialno;             /* stream the page belongs to */
+} GstOggGranuleIndexEntry;
+
 /* all information needed for one ogg chain (relevant for chained bitstreams) */
 struct _GstOggChain
 {
@@ -65,6 +74,10 @@ struct _GstOggChain
 
   GArray *streams;
 
+  GArray *granule_index;        /* sorted (by offset) array of
+                                   GstOggGranuleIndexEntry, built incrementally
+                                   from the pages we read while seeking */
+
   GstClockTime total_time;      /* the total time of this chain, this is the MAX of
                                    the totals of all streams */
   GstClockTime begin_time;      /* when this chain starts in the stream */
@@ -142,6 +155,11 @@ struct _GstOggDemux
   guint group_id;
 
   gboolean need_chains;
+  /* chained stream whose scan was cut short after the first chain so
+   * playback could start; the remaining chains are discovered from the
+   * streaming thread */
+  gboolean chains_deferred;
+  gint64 scan_offset;           /* start offset of the next unscanned chain */
   gboolean resync;
 
   /* keep track of how large pages and packets are,
@@ -202,6 +220,8 @@ struct _GstOggDemux
   /* ogg stuff */
   ogg_sync_state sync;
   long chunk_size;
+  long read_size;               /* current pull-range size; ramps up while
+                                   reading sequentially, reset on seeks */
 
   /* Seek events set up by the streaming thread in push mode */
   GstEvent *seek_event;
@@ -69,6 +69,8 @@ GST_DEBUG_CATEGORY_STATIC (gst_ogg_mux_debug);
 #define DEFAULT_MAX_DELAY       G_GINT64_CONSTANT(500000000)
 #define DEFAULT_MAX_PAGE_DELAY  G_GINT64_CONSTANT(500000000)
 #define DEFAULT_MAX_TOLERANCE   G_GINT64_CONSTANT(40000000)
+#define DEFAULT_MAX_BATCH_BYTES 0
+#define DEFAULT_MAX_BATCH_TIME  G_GINT64_CONSTANT(500000000)
 #define DEFAULT_SKELETON        FALSE
 
 enum
@@ -77,7 +79,9 @@ enum
   ARG_MAX_DELAY,
   ARG_MAX_PAGE_DELAY,
   ARG_MAX_TOLERANCE,
-  ARG_SKELETON
+  ARG_SKELETON,
+  ARG_MAX_BATCH_BYTES,
+  ARG_MAX_BATCH_TIME
 };
 
 static GstStaticPadTemplate src_factory = GST_STATIC_PAD_TEMPLATE ("src",
@@ -125,6 +129,7 @@ static GstPad *gst_ogg_mux_request_new_pad (GstElement * element,
 static void gst_ogg_mux_release_pad (GstElement * element, GstPad * pad);
 static void gst_ogg_pad_data_reset (GstOggMux * ogg_mux,
     GstOggPadData * pad_data);
+static void gst_ogg_mux_pad_queue_remove (GstOggPadData * pad);
 
 static void gst_ogg_mux_set_property (GObject * object,
     guint prop_id, const GValue * value, GParamSpec * pspec);
@@ -187,6 +192,35 @@ gst_ogg_mux_class_init (GstOggMuxClass * klass)
           "Whether to include a Skeleton track",
           DEFAULT_SKELETON,
           (GParamFlags) G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstOggMux:max-batch-bytes:
+   *
+   * Aggregate completed pages and push them downstream as a single
+   * buffer list once this many bytes have accumulated, cutting the
+   * per-page push overhead. 0 pushes every page on its own.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, ARG_MAX_BATCH_BYTES,
+      g_param_spec_uint64 ("max-batch-bytes", "Max batch bytes",
+          "Aggregate pages until this many bytes before pushing them "
+          "downstream as one buffer list (0 = push every page separately)",
+          0, G_MAXUINT64, DEFAULT_MAX_BATCH_BYTES,
+          (GParamFlags) G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstOggMux:max-batch-time:
+   *
+   * Maximum amount of stream time that may accumulate in a page batch
+   * before it is flushed, bounding the extra latency introduced by
+   * #GstOggMux:max-batch-bytes.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, ARG_MAX_BATCH_TIME,
+      g_param_spec_uint64 ("max-batch-time", "Max batch time",
+          "Maximum amount of stream time to batch up pages for "
+          "(in nanoseconds)", 0, G_MAXUINT64, DEFAULT_MAX_BATCH_TIME,
+          (GParamFlags) G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gstelement_class->change_state = gst_ogg_mux_change_state;
 
@@ -195,6 +229,12 @@ gst_ogg_mux_class_init (GstOggMuxClass * klass)
 static void
 gst_ogg_mux_clear (GstOggMux * ogg_mux)
 {
+  if (ogg_mux->batch) {
+    gst_buffer_list_unref (ogg_mux->batch);
+    ogg_mux->batch = NULL;
+  }
+  ogg_mux->batch_size = 0;
+  ogg_mux->batch_first_ts = GST_CLOCK_TIME_NONE;
   ogg_mux->pulling = NULL;
   ogg_mux->need_headers = TRUE;
   ogg_mux->need_start_events = TRUE;
@@ -218,6 +258,8 @@ gst_ogg_mux_init (GstOggMux * ogg_mux)
   /* seed random number generator for creation of serial numbers */
   srand (time (NULL));
 
+  ogg_mux->pad_queue = g_sequence_new (NULL);
+
   ogg_mux->collect = gst_collect_pads_new ();
   gst_collect_pads_set_function (ogg_mux->collect,
       (GstCollectPadsFunction) GST_DEBUG_FUNCPTR (gst_ogg_mux_collected),
@@ -229,6 +271,8 @@ gst_ogg_mux_init (GstOggMux * ogg_mux)
   ogg_mux->max_delay = DEFAULT_MAX_DELAY;
   ogg_mux->max_page_delay = DEFAULT_MAX_PAGE_DELAY;
   ogg_mux->max_tolerance = DEFAULT_MAX_TOLERANCE;
+  ogg_mux->max_batch_bytes = DEFAULT_MAX_BATCH_BYTES;
+  ogg_mux->max_batch_time = DEFAULT_MAX_BATCH_TIME;
 
   gst_ogg_mux_clear (ogg_mux);
 }
@@ -244,6 +288,14 @@ gst_ogg_mux_finalize (GObject * object)
     gst_object_unref (ogg_mux->collect);
     ogg_mux->collect = NULL;
   }
+  if (ogg_mux->batch) {
+    gst_buffer_list_unref (ogg_mux->batch);
+    ogg_mux->batch = NULL;
+  }
+  if (ogg_mux->pad_queue) {
+    g_sequence_free (ogg_mux->pad_queue);
+    ogg_mux->pad_queue = NULL;
+  }
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -257,6 +309,8 @@ gst_ogg_mux_ogg_pad_destroy_notify (GstCollectData * data)
   ogg_stream_clear (&oggpad->map.stream);
   gst_caps_replace (&oggpad->map.caps, NULL);
 
+  gst_ogg_mux_pad_queue_remove (oggpad);
+
   if (oggpad->pagebuffers) {
     while ((buf = g_queue_pop_head (oggpad->pagebuffers)) != NULL) {
       gst_buffer_unref (buf);
@@ -571,6 +625,27 @@ gst_ogg_mux_buffer_from_page (GstOggMux * mux, ogg_page * page, gboolean delta)
   return buffer;
 }
 
+/* push out the pages batched up so far, if any */
+static GstFlowReturn
+gst_ogg_mux_flush_batch (GstOggMux * mux)
+{
+  GstBufferList *batch;
+
+  if (mux->batch == NULL)
+    return GST_FLOW_OK;
+
+  batch = mux->batch;
+  mux->batch = NULL;
+
+  GST_LOG_OBJECT (mux->srcpad, "pushing batch of %u pages (%" G_GSIZE_FORMAT
+      " bytes)", gst_buffer_list_length (batch), mux->batch_size);
+
+  mux->batch_size = 0;
+  mux->batch_first_ts = GST_CLOCK_TIME_NONE;
+
+  return gst_pad_push_list (mux->srcpad, batch);
+}
+
 static GstFlowReturn
 gst_ogg_mux_push_buffer (GstOggMux * mux, GstBuffer * buffer,
     GstOggPadData * oggpad)
@@ -589,10 +664,34 @@ gst_ogg_mux_push_buffer (GstOggMux * mux, GstBuffer * buffer,
       mux->last_ts = run_time;
   }
 
-  GST_LOG_OBJECT (mux->srcpad, "pushing %p, last_ts=%" GST_TIME_FORMAT,
-      buffer, GST_TIME_ARGS (mux->last_ts));
+  if (mux->max_batch_bytes == 0) {
+    GST_LOG_OBJECT (mux->srcpad, "pushing %p, last_ts=%" GST_TIME_FORMAT,
+        buffer, GST_TIME_ARGS (mux->last_ts));
+
+    return gst_pad_push (mux->srcpad, buffer);
+  }
+
+  /* batch pages up and push them downstream in one go once enough bytes
+   * or stream time accumulated */
+  if (mux->batch == NULL) {
+    mux->batch = gst_buffer_list_new ();
+    mux->batch_first_ts = GST_BUFFER_TIMESTAMP (buffer);
+  }
+  mux->batch_size += gst_buffer_get_size (buffer);
+  gst_buffer_list_add (mux->batch, buffer);
+
+  GST_LOG_OBJECT (mux->srcpad, "batched %p, last_ts=%" GST_TIME_FORMAT
+      ", %" G_GSIZE_FORMAT " bytes batched", buffer,
+      GST_TIME_ARGS (mux->last_ts), mux->batch_size);
 
-  return gst_pad_push (mux->srcpad, buffer);
+  if (mux->batch_size >= mux->max_batch_bytes ||
+      (GST_CLOCK_TIME_IS_VALID (mux->batch_first_ts)
+          && GST_CLOCK_TIME_IS_VALID (mux->last_ts)
+          && mux->last_ts >= mux->batch_first_ts
+          && mux->last_ts - mux->batch_first_ts >= mux->max_batch_time))
+    return gst_ogg_mux_flush_batch (mux);
+
+  return GST_FLOW_OK;
 }
 
 /* if all queues have at least one page, dequeue the page with the lowest
@@ -797,6 +896,40 @@ gst_ogg_mux_compare_pads (GstOggMux * ogg_mux, GstOggPadData * first,
   return 0;
 }
 
+static gint
+gst_ogg_mux_compare_pads_sequence (gconstpointer a, gconstpointer b,
+    gpointer user_data)
+{
+  return gst_ogg_mux_compare_pads ((GstOggMux *) user_data,
+      (GstOggPadData *) a, (GstOggPadData *) b);
+}
+
+/* Removes @pad from the ordered pad queue */
+static void
+gst_ogg_mux_pad_queue_remove (GstOggPadData * pad)
+{
+  if (pad->queue_iter) {
+    g_sequence_remove (pad->queue_iter);
+    pad->queue_iter = NULL;
+  }
+}
+
+/* Stores a new queued buffer (or NULL) on @pad and updates its position
+ * in the ordered pad queue. The queue key is the priority of the queued
+ * buffer, so the pad must be re-inserted whenever the buffer changes. */
+static void
+gst_ogg_mux_pad_set_buffer (GstOggMux * ogg_mux, GstOggPadData * pad,
+    GstBuffer * buffer)
+{
+  gst_ogg_mux_pad_queue_remove (pad);
+
+  pad->buffer = buffer;
+
+  if (buffer)
+    pad->queue_iter = g_sequence_insert_sorted (ogg_mux->pad_queue, pad,
+        gst_ogg_mux_compare_pads_sequence, ogg_mux);
+}
+
 static GstBuffer *
 gst_ogg_mux_decorate_buffer (GstOggMux * ogg_mux, GstOggPadData * pad,
     GstBuffer * buf)
@@ -985,6 +1118,7 @@ static GstOggPadData *
 gst_ogg_mux_queue_pads (GstOggMux * ogg_mux, gboolean * popped)
 {
   GstOggPadData *bestpad = NULL;
+  GSequenceIter *iter;
   GSList *walk;
 
   *popped = FALSE;
@@ -1115,18 +1249,21 @@ gst_ogg_mux_queue_pads (GstOggMux * ogg_mux, gboolean * popped)
         }
       }
 
-      pad->buffer = buf;
+      gst_ogg_mux_pad_set_buffer (ogg_mux, pad, buf);
     }
+  }
 
-    /* we should have a buffer now, see if it is the best pad to
-     * pull on. Our best pad can't be eos */
-    if (pad->buffer && !pad->eos) {
-      if (gst_ogg_mux_compare_pads (ogg_mux, bestpad, pad) > 0) {
-        GST_LOG_OBJECT (data->pad,
-            "new best pad, with buffer %" GST_PTR_FORMAT, pad->buffer);
+  /* the best pad sits at the front of the ordered pad queue; skip over
+   * pads that went EOS, our best pad can't be eos */
+  for (iter = g_sequence_get_begin_iter (ogg_mux->pad_queue);
+      !g_sequence_iter_is_end (iter); iter = g_sequence_iter_next (iter)) {
+    GstOggPadData *pad = (GstOggPadData *) g_sequence_get (iter);
 
-        bestpad = pad;
-      }
+    if (!pad->eos) {
+      GST_LOG_OBJECT (pad->collect.pad,
+          "best pad, with buffer %" GST_PTR_FORMAT, pad->buffer);
+      bestpad = pad;
+      break;
     }
   }
 
@@ -1182,6 +1319,7 @@ gst_ogg_mux_get_headers (GstOggPadData * pad)
 
   } else if (gst_structure_has_name (structure, "video/x-dirac")) {
     res = g_list_append (res, pad->buffer);
+    gst_ogg_mux_pad_queue_remove (pad);
     pad->buffer = NULL;
   } else if (pad->have_type
       && (header = gst_ogg_stream_get_headers (&pad->map))) {
@@ -1763,6 +1901,7 @@ gst_ogg_mux_process_best_pad (GstOggMux * ogg_mux, GstOggPadData * best)
     } else {
       GST_LOG_OBJECT (ogg_mux->srcpad, "sending EOS");
       /* no pad to pull on, send EOS */
+      gst_ogg_mux_flush_batch (ogg_mux);
       gst_pad_push_event (ogg_mux->srcpad, gst_event_new_eos ());
       return GST_FLOW_FLUSHING;
     }
@@ -1913,7 +2052,7 @@ gst_ogg_mux_process_best_pad (GstOggMux * ogg_mux, GstOggPadData * best)
     /* don't need the old buffer anymore */
     gst_buffer_unref (pad->buffer);
     /* store new readahead buffer */
-    pad->buffer = tmpbuf;
+    gst_ogg_mux_pad_set_buffer (ogg_mux, pad, tmpbuf);
 
     /* let ogg write out the pages now. The packet we got could end
      * up in more than one page so we need to write them all */
@@ -2090,6 +2229,7 @@ gst_ogg_mux_collected (GstCollectPads * pads, GstOggMux * ogg_mux)
 eos:
   {
     GST_DEBUG_OBJECT (ogg_mux, "no data available, must be EOS");
+    gst_ogg_mux_flush_batch (ogg_mux);
     gst_pad_push_event (ogg_mux->srcpad, gst_event_new_eos ());
     return GST_FLOW_EOS;
   }
@@ -2116,6 +2256,12 @@ gst_ogg_mux_get_property (GObject * object,
     case ARG_SKELETON:
       g_value_set_boolean (value, ogg_mux->use_skeleton);
       break;
+    case ARG_MAX_BATCH_BYTES:
+      g_value_set_uint64 (value, ogg_mux->max_batch_bytes);
+      break;
+    case ARG_MAX_BATCH_TIME:
+      g_value_set_uint64 (value, ogg_mux->max_batch_time);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2143,6 +2289,12 @@ gst_ogg_mux_set_property (GObject * object,
     case ARG_SKELETON:
       ogg_mux->use_skeleton = g_value_get_boolean (value);
       break;
+    case ARG_MAX_BATCH_BYTES:
+      ogg_mux->max_batch_bytes = g_value_get_uint64 (value);
+      break;
+    case ARG_MAX_BATCH_TIME:
+      ogg_mux->max_batch_time = g_value_get_uint64 (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2197,6 +2349,7 @@ gst_ogg_mux_clear_collectpads (GstCollectPads * collect)
     g_queue_free (oggpad->pagebuffers);
     oggpad->pagebuffers = NULL;
 
+    gst_ogg_mux_pad_queue_remove (oggpad);
     if (oggpad->buffer) {
       gst_buffer_unref (oggpad->buffer);
       oggpad->buffer = NULL;
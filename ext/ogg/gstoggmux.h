@@ -56,6 +56,8 @@ typedef struct
   GstSegment segment;
 
   GstBuffer *buffer;            /* the first waiting buffer for the pad */
+  GSequenceIter *queue_iter;    /* position in the muxer's ordered pad queue,
+                                 * NULL when no buffer is queued */
 
   gint64 packetno;              /* number of next packet */
   gint64 pageno;                /* number of next page */
@@ -101,6 +103,10 @@ struct _GstOggMux
   /* sinkpads */
   GstCollectPads *collect;
 
+  /* pads that have a queued buffer, ordered by the priority of that
+   * buffer (oldest first), so the best pad is found in O(log n) */
+  GSequence *pad_queue;
+
   /* number of pads which have not received EOS */
   gint active_pads;
 
@@ -131,6 +137,14 @@ struct _GstOggMux
 
   /* whether to create a skeleton track */
   gboolean use_skeleton;
+
+  /* output page batching */
+  guint64 max_batch_bytes;      /* flush threshold in bytes, 0 disables
+                                 * batching */
+  guint64 max_batch_time;       /* flush threshold on batched duration */
+  GstBufferList *batch;         /* completed pages awaiting a flush */
+  gsize batch_size;             /* bytes accumulated in batch */
+  GstClockTime batch_first_ts;  /* timestamp of the oldest batched page */
 };
 
 struct _GstOggMuxClass
@@ -592,9 +592,23 @@ opus_dec_chain_parse_data (GstOpusDec * dec, GstBuffer * buffer)
         GST_TIME_ARGS (aligned_missing_duration), samples,
         GST_TIME_ARGS (dec->leftover_plc_duration));
   } else {
-    /* use maximum size (120 ms) as the number of returned samples is
-       not constant over the stream. */
-    samples = 120 * dec->sample_rate / 1000;
+    GstClockTime packet_dur = 0;
+
+    if (size > 0)
+      packet_dur = packet_duration_opus (data, size);
+
+    if (packet_dur > 0) {
+      /* size the output buffer from the packet's TOC instead of always
+         reserving the 120 ms maximum; a wrong guess is corrected by the
+         OPUS_BUFFER_TOO_SMALL retry below */
+      samples =
+          gst_util_uint64_scale_int (packet_dur, dec->sample_rate, GST_SECOND);
+      dec->last_known_buffer_duration = packet_dur;
+    } else {
+      /* use maximum size (120 ms) as the number of returned samples is
+         not constant over the stream. */
+      samples = 120 * dec->sample_rate / 1000;
+    }
   }
   packet_size = samples * dec->n_channels * 2;
 
@@ -605,9 +619,6 @@ opus_dec_chain_parse_data (GstOpusDec * dec, GstBuffer * buffer)
     goto buffer_failed;
   }
 
-  if (size > 0)
-    dec->last_known_buffer_duration = packet_duration_opus (data, size);
-
   gst_buffer_map (outbuf, &omap, GST_MAP_WRITE);
   out_data = (gint16 *) omap.data;
 
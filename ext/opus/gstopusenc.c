@@ -102,6 +102,13 @@ gst_opus_enc_frame_size_get_type (void)
     {20, "20", "20"},
     {40, "40", "40"},
     {60, "60", "60"},
+#ifdef OPUS_FRAMESIZE_80_MS
+    /* multi-frame packets, assembled by libopus (1.2+) with its
+     * repacketizer; one packet carries 4, 5 or 6 20 ms frames */
+    {80, "80", "80"},
+    {100, "100", "100"},
+    {120, "120", "120"},
+#endif
     {0, NULL, NULL}
   };
   static volatile GType id = 0;
@@ -323,7 +330,8 @@ gst_opus_enc_class_init (GstOpusEncClass * klass)
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_PLAYING));
   g_object_class_install_property (gobject_class, PROP_DTX,
-      g_param_spec_boolean ("dtx", "DTX", "DTX", DEFAULT_DTX,
+      g_param_spec_boolean ("dtx", "DTX",
+          "DTX (drops output buffers during silence)", DEFAULT_DTX,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_PLAYING));
   g_object_class_install_property (G_OBJECT_CLASS (klass),
@@ -424,7 +432,9 @@ gst_opus_enc_setup_base_class (GstOpusEnc * enc, GstAudioEncoder * benc)
       gst_opus_enc_get_latency (enc), gst_opus_enc_get_latency (enc));
   gst_audio_encoder_set_frame_samples_min (benc, enc->frame_samples);
   gst_audio_encoder_set_frame_samples_max (benc, enc->frame_samples);
-  gst_audio_encoder_set_frame_max (benc, 1);
+  /* accept batches of frames from the adapter, handle_frame slices them
+   * up again so each opus packet still covers one frame */
+  gst_audio_encoder_set_frame_max (benc, 0);
 }
 
 static gint
@@ -450,6 +460,17 @@ gst_opus_enc_get_frame_samples (GstOpusEnc * enc)
     case 60:
       frame_samples = 3 * enc->sample_rate / 50;
       break;
+#ifdef OPUS_FRAMESIZE_80_MS
+    case 80:
+      frame_samples = 4 * enc->sample_rate / 50;
+      break;
+    case 100:
+      frame_samples = 5 * enc->sample_rate / 50;
+      break;
+    case 120:
+      frame_samples = 6 * enc->sample_rate / 50;
+      break;
+#endif
     default:
       GST_WARNING_OBJECT (enc, "Unsupported frame size: %d", enc->frame_size);
       frame_samples = 0;
@@ -910,12 +931,14 @@ gst_opus_enc_encode (GstOpusEnc * enc, GstBuffer * buf)
 
   guint max_payload_size;
   gint frame_samples, input_samples, output_samples;
+  gboolean dtx;
 
   g_mutex_lock (&enc->property_lock);
 
   bytes = enc->frame_samples * enc->n_channels * 2;
   max_payload_size = enc->max_payload_size;
   frame_samples = input_samples = enc->frame_samples;
+  dtx = enc->dtx;
 
   g_mutex_unlock (&enc->property_lock);
 
@@ -1039,9 +1062,16 @@ gst_opus_enc_encode (GstOpusEnc * enc, GstBuffer * buf)
     goto done;
   }
 
-  GST_DEBUG_OBJECT (enc, "Output packet is %u bytes", outsize);
-  gst_buffer_set_size (outbuf, outsize);
-
+  if (dtx && outsize <= 2 && !trim_start && !trim_end) {
+    /* a 1-2 byte packet during DTX carries no audio, push no buffer for
+     * it; the base class still accounts for the samples */
+    GST_DEBUG_OBJECT (enc, "DTX packet of %d bytes, dropping", outsize);
+    gst_buffer_unref (outbuf);
+    outbuf = NULL;
+  } else {
+    GST_DEBUG_OBJECT (enc, "Output packet is %u bytes", outsize);
+    gst_buffer_set_size (outbuf, outsize);
+  }
 
   ret =
       gst_audio_encoder_finish_frame (GST_AUDIO_ENCODER (enc), outbuf,
@@ -1070,6 +1100,31 @@ gst_opus_enc_handle_frame (GstAudioEncoder * benc, GstBuffer * buf)
   GST_DEBUG_OBJECT (enc, "received buffer %p of %" G_GSIZE_FORMAT " bytes", buf,
       buf ? gst_buffer_get_size (buf) : 0);
 
+  if (buf) {
+    gsize size, frame_bytes, offset = 0;
+
+    g_mutex_lock (&enc->property_lock);
+    frame_bytes = enc->frame_samples * enc->n_channels * 2;
+    g_mutex_unlock (&enc->property_lock);
+
+    size = gst_buffer_get_size (buf);
+
+    /* the base class hands us batches of frames at once, slice them up
+     * so each opus packet covers exactly one frame */
+    if (size > frame_bytes) {
+      while (offset < size && ret == GST_FLOW_OK) {
+        GstBuffer *sub;
+        gsize n = MIN (frame_bytes, size - offset);
+
+        sub = gst_buffer_copy_region (buf, GST_BUFFER_COPY_ALL, offset, n);
+        ret = gst_opus_enc_encode (enc, sub);
+        gst_buffer_unref (sub);
+        offset += n;
+      }
+      return ret;
+    }
+  }
+
   ret = gst_opus_enc_encode (enc, buf);
 
   return ret;
@@ -79,6 +79,21 @@ GST_DEBUG_CATEGORY (pango_debug);
 #define MINIMUM_OUTLINE_OFFSET 1.0
 #define DEFAULT_SCALE_BASIS    640
 
+/* number of rendered text images kept around for reuse; subtitle streams
+ * typically cycle through a small set of strings (and often repeat the
+ * previous one after a seek), so a small LRU already catches most re-renders */
+#define RENDER_CACHE_SIZE 16
+
+typedef struct
+{
+  gchar *key;
+  GstBuffer *image;
+  guint text_width;
+  guint text_height;
+  PangoRectangle ink_rect;
+  PangoRectangle logical_rect;
+} GstBaseTextOverlayRenderCacheEntry;
+
 enum
 {
   PROP_0,
@@ -672,6 +687,10 @@ gst_base_text_overlay_finalize (GObject * object)
     overlay->text_image = NULL;
   }
 
+  g_queue_foreach (&overlay->render_cache,
+      (GFunc) gst_base_text_overlay_render_cache_entry_free, NULL);
+  g_queue_clear (&overlay->render_cache);
+
   if (overlay->layout) {
     g_object_unref (overlay->layout);
     overlay->layout = NULL;
@@ -769,6 +788,7 @@ gst_base_text_overlay_init (GstBaseTextOverlay * overlay,
   overlay->default_text = g_strdup (DEFAULT_PROP_TEXT);
   overlay->need_render = TRUE;
   overlay->text_image = NULL;
+  g_queue_init (&overlay->render_cache);
   overlay->use_vertical_render = DEFAULT_PROP_VERTICAL_RENDER;
   overlay->scale_mode = DEFAULT_PROP_SCALE_MODE;
   overlay->scale_par_n = DEFAULT_PROP_SCALE_PAR_N;
@@ -1690,9 +1710,11 @@ gst_base_text_overlay_set_composition (GstBaseTextOverlay * overlay)
         overlay->text_width, overlay->text_height, render_width,
         render_height, xpos, ypos);
 
-    gst_buffer_add_video_meta (overlay->text_image, GST_VIDEO_FRAME_FLAG_NONE,
-        GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB,
-        overlay->text_width, overlay->text_height);
+    /* a buffer coming back from the render cache already carries the meta */
+    if (!gst_buffer_get_video_meta (overlay->text_image))
+      gst_buffer_add_video_meta (overlay->text_image, GST_VIDEO_FRAME_FLAG_NONE,
+          GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB,
+          overlay->text_width, overlay->text_height);
 
     rectangle = gst_video_overlay_rectangle_new_raw (overlay->text_image,
         xpos, ypos, render_width, render_height,
@@ -1726,6 +1748,92 @@ gst_base_text_overlay_set_composition (GstBaseTextOverlay * overlay)
   }
 }
 
+static void
+gst_base_text_overlay_render_cache_entry_free (gpointer data)
+{
+  GstBaseTextOverlayRenderCacheEntry *entry = data;
+
+  g_free (entry->key);
+  gst_buffer_unref (entry->image);
+  g_slice_free (GstBaseTextOverlayRenderCacheEntry, entry);
+}
+
+/* Build a key covering every input that influences the rendered image.
+ * The position-only inputs (deltax/y, x/ypos) are deliberately left out,
+ * they are applied when the composition is (re)created from the image.
+ * Must be called with the pango lock held (reads the layout font). */
+static gchar *
+gst_base_text_overlay_render_cache_key (GstBaseTextOverlay * overlay,
+    const gchar * string)
+{
+  const PangoFontDescription *desc;
+  gchar *font, *key;
+
+  desc = pango_layout_get_font_description (overlay->layout);
+  font = desc ? pango_font_description_to_string ((PangoFontDescription *)
+      desc) : g_strdup ("");
+
+  key = g_strdup_printf ("%dx%d|%dx%d|%g|%d|%d/%d|%d/%d|%d|%d|"
+      "%d|%g|%d|%g|%08x|%08x|%d|%d|%d|%d|%d|%d|%s|%s",
+      overlay->width, overlay->height,
+      overlay->window_width, overlay->window_height,
+      overlay->render_scale, overlay->scale_mode,
+      overlay->scale_par_n, overlay->scale_par_d,
+      overlay->info.par_n, overlay->info.par_d,
+      overlay->auto_adjust_size, overlay->use_vertical_render,
+      overlay->draw_shadow, overlay->shadow_offset,
+      overlay->draw_outline, overlay->outline_offset,
+      overlay->color, overlay->outline_color,
+      overlay->xpad, overlay->ypad,
+      overlay->halign, overlay->valign, overlay->wrap_mode,
+      overlay->line_align, font, string);
+
+  g_free (font);
+
+  return key;
+}
+
+static GstBaseTextOverlayRenderCacheEntry *
+gst_base_text_overlay_render_cache_lookup (GstBaseTextOverlay * overlay,
+    const gchar * key)
+{
+  GList *l;
+
+  for (l = overlay->render_cache.head; l != NULL; l = l->next) {
+    GstBaseTextOverlayRenderCacheEntry *entry = l->data;
+
+    if (strcmp (entry->key, key) == 0) {
+      /* move to the front so frequently shown strings stay cached */
+      g_queue_unlink (&overlay->render_cache, l);
+      g_queue_push_head_link (&overlay->render_cache, l);
+      return entry;
+    }
+  }
+
+  return NULL;
+}
+
+/* takes ownership of @key, refs the current text image */
+static void
+gst_base_text_overlay_render_cache_store (GstBaseTextOverlay * overlay,
+    gchar * key)
+{
+  GstBaseTextOverlayRenderCacheEntry *entry;
+
+  entry = g_slice_new (GstBaseTextOverlayRenderCacheEntry);
+  entry->key = key;
+  entry->image = gst_buffer_ref (overlay->text_image);
+  entry->text_width = overlay->text_width;
+  entry->text_height = overlay->text_height;
+  entry->ink_rect = overlay->ink_rect;
+  entry->logical_rect = overlay->logical_rect;
+  g_queue_push_head (&overlay->render_cache, entry);
+
+  while (overlay->render_cache.length > RENDER_CACHE_SIZE)
+    gst_base_text_overlay_render_cache_entry_free (g_queue_pop_tail
+        (&overlay->render_cache));
+}
+
 static gboolean
 gst_text_overlay_filter_foreground_attr (PangoAttribute * attr, gpointer data)
 {
@@ -1754,9 +1862,30 @@ gst_base_text_overlay_render_pangocairo (GstBaseTextOverlay * overlay,
   gint xpad = 0, ypad = 0;
   GstBuffer *buffer;
   GstMapInfo map;
+  GstBaseTextOverlayRenderCacheEntry *cached;
+  gchar *cache_key;
 
   g_mutex_lock (GST_BASE_TEXT_OVERLAY_GET_CLASS (overlay)->pango_lock);
 
+  /* identical text was rendered with identical settings before; reuse the
+   * image instead of laying out and rasterizing it again. The cached buffers
+   * are never written to after rendering, so they can be shared safely. */
+  cache_key = gst_base_text_overlay_render_cache_key (overlay, string);
+  cached = gst_base_text_overlay_render_cache_lookup (overlay, cache_key);
+  if (cached != NULL) {
+    GST_DEBUG_OBJECT (overlay, "Reusing previously rendered text image");
+    gst_buffer_replace (&overlay->text_image, cached->image);
+    overlay->text_width = cached->text_width;
+    overlay->text_height = cached->text_height;
+    overlay->ink_rect = cached->ink_rect;
+    overlay->logical_rect = cached->logical_rect;
+    g_free (cache_key);
+    g_mutex_unlock (GST_BASE_TEXT_OVERLAY_GET_CLASS (overlay)->pango_lock);
+
+    gst_base_text_overlay_set_composition (overlay);
+    return;
+  }
+
   if (overlay->auto_adjust_size) {
     /* 640 pixel is default */
     scalef_x = scalef_y = (double) (overlay->width) / DEFAULT_SCALE_BASIS;
@@ -1918,6 +2047,7 @@ gst_base_text_overlay_render_pangocairo (GstBaseTextOverlay * overlay,
   scalef_y *= overlay->render_scale;
 
   if (width <= 0 || height <= 0) {
+    g_free (cache_key);
     g_mutex_unlock (GST_BASE_TEXT_OVERLAY_GET_CLASS (overlay)->pango_lock);
     GST_DEBUG_OBJECT (overlay,
         "Overlay is outside video frame. Skipping text rendering");
@@ -1925,6 +2055,7 @@ gst_base_text_overlay_render_pangocairo (GstBaseTextOverlay * overlay,
   }
 
   if (unscaled_height <= 0 || unscaled_width <= 0) {
+    g_free (cache_key);
     g_mutex_unlock (GST_BASE_TEXT_OVERLAY_GET_CLASS (overlay)->pango_lock);
     GST_DEBUG_OBJECT (overlay,
         "Overlay is outside video frame. Skipping text rendering");
@@ -2057,6 +2188,9 @@ gst_base_text_overlay_render_pangocairo (GstBaseTextOverlay * overlay,
     overlay->text_width = width;
   if (height != 0)
     overlay->text_height = height;
+
+  /* cache_key ownership passes to the cache */
+  gst_base_text_overlay_render_cache_store (overlay, cache_key);
   g_mutex_unlock (GST_BASE_TEXT_OVERLAY_GET_CLASS (overlay)->pango_lock);
 
   gst_base_text_overlay_set_composition (overlay);
@@ -197,6 +197,8 @@ struct _GstBaseTextOverlay {
     /* rendering state */
     gboolean                 need_render;
     GstBuffer               *text_image;
+    GQueue                   render_cache;  /* recently rendered text images,
+                                             * most recently used first */
 
     /* dimension relative to witch the render is done, this is the stream size
      * or a portion of the window_size (adapted to aspect ratio) */
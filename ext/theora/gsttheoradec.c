@@ -721,11 +721,16 @@ theora_handle_image (GstTheoraDec * dec, th_ycbcr_buffer buf,
         * buf[comp].stride;
     src += (width == pic_width) ? offset_x : offset_x / 2;
 
-    for (i = 0; i < height; i++) {
-      memcpy (dest, src, width);
-
-      dest += stride;
-      src += buf[comp].stride;
+    if (G_LIKELY (height > 0) && stride == buf[comp].stride) {
+      /* same row layout on both sides, copy the plane in one go */
+      memcpy (dest, src, (gsize) (height - 1) * stride + width);
+    } else {
+      for (i = 0; i < height; i++) {
+        memcpy (dest, src, width);
+
+        dest += stride;
+        src += buf[comp].stride;
+      }
     }
   }
   gst_video_frame_unmap (&vframe);
@@ -117,6 +117,11 @@ _ilog (unsigned int v)
 #define THEORA_DEF_RATE_BUFFER          0
 #define THEORA_DEF_MULTIPASS_CACHE_FILE NULL
 #define THEORA_DEF_MULTIPASS_MODE       MULTIPASS_MODE_SINGLE_PASS
+#define THEORA_DEF_THREADS              1
+
+/* maximum number of frames waiting for the encode thread before
+ * handle_frame blocks */
+#define THEORA_MAX_PENDING_FRAMES       2
 enum
 {
   PROP_0,
@@ -132,7 +137,8 @@ enum
   PROP_CAP_UNDERFLOW,
   PROP_RATE_BUFFER,
   PROP_MULTIPASS_CACHE_FILE,
-  PROP_MULTIPASS_MODE
+  PROP_MULTIPASS_MODE,
+  PROP_THREADS
       /* FILL ME */
 };
 
@@ -198,6 +204,11 @@ static void theora_enc_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
 static void theora_enc_finalize (GObject * object);
 
+static GstFlowReturn theora_enc_encode_frame (GstTheoraEnc * enc,
+    GstVideoCodecFrame * frame);
+static void theora_enc_stop_encode_thread (GstTheoraEnc * enc);
+static GstFlowReturn theora_enc_drain_encode_thread (GstTheoraEnc * enc);
+
 static gboolean theora_enc_write_multipass_cache (GstTheoraEnc * enc,
     gboolean begin, gboolean eos);
 
@@ -300,6 +311,21 @@ gst_theora_enc_class_init (GstTheoraEncClass * klass)
           THEORA_DEF_MULTIPASS_MODE,
           (GParamFlags) G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTheoraEnc:threads:
+   *
+   * With a value above 1, encoding runs on a separate thread so it overlaps
+   * with upstream processing. libtheora itself is single-threaded, so values
+   * above 2 do not add further parallelism.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_THREADS,
+      g_param_spec_int ("threads", "Threads",
+          "Number of threads used for encoding (1 = encode on the "
+          "streaming thread)", 1, 8, THEORA_DEF_THREADS,
+          (GParamFlags) G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   GST_DEBUG_CATEGORY_INIT (theoraenc_debug, "theoraenc", 0, "Theora encoder");
 }
 
@@ -323,6 +349,11 @@ gst_theora_enc_init (GstTheoraEnc * enc)
 
   enc->multipass_mode = THEORA_DEF_MULTIPASS_MODE;
   enc->multipass_cache_file = THEORA_DEF_MULTIPASS_CACHE_FILE;
+
+  enc->threads = THEORA_DEF_THREADS;
+  g_mutex_init (&enc->encode_lock);
+  g_cond_init (&enc->encode_cond);
+  g_queue_init (&enc->encode_queue);
 }
 
 static void
@@ -357,6 +388,9 @@ theora_enc_finalize (GObject * object)
   if (enc->input_state)
     gst_video_codec_state_unref (enc->input_state);
 
+  g_mutex_clear (&enc->encode_lock);
+  g_cond_clear (&enc->encode_cond);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -374,6 +408,9 @@ theora_enc_flush (GstVideoEncoder * encoder)
     return FALSE;
   }
 
+  /* the encode thread works on enc->encoder, stop it before we replace it */
+  theora_enc_stop_encode_thread (enc);
+
   GST_OBJECT_LOCK (enc);
   enc->info.target_bitrate = enc->video_bitrate;
   enc->info.quality = enc->video_quality;
@@ -456,6 +493,7 @@ theora_enc_start (GstVideoEncoder * benc)
 
   enc->packetno = 0;
   enc->initialised = FALSE;
+  enc->headers_pushed = FALSE;
 
   return TRUE;
 }
@@ -468,6 +506,8 @@ theora_enc_stop (GstVideoEncoder * benc)
   GST_DEBUG_OBJECT (benc, "stop: clearing theora state");
   enc = GST_THEORA_ENC (benc);
 
+  theora_enc_stop_encode_thread (enc);
+
   if (enc->encoder)
     th_encode_free (enc->encoder);
   enc->encoder = NULL;
@@ -867,6 +907,99 @@ theora_enc_buffer_from_header_packet (GstTheoraEnc * enc, ogg_packet * packet)
   return outbuf;
 }
 
+static gpointer
+theora_enc_encode_thread_func (gpointer data)
+{
+  GstTheoraEnc *enc = data;
+
+  g_mutex_lock (&enc->encode_lock);
+  while (enc->encode_running) {
+    GstVideoCodecFrame *frame;
+    GstFlowReturn ret;
+
+    frame = g_queue_pop_head (&enc->encode_queue);
+    if (frame == NULL) {
+      g_cond_wait (&enc->encode_cond, &enc->encode_lock);
+      continue;
+    }
+    /* wake up a handle_frame call waiting for room in the queue */
+    g_cond_broadcast (&enc->encode_cond);
+    g_mutex_unlock (&enc->encode_lock);
+
+    ret = theora_enc_encode_frame (enc, frame);
+
+    g_mutex_lock (&enc->encode_lock);
+    enc->encode_pending--;
+    if (ret != GST_FLOW_OK && enc->encode_ret == GST_FLOW_OK)
+      enc->encode_ret = ret;
+    g_cond_broadcast (&enc->encode_cond);
+  }
+  g_mutex_unlock (&enc->encode_lock);
+
+  return NULL;
+}
+
+static void
+theora_enc_start_encode_thread (GstTheoraEnc * enc)
+{
+  if (enc->encode_thread)
+    return;
+
+  enc->encode_running = TRUE;
+  enc->encode_ret = GST_FLOW_OK;
+  enc->encode_pending = 0;
+  enc->encode_thread =
+      g_thread_new ("theoraenc-encode", theora_enc_encode_thread_func, enc);
+}
+
+/* stop the encode thread, dropping frames it has not started on yet. Called
+ * with the stream lock, which is released while joining so the thread can
+ * finish the frame it is currently encoding. */
+static void
+theora_enc_stop_encode_thread (GstTheoraEnc * enc)
+{
+  GstVideoCodecFrame *frame;
+
+  if (enc->encode_thread == NULL)
+    return;
+
+  g_mutex_lock (&enc->encode_lock);
+  enc->encode_running = FALSE;
+  while ((frame = g_queue_pop_head (&enc->encode_queue))) {
+    enc->encode_pending--;
+    gst_video_codec_frame_unref (frame);
+  }
+  g_cond_broadcast (&enc->encode_cond);
+  g_mutex_unlock (&enc->encode_lock);
+
+  GST_VIDEO_ENCODER_STREAM_UNLOCK (enc);
+  g_thread_join (enc->encode_thread);
+  GST_VIDEO_ENCODER_STREAM_LOCK (enc);
+  enc->encode_thread = NULL;
+}
+
+/* wait until the encode thread has encoded all queued frames. Called with
+ * the stream lock, which is released while waiting so the thread can push
+ * out the frames it finishes. */
+static GstFlowReturn
+theora_enc_drain_encode_thread (GstTheoraEnc * enc)
+{
+  GstFlowReturn ret;
+
+  if (enc->encode_thread == NULL)
+    return GST_FLOW_OK;
+
+  GST_VIDEO_ENCODER_STREAM_UNLOCK (enc);
+  g_mutex_lock (&enc->encode_lock);
+  while (enc->encode_running && enc->encode_pending > 0)
+    g_cond_wait (&enc->encode_cond, &enc->encode_lock);
+  ret = enc->encode_ret;
+  g_mutex_unlock (&enc->encode_lock);
+  GST_VIDEO_ENCODER_STREAM_LOCK (enc);
+
+  return ret;
+}
+
 static GstFlowReturn
 theora_enc_handle_frame (GstVideoEncoder * benc, GstVideoCodecFrame * frame)
 {
@@ -874,7 +1007,7 @@ theora_enc_handle_frame (GstVideoEncoder * benc, GstVideoCodecFrame * frame)
   ogg_packet op;
   GstClockTime timestamp, running_time;
   GstFlowReturn ret;
-  gboolean force_keyframe;
+  gint threads;
 
   enc = GST_THEORA_ENC (benc);
 
@@ -892,28 +1025,7 @@ theora_enc_handle_frame (GstVideoEncoder * benc, GstVideoCodecFrame * frame)
       gst_segment_to_running_time (&GST_VIDEO_ENCODER_INPUT_SEGMENT (enc),
       GST_FORMAT_TIME, timestamp);
 
-  GST_OBJECT_LOCK (enc);
-  if (enc->bitrate_changed) {
-    long int bitrate = enc->video_bitrate;
-
-    th_encode_ctl (enc->encoder, TH_ENCCTL_SET_BITRATE, &bitrate,
-        sizeof (long int));
-    enc->bitrate_changed = FALSE;
-  }
-
-  if (enc->quality_changed) {
-    long int quality = enc->video_quality;
-
-    th_encode_ctl (enc->encoder, TH_ENCCTL_SET_QUALITY, &quality,
-        sizeof (long int));
-    enc->quality_changed = FALSE;
-  }
-
-  /* see if we need to schedule a keyframe */
-  force_keyframe = GST_VIDEO_CODEC_FRAME_IS_FORCE_KEYFRAME (frame);
-  GST_OBJECT_UNLOCK (enc);
-
-  if (enc->packetno == 0) {
+  if (!enc->headers_pushed) {
     /* no packets written yet, setup headers */
     GstCaps *caps;
     GstBuffer *buf;
@@ -963,13 +1075,89 @@ theora_enc_handle_frame (GstVideoEncoder * benc, GstVideoCodecFrame * frame)
     gst_video_encoder_set_headers (benc, buffers);
 
     theora_enc_reset_ts (enc, running_time, frame->presentation_frame_number);
+
+    enc->headers_pushed = TRUE;
+  }
+
+  GST_OBJECT_LOCK (enc);
+  threads = enc->threads;
+  GST_OBJECT_UNLOCK (enc);
+
+  if (threads > 1) {
+    theora_enc_start_encode_thread (enc);
+
+    /* hand the frame to the encode thread; wait for room in the queue with
+     * the stream lock released so the thread can push out finished frames
+     * meanwhile */
+    GST_VIDEO_ENCODER_STREAM_UNLOCK (enc);
+    g_mutex_lock (&enc->encode_lock);
+    while (enc->encode_ret == GST_FLOW_OK &&
+        g_queue_get_length (&enc->encode_queue) >= THEORA_MAX_PENDING_FRAMES)
+      g_cond_wait (&enc->encode_cond, &enc->encode_lock);
+    ret = enc->encode_ret;
+    if (ret == GST_FLOW_OK) {
+      g_queue_push_tail (&enc->encode_queue, frame);
+      enc->encode_pending++;
+      frame = NULL;
+      g_cond_broadcast (&enc->encode_cond);
+    }
+    g_mutex_unlock (&enc->encode_lock);
+    GST_VIDEO_ENCODER_STREAM_LOCK (enc);
+
+    if (frame)
+      gst_video_codec_frame_unref (frame);
+
+    return ret;
   }
 
+  return theora_enc_encode_frame (enc, frame);
+
+  /* ERRORS */
+encoder_disabled:
+  {
+    gst_video_codec_frame_unref (frame);
+    GST_ELEMENT_ERROR (enc, STREAM, ENCODE, (NULL),
+        ("libtheora has been compiled with the encoder disabled"));
+    return GST_FLOW_ERROR;
+  }
+}
+
+/* encode one frame and push out the resulting packets. Takes ownership of
+ * @frame. Runs either on the streaming thread or, with threads > 1, on the
+ * encode thread. */
+static GstFlowReturn
+theora_enc_encode_frame (GstTheoraEnc * enc, GstVideoCodecFrame * frame)
+{
+  ogg_packet op;
+  GstFlowReturn ret;
+  gboolean force_keyframe;
+
   {
     th_ycbcr_buffer ycbcr;
     gint res, keyframe_interval;
     GstVideoFrame vframe;
 
+    GST_OBJECT_LOCK (enc);
+    if (enc->bitrate_changed) {
+      long int bitrate = enc->video_bitrate;
+
+      th_encode_ctl (enc->encoder, TH_ENCCTL_SET_BITRATE, &bitrate,
+          sizeof (long int));
+      enc->bitrate_changed = FALSE;
+    }
+
+    if (enc->quality_changed) {
+      long int quality = enc->video_quality;
+
+      th_encode_ctl (enc->encoder, TH_ENCCTL_SET_QUALITY, &quality,
+          sizeof (long int));
+      enc->quality_changed = FALSE;
+    }
+
+    /* see if we need to schedule a keyframe */
+    force_keyframe = GST_VIDEO_CODEC_FRAME_IS_FORCE_KEYFRAME (frame);
+    GST_OBJECT_UNLOCK (enc);
+
     if (force_keyframe) {
       /* if we want a keyframe, temporarily reset the max keyframe interval
        * to 1, which will cause libtheora to emit one. There is no API to
@@ -1038,13 +1226,6 @@ multipass_write_failed:
     gst_video_codec_frame_unref (frame);
     return ret;
   }
-encoder_disabled:
-  {
-    gst_video_codec_frame_unref (frame);
-    GST_ELEMENT_ERROR (enc, STREAM, ENCODE, (NULL),
-        ("libtheora has been compiled with the encoder disabled"));
-    return GST_FLOW_ERROR;
-  }
 }
 
 static gboolean
@@ -1055,6 +1236,9 @@ theora_enc_finish (GstVideoEncoder * benc)
 
   enc = GST_THEORA_ENC (benc);
 
+  /* make sure all queued frames have been encoded and pushed */
+  theora_enc_drain_encode_thread (enc);
+
   if (enc->initialised) {
     /* push last packet with eos flag, should not be called */
     while (th_encode_packetout (enc->encoder, 1, &op)) {
@@ -1138,6 +1322,11 @@ theora_enc_set_property (GObject * object, guint prop_id,
     case PROP_MULTIPASS_MODE:
       enc->multipass_mode = g_value_get_enum (value);
       break;
+    case PROP_THREADS:
+      GST_OBJECT_LOCK (enc);
+      enc->threads = g_value_get_int (value);
+      GST_OBJECT_UNLOCK (enc);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1194,6 +1383,11 @@ theora_enc_get_property (GObject * object, guint prop_id,
     case PROP_MULTIPASS_MODE:
       g_value_set_enum (value, enc->multipass_mode);
       break;
+    case PROP_THREADS:
+      GST_OBJECT_LOCK (enc);
+      g_value_set_int (value, enc->threads);
+      GST_OBJECT_UNLOCK (enc);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -104,6 +104,18 @@ struct _GstTheoraEnc
   GIOChannel *multipass_cache_fd;
   GstAdapter *multipass_cache_adapter;
   gchar *multipass_cache_file;
+
+  gint threads;
+
+  /* asynchronous encoding, used when threads > 1 */
+  GThread *encode_thread;
+  GMutex encode_lock;
+  GCond encode_cond;
+  GQueue encode_queue;          /* of GstVideoCodecFrame */
+  guint encode_pending;         /* queued plus in-flight frames */
+  gboolean encode_running;
+  GstFlowReturn encode_ret;
+  gboolean headers_pushed;
 };
 
 struct _GstTheoraEncClass
@@ -49,11 +49,23 @@ copy_samples_s (vorbis_sample_t * out, vorbis_sample_t ** in, guint samples,
   out += samples;
   memcpy (out, in[1], samples * sizeof (float));
 #else
-  gint j;
-
-  for (j = 0; j < samples; j++) {
-    *out++ = in[0][j];
-    *out++ = in[1][j];
+  const vorbis_sample_t *l = in[0], *r = in[1];
+  guint j;
+
+  for (j = 0; j + 4 <= samples; j += 4) {
+    out[0] = l[j];
+    out[1] = r[j];
+    out[2] = l[j + 1];
+    out[3] = r[j + 1];
+    out[4] = l[j + 2];
+    out[5] = r[j + 2];
+    out[6] = l[j + 3];
+    out[7] = r[j + 3];
+    out += 8;
+  }
+  for (; j < samples; j++) {
+    *out++ = l[j];
+    *out++ = r[j];
   }
 #endif
 }
@@ -71,11 +83,18 @@ copy_samples (vorbis_sample_t * out, vorbis_sample_t ** in, guint samples,
     out += samples;
   }
 #else
-  gint i, j;
+  const vorbis_sample_t *src[8];
+  gint i;
+  guint j;
+
+  /* resolve the reordered source pointers once instead of doing the
+   * double-indexed lookup for every sample */
+  for (i = 0; i < channels; i++)
+    src[i] = in[gst_vorbis_reorder_map[channels - 1][i]];
 
   for (j = 0; j < samples; j++) {
     for (i = 0; i < channels; i++) {
-      *out++ = in[gst_vorbis_reorder_map[channels - 1][i]][j];
+      *out++ = src[i][j];
     }
   }
 #endif
@@ -235,6 +235,12 @@ gst_vorbis_enc_stop (GstAudioEncoder * enc)
   GstVorbisEnc *vorbisenc = GST_VORBISENC (enc);
 
   GST_DEBUG_OBJECT (enc, "stop");
+  if (vorbisenc->packet_pool) {
+    gst_buffer_pool_set_active (vorbisenc->packet_pool, FALSE);
+    gst_object_unref (vorbisenc->packet_pool);
+    vorbisenc->packet_pool = NULL;
+    vorbisenc->packet_pool_size = 0;
+  }
   vorbis_block_clear (&vorbisenc->vb);
   vorbis_dsp_clear (&vorbisenc->vd);
   vorbis_info_clear (&vorbisenc->vi);
@@ -917,22 +923,27 @@ gst_vorbis_enc_handle_frame (GstAudioEncoder * enc, GstBuffer * buffer)
   vorbis_buffer = vorbis_analysis_buffer (&vorbisenc->vd, size);
 
   /* deinterleave samples, write the buffer data */
-  if (vorbisenc->channels < 2 || vorbisenc->channels > 8) {
+  if (vorbisenc->channels == 1) {
+    memcpy (vorbis_buffer[0], ptr, size * sizeof (gfloat));
+  } else if (vorbisenc->channels > 8) {
     for (i = 0; i < size; i++) {
       for (j = 0; j < vorbisenc->channels; j++) {
         vorbis_buffer[j][i] = *ptr++;
       }
     }
   } else {
-    gint i, j;
-
-    /* Reorder */
-    for (i = 0; i < size; i++) {
-      for (j = 0; j < vorbisenc->channels; j++) {
-        vorbis_buffer[gst_vorbis_reorder_map[vorbisenc->channels - 1][j]][i] =
-            ptr[j];
-      }
-      ptr += vorbisenc->channels;
+    gint j;
+
+    /* Reorder; fill one analysis channel at a time so each destination
+     * is written sequentially instead of doing a mapped scatter per
+     * sample */
+    for (j = 0; j < vorbisenc->channels; j++) {
+      gfloat *dst =
+          vorbis_buffer[gst_vorbis_reorder_map[vorbisenc->channels - 1][j]];
+      const gfloat *src = ptr + j;
+
+      for (i = 0; i < size; i++)
+        dst[i] = src[i * vorbisenc->channels];
     }
   }
 
@@ -947,6 +958,58 @@ gst_vorbis_enc_handle_frame (GstAudioEncoder * enc, GstBuffer * buffer)
   return ret;
 }
 
+/* The encoded packets are small and frequent; recycle the output
+ * buffers through a private pool instead of allocating a fresh one per
+ * packet. The pool is sized to the largest packet seen so far and
+ * recreated when a bigger one shows up, which settles after the first
+ * few frames. */
+static GstBuffer *
+gst_vorbis_enc_alloc_packet_buffer (GstVorbisEnc * vorbisenc, gsize bytes)
+{
+  GstBuffer *buf = NULL;
+
+  if (vorbisenc->packet_pool != NULL && vorbisenc->packet_pool_size < bytes) {
+    gst_buffer_pool_set_active (vorbisenc->packet_pool, FALSE);
+    gst_object_unref (vorbisenc->packet_pool);
+    vorbisenc->packet_pool = NULL;
+  }
+
+  if (vorbisenc->packet_pool == NULL) {
+    GstBufferPool *pool;
+    GstStructure *config;
+    guint size = 4096;
+
+    while (size < bytes)
+      size <<= 1;
+
+    pool = gst_buffer_pool_new ();
+    config = gst_buffer_pool_get_config (pool);
+    gst_buffer_pool_config_set_params (config, NULL, size, 0, 0);
+    if (!gst_buffer_pool_set_config (pool, config)
+        || !gst_buffer_pool_set_active (pool, TRUE)) {
+      GST_WARNING_OBJECT (vorbisenc, "failed to set up packet pool");
+      gst_object_unref (pool);
+      goto fallback;
+    }
+
+    GST_DEBUG_OBJECT (vorbisenc, "new packet pool, buffer size %u", size);
+    vorbisenc->packet_pool = pool;
+    vorbisenc->packet_pool_size = size;
+  }
+
+  if (gst_buffer_pool_acquire_buffer (vorbisenc->packet_pool, &buf,
+          NULL) != GST_FLOW_OK)
+    goto fallback;
+
+  gst_buffer_set_size (buf, bytes);
+
+  return buf;
+
+fallback:
+  return gst_audio_encoder_allocate_output_buffer (GST_AUDIO_ENCODER
+      (vorbisenc), bytes);
+}
+
 static GstFlowReturn
 gst_vorbis_enc_output_buffers (GstVorbisEnc * vorbisenc)
 {
@@ -969,9 +1032,7 @@ gst_vorbis_enc_output_buffers (GstVorbisEnc * vorbisenc)
       GstBuffer *buf;
 
       GST_LOG_OBJECT (vorbisenc, "pushing out a data packet");
-      buf =
-          gst_audio_encoder_allocate_output_buffer (GST_AUDIO_ENCODER
-          (vorbisenc), op.bytes);
+      buf = gst_vorbis_enc_alloc_packet_buffer (vorbisenc, op.bytes);
       gst_buffer_fill (buf, 0, op.packet, op.bytes);
 
       /* we have to call this every packet, not just on e_o_s, since
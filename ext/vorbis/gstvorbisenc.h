@@ -84,6 +84,10 @@ struct _GstVorbisEnc {
   int              last_size;
   int              vorbis_log2_num_modes;
   int              vorbis_mode_sizes[256];
+
+  /* recycles output buffers for the encoded packets */
+  GstBufferPool   *packet_pool;
+  guint            packet_pool_size;
 };
 
 struct _GstVorbisEncClass {
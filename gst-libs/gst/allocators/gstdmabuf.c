@@ -103,6 +103,81 @@ gst_dmabuf_allocator_alloc (GstAllocator * allocator, gint fd, gsize size)
   return gst_fd_allocator_alloc (allocator, fd, size, GST_FD_MEMORY_FLAG_NONE);
 }
 
+/**
+ * gst_dmabuf_allocator_alloc_with_flags:
+ * @allocator: allocator to be used for this memory
+ * @fd: dmabuf file descriptor
+ * @size: memory size
+ * @flags: extra #GstFdMemoryFlags
+ *
+ * Return a %GstMemory that wraps a dmabuf file descriptor.
+ *
+ * Returns: (transfer full): a GstMemory based on @allocator.
+ *
+ * When the buffer will be released the allocator will close the @fd unless
+ * the %GST_FD_MEMORY_FLAG_DONT_CLOSE flag is specified.
+ * The memory is only mmapped on gst_buffer_mmap() request, unless the
+ * %GST_FD_MEMORY_FLAG_MAP_PERSISTENT flag is specified.
+ *
+ * Since: 1.14
+ */
+GstMemory *
+gst_dmabuf_allocator_alloc_with_flags (GstAllocator * allocator, gint fd,
+    gsize size, GstFdMemoryFlags flags)
+{
+  g_return_val_if_fail (GST_IS_DMABUF_ALLOCATOR (allocator), NULL);
+
+  return gst_fd_allocator_alloc (allocator, fd, size, flags);
+}
+
+/**
+ * gst_dmabuf_allocator_alloc_batch:
+ * @allocator: allocator to be used for this memory
+ * @fds: (array length=n_memories): array of dmabuf file descriptors
+ * @sizes: (array length=n_memories): memory size of each file descriptor
+ * @n_memories: number of file descriptors
+ * @flags: extra #GstFdMemoryFlags, applied to every memory
+ *
+ * Wrap an array of dmabuf file descriptors into a single #GstBuffer with
+ * one #GstMemory per descriptor. This is a convenience for importers that
+ * receive complete frame sets, e.g. one descriptor per plane, and avoids
+ * allocating and appending the memories one by one in the capture path.
+ *
+ * Returns: (transfer full) (nullable): a #GstBuffer with @n_memories
+ * memories, or %NULL if a memory could not be allocated. When the buffer
+ * is released the file descriptors are closed unless the
+ * %GST_FD_MEMORY_FLAG_DONT_CLOSE flag is specified.
+ *
+ * Since: 1.14
+ */
+GstBuffer *
+gst_dmabuf_allocator_alloc_batch (GstAllocator * allocator, const gint * fds,
+    const gsize * sizes, guint n_memories, GstFdMemoryFlags flags)
+{
+  GstBuffer *buffer;
+  GstMemory *mem;
+  guint i;
+
+  g_return_val_if_fail (GST_IS_DMABUF_ALLOCATOR (allocator), NULL);
+  g_return_val_if_fail (fds != NULL, NULL);
+  g_return_val_if_fail (sizes != NULL, NULL);
+  g_return_val_if_fail (n_memories > 0, NULL);
+
+  buffer = gst_buffer_new ();
+
+  for (i = 0; i < n_memories; i++) {
+    mem = gst_fd_allocator_alloc (allocator, fds[i], sizes[i], flags);
+    if (mem == NULL) {
+      GST_ERROR ("Failed to wrap dmabuf fd %d", fds[i]);
+      gst_buffer_unref (buffer);
+      return NULL;
+    }
+    gst_buffer_append_memory (buffer, mem);
+  }
+
+  return buffer;
+}
+
 /**
  * gst_dmabuf_memory_get_fd:
  * @mem: the memory to get the file descriptor
@@ -104,6 +104,15 @@ GstAllocator * gst_dmabuf_allocator_new (void);
 GST_EXPORT
 GstMemory    * gst_dmabuf_allocator_alloc (GstAllocator * allocator, gint fd, gsize size);
 
+GST_EXPORT
+GstMemory    * gst_dmabuf_allocator_alloc_with_flags (GstAllocator * allocator, gint fd, gsize size,
+                                                      GstFdMemoryFlags flags);
+
+GST_EXPORT
+GstBuffer    * gst_dmabuf_allocator_alloc_batch (GstAllocator * allocator, const gint * fds,
+                                                 const gsize * sizes, guint n_memories,
+                                                 GstFdMemoryFlags flags);
+
 GST_EXPORT
 gint           gst_dmabuf_memory_get_fd (GstMemory * mem);
 
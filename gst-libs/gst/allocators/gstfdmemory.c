@@ -75,6 +75,62 @@ gst_fd_mem_free (GstAllocator * allocator, GstMemory * gmem)
 #endif
 }
 
+#ifdef HAVE_MMAP
+/* called with the lock and with mem->data == NULL */
+static gboolean
+gst_fd_mem_mmap_locked (GstFdMemory * mem, gint prot)
+{
+  GstMemory *gmem = GST_MEMORY_CAST (mem);
+  gint flags;
+
+  if (mem->fd == -1)
+    return FALSE;
+
+  flags =
+      (mem->flags & GST_FD_MEMORY_FLAG_MAP_PRIVATE) ? MAP_PRIVATE : MAP_SHARED;
+
+  mem->data = mmap (0, gmem->maxsize, prot, flags, mem->fd, 0);
+  if (mem->data == MAP_FAILED) {
+    GstDebugLevel level;
+    mem->data = NULL;
+
+    switch (errno) {
+      case EACCES:
+        level = GST_LEVEL_INFO;
+        break;
+      default:
+        level = GST_LEVEL_ERROR;
+        break;
+    }
+
+    GST_CAT_LEVEL_LOG (GST_CAT_DEFAULT, level, NULL,
+        "%p: fd %d: mmap failed: %s", mem, mem->fd, g_strerror (errno));
+    return FALSE;
+  }
+
+#ifdef MADV_SEQUENTIAL
+  if (mem->flags & GST_FD_MEMORY_FLAG_ADVISE_SEQUENTIAL) {
+    if (madvise (mem->data, gmem->maxsize, MADV_SEQUENTIAL) != 0)
+      GST_DEBUG ("%p: fd %d: madvise (MADV_SEQUENTIAL) failed: %s", mem,
+          mem->fd, g_strerror (errno));
+  }
+#endif
+#ifdef MADV_WILLNEED
+  if (mem->flags & GST_FD_MEMORY_FLAG_ADVISE_WILLNEED) {
+    if (madvise (mem->data, gmem->maxsize, MADV_WILLNEED) != 0)
+      GST_DEBUG ("%p: fd %d: madvise (MADV_WILLNEED) failed: %s", mem,
+          mem->fd, g_strerror (errno));
+  }
+#endif
+
+  mem->mmapping_flags = prot;
+
+  GST_DEBUG ("%p: fd %d: mapped %p", mem, mem->fd, mem->data);
+
+  return TRUE;
+}
+#endif
+
 static gpointer
 gst_fd_mem_map (GstMemory * gmem, gsize maxsize, GstMapFlags flags)
 {
@@ -102,37 +158,7 @@ gst_fd_mem_map (GstMemory * gmem, gsize maxsize, GstMapFlags flags)
     goto out;
   }
 
-  if (mem->fd != -1) {
-    gint flags;
-
-    flags =
-        (mem->flags & GST_FD_MEMORY_FLAG_MAP_PRIVATE) ? MAP_PRIVATE :
-        MAP_SHARED;
-
-    mem->data = mmap (0, gmem->maxsize, prot, flags, mem->fd, 0);
-    if (mem->data == MAP_FAILED) {
-      GstDebugLevel level;
-      mem->data = NULL;
-
-      switch (errno) {
-        case EACCES:
-          level = GST_LEVEL_INFO;
-          break;
-        default:
-          level = GST_LEVEL_ERROR;
-          break;
-      }
-
-      GST_CAT_LEVEL_LOG (GST_CAT_DEFAULT, level, NULL,
-          "%p: fd %d: mmap failed: %s", mem, mem->fd, g_strerror (errno));
-      goto out;
-    }
-  }
-
-  GST_DEBUG ("%p: fd %d: mapped %p", mem, mem->fd, mem->data);
-
-  if (mem->data) {
-    mem->mmapping_flags = prot;
+  if (gst_fd_mem_mmap_locked (mem, prot)) {
     mem->mmap_count++;
     ret = mem->data;
   }
@@ -265,7 +291,9 @@ gst_fd_allocator_new (void)
  * Returns: (transfer full): a GstMemory based on @allocator.
  * When the buffer will be released the allocator will close the @fd unless
  * the %GST_FD_MEMORY_FLAG_DONT_CLOSE flag is specified.
- * The memory is only mmapped on gst_buffer_mmap() request.
+ * The memory is only mmapped on gst_buffer_mmap() request, unless the
+ * %GST_FD_MEMORY_FLAG_MAP_PERSISTENT flag is specified, in which case it
+ * is mapped immediately and stays mapped until the memory is destroyed.
  *
  * Since: 1.6
  */
@@ -283,9 +311,20 @@ gst_fd_allocator_alloc (GstAllocator * allocator, gint fd, gsize size,
       NULL, size, 0, 0, size);
 
   mem->flags = flags;
+  if (flags & GST_FD_MEMORY_FLAG_MAP_PERSISTENT)
+    mem->flags |= GST_FD_MEMORY_FLAG_KEEP_MAPPED;
   mem->fd = fd;
   g_mutex_init (&mem->lock);
 
+  if (mem->flags & GST_FD_MEMORY_FLAG_MAP_PERSISTENT) {
+    /* map right away so map requests from the streaming thread never have
+     * to mmap; if the fd is not mappable for writing this fails and we
+     * fall back to mapping on request */
+    g_mutex_lock (&mem->lock);
+    gst_fd_mem_mmap_locked (mem, PROT_READ | PROT_WRITE);
+    g_mutex_unlock (&mem->lock);
+  }
+
   GST_DEBUG ("%p: fd: %d size %" G_GSIZE_FORMAT, mem, mem->fd,
       mem->mem.maxsize);
 
@@ -47,6 +47,15 @@ typedef struct _GstFdAllocatorClass GstFdAllocatorClass;
  *        the default shared mapping.
  * @GST_FD_MEMORY_FLAG_DONT_CLOSE: don't close the file descriptor when
  *        the memory is freed. Since: 1.10.
+ * @GST_FD_MEMORY_FLAG_MAP_PERSISTENT: map the memory for reading and
+ *        writing when it is allocated and keep the mapping until the memory
+ *        is destroyed, so that map requests from the streaming thread never
+ *        have to mmap. Implies @GST_FD_MEMORY_FLAG_KEEP_MAPPED. Since: 1.14.
+ * @GST_FD_MEMORY_FLAG_ADVISE_SEQUENTIAL: hint the kernel that the mapping
+ *        will be accessed sequentially (madvise MADV_SEQUENTIAL).
+ *        Since: 1.14.
+ * @GST_FD_MEMORY_FLAG_ADVISE_WILLNEED: hint the kernel that the mapping
+ *        will be needed soon (madvise MADV_WILLNEED). Since: 1.14.
  *
  * Various flags to control the operation of the fd backed memory.
  *
@@ -57,6 +66,9 @@ typedef enum {
   GST_FD_MEMORY_FLAG_KEEP_MAPPED = (1 << 0),
   GST_FD_MEMORY_FLAG_MAP_PRIVATE = (1 << 1),
   GST_FD_MEMORY_FLAG_DONT_CLOSE  = (1 << 2),
+  GST_FD_MEMORY_FLAG_MAP_PERSISTENT = (1 << 3),
+  GST_FD_MEMORY_FLAG_ADVISE_SEQUENTIAL = (1 << 4),
+  GST_FD_MEMORY_FLAG_ADVISE_WILLNEED = (1 << 5),
 } GstFdMemoryFlags;
 
 /**
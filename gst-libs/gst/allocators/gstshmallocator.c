@@ -0,0 +1,168 @@
+/* GStreamer shared memory allocator
+ * Copyright (C) 2018 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstfdmemory.h"
+#include "gstshmallocator.h"
+
+/**
+ * SECTION:gstshmallocator
+ * @title: GstShmAllocator
+ * @short_description: Allocator for file-descriptor backed shared memory
+ * @see_also: #GstMemory and #GstFdAllocator
+ *
+ * This allocator creates anonymous shared memory with memfd_create() and
+ * seals the size of every allocation, so the file descriptor behind a
+ * #GstMemory can be passed to another process, for example over a unix
+ * domain socket, and mapped there for zero-copy frame handoff.
+ *
+ * The allocated memories are regular fd memories: use
+ * gst_fd_memory_get_fd() to get the descriptor to serialize, and wrap the
+ * received descriptor on the other side with gst_fd_allocator_alloc().
+ *
+ * Since: 1.14
+ */
+
+#ifdef HAVE_MEMFD_CREATE
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+GST_DEBUG_CATEGORY_STATIC (shm_debug);
+#define GST_CAT_DEFAULT shm_debug
+
+G_DEFINE_TYPE (GstShmAllocator, gst_shm_allocator, GST_TYPE_FD_ALLOCATOR);
+
+static GstMemory *
+gst_shm_allocator_alloc (GstAllocator * allocator, gsize size,
+    GstAllocationParams * params)
+{
+#ifdef HAVE_MEMFD_CREATE
+  GstMemory *mem;
+  gsize maxsize;
+  gint fd;
+
+  maxsize = size + params->prefix + params->padding;
+
+  fd = memfd_create ("GStreamer-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd < 0) {
+    GST_ERROR_OBJECT (allocator, "memfd_create failed: %s",
+        g_strerror (errno));
+    return NULL;
+  }
+
+  if (ftruncate (fd, maxsize) < 0) {
+    GST_ERROR_OBJECT (allocator,
+        "ftruncate to %" G_GSIZE_FORMAT " failed: %s", maxsize,
+        g_strerror (errno));
+    close (fd);
+    return NULL;
+  }
+
+  /* seal the size so importers can trust it; mapping is still allowed */
+  if (fcntl (fd, F_ADD_SEALS, F_SEAL_GROW | F_SEAL_SHRINK | F_SEAL_SEAL) < 0)
+    GST_WARNING_OBJECT (allocator, "failed to seal memfd: %s",
+        g_strerror (errno));
+
+  mem = gst_fd_allocator_alloc (allocator, fd, maxsize,
+      GST_FD_MEMORY_FLAG_KEEP_MAPPED);
+  if (mem == NULL) {
+    close (fd);
+    return NULL;
+  }
+
+  if (params->prefix || maxsize != size)
+    gst_memory_resize (mem, params->prefix, size);
+
+  return mem;
+#else /* !HAVE_MEMFD_CREATE */
+  return NULL;
+#endif
+}
+
+static void
+gst_shm_allocator_class_init (GstShmAllocatorClass * klass)
+{
+  GstAllocatorClass *allocator_class = (GstAllocatorClass *) klass;
+
+  allocator_class->alloc = gst_shm_allocator_alloc;
+}
+
+static void
+gst_shm_allocator_init (GstShmAllocator * allocator)
+{
+  GstAllocator *alloc = GST_ALLOCATOR_CAST (allocator);
+
+  alloc->mem_type = GST_ALLOCATOR_SHM;
+
+  /* unlike the base fd allocator we can allocate memory ourselves */
+  GST_OBJECT_FLAG_UNSET (allocator, GST_ALLOCATOR_FLAG_CUSTOM_ALLOC);
+}
+
+/**
+ * gst_shm_allocator_new:
+ *
+ * Return a new shm allocator. Memory is allocated with
+ * gst_allocator_alloc() on it.
+ *
+ * Returns: (transfer full): a new shm allocator, or NULL if the allocator
+ *    isn't available. Use gst_object_unref() to release the allocator after
+ *    usage
+ *
+ * Since: 1.14
+ */
+GstAllocator *
+gst_shm_allocator_new (void)
+{
+#ifdef HAVE_MEMFD_CREATE
+  GstAllocator *alloc;
+
+  GST_DEBUG_CATEGORY_INIT (shm_debug, "shmallocator", 0, "shm memory");
+
+  alloc = g_object_new (GST_TYPE_SHM_ALLOCATOR, NULL);
+  gst_object_ref_sink (alloc);
+
+  return alloc;
+#else /* !HAVE_MEMFD_CREATE */
+  return NULL;
+#endif
+}
+
+/**
+ * gst_is_shm_memory:
+ * @mem: the memory to be check
+ *
+ * Check if @mem is shm memory.
+ *
+ * Returns: %TRUE if @mem is shm memory, otherwise %FALSE
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_is_shm_memory (GstMemory * mem)
+{
+  g_return_val_if_fail (mem != NULL, FALSE);
+
+  return GST_IS_SHM_ALLOCATOR (mem->allocator);
+}
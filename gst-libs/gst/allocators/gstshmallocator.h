@@ -0,0 +1,89 @@
+/* GStreamer shared memory allocator
+ * Copyright (C) 2018 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_SHM_ALLOCATOR_H__
+#define __GST_SHM_ALLOCATOR_H__
+
+#include <gst/gst.h>
+#include <gst/allocators/gstfdmemory.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GST_ALLOCATOR_SHM:
+ *
+ * Name of the shared memory allocator, to be used for example with
+ * gst_allocator_find().
+ *
+ * Since: 1.14
+ */
+#define GST_ALLOCATOR_SHM "shm"
+
+#define GST_TYPE_SHM_ALLOCATOR              (gst_shm_allocator_get_type())
+#define GST_IS_SHM_ALLOCATOR(obj)           (G_TYPE_CHECK_INSTANCE_TYPE ((obj), GST_TYPE_SHM_ALLOCATOR))
+#define GST_IS_SHM_ALLOCATOR_CLASS(klass)   (G_TYPE_CHECK_CLASS_TYPE ((klass), GST_TYPE_SHM_ALLOCATOR))
+#define GST_SHM_ALLOCATOR_GET_CLASS(obj)    (G_TYPE_INSTANCE_GET_CLASS ((obj), GST_TYPE_SHM_ALLOCATOR, GstShmAllocatorClass))
+#define GST_SHM_ALLOCATOR(obj)              (G_TYPE_CHECK_INSTANCE_CAST ((obj), GST_TYPE_SHM_ALLOCATOR, GstShmAllocator))
+#define GST_SHM_ALLOCATOR_CLASS(klass)      (G_TYPE_CHECK_CLASS_CAST ((klass), GST_TYPE_SHM_ALLOCATOR, GstShmAllocatorClass))
+#define GST_SHM_ALLOCATOR_CAST(obj)         ((GstShmAllocator *)(obj))
+
+typedef struct _GstShmAllocator GstShmAllocator;
+typedef struct _GstShmAllocatorClass GstShmAllocatorClass;
+
+/**
+ * GstShmAllocator:
+ *
+ * Allocator for anonymous shared memory backed by sealed memfd file
+ * descriptors.
+ *
+ * Since: 1.14
+ */
+struct _GstShmAllocator
+{
+  GstFdAllocator parent;
+
+  /*< private >*/
+  gpointer _gst_reserved[GST_PADDING];
+};
+
+struct _GstShmAllocatorClass
+{
+  GstFdAllocatorClass parent_class;
+
+  /*< private >*/
+  gpointer _gst_reserved[GST_PADDING];
+};
+
+
+GST_EXPORT
+GType          gst_shm_allocator_get_type (void);
+
+GST_EXPORT
+GstAllocator * gst_shm_allocator_new (void);
+
+GST_EXPORT
+gboolean       gst_is_shm_memory (GstMemory * mem);
+
+
+#ifdef G_DEFINE_AUTOPTR_CLEANUP_FUNC
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstShmAllocator, gst_object_unref)
+#endif
+
+G_END_DECLS
+#endif /* __GST_SHM_ALLOCATOR_H__ */
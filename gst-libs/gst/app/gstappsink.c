@@ -60,6 +60,13 @@
  *
  * The eos signal can also be used to be informed when the EOS state is reached
  * to avoid polling.
+ *
+ * Applications that want to batch their pulls instead of waking up for every
+ * buffer can use the "low-watermark" and "high-watermark" properties: when
+ * both are configured, appsink emits the edge-triggered "high-watermark"
+ * signal once the queue fills up to the high mark, the application drains it
+ * with the pull APIs, and the "low-watermark" signal re-arms the cycle once
+ * the fill level has fallen back to the low mark.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -75,6 +82,10 @@
 
 #include "gstappsink.h"
 
+/* residency histogram: bucket 0 is < 1ms, bucket i is [2^(i-1), 2^i) ms,
+ * the last bucket collects everything longer */
+#define N_RESIDENCY_BUCKETS 14
+
 struct _GstAppSinkPrivate
 {
   GstCaps *caps;
@@ -98,6 +109,22 @@ struct _GstAppSinkPrivate
   gboolean is_eos;
   gboolean buffer_lists_supported;
 
+  /* watermark hysteresis, protected by @mutex: TRUE between the emission of
+   * "high-watermark" and the fill level falling back to @low_watermark */
+  guint low_watermark;
+  guint high_watermark;
+  gboolean above_watermark;
+
+  /* queue telemetry, protected by @mutex. @queue_times mirrors @queue and
+   * holds the enqueue time of every object still queued */
+  GQueue *queue_times;
+  guint max_level_buffers;
+  guint64 stat_dequeued;
+  guint64 stat_dropped;
+  guint64 residency_sum;
+  guint64 residency_max;
+  guint64 residency_hist[N_RESIDENCY_BUCKETS];
+
   GstAppSinkCallbacks callbacks;
   gpointer user_data;
   GDestroyNotify notify;
@@ -112,6 +139,8 @@ enum
   SIGNAL_EOS,
   SIGNAL_NEW_PREROLL,
   SIGNAL_NEW_SAMPLE,
+  SIGNAL_HIGH_WATERMARK,
+  SIGNAL_LOW_WATERMARK,
 
   /* actions */
   SIGNAL_PULL_PREROLL,
@@ -128,6 +157,8 @@ enum
 #define DEFAULT_PROP_DROP		FALSE
 #define DEFAULT_PROP_WAIT_ON_EOS	TRUE
 #define DEFAULT_PROP_BUFFER_LIST	FALSE
+#define DEFAULT_PROP_LOW_WATERMARK	0
+#define DEFAULT_PROP_HIGH_WATERMARK	0
 
 enum
 {
@@ -139,6 +170,9 @@ enum
   PROP_DROP,
   PROP_WAIT_ON_EOS,
   PROP_BUFFER_LIST,
+  PROP_STATS,
+  PROP_LOW_WATERMARK,
+  PROP_HIGH_WATERMARK,
   PROP_LAST
 };
 
@@ -245,6 +279,52 @@ gst_app_sink_class_init (GstAppSinkClass * klass)
           DEFAULT_PROP_WAIT_ON_EOS,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAppSink::stats:
+   *
+   * Queue statistics as a #GstStructure: how many buffers were pulled and
+   * dropped, the current and highest fill level, and how long objects
+   * stayed queued between the streaming thread and the application
+   * (average, maximum and a logarithmic milliseconds histogram). Reading
+   * the property takes a consistent snapshot.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Stats",
+          "Queue residency and fill level statistics",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAppSink::low-watermark:
+   *
+   * Fill level, in buffers, at which the "low-watermark" signal is emitted
+   * once the queue drains after a "high-watermark" emission.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_LOW_WATERMARK,
+      g_param_spec_uint ("low-watermark", "Low Watermark",
+          "Emit the low-watermark signal when the queue drains to this many "
+          "buffers after high-watermark was signalled",
+          0, G_MAXUINT, DEFAULT_PROP_LOW_WATERMARK,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAppSink::high-watermark:
+   *
+   * Fill level, in buffers, at which the "high-watermark" signal is emitted.
+   * 0 (the default) disables both watermark signals.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_HIGH_WATERMARK,
+      g_param_spec_uint ("high-watermark", "High Watermark",
+          "Emit the high-watermark signal when the queue fills up to this "
+          "many buffers (0 = disabled)",
+          0, G_MAXUINT, DEFAULT_PROP_HIGH_WATERMARK,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstAppSink::eos:
    * @appsink: the appsink element that emitted the signal
@@ -296,6 +376,40 @@ gst_app_sink_class_init (GstAppSinkClass * klass)
       g_signal_new ("new-sample", G_TYPE_FROM_CLASS (klass), G_SIGNAL_RUN_LAST,
       G_STRUCT_OFFSET (GstAppSinkClass, new_sample),
       NULL, NULL, NULL, GST_TYPE_FLOW_RETURN, 0, G_TYPE_NONE);
+  /**
+   * GstAppSink::high-watermark:
+   * @appsink: the appsink element that emitted the signal
+   *
+   * Signal that the queue fill level has risen to the "high-watermark"
+   * property. The signal is edge-triggered: it is emitted once per crossing
+   * and only re-armed after the fill level has fallen back to the
+   * "low-watermark" property. Unlike "new-sample" it does not require the
+   * "emit-signals" property, since it fires at most once per batch.
+   *
+   * This signal is emitted from the streaming thread.
+   *
+   * Since: 1.14
+   */
+  gst_app_sink_signals[SIGNAL_HIGH_WATERMARK] =
+      g_signal_new ("high-watermark", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST, 0, NULL, NULL, g_cclosure_marshal_VOID__VOID,
+      G_TYPE_NONE, 0, G_TYPE_NONE);
+  /**
+   * GstAppSink::low-watermark:
+   * @appsink: the appsink element that emitted the signal
+   *
+   * Signal that the queue fill level has fallen back to the "low-watermark"
+   * property after a "high-watermark" emission, re-arming the high
+   * watermark.
+   *
+   * This signal is emitted from the thread that pulls samples.
+   *
+   * Since: 1.14
+   */
+  gst_app_sink_signals[SIGNAL_LOW_WATERMARK] =
+      g_signal_new ("low-watermark", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST, 0, NULL, NULL, g_cclosure_marshal_VOID__VOID,
+      G_TYPE_NONE, 0, G_TYPE_NONE);
 
   /**
    * GstAppSink::pull-preroll:
@@ -451,12 +565,116 @@ gst_app_sink_init (GstAppSink * appsink)
   g_mutex_init (&priv->mutex);
   g_cond_init (&priv->cond);
   priv->queue = g_queue_new ();
+  priv->queue_times = g_queue_new ();
 
   priv->emit_signals = DEFAULT_PROP_EMIT_SIGNALS;
   priv->max_buffers = DEFAULT_PROP_MAX_BUFFERS;
   priv->drop = DEFAULT_PROP_DROP;
   priv->wait_on_eos = DEFAULT_PROP_WAIT_ON_EOS;
   priv->buffer_lists_supported = DEFAULT_PROP_BUFFER_LIST;
+  priv->low_watermark = DEFAULT_PROP_LOW_WATERMARK;
+  priv->high_watermark = DEFAULT_PROP_HIGH_WATERMARK;
+}
+
+/* called with the appsink mutex after the fill level rose: returns whether
+ * the high watermark was crossed upwards and the signal should be emitted
+ * (after releasing the mutex) */
+static gboolean
+gst_app_sink_check_high_watermark (GstAppSinkPrivate * priv)
+{
+  if (priv->high_watermark == 0 || priv->above_watermark)
+    return FALSE;
+  if (priv->num_buffers < priv->high_watermark)
+    return FALSE;
+  priv->above_watermark = TRUE;
+  return TRUE;
+}
+
+/* called with the appsink mutex after the fill level fell: returns whether
+ * the low watermark was crossed downwards and the signal should be emitted
+ * (after releasing the mutex) */
+static gboolean
+gst_app_sink_check_low_watermark (GstAppSinkPrivate * priv)
+{
+  if (!priv->above_watermark || priv->num_buffers > priv->low_watermark)
+    return FALSE;
+  priv->above_watermark = FALSE;
+  return TRUE;
+}
+
+/* called with the appsink mutex after pushing one object on the queue:
+ * remember when it was enqueued and track the highest fill level */
+static void
+gst_app_sink_stats_enqueued (GstAppSinkPrivate * priv)
+{
+  gint64 *enqueued = g_new (gint64, 1);
+
+  *enqueued = g_get_monotonic_time ();
+  g_queue_push_tail (priv->queue_times, enqueued);
+  if (priv->num_buffers > priv->max_level_buffers)
+    priv->max_level_buffers = priv->num_buffers;
+}
+
+/* called with the appsink mutex after popping one object from the queue:
+ * fold the time it spent queued into the counters, or count it as dropped */
+static void
+gst_app_sink_stats_dequeued (GstAppSinkPrivate * priv, gboolean dropped)
+{
+  gint64 *enqueued;
+  guint64 residency, ms;
+  guint bucket = 0;
+
+  enqueued = g_queue_pop_head (priv->queue_times);
+  if (enqueued == NULL)
+    return;
+
+  if (dropped) {
+    priv->stat_dropped++;
+  } else {
+    residency = (g_get_monotonic_time () - *enqueued) * 1000;
+    priv->stat_dequeued++;
+    priv->residency_sum += residency;
+    if (residency > priv->residency_max)
+      priv->residency_max = residency;
+    for (ms = residency / GST_MSECOND; ms > 0; ms >>= 1) {
+      if (++bucket == N_RESIDENCY_BUCKETS - 1)
+        break;
+    }
+    priv->residency_hist[bucket]++;
+  }
+  g_free (enqueued);
+}
+
+/* called with the appsink mutex */
+static GstStructure *
+gst_app_sink_create_stats (GstAppSink * appsink)
+{
+  GstAppSinkPrivate *priv = appsink->priv;
+  GstStructure *s;
+  GValue hist = G_VALUE_INIT;
+  GValue v = G_VALUE_INIT;
+  guint i;
+
+  s = gst_structure_new ("application/x-appsink-stats",
+      "dequeued", G_TYPE_UINT64, priv->stat_dequeued,
+      "dropped", G_TYPE_UINT64, priv->stat_dropped,
+      "current-level-buffers", G_TYPE_UINT, priv->num_buffers,
+      "max-level-buffers", G_TYPE_UINT, priv->max_level_buffers,
+      "avg-residency", G_TYPE_UINT64,
+      priv->stat_dequeued ? priv->residency_sum / priv->stat_dequeued :
+      G_GUINT64_CONSTANT (0),
+      "max-residency", G_TYPE_UINT64, priv->residency_max, NULL);
+
+  g_value_init (&hist, GST_TYPE_ARRAY);
+  g_value_init (&v, G_TYPE_UINT64);
+  for (i = 0; i < N_RESIDENCY_BUCKETS; i++) {
+    g_value_set_uint64 (&v, priv->residency_hist[i]);
+    gst_value_array_append_value (&hist, &v);
+  }
+  g_value_unset (&v);
+  gst_structure_take_value (s, "residency-histogram", &hist);
+
+  return s;
 }
 
 static void
@@ -480,8 +698,10 @@ gst_app_sink_dispose (GObject * obj)
   GST_OBJECT_UNLOCK (appsink);
 
   g_mutex_lock (&priv->mutex);
-  while ((queue_obj = g_queue_pop_head (priv->queue)))
+  while ((queue_obj = g_queue_pop_head (priv->queue))) {
     gst_mini_object_unref (queue_obj);
+    gst_app_sink_stats_dequeued (priv, TRUE);
+  }
   gst_buffer_replace (&priv->preroll, NULL);
   gst_caps_replace (&priv->preroll_caps, NULL);
   gst_caps_replace (&priv->last_caps, NULL);
@@ -499,6 +719,7 @@ gst_app_sink_finalize (GObject * obj)
   g_mutex_clear (&priv->mutex);
   g_cond_clear (&priv->cond);
   g_queue_free (priv->queue);
+  g_queue_free_full (priv->queue_times, g_free);
 
   G_OBJECT_CLASS (parent_class)->finalize (obj);
 }
@@ -529,6 +750,16 @@ gst_app_sink_set_property (GObject * object, guint prop_id,
     case PROP_WAIT_ON_EOS:
       gst_app_sink_set_wait_on_eos (appsink, g_value_get_boolean (value));
       break;
+    case PROP_LOW_WATERMARK:
+      g_mutex_lock (&appsink->priv->mutex);
+      appsink->priv->low_watermark = g_value_get_uint (value);
+      g_mutex_unlock (&appsink->priv->mutex);
+      break;
+    case PROP_HIGH_WATERMARK:
+      g_mutex_lock (&appsink->priv->mutex);
+      appsink->priv->high_watermark = g_value_get_uint (value);
+      g_mutex_unlock (&appsink->priv->mutex);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -571,6 +802,21 @@ gst_app_sink_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_WAIT_ON_EOS:
       g_value_set_boolean (value, gst_app_sink_get_wait_on_eos (appsink));
       break;
+    case PROP_STATS:
+      g_mutex_lock (&appsink->priv->mutex);
+      g_value_take_boxed (value, gst_app_sink_create_stats (appsink));
+      g_mutex_unlock (&appsink->priv->mutex);
+      break;
+    case PROP_LOW_WATERMARK:
+      g_mutex_lock (&appsink->priv->mutex);
+      g_value_set_uint (value, appsink->priv->low_watermark);
+      g_mutex_unlock (&appsink->priv->mutex);
+      break;
+    case PROP_HIGH_WATERMARK:
+      g_mutex_lock (&appsink->priv->mutex);
+      g_value_set_uint (value, appsink->priv->high_watermark);
+      g_mutex_unlock (&appsink->priv->mutex);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -616,9 +862,12 @@ gst_app_sink_flush_unlocked (GstAppSink * appsink)
   GST_DEBUG_OBJECT (appsink, "flush stop appsink");
   priv->is_eos = FALSE;
   gst_buffer_replace (&priv->preroll, NULL);
-  while ((obj = g_queue_pop_head (priv->queue)))
+  while ((obj = g_queue_pop_head (priv->queue))) {
     gst_mini_object_unref (obj);
+    gst_app_sink_stats_dequeued (priv, TRUE);
+  }
   priv->num_buffers = 0;
+  priv->above_watermark = FALSE;
   g_cond_signal (&priv->cond);
 }
 
@@ -669,6 +918,7 @@ gst_app_sink_setcaps (GstBaseSink * sink, GstCaps * caps)
   g_mutex_lock (&priv->mutex);
   GST_DEBUG_OBJECT (appsink, "receiving CAPS");
   g_queue_push_tail (priv->queue, gst_event_new_caps (caps));
+  gst_app_sink_stats_enqueued (priv);
   if (!priv->preroll)
     gst_caps_replace (&priv->preroll_caps, caps);
   g_mutex_unlock (&priv->mutex);
@@ -687,6 +937,7 @@ gst_app_sink_event (GstBaseSink * sink, GstEvent * event)
       g_mutex_lock (&priv->mutex);
       GST_DEBUG_OBJECT (appsink, "receiving SEGMENT");
       g_queue_push_tail (priv->queue, gst_event_ref (event));
+      gst_app_sink_stats_enqueued (priv);
       if (!priv->preroll)
         gst_event_copy_segment (event, &priv->preroll_segment);
       g_mutex_unlock (&priv->mutex);
@@ -777,13 +1028,14 @@ flushing:
 }
 
 static GstMiniObject *
-dequeue_buffer (GstAppSink * appsink)
+dequeue_buffer (GstAppSink * appsink, gboolean drop)
 {
   GstAppSinkPrivate *priv = appsink->priv;
   GstMiniObject *obj;
 
   do {
     obj = g_queue_pop_head (priv->queue);
+    gst_app_sink_stats_dequeued (priv, drop);
 
     if (GST_IS_BUFFER (obj) || GST_IS_BUFFER_LIST (obj)) {
       GST_DEBUG_OBJECT (appsink, "dequeued buffer/list %p", obj);
@@ -824,7 +1076,7 @@ gst_app_sink_render_common (GstBaseSink * psink, GstMiniObject * data,
   GstFlowReturn ret;
   GstAppSink *appsink = GST_APP_SINK_CAST (psink);
   GstAppSinkPrivate *priv = appsink->priv;
-  gboolean emit;
+  gboolean emit, emit_high;
 
 restart:
   g_mutex_lock (&priv->mutex);
@@ -840,6 +1092,31 @@ restart:
         priv->last_caps);
   }
 
+  /* when a consume_buffer callback is installed, hand the buffers to the
+   * application directly from the streaming thread without queueing them or
+   * wrapping them in a sample */
+  if (priv->callbacks.consume_buffer) {
+    g_mutex_unlock (&priv->mutex);
+
+    if (is_list) {
+      GstBufferList *list = GST_BUFFER_LIST_CAST (data);
+      guint i, len;
+
+      len = gst_buffer_list_length (list);
+      ret = GST_FLOW_OK;
+      for (i = 0; i < len; i++) {
+        ret = priv->callbacks.consume_buffer (appsink,
+            gst_buffer_list_get (list, i), priv->user_data);
+        if (ret != GST_FLOW_OK)
+          break;
+      }
+    } else {
+      ret = priv->callbacks.consume_buffer (appsink, GST_BUFFER_CAST (data),
+          priv->user_data);
+    }
+    return ret;
+  }
+
   GST_DEBUG_OBJECT (appsink, "pushing render buffer/list %p on queue (%d)",
       data, priv->num_buffers);
 
@@ -848,7 +1125,7 @@ restart:
       GstMiniObject *old;
 
       /* we need to drop the oldest buffer/list and try again */
-      if ((old = dequeue_buffer (appsink))) {
+      if ((old = dequeue_buffer (appsink, TRUE))) {
         GST_DEBUG_OBJECT (appsink, "dropping old buffer/list %p", old);
         gst_mini_object_unref (old);
       }
@@ -875,10 +1152,15 @@ restart:
   /* we need to ref the buffer/list when pushing it in the queue */
   g_queue_push_tail (priv->queue, gst_mini_object_ref (data));
   priv->num_buffers++;
+  gst_app_sink_stats_enqueued (priv);
   g_cond_signal (&priv->cond);
   emit = priv->emit_signals;
+  emit_high = gst_app_sink_check_high_watermark (priv);
   g_mutex_unlock (&priv->mutex);
 
+  if (emit_high)
+    g_signal_emit (appsink, gst_app_sink_signals[SIGNAL_HIGH_WATERMARK], 0);
+
   if (priv->callbacks.new_sample) {
     ret = priv->callbacks.new_sample (appsink, priv->user_data);
   } else {
@@ -1536,6 +1818,8 @@ gst_app_sink_try_pull_sample (GstAppSink * appsink, GstClockTime timeout)
   gboolean timeout_valid;
   gint64 end_time;
 
+  gboolean emit_low;
+
   g_return_val_if_fail (GST_IS_APP_SINK (appsink), NULL);
 
   timeout_valid = GST_CLOCK_TIME_IS_VALID (timeout);
@@ -1569,7 +1853,7 @@ gst_app_sink_try_pull_sample (GstAppSink * appsink, GstClockTime timeout)
     }
   }
 
-  obj = dequeue_buffer (appsink);
+  obj = dequeue_buffer (appsink, FALSE);
   if (GST_IS_BUFFER (obj)) {
     GST_DEBUG_OBJECT (appsink, "we have a buffer %p", obj);
     sample = gst_sample_new (GST_BUFFER_CAST (obj), priv->last_caps,
@@ -1582,8 +1866,12 @@ gst_app_sink_try_pull_sample (GstAppSink * appsink, GstClockTime timeout)
   gst_mini_object_unref (obj);
 
   g_cond_signal (&priv->cond);
+  emit_low = gst_app_sink_check_low_watermark (priv);
   g_mutex_unlock (&priv->mutex);
 
+  if (emit_low)
+    g_signal_emit (appsink, gst_app_sink_signals[SIGNAL_LOW_WATERMARK], 0);
+
   return sample;
 
   /* special conditions */
@@ -1607,6 +1895,105 @@ not_started:
   }
 }
 
+/**
+ * gst_app_sink_pull_sample_list:
+ * @appsink: a #GstAppSink
+ * @max_samples: the maximum number of samples to return, 0 for no limit
+ *
+ * Drain up to @max_samples queued samples from @appsink with a single lock
+ * acquisition. This behaves like calling gst_app_sink_pull_sample()
+ * repeatedly but is cheaper for applications that consume buffers at a high
+ * rate, because the internal mutex is only taken once for the whole batch.
+ *
+ * This function blocks until at least one sample or EOS becomes available or
+ * the appsink element is set to the READY/NULL state.
+ *
+ * If an EOS event was received before any buffers, this function returns
+ * %NULL. Use gst_app_sink_is_eos () to check for the EOS condition.
+ *
+ * Returns: (element-type GstSample) (transfer full): a #GList of #GstSample
+ *     in the order they were rendered, or %NULL when the appsink is stopped
+ *     or EOS. Free with g_list_free_full (list, (GDestroyNotify)
+ *     gst_sample_unref) after usage.
+ *
+ * Since: 1.14
+ */
+GList *
+gst_app_sink_pull_sample_list (GstAppSink * appsink, guint max_samples)
+{
+  GstAppSinkPrivate *priv;
+  GList *samples = NULL;
+  guint len = 0;
+  gboolean emit_low;
+
+  g_return_val_if_fail (GST_IS_APP_SINK (appsink), NULL);
+
+  priv = appsink->priv;
+
+  g_mutex_lock (&priv->mutex);
+
+  while (TRUE) {
+    GST_DEBUG_OBJECT (appsink, "trying to grab a buffer");
+    if (!priv->started)
+      goto not_started;
+
+    if (priv->num_buffers > 0)
+      break;
+
+    if (priv->is_eos)
+      goto eos;
+
+    /* nothing to return, wait */
+    GST_DEBUG_OBJECT (appsink, "waiting for a buffer");
+    g_cond_wait (&priv->cond, &priv->mutex);
+  }
+
+  while (priv->num_buffers > 0 && (max_samples == 0 || len < max_samples)) {
+    GstMiniObject *obj;
+    GstSample *sample;
+
+    obj = dequeue_buffer (appsink, FALSE);
+    if (GST_IS_BUFFER (obj)) {
+      GST_DEBUG_OBJECT (appsink, "we have a buffer %p", obj);
+      sample = gst_sample_new (GST_BUFFER_CAST (obj), priv->last_caps,
+          &priv->last_segment, NULL);
+    } else {
+      GST_DEBUG_OBJECT (appsink, "we have a list %p", obj);
+      sample =
+          gst_sample_new (NULL, priv->last_caps, &priv->last_segment, NULL);
+      gst_sample_set_buffer_list (sample, GST_BUFFER_LIST_CAST (obj));
+    }
+    gst_mini_object_unref (obj);
+
+    samples = g_list_prepend (samples, sample);
+    len++;
+  }
+  GST_DEBUG_OBJECT (appsink, "drained %u samples", len);
+
+  g_cond_signal (&priv->cond);
+  emit_low = gst_app_sink_check_low_watermark (priv);
+  g_mutex_unlock (&priv->mutex);
+
+  if (emit_low)
+    g_signal_emit (appsink, gst_app_sink_signals[SIGNAL_LOW_WATERMARK], 0);
+
+  return g_list_reverse (samples);
+
+  /* special conditions */
+eos:
+  {
+    GST_DEBUG_OBJECT (appsink, "we are EOS, return NULL");
+    g_mutex_unlock (&priv->mutex);
+    return NULL;
+  }
+not_started:
+  {
+    GST_DEBUG_OBJECT (appsink, "we are stopped, return NULL");
+    g_mutex_unlock (&priv->mutex);
+    return NULL;
+  }
+}
+
 /**
  * gst_app_sink_set_callbacks: (skip)
  * @appsink: a #GstAppSink
@@ -58,6 +58,12 @@ typedef struct _GstAppSinkPrivate GstAppSinkPrivate;
  *       The new sample can be retrieved with
  *       gst_app_sink_pull_sample() either from this callback
  *       or from any other thread.
+ * @consume_buffer: Called from the streaming thread with each rendered
+ *       buffer instead of queueing it. The buffer is borrowed: it is only
+ *       valid for the duration of the call and must be reffed with
+ *       gst_buffer_ref() to keep it. When this callback is set, no samples
+ *       are queued and the pull methods will not return any data. The
+ *       negotiated caps can be retrieved from the sink pad. (Since: 1.14)
  *
  * A set of callbacks that can be installed on the appsink with
  * gst_app_sink_set_callbacks().
@@ -66,9 +72,10 @@ typedef struct {
   void          (*eos)              (GstAppSink *appsink, gpointer user_data);
   GstFlowReturn (*new_preroll)      (GstAppSink *appsink, gpointer user_data);
   GstFlowReturn (*new_sample)       (GstAppSink *appsink, gpointer user_data);
+  GstFlowReturn (*consume_buffer)   (GstAppSink *appsink, GstBuffer *buffer, gpointer user_data);
 
   /*< private >*/
-  gpointer     _gst_reserved[GST_PADDING];
+  gpointer     _gst_reserved[GST_PADDING - 1];
 } GstAppSinkCallbacks;
 
 struct _GstAppSink
@@ -155,6 +162,9 @@ GstSample *     gst_app_sink_try_pull_preroll (GstAppSink *appsink, GstClockTime
 GST_EXPORT
 GstSample *     gst_app_sink_try_pull_sample  (GstAppSink *appsink, GstClockTime timeout);
 
+GST_EXPORT
+GList *         gst_app_sink_pull_sample_list (GstAppSink *appsink, guint max_samples);
+
 GST_EXPORT
 void            gst_app_sink_set_callbacks    (GstAppSink * appsink,
                                                GstAppSinkCallbacks *callbacks,
@@ -101,6 +101,10 @@
 
 #include "gstappsrc.h"
 
+/* residency histogram: bucket 0 is < 1ms, bucket i is [2^(i-1), 2^i) ms,
+ * the last bucket collects everything longer */
+#define N_RESIDENCY_BUCKETS 14
+
 struct _GstAppSrcPrivate
 {
   GCond cond;
@@ -130,6 +134,39 @@ struct _GstAppSrcPrivate
   gboolean emit_signals;
   guint min_percent;
 
+  /* opt-in lock-free bounded single-producer/single-consumer ring between
+   * the application thread and the streaming thread. Slots hold buffers or
+   * caps. Only pushing is lock-free; all popping (streaming thread and
+   * flushing) happens with the mutex held, which keeps the consumer side
+   * serialized. */
+  gboolean use_lockfree_queue;
+  GstMiniObject **ring;
+  guint ring_size;              /* number of slots, a power of two */
+  volatile gint ring_head;      /* next slot to pop, only moved by consumers */
+  volatile gint ring_tail;      /* next slot to fill, only moved by the producer */
+  volatile gint ring_level_bytes;       /* bytes of buffer data in the ring */
+  volatile gint cond_waiting;   /* the streaming thread is waiting on cond */
+
+  /* queue telemetry; the counters are protected by @mutex (all pops hold
+   * it), ring enqueue times are written by the producer before publishing.
+   * @queue_times mirrors @queue and holds the enqueue time of every item
+   * still in it */
+  GQueue *queue_times;
+  gint64 *ring_times;
+  guint64 max_level_bytes;
+  guint64 stat_dequeued;
+  guint64 stat_dropped;
+  guint64 residency_sum;
+  guint64 residency_max;
+  guint64 residency_hist[N_RESIDENCY_BUCKETS];
+
+  /* block cache for random-access mode, protected by @mutex. Repeat and
+   * overlapping range requests are served from recently returned buffers
+   * without a seek-data/need-data round trip to the application */
+  guint64 cache_size;
+  guint64 cache_level;
+  GQueue *cache;
+
   GstAppSrcCallbacks callbacks;
   gpointer user_data;
   GDestroyNotify notify;
@@ -149,6 +186,7 @@ enum
   SIGNAL_PUSH_BUFFER,
   SIGNAL_END_OF_STREAM,
   SIGNAL_PUSH_SAMPLE,
+  SIGNAL_PUSH_BUFFER_LIST,
 
   LAST_SIGNAL
 };
@@ -165,6 +203,11 @@ enum
 #define DEFAULT_PROP_MIN_PERCENT   0
 #define DEFAULT_PROP_CURRENT_LEVEL_BYTES   0
 #define DEFAULT_PROP_DURATION      GST_CLOCK_TIME_NONE
+#define DEFAULT_PROP_LOCKFREE_QUEUE FALSE
+#define DEFAULT_PROP_CACHE_SIZE    0
+
+/* number of slots in the lock-free ring, must be a power of two */
+#define RING_SLOTS 4096
 
 enum
 {
@@ -182,6 +225,9 @@ enum
   PROP_MIN_PERCENT,
   PROP_CURRENT_LEVEL_BYTES,
   PROP_DURATION,
+  PROP_LOCKFREE_QUEUE,
+  PROP_STATS,
+  PROP_CACHE_SIZE,
   PROP_LAST
 };
 
@@ -224,6 +270,8 @@ static gboolean gst_app_src_event (GstBaseSrc * src, GstEvent * event);
 
 static GstFlowReturn gst_app_src_push_buffer_action (GstAppSrc * appsrc,
     GstBuffer * buffer);
+static GstFlowReturn gst_app_src_push_buffer_list_action (GstAppSrc * appsrc,
+    GstBufferList * buffer_list);
 static GstFlowReturn gst_app_src_push_sample_action (GstAppSrc * appsrc,
     GstSample * sample);
 
@@ -372,6 +420,23 @@ gst_app_src_class_init (GstAppSrcClass * klass)
           0, 100, DEFAULT_PROP_MIN_PERCENT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAppSrc::cache-size:
+   *
+   * The size in bytes of the block cache used in random-access mode.
+   * Buffers handed to appsrc are kept around and ranges that are fully
+   * covered by a cached buffer are served directly, without a
+   * seek-data/need-data round trip to the application. Old buffers are
+   * evicted least-recently-used. A value of 0 disables the cache.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_CACHE_SIZE,
+      g_param_spec_uint64 ("cache-size", "Cache size",
+          "The size of the block cache for random-access mode (0 = disabled)",
+          0, G_MAXUINT64, DEFAULT_PROP_CACHE_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstAppSrc::current-level-bytes:
    *
@@ -399,6 +464,43 @@ gst_app_src_class_init (GstAppSrcClass * klass)
           0, G_MAXUINT64, DEFAULT_PROP_DURATION,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAppSrc::lockfree-queue:
+   *
+   * Hand buffers from push-buffer to the streaming thread through a bounded
+   * lock-free ring instead of the mutex protected queue, reducing the
+   * per-buffer synchronization to an atomic store. Only a single application
+   * thread may push buffers, set caps or send EOS in this mode. max-bytes
+   * still controls the enough-data signal, but push-buffer only ever blocks
+   * when the ring itself is full, independent of the block property. Can
+   * only be changed before the element is started.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_LOCKFREE_QUEUE,
+      g_param_spec_boolean ("lockfree-queue", "Lock-free queue",
+          "Use a bounded lock-free ring for push-buffer "
+          "(single producer thread only)",
+          DEFAULT_PROP_LOCKFREE_QUEUE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAppSrc::stats:
+   *
+   * Queue statistics as a #GstStructure: how many items the streaming
+   * thread dequeued, how many were dropped by flushing, the current and
+   * highest fill level in bytes, and how long buffers stayed queued
+   * between push-buffer and the streaming thread picking them up
+   * (average, maximum and a logarithmic milliseconds histogram). Reading
+   * the property takes a consistent snapshot.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Stats",
+          "Queue residency and fill level statistics",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstAppSrc::need-data:
    * @appsrc: the appsrc element that emitted the signal
@@ -465,6 +567,27 @@ gst_app_src_class_init (GstAppSrcClass * klass)
           push_buffer), NULL, NULL, NULL,
       GST_TYPE_FLOW_RETURN, 1, GST_TYPE_BUFFER);
 
+   /**
+    * GstAppSrc::push-buffer-list:
+    * @appsrc: the appsrc
+    * @buffer_list: a buffer list to push
+    *
+    * Adds a buffer list to the queue of buffers and buffer lists that the
+    * appsrc element will push to its source pad. This function does not take
+    * ownership of the buffer list so the buffer list needs to be unreffed
+    * after calling this function.
+    *
+    * When the block property is TRUE, this function can block until free space
+    * becomes available in the queue.
+    *
+    * Since: 1.14
+    */
+  gst_app_src_signals[SIGNAL_PUSH_BUFFER_LIST] =
+      g_signal_new ("push-buffer-list", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION, G_STRUCT_OFFSET (GstAppSrcClass,
+          push_buffer_list), NULL, NULL, NULL,
+      GST_TYPE_FLOW_RETURN, 1, GST_TYPE_BUFFER_LIST);
+
   /**
     * GstAppSrc::push-sample:
     * @appsrc: the appsrc
@@ -527,6 +650,7 @@ gst_app_src_class_init (GstAppSrcClass * klass)
   basesrc_class->event = gst_app_src_event;
 
   klass->push_buffer = gst_app_src_push_buffer_action;
+  klass->push_buffer_list = gst_app_src_push_buffer_list_action;
   klass->push_sample = gst_app_src_push_sample_action;
   klass->end_of_stream = gst_app_src_end_of_stream;
 
@@ -544,6 +668,7 @@ gst_app_src_init (GstAppSrc * appsrc)
   g_mutex_init (&priv->mutex);
   g_cond_init (&priv->cond);
   priv->queue = g_queue_new ();
+  priv->queue_times = g_queue_new ();
 
   priv->size = DEFAULT_PROP_SIZE;
   priv->duration = DEFAULT_PROP_DURATION;
@@ -555,10 +680,319 @@ gst_app_src_init (GstAppSrc * appsrc)
   priv->max_latency = DEFAULT_PROP_MAX_LATENCY;
   priv->emit_signals = DEFAULT_PROP_EMIT_SIGNALS;
   priv->min_percent = DEFAULT_PROP_MIN_PERCENT;
+  priv->use_lockfree_queue = DEFAULT_PROP_LOCKFREE_QUEUE;
+  priv->cache_size = DEFAULT_PROP_CACHE_SIZE;
+  priv->cache = g_queue_new ();
 
   gst_base_src_set_live (GST_BASE_SRC (appsrc), DEFAULT_PROP_IS_LIVE);
 }
 
+#define RING_MASK(priv) ((priv)->ring_size - 1)
+
+static inline gboolean
+gst_app_src_ring_is_empty (GstAppSrcPrivate * priv)
+{
+  return priv->ring == NULL
+      || g_atomic_int_get (&priv->ring_tail) == priv->ring_head;
+}
+
+/* the total amount of queued buffer bytes, in the GQueue and the ring */
+static inline guint64
+gst_app_src_all_queued_bytes (GstAppSrcPrivate * priv)
+{
+  return priv->queued_bytes + (guint) g_atomic_int_get (&priv->ring_level_bytes);
+}
+
+/* called with priv->mutex after pushing one item on the GQueue: remember
+ * when it was enqueued. Ring items get their time stamped by the producer
+ * in gst_app_src_ring_push() instead. */
+static void
+gst_app_src_stats_enqueued (GstAppSrcPrivate * priv)
+{
+  gint64 *enqueued = g_new (gint64, 1);
+
+  *enqueued = g_get_monotonic_time ();
+  g_queue_push_tail (priv->queue_times, enqueued);
+}
+
+/* called with priv->mutex: track the highest fill level seen so far */
+static void
+gst_app_src_stats_sample_level (GstAppSrcPrivate * priv)
+{
+  guint64 level = gst_app_src_all_queued_bytes (priv);
+
+  if (level > priv->max_level_bytes)
+    priv->max_level_bytes = level;
+}
+
+/* pop the enqueue time matching the GQueue head, 0 when unknown */
+static gint64
+gst_app_src_stats_pop_time (GstAppSrcPrivate * priv)
+{
+  gint64 *enqueued, res = 0;
+
+  if ((enqueued = g_queue_pop_head (priv->queue_times))) {
+    res = *enqueued;
+    g_free (enqueued);
+  }
+  return res;
+}
+
+/* called with priv->mutex after an item left the queue or the ring: fold
+ * the time it spent queued into the counters, or count it as dropped */
+static void
+gst_app_src_stats_popped (GstAppSrcPrivate * priv, gint64 enqueued,
+    gboolean dropped)
+{
+  guint64 residency, ms;
+  guint bucket = 0;
+
+  if (enqueued == 0)
+    return;
+
+  if (dropped) {
+    priv->stat_dropped++;
+    return;
+  }
+
+  residency = (g_get_monotonic_time () - enqueued) * 1000;
+  priv->stat_dequeued++;
+  priv->residency_sum += residency;
+  if (residency > priv->residency_max)
+    priv->residency_max = residency;
+  for (ms = residency / GST_MSECOND; ms > 0; ms >>= 1) {
+    if (++bucket == N_RESIDENCY_BUCKETS - 1)
+      break;
+  }
+  priv->residency_hist[bucket]++;
+}
+
+/* called with priv->mutex */
+static GstStructure *
+gst_app_src_create_stats (GstAppSrc * appsrc)
+{
+  GstAppSrcPrivate *priv = appsrc->priv;
+  GstStructure *s;
+  GValue hist = G_VALUE_INIT;
+  GValue v = G_VALUE_INIT;
+  guint i;
+
+  s = gst_structure_new ("application/x-appsrc-stats",
+      "dequeued", G_TYPE_UINT64, priv->stat_dequeued,
+      "dropped", G_TYPE_UINT64, priv->stat_dropped,
+      "current-level-bytes", G_TYPE_UINT64,
+      gst_app_src_all_queued_bytes (priv),
+      "max-level-bytes", G_TYPE_UINT64, priv->max_level_bytes,
+      "avg-residency", G_TYPE_UINT64,
+      priv->stat_dequeued ? priv->residency_sum / priv->stat_dequeued :
+      G_GUINT64_CONSTANT (0),
+      "max-residency", G_TYPE_UINT64, priv->residency_max, NULL);
+
+  g_value_init (&hist, GST_TYPE_ARRAY);
+  g_value_init (&v, G_TYPE_UINT64);
+  for (i = 0; i < N_RESIDENCY_BUCKETS; i++) {
+    g_value_set_uint64 (&v, priv->residency_hist[i]);
+    gst_value_array_append_value (&hist, &v);
+  }
+  g_value_unset (&v);
+  gst_structure_take_value (s, "residency-histogram", &hist);
+
+  return s;
+}
+
+/* Pop the oldest object from the ring, or NULL when it is empty. Must be
+ * called with priv->mutex so all consumers (the streaming thread and
+ * flushing) stay serialized against each other. */
+static GstMiniObject *
+gst_app_src_ring_pop (GstAppSrcPrivate * priv, gint64 * enqueued)
+{
+  GstMiniObject *obj;
+  gint head = priv->ring_head;
+
+  if (priv->ring == NULL || g_atomic_int_get (&priv->ring_tail) == head)
+    return NULL;
+
+  obj = priv->ring[head & RING_MASK (priv)];
+  if (enqueued)
+    *enqueued = priv->ring_times[head & RING_MASK (priv)];
+  if (obj != NULL) {
+    if (GST_IS_BUFFER (obj))
+      g_atomic_int_add (&priv->ring_level_bytes,
+          -((gint) gst_buffer_get_size (GST_BUFFER_CAST (obj))));
+    else if (GST_IS_BUFFER_LIST (obj))
+      g_atomic_int_add (&priv->ring_level_bytes,
+          -((gint) gst_buffer_list_calculate_size (GST_BUFFER_LIST_CAST
+                  (obj))));
+  }
+  g_atomic_int_set (&priv->ring_head, head + 1);
+
+  return obj;
+}
+
+/* Publish @obj (a buffer or caps) into the ring with a single atomic store,
+ * only touching the mutex when the ring is full, a flush raced with us or
+ * the streaming thread is asleep. Takes ownership of @obj, also on failure.
+ * Only a single application thread may push. */
+static GstFlowReturn
+gst_app_src_ring_push (GstAppSrc * appsrc, GstMiniObject * obj)
+{
+  GstAppSrcPrivate *priv = appsrc->priv;
+  gint tail;
+
+  while (TRUE) {
+    if (g_atomic_int_get (&priv->flushing))
+      goto flushing;
+    if (priv->is_eos)
+      goto eos;
+
+    tail = priv->ring_tail;
+    if (tail - g_atomic_int_get (&priv->ring_head) < (gint) priv->ring_size)
+      break;
+
+    /* the ring mode is bounded: wait until the streaming thread pops */
+    GST_DEBUG_OBJECT (appsrc, "ring full, waiting for free space");
+    g_mutex_lock (&priv->mutex);
+    if (!priv->flushing && !priv->is_eos
+        && priv->ring_tail - priv->ring_head >= (gint) priv->ring_size)
+      g_cond_wait (&priv->cond, &priv->mutex);
+    g_mutex_unlock (&priv->mutex);
+  }
+
+  priv->ring[tail & RING_MASK (priv)] = obj;
+  priv->ring_times[tail & RING_MASK (priv)] = g_get_monotonic_time ();
+  if (obj != NULL) {
+    if (GST_IS_BUFFER (obj))
+      g_atomic_int_add (&priv->ring_level_bytes,
+          (gint) gst_buffer_get_size (GST_BUFFER_CAST (obj)));
+    else if (GST_IS_BUFFER_LIST (obj))
+      g_atomic_int_add (&priv->ring_level_bytes,
+          (gint) gst_buffer_list_calculate_size (GST_BUFFER_LIST_CAST (obj)));
+  }
+  /* publish, g_atomic_int_set () is a full barrier */
+  g_atomic_int_set (&priv->ring_tail, tail + 1);
+
+  /* a flush that raced with the stores above may have missed the object we
+   * just published, drain it ourselves in that case */
+  if (G_UNLIKELY (g_atomic_int_get (&priv->flushing))) {
+    g_mutex_lock (&priv->mutex);
+    while (!gst_app_src_ring_is_empty (priv)) {
+      gint64 enqueued = 0;
+
+      if ((obj = gst_app_src_ring_pop (priv, &enqueued))) {
+        gst_mini_object_unref (obj);
+        gst_app_src_stats_popped (priv, enqueued, TRUE);
+      }
+    }
+    g_mutex_unlock (&priv->mutex);
+    return GST_FLOW_FLUSHING;
+  }
+
+  /* batched wakeup: only take the mutex and signal when the streaming
+   * thread is actually waiting for data */
+  if (g_atomic_int_get (&priv->cond_waiting)) {
+    g_mutex_lock (&priv->mutex);
+    g_cond_broadcast (&priv->cond);
+    g_mutex_unlock (&priv->mutex);
+  }
+
+  return GST_FLOW_OK;
+
+  /* ERRORS */
+flushing:
+  {
+    GST_DEBUG_OBJECT (appsrc, "refuse object %p, we are flushing", obj);
+    if (obj)
+      gst_mini_object_unref (obj);
+    return GST_FLOW_FLUSHING;
+  }
+eos:
+  {
+    GST_DEBUG_OBJECT (appsrc, "refuse object %p, we are EOS", obj);
+    if (obj)
+      gst_mini_object_unref (obj);
+    return GST_FLOW_EOS;
+  }
+}
+
+typedef struct
+{
+  guint64 offset;
+  guint64 size;
+  GstBuffer *buffer;
+} GstAppSrcCacheBlock;
+
+static void
+gst_app_src_cache_block_free (GstAppSrcCacheBlock * block)
+{
+  gst_buffer_unref (block->buffer);
+  g_slice_free (GstAppSrcCacheBlock, block);
+}
+
+/* Must be called with priv->mutex */
+static void
+gst_app_src_cache_clear (GstAppSrcPrivate * priv)
+{
+  GstAppSrcCacheBlock *block;
+
+  while ((block = g_queue_pop_head (priv->cache)))
+    gst_app_src_cache_block_free (block);
+  priv->cache_level = 0;
+}
+
+/* Find a cached block fully covering the requested range and return the
+ * requested part of it, with the memory shared, not copied. The block is
+ * moved to the head of the cache to keep the eviction order
+ * least-recently-used. Must be called with priv->mutex */
+static GstBuffer *
+gst_app_src_cache_lookup (GstAppSrc * appsrc, guint64 offset, guint size)
+{
+  GstAppSrcPrivate *priv = appsrc->priv;
+  GList *l;
+
+  for (l = priv->cache->head; l; l = l->next) {
+    GstAppSrcCacheBlock *block = l->data;
+
+    if (offset >= block->offset && offset + size <= block->offset + block->size) {
+      GST_DEBUG_OBJECT (appsrc, "cache hit for offset %" G_GUINT64_FORMAT
+          ", size %u", offset, size);
+      g_queue_unlink (priv->cache, l);
+      g_queue_push_head_link (priv->cache, l);
+      return gst_buffer_copy_region (block->buffer, GST_BUFFER_COPY_MEMORY,
+          offset - block->offset, size);
+    }
+  }
+  return NULL;
+}
+
+/* Remember a buffer that was just returned for the range starting at
+ * @offset and evict the least-recently-used blocks over the configured
+ * cache size. Must be called with priv->mutex */
+static void
+gst_app_src_cache_insert (GstAppSrc * appsrc, guint64 offset,
+    GstBuffer * buffer)
+{
+  GstAppSrcPrivate *priv = appsrc->priv;
+  GstAppSrcCacheBlock *block;
+  guint64 buf_size;
+
+  buf_size = gst_buffer_get_size (buffer);
+  if (buf_size == 0 || buf_size > priv->cache_size)
+    return;
+
+  block = g_slice_new (GstAppSrcCacheBlock);
+  block->offset = offset;
+  block->size = buf_size;
+  block->buffer = gst_buffer_ref (buffer);
+  g_queue_push_head (priv->cache, block);
+  priv->cache_level += buf_size;
+
+  while (priv->cache_level > priv->cache_size) {
+    block = g_queue_pop_tail (priv->cache);
+    priv->cache_level -= block->size;
+    gst_app_src_cache_block_free (block);
+  }
+}
+
 /* Must be called with priv->mutex */
 static void
 gst_app_src_flush_queued (GstAppSrc * src, gboolean retain_last_caps)
@@ -569,7 +1003,21 @@ gst_app_src_flush_queued (GstAppSrc * src, gboolean retain_last_caps)
 
   while (!g_queue_is_empty (priv->queue)) {
     obj = g_queue_pop_head (priv->queue);
+    gst_app_src_stats_popped (priv, gst_app_src_stats_pop_time (priv), TRUE);
+    if (obj) {
+      if (GST_IS_CAPS (obj) && retain_last_caps) {
+        gst_caps_replace (&requeue_caps, GST_CAPS_CAST (obj));
+      }
+      gst_mini_object_unref (obj);
+    }
+  }
+
+  while (!gst_app_src_ring_is_empty (priv)) {
+    gint64 enqueued = 0;
+
+    obj = gst_app_src_ring_pop (priv, &enqueued);
     if (obj) {
+      gst_app_src_stats_popped (priv, enqueued, TRUE);
       if (GST_IS_CAPS (obj) && retain_last_caps) {
         gst_caps_replace (&requeue_caps, GST_CAPS_CAST (obj));
       }
@@ -579,6 +1027,7 @@ gst_app_src_flush_queued (GstAppSrc * src, gboolean retain_last_caps)
 
   if (requeue_caps) {
     g_queue_push_tail (priv->queue, requeue_caps);
+    gst_app_src_stats_enqueued (priv);
   }
 
   priv->queued_bytes = 0;
@@ -609,6 +1058,7 @@ gst_app_src_dispose (GObject * obj)
 
   g_mutex_lock (&priv->mutex);
   gst_app_src_flush_queued (appsrc, FALSE);
+  gst_app_src_cache_clear (priv);
   g_mutex_unlock (&priv->mutex);
 
   G_OBJECT_CLASS (parent_class)->dispose (obj);
@@ -623,6 +1073,10 @@ gst_app_src_finalize (GObject * obj)
   g_mutex_clear (&priv->mutex);
   g_cond_clear (&priv->cond);
   g_queue_free (priv->queue);
+  g_queue_free_full (priv->queue_times, g_free);
+  g_queue_free (priv->cache);
+  g_free (priv->ring);
+  g_free (priv->ring_times);
 
   g_free (priv->uri);
 
@@ -675,6 +1129,9 @@ gst_app_src_set_property (GObject * object, guint prop_id,
     case PROP_MAX_BYTES:
       gst_app_src_set_max_bytes (appsrc, g_value_get_uint64 (value));
       break;
+    case PROP_CACHE_SIZE:
+      gst_app_src_set_cache_size (appsrc, g_value_get_uint64 (value));
+      break;
     case PROP_FORMAT:
       priv->format = g_value_get_enum (value);
       break;
@@ -702,6 +1159,16 @@ gst_app_src_set_property (GObject * object, guint prop_id,
     case PROP_DURATION:
       gst_app_src_set_duration (appsrc, g_value_get_uint64 (value));
       break;
+    case PROP_LOCKFREE_QUEUE:
+      g_mutex_lock (&priv->mutex);
+      if (priv->started) {
+        GST_WARNING_OBJECT (appsrc,
+            "lockfree-queue can only be changed before the element is started");
+      } else {
+        priv->use_lockfree_queue = g_value_get_boolean (value);
+      }
+      g_mutex_unlock (&priv->mutex);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -728,6 +1195,9 @@ gst_app_src_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_MAX_BYTES:
       g_value_set_uint64 (value, gst_app_src_get_max_bytes (appsrc));
       break;
+    case PROP_CACHE_SIZE:
+      g_value_set_uint64 (value, gst_app_src_get_cache_size (appsrc));
+      break;
     case PROP_FORMAT:
       g_value_set_enum (value, priv->format);
       break;
@@ -765,6 +1235,14 @@ gst_app_src_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_DURATION:
       g_value_set_uint64 (value, gst_app_src_get_duration (appsrc));
       break;
+    case PROP_LOCKFREE_QUEUE:
+      g_value_set_boolean (value, priv->use_lockfree_queue);
+      break;
+    case PROP_STATS:
+      g_mutex_lock (&priv->mutex);
+      g_value_take_boxed (value, gst_app_src_create_stats (appsrc));
+      g_mutex_unlock (&priv->mutex);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -834,6 +1312,13 @@ gst_app_src_start (GstBaseSrc * bsrc)
    * in random-access mode. */
   priv->offset = -1;
   priv->flushing = FALSE;
+  /* the ring stays allocated until finalize so the producer fast path never
+   * races against it disappearing */
+  if (priv->use_lockfree_queue && priv->ring == NULL) {
+    priv->ring = g_new (GstMiniObject *, RING_SLOTS);
+    priv->ring_times = g_new (gint64, RING_SLOTS);
+    priv->ring_size = RING_SLOTS;
+  }
   g_mutex_unlock (&priv->mutex);
 
   gst_base_src_set_format (bsrc, priv->format);
@@ -853,6 +1338,7 @@ gst_app_src_stop (GstBaseSrc * bsrc)
   priv->flushing = TRUE;
   priv->started = FALSE;
   gst_app_src_flush_queued (appsrc, TRUE);
+  gst_app_src_cache_clear (priv);
   g_cond_broadcast (&priv->cond);
   g_mutex_unlock (&priv->mutex);
 
@@ -1125,6 +1611,14 @@ gst_app_src_create (GstBaseSrc * bsrc, guint64 offset, guint size,
     goto flushing;
 
   if (priv->stream_type == GST_APP_STREAM_TYPE_RANDOM_ACCESS) {
+    /* a cache hit serves the range without a round trip to the application
+     * and without disturbing the position the application pushes at */
+    if (priv->cache_size > 0 &&
+        (*buf = gst_app_src_cache_lookup (appsrc, offset, size))) {
+      g_mutex_unlock (&priv->mutex);
+      return GST_FLOW_OK;
+    }
+
     /* if we are dealing with a random-access stream, issue a seek if the offset
      * changed. */
     if (G_UNLIKELY (priv->offset != offset)) {
@@ -1143,12 +1637,33 @@ gst_app_src_create (GstBaseSrc * bsrc, guint64 offset, guint size,
   }
 
   while (TRUE) {
-    /* return data as long as we have some */
+    GstMiniObject *obj = NULL;
+    gboolean have_obj = FALSE;
+    gboolean from_queue = FALSE;
+
+    /* return data as long as we have some. The GQueue is drained before
+     * the lock-free ring, it can only hold items that are older (caps
+     * requeued on flush) */
+    gst_app_src_stats_sample_level (priv);
+
     if (!g_queue_is_empty (priv->queue)) {
+      obj = g_queue_pop_head (priv->queue);
+      gst_app_src_stats_popped (priv, gst_app_src_stats_pop_time (priv),
+          FALSE);
+      have_obj = TRUE;
+      from_queue = TRUE;
+    } else if (!gst_app_src_ring_is_empty (priv)) {
+      gint64 enqueued = 0;
+
+      obj = gst_app_src_ring_pop (priv, &enqueued);
+      gst_app_src_stats_popped (priv, enqueued, FALSE);
+      have_obj = TRUE;
+    }
+
+    if (have_obj) {
       guint buf_size;
-      GstMiniObject *obj = g_queue_pop_head (priv->queue);
 
-      if (!GST_IS_BUFFER (obj)) {
+      if (!GST_IS_BUFFER (obj) && !GST_IS_BUFFER_LIST (obj)) {
         GstCaps *next_caps = GST_CAPS (obj);
         gboolean caps_changed = TRUE;
 
@@ -1177,23 +1692,47 @@ gst_app_src_create (GstBaseSrc * bsrc, guint64 offset, guint size,
         continue;
       }
 
-      *buf = GST_BUFFER (obj);
-      buf_size = gst_buffer_get_size (*buf);
+      if (GST_IS_BUFFER_LIST (obj)) {
+        GstBufferList *buffer_list = GST_BUFFER_LIST (obj);
+
+        buf_size = gst_buffer_list_calculate_size (buffer_list);
 
-      GST_DEBUG_OBJECT (appsrc, "we have buffer %p of size %u", *buf, buf_size);
+        GST_DEBUG_OBJECT (appsrc, "we have buffer list %p of size %u",
+            buffer_list, buf_size);
 
-      priv->queued_bytes -= buf_size;
+        /* submit the whole list in one go, the base class will push it
+         * downstream with a single serialized gst_pad_push_list() */
+        gst_base_src_submit_buffer_list (bsrc, buffer_list);
+        *buf = NULL;
+      } else {
+        *buf = GST_BUFFER (obj);
+        buf_size = gst_buffer_get_size (*buf);
+
+        GST_DEBUG_OBJECT (appsrc, "we have buffer %p of size %u", *buf,
+            buf_size);
+      }
+
+      /* ring items are accounted in ring_level_bytes, which ring_pop
+       * already decremented; queued_bytes only tracks the GQueue */
+      if (from_queue)
+        priv->queued_bytes -= buf_size;
 
       /* only update the offset when in random_access mode */
-      if (priv->stream_type == GST_APP_STREAM_TYPE_RANDOM_ACCESS)
+      if (priv->stream_type == GST_APP_STREAM_TYPE_RANDOM_ACCESS) {
+        /* remember the block; follow-up requests inside it, like the many
+         * small reads of typefinding, are answered from the cache */
+        if (priv->cache_size > 0 && *buf != NULL)
+          gst_app_src_cache_insert (appsrc, priv->offset, *buf);
         priv->offset += buf_size;
+      }
 
       /* signal that we removed an item */
       g_cond_broadcast (&priv->cond);
 
       /* see if we go lower than the empty-percent */
       if (priv->min_percent && priv->max_bytes) {
-        if (priv->queued_bytes * 100 / priv->max_bytes <= priv->min_percent)
+        if (gst_app_src_all_queued_bytes (priv) * 100 / priv->max_bytes <=
+            priv->min_percent)
           /* ignore flushing state, we got a buffer and we will return it now.
            * Errors will be handled in the next round */
           gst_app_src_emit_need_data (appsrc, size);
@@ -1212,7 +1751,8 @@ gst_app_src_create (GstBaseSrc * bsrc, guint64 offset, guint size,
        * signal) we can still be empty because the pushed buffer got flushed or
        * when the application pushes the requested buffer later, we support both
        * possibilities. */
-      if (!g_queue_is_empty (priv->queue))
+      if (!g_queue_is_empty (priv->queue)
+          || !gst_app_src_ring_is_empty (priv))
         continue;
 
       /* no buffer yet, maybe we are EOS, if not, block for more data. */
@@ -1222,8 +1762,14 @@ gst_app_src_create (GstBaseSrc * bsrc, guint64 offset, guint size,
     if (G_UNLIKELY (priv->is_eos))
       goto eos;
 
-    /* nothing to return, wait a while for new data or flushing. */
-    g_cond_wait (&priv->cond, &priv->mutex);
+    /* nothing to return, wait a while for new data or flushing. Flag that
+     * we are waiting first so the lock-free producer knows it has to take
+     * the mutex and signal us, and re-check the ring after flagging so a
+     * wakeup cannot get lost. */
+    g_atomic_int_set (&priv->cond_waiting, TRUE);
+    if (gst_app_src_ring_is_empty (priv))
+      g_cond_wait (&priv->cond, &priv->mutex);
+    g_atomic_int_set (&priv->cond_waiting, FALSE);
   }
   g_mutex_unlock (&priv->mutex);
   return ret;
@@ -1267,6 +1813,8 @@ gst_app_src_set_caps (GstAppSrc * appsrc, const GstCaps * caps)
 {
   GstAppSrcPrivate *priv;
   gboolean caps_changed;
+  GstCaps *ring_caps = NULL;
+  gboolean push_to_ring = FALSE;
 
   g_return_if_fail (GST_IS_APP_SRC (appsrc));
 
@@ -1284,16 +1832,35 @@ gst_app_src_set_caps (GstAppSrc * appsrc, const GstCaps * caps)
     GstCaps *new_caps;
     new_caps = caps ? gst_caps_copy (caps) : NULL;
     GST_DEBUG_OBJECT (appsrc, "setting caps to %" GST_PTR_FORMAT, caps);
-    if (priv->queue->tail != NULL && GST_IS_CAPS (priv->queue->tail->data)) {
-      gst_caps_unref (g_queue_pop_tail (priv->queue));
+    if (priv->ring != NULL) {
+      /* lock-free mode: the caps item must travel through the ring like the
+       * buffers do so ordering is preserved, and gst_app_src_ring_push() may
+       * block on priv->mutex, so it has to run after we drop the locks */
+      ring_caps = new_caps ? gst_caps_ref (new_caps) : NULL;
+      push_to_ring = TRUE;
+    } else {
+      if (priv->queue->tail != NULL && GST_IS_CAPS (priv->queue->tail->data)) {
+        gst_caps_unref (g_queue_pop_tail (priv->queue));
+        g_free (g_queue_pop_tail (priv->queue_times));
+      }
+      g_queue_push_tail (priv->queue, new_caps);
+      gst_app_src_stats_enqueued (priv);
     }
-    g_queue_push_tail (priv->queue, new_caps);
     gst_caps_replace (&priv->last_caps, new_caps);
+    if (push_to_ring && new_caps)
+      gst_caps_unref (new_caps);
   }
 
   GST_OBJECT_UNLOCK (appsrc);
 
   g_mutex_unlock (&priv->mutex);
+
+  if (push_to_ring) {
+    /* ring_push takes ownership; on flushing/EOS the caps are dropped, which
+     * matches the queued items being flushed as well */
+    gst_app_src_ring_push (appsrc,
+        ring_caps ? GST_MINI_OBJECT_CAST (ring_caps) : NULL);
+  }
 }
 
 /**
@@ -1533,6 +2100,67 @@ gst_app_src_get_max_bytes (GstAppSrc * appsrc)
   return result;
 }
 
+/**
+ * gst_app_src_set_cache_size:
+ * @appsrc: a #GstAppSrc
+ * @size: the size of the block cache in bytes
+ *
+ * Set the size of the block cache used in random-access mode. Ranges that
+ * are fully covered by a recently returned buffer are then served from the
+ * cache, without a seek-data/need-data round trip to the application. A
+ * value of 0 disables the cache.
+ *
+ * Since: 1.14
+ */
+void
+gst_app_src_set_cache_size (GstAppSrc * appsrc, guint64 size)
+{
+  GstAppSrcPrivate *priv;
+
+  g_return_if_fail (GST_IS_APP_SRC (appsrc));
+
+  priv = appsrc->priv;
+
+  g_mutex_lock (&priv->mutex);
+  if (size != priv->cache_size) {
+    GST_DEBUG_OBJECT (appsrc, "setting cache-size to %" G_GUINT64_FORMAT,
+        size);
+    priv->cache_size = size;
+    if (size == 0)
+      gst_app_src_cache_clear (priv);
+  }
+  g_mutex_unlock (&priv->mutex);
+}
+
+/**
+ * gst_app_src_get_cache_size:
+ * @appsrc: a #GstAppSrc
+ *
+ * Get the size of the block cache used in random-access mode.
+ *
+ * Returns: The size of the block cache in bytes, 0 when it is disabled.
+ *
+ * Since: 1.14
+ */
+guint64
+gst_app_src_get_cache_size (GstAppSrc * appsrc)
+{
+  guint64 result;
+  GstAppSrcPrivate *priv;
+
+  g_return_val_if_fail (GST_IS_APP_SRC (appsrc), 0);
+
+  priv = appsrc->priv;
+
+  g_mutex_lock (&priv->mutex);
+  result = priv->cache_size;
+  GST_DEBUG_OBJECT (appsrc, "getting cache-size of %" G_GUINT64_FORMAT,
+      result);
+  g_mutex_unlock (&priv->mutex);
+
+  return result;
+}
+
 /**
  * gst_app_src_get_current_level_bytes:
  * @appsrc: a #GstAppSrc
@@ -1554,7 +2182,7 @@ gst_app_src_get_current_level_bytes (GstAppSrc * appsrc)
   priv = appsrc->priv;
 
   GST_OBJECT_LOCK (appsrc);
-  queued = priv->queued_bytes;
+  queued = gst_app_src_all_queued_bytes (priv);
   GST_DEBUG_OBJECT (appsrc, "current level bytes is %" G_GUINT64_FORMAT,
       queued);
   GST_OBJECT_UNLOCK (appsrc);
@@ -1677,17 +2305,28 @@ gst_app_src_get_emit_signals (GstAppSrc * appsrc)
 }
 
 static GstFlowReturn
-gst_app_src_push_buffer_full (GstAppSrc * appsrc, GstBuffer * buffer,
-    gboolean steal_ref)
+gst_app_src_push_internal (GstAppSrc * appsrc, GstBuffer * buffer,
+    GstBufferList * buflist, gboolean steal_ref)
 {
   gboolean first = TRUE;
   GstAppSrcPrivate *priv;
 
   g_return_val_if_fail (GST_IS_APP_SRC (appsrc), GST_FLOW_ERROR);
-  g_return_val_if_fail (GST_IS_BUFFER (buffer), GST_FLOW_ERROR);
 
   priv = appsrc->priv;
 
+  g_return_val_if_fail (buffer == NULL || buflist == NULL, GST_FLOW_ERROR);
+
+  if (buflist != NULL) {
+    if (gst_buffer_list_length (buflist) == 0) {
+      if (steal_ref)
+        gst_buffer_list_unref (buflist);
+      return GST_FLOW_OK;
+    }
+
+    buffer = gst_buffer_list_get (buflist, 0);
+  }
+
   if (GST_BUFFER_DTS (buffer) == GST_CLOCK_TIME_NONE &&
       GST_BUFFER_PTS (buffer) == GST_CLOCK_TIME_NONE &&
       gst_base_src_get_do_timestamp (GST_BASE_SRC_CAST (appsrc))) {
@@ -1706,10 +2345,19 @@ gst_app_src_push_buffer_full (GstAppSrc * appsrc, GstBuffer * buffer,
         now = 0;
       gst_object_unref (clock);
 
-      if (!steal_ref)
-        buffer = gst_buffer_copy (buffer);
-      else
-        buffer = gst_buffer_make_writable (buffer);
+      if (buflist == NULL) {
+        if (!steal_ref)
+          buffer = gst_buffer_copy (buffer);
+        else
+          buffer = gst_buffer_make_writable (buffer);
+      } else {
+        if (!steal_ref)
+          buflist = gst_buffer_list_copy (buflist);
+        else
+          buflist = gst_buffer_list_make_writable (buflist);
+
+        buffer = gst_buffer_list_get_writable (buflist, 0);
+      }
 
       GST_BUFFER_PTS (buffer) = now;
       GST_BUFFER_DTS (buffer) = now;
@@ -1722,6 +2370,35 @@ gst_app_src_push_buffer_full (GstAppSrc * appsrc, GstBuffer * buffer,
     }
   }
 
+  /* lock-free mode: publish the buffer into the ring without taking the
+   * mutex. The enough-data threshold only triggers the signal here, the
+   * only blocking condition is a full ring. */
+  if (priv->ring != NULL) {
+    if (priv->max_bytes
+        && gst_app_src_all_queued_bytes (priv) >= priv->max_bytes) {
+      gboolean emit = priv->emit_signals;
+
+      GST_DEBUG_OBJECT (appsrc, "queue filled, signalling enough-data");
+      if (priv->callbacks.enough_data)
+        priv->callbacks.enough_data (appsrc, priv->user_data);
+      else if (emit)
+        g_signal_emit (appsrc, gst_app_src_signals[SIGNAL_ENOUGH_DATA], 0,
+            NULL);
+    }
+
+    if (buflist != NULL) {
+      GST_DEBUG_OBJECT (appsrc, "queueing buffer list %p on ring", buflist);
+      if (!steal_ref)
+        gst_buffer_list_ref (buflist);
+      return gst_app_src_ring_push (appsrc, GST_MINI_OBJECT_CAST (buflist));
+    }
+
+    GST_DEBUG_OBJECT (appsrc, "queueing buffer %p on ring", buffer);
+    if (!steal_ref)
+      gst_buffer_ref (buffer);
+    return gst_app_src_ring_push (appsrc, GST_MINI_OBJECT_CAST (buffer));
+  }
+
   g_mutex_lock (&priv->mutex);
 
   while (TRUE) {
@@ -1770,11 +2447,21 @@ gst_app_src_push_buffer_full (GstAppSrc * appsrc, GstBuffer * buffer,
       break;
   }
 
-  GST_DEBUG_OBJECT (appsrc, "queueing buffer %p", buffer);
-  if (!steal_ref)
-    gst_buffer_ref (buffer);
-  g_queue_push_tail (priv->queue, buffer);
-  priv->queued_bytes += gst_buffer_get_size (buffer);
+  if (buflist != NULL) {
+    GST_DEBUG_OBJECT (appsrc, "queueing buffer list %p", buflist);
+    if (!steal_ref)
+      gst_buffer_list_ref (buflist);
+    g_queue_push_tail (priv->queue, buflist);
+    priv->queued_bytes += gst_buffer_list_calculate_size (buflist);
+  } else {
+    GST_DEBUG_OBJECT (appsrc, "queueing buffer %p", buffer);
+    if (!steal_ref)
+      gst_buffer_ref (buffer);
+    g_queue_push_tail (priv->queue, buffer);
+    priv->queued_bytes += gst_buffer_get_size (buffer);
+  }
+  gst_app_src_stats_enqueued (priv);
+  gst_app_src_stats_sample_level (priv);
   g_cond_broadcast (&priv->cond);
   g_mutex_unlock (&priv->mutex);
 
@@ -1784,21 +2471,36 @@ gst_app_src_push_buffer_full (GstAppSrc * appsrc, GstBuffer * buffer,
 flushing:
   {
     GST_DEBUG_OBJECT (appsrc, "refuse buffer %p, we are flushing", buffer);
-    if (steal_ref)
-      gst_buffer_unref (buffer);
+    if (steal_ref) {
+      if (buflist != NULL)
+        gst_buffer_list_unref (buflist);
+      else
+        gst_buffer_unref (buffer);
+    }
     g_mutex_unlock (&priv->mutex);
     return GST_FLOW_FLUSHING;
   }
 eos:
   {
     GST_DEBUG_OBJECT (appsrc, "refuse buffer %p, we are EOS", buffer);
-    if (steal_ref)
-      gst_buffer_unref (buffer);
+    if (steal_ref) {
+      if (buflist != NULL)
+        gst_buffer_list_unref (buflist);
+      else
+        gst_buffer_unref (buffer);
+    }
     g_mutex_unlock (&priv->mutex);
     return GST_FLOW_EOS;
   }
 }
 
+static GstFlowReturn
+gst_app_src_push_buffer_full (GstAppSrc * appsrc, GstBuffer * buffer,
+    gboolean steal_ref)
+{
+  return gst_app_src_push_internal (appsrc, buffer, NULL, steal_ref);
+}
+
 static GstFlowReturn
 gst_app_src_push_sample_internal (GstAppSrc * appsrc, GstSample * sample)
 {
@@ -1844,6 +2546,30 @@ gst_app_src_push_buffer (GstAppSrc * appsrc, GstBuffer * buffer)
   return gst_app_src_push_buffer_full (appsrc, buffer, TRUE);
 }
 
+/**
+ * gst_app_src_push_buffer_list:
+ * @appsrc: a #GstAppSrc
+ * @buffer_list: (transfer full): a #GstBufferList to push
+ *
+ * Adds a buffer list to the queue of buffers and buffer lists that the
+ * appsrc element will push to its source pad.  This function takes ownership
+ * of @buffer_list.
+ *
+ * When the block property is TRUE, this function can block until free
+ * space becomes available in the queue.
+ *
+ * Returns: #GST_FLOW_OK when the buffer list was successfuly queued.
+ * #GST_FLOW_FLUSHING when @appsrc is not PAUSED or PLAYING.
+ * #GST_FLOW_EOS when EOS occured.
+ *
+ * Since: 1.14
+ */
+GstFlowReturn
+gst_app_src_push_buffer_list (GstAppSrc * appsrc, GstBufferList * buffer_list)
+{
+  return gst_app_src_push_internal (appsrc, NULL, buffer_list, TRUE);
+}
+
 /**
  * gst_app_src_push_sample:
  * @appsrc: a #GstAppSrc
@@ -1879,6 +2605,15 @@ gst_app_src_push_buffer_action (GstAppSrc * appsrc, GstBuffer * buffer)
   return gst_app_src_push_buffer_full (appsrc, buffer, FALSE);
 }
 
+/* push a buffer list without stealing the ref of the buffer list. This is
+ * used for the action signal. */
+static GstFlowReturn
+gst_app_src_push_buffer_list_action (GstAppSrc * appsrc,
+    GstBufferList * buffer_list)
+{
+  return gst_app_src_push_internal (appsrc, NULL, buffer_list, FALSE);
+}
+
 /* push a sample without stealing the ref. This is used for the
  * action signal. */
 static GstFlowReturn
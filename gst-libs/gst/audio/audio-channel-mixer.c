@@ -76,6 +76,14 @@ struct _GstAudioChannelMixer
    * this is matrix * (2^10) as integers */
   gint **matrix_int;
 
+  /* sparse form of the matrix: for every output channel the list of input
+   * channels with a nonzero coefficient, so that mixing only costs the
+   * nonzero terms */
+  gint *sparse_count;           /* [out_channels] */
+  gint **sparse_in;             /* [out_channels][count] input channel index */
+  gfloat **sparse_coeff;        /* [out_channels][count] */
+  gint **sparse_coeff_int;      /* [out_channels][count] */
+
   MixerFunc func;
 
   gpointer tmp;
@@ -103,6 +111,16 @@ gst_audio_channel_mixer_free (GstAudioChannelMixer * mix)
   g_free (mix->matrix_int);
   mix->matrix_int = NULL;
 
+  for (i = 0; i < mix->out_channels; i++) {
+    g_free (mix->sparse_in[i]);
+    g_free (mix->sparse_coeff[i]);
+    g_free (mix->sparse_coeff_int[i]);
+  }
+  g_free (mix->sparse_in);
+  g_free (mix->sparse_coeff);
+  g_free (mix->sparse_coeff_int);
+  g_free (mix->sparse_count);
+
   g_free (mix->tmp);
   mix->tmp = NULL;
 
@@ -664,6 +682,38 @@ gst_audio_channel_mixer_setup_matrix_int (GstAudioChannelMixer * mix)
   }
 }
 
+/* compact the matrix into per-output-channel lists of nonzero
+ * coefficients. Typical up/downmix matrices are mostly zeros, the mix
+ * functions then only pay for the nonzero terms. */
+static void
+gst_audio_channel_mixer_setup_matrix_sparse (GstAudioChannelMixer * mix)
+{
+  gint i, j, count;
+
+  mix->sparse_count = g_new0 (gint, mix->out_channels);
+  mix->sparse_in = g_new0 (gint *, mix->out_channels);
+  mix->sparse_coeff = g_new0 (gfloat *, mix->out_channels);
+  mix->sparse_coeff_int = g_new0 (gint *, mix->out_channels);
+
+  for (j = 0; j < mix->out_channels; j++) {
+    mix->sparse_in[j] = g_new (gint, mix->in_channels);
+    mix->sparse_coeff[j] = g_new (gfloat, mix->in_channels);
+    mix->sparse_coeff_int[j] = g_new (gint, mix->in_channels);
+
+    count = 0;
+    for (i = 0; i < mix->in_channels; i++) {
+      if (mix->matrix[i][j] == 0.0 && mix->matrix_int[i][j] == 0)
+        continue;
+
+      mix->sparse_in[j][count] = i;
+      mix->sparse_coeff[j][count] = mix->matrix[i][j];
+      mix->sparse_coeff_int[j][count] = mix->matrix_int[i][j];
+      count++;
+    }
+    mix->sparse_count[j] = count;
+  }
+}
+
 static void
 gst_audio_channel_mixer_setup_matrix (GstAudioChannelMixer * mix)
 {
@@ -684,6 +734,8 @@ gst_audio_channel_mixer_setup_matrix (GstAudioChannelMixer * mix)
 
   gst_audio_channel_mixer_setup_matrix_int (mix);
 
+  gst_audio_channel_mixer_setup_matrix_sparse (mix);
+
 #ifndef GST_DISABLE_GST_DEBUG
   /* debug */
   {
@@ -710,27 +762,64 @@ gst_audio_channel_mixer_setup_matrix (GstAudioChannelMixer * mix)
 #endif
 }
 
+/* The mix functions work on one output channel at a time with the sparse
+ * coefficient lists and specialize the common shapes: silence, plain copy,
+ * one scaled input and a 2-input blend. The mix chain never runs in place
+ * (see chain_mix in audio-converter.c) so it's fine to fill the output
+ * channel-by-channel. */
+
 static void
 gst_audio_channel_mixer_mix_int16 (GstAudioChannelMixer * mix,
     const gint16 * in_data, gint16 * out_data, gint samples)
 {
-  gint in, out, n;
+  gint i, out, n;
   gint32 res;
   gint inchannels, outchannels;
 
   inchannels = mix->in_channels;
   outchannels = mix->out_channels;
 
-  for (n = 0; n < samples; n++) {
-    for (out = 0; out < outchannels; out++) {
-      /* convert */
-      res = 0;
-      for (in = 0; in < inchannels; in++)
-        res += in_data[n * inchannels + in] * mix->matrix_int[in][out];
-
-      /* remove factor from int matrix */
-      res = (res + (1 << (PRECISION_INT - 1))) >> PRECISION_INT;
-      out_data[n * outchannels + out] = CLAMP (res, G_MININT16, G_MAXINT16);
+  for (out = 0; out < outchannels; out++) {
+    gint count = mix->sparse_count[out];
+    const gint *idx = mix->sparse_in[out];
+    const gint *coeff = mix->sparse_coeff_int[out];
+
+    if (count == 0) {
+      for (n = 0; n < samples; n++)
+        out_data[n * outchannels + out] = 0;
+    } else if (count == 1 && coeff[0] == (1 << PRECISION_INT)) {
+      const gint16 *s = in_data + idx[0];
+
+      for (n = 0; n < samples; n++)
+        out_data[n * outchannels + out] = s[n * inchannels];
+    } else if (count == 1) {
+      const gint16 *s = in_data + idx[0];
+      gint32 c = coeff[0];
+
+      for (n = 0; n < samples; n++) {
+        res = (s[n * inchannels] * c +
+            (1 << (PRECISION_INT - 1))) >> PRECISION_INT;
+        out_data[n * outchannels + out] = CLAMP (res, G_MININT16, G_MAXINT16);
+      }
+    } else if (count == 2) {
+      const gint16 *s0 = in_data + idx[0], *s1 = in_data + idx[1];
+      gint32 c0 = coeff[0], c1 = coeff[1];
+
+      for (n = 0; n < samples; n++) {
+        res = (s0[n * inchannels] * c0 + s1[n * inchannels] * c1 +
+            (1 << (PRECISION_INT - 1))) >> PRECISION_INT;
+        out_data[n * outchannels + out] = CLAMP (res, G_MININT16, G_MAXINT16);
+      }
+    } else {
+      for (n = 0; n < samples; n++) {
+        res = 0;
+        for (i = 0; i < count; i++)
+          res += in_data[n * inchannels + idx[i]] * coeff[i];
+
+        /* remove factor from int matrix */
+        res = (res + (1 << (PRECISION_INT - 1))) >> PRECISION_INT;
+        out_data[n * outchannels + out] = CLAMP (res, G_MININT16, G_MAXINT16);
+      }
     }
   }
 }
@@ -739,23 +828,54 @@ static void
 gst_audio_channel_mixer_mix_int32 (GstAudioChannelMixer * mix,
     const gint32 * in_data, gint32 * out_data, gint samples)
 {
-  gint in, out, n;
+  gint i, out, n;
   gint64 res;
   gint inchannels, outchannels;
 
   inchannels = mix->in_channels;
   outchannels = mix->out_channels;
 
-  for (n = 0; n < samples; n++) {
-    for (out = 0; out < outchannels; out++) {
-      /* convert */
-      res = 0;
-      for (in = 0; in < inchannels; in++)
-        res += in_data[n * inchannels + in] * (gint64) mix->matrix_int[in][out];
-
-      /* remove factor from int matrix */
-      res = (res + (1 << (PRECISION_INT - 1))) >> PRECISION_INT;
-      out_data[n * outchannels + out] = CLAMP (res, G_MININT32, G_MAXINT32);
+  for (out = 0; out < outchannels; out++) {
+    gint count = mix->sparse_count[out];
+    const gint *idx = mix->sparse_in[out];
+    const gint *coeff = mix->sparse_coeff_int[out];
+
+    if (count == 0) {
+      for (n = 0; n < samples; n++)
+        out_data[n * outchannels + out] = 0;
+    } else if (count == 1 && coeff[0] == (1 << PRECISION_INT)) {
+      const gint32 *s = in_data + idx[0];
+
+      for (n = 0; n < samples; n++)
+        out_data[n * outchannels + out] = s[n * inchannels];
+    } else if (count == 1) {
+      const gint32 *s = in_data + idx[0];
+      gint64 c = coeff[0];
+
+      for (n = 0; n < samples; n++) {
+        res = (s[n * inchannels] * c +
+            (1 << (PRECISION_INT - 1))) >> PRECISION_INT;
+        out_data[n * outchannels + out] = CLAMP (res, G_MININT32, G_MAXINT32);
+      }
+    } else if (count == 2) {
+      const gint32 *s0 = in_data + idx[0], *s1 = in_data + idx[1];
+      gint64 c0 = coeff[0], c1 = coeff[1];
+
+      for (n = 0; n < samples; n++) {
+        res = (s0[n * inchannels] * c0 + s1[n * inchannels] * c1 +
+            (1 << (PRECISION_INT - 1))) >> PRECISION_INT;
+        out_data[n * outchannels + out] = CLAMP (res, G_MININT32, G_MAXINT32);
+      }
+    } else {
+      for (n = 0; n < samples; n++) {
+        res = 0;
+        for (i = 0; i < count; i++)
+          res += in_data[n * inchannels + idx[i]] * (gint64) coeff[i];
+
+        /* remove factor from int matrix */
+        res = (res + (1 << (PRECISION_INT - 1))) >> PRECISION_INT;
+        out_data[n * outchannels + out] = CLAMP (res, G_MININT32, G_MAXINT32);
+      }
     }
   }
 }
@@ -764,21 +884,47 @@ static void
 gst_audio_channel_mixer_mix_float (GstAudioChannelMixer * mix,
     const gfloat * in_data, gfloat * out_data, gint samples)
 {
-  gint in, out, n;
+  gint i, out, n;
   gfloat res;
   gint inchannels, outchannels;
 
   inchannels = mix->in_channels;
   outchannels = mix->out_channels;
 
-  for (n = 0; n < samples; n++) {
-    for (out = 0; out < outchannels; out++) {
-      /* convert */
-      res = 0.0;
-      for (in = 0; in < inchannels; in++)
-        res += in_data[n * inchannels + in] * mix->matrix[in][out];
-
-      out_data[n * outchannels + out] = res;
+  for (out = 0; out < outchannels; out++) {
+    gint count = mix->sparse_count[out];
+    const gint *idx = mix->sparse_in[out];
+    const gfloat *coeff = mix->sparse_coeff[out];
+
+    if (count == 0) {
+      for (n = 0; n < samples; n++)
+        out_data[n * outchannels + out] = 0.0;
+    } else if (count == 1 && coeff[0] == 1.0) {
+      const gfloat *s = in_data + idx[0];
+
+      for (n = 0; n < samples; n++)
+        out_data[n * outchannels + out] = s[n * inchannels];
+    } else if (count == 1) {
+      const gfloat *s = in_data + idx[0];
+      gfloat c = coeff[0];
+
+      for (n = 0; n < samples; n++)
+        out_data[n * outchannels + out] = s[n * inchannels] * c;
+    } else if (count == 2) {
+      const gfloat *s0 = in_data + idx[0], *s1 = in_data + idx[1];
+      gfloat c0 = coeff[0], c1 = coeff[1];
+
+      for (n = 0; n < samples; n++)
+        out_data[n * outchannels + out] =
+            s0[n * inchannels] * c0 + s1[n * inchannels] * c1;
+    } else {
+      for (n = 0; n < samples; n++) {
+        res = 0.0;
+        for (i = 0; i < count; i++)
+          res += in_data[n * inchannels + idx[i]] * coeff[i];
+
+        out_data[n * outchannels + out] = res;
+      }
     }
   }
 }
@@ -787,21 +933,47 @@ static void
 gst_audio_channel_mixer_mix_double (GstAudioChannelMixer * mix,
     const gdouble * in_data, gdouble * out_data, gint samples)
 {
-  gint in, out, n;
+  gint i, out, n;
   gdouble res;
   gint inchannels, outchannels;
 
   inchannels = mix->in_channels;
   outchannels = mix->out_channels;
 
-  for (n = 0; n < samples; n++) {
-    for (out = 0; out < outchannels; out++) {
-      /* convert */
-      res = 0.0;
-      for (in = 0; in < inchannels; in++)
-        res += in_data[n * inchannels + in] * mix->matrix[in][out];
-
-      out_data[n * outchannels + out] = res;
+  for (out = 0; out < outchannels; out++) {
+    gint count = mix->sparse_count[out];
+    const gint *idx = mix->sparse_in[out];
+    const gfloat *coeff = mix->sparse_coeff[out];
+
+    if (count == 0) {
+      for (n = 0; n < samples; n++)
+        out_data[n * outchannels + out] = 0.0;
+    } else if (count == 1 && coeff[0] == 1.0) {
+      const gdouble *s = in_data + idx[0];
+
+      for (n = 0; n < samples; n++)
+        out_data[n * outchannels + out] = s[n * inchannels];
+    } else if (count == 1) {
+      const gdouble *s = in_data + idx[0];
+      gdouble c = coeff[0];
+
+      for (n = 0; n < samples; n++)
+        out_data[n * outchannels + out] = s[n * inchannels] * c;
+    } else if (count == 2) {
+      const gdouble *s0 = in_data + idx[0], *s1 = in_data + idx[1];
+      gdouble c0 = coeff[0], c1 = coeff[1];
+
+      for (n = 0; n < samples; n++)
+        out_data[n * outchannels + out] =
+            s0[n * inchannels] * c0 + s1[n * inchannels] * c1;
+    } else {
+      for (n = 0; n < samples; n++) {
+        res = 0.0;
+        for (i = 0; i < count; i++)
+          res += in_data[n * inchannels + idx[i]] * coeff[i];
+
+        out_data[n * outchannels + out] = res;
+      }
     }
   }
 }
@@ -236,6 +236,57 @@ gst_audio_reorder_channels (gpointer data, gsize size, GstAudioFormat format,
   ptr = data;
 
   n = size / bpf;
+
+  /* Specialized versions for the common sample widths that move whole
+   * samples with direct indexing; two memcpy calls per sample make
+   * reordering needlessly expensive with high channel counts. The data is
+   * not guaranteed to be aligned to the sample size (it may come from
+   * arbitrary byte offsets in a stream), so fall back below if it isn't. */
+  switch (((guintptr) ptr & (bps - 1)) == 0 ? bps : 0) {
+    case 1:{
+      guint8 *p = ptr;
+
+      for (i = 0; i < n; i++, p += channels) {
+        memcpy (tmp, p, bpf);
+        for (j = 0; j < channels; j++)
+          p[reorder_map[j]] = tmp[j];
+      }
+      return TRUE;
+    }
+    case 2:{
+      guint16 *p = (guint16 *) ptr, *t = (guint16 *) tmp;
+
+      for (i = 0; i < n; i++, p += channels) {
+        memcpy (tmp, p, bpf);
+        for (j = 0; j < channels; j++)
+          p[reorder_map[j]] = t[j];
+      }
+      return TRUE;
+    }
+    case 4:{
+      guint32 *p = (guint32 *) ptr, *t = (guint32 *) tmp;
+
+      for (i = 0; i < n; i++, p += channels) {
+        memcpy (tmp, p, bpf);
+        for (j = 0; j < channels; j++)
+          p[reorder_map[j]] = t[j];
+      }
+      return TRUE;
+    }
+    case 8:{
+      guint64 *p = (guint64 *) ptr, *t = (guint64 *) tmp;
+
+      for (i = 0; i < n; i++, p += channels) {
+        memcpy (tmp, p, bpf);
+        for (j = 0; j < channels; j++)
+          p[reorder_map[j]] = t[j];
+      }
+      return TRUE;
+    }
+    default:
+      break;
+  }
+
   for (i = 0; i < n; i++) {
 
     memcpy (tmp, ptr, bpf);
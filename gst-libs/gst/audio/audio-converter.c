@@ -139,6 +139,13 @@ struct _GstAudioConverter
   AudioConvertEndianFunc swap_endian;
 
   AudioConvertSamplesFunc convert;
+
+  /* split conversion */
+  GstAudioConverter **split;
+  guint n_split;
+  GMutex split_lock;
+  GCond split_cond;
+  guint split_pending;
 };
 
 typedef gboolean (*AudioChainFunc) (AudioChain * chain, gpointer user_data);
@@ -242,7 +249,6 @@ audio_chain_get_samples (AudioChain * chain, gsize * avail)
   return res;
 }
 
-/*
 static guint
 get_opt_uint (GstAudioConverter * convert, const gchar * opt, guint def)
 {
@@ -251,7 +257,6 @@ get_opt_uint (GstAudioConverter * convert, const gchar * opt, guint def)
     res = def;
   return res;
 }
-*/
 
 static gint
 get_opt_enum (GstAudioConverter * convert, const gchar * opt, GType type,
@@ -267,6 +272,7 @@ get_opt_enum (GstAudioConverter * convert, const gchar * opt, GType type,
 #define DEFAULT_OPT_DITHER_METHOD GST_AUDIO_DITHER_NONE
 #define DEFAULT_OPT_NOISE_SHAPING_METHOD GST_AUDIO_NOISE_SHAPING_NONE
 #define DEFAULT_OPT_QUANTIZATION 1
+#define DEFAULT_OPT_THREADS 1
 
 #define GET_OPT_RESAMPLER_METHOD(c) get_opt_enum(c, \
     GST_AUDIO_CONVERTER_OPT_RESAMPLER_METHOD, GST_TYPE_AUDIO_RESAMPLER_METHOD, \
@@ -279,6 +285,8 @@ get_opt_enum (GstAudioConverter * convert, const gchar * opt, GType type,
     DEFAULT_OPT_NOISE_SHAPING_METHOD)
 #define GET_OPT_QUANTIZATION(c) get_opt_uint(c, \
     GST_AUDIO_CONVERTER_OPT_QUANTIZATION, DEFAULT_OPT_QUANTIZATION)
+#define GET_OPT_THREADS(c) get_opt_uint(c, \
+    GST_AUDIO_CONVERTER_OPT_THREADS, DEFAULT_OPT_THREADS)
 
 static gboolean
 copy_config (GQuark field_id, const GValue * value, gpointer user_data)
@@ -336,6 +344,12 @@ gst_audio_converter_update_config (GstAudioConverter * convert,
     gst_audio_resampler_update (convert->resampler, in_rate, out_rate, config);
 
   if (config) {
+    guint i;
+
+    for (i = 0; i < convert->n_split; i++)
+      gst_audio_converter_update_config (convert->split[i], in_rate, out_rate,
+          gst_structure_copy (config));
+
     gst_structure_foreach (config, copy_config, convert);
     gst_structure_free (config);
   }
@@ -1048,6 +1062,161 @@ converter_resample (GstAudioConverter * convert,
   return TRUE;
 }
 
+typedef struct
+{
+  GstAudioConverter *convert;
+  GstAudioConverter *sub;
+  GstAudioConverterFlags flags;
+  gpointer in_data;
+  gpointer out_data;
+  gsize frames;
+} SplitTask;
+
+static void
+audio_converter_split_run_task (SplitTask * task)
+{
+  gpointer in[1] = { task->in_data };
+  gpointer out[1] = { task->out_data };
+
+  gst_audio_converter_samples (task->sub, task->flags,
+      task->in_data ? in : NULL, task->frames, out, task->frames);
+}
+
+static void
+audio_converter_split_worker (gpointer data, gpointer user_data)
+{
+  SplitTask *task = data;
+  GstAudioConverter *convert = task->convert;
+
+  audio_converter_split_run_task (task);
+
+  g_mutex_lock (&convert->split_lock);
+  convert->split_pending--;
+  g_cond_signal (&convert->split_cond);
+  g_mutex_unlock (&convert->split_lock);
+}
+
+static GThreadPool *
+audio_converter_get_pool (void)
+{
+  static gsize init_gonce = 0;
+  static GThreadPool *pool = NULL;
+
+  if (g_once_init_enter (&init_gonce)) {
+    GError *err = NULL;
+
+    pool = g_thread_pool_new (audio_converter_split_worker, NULL,
+        g_get_num_processors (), FALSE, &err);
+    if (pool == NULL) {
+      GST_WARNING ("failed to create thread pool: %s", err->message);
+      g_clear_error (&err);
+    }
+    g_once_init_leave (&init_gonce, 1);
+  }
+  return pool;
+}
+
+/* the worker function that splits the conversion into equal chunks of
+ * frames and converts them in parallel with the sub-converters */
+static gboolean
+converter_split (GstAudioConverter * convert,
+    GstAudioConverterFlags flags, gpointer in[], gsize in_frames,
+    gpointer out[], gsize out_frames)
+{
+  GThreadPool *pool = audio_converter_get_pool ();
+  SplitTask *tasks;
+  gsize offset = 0, chunk;
+  gint in_bpf, out_bpf;
+  guint i, n;
+
+  n = convert->n_split;
+
+  if (pool == NULL || in_frames < n)
+    return gst_audio_converter_samples (convert->split[0], flags, in,
+        in_frames, out, out_frames);
+
+  in_bpf = convert->in.bpf;
+  out_bpf = convert->out.bpf;
+  chunk = (in_frames + n - 1) / n;
+
+  tasks = g_newa (SplitTask, n);
+
+  g_mutex_lock (&convert->split_lock);
+  convert->split_pending = n - 1;
+  g_mutex_unlock (&convert->split_lock);
+
+  for (i = 0; i < n; i++) {
+    SplitTask *task = &tasks[i];
+    gsize frames = MIN (chunk, in_frames - offset);
+
+    task->convert = convert;
+    task->sub = convert->split[i];
+    task->flags = flags;
+    task->in_data = in ? (guint8 *) in[0] + offset * in_bpf : NULL;
+    task->out_data = (guint8 *) out[0] + offset * out_bpf;
+    task->frames = frames;
+    offset += frames;
+
+    if (i < n - 1)
+      g_thread_pool_push (pool, task, NULL);
+  }
+  /* do the last chunk ourselves while the pool runs the others */
+  audio_converter_split_run_task (&tasks[n - 1]);
+
+  g_mutex_lock (&convert->split_lock);
+  while (convert->split_pending > 0)
+    g_cond_wait (&convert->split_cond, &convert->split_lock);
+  g_mutex_unlock (&convert->split_lock);
+
+  return TRUE;
+}
+
+static void
+audio_converter_setup_split (GstAudioConverter * convert)
+{
+  guint i, n_threads;
+
+  n_threads = GET_OPT_THREADS (convert);
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+  if (n_threads <= 1)
+    return;
+
+  /* only the generic path is worth splitting, passthrough and endian
+   * conversion are already memory bound */
+  if (convert->convert != converter_generic)
+    return;
+  /* the resampler and the noise shaper keep history between calls, chunks
+   * can't be converted independently then */
+  if (convert->resampler != NULL)
+    return;
+  if (GET_OPT_NOISE_SHAPING_METHOD (convert) != GST_AUDIO_NOISE_SHAPING_NONE)
+    return;
+
+  convert->split = g_new0 (GstAudioConverter *, n_threads);
+  for (i = 0; i < n_threads; i++) {
+    GstStructure *config;
+
+    config = gst_structure_copy (convert->config);
+    gst_structure_set (config, GST_AUDIO_CONVERTER_OPT_THREADS,
+        G_TYPE_UINT, (guint) 1, NULL);
+
+    convert->split[i] = gst_audio_converter_new (convert->flags,
+        &convert->in, &convert->out, config);
+    if (convert->split[i] == NULL) {
+      while (i > 0)
+        gst_audio_converter_free (convert->split[--i]);
+      g_free (convert->split);
+      convert->split = NULL;
+      return;
+    }
+  }
+  convert->n_split = n_threads;
+  convert->convert = converter_split;
+
+  GST_INFO ("split conversion over %d threads", n_threads);
+}
+
 #define GST_AUDIO_FORMAT_IS_ENDIAN_CONVERSION(info1, info2) \
 		( \
 			!(((info1)->flags ^ (info2)->flags) & (~GST_AUDIO_FORMAT_FLAG_UNPACK)) && \
@@ -1094,6 +1263,9 @@ gst_audio_converter_new (GstAudioConverterFlags flags, GstAudioInfo * in_info,
   convert->in = *in_info;
   convert->out = *out_info;
 
+  g_mutex_init (&convert->split_lock);
+  g_cond_init (&convert->split_cond);
+
   /* default config */
   convert->config = gst_structure_new_empty ("GstAudioConverter");
   if (config)
@@ -1167,6 +1339,8 @@ gst_audio_converter_new (GstAudioConverterFlags flags, GstAudioInfo * in_info,
 
   setup_allocators (convert);
 
+  audio_converter_setup_split (convert);
+
   return convert;
 
   /* ERRORS */
@@ -1203,6 +1377,15 @@ gst_audio_converter_free (GstAudioConverter * convert)
     gst_audio_channel_mixer_free (convert->mix);
   if (convert->resampler)
     gst_audio_resampler_free (convert->resampler);
+  if (convert->split) {
+    guint i;
+
+    for (i = 0; i < convert->n_split; i++)
+      gst_audio_converter_free (convert->split[i]);
+    g_free (convert->split);
+  }
+  g_mutex_clear (&convert->split_lock);
+  g_cond_clear (&convert->split_cond);
   gst_audio_info_init (&convert->in);
   gst_audio_info_init (&convert->out);
 
@@ -1280,10 +1463,14 @@ gst_audio_converter_get_max_latency (GstAudioConverter * convert)
 void
 gst_audio_converter_reset (GstAudioConverter * convert)
 {
+  guint i;
+
   if (convert->resampler)
     gst_audio_resampler_reset (convert->resampler);
   if (convert->quant)
     gst_audio_quantize_reset (convert->quant);
+  for (i = 0; i < convert->n_split; i++)
+    gst_audio_converter_reset (convert->split[i]);
 }
 
 /**
@@ -1343,3 +1530,22 @@ gst_audio_converter_supports_inplace (GstAudioConverter * convert)
 {
   return convert->in_place;
 }
+
+/**
+ * gst_audio_converter_is_passthrough:
+ * @convert: a #GstAudioConverter
+ *
+ * Returns whether the audio converter is in passthrough mode and the
+ * conversion would not modify the samples at all. The return value would
+ * be typically input to gst_base_transform_set_passthrough(), so that the
+ * input buffers can be forwarded without mapping them.
+ *
+ * Returns: %TRUE when no conversion will actually occur.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_audio_converter_is_passthrough (GstAudioConverter * convert)
+{
+  return convert->convert == converter_passthrough;
+}
@@ -64,6 +64,19 @@ typedef struct _GstAudioConverter GstAudioConverter;
  */
 #define GST_AUDIO_CONVERTER_OPT_QUANTIZATION   "GstAudioConverter.quantization"
 
+/**
+ * GST_AUDIO_CONVERTER_OPT_THREADS:
+ *
+ * #G_TYPE_UINT, The maximum number of threads to use.
+ * The input is split into equal chunks of frames that are converted in
+ * parallel. This is only done for conversions that keep no history between
+ * calls, so not when resampling or noise shaping.
+ * Default is 1, set to 0 to use the number of available processors.
+ *
+ * Since: 1.14
+ */
+#define GST_AUDIO_CONVERTER_OPT_THREADS   "GstAudioConverter.threads"
+
 
 /**
  * GstAudioConverterFlags:
@@ -122,4 +135,7 @@ gboolean             gst_audio_converter_samples         (GstAudioConverter * co
 GST_EXPORT
 gboolean             gst_audio_converter_supports_inplace (GstAudioConverter *convert);
 
+GST_EXPORT
+gboolean             gst_audio_converter_is_passthrough  (GstAudioConverter *convert);
+
 #endif /* __GST_AUDIO_CONVERTER_H__ */
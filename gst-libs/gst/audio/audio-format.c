@@ -22,6 +22,7 @@
 #endif
 
 #include <string.h>
+#include <stdlib.h>
 
 #include "audio-format.h"
 
@@ -401,6 +402,37 @@ gst_audio_format_build_integer (gboolean sign, gint endianness,
   return GST_AUDIO_FORMAT_UNKNOWN;
 }
 
+/* index into formats[], sorted by format name. Lookup by string is then a
+ * binary search instead of a strcmp against every table entry, which matters
+ * on the caps to GstAudioInfo path during renegotiation. Built on first
+ * use, like the equivalent index in video-format.c */
+static guint16 format_name_index[G_N_ELEMENTS (formats)];
+
+static gint
+format_name_index_compare (gconstpointer a, gconstpointer b)
+{
+  const guint16 *ia = a, *ib = b;
+
+  return strcmp (GST_AUDIO_FORMAT_INFO_NAME (&formats[*ia]),
+      GST_AUDIO_FORMAT_INFO_NAME (&formats[*ib]));
+}
+
+static void
+ensure_format_name_index (void)
+{
+  static gsize once = 0;
+
+  if (g_once_init_enter (&once)) {
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (formats); i++)
+      format_name_index[i] = i;
+    qsort (format_name_index, G_N_ELEMENTS (formats),
+        sizeof (format_name_index[0]), format_name_index_compare);
+    g_once_init_leave (&once, 1);
+  }
+}
+
 /**
  * gst_audio_format_from_string:
  * @format: a format string
@@ -413,13 +445,25 @@ gst_audio_format_build_integer (gboolean sign, gint endianness,
 GstAudioFormat
 gst_audio_format_from_string (const gchar * format)
 {
-  guint i;
+  gint lo, hi;
 
   g_return_val_if_fail (format != NULL, GST_AUDIO_FORMAT_UNKNOWN);
 
-  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
-    if (strcmp (GST_AUDIO_FORMAT_INFO_NAME (&formats[i]), format) == 0)
-      return GST_AUDIO_FORMAT_INFO_FORMAT (&formats[i]);
+  ensure_format_name_index ();
+
+  lo = 0;
+  hi = G_N_ELEMENTS (formats) - 1;
+  while (lo <= hi) {
+    gint mid = (lo + hi) / 2;
+    const GstAudioFormatInfo *info = &formats[format_name_index[mid]];
+    gint cmp = strcmp (format, GST_AUDIO_FORMAT_INFO_NAME (info));
+
+    if (cmp == 0)
+      return GST_AUDIO_FORMAT_INFO_FORMAT (info);
+    else if (cmp < 0)
+      hi = mid - 1;
+    else
+      lo = mid + 1;
   }
   return GST_AUDIO_FORMAT_UNKNOWN;
 }
@@ -179,6 +179,80 @@ gst_audio_info_set_format (GstAudioInfo * info, GstAudioFormat format,
     info->position[i] = GST_AUDIO_CHANNEL_POSITION_NONE;
 }
 
+/* memo cache for gst_audio_info_from_caps(). The resulting info is fully
+ * determined by the five scalar fields extracted from the caps structure,
+ * so entries are keyed by value and a hit is a plain struct copy, skipping
+ * the channel mask conversion and position validation. Elements that
+ * renegotiate between the same few configurations stay in the cache */
+typedef struct
+{
+  GstAudioFormat format;
+  GstAudioLayout layout;
+  gint rate;
+  gint channels;
+  gboolean has_channel_mask;
+  guint64 channel_mask;
+  GstAudioInfo info;
+} AudioInfoCacheEntry;
+
+#define AUDIO_INFO_CACHE_SIZE 8
+
+static GMutex audio_info_cache_lock;
+static AudioInfoCacheEntry audio_info_cache[AUDIO_INFO_CACHE_SIZE];
+static guint audio_info_cache_len;
+static guint audio_info_cache_next;
+
+static gboolean
+audio_info_cache_lookup (GstAudioFormat format, GstAudioLayout layout,
+    gint rate, gint channels, gboolean has_channel_mask, guint64 channel_mask,
+    GstAudioInfo * info)
+{
+  gboolean found = FALSE;
+  guint i;
+
+  g_mutex_lock (&audio_info_cache_lock);
+  for (i = 0; i < audio_info_cache_len; i++) {
+    AudioInfoCacheEntry *entry = &audio_info_cache[i];
+
+    if (entry->format == format && entry->layout == layout &&
+        entry->rate == rate && entry->channels == channels &&
+        entry->has_channel_mask == has_channel_mask &&
+        entry->channel_mask == channel_mask) {
+      *info = entry->info;
+      found = TRUE;
+      break;
+    }
+  }
+  g_mutex_unlock (&audio_info_cache_lock);
+
+  return found;
+}
+
+static void
+audio_info_cache_store (GstAudioFormat format, GstAudioLayout layout,
+    gint rate, gint channels, gboolean has_channel_mask, guint64 channel_mask,
+    const GstAudioInfo * info)
+{
+  AudioInfoCacheEntry *entry;
+
+  g_mutex_lock (&audio_info_cache_lock);
+  if (audio_info_cache_len < AUDIO_INFO_CACHE_SIZE) {
+    entry = &audio_info_cache[audio_info_cache_len++];
+  } else {
+    /* replace entries round-robin once the cache is full */
+    entry = &audio_info_cache[audio_info_cache_next];
+    audio_info_cache_next = (audio_info_cache_next + 1) % AUDIO_INFO_CACHE_SIZE;
+  }
+  entry->format = format;
+  entry->layout = layout;
+  entry->rate = rate;
+  entry->channels = channels;
+  entry->has_channel_mask = has_channel_mask;
+  entry->channel_mask = channel_mask;
+  entry->info = *info;
+  g_mutex_unlock (&audio_info_cache_lock);
+}
+
 /**
  * gst_audio_info_from_caps:
  * @info: a #GstAudioInfo
@@ -195,7 +269,8 @@ gst_audio_info_from_caps (GstAudioInfo * info, const GstCaps * caps)
   const gchar *s;
   GstAudioFormat format;
   gint rate, channels;
-  guint64 channel_mask;
+  guint64 channel_mask = 0;
+  gboolean has_channel_mask;
   gint i;
   GstAudioChannelPosition position[64];
   GstAudioFlags flags;
@@ -235,8 +310,16 @@ gst_audio_info_from_caps (GstAudioInfo * info, const GstCaps * caps)
   if (!gst_structure_get_int (str, "channels", &channels))
     goto no_channels;
 
-  if (!gst_structure_get (str, "channel-mask", GST_TYPE_BITMASK, &channel_mask,
-          NULL) || (channel_mask == 0 && channels == 1)) {
+  has_channel_mask = gst_structure_get (str, "channel-mask", GST_TYPE_BITMASK,
+      &channel_mask, NULL);
+
+  /* everything below only depends on the values extracted above, so a
+   * previously parsed identical configuration can be copied as is */
+  if (audio_info_cache_lookup (format, layout, rate, channels,
+          has_channel_mask, channel_mask, info))
+    return TRUE;
+
+  if (!has_channel_mask || (channel_mask == 0 && channels == 1)) {
     if (channels == 1) {
       position[0] = GST_AUDIO_CHANNEL_POSITION_MONO;
     } else if (channels == 2) {
@@ -261,6 +344,9 @@ gst_audio_info_from_caps (GstAudioInfo * info, const GstCaps * caps)
   info->flags = flags;
   info->layout = layout;
 
+  audio_info_cache_store (format, layout, rate, channels, has_channel_mask,
+      channel_mask, info);
+
   return TRUE;
 
   /* ERROR */
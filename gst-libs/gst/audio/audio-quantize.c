@@ -223,6 +223,32 @@ gst_audio_quantize_quantize_int_dither_feedback (GstAudioQuantize * quant,
   memmove (e, &e[len], sizeof (gint32) * stride);
 }
 
+/* Like setup_error_buf() but lays the errors out per channel, in
+ * consecutive blocks of (samples + extra) values with the history of
+ * each channel at the start of its block. The blocked layout keeps the
+ * error filter taps of one channel in contiguous memory. */
+static void
+setup_error_buf_chan (GstAudioQuantize * quant, gint samples, gint extra)
+{
+  gint stride = quant->stride;
+  gint blocksize = samples + extra;
+  gint len = blocksize * stride;
+
+  if (quant->error_size < len) {
+    gint32 *e = g_new0 (gint32, len);
+    gint i, oldblock = quant->error_size / stride;
+
+    /* move the per-channel history to the start of the larger blocks */
+    for (i = 0; i < stride && quant->error_buf; i++)
+      memcpy (&e[i * blocksize], &quant->error_buf[i * oldblock],
+          extra * sizeof (gint32));
+
+    g_free (quant->error_buf);
+    quant->error_buf = e;
+    quant->error_size = len;
+  }
+}
+
 #define SHIFT 10
 #define REDUCE 8
 #define RROUND (1<<(REDUCE-1))
@@ -234,42 +260,48 @@ gst_audio_quantize_quantize_int_dither_noise_shape (GstAudioQuantize * quant,
     const gpointer src, gpointer dst, gint samples)
 {
   guint32 mask;
-  gint i, j, k, len, stride, nc;
+  gint i, j, ch, stride, nc;
   const gint32 *s = src;
   gint32 *c, *dith, *d = dst, v, o, *e, err;
 
   nc = quant->n_coeffs;
 
   setup_dither_buf (quant, samples);
-  setup_error_buf (quant, samples, nc);
+  setup_error_buf_chan (quant, samples, nc);
 
   stride = quant->stride;
-  len = samples * stride;
   dith = quant->dither_buf;
-  e = quant->error_buf;
   c = quant->coeffs;
   mask = ~quant->mask;
 
-  for (i = 0; i < len; i++) {
-    v = s[i];
-    /* combine and remove error */
-    err = 0;
-    for (j = 0, k = i; j < nc; j++, k += stride)
-      err -= e[k] * c[j];
-    err = (err + SROUND) >> (SREDUCE);
-    ADDSS (v, err);
-    o = v;
-    /* add dither */
-    err = dith[i];
-    ADDSS (v, err);
-    /* quantize */
-    v &= mask;
-    /* store new error with reduced precision */
-    e[k] = (v - o + RROUND) >> REDUCE;
-    /* store result */
-    d[i] = v;
+  /* Process channel by channel over a per-channel error block so that
+   * the filter taps read contiguous memory and the compiler can
+   * vectorize the convolution. The feedback through the newly stored
+   * error keeps the recurrence itself serial within a channel. */
+  for (ch = 0; ch < stride; ch++) {
+    e = quant->error_buf + ch * (samples + nc);
+
+    for (i = 0; i < samples; i++) {
+      v = s[i * stride + ch];
+      /* combine and remove error */
+      err = 0;
+      for (j = 0; j < nc; j++)
+        err -= e[i + j] * c[j];
+      err = (err + SROUND) >> (SREDUCE);
+      ADDSS (v, err);
+      o = v;
+      /* add dither */
+      err = dith[i * stride + ch];
+      ADDSS (v, err);
+      /* quantize */
+      v &= mask;
+      /* store new error with reduced precision */
+      e[i + nc] = (v - o + RROUND) >> REDUCE;
+      /* store result */
+      d[i * stride + ch] = v;
+    }
+    memmove (e, &e[samples], sizeof (gint32) * nc);
   }
-  memmove (e, &e[len], sizeof (gint32) * stride * nc);
 }
 
 #define MAKE_QUANTIZE_FUNC_NAME(name)                                   \
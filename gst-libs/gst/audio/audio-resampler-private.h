@@ -85,10 +85,11 @@ struct _GstAudioResampler
   gint alloc_taps;
   gint alloc_phases;
 
-  /* cached taps */
+  /* cached taps, memory shared between resamplers with the
+   * same filter parameters */
+  gpointer shared_taps;
   gpointer *cached_phases;
   gpointer cached_taps;
-  gpointer cached_taps_mem;
   gsize cached_taps_stride;
 
   ConvertTapsFunc convert_taps;
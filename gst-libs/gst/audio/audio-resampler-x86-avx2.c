@@ -0,0 +1,306 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "audio-resampler-x86-avx2.h"
+
+#if defined (HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+
+/* The taps and sample memory is only guaranteed to be aligned to the
+ * 16 byte ALIGN of the resampler, so all 32 byte loads and stores need
+ * to be unaligned ones. n_taps is always a multiple of 8. */
+
+static inline void
+inner_product_gfloat_full_1_avx2 (gfloat * o, const gfloat * a,
+    const gfloat * b, gint len, const gfloat * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256 sum = _mm256_setzero_ps ();
+  __m128 sum128;
+
+  for (; i < len; i += 8)
+    sum = _mm256_fmadd_ps (_mm256_loadu_ps (a + i), _mm256_loadu_ps (b + i),
+        sum);
+
+  sum128 = _mm_add_ps (_mm256_castps256_ps128 (sum),
+      _mm256_extractf128_ps (sum, 1));
+  sum128 = _mm_add_ps (sum128, _mm_movehl_ps (sum128, sum128));
+  sum128 = _mm_add_ss (sum128, _mm_shuffle_ps (sum128, sum128, 0x55));
+  _mm_store_ss (o, sum128);
+}
+
+static inline void
+inner_product_gfloat_linear_1_avx2 (gfloat * o, const gfloat * a,
+    const gfloat * b, gint len, const gfloat * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256 sum[2], t;
+  __m128 sum128;
+  const gfloat *c[2] = { (gfloat *) ((gint8 *) b + 0 * bstride),
+    (gfloat *) ((gint8 *) b + 1 * bstride)
+  };
+
+  sum[0] = sum[1] = _mm256_setzero_ps ();
+
+  for (; i < len; i += 8) {
+    t = _mm256_loadu_ps (a + i);
+    sum[0] = _mm256_fmadd_ps (t, _mm256_loadu_ps (c[0] + i), sum[0]);
+    sum[1] = _mm256_fmadd_ps (t, _mm256_loadu_ps (c[1] + i), sum[1]);
+  }
+  sum[0] = _mm256_mul_ps (_mm256_sub_ps (sum[0], sum[1]),
+      _mm256_broadcast_ss (icoeff));
+  sum[0] = _mm256_add_ps (sum[0], sum[1]);
+  sum128 = _mm_add_ps (_mm256_castps256_ps128 (sum[0]),
+      _mm256_extractf128_ps (sum[0], 1));
+  sum128 = _mm_add_ps (sum128, _mm_movehl_ps (sum128, sum128));
+  sum128 = _mm_add_ss (sum128, _mm_shuffle_ps (sum128, sum128, 0x55));
+  _mm_store_ss (o, sum128);
+}
+
+static inline void
+inner_product_gfloat_cubic_1_avx2 (gfloat * o, const gfloat * a,
+    const gfloat * b, gint len, const gfloat * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256 sum[4], t;
+  __m128 f = _mm_loadu_ps (icoeff), sum128;
+  const gfloat *c[4] = { (gfloat *) ((gint8 *) b + 0 * bstride),
+    (gfloat *) ((gint8 *) b + 1 * bstride),
+    (gfloat *) ((gint8 *) b + 2 * bstride),
+    (gfloat *) ((gint8 *) b + 3 * bstride)
+  };
+
+  sum[0] = sum[1] = sum[2] = sum[3] = _mm256_setzero_ps ();
+
+  for (; i < len; i += 8) {
+    t = _mm256_loadu_ps (a + i);
+    sum[0] = _mm256_fmadd_ps (t, _mm256_loadu_ps (c[0] + i), sum[0]);
+    sum[1] = _mm256_fmadd_ps (t, _mm256_loadu_ps (c[1] + i), sum[1]);
+    sum[2] = _mm256_fmadd_ps (t, _mm256_loadu_ps (c[2] + i), sum[2]);
+    sum[3] = _mm256_fmadd_ps (t, _mm256_loadu_ps (c[3] + i), sum[3]);
+  }
+  sum[0] = _mm256_mul_ps (sum[0],
+      _mm256_broadcastss_ps (_mm_shuffle_ps (f, f, 0x00)));
+  sum[1] = _mm256_mul_ps (sum[1],
+      _mm256_broadcastss_ps (_mm_shuffle_ps (f, f, 0x55)));
+  sum[2] = _mm256_mul_ps (sum[2],
+      _mm256_broadcastss_ps (_mm_shuffle_ps (f, f, 0xaa)));
+  sum[3] = _mm256_mul_ps (sum[3],
+      _mm256_broadcastss_ps (_mm_shuffle_ps (f, f, 0xff)));
+  sum[0] = _mm256_add_ps (sum[0], sum[1]);
+  sum[2] = _mm256_add_ps (sum[2], sum[3]);
+  sum[0] = _mm256_add_ps (sum[0], sum[2]);
+  sum128 = _mm_add_ps (_mm256_castps256_ps128 (sum[0]),
+      _mm256_extractf128_ps (sum[0], 1));
+  sum128 = _mm_add_ps (sum128, _mm_movehl_ps (sum128, sum128));
+  sum128 = _mm_add_ss (sum128, _mm_shuffle_ps (sum128, sum128, 0x55));
+  _mm_store_ss (o, sum128);
+}
+
+static inline void
+inner_product_gdouble_full_1_avx2 (gdouble * o, const gdouble * a,
+    const gdouble * b, gint len, const gdouble * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256d sum = _mm256_setzero_pd ();
+  __m128d sum128;
+
+  for (; i < len; i += 8) {
+    sum = _mm256_fmadd_pd (_mm256_loadu_pd (a + i + 0),
+        _mm256_loadu_pd (b + i + 0), sum);
+    sum = _mm256_fmadd_pd (_mm256_loadu_pd (a + i + 4),
+        _mm256_loadu_pd (b + i + 4), sum);
+  }
+  sum128 = _mm_add_pd (_mm256_castpd256_pd128 (sum),
+      _mm256_extractf128_pd (sum, 1));
+  sum128 = _mm_add_sd (sum128, _mm_unpackhi_pd (sum128, sum128));
+  _mm_store_sd (o, sum128);
+}
+
+static inline void
+inner_product_gdouble_linear_1_avx2 (gdouble * o, const gdouble * a,
+    const gdouble * b, gint len, const gdouble * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256d sum[2], t;
+  __m128d sum128;
+  const gdouble *c[2] = { (gdouble *) ((gint8 *) b + 0 * bstride),
+    (gdouble *) ((gint8 *) b + 1 * bstride)
+  };
+
+  sum[0] = sum[1] = _mm256_setzero_pd ();
+
+  for (; i < len; i += 4) {
+    t = _mm256_loadu_pd (a + i);
+    sum[0] = _mm256_fmadd_pd (t, _mm256_loadu_pd (c[0] + i), sum[0]);
+    sum[1] = _mm256_fmadd_pd (t, _mm256_loadu_pd (c[1] + i), sum[1]);
+  }
+  sum[0] = _mm256_mul_pd (_mm256_sub_pd (sum[0], sum[1]),
+      _mm256_broadcast_sd (icoeff));
+  sum[0] = _mm256_add_pd (sum[0], sum[1]);
+  sum128 = _mm_add_pd (_mm256_castpd256_pd128 (sum[0]),
+      _mm256_extractf128_pd (sum[0], 1));
+  sum128 = _mm_add_sd (sum128, _mm_unpackhi_pd (sum128, sum128));
+  _mm_store_sd (o, sum128);
+}
+
+static inline void
+inner_product_gdouble_cubic_1_avx2 (gdouble * o, const gdouble * a,
+    const gdouble * b, gint len, const gdouble * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256d sum[4], t;
+  __m128d sum128;
+  const gdouble *c[4] = { (gdouble *) ((gint8 *) b + 0 * bstride),
+    (gdouble *) ((gint8 *) b + 1 * bstride),
+    (gdouble *) ((gint8 *) b + 2 * bstride),
+    (gdouble *) ((gint8 *) b + 3 * bstride)
+  };
+
+  sum[0] = sum[1] = sum[2] = sum[3] = _mm256_setzero_pd ();
+
+  for (; i < len; i += 4) {
+    t = _mm256_loadu_pd (a + i);
+    sum[0] = _mm256_fmadd_pd (t, _mm256_loadu_pd (c[0] + i), sum[0]);
+    sum[1] = _mm256_fmadd_pd (t, _mm256_loadu_pd (c[1] + i), sum[1]);
+    sum[2] = _mm256_fmadd_pd (t, _mm256_loadu_pd (c[2] + i), sum[2]);
+    sum[3] = _mm256_fmadd_pd (t, _mm256_loadu_pd (c[3] + i), sum[3]);
+  }
+  sum[0] = _mm256_mul_pd (sum[0], _mm256_broadcast_sd (icoeff + 0));
+  sum[1] = _mm256_mul_pd (sum[1], _mm256_broadcast_sd (icoeff + 1));
+  sum[2] = _mm256_mul_pd (sum[2], _mm256_broadcast_sd (icoeff + 2));
+  sum[3] = _mm256_mul_pd (sum[3], _mm256_broadcast_sd (icoeff + 3));
+  sum[0] = _mm256_add_pd (sum[0], sum[1]);
+  sum[2] = _mm256_add_pd (sum[2], sum[3]);
+  sum[0] = _mm256_add_pd (sum[0], sum[2]);
+  sum128 = _mm_add_pd (_mm256_castpd256_pd128 (sum[0]),
+      _mm256_extractf128_pd (sum[0], 1));
+  sum128 = _mm_add_sd (sum128, _mm_unpackhi_pd (sum128, sum128));
+  _mm_store_sd (o, sum128);
+}
+
+MAKE_RESAMPLE_FUNC (gfloat, full, 1, avx2);
+MAKE_RESAMPLE_FUNC (gfloat, linear, 1, avx2);
+MAKE_RESAMPLE_FUNC (gfloat, cubic, 1, avx2);
+
+MAKE_RESAMPLE_FUNC (gdouble, full, 1, avx2);
+MAKE_RESAMPLE_FUNC (gdouble, linear, 1, avx2);
+MAKE_RESAMPLE_FUNC (gdouble, cubic, 1, avx2);
+
+void
+interpolate_gfloat_linear_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gfloat *o = op, *a = ap, *ic = icp;
+  __m256 f[2], t;
+  const gfloat *c[2] = { (gfloat *) ((gint8 *) a + 0 * astride),
+    (gfloat *) ((gint8 *) a + 1 * astride)
+  };
+
+  f[0] = _mm256_broadcast_ss (ic + 0);
+  f[1] = _mm256_broadcast_ss (ic + 1);
+
+  for (i = 0; i < len; i += 8) {
+    t = _mm256_mul_ps (_mm256_loadu_ps (c[0] + i), f[0]);
+    t = _mm256_fmadd_ps (_mm256_loadu_ps (c[1] + i), f[1], t);
+    _mm256_storeu_ps (o + i, t);
+  }
+}
+
+void
+interpolate_gfloat_cubic_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gfloat *o = op, *a = ap, *ic = icp;
+  __m256 f[4], t;
+  const gfloat *c[4] = { (gfloat *) ((gint8 *) a + 0 * astride),
+    (gfloat *) ((gint8 *) a + 1 * astride),
+    (gfloat *) ((gint8 *) a + 2 * astride),
+    (gfloat *) ((gint8 *) a + 3 * astride)
+  };
+
+  f[0] = _mm256_broadcast_ss (ic + 0);
+  f[1] = _mm256_broadcast_ss (ic + 1);
+  f[2] = _mm256_broadcast_ss (ic + 2);
+  f[3] = _mm256_broadcast_ss (ic + 3);
+
+  for (i = 0; i < len; i += 8) {
+    t = _mm256_mul_ps (_mm256_loadu_ps (c[0] + i), f[0]);
+    t = _mm256_fmadd_ps (_mm256_loadu_ps (c[1] + i), f[1], t);
+    t = _mm256_fmadd_ps (_mm256_loadu_ps (c[2] + i), f[2], t);
+    t = _mm256_fmadd_ps (_mm256_loadu_ps (c[3] + i), f[3], t);
+    _mm256_storeu_ps (o + i, t);
+  }
+}
+
+void
+interpolate_gdouble_linear_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gdouble *o = op, *a = ap, *ic = icp;
+  __m256d f[2], t;
+  const gdouble *c[2] = { (gdouble *) ((gint8 *) a + 0 * astride),
+    (gdouble *) ((gint8 *) a + 1 * astride)
+  };
+
+  f[0] = _mm256_broadcast_sd (ic + 0);
+  f[1] = _mm256_broadcast_sd (ic + 1);
+
+  for (i = 0; i < len; i += 4) {
+    t = _mm256_mul_pd (_mm256_loadu_pd (c[0] + i), f[0]);
+    t = _mm256_fmadd_pd (_mm256_loadu_pd (c[1] + i), f[1], t);
+    _mm256_storeu_pd (o + i, t);
+  }
+}
+
+void
+interpolate_gdouble_cubic_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gdouble *o = op, *a = ap, *ic = icp;
+  __m256d f[4], t;
+  const gdouble *c[4] = { (gdouble *) ((gint8 *) a + 0 * astride),
+    (gdouble *) ((gint8 *) a + 1 * astride),
+    (gdouble *) ((gint8 *) a + 2 * astride),
+    (gdouble *) ((gint8 *) a + 3 * astride)
+  };
+
+  f[0] = _mm256_broadcast_sd (ic + 0);
+  f[1] = _mm256_broadcast_sd (ic + 1);
+  f[2] = _mm256_broadcast_sd (ic + 2);
+  f[3] = _mm256_broadcast_sd (ic + 3);
+
+  for (i = 0; i < len; i += 4) {
+    t = _mm256_mul_pd (_mm256_loadu_pd (c[0] + i), f[0]);
+    t = _mm256_fmadd_pd (_mm256_loadu_pd (c[1] + i), f[1], t);
+    t = _mm256_fmadd_pd (_mm256_loadu_pd (c[2] + i), f[2], t);
+    t = _mm256_fmadd_pd (_mm256_loadu_pd (c[3] + i), f[3], t);
+    _mm256_storeu_pd (o + i, t);
+  }
+}
+
+#endif
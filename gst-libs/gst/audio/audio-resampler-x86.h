@@ -21,6 +21,14 @@
 #include "audio-resampler-x86-sse.h"
 #include "audio-resampler-x86-sse2.h"
 #include "audio-resampler-x86-sse41.h"
+#include "audio-resampler-x86-avx2.h"
+
+/* which instruction sets audio_resampler_check_x86() actually enabled,
+ * used to filter the calibration candidates below */
+static gboolean x86_have_sse;
+static gboolean x86_have_sse2;
+static gboolean x86_have_sse41;
+static gboolean x86_have_avx2;
 
 static void
 audio_resampler_check_x86 (const gchar *option)
@@ -28,6 +36,7 @@ audio_resampler_check_x86 (const gchar *option)
   if (!strcmp (option, "sse")) {
 #if defined (HAVE_XMMINTRIN_H) && HAVE_SSE
     GST_DEBUG ("enable SSE optimisations");
+    x86_have_sse = TRUE;
     resample_gfloat_full_1 = resample_gfloat_full_1_sse;
     resample_gfloat_linear_1 = resample_gfloat_linear_1_sse;
     resample_gfloat_cubic_1 = resample_gfloat_cubic_1_sse;
@@ -40,6 +49,7 @@ audio_resampler_check_x86 (const gchar *option)
   } else if (!strcmp (option, "sse2")) {
 #if defined (HAVE_EMMINTRIN_H) && HAVE_SSE2
     GST_DEBUG ("enable SSE2 optimisations");
+    x86_have_sse2 = TRUE;
     resample_gint16_full_1 = resample_gint16_full_1_sse2;
     resample_gint16_linear_1 = resample_gint16_linear_1_sse2;
     resample_gint16_cubic_1 = resample_gint16_cubic_1_sse2;
@@ -61,11 +71,99 @@ audio_resampler_check_x86 (const gchar *option)
     defined (HAVE_SMMINTRIN_H) && defined (HAVE_EMMINTRIN_H) && \
     HAVE_SSE41
     GST_DEBUG ("enable SSE41 optimisations");
+    x86_have_sse41 = TRUE;
     resample_gint32_full_1 = resample_gint32_full_1_sse41;
     resample_gint32_linear_1 = resample_gint32_linear_1_sse41;
     resample_gint32_cubic_1 = resample_gint32_cubic_1_sse41;
 #else
     GST_DEBUG ("SSE41 optimisations not enabled");
+#endif
+  } else if (!strcmp (option, "avx2")) {
+#if defined (HAVE_IMMINTRIN_H) && defined (__GNUC__) && HAVE_AVX2
+    /* we can get here from a direct probe without Orc having checked the
+     * CPU, ask the CPU itself. AVX2 machines all have FMA but the kernels
+     * are compiled with -mfma so check it anyway. */
+    if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma")) {
+      GST_DEBUG ("enable AVX2 optimisations");
+      x86_have_avx2 = TRUE;
+      resample_gfloat_full_1 = resample_gfloat_full_1_avx2;
+      resample_gfloat_linear_1 = resample_gfloat_linear_1_avx2;
+      resample_gfloat_cubic_1 = resample_gfloat_cubic_1_avx2;
+
+      interpolate_gfloat_linear = interpolate_gfloat_linear_avx2;
+      interpolate_gfloat_cubic = interpolate_gfloat_cubic_avx2;
+
+      resample_gdouble_full_1 = resample_gdouble_full_1_avx2;
+      resample_gdouble_linear_1 = resample_gdouble_linear_1_avx2;
+      resample_gdouble_cubic_1 = resample_gdouble_cubic_1_avx2;
+
+      interpolate_gdouble_linear = interpolate_gdouble_linear_avx2;
+      interpolate_gdouble_cubic = interpolate_gdouble_cubic_avx2;
+    } else {
+      GST_DEBUG ("AVX2 not supported by the CPU");
+    }
+#else
+    GST_DEBUG ("AVX2 optimisations not enabled");
 #endif
   }
 }
+
+/* every compiled-in kernel per resample_funcs slot, including the plain C
+ * ones, as candidates for the optional init-time calibration */
+static const ResampleKernelCandidate audio_resampler_x86_candidates[] = {
+  {4, "c", resample_gint16_full_1_c},
+  {5, "c", resample_gint32_full_1_c},
+  {6, "c", resample_gfloat_full_1_c},
+  {7, "c", resample_gdouble_full_1_c},
+  {8, "c", resample_gint16_linear_1_c},
+  {9, "c", resample_gint32_linear_1_c},
+  {10, "c", resample_gfloat_linear_1_c},
+  {11, "c", resample_gdouble_linear_1_c},
+  {12, "c", resample_gint16_cubic_1_c},
+  {13, "c", resample_gint32_cubic_1_c},
+  {14, "c", resample_gfloat_cubic_1_c},
+  {15, "c", resample_gdouble_cubic_1_c},
+#if defined (HAVE_XMMINTRIN_H) && HAVE_SSE
+  {6, "sse", resample_gfloat_full_1_sse},
+  {10, "sse", resample_gfloat_linear_1_sse},
+  {14, "sse", resample_gfloat_cubic_1_sse},
+#endif
+#if defined (HAVE_EMMINTRIN_H) && HAVE_SSE2
+  {4, "sse2", resample_gint16_full_1_sse2},
+  {7, "sse2", resample_gdouble_full_1_sse2},
+  {8, "sse2", resample_gint16_linear_1_sse2},
+  {11, "sse2", resample_gdouble_linear_1_sse2},
+  {12, "sse2", resample_gint16_cubic_1_sse2},
+  {15, "sse2", resample_gdouble_cubic_1_sse2},
+#endif
+#if defined (__x86_64__) && \
+    defined (HAVE_SMMINTRIN_H) && defined (HAVE_EMMINTRIN_H) && \
+    HAVE_SSE41
+  {5, "sse41", resample_gint32_full_1_sse41},
+  {9, "sse41", resample_gint32_linear_1_sse41},
+  {13, "sse41", resample_gint32_cubic_1_sse41},
+#endif
+#if defined (HAVE_IMMINTRIN_H) && defined (__GNUC__) && HAVE_AVX2
+  {6, "avx2", resample_gfloat_full_1_avx2},
+  {7, "avx2", resample_gdouble_full_1_avx2},
+  {10, "avx2", resample_gfloat_linear_1_avx2},
+  {11, "avx2", resample_gdouble_linear_1_avx2},
+  {14, "avx2", resample_gfloat_cubic_1_avx2},
+  {15, "avx2", resample_gdouble_cubic_1_avx2},
+#endif
+};
+
+/* a kernel may only be timed when its instruction set was enabled */
+static gboolean
+audio_resampler_x86_candidate_usable (const ResampleKernelCandidate * cand)
+{
+  if (!strcmp (cand->name, "c"))
+    return TRUE;
+  if (!strcmp (cand->name, "sse"))
+    return x86_have_sse;
+  if (!strcmp (cand->name, "sse2"))
+    return x86_have_sse2;
+  if (!strcmp (cand->name, "sse41"))
+    return x86_have_sse41;
+  return x86_have_avx2;
+}
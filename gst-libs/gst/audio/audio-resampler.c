@@ -513,7 +513,11 @@ DECL_GET_TAPS_FULL_FUNC(type)
   gint phase = (n_phases == out_rate ? *samp_phase :                            \
       ((gint64)*samp_phase * n_phases) / out_rate);                             \
                                                                                 \
-  res = resampler->cached_phases[phase];                                        \
+  /* the cache can be shared between resamplers; filling a phase is       */    \
+  /* idempotent since the taps only depend on the filter parameters, so   */    \
+  /* concurrent fills write identical data and we only need the pointer   */    \
+  /* publication to be atomic */                                                \
+  res = g_atomic_pointer_get (&resampler->cached_phases[phase]);                \
   if (G_UNLIKELY (res == NULL)) {                                               \
     res = (gint8 *) resampler->cached_taps +                                    \
                         phase * resampler->cached_taps_stride;                  \
@@ -553,7 +557,7 @@ DECL_GET_TAPS_FULL_FUNC(type)
         resampler->interpolate (res, taps, n_taps, ic, taps_stride);            \
       }                                                                         \
     }                                                                           \
-    resampler->cached_phases[phase] = res;                                      \
+    g_atomic_pointer_set (&resampler->cached_phases[phase], res);               \
   }                                                                             \
   *samp_index += resampler->samp_inc;                                           \
   *samp_phase += resampler->samp_frac;                                          \
@@ -822,6 +826,15 @@ static ResampleFunc resample_funcs[] = {
 #define resample_gfloat_cubic_1 resample_funcs[14]
 #define resample_gdouble_cubic_1 resample_funcs[15]
 
+/* one compiled-in implementation of a resample_funcs entry, candidate
+ * for the optional init-time calibration below */
+typedef struct
+{
+  guint slot;                   /* index in resample_funcs */
+  const gchar *name;            /* instruction set name */
+  ResampleFunc func;
+} ResampleKernelCandidate;
+
 #if defined HAVE_ORC && !defined DISABLE_ORC
 # if defined (HAVE_ARM_NEON)
 #  define CHECK_NEON
@@ -833,6 +846,164 @@ static ResampleFunc resample_funcs[] = {
 # endif
 #endif
 
+#ifdef CHECK_X86
+/* The CPUID based selection in audio_resampler_check_x86() installs the
+ * widest available kernel, which is not the fastest one on every
+ * microarchitecture. When the GST_AUDIO_RESAMPLER_CALIBRATE environment
+ * variable is set, every compiled-in kernel is instead timed once at
+ * init time through a small scratch resampler and the winner is
+ * installed in the dispatch table. */
+
+#define CALIBRATE_RATE_IN   48000
+#define CALIBRATE_RATE_OUT  44100
+#define CALIBRATE_FRAMES    512
+#define CALIBRATE_CALLS     64
+#define CALIBRATE_ROUNDS    4
+
+/* the format and filter options that make setup_functions() select a
+ * given slot, index 0 corresponds to slot 4 */
+static const struct
+{
+  GstAudioFormat format;
+  GstAudioResamplerFilterMode filter_mode;
+  GstAudioResamplerFilterInterpolation filter_interpolation;
+} calibrate_slot_config[12] = {
+  {GST_AUDIO_FORMAT_S16, GST_AUDIO_RESAMPLER_FILTER_MODE_FULL,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_NONE},
+  {GST_AUDIO_FORMAT_S32, GST_AUDIO_RESAMPLER_FILTER_MODE_FULL,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_NONE},
+  {GST_AUDIO_FORMAT_F32, GST_AUDIO_RESAMPLER_FILTER_MODE_FULL,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_NONE},
+  {GST_AUDIO_FORMAT_F64, GST_AUDIO_RESAMPLER_FILTER_MODE_FULL,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_NONE},
+  {GST_AUDIO_FORMAT_S16, GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_LINEAR},
+  {GST_AUDIO_FORMAT_S32, GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_LINEAR},
+  {GST_AUDIO_FORMAT_F32, GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_LINEAR},
+  {GST_AUDIO_FORMAT_F64, GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_LINEAR},
+  {GST_AUDIO_FORMAT_S16, GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_CUBIC},
+  {GST_AUDIO_FORMAT_S32, GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_CUBIC},
+  {GST_AUDIO_FORMAT_F32, GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_CUBIC},
+  {GST_AUDIO_FORMAT_F64, GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_CUBIC},
+};
+
+/* returns the best of CALIBRATE_ROUNDS timings of the kernel in
+ * microseconds, taking the minimum so scheduling noise only slows a
+ * round down and never speeds one up */
+static gint64
+audio_resampler_time_kernel (GstAudioResampler * resampler,
+    ResampleFunc func, gpointer in, gpointer out)
+{
+  gint64 best = G_MAXINT64;
+  gint round, i;
+
+  resampler->resample = func;
+
+  for (round = 0; round < CALIBRATE_ROUNDS; round++) {
+    gint64 elapsed, start = g_get_monotonic_time ();
+
+    for (i = 0; i < CALIBRATE_CALLS; i++) {
+      gpointer in_frames[1] = { in };
+      gpointer out_frames[1] = { out };
+      gsize out_len;
+
+      out_len = gst_audio_resampler_get_out_frames (resampler,
+          CALIBRATE_FRAMES);
+      gst_audio_resampler_resample (resampler, in_frames, CALIBRATE_FRAMES,
+          out_frames, out_len);
+    }
+    elapsed = g_get_monotonic_time () - start;
+    best = MIN (best, elapsed);
+  }
+  return best;
+}
+
+static void
+audio_resampler_calibrate_kernels (const ResampleKernelCandidate * candidates,
+    guint n_candidates, gboolean (*usable) (const ResampleKernelCandidate *))
+{
+  gpointer in, out;
+  guint slot, i;
+
+  /* large enough for CALIBRATE_FRAMES mono frames of the widest format */
+  in = g_malloc0 (CALIBRATE_FRAMES * sizeof (gdouble));
+  out = g_malloc0 (CALIBRATE_FRAMES * sizeof (gdouble));
+
+  for (slot = 4; slot < G_N_ELEMENTS (resample_funcs); slot++) {
+    GstAudioResampler *resampler;
+    GstStructure *options;
+    ResampleFunc best_func = NULL;
+    const gchar *best_name = NULL;
+    gint64 best_time = G_MAXINT64;
+    guint n_usable = 0;
+
+    for (i = 0; i < n_candidates; i++)
+      if (candidates[i].slot == slot && usable (&candidates[i]))
+        n_usable++;
+    /* nothing to choose between */
+    if (n_usable < 2)
+      continue;
+
+    options = gst_structure_new ("resampler-options",
+        GST_AUDIO_RESAMPLER_OPT_FILTER_MODE,
+        GST_TYPE_AUDIO_RESAMPLER_FILTER_MODE,
+        calibrate_slot_config[slot - 4].filter_mode,
+        GST_AUDIO_RESAMPLER_OPT_FILTER_INTERPOLATION,
+        GST_TYPE_AUDIO_RESAMPLER_FILTER_INTERPOLATION,
+        calibrate_slot_config[slot - 4].filter_interpolation, NULL);
+    resampler = gst_audio_resampler_new (GST_AUDIO_RESAMPLER_METHOD_KAISER,
+        GST_AUDIO_RESAMPLER_FLAG_NONE, calibrate_slot_config[slot - 4].format,
+        1, CALIBRATE_RATE_IN, CALIBRATE_RATE_OUT, options);
+    gst_structure_free (options);
+    if (resampler == NULL)
+      continue;
+
+    /* the options must have selected the slot being calibrated, the
+     * candidates are only exchangeable against its taps layout */
+    if (resampler->resample != resample_funcs[slot]) {
+      gst_audio_resampler_free (resampler);
+      continue;
+    }
+
+    /* warm up the caches and the branch predictors */
+    audio_resampler_time_kernel (resampler, resample_funcs[slot], in, out);
+
+    for (i = 0; i < n_candidates; i++) {
+      gint64 elapsed;
+
+      if (candidates[i].slot != slot || !usable (&candidates[i]))
+        continue;
+
+      elapsed = audio_resampler_time_kernel (resampler, candidates[i].func,
+          in, out);
+      GST_DEBUG ("slot %u: %s kernel took %" G_GINT64_FORMAT " us", slot,
+          candidates[i].name, elapsed);
+      if (elapsed < best_time) {
+        best_time = elapsed;
+        best_func = candidates[i].func;
+        best_name = candidates[i].name;
+      }
+    }
+    gst_audio_resampler_free (resampler);
+
+    if (best_func != NULL && best_func != resample_funcs[slot]) {
+      GST_INFO ("slot %u: installing calibrated %s kernel", slot, best_name);
+      resample_funcs[slot] = best_func;
+    }
+  }
+
+  g_free (in);
+  g_free (out);
+}
+#endif /* CHECK_X86 */
+
 static void
 audio_resampler_init (void)
 {
@@ -874,6 +1045,15 @@ audio_resampler_init (void)
         }
       }
     }
+#ifdef CHECK_X86
+    /* Orc doesn't report an avx2 target flag, probe the CPU directly */
+    audio_resampler_check_x86 ("avx2");
+
+    if (g_getenv ("GST_AUDIO_RESAMPLER_CALIBRATE") != NULL)
+      audio_resampler_calibrate_kernels (audio_resampler_x86_candidates,
+          G_N_ELEMENTS (audio_resampler_x86_candidates),
+          audio_resampler_x86_candidate_usable);
+#endif
 #endif
     g_once_init_leave (&init_gonce, 1);
   }
@@ -973,27 +1153,120 @@ alloc_taps_mem (GstAudioResampler * resampler, gint bps, gint n_taps,
   resampler->alloc_phases = n_phases;
 }
 
+/* The full filter tables only depend on the filter parameters and not on
+ * the state of a particular resampler. They can be large, so they are kept
+ * in a process-wide list of refcounted entries and shared, read-only,
+ * between all resamplers constructed with the same parameters. */
+typedef struct
+{
+  gint refcount;
+
+  GstAudioResamplerMethod method;
+  gint format_index;
+  GstAudioResamplerFilterInterpolation filter_interpolation;
+  gint oversample;
+  gint n_taps;
+  gint n_phases;
+  gdouble cutoff;
+  gdouble kaiser_beta;
+  gdouble b, c;
+  gsize stride;
+
+  gpointer mem;
+  gpointer *phases;
+  gpointer taps;
+} SharedTaps;
+
+static GList *shared_taps_list;
+G_LOCK_DEFINE_STATIC (shared_taps_lock);
+
+static void
+release_cache_mem (GstAudioResampler * resampler)
+{
+  SharedTaps *shared = resampler->shared_taps;
+
+  if (shared == NULL)
+    return;
+
+  G_LOCK (shared_taps_lock);
+  if (--shared->refcount == 0) {
+    shared_taps_list = g_list_remove (shared_taps_list, shared);
+    g_free (shared->mem);
+    g_slice_free (SharedTaps, shared);
+  }
+  G_UNLOCK (shared_taps_lock);
+
+  resampler->shared_taps = NULL;
+  resampler->cached_taps = NULL;
+  resampler->cached_phases = NULL;
+}
+
 static void
 alloc_cache_mem (GstAudioResampler * resampler, gint bps, gint n_taps,
     gint n_phases)
 {
-  gsize phases_size;
+  SharedTaps *shared;
+  GList *walk;
+  gsize phases_size, stride;
 
   resampler->tmp_taps =
       g_realloc_n (resampler->tmp_taps, n_taps, sizeof (gdouble));
 
-  resampler->cached_taps_stride =
-      GST_ROUND_UP_32 (bps * (n_taps + TAPS_OVERREAD));
+  release_cache_mem (resampler);
+
+  stride = GST_ROUND_UP_32 (bps * (n_taps + TAPS_OVERREAD));
 
-  phases_size = sizeof (gpointer) * n_phases;
+  G_LOCK (shared_taps_lock);
+  for (walk = shared_taps_list; walk; walk = walk->next) {
+    shared = walk->data;
+
+    if (shared->method == resampler->method &&
+        shared->format_index == resampler->format_index &&
+        shared->filter_interpolation == resampler->filter_interpolation &&
+        shared->oversample == resampler->oversample &&
+        shared->n_taps == n_taps &&
+        shared->n_phases == n_phases &&
+        shared->cutoff == resampler->cutoff &&
+        shared->kaiser_beta == resampler->kaiser_beta &&
+        shared->b == resampler->b && shared->c == resampler->c &&
+        shared->stride == stride)
+      break;
+  }
+  if (walk == NULL) {
+    GST_DEBUG ("allocate shared taps, bps %d n_taps %d n_phases %d", bps,
+        n_taps, n_phases);
+
+    shared = g_slice_new0 (SharedTaps);
+    shared->refcount = 0;
+    shared->method = resampler->method;
+    shared->format_index = resampler->format_index;
+    shared->filter_interpolation = resampler->filter_interpolation;
+    shared->oversample = resampler->oversample;
+    shared->n_taps = n_taps;
+    shared->n_phases = n_phases;
+    shared->cutoff = resampler->cutoff;
+    shared->kaiser_beta = resampler->kaiser_beta;
+    shared->b = resampler->b;
+    shared->c = resampler->c;
+    shared->stride = stride;
+
+    phases_size = sizeof (gpointer) * n_phases;
+    shared->mem = g_malloc0 (phases_size + n_phases * stride + ALIGN - 1);
+    shared->phases = shared->mem;
+    shared->taps = MEM_ALIGN ((gint8 *) shared->mem + phases_size, ALIGN);
+
+    shared_taps_list = g_list_prepend (shared_taps_list, shared);
+  } else {
+    GST_DEBUG ("reuse shared taps, bps %d n_taps %d n_phases %d", bps,
+        n_taps, n_phases);
+  }
+  shared->refcount++;
+  G_UNLOCK (shared_taps_lock);
 
-  g_free (resampler->cached_taps_mem);
-  resampler->cached_taps_mem =
-      g_malloc0 (phases_size + n_phases * resampler->cached_taps_stride +
-      ALIGN - 1);
-  resampler->cached_taps =
-      MEM_ALIGN ((gint8 *) resampler->cached_taps_mem + phases_size, ALIGN);
-  resampler->cached_phases = resampler->cached_taps_mem;
+  resampler->shared_taps = shared;
+  resampler->cached_taps = shared->taps;
+  resampler->cached_phases = shared->phases;
+  resampler->cached_taps_stride = shared->stride;
 }
 
 static void
@@ -1608,7 +1881,7 @@ gst_audio_resampler_free (GstAudioResampler * resampler)
 {
   g_return_if_fail (resampler != NULL);
 
-  g_free (resampler->cached_taps_mem);
+  release_cache_mem (resampler);
   g_free (resampler->taps_mem);
   g_free (resampler->tmp_taps);
   g_free (resampler->samples);
@@ -42,6 +42,10 @@ GST_DEBUG_CATEGORY_STATIC (gst_audio_base_sink_debug);
 #define GST_AUDIO_BASE_SINK_GET_PRIVATE(obj)  \
    (G_TYPE_INSTANCE_GET_PRIVATE ((obj), GST_TYPE_AUDIO_BASE_SINK, GstAudioBaseSinkPrivate))
 
+/* number of (itime, etime) observations we keep to estimate the rate of
+ * the external clock relative to our own clock */
+#define GST_AUDIO_BASE_SINK_SKEW_WINDOW 32
+
 struct _GstAudioBaseSinkPrivate
 {
   /* upstream latency */
@@ -53,6 +57,14 @@ struct _GstAudioBaseSinkPrivate
   /* the number of samples we aligned last time */
   gint64 last_align;
 
+  /* sliding window of clock observations with running regression sums,
+   * updated incrementally so the rate estimate is O(1) per observation */
+  gdouble skew_obs_x[GST_AUDIO_BASE_SINK_SKEW_WINDOW];
+  gdouble skew_obs_y[GST_AUDIO_BASE_SINK_SKEW_WINDOW];
+  gint skew_obs_count, skew_obs_pos;
+  GstClockTime skew_base_itime, skew_base_etime;
+  gdouble skew_sum_x, skew_sum_y, skew_sum_xx, skew_sum_xy;
+
   gboolean sync_latency;
 
   GstClockTime eos_time;
@@ -117,6 +129,7 @@ enum
   PROP_ALIGNMENT_THRESHOLD,
   PROP_DRIFT_TOLERANCE,
   PROP_DISCONT_WAIT,
+  PROP_STATS,
 
   PROP_LAST
 };
@@ -152,6 +165,8 @@ static GstFlowReturn gst_audio_base_sink_preroll (GstBaseSink * bsink,
     GstBuffer * buffer);
 static GstFlowReturn gst_audio_base_sink_render (GstBaseSink * bsink,
     GstBuffer * buffer);
+static GstFlowReturn gst_audio_base_sink_render_list (GstBaseSink * bsink,
+    GstBufferList * list);
 static gboolean gst_audio_base_sink_event (GstBaseSink * bsink,
     GstEvent * event);
 static GstFlowReturn gst_audio_base_sink_wait_event (GstBaseSink * bsink,
@@ -249,6 +264,20 @@ gst_audio_base_sink_class_init (GstAudioBaseSinkClass * klass)
           G_MAXUINT64 - 1, DEFAULT_DISCONT_WAIT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioBaseSink:stats:
+   *
+   * A snapshot of the underrun and delay statistics the ringbuffer
+   * collects while running, see gst_audio_ring_buffer_get_stats().
+   * %NULL when no ringbuffer has been created yet.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Stats",
+          "Underrun and delay statistics of the ringbuffer",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_audio_base_sink_change_state);
   gstelement_class->provide_clock =
@@ -264,6 +293,8 @@ gst_audio_base_sink_class_init (GstAudioBaseSinkClass * klass)
       GST_DEBUG_FUNCPTR (gst_audio_base_sink_get_times);
   gstbasesink_class->preroll = GST_DEBUG_FUNCPTR (gst_audio_base_sink_preroll);
   gstbasesink_class->render = GST_DEBUG_FUNCPTR (gst_audio_base_sink_render);
+  gstbasesink_class->render_list =
+      GST_DEBUG_FUNCPTR (gst_audio_base_sink_render_list);
   gstbasesink_class->query = GST_DEBUG_FUNCPTR (gst_audio_base_sink_query_pad);
   gstbasesink_class->activate_pull =
       GST_DEBUG_FUNCPTR (gst_audio_base_sink_activate_pull);
@@ -889,6 +920,11 @@ gst_audio_base_sink_get_property (GObject * object, guint prop_id,
     case PROP_DRIFT_TOLERANCE:
       g_value_set_int64 (value, gst_audio_base_sink_get_drift_tolerance (sink));
       break;
+    case PROP_STATS:
+      if (sink->ringbuffer)
+        g_value_take_boxed (value,
+            gst_audio_ring_buffer_get_stats (sink->ringbuffer));
+      break;
     case PROP_ALIGNMENT_THRESHOLD:
       g_value_set_uint64 (value,
           gst_audio_base_sink_get_alignment_threshold (sink));
@@ -1035,6 +1071,20 @@ gst_audio_base_sink_fixate (GstBaseSink * bsink, GstCaps * caps)
   return caps;
 }
 
+/* drop all skew observations and running regression sums. Must be called
+ * whenever the calibration offset jumps: the old observations were taken
+ * against the pre-jump etime base and would bias the estimated rate */
+static inline void
+gst_audio_base_sink_reset_skew_observations (GstAudioBaseSink * sink)
+{
+  sink->priv->skew_obs_count = 0;
+  sink->priv->skew_obs_pos = 0;
+  sink->priv->skew_sum_x = 0.0;
+  sink->priv->skew_sum_y = 0.0;
+  sink->priv->skew_sum_xx = 0.0;
+  sink->priv->skew_sum_xy = 0.0;
+}
+
 static inline void
 gst_audio_base_sink_reset_sync (GstAudioBaseSink * sink)
 {
@@ -1043,6 +1093,7 @@ gst_audio_base_sink_reset_sync (GstAudioBaseSink * sink)
   sink->priv->discont_time = -1;
   sink->priv->avg_skew = -1;
   sink->priv->last_align = 0;
+  gst_audio_base_sink_reset_skew_observations (sink);
 }
 
 static void
@@ -1401,6 +1452,72 @@ gst_audio_base_sink_resample_slaving (GstAudioBaseSink * sink,
   *srender_stop = render_stop;
 }
 
+/* Add one (itime, etime) observation to the sliding window and update the
+ * running regression sums, adding the new and expiring the oldest
+ * observation in constant time.
+ *
+ * Returns TRUE and the estimated rate of the external clock relative to
+ * our internal clock when the window holds enough observations for a
+ * usable estimate. The window is only valid for a fixed calibration
+ * offset; when the offset is jumped the caller must reset it with
+ * gst_audio_base_sink_reset_skew_observations() */
+static gboolean
+gst_audio_base_sink_add_skew_observation (GstAudioBaseSink * sink,
+    GstClockTime itime, GstClockTime etime, gdouble * rate)
+{
+  GstAudioBaseSinkPrivate *priv = sink->priv;
+  gdouble x, y, n, denom;
+  gint pos = priv->skew_obs_pos;
+
+  if (priv->skew_obs_count == 0) {
+    priv->skew_base_itime = itime;
+    priv->skew_base_etime = etime;
+  }
+  /* keep the values small relative to the window base so the squared
+   * sums don't lose precision */
+  x = (gdouble) GST_CLOCK_DIFF (priv->skew_base_itime, itime);
+  y = (gdouble) GST_CLOCK_DIFF (priv->skew_base_etime, etime);
+
+  if (priv->skew_obs_count == GST_AUDIO_BASE_SINK_SKEW_WINDOW) {
+    gdouble ox = priv->skew_obs_x[pos], oy = priv->skew_obs_y[pos];
+
+    /* expire the oldest observation from the running sums */
+    priv->skew_sum_x -= ox;
+    priv->skew_sum_y -= oy;
+    priv->skew_sum_xx -= ox * ox;
+    priv->skew_sum_xy -= ox * oy;
+  } else {
+    priv->skew_obs_count++;
+  }
+  priv->skew_obs_x[pos] = x;
+  priv->skew_obs_y[pos] = y;
+  priv->skew_sum_x += x;
+  priv->skew_sum_y += y;
+  priv->skew_sum_xx += x * x;
+  priv->skew_sum_xy += x * y;
+  priv->skew_obs_pos = (pos + 1) % GST_AUDIO_BASE_SINK_SKEW_WINDOW;
+
+  if (priv->skew_obs_count < GST_AUDIO_BASE_SINK_SKEW_WINDOW / 4)
+    return FALSE;
+
+  n = (gdouble) priv->skew_obs_count;
+  denom = n * priv->skew_sum_xx - priv->skew_sum_x * priv->skew_sum_x;
+  if (denom <= 0.0)
+    return FALSE;
+
+  *rate = (n * priv->skew_sum_xy - priv->skew_sum_x * priv->skew_sum_y) /
+      denom;
+
+  /* no sane clock drifts this much, start over */
+  if (*rate < 0.9 || *rate > 1.1)
+    return FALSE;
+
+  return TRUE;
+}
+
+/* precision of the calibration rate we derive from the estimator */
+#define SKEW_RATE_PRECISION (G_GINT64_CONSTANT (1) << 32)
+
 /* algorithm to calculate sample positions that will result in changing the
  * playout pointer to match the clock rate of the master */
 static void
@@ -1409,8 +1526,10 @@ gst_audio_base_sink_skew_slaving (GstAudioBaseSink * sink,
     GstClockTime * srender_start, GstClockTime * srender_stop)
 {
   GstClockTime cinternal, cexternal, crate_num, crate_denom;
-  GstClockTime etime, itime;
+  GstClockTime etime, itime, itime_scaled;
   GstClockTimeDiff skew, mdrift, mdrift2;
+  gdouble rate = 1.0, corr;
+  gboolean have_rate;
   gint driftsamples;
   gint64 last_align;
 
@@ -1434,10 +1553,19 @@ gst_audio_base_sink_skew_slaving (GstAudioBaseSink * sink,
   etime = etime > cexternal ? etime - cexternal : 0;
   itime = itime > cinternal ? itime - cinternal : 0;
 
+  if (crate_num == 0)
+    crate_denom = crate_num = 1;
+
+  /* take rate corrections we applied earlier into account */
+  if (crate_num != crate_denom)
+    itime_scaled = gst_util_uint64_scale (itime, crate_num, crate_denom);
+  else
+    itime_scaled = itime;
+
   /* do itime - etime.
    * positive value means external clock goes slower
    * negative value means external clock goes faster */
-  skew = GST_CLOCK_DIFF (etime, itime);
+  skew = GST_CLOCK_DIFF (etime, itime_scaled);
   if (sink->priv->avg_skew == -1) {
     /* first observation */
     sink->priv->avg_skew = skew;
@@ -1446,6 +1574,10 @@ gst_audio_base_sink_skew_slaving (GstAudioBaseSink * sink,
     sink->priv->avg_skew = (31 * sink->priv->avg_skew + skew) / 32;
   }
 
+  /* update the rate estimator with the raw observation */
+  have_rate = gst_audio_base_sink_add_skew_observation (sink, itime, etime,
+      &rate);
+
   GST_DEBUG_OBJECT (sink, "internal %" GST_TIME_FORMAT " external %"
       GST_TIME_FORMAT " skew %" GST_STIME_FORMAT " avg %" GST_STIME_FORMAT,
       GST_TIME_ARGS (itime), GST_TIME_ARGS (etime), GST_STIME_ARGS (skew),
@@ -1455,63 +1587,86 @@ gst_audio_base_sink_skew_slaving (GstAudioBaseSink * sink,
   mdrift = sink->priv->drift_tolerance * 1000;
   mdrift2 = mdrift / 2;
 
-  /* adjust playout pointer based on skew */
-  if (sink->priv->avg_skew > mdrift2) {
-    /* master is running slower, move internal time forward */
-    GST_WARNING_OBJECT (sink,
-        "correct clock skew %" GST_STIME_FORMAT " > %" GST_STIME_FORMAT,
-        GST_STIME_ARGS (sink->priv->avg_skew), GST_STIME_ARGS (mdrift2));
-
-    if (sink->priv->avg_skew > (2 * mdrift)) {
-      cexternal -= sink->priv->avg_skew;
-      sink->priv->avg_skew = 0;
-    } else {
-      cexternal = cexternal > mdrift ? cexternal - mdrift : 0;
-      sink->priv->avg_skew -= mdrift;
-    }
+  /* adjust clock rate or playout pointer based on skew */
+  if (sink->priv->avg_skew > mdrift2 || sink->priv->avg_skew < -mdrift2) {
+    gboolean beyond = sink->priv->avg_skew > (2 * mdrift) ||
+        sink->priv->avg_skew < (2 * -mdrift);
 
-    driftsamples = (sink->ringbuffer->spec.info.rate * mdrift) / GST_SECOND;
-    last_align = sink->priv->last_align;
+    GST_WARNING_OBJECT (sink,
+        "correct clock skew %" GST_STIME_FORMAT ", tolerance %"
+        GST_STIME_FORMAT, GST_STIME_ARGS (sink->priv->avg_skew),
+        GST_STIME_ARGS (mdrift2));
+
+    if (have_rate && !beyond) {
+      /* steer the calibration rate so that the estimated drift is
+       * compensated and the accumulated skew dissolves over the next
+       * second. This keeps the playout pointer in place and so, unlike
+       * jumping the calibration offset, never needs a resync */
+      corr = rate - (gdouble) sink->priv->avg_skew / GST_SECOND;
+
+      crate_denom = SKEW_RATE_PRECISION;
+      crate_num = (GstClockTime) (corr * (gdouble) SKEW_RATE_PRECISION + 0.5);
+
+      GST_DEBUG_OBJECT (sink, "steering rate to %f (estimated rate %f)",
+          corr, rate);
+
+      gst_clock_set_calibration (sink->provided_clock, cinternal, cexternal,
+          crate_num, crate_denom);
+    } else if (sink->priv->avg_skew > 0) {
+      /* master is running slower, move internal time forward */
+      if (beyond) {
+        cexternal -= sink->priv->avg_skew;
+        sink->priv->avg_skew = 0;
+      } else {
+        cexternal = cexternal > mdrift ? cexternal - mdrift : 0;
+        sink->priv->avg_skew -= mdrift;
+      }
+      /* the offset jumped, observations against the old base would bias
+       * the rate estimate */
+      gst_audio_base_sink_reset_skew_observations (sink);
 
-    /* if we were aligning in the wrong direction or we aligned more than what
-     * we will correct, resync */
-    if (last_align < 0 || last_align > driftsamples)
-      sink->next_sample = -1;
+      driftsamples = (sink->ringbuffer->spec.info.rate * mdrift) / GST_SECOND;
+      last_align = sink->priv->last_align;
 
-    GST_DEBUG_OBJECT (sink,
-        "last_align %" G_GINT64_FORMAT " driftsamples %u, next %"
-        G_GUINT64_FORMAT, last_align, driftsamples, sink->next_sample);
+      /* if we were aligning in the wrong direction or we aligned more than
+       * what we will correct, resync */
+      if (last_align < 0 || last_align > driftsamples)
+        sink->next_sample = -1;
 
-    gst_clock_set_calibration (sink->provided_clock, cinternal, cexternal,
-        crate_num, crate_denom);
-  } else if (sink->priv->avg_skew < -mdrift2) {
-    /* master is running faster, move external time forwards */
-    GST_WARNING_OBJECT (sink,
-        "correct clock skew %" GST_STIME_FORMAT " < -%" GST_STIME_FORMAT,
-        GST_STIME_ARGS (sink->priv->avg_skew), GST_STIME_ARGS (mdrift2));
+      GST_DEBUG_OBJECT (sink,
+          "last_align %" G_GINT64_FORMAT " driftsamples %u, next %"
+          G_GUINT64_FORMAT, last_align, driftsamples, sink->next_sample);
 
-    if (sink->priv->avg_skew < (2 * -mdrift)) {
-      cexternal -= sink->priv->avg_skew;
-      sink->priv->avg_skew = 0;
+      gst_clock_set_calibration (sink->provided_clock, cinternal, cexternal,
+          crate_num, crate_denom);
     } else {
-      cexternal += mdrift;
-      sink->priv->avg_skew += mdrift;
-    }
+      /* master is running faster, move external time forwards */
+      if (beyond) {
+        cexternal -= sink->priv->avg_skew;
+        sink->priv->avg_skew = 0;
+      } else {
+        cexternal += mdrift;
+        sink->priv->avg_skew += mdrift;
+      }
+      /* the offset jumped, observations against the old base would bias
+       * the rate estimate */
+      gst_audio_base_sink_reset_skew_observations (sink);
 
-    driftsamples = (sink->ringbuffer->spec.info.rate * mdrift) / GST_SECOND;
-    last_align = sink->priv->last_align;
+      driftsamples = (sink->ringbuffer->spec.info.rate * mdrift) / GST_SECOND;
+      last_align = sink->priv->last_align;
 
-    /* if we were aligning in the wrong direction or we aligned more than what
-     * we will correct, resync */
-    if (last_align > 0 || -last_align > driftsamples)
-      sink->next_sample = -1;
+      /* if we were aligning in the wrong direction or we aligned more than
+       * what we will correct, resync */
+      if (last_align > 0 || -last_align > driftsamples)
+        sink->next_sample = -1;
 
-    GST_DEBUG_OBJECT (sink,
-        "last_align %" G_GINT64_FORMAT " driftsamples %u, next %"
-        G_GUINT64_FORMAT, last_align, driftsamples, sink->next_sample);
+      GST_DEBUG_OBJECT (sink,
+          "last_align %" G_GINT64_FORMAT " driftsamples %u, next %"
+          G_GUINT64_FORMAT, last_align, driftsamples, sink->next_sample);
 
-    gst_clock_set_calibration (sink->provided_clock, cinternal, cexternal,
-        crate_num, crate_denom);
+      gst_clock_set_calibration (sink->provided_clock, cinternal, cexternal,
+          crate_num, crate_denom);
+    }
   }
 
   /* convert, ignoring speed */
@@ -2177,6 +2332,17 @@ no_align:
   GST_DEBUG_OBJECT (sink, "next sample expected at %" G_GUINT64_FORMAT,
       sink->next_sample);
 
+  /* refresh the wait-free snapshot of our provided clock with the device
+   * position we just committed against; if no commit follows within two
+   * segments, clock readers fall back to querying the device */
+  if (gst_audio_base_sink_is_self_provided_clock (sink)) {
+    gst_audio_clock_publish (GST_AUDIO_CLOCK (sink->provided_clock),
+        gst_audio_base_sink_get_time (GST_CLOCK_CAST (sink->provided_clock),
+            sink), 1.0,
+        gst_util_uint64_scale_int (2 * (guint64) ringbuf->samples_per_seg,
+            GST_SECOND, rate));
+  }
+
   if (G_UNLIKELY (GST_CLOCK_TIME_IS_VALID (stop)
           && stop >= bsink->segment.stop)) {
     GST_DEBUG_OBJECT (sink,
@@ -2244,6 +2410,113 @@ sync_latency_failed:
   }
 }
 
+/* Renders a whole buffer list in one go when the buffers are contiguous
+ * in time. The buffers are then collapsed into a single buffer, sharing
+ * the memory blocks, and pushed through the regular render function so
+ * that the clipping, clock slaving and ringbuffer commit (with its
+ * locking) happen once per list instead of once per buffer. Lists that
+ * are not contiguous, need payloading or carry gaps take the per-buffer
+ * path, which behaves exactly like not implementing render_list at all */
+static GstFlowReturn
+gst_audio_base_sink_render_list (GstBaseSink * bsink, GstBufferList * list)
+{
+  GstAudioBaseSink *sink = GST_AUDIO_BASE_SINK (bsink);
+  GstAudioBaseSinkClass *bclass = GST_AUDIO_BASE_SINK_GET_CLASS (sink);
+  GstAudioRingBuffer *ringbuf = sink->ringbuffer;
+  GstClockTime expected = GST_CLOCK_TIME_NONE;
+  GstClockTime tolerance;
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstBuffer *merged;
+  guint i, length;
+  gboolean contiguous;
+  gint bpf, rate;
+
+  length = gst_buffer_list_length (list);
+  if (G_UNLIKELY (length == 0))
+    return GST_FLOW_OK;
+
+  if (length == 1)
+    return gst_audio_base_sink_render (bsink, gst_buffer_list_get (list, 0));
+
+  /* payloaders frame each buffer individually, and without an acquired
+   * ringbuffer we don't know the sample layout; let the per-buffer path
+   * deal with those cases */
+  if (bclass->payload != NULL
+      || G_UNLIKELY (!gst_audio_ring_buffer_is_acquired (ringbuf)))
+    goto fallback;
+
+  bpf = GST_AUDIO_INFO_BPF (&ringbuf->spec.info);
+  rate = GST_AUDIO_INFO_RATE (&ringbuf->spec.info);
+
+  /* the buffers are contiguous when each one starts, within one sample,
+   * where the previous one stopped and none of them needs a resync or is
+   * a gap. Those would have been aligned to the previous sample by the
+   * regular render anyway, so collapsing them renders the same samples */
+  tolerance = gst_util_uint64_scale_int (1, GST_SECOND, rate);
+  contiguous = TRUE;
+  for (i = 0; i < length; i++) {
+    GstBuffer *buf = gst_buffer_list_get (list, i);
+    GstClockTime time = GST_BUFFER_TIMESTAMP (buf);
+    gsize size = gst_buffer_get_size (buf);
+
+    if (G_UNLIKELY (size % bpf) != 0)
+      goto wrong_size;
+
+    if (!GST_CLOCK_TIME_IS_VALID (time)
+        || GST_BUFFER_FLAG_IS_SET (buf, GST_BUFFER_FLAG_GAP)
+        || (i > 0 && (GST_BUFFER_FLAG_IS_SET (buf, GST_BUFFER_FLAG_DISCONT)
+                || GST_BUFFER_FLAG_IS_SET (buf, GST_BUFFER_FLAG_RESYNC)))) {
+      contiguous = FALSE;
+      break;
+    }
+    if (i > 0 && (time > expected + tolerance || time + tolerance < expected)) {
+      GST_DEBUG_OBJECT (sink, "buffer %u not contiguous: %" GST_TIME_FORMAT
+          " but expected %" GST_TIME_FORMAT, i, GST_TIME_ARGS (time),
+          GST_TIME_ARGS (expected));
+      contiguous = FALSE;
+      break;
+    }
+    expected = time +
+        gst_util_uint64_scale_int (size / bpf, GST_SECOND, rate);
+  }
+
+  if (!contiguous)
+    goto fallback;
+
+  /* collapse the list into one buffer carrying the timestamp and flags of
+   * the first one; the memory blocks are shared, not copied */
+  merged = gst_buffer_ref (gst_buffer_list_get (list, 0));
+  for (i = 1; i < length; i++) {
+    merged = gst_buffer_append (merged,
+        gst_buffer_ref (gst_buffer_list_get (list, i)));
+  }
+
+  GST_LOG_OBJECT (sink, "rendering %u contiguous buffers as one", length);
+
+  ret = gst_audio_base_sink_render (bsink, merged);
+  gst_buffer_unref (merged);
+
+  return ret;
+
+fallback:
+  {
+    GST_LOG_OBJECT (sink, "rendering %u buffers one by one", length);
+    for (i = 0; i < length; i++) {
+      ret = gst_audio_base_sink_render (bsink, gst_buffer_list_get (list, i));
+      if (G_UNLIKELY (ret != GST_FLOW_OK))
+        break;
+    }
+    return ret;
+  }
+wrong_size:
+  {
+    GST_DEBUG_OBJECT (sink, "wrong size");
+    GST_ELEMENT_ERROR (sink, STREAM, WRONG_TYPE,
+        (NULL), ("sink received buffer of wrong size."));
+    return GST_FLOW_ERROR;
+  }
+}
+
 /**
  * gst_audio_base_sink_create_ringbuffer:
  * @sink: a #GstAudioBaseSink.
@@ -2454,6 +2727,12 @@ gst_audio_base_sink_change_state (GstElement * element,
       gst_audio_ring_buffer_may_start (sink->ringbuffer, FALSE);
       gst_audio_ring_buffer_pause (sink->ringbuffer);
 
+      /* the device position stops advancing while paused, invalidate the
+       * published snapshot so clock reads don't keep interpolating */
+      if (gst_audio_base_sink_is_self_provided_clock (sink))
+        gst_audio_clock_publish (GST_AUDIO_CLOCK (sink->provided_clock),
+            GST_CLOCK_TIME_NONE, 1.0, 0);
+
       GST_OBJECT_LOCK (sink);
       sink->priv->sync_latency = FALSE;
       GST_OBJECT_UNLOCK (sink);
@@ -52,6 +52,14 @@ struct _GstAudioBaseSrcPrivate
 {
   /* the clock slaving algorithm in use */
   GstAudioBaseSrcSlaveMethod slave_method;
+
+  /* timestamp anchoring: when the interval is non-zero, the device delay
+   * is queried at most once per interval and clock reads in between
+   * interpolate from the sample counter with the cached delay */
+  GstClockTime anchor_interval;
+  GMutex anchor_lock;
+  gint64 anchor_monotonic;      /* 0 = no anchor yet */
+  guint anchor_delay;           /* device delay at the anchor, in samples */
 };
 
 /* BaseAudioSrc signals and args */
@@ -68,6 +76,7 @@ enum
 #define DEFAULT_ACTUAL_LATENCY_TIME    -1
 #define DEFAULT_PROVIDE_CLOCK   TRUE
 #define DEFAULT_SLAVE_METHOD    GST_AUDIO_BASE_SRC_SLAVE_SKEW
+#define DEFAULT_TIMESTAMP_ANCHOR_INTERVAL 0
 
 enum
 {
@@ -78,6 +87,7 @@ enum
   PROP_ACTUAL_LATENCY_TIME,
   PROP_PROVIDE_CLOCK,
   PROP_SLAVE_METHOD,
+  PROP_TIMESTAMP_ANCHOR_INTERVAL,
   PROP_LAST
 };
 
@@ -104,6 +114,7 @@ static void gst_audio_base_src_set_property (GObject * object, guint prop_id,
 static void gst_audio_base_src_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static void gst_audio_base_src_dispose (GObject * object);
+static void gst_audio_base_src_finalize (GObject * object);
 
 static GstStateChangeReturn gst_audio_base_src_change_state (GstElement *
     element, GstStateChange transition);
@@ -141,6 +152,7 @@ gst_audio_base_src_class_init (GstAudioBaseSrcClass * klass)
   gobject_class->set_property = gst_audio_base_src_set_property;
   gobject_class->get_property = gst_audio_base_src_get_property;
   gobject_class->dispose = gst_audio_base_src_dispose;
+  gobject_class->finalize = gst_audio_base_src_finalize;
 
   /* FIXME: 2.0, handle BUFFER_TIME and LATENCY in nanoseconds */
   g_object_class_install_property (gobject_class, PROP_BUFFER_TIME,
@@ -193,6 +205,27 @@ gst_audio_base_src_class_init (GstAudioBaseSrcClass * klass)
           GST_TYPE_AUDIO_BASE_SRC_SLAVE_METHOD, DEFAULT_SLAVE_METHOD,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioBaseSrc:timestamp-anchor-interval:
+   *
+   * Query the device position at most once per this interval and
+   * interpolate clock reads in between from the sample counter and the
+   * cached device delay. This avoids one delay query per clock read,
+   * which on some APIs is a syscall per call, at the cost of up to one
+   * device period of timestamp jitter plus whatever the delay drifts
+   * within the interval. 0 queries the device on every read.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_TIMESTAMP_ANCHOR_INTERVAL,
+      g_param_spec_uint64 ("timestamp-anchor-interval",
+          "Timestamp anchor interval",
+          "Interval between device position queries for timestamping "
+          "(in nanoseconds, 0 = every read)",
+          0, G_MAXUINT64, DEFAULT_TIMESTAMP_ANCHOR_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_audio_base_src_change_state);
   gstelement_class->provide_clock =
@@ -226,6 +259,8 @@ gst_audio_base_src_init (GstAudioBaseSrc * audiobasesrc)
   else
     GST_OBJECT_FLAG_UNSET (audiobasesrc, GST_ELEMENT_FLAG_PROVIDE_CLOCK);
   audiobasesrc->priv->slave_method = DEFAULT_SLAVE_METHOD;
+  audiobasesrc->priv->anchor_interval = DEFAULT_TIMESTAMP_ANCHOR_INTERVAL;
+  g_mutex_init (&audiobasesrc->priv->anchor_lock);
   /* reset blocksize we use latency time to calculate a more useful
    * value based on negotiated format. */
   GST_BASE_SRC (audiobasesrc)->blocksize = 0;
@@ -264,6 +299,16 @@ gst_audio_base_src_dispose (GObject * object)
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
 
+static void
+gst_audio_base_src_finalize (GObject * object)
+{
+  GstAudioBaseSrc *src = GST_AUDIO_BASE_SRC (object);
+
+  g_mutex_clear (&src->priv->anchor_lock);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 static GstClock *
 gst_audio_base_src_provide_clock (GstElement * elem)
 {
@@ -316,9 +361,28 @@ gst_audio_base_src_get_time (GstClock * clock, GstAudioBaseSrc * src)
 
   raw = samples = gst_audio_ring_buffer_samples_done (src->ringbuffer);
 
-  /* the number of samples not yet processed, this is still queued in the
-   * device (not yet read for capture). */
-  delay = gst_audio_ring_buffer_delay (src->ringbuffer);
+  if (src->priv->anchor_interval > 0) {
+    gint64 now = g_get_monotonic_time ();
+
+    /* only query the device delay when the anchor expired, in between
+     * the sample counter read above moves the time forward and the
+     * cached delay bounds the error to its drift within the interval */
+    g_mutex_lock (&src->priv->anchor_lock);
+    if (src->priv->anchor_monotonic != 0 &&
+        now - src->priv->anchor_monotonic <
+        (gint64) (src->priv->anchor_interval / 1000)) {
+      delay = src->priv->anchor_delay;
+    } else {
+      delay = gst_audio_ring_buffer_delay (src->ringbuffer);
+      src->priv->anchor_monotonic = now;
+      src->priv->anchor_delay = delay;
+    }
+    g_mutex_unlock (&src->priv->anchor_lock);
+  } else {
+    /* the number of samples not yet processed, this is still queued in the
+     * device (not yet read for capture). */
+    delay = gst_audio_ring_buffer_delay (src->ringbuffer);
+  }
 
   samples += delay;
 
@@ -439,6 +503,15 @@ gst_audio_base_src_set_property (GObject * object, guint prop_id,
     case PROP_SLAVE_METHOD:
       gst_audio_base_src_set_slave_method (src, g_value_get_enum (value));
       break;
+    case PROP_TIMESTAMP_ANCHOR_INTERVAL:
+      GST_OBJECT_LOCK (src);
+      src->priv->anchor_interval = g_value_get_uint64 (value);
+      GST_OBJECT_UNLOCK (src);
+      /* force a fresh anchor on the next clock read */
+      g_mutex_lock (&src->priv->anchor_lock);
+      src->priv->anchor_monotonic = 0;
+      g_mutex_unlock (&src->priv->anchor_lock);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -482,6 +555,11 @@ gst_audio_base_src_get_property (GObject * object, guint prop_id,
     case PROP_SLAVE_METHOD:
       g_value_set_enum (value, gst_audio_base_src_get_slave_method (src));
       break;
+    case PROP_TIMESTAMP_ANCHOR_INTERVAL:
+      GST_OBJECT_LOCK (src);
+      g_value_set_uint64 (value, src->priv->anchor_interval);
+      GST_OBJECT_UNLOCK (src);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -835,6 +913,18 @@ gst_audio_base_src_create (GstBaseSrc * bsrc, guint64 offset, guint length,
   } while (TRUE);
   gst_buffer_unmap (buf, &info);
 
+  /* refresh the wait-free snapshot of our provided clock with the device
+   * position we just read against; if no read follows within two segments,
+   * clock readers fall back to querying the device */
+  if (src->clock && GST_IS_AUDIO_CLOCK (src->clock) &&
+      GST_AUDIO_CLOCK_CAST (src->clock)->func ==
+      (GstAudioClockGetTimeFunc) gst_audio_base_src_get_time) {
+    gst_audio_clock_publish (GST_AUDIO_CLOCK (src->clock),
+        gst_audio_base_src_get_time (GST_CLOCK_CAST (src->clock), src), 1.0,
+        gst_util_uint64_scale_int (2 * (guint64) ringbuffer->samples_per_seg,
+            GST_SECOND, ringbuffer->spec.info.rate));
+  }
+
   /* mark discontinuity if needed */
   if (G_UNLIKELY (sample != src->next_sample) && src->next_sample != -1) {
     GST_WARNING_OBJECT (src,
@@ -1153,6 +1243,14 @@ gst_audio_base_src_change_state (GstElement * element,
       GST_DEBUG_OBJECT (src, "PLAYING->PAUSED");
       gst_audio_ring_buffer_may_start (src->ringbuffer, FALSE);
       gst_audio_ring_buffer_pause (src->ringbuffer);
+
+      /* the device position stops advancing while paused, invalidate the
+       * published snapshot so clock reads don't keep interpolating */
+      if (src->clock && GST_IS_AUDIO_CLOCK (src->clock) &&
+          GST_AUDIO_CLOCK_CAST (src->clock)->func ==
+          (GstAudioClockGetTimeFunc) gst_audio_base_src_get_time)
+        gst_audio_clock_publish (GST_AUDIO_CLOCK (src->clock),
+            GST_CLOCK_TIME_NONE, 1.0, 0);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       GST_DEBUG_OBJECT (src, "PAUSED->READY");
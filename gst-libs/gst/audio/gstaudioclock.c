@@ -41,6 +41,23 @@
 GST_DEBUG_CATEGORY_STATIC (gst_audio_clock_debug);
 #define GST_CAT_DEFAULT gst_audio_clock_debug
 
+/* an atomically published (time, monotonic-anchor, rate) snapshot so that
+ * gst_audio_clock_get_time() can be answered by interpolation without
+ * calling into the time function. Writers bump seq to an odd value, update
+ * the fields and bump it again; readers retry when they see an odd or
+ * changed seq. */
+typedef struct
+{
+  gint seq;
+  GstClockTime time;            /* clock time at the anchor */
+  gint64 monotonic;             /* monotonic time of the anchor, in usec */
+  gdouble rate;                 /* clock units per system time unit */
+  gint64 max_age;               /* usable interpolation window, in usec */
+} GstAudioClockSnapshot;
+
+#define GST_AUDIO_CLOCK_SNAPSHOT(clock) \
+    ((GstAudioClockSnapshot *) GST_AUDIO_CLOCK_CAST (clock)->snapshot)
+
 static void gst_audio_clock_dispose (GObject * object);
 
 static GstClockTime gst_audio_clock_get_internal_time (GstClock * clock);
@@ -70,6 +87,7 @@ gst_audio_clock_init (GstAudioClock * clock)
   GST_DEBUG_OBJECT (clock, "init");
   clock->last_time = 0;
   clock->time_offset = 0;
+  clock->snapshot = g_new0 (GstAudioClockSnapshot, 1);
   GST_OBJECT_FLAG_SET (clock, GST_CLOCK_FLAG_CAN_SET_MASTER);
 }
 
@@ -83,6 +101,9 @@ gst_audio_clock_dispose (GObject * object)
   clock->destroy_notify = NULL;
   clock->user_data = NULL;
 
+  g_free (clock->snapshot);
+  clock->snapshot = NULL;
+
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
 
@@ -150,6 +171,79 @@ gst_audio_clock_func_invalid (GstClock * clock, gpointer user_data)
   return GST_CLOCK_TIME_NONE;
 }
 
+/* wait-free interpolated read of the published snapshot, returns
+ * GST_CLOCK_TIME_NONE when no usable snapshot is published */
+static GstClockTime
+gst_audio_clock_read_snapshot (GstAudioClock * clock)
+{
+  GstAudioClockSnapshot *snapshot = GST_AUDIO_CLOCK_SNAPSHOT (clock);
+  GstClockTime time;
+  gint64 monotonic, max_age, age;
+  gdouble rate;
+  gint seq;
+
+  if (snapshot == NULL)
+    return GST_CLOCK_TIME_NONE;
+
+  do {
+    seq = g_atomic_int_get (&snapshot->seq);
+    if (seq & 1)
+      continue;
+    time = snapshot->time;
+    monotonic = snapshot->monotonic;
+    rate = snapshot->rate;
+    max_age = snapshot->max_age;
+  } while (g_atomic_int_get (&snapshot->seq) != seq);
+
+  if (max_age == 0 || !GST_CLOCK_TIME_IS_VALID (time))
+    return GST_CLOCK_TIME_NONE;
+
+  age = g_get_monotonic_time () - monotonic;
+  if (age < 0 || age > max_age)
+    return GST_CLOCK_TIME_NONE;
+
+  return time + (GstClockTime) (age * rate * 1000.0);
+}
+
+/**
+ * gst_audio_clock_publish:
+ * @clock: a #GstAudioClock
+ * @time: the current time of the time function, or #GST_CLOCK_TIME_NONE
+ *   to invalidate the snapshot
+ * @rate: the rate of the clock relative to the system monotonic clock,
+ *   usually 1.0
+ * @max_age: how long the snapshot may be interpolated before readers fall
+ *   back to the time function
+ *
+ * Publish a snapshot of the current clock time. While a snapshot is no
+ * older than @max_age, gst_audio_clock_get_time() answers by
+ * interpolating from it against the system monotonic clock instead of
+ * calling the #GstAudioClockGetTimeFunc, which makes time reads wait-free
+ * and keeps concurrent readers out of the audio object. Providers that
+ * process audio in segments would typically publish from their segment
+ * processing callback with a @max_age of a couple of segment durations.
+ *
+ * Since: 1.14
+ */
+void
+gst_audio_clock_publish (GstAudioClock * clock, GstClockTime time,
+    gdouble rate, GstClockTime max_age)
+{
+  GstAudioClockSnapshot *snapshot;
+
+  g_return_if_fail (GST_IS_AUDIO_CLOCK (clock));
+
+  snapshot = GST_AUDIO_CLOCK_SNAPSHOT (clock);
+
+  g_atomic_int_inc (&snapshot->seq);
+  snapshot->time = time;
+  snapshot->monotonic = g_get_monotonic_time ();
+  snapshot->rate = rate;
+  snapshot->max_age = GST_CLOCK_TIME_IS_VALID (max_age) ?
+      (gint64) (max_age / 1000) : 0;
+  g_atomic_int_inc (&snapshot->seq);
+}
+
 static GstClockTime
 gst_audio_clock_get_internal_time (GstClock * clock)
 {
@@ -158,7 +252,9 @@ gst_audio_clock_get_internal_time (GstClock * clock)
 
   aclock = GST_AUDIO_CLOCK_CAST (clock);
 
-  result = aclock->func (clock, aclock->user_data);
+  result = gst_audio_clock_read_snapshot (aclock);
+  if (result == GST_CLOCK_TIME_NONE)
+    result = aclock->func (clock, aclock->user_data);
   if (result == GST_CLOCK_TIME_NONE) {
     result = aclock->last_time;
   } else {
@@ -191,6 +287,10 @@ gst_audio_clock_get_time (GstAudioClock * clock)
 {
   GstClockTime result;
 
+  result = gst_audio_clock_read_snapshot (clock);
+  if (result != GST_CLOCK_TIME_NONE)
+    return result;
+
   result = clock->func (GST_CLOCK_CAST (clock), clock->user_data);
   if (result == GST_CLOCK_TIME_NONE) {
     GST_DEBUG_OBJECT (clock, "no time, reuse last");
@@ -237,5 +337,6 @@ gst_audio_clock_adjust (GstAudioClock * clock, GstClockTime time)
 void
 gst_audio_clock_invalidate (GstAudioClock * clock)
 {
+  gst_audio_clock_publish (clock, GST_CLOCK_TIME_NONE, 1.0, 0);
   clock->func = gst_audio_clock_func_invalid;
 }
@@ -79,7 +79,9 @@ struct _GstAudioClock {
   GstClockTime             last_time;
   GstClockTimeDiff         time_offset;
 
-  gpointer _gst_reserved[GST_PADDING];
+  gpointer                 snapshot;
+
+  gpointer _gst_reserved[GST_PADDING - 1];
 };
 
 struct _GstAudioClockClass {
@@ -108,6 +110,10 @@ GstClockTime    gst_audio_clock_adjust          (GstAudioClock * clock, GstClock
 GST_EXPORT
 void            gst_audio_clock_invalidate      (GstAudioClock * clock);
 
+GST_EXPORT
+void            gst_audio_clock_publish         (GstAudioClock * clock, GstClockTime time,
+                                                 gdouble rate, GstClockTime max_age);
+
 #ifdef G_DEFINE_AUTOPTR_CLEANUP_FUNC
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstAudioClock, gst_object_unref)
 #endif
@@ -182,6 +182,11 @@ typedef struct _GstAudioDecoderContext
 
   GstAllocator *allocator;
   GstAllocationParams params;
+
+  /* output buffer pool so that steady-state decoding recycles buffers
+   * instead of hitting the allocator for every frame */
+  GstBufferPool *pool;
+  gsize pool_size;
 } GstAudioDecoderContext;
 
 struct _GstAudioDecoderPrivate
@@ -501,6 +506,11 @@ gst_audio_decoder_reset (GstAudioDecoder * dec, gboolean full)
     if (dec->priv->ctx.allocator)
       gst_object_unref (dec->priv->ctx.allocator);
 
+    if (dec->priv->ctx.pool) {
+      gst_buffer_pool_set_active (dec->priv->ctx.pool, FALSE);
+      gst_object_unref (dec->priv->ctx.pool);
+    }
+
     GST_OBJECT_LOCK (dec);
     gst_caps_replace (&dec->priv->ctx.input_caps, NULL);
     gst_caps_replace (&dec->priv->ctx.allocation_caps, NULL);
@@ -683,6 +693,15 @@ gst_audio_decoder_negotiate_default (GstAudioDecoder * dec)
   dec->priv->ctx.allocator = allocator;
   dec->priv->ctx.params = params;
 
+  /* drop the output pool, it will be rebuilt with the new allocator on the
+   * next allocation */
+  if (dec->priv->ctx.pool) {
+    gst_buffer_pool_set_active (dec->priv->ctx.pool, FALSE);
+    gst_object_unref (dec->priv->ctx.pool);
+    dec->priv->ctx.pool = NULL;
+    dec->priv->ctx.pool_size = 0;
+  }
+
 done:
 
   if (query)
@@ -3504,13 +3523,60 @@ gst_audio_decoder_merge_tags (GstAudioDecoder * dec,
   GST_AUDIO_DECODER_STREAM_UNLOCK (dec);
 }
 
+static GstBuffer *
+gst_audio_decoder_acquire_output_buffer (GstAudioDecoder * dec, gsize size)
+{
+  GstAudioDecoderContext *ctx = &dec->priv->ctx;
+  GstBuffer *buffer = NULL;
+
+  if (G_UNLIKELY (ctx->pool == NULL || size > ctx->pool_size)) {
+    GstBufferPool *pool;
+    GstStructure *config;
+    gsize pool_size;
+
+    /* round up to the next power of two so that slightly varying frame
+     * sizes all recycle the same buffers */
+    pool_size = MAX (size, 1024);
+    pool_size = 1 << g_bit_storage (pool_size - 1);
+
+    pool = gst_buffer_pool_new ();
+    config = gst_buffer_pool_get_config (pool);
+    gst_buffer_pool_config_set_params (config, NULL, pool_size, 0, 0);
+    gst_buffer_pool_config_set_allocator (config, ctx->allocator,
+        &ctx->params);
+    if (!gst_buffer_pool_set_config (pool, config) ||
+        !gst_buffer_pool_set_active (pool, TRUE)) {
+      gst_object_unref (pool);
+      return NULL;
+    }
+
+    if (ctx->pool) {
+      gst_buffer_pool_set_active (ctx->pool, FALSE);
+      gst_object_unref (ctx->pool);
+    }
+    ctx->pool = pool;
+    ctx->pool_size = pool_size;
+
+    GST_DEBUG_OBJECT (dec, "new output pool, bucket size %" G_GSIZE_FORMAT,
+        pool_size);
+  }
+
+  if (gst_buffer_pool_acquire_buffer (ctx->pool, &buffer, NULL) != GST_FLOW_OK)
+    return NULL;
+
+  gst_buffer_resize (buffer, 0, size);
+
+  return buffer;
+}
+
 /**
  * gst_audio_decoder_allocate_output_buffer:
  * @dec: a #GstAudioDecoder
  * @size: size of the buffer
  *
  * Helper function that allocates a buffer to hold an audio frame
- * for @dec's current output format.
+ * for @dec's current output format. The buffer comes from an internal
+ * buffer pool and is returned to it when unreffed.
  *
  * Returns: (transfer full): allocated buffer
  */
@@ -3537,9 +3603,7 @@ gst_audio_decoder_allocate_output_buffer (GstAudioDecoder * dec, gsize size)
     }
   }
 
-  buffer =
-      gst_buffer_new_allocate (dec->priv->ctx.allocator, size,
-      &dec->priv->ctx.params);
+  buffer = gst_audio_decoder_acquire_output_buffer (dec, size);
   if (!buffer) {
     GST_INFO_OBJECT (dec, "couldn't allocate output buffer");
     goto fallback;
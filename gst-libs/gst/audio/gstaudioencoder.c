@@ -2225,6 +2225,42 @@ gst_audio_encoder_get_frame_max (GstAudioEncoder * enc)
   return enc->priv->ctx.frame_max;
 }
 
+/**
+ * gst_audio_encoder_get_frame_samples_batch:
+ * @enc: a #GstAudioEncoder
+ *
+ * Returns the maximum number of samples that will be handed to
+ * GstAudioEncoder::handle_frame in one call with the current frame
+ * configuration, that is @frame_samples_max frames of samples times the
+ * number of frames accepted at once. Subclasses that set @frame_max
+ * larger than 1 can use this to size their internal batch buffers.
+ *
+ * Returns: the maximum number of samples per handle_frame call,
+ * 0 for unlimited or unknown
+ *
+ * Since: 1.14
+ */
+gint
+gst_audio_encoder_get_frame_samples_batch (GstAudioEncoder * enc)
+{
+  GstAudioEncoderContext *ctx;
+
+  g_return_val_if_fail (GST_IS_AUDIO_ENCODER (enc), 0);
+
+  ctx = &enc->priv->ctx;
+
+  /* batching only happens for fixed frame sizes */
+  if (ctx->frame_samples_min <= 0 ||
+      ctx->frame_samples_min != ctx->frame_samples_max)
+    return MAX (ctx->frame_samples_max, 0);
+
+  /* frame_max == 0 means as many frames as available */
+  if (ctx->frame_max == 0)
+    return 0;
+
+  return ctx->frame_samples_max * MAX (ctx->frame_max, 1);
+}
+
 /**
  * gst_audio_encoder_set_lookahead:
  * @enc: a #GstAudioEncoder
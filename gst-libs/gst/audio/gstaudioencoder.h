@@ -291,6 +291,9 @@ void            gst_audio_encoder_set_frame_samples_max (GstAudioEncoder * enc,
 GST_EXPORT
 gint            gst_audio_encoder_get_frame_max (GstAudioEncoder * enc);
 
+GST_EXPORT
+gint            gst_audio_encoder_get_frame_samples_batch (GstAudioEncoder * enc);
+
 GST_EXPORT
 void            gst_audio_encoder_set_frame_max (GstAudioEncoder * enc, gint num);
 
@@ -139,28 +139,13 @@ gst_audio_iec61937_frame_size (const GstAudioRingBufferSpec * spec)
   }
 }
 
-/**
- * gst_audio_iec61937_payload:
- * @src: (array length=src_n): a buffer containing the data to payload
- * @src_n: size of @src in bytes
- * @dst: (array length=dst_n): the destination buffer to store the
- *       payloaded contents in. Should not overlap with @src
- * @dst_n: size of @dst in bytes
- * @spec: the ringbufer spec for @src
- * @endianness: the expected byte order of the payloaded data
- *
- * Payloads @src in the form specified by IEC 61937 for the type from @spec and
- * stores the result in @dst. @src must contain exactly one frame of data and
- * the frame is not checked for errors.
- *
- * Returns: transfer-full: %TRUE if the payloading was successful, %FALSE
- * otherwise.
- */
-gboolean
-gst_audio_iec61937_payload (const guint8 * src, guint src_n, guint8 * dst,
-    guint dst_n, const GstAudioRingBufferSpec * spec, gint endianness)
+/* writes the IEC 61937 burst preamble (Pa, Pb, Pc, Pd) for one frame of
+ * data into the %IEC61937_HEADER_SIZE bytes at @dst */
+static gboolean
+gst_audio_iec61937_fill_header (const guint8 * src, guint src_n, guint8 * dst,
+    const GstAudioRingBufferSpec * spec)
 {
-  guint i, tmp;
+  guint tmp;
 #if G_BYTE_ORDER == G_BIG_ENDIAN
   guint8 zero = 0, one = 1, two = 2, three = 3, four = 4, five = 5, six = 6,
       seven = 7;
@@ -170,14 +155,6 @@ gst_audio_iec61937_payload (const guint8 * src, guint src_n, guint8 * dst,
       seven = 6;
 #endif
 
-  g_return_val_if_fail (src != NULL, FALSE);
-  g_return_val_if_fail (dst != NULL, FALSE);
-  g_return_val_if_fail (src != dst, FALSE);
-  g_return_val_if_fail (dst_n >= gst_audio_iec61937_frame_size (spec), FALSE);
-
-  if (dst_n < src_n + IEC61937_HEADER_SIZE)
-    return FALSE;
-
   /* Pa, Pb */
   dst[zero] = 0xF8;
   dst[one] = 0x72;
@@ -338,6 +315,43 @@ gst_audio_iec61937_payload (const guint8 * src, guint src_n, guint8 * dst,
       return FALSE;
   }
 
+  return TRUE;
+}
+
+/**
+ * gst_audio_iec61937_payload:
+ * @src: (array length=src_n): a buffer containing the data to payload
+ * @src_n: size of @src in bytes
+ * @dst: (array length=dst_n): the destination buffer to store the
+ *       payloaded contents in. Should not overlap with @src
+ * @dst_n: size of @dst in bytes
+ * @spec: the ringbufer spec for @src
+ * @endianness: the expected byte order of the payloaded data
+ *
+ * Payloads @src in the form specified by IEC 61937 for the type from @spec and
+ * stores the result in @dst. @src must contain exactly one frame of data and
+ * the frame is not checked for errors.
+ *
+ * Returns: transfer-full: %TRUE if the payloading was successful, %FALSE
+ * otherwise.
+ */
+gboolean
+gst_audio_iec61937_payload (const guint8 * src, guint src_n, guint8 * dst,
+    guint dst_n, const GstAudioRingBufferSpec * spec, gint endianness)
+{
+  guint i, tmp;
+
+  g_return_val_if_fail (src != NULL, FALSE);
+  g_return_val_if_fail (dst != NULL, FALSE);
+  g_return_val_if_fail (src != dst, FALSE);
+  g_return_val_if_fail (dst_n >= gst_audio_iec61937_frame_size (spec), FALSE);
+
+  if (dst_n < src_n + IEC61937_HEADER_SIZE)
+    return FALSE;
+
+  if (!gst_audio_iec61937_fill_header (src, src_n, dst, spec))
+    return FALSE;
+
   /* Copy the payload */
   i = 8;
 
@@ -365,3 +379,148 @@ gst_audio_iec61937_payload (const guint8 * src, guint src_n, guint8 * dst,
 
   return TRUE;
 }
+
+/**
+ * gst_audio_iec61937_payload_buffer:
+ * @src: (transfer full): a buffer containing exactly one frame of data to
+ *       payload
+ * @spec: the ringbuffer spec for @src
+ * @endianness: the expected byte order of the payloaded data
+ *
+ * Payloads @src in the form specified by IEC 61937 for the type from @spec.
+ * Unlike gst_audio_iec61937_payload(), the frame data is not copied into a
+ * freshly allocated frame: the returned buffer shares the memory of @src,
+ * with a newly allocated burst preamble prepended and zero padding up to
+ * the IEC 61937 frame size appended. If the data needs to be byte-swapped
+ * for @endianness, the swap is done in place when @src is writable and
+ * into a new memory block otherwise.
+ *
+ * Buffer metadata such as timestamps is copied from @src.
+ *
+ * Returns: (transfer full) (nullable): the payloaded frame, or %NULL if
+ * @src cannot be payloaded for @spec.
+ *
+ * Since: 1.14
+ */
+GstBuffer *
+gst_audio_iec61937_payload_buffer (GstBuffer * src,
+    const GstAudioRingBufferSpec * spec, gint endianness)
+{
+  guint frame_size, pad, tmp;
+  gsize src_n;
+  gboolean swap, inplace;
+  guint8 last = 0;
+  GstMapInfo map, omap;
+  GstMemory *mem;
+  GstBuffer *out;
+
+  g_return_val_if_fail (GST_IS_BUFFER (src), NULL);
+  g_return_val_if_fail (spec != NULL, NULL);
+
+  frame_size = gst_audio_iec61937_frame_size (spec);
+  src_n = gst_buffer_get_size (src);
+
+  if (frame_size == 0 || frame_size < src_n + IEC61937_HEADER_SIZE)
+    goto wrong_size;
+
+  pad = frame_size - IEC61937_HEADER_SIZE - src_n;
+  swap = (G_BYTE_ORDER != endianness);
+  /* an odd frame grows by one byte when swapped, which has to land in the
+   * padding */
+  if (swap && (src_n % 2) && pad == 0)
+    goto wrong_size;
+
+  inplace = swap && gst_buffer_is_writable (src);
+
+  if (!gst_buffer_map (src, &map, inplace ? GST_MAP_READWRITE : GST_MAP_READ))
+    goto map_failed;
+
+  out = gst_buffer_new ();
+  gst_buffer_copy_into (out, src, GST_BUFFER_COPY_METADATA, 0, -1);
+
+  /* the burst preamble peeks at the frame, write it before a byte swap
+   * scrambles the data */
+  mem = gst_allocator_alloc (NULL, IEC61937_HEADER_SIZE, NULL);
+  gst_memory_map (mem, &omap, GST_MAP_WRITE);
+  if (!gst_audio_iec61937_fill_header (map.data, src_n, omap.data, spec)) {
+    gst_memory_unmap (mem, &omap);
+    gst_memory_unref (mem);
+    gst_buffer_unmap (src, &map);
+    gst_buffer_unref (out);
+    goto payload_failed;
+  }
+  gst_memory_unmap (mem, &omap);
+  gst_buffer_append_memory (out, mem);
+
+  if (!swap) {
+    /* share the frame data as-is */
+    gst_buffer_unmap (src, &map);
+    gst_buffer_copy_into (out, src, GST_BUFFER_COPY_MEMORY, 0, -1);
+  } else if (inplace) {
+    guint8 *data = map.data;
+
+    for (tmp = 1; tmp < src_n; tmp += 2) {
+      guint8 t = data[tmp - 1];
+
+      data[tmp - 1] = data[tmp];
+      data[tmp] = t;
+    }
+    if (src_n % 2) {
+      /* the last byte pairs with the first byte of the padding */
+      last = data[src_n - 1];
+      data[src_n - 1] = 0;
+    }
+    gst_buffer_unmap (src, &map);
+    gst_buffer_copy_into (out, src, GST_BUFFER_COPY_MEMORY, 0, -1);
+  } else {
+    /* we may not modify the data, swap into a new memory block */
+    mem = gst_allocator_alloc (NULL, src_n, NULL);
+    gst_memory_map (mem, &omap, GST_MAP_WRITE);
+    for (tmp = 1; tmp < src_n; tmp += 2) {
+      omap.data[tmp - 1] = map.data[tmp];
+      omap.data[tmp] = map.data[tmp - 1];
+    }
+    if (src_n % 2) {
+      last = map.data[src_n - 1];
+      omap.data[src_n - 1] = 0;
+    }
+    gst_memory_unmap (mem, &omap);
+    gst_buffer_unmap (src, &map);
+    gst_buffer_append_memory (out, mem);
+  }
+
+  if (pad > 0) {
+    mem = gst_allocator_alloc (NULL, pad, NULL);
+    gst_memory_map (mem, &omap, GST_MAP_WRITE);
+    memset (omap.data, 0, pad);
+    /* zero unless an odd frame was byte-swapped */
+    omap.data[0] = last;
+    gst_memory_unmap (mem, &omap);
+    gst_buffer_append_memory (out, mem);
+  }
+
+  gst_buffer_unref (src);
+
+  return out;
+
+  /* ERRORS */
+wrong_size:
+  {
+    GST_WARNING ("frame of %" G_GSIZE_FORMAT " bytes does not fit an IEC "
+        "61937 frame of %u bytes", src_n, frame_size);
+    gst_buffer_unref (src);
+    return NULL;
+  }
+map_failed:
+  {
+    GST_WARNING ("failed to map frame data");
+    gst_buffer_unref (src);
+    return NULL;
+  }
+payload_failed:
+  {
+    GST_WARNING ("could not payload frame");
+    gst_buffer_unref (src);
+    return NULL;
+  }
+}
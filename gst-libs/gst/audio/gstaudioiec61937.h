@@ -33,4 +33,9 @@ gboolean    gst_audio_iec61937_payload     (const guint8 * src, guint src_n,
                                             const GstAudioRingBufferSpec * spec,
                                             gint endianness);
 
+GST_EXPORT
+GstBuffer * gst_audio_iec61937_payload_buffer (GstBuffer * src,
+                                            const GstAudioRingBufferSpec * spec,
+                                            gint endianness);
+
 #endif /* __GST_AUDIO_IEC61937_H__ */
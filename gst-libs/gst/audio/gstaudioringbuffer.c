@@ -45,6 +45,39 @@ GST_DEBUG_CATEGORY_STATIC (gst_audio_ring_buffer_debug);
 static void gst_audio_ring_buffer_dispose (GObject * object);
 static void gst_audio_ring_buffer_finalize (GObject * object);
 
+/* number of log2 buckets in the statistics histograms */
+#define STATS_N_BUCKETS 16
+
+/* underrun and delay statistics, attached to the stats pointer of the
+ * ringbuffer. All counters are updated with atomic operations from the
+ * streaming and device threads and only read when an application asks
+ * for them, so they are cheap enough to always keep enabled. */
+typedef struct
+{
+  gint underruns;               /* segments dropped because the writer was too late */
+  gint commit_waits;            /* commits that blocked on a full ringbuffer */
+  gint delay_hist[STATS_N_BUCKETS];     /* commit-to-play distance in log2 segments */
+  gint jitter_hist[STATS_N_BUCKETS];    /* advance interval jitter in log2 ms */
+  gint64 last_advance_time;     /* monotonic time of the last advance, only
+                                 * touched by the device thread */
+} GstAudioRingBufferStats;
+
+#define GST_AUDIO_RING_BUFFER_STATS(buf) ((GstAudioRingBufferStats *) (buf)->stats)
+
+/* log2 bucket: 0 holds value 0, bucket i holds [2^(i-1), 2^i), the last
+ * bucket collects everything larger */
+static inline guint
+stats_bucket (guint64 value)
+{
+  guint bucket = 0;
+
+  while (value > 0 && bucket < STATS_N_BUCKETS - 1) {
+    bucket++;
+    value >>= 1;
+  }
+  return bucket;
+}
+
 static gboolean gst_audio_ring_buffer_pause_unlocked (GstAudioRingBuffer * buf);
 static void default_clear_all (GstAudioRingBuffer * buf);
 static guint default_commit (GstAudioRingBuffer * buf, guint64 * sample,
@@ -85,6 +118,7 @@ gst_audio_ring_buffer_init (GstAudioRingBuffer * ringbuffer)
   ringbuffer->flushing = TRUE;
   ringbuffer->segbase = 0;
   ringbuffer->segdone = 0;
+  ringbuffer->stats = g_new0 (GstAudioRingBufferStats, 1);
 }
 
 static void
@@ -105,6 +139,7 @@ gst_audio_ring_buffer_finalize (GObject * object)
 
   g_cond_clear (&ringbuffer->cond);
   g_free (ringbuffer->empty_seg);
+  g_free (ringbuffer->stats);
 
   if (ringbuffer->cb_data_notify != NULL)
     ringbuffer->cb_data_notify (ringbuffer->cb_data);
@@ -972,6 +1007,9 @@ gst_audio_ring_buffer_start (GstAudioRingBuffer * buf)
   if (G_UNLIKELY (!g_atomic_int_get (&buf->may_start)))
     goto may_not_start;
 
+  /* the gap while we were not running must not count as jitter */
+  GST_AUDIO_RING_BUFFER_STATS (buf)->last_advance_time = 0;
+
   /* if stopped, set to started */
   res = g_atomic_int_compare_and_exchange (&buf->state,
       GST_AUDIO_RING_BUFFER_STATE_STOPPED, GST_AUDIO_RING_BUFFER_STATE_STARTED);
@@ -1326,12 +1364,12 @@ gst_audio_ring_buffer_clear_all (GstAudioRingBuffer * buf)
 }
 
 
+/* wait for the device to process a segment. @segdone is the last segdone
+ * value observed by the caller, we only go to sleep as long as it didn't
+ * change. */
 static gboolean
-wait_segment (GstAudioRingBuffer * buf)
+wait_segment (GstAudioRingBuffer * buf, gint segdone)
 {
-  gint segments;
-  gboolean wait = TRUE;
-
   /* buffer must be started now or we deadlock since nobody is reading */
   if (G_UNLIKELY (g_atomic_int_get (&buf->state) !=
           GST_AUDIO_RING_BUFFER_STATE_STARTED)) {
@@ -1340,13 +1378,20 @@ wait_segment (GstAudioRingBuffer * buf)
       goto no_start;
 
     GST_DEBUG_OBJECT (buf, "start!");
-    segments = g_atomic_int_get (&buf->segdone);
     gst_audio_ring_buffer_start (buf);
+  }
 
-    /* After starting, the writer may have wrote segments already and then we
-     * don't need to wait anymore */
-    if (G_LIKELY (g_atomic_int_get (&buf->segdone) != segments))
-      wait = FALSE;
+  /* fast path: the device advanced in the meantime and there is no need to
+   * go to sleep, keep the lock and the cond out of the hot loop */
+  if (G_LIKELY (g_atomic_int_get (&buf->segdone) != segdone)) {
+    if (G_UNLIKELY (buf->flushing))
+      goto flushing_fast;
+
+    if (G_UNLIKELY (g_atomic_int_get (&buf->state) !=
+            GST_AUDIO_RING_BUFFER_STATE_STARTED))
+      goto not_started_fast;
+
+    return TRUE;
   }
 
   /* take lock first, then update our waiting flag */
@@ -1358,8 +1403,10 @@ wait_segment (GstAudioRingBuffer * buf)
           GST_AUDIO_RING_BUFFER_STATE_STARTED))
     goto not_started;
 
-  if (G_LIKELY (wait)) {
-    if (g_atomic_int_compare_and_exchange (&buf->waiting, 0, 1)) {
+  if (g_atomic_int_compare_and_exchange (&buf->waiting, 0, 1)) {
+    /* recheck after the waiting flag is visible to advance(), we would
+     * otherwise sleep a whole period for a wakeup that already happened */
+    if (G_LIKELY (g_atomic_int_get (&buf->segdone) == segdone)) {
       GST_DEBUG_OBJECT (buf, "waiting..");
       GST_AUDIO_RING_BUFFER_WAIT (buf);
 
@@ -1369,6 +1416,8 @@ wait_segment (GstAudioRingBuffer * buf)
       if (G_UNLIKELY (g_atomic_int_get (&buf->state) !=
               GST_AUDIO_RING_BUFFER_STATE_STARTED))
         goto not_started;
+    } else {
+      g_atomic_int_compare_and_exchange (&buf->waiting, 1, 0);
     }
   }
   GST_OBJECT_UNLOCK (buf);
@@ -1390,6 +1439,16 @@ flushing:
     GST_OBJECT_UNLOCK (buf);
     return FALSE;
   }
+not_started_fast:
+  {
+    GST_DEBUG_OBJECT (buf, "stopped processing");
+    return FALSE;
+  }
+flushing_fast:
+  {
+    GST_DEBUG_OBJECT (buf, "flushing");
+    return FALSE;
+  }
 no_start:
   {
     GST_DEBUG_OBJECT (buf, "not allowed to start");
@@ -1576,6 +1635,7 @@ default_commit (GstAudioRingBuffer * buf, guint64 * sample,
       /* segment too far ahead, writer too slow, we need to drop, hopefully UNLIKELY */
       if (G_UNLIKELY (diff < 0)) {
         /* we need to drop one segment at a time, pretend we wrote a segment. */
+        g_atomic_int_inc (&GST_AUDIO_RING_BUFFER_STATS (buf)->underruns);
         skip = TRUE;
         break;
       }
@@ -1583,12 +1643,15 @@ default_commit (GstAudioRingBuffer * buf, guint64 * sample,
       /* write segment is within writable range, we can break the loop and
        * start writing the data. */
       if (diff < segtotal) {
+        g_atomic_int_inc (&GST_AUDIO_RING_BUFFER_STATS
+            (buf)->delay_hist[stats_bucket (diff)]);
         skip = FALSE;
         break;
       }
 
       /* else we need to wait for the segment to become writable. */
-      if (!wait_segment (buf))
+      g_atomic_int_inc (&GST_AUDIO_RING_BUFFER_STATS (buf)->commit_waits);
+      if (!wait_segment (buf, segdone + buf->segbase))
         goto not_started;
     }
 
@@ -1804,7 +1867,7 @@ gst_audio_ring_buffer_read (GstAudioRingBuffer * buf, guint64 sample,
         break;
 
       /* else we need to wait for the segment to become readable. */
-      if (!wait_segment (buf))
+      if (!wait_segment (buf, segdone + buf->segbase))
         goto not_started;
     }
 
@@ -1921,8 +1984,26 @@ gst_audio_ring_buffer_prepare_read (GstAudioRingBuffer * buf, gint * segment,
 void
 gst_audio_ring_buffer_advance (GstAudioRingBuffer * buf, guint advance)
 {
+  GstAudioRingBufferStats *stats;
+  gint64 now;
+
   g_return_if_fail (GST_IS_AUDIO_RING_BUFFER (buf));
 
+  /* measure how far the interval between device notifications deviates
+   * from the nominal duration of the processed segments; only the device
+   * thread advances, so last_advance_time needs no synchronization */
+  stats = GST_AUDIO_RING_BUFFER_STATS (buf);
+  now = g_get_monotonic_time ();
+  if (stats->last_advance_time != 0 && buf->spec.info.rate > 0) {
+    gint64 expected, jitter;
+
+    expected = gst_util_uint64_scale_int ((guint64) advance * G_USEC_PER_SEC,
+        buf->samples_per_seg, buf->spec.info.rate);
+    jitter = (now - stats->last_advance_time) - expected;
+    g_atomic_int_inc (&stats->jitter_hist[stats_bucket (ABS (jitter) / 1000)]);
+  }
+  stats->last_advance_time = now;
+
   /* update counter */
   g_atomic_int_add (&buf->segdone, advance);
 
@@ -1937,6 +2018,70 @@ gst_audio_ring_buffer_advance (GstAudioRingBuffer * buf, guint advance)
   }
 }
 
+/* append one histogram of @n counters as a GST_TYPE_ARRAY field */
+static void
+stats_add_histogram (GstStructure * s, const gchar * field, gint * counters,
+    guint n)
+{
+  GValue hist = G_VALUE_INIT;
+  GValue v = G_VALUE_INIT;
+  guint i;
+
+  g_value_init (&hist, GST_TYPE_ARRAY);
+  g_value_init (&v, G_TYPE_INT);
+  for (i = 0; i < n; i++) {
+    g_value_set_int (&v, g_atomic_int_get (&counters[i]));
+    gst_value_array_append_value (&hist, &v);
+  }
+  g_value_unset (&v);
+  gst_structure_take_value (s, field, &hist);
+}
+
+/**
+ * gst_audio_ring_buffer_get_stats:
+ * @buf: the #GstAudioRingBuffer
+ *
+ * Get a snapshot of the glitch and delay statistics that the ringbuffer
+ * collects while running: the number of segments that were dropped
+ * because the writer fell behind the device (underruns), the number of
+ * commits that blocked on a full ringbuffer, a histogram of the
+ * commit-to-play distance in log2 segments and a histogram of how far
+ * the interval between device notifications deviated from the nominal
+ * segment duration, in log2 milliseconds. In both histograms bucket 0
+ * counts value zero and bucket i counts values in [2^(i-1), 2^i), with
+ * the last bucket collecting everything larger.
+ *
+ * The counters keep accumulating for the lifetime of the ringbuffer.
+ *
+ * Returns: (transfer full): a new #GstStructure with the statistics
+ *
+ * Since: 1.14
+ *
+ * MT safe.
+ */
+GstStructure *
+gst_audio_ring_buffer_get_stats (GstAudioRingBuffer * buf)
+{
+  GstAudioRingBufferStats *stats;
+  GstStructure *s;
+
+  g_return_val_if_fail (GST_IS_AUDIO_RING_BUFFER (buf), NULL);
+
+  stats = GST_AUDIO_RING_BUFFER_STATS (buf);
+
+  s = gst_structure_new ("application/x-audio-ring-buffer-stats",
+      "underruns", G_TYPE_INT, g_atomic_int_get (&stats->underruns),
+      "commit-waits", G_TYPE_INT, g_atomic_int_get (&stats->commit_waits),
+      "segments-done", G_TYPE_INT, g_atomic_int_get (&buf->segdone), NULL);
+
+  stats_add_histogram (s, "commit-delay-histogram", stats->delay_hist,
+      STATS_N_BUCKETS);
+  stats_add_histogram (s, "jitter-histogram", stats->jitter_hist,
+      STATS_N_BUCKETS);
+
+  return s;
+}
+
 /**
  * gst_audio_ring_buffer_clear:
  * @buf: the #GstAudioRingBuffer to clear
@@ -214,7 +214,10 @@ struct _GstAudioRingBuffer {
   GDestroyNotify              cb_data_notify;
 
   /*< private >*/
-  gpointer _gst_reserved[GST_PADDING - 1];
+  /* underrun and delay statistics, updated with atomic operations */
+  gpointer                    stats;
+
+  gpointer _gst_reserved[GST_PADDING - 2];
 };
 
 /**
@@ -399,6 +402,9 @@ void            gst_audio_ring_buffer_clear           (GstAudioRingBuffer *buf,
 GST_EXPORT
 void            gst_audio_ring_buffer_advance         (GstAudioRingBuffer *buf, guint advance);
 
+GST_EXPORT
+GstStructure *  gst_audio_ring_buffer_get_stats       (GstAudioRingBuffer *buf);
+
 GST_EXPORT
 void            gst_audio_ring_buffer_may_start       (GstAudioRingBuffer *buf, gboolean allowed);
 
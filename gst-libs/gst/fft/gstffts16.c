@@ -69,6 +69,17 @@ struct _GstFFTS16
   gint len;
 };
 
+/* Process-wide pool of plans that were freed with gst_fft_s16_free().
+ * Computing the twiddle and factor tables is the expensive part of creating
+ * an instance, so keep a few finished plans around, keyed by their length
+ * and direction, and hand them out again from gst_fft_s16_new(). The tables
+ * are only read during a transform but each config also embeds scratch
+ * space, so a pooled plan always has exactly one owner. */
+static GQueue fft_s16_plan_pool = G_QUEUE_INIT;
+static GMutex fft_s16_plan_pool_lock;
+
+#define GST_FFT_S16_PLAN_POOL_MAX 16
+
 /**
  * gst_fft_s16_new: (skip)
  * @len: Length of the FFT in the time domain
@@ -88,10 +99,22 @@ gst_fft_s16_new (gint len, gboolean inverse)
 {
   GstFFTS16 *self;
   gsize subsize = 0, memneeded;
+  GList *l;
 
   g_return_val_if_fail (len > 0, NULL);
   g_return_val_if_fail (len % 2 == 0, NULL);
 
+  g_mutex_lock (&fft_s16_plan_pool_lock);
+  for (l = fft_s16_plan_pool.head; l; l = l->next) {
+    self = l->data;
+    if (self->len == len && !self->inverse == !inverse) {
+      g_queue_delete_link (&fft_s16_plan_pool, l);
+      g_mutex_unlock (&fft_s16_plan_pool_lock);
+      return self;
+    }
+  }
+  g_mutex_unlock (&fft_s16_plan_pool_lock);
+
   kiss_fftr_s16_alloc (len, (inverse) ? 1 : 0, NULL, &subsize);
   memneeded = ALIGN_STRUCT (sizeof (GstFFTS16)) + subsize;
 
@@ -164,12 +187,24 @@ gst_fft_s16_inverse_fft (GstFFTS16 * self, const GstFFTS16Complex * freqdata,
  * gst_fft_s16_free:
  * @self: #GstFFTS16 instance for this call
  *
- * This frees the memory allocated for @self.
+ * This frees the memory allocated for @self. The instance may be kept
+ * around internally and handed out again by a later gst_fft_s16_new()
+ * call with the same parameters.
  *
  */
 void
 gst_fft_s16_free (GstFFTS16 * self)
 {
+  if (self == NULL)
+    return;
+
+  g_mutex_lock (&fft_s16_plan_pool_lock);
+  if (fft_s16_plan_pool.length < GST_FFT_S16_PLAN_POOL_MAX) {
+    g_queue_push_head (&fft_s16_plan_pool, self);
+    self = NULL;
+  }
+  g_mutex_unlock (&fft_s16_plan_pool_lock);
+
   g_free (self);
 }
 
@@ -104,6 +104,15 @@ kf_bfly4 (kiss_fft_f32_cpx * Fout,
   } while (--k);
 }
 
+/* The radix-2 and radix-4 butterflies dominate the power-of-two transform
+ * sizes used for audio analysis; they are called through these pointers so
+ * that SIMD implementations can be plugged in at runtime, see
+ * kiss_fft_f32_check_simd() below. */
+static void (*kf_bfly2_impl) (kiss_fft_f32_cpx * Fout, const size_t fstride,
+    const kiss_fft_f32_cfg st, int m) = kf_bfly2;
+static void (*kf_bfly4_impl) (kiss_fft_f32_cpx * Fout, const size_t fstride,
+    const kiss_fft_f32_cfg st, const size_t m) = kf_bfly4;
+
 static void
 kf_bfly3 (kiss_fft_f32_cpx * Fout,
     const size_t fstride, const kiss_fft_f32_cfg st, size_t m)
@@ -282,13 +291,13 @@ kf_work (kiss_fft_f32_cpx * Fout,
 
     switch (p) {
       case 2:
-        kf_bfly2 (Fout, fstride, st, m);
+        kf_bfly2_impl (Fout, fstride, st, m);
         break;
       case 3:
         kf_bfly3 (Fout, fstride, st, m);
         break;
       case 4:
-        kf_bfly4 (Fout, fstride, st, m);
+        kf_bfly4_impl (Fout, fstride, st, m);
         break;
       case 5:
         kf_bfly5 (Fout, fstride, st, m);
@@ -322,13 +331,13 @@ kf_work (kiss_fft_f32_cpx * Fout,
   // recombine the p smaller DFTs 
   switch (p) {
     case 2:
-      kf_bfly2 (Fout, fstride, st, m);
+      kf_bfly2_impl (Fout, fstride, st, m);
       break;
     case 3:
       kf_bfly3 (Fout, fstride, st, m);
       break;
     case 4:
-      kf_bfly4 (Fout, fstride, st, m);
+      kf_bfly4_impl (Fout, fstride, st, m);
       break;
     case 5:
       kf_bfly5 (Fout, fstride, st, m);
@@ -374,6 +383,32 @@ kf_factor (int n, int *facbuf)
   } while (n > 1);
 }
 
+#if defined (__i386__) || defined (__x86_64__)
+#define CHECK_X86_SSE
+#include "kiss_fft_f32_sse.h"
+#endif
+
+/* Select SIMD butterfly implementations matching the CPU we run on. The
+ * SSE kernels live in a separate object compiled with SSE_CFLAGS, so only
+ * hook them up after asking the CPU, like the audio resampler does for
+ * its arch variants. */
+static void
+kiss_fft_f32_check_simd (void)
+{
+  static gsize simd_once = 0;
+
+  if (g_once_init_enter (&simd_once)) {
+#if defined (CHECK_X86_SSE) && defined (HAVE_XMMINTRIN_H) && HAVE_SSE && \
+    defined (__GNUC__)
+    if (__builtin_cpu_supports ("sse")) {
+      kf_bfly2_impl = kiss_fft_f32_bfly2_sse;
+      kf_bfly4_impl = kiss_fft_f32_bfly4_sse;
+    }
+#endif
+    g_once_init_leave (&simd_once, 1);
+  }
+}
+
 /*
  *
  * User-callable function to allocate all necessary storage space for the fft.
@@ -388,6 +423,8 @@ kiss_fft_f32_alloc (int nfft, int inverse_fft, void *mem, size_t * lenmem)
   size_t memneeded = sizeof (struct kiss_fft_f32_state)
       + sizeof (kiss_fft_f32_cpx) * (nfft - 1); /* twiddle factors */
 
+  kiss_fft_f32_check_simd ();
+
   if (lenmem == NULL) {
     st = (kiss_fft_f32_cfg) KISS_FFT_F32_MALLOC (memneeded);
   } else {
@@ -0,0 +1,154 @@
+/*
+Copyright (c) 2003-2004, Mark Borgerding
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the author nor the names of any contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "kiss_fft_f32_sse.h"
+
+#if defined (HAVE_XMMINTRIN_H) && defined(__SSE__)
+#include <xmmintrin.h>
+
+#include "_kiss_fft_guts_f32.h"
+
+/* Each __m128 holds two interleaved complex values: [ r0 i0 r1 i1 ].
+ * Only SSE1 instructions are used; the sign-flip trick below stands in
+ * for the SSE3 addsub instruction. */
+
+/* complex multiply of two packed complex pairs */
+static inline __m128
+kf_cmul_sse (__m128 a, __m128 b)
+{
+  const __m128 neg_r = _mm_set_ps (0.f, -0.f, 0.f, -0.f);
+  __m128 br, bi, arev;
+
+  br = _mm_shuffle_ps (b, b, _MM_SHUFFLE (2, 2, 0, 0));
+  bi = _mm_shuffle_ps (b, b, _MM_SHUFFLE (3, 3, 1, 1));
+  arev = _mm_shuffle_ps (a, a, _MM_SHUFFLE (2, 3, 0, 1));
+
+  /* (a.r*b.r - a.i*b.i) + (a.r*b.i + a.i*b.r)i */
+  return _mm_add_ps (_mm_mul_ps (a, br),
+      _mm_xor_ps (_mm_mul_ps (arev, bi), neg_r));
+}
+
+/* gather two twiddles that are fstride apart into one register */
+static inline __m128
+kf_load2_cpx_sse (const kiss_fft_f32_cpx * t0, const kiss_fft_f32_cpx * t1)
+{
+  __m128 v = _mm_loadl_pi (_mm_setzero_ps (), (const __m64 *) t0);
+
+  return _mm_loadh_pi (v, (const __m64 *) t1);
+}
+
+void
+kiss_fft_f32_bfly2_sse (kiss_fft_f32_cpx * Fout, const size_t fstride,
+    const kiss_fft_f32_cfg st, int m)
+{
+  kiss_fft_f32_cpx *tw = st->twiddles;
+  kiss_fft_f32_cpx *Fout2 = Fout + m;
+  int k;
+
+  for (k = 0; k + 1 < m; k += 2) {
+    __m128 F0, t;
+
+    F0 = _mm_loadu_ps ((const float *) (Fout + k));
+    t = kf_cmul_sse (_mm_loadu_ps ((const float *) (Fout2 + k)),
+        kf_load2_cpx_sse (tw + k * fstride, tw + (k + 1) * fstride));
+
+    _mm_storeu_ps ((float *) (Fout2 + k), _mm_sub_ps (F0, t));
+    _mm_storeu_ps ((float *) (Fout + k), _mm_add_ps (F0, t));
+  }
+
+  /* scalar tail for odd m */
+  for (; k < m; k++) {
+    kiss_fft_f32_cpx t;
+
+    C_MUL (t, Fout2[k], tw[k * fstride]);
+    C_SUB (Fout2[k], Fout[k], t);
+    C_ADDTO (Fout[k], t);
+  }
+}
+
+void
+kiss_fft_f32_bfly4_sse (kiss_fft_f32_cpx * Fout, const size_t fstride,
+    const kiss_fft_f32_cfg st, const size_t m)
+{
+  kiss_fft_f32_cpx *tw = st->twiddles;
+  const __m128 neg_i = _mm_set_ps (-0.f, 0.f, -0.f, 0.f);
+  const size_t m2 = 2 * m;
+  const size_t m3 = 3 * m;
+  size_t k;
+
+  for (k = 0; k + 1 < m; k += 2) {
+    __m128 F0, s0, s1, s2, s3, s4, s5, w;
+
+    F0 = _mm_loadu_ps ((const float *) (Fout + k));
+    s0 = kf_cmul_sse (_mm_loadu_ps ((const float *) (Fout + m + k)),
+        kf_load2_cpx_sse (tw + k * fstride, tw + (k + 1) * fstride));
+    s1 = kf_cmul_sse (_mm_loadu_ps ((const float *) (Fout + m2 + k)),
+        kf_load2_cpx_sse (tw + 2 * k * fstride, tw + 2 * (k + 1) * fstride));
+    s2 = kf_cmul_sse (_mm_loadu_ps ((const float *) (Fout + m3 + k)),
+        kf_load2_cpx_sse (tw + 3 * k * fstride, tw + 3 * (k + 1) * fstride));
+
+    s5 = _mm_sub_ps (F0, s1);
+    F0 = _mm_add_ps (F0, s1);
+    s3 = _mm_add_ps (s0, s2);
+    s4 = _mm_sub_ps (s0, s2);
+
+    _mm_storeu_ps ((float *) (Fout + m2 + k), _mm_sub_ps (F0, s3));
+    _mm_storeu_ps ((float *) (Fout + k), _mm_add_ps (F0, s3));
+
+    /* w = s4 rotated by -90 degrees: (s4.i, -s4.r) */
+    w = _mm_xor_ps (_mm_shuffle_ps (s4, s4, _MM_SHUFFLE (2, 3, 0, 1)), neg_i);
+
+    if (st->inverse) {
+      _mm_storeu_ps ((float *) (Fout + m + k), _mm_sub_ps (s5, w));
+      _mm_storeu_ps ((float *) (Fout + m3 + k), _mm_add_ps (s5, w));
+    } else {
+      _mm_storeu_ps ((float *) (Fout + m + k), _mm_add_ps (s5, w));
+      _mm_storeu_ps ((float *) (Fout + m3 + k), _mm_sub_ps (s5, w));
+    }
+  }
+
+  /* scalar tail for odd m */
+  for (; k < m; k++) {
+    kiss_fft_f32_cpx scratch[6];
+    kiss_fft_f32_cpx *F = Fout + k;
+
+    C_MUL (scratch[0], F[m], tw[k * fstride]);
+    C_MUL (scratch[1], F[m2], tw[2 * k * fstride]);
+    C_MUL (scratch[2], F[m3], tw[3 * k * fstride]);
+
+    C_SUB (scratch[5], *F, scratch[1]);
+    C_ADDTO (*F, scratch[1]);
+    C_ADD (scratch[3], scratch[0], scratch[2]);
+    C_SUB (scratch[4], scratch[0], scratch[2]);
+    C_SUB (F[m2], *F, scratch[3]);
+    C_ADDTO (*F, scratch[3]);
+
+    if (st->inverse) {
+      F[m].r = scratch[5].r - scratch[4].i;
+      F[m].i = scratch[5].i + scratch[4].r;
+      F[m3].r = scratch[5].r + scratch[4].i;
+      F[m3].i = scratch[5].i - scratch[4].r;
+    } else {
+      F[m].r = scratch[5].r + scratch[4].i;
+      F[m].i = scratch[5].i - scratch[4].r;
+      F[m3].r = scratch[5].r - scratch[4].i;
+      F[m3].i = scratch[5].i + scratch[4].r;
+    }
+  }
+}
+
+#endif
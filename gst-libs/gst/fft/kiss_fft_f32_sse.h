@@ -0,0 +1,30 @@
+/*
+Copyright (c) 2003-2004, Mark Borgerding
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the author nor the names of any contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* SSE implementations of the radix-2 and radix-4 butterflies for the
+ * float32 variant. Compiled into a separate object with SSE_CFLAGS and
+ * selected at runtime from kiss_fft_f32.c when the CPU supports SSE. */
+
+#ifndef KISS_FFT_F32_SSE_H
+#define KISS_FFT_F32_SSE_H
+
+#include "kiss_fft_f32.h"
+
+void kiss_fft_f32_bfly2_sse (kiss_fft_f32_cpx * Fout, const size_t fstride,
+    const kiss_fft_f32_cfg st, int m);
+
+void kiss_fft_f32_bfly4_sse (kiss_fft_f32_cpx * Fout, const size_t fstride,
+    const kiss_fft_f32_cfg st, const size_t m);
+
+#endif /* KISS_FFT_F32_SSE_H */
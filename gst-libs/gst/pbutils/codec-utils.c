@@ -1642,3 +1642,174 @@ done:
 
   return ret;
 }
+
+/* Process-wide cache of caps string -> RFC 6381 codec string. Manifest and
+ * SDP generators tend to ask for the same handful of caps over and over
+ * again, once per segment or per client, so remember what we computed.
+ * Flushed wholesale when it grows too large (the working set is tiny). */
+static GHashTable *mime_codec_cache;    /* protected by mime_codec_cache_lock */
+static GMutex mime_codec_cache_lock;
+
+#define MIME_CODEC_CACHE_MAX_ENTRIES 256
+
+static GstBuffer *
+caps_get_codec_data (const GstStructure * s)
+{
+  const GValue *codec_data_value;
+
+  codec_data_value = gst_structure_get_value (s, "codec_data");
+  if (codec_data_value == NULL || !GST_VALUE_HOLDS_BUFFER (codec_data_value))
+    return NULL;
+
+  return gst_value_get_buffer (codec_data_value);
+}
+
+static gchar *
+caps_get_mime_codec (const GstCaps * caps)
+{
+  const GstStructure *s;
+  const gchar *media_type;
+  GstBuffer *codec_data;
+  GstMapInfo map;
+  gchar *ret = NULL;
+
+  s = gst_caps_get_structure (caps, 0);
+  media_type = gst_structure_get_name (s);
+
+  if (strcmp (media_type, "video/x-h264") == 0) {
+    /* avc1.AABBCC, where AABBCC are profile_idc, constraint flags and
+     * level_idc as found in the avcC configuration record */
+    codec_data = caps_get_codec_data (s);
+    if (codec_data == NULL || !gst_buffer_map (codec_data, &map, GST_MAP_READ))
+      return NULL;
+    if (map.size >= 4)
+      ret = g_strdup_printf ("avc1.%02X%02X%02X", map.data[1], map.data[2],
+          map.data[3]);
+    gst_buffer_unmap (codec_data, &map);
+  } else if (strcmp (media_type, "video/x-h265") == 0) {
+    guint8 profile_space, tier_flag, profile_idc, level_idc;
+    guint32 compat_flags, compat_flags_reversed = 0;
+    const gchar *profile_space_str[] = { "", "A", "B", "C" };
+    gint i;
+
+    codec_data = caps_get_codec_data (s);
+    if (codec_data == NULL || !gst_buffer_map (codec_data, &map, GST_MAP_READ))
+      return NULL;
+    if (map.size >= 13 && map.data[0] == 1) {
+      profile_space = (map.data[1] & 0xc0) >> 6;
+      tier_flag = (map.data[1] & 0x20) >> 5;
+      profile_idc = map.data[1] & 0x1f;
+      compat_flags = GST_READ_UINT32_BE (map.data + 2);
+      level_idc = map.data[12];
+
+      /* The compatibility flags are serialised in reverse bit order
+       * (ISO/IEC 14496-15 E.3) */
+      for (i = 0; i < 32; i++) {
+        if (compat_flags & (1u << i))
+          compat_flags_reversed |= 1u << (31 - i);
+      }
+
+      ret = g_strdup_printf ("hvc1.%s%u.%X.%c%u",
+          profile_space_str[profile_space], profile_idc, compat_flags_reversed,
+          tier_flag ? 'H' : 'L', level_idc);
+    }
+    gst_buffer_unmap (codec_data, &map);
+  } else if (strcmp (media_type, "audio/mpeg") == 0) {
+    gint mpegversion = 0, layer = 0;
+
+    gst_structure_get_int (s, "mpegversion", &mpegversion);
+    if (mpegversion == 4) {
+      /* mp4a.40.OT, with OT the audio object type from the
+       * AudioSpecificConfig (first five bits) */
+      codec_data = caps_get_codec_data (s);
+      if (codec_data != NULL
+          && gst_buffer_map (codec_data, &map, GST_MAP_READ)) {
+        if (map.size >= 1)
+          ret = g_strdup_printf ("mp4a.40.%u", map.data[0] >> 3);
+        gst_buffer_unmap (codec_data, &map);
+      } else {
+        /* AAC-LC is by far the most common stream type */
+        ret = g_strdup ("mp4a.40.2");
+      }
+    } else if (mpegversion == 1) {
+      gst_structure_get_int (s, "layer", &layer);
+      if (layer == 3)
+        ret = g_strdup ("mp4a.40.34");
+    }
+  } else if (strcmp (media_type, "video/x-vp8") == 0) {
+    /* profile and level are not negotiated in caps; use the most common
+     * profile 0 / level 1.0 / 8 bit combination */
+    ret = g_strdup ("vp08.00.10.08");
+  } else if (strcmp (media_type, "video/x-vp9") == 0) {
+    ret = g_strdup ("vp09.00.10.08");
+  } else if (strcmp (media_type, "video/x-theora") == 0) {
+    ret = g_strdup ("theora");
+  } else if (strcmp (media_type, "audio/x-opus") == 0) {
+    ret = g_strdup ("opus");
+  } else if (strcmp (media_type, "audio/x-vorbis") == 0) {
+    ret = g_strdup ("vorbis");
+  } else if (strcmp (media_type, "audio/x-ac3") == 0) {
+    ret = g_strdup ("ac-3");
+  } else if (strcmp (media_type, "audio/x-eac3") == 0) {
+    ret = g_strdup ("ec-3");
+  }
+
+  return ret;
+}
+
+/**
+ * gst_codec_utils_caps_get_mime_codec:
+ * @caps: A #GstCaps to convert to mime codec
+ *
+ * Converts @caps to a RFC 6381 compatible codec string if possible.
+ *
+ * Useful for providing the 'codecs' field inside the 'Content-Type' HTTP
+ * header of a DASH or HLS manifest, or the SDP of a WebRTC session.
+ *
+ * Results are cached process-wide, so repeatedly converting the same caps
+ * (e.g. once per segment when generating a manifest) does not re-parse the
+ * codec data every time.
+ *
+ * Returns: (transfer full) (nullable): a RFC 6381 compatible codec string
+ *     or %NULL if @caps are not recognised.
+ *
+ * Since: 1.14
+ */
+gchar *
+gst_codec_utils_caps_get_mime_codec (GstCaps * caps)
+{
+  gchar *key, *mime_codec;
+
+  g_return_val_if_fail (GST_IS_CAPS (caps), NULL);
+  g_return_val_if_fail (GST_CAPS_IS_SIMPLE (caps), NULL);
+
+  key = gst_caps_to_string (caps);
+
+  g_mutex_lock (&mime_codec_cache_lock);
+  if (G_UNLIKELY (mime_codec_cache == NULL)) {
+    mime_codec_cache = g_hash_table_new_full (g_str_hash, g_str_equal,
+        (GDestroyNotify) g_free, (GDestroyNotify) g_free);
+  }
+  mime_codec = g_hash_table_lookup (mime_codec_cache, key);
+  if (mime_codec != NULL) {
+    mime_codec = g_strdup (mime_codec);
+    g_mutex_unlock (&mime_codec_cache_lock);
+    g_free (key);
+    return mime_codec;
+  }
+  g_mutex_unlock (&mime_codec_cache_lock);
+
+  mime_codec = caps_get_mime_codec (caps);
+
+  if (mime_codec != NULL) {
+    g_mutex_lock (&mime_codec_cache_lock);
+    if (g_hash_table_size (mime_codec_cache) >= MIME_CODEC_CACHE_MAX_ENTRIES)
+      g_hash_table_remove_all (mime_codec_cache);
+    g_hash_table_insert (mime_codec_cache, key, g_strdup (mime_codec));
+    g_mutex_unlock (&mime_codec_cache_lock);
+  } else {
+    g_free (key);
+  }
+
+  return mime_codec;
+}
@@ -850,28 +850,65 @@ format_info_get_desc (const FormatInfo * info, const GstCaps * caps)
   return NULL;
 }
 
+/* Index over the formats table so lookups don't have to scan the whole
+ * table on every call. Maps a media type to a GPtrArray with all records
+ * for that type, in table order (some types have both a systemstream and
+ * an elementary stream record). Built once on first use. */
+static GHashTable *format_index;        /* protected by the g_once below */
+
+static GHashTable *
+get_format_index (void)
+{
+  static gsize once = 0;
+
+  if (g_once_init_enter (&once)) {
+    GHashTable *index;
+    guint i;
+
+    index = g_hash_table_new (g_str_hash, g_str_equal);
+    for (i = 0; i < G_N_ELEMENTS (formats); ++i) {
+      GPtrArray *entries;
+
+      entries = g_hash_table_lookup (index, formats[i].type);
+      if (entries == NULL) {
+        entries = g_ptr_array_new ();
+        g_hash_table_insert (index, (gpointer) formats[i].type, entries);
+      }
+      g_ptr_array_add (entries, (gpointer) & formats[i]);
+    }
+    format_index = index;
+    g_once_init_leave (&once, 1);
+  }
+
+  return format_index;
+}
+
 /* returns format info structure, will return NULL for dynamic media types! */
 static const FormatInfo *
 find_format_info (const GstCaps * caps)
 {
   const GstStructure *s;
   const gchar *media_type;
+  const GPtrArray *entries;
   guint i;
 
   s = gst_caps_get_structure (caps, 0);
   media_type = gst_structure_get_name (s);
 
-  for (i = 0; i < G_N_ELEMENTS (formats); ++i) {
-    if (strcmp (media_type, formats[i].type) == 0) {
-      gboolean is_sys = FALSE;
+  entries = g_hash_table_lookup (get_format_index (), media_type);
+  if (entries == NULL)
+    return NULL;
 
-      if ((formats[i].flags & FLAG_SYSTEMSTREAM) == 0)
-        return &formats[i];
+  for (i = 0; i < entries->len; ++i) {
+    const FormatInfo *info = g_ptr_array_index (entries, i);
+    gboolean is_sys = FALSE;
 
-      /* this record should only be matched if the systemstream field is set */
-      if (gst_structure_get_boolean (s, "systemstream", &is_sys) && is_sys)
-        return &formats[i];
-    }
+    if ((info->flags & FLAG_SYSTEMSTREAM) == 0)
+      return info;
+
+    /* this record should only be matched if the systemstream field is set */
+    if (gst_structure_get_boolean (s, "systemstream", &is_sys) && is_sys)
+      return info;
   }
 
   return NULL;
@@ -1189,11 +1226,20 @@ gst_pb_utils_add_codec_description_to_tag_list (GstTagList * taglist,
  * Returns: a newly-allocated description string, or NULL on error. Free
  *          string with g_free() when not needed any longer.
  */
+/* Cache of complete description strings, keyed by the serialized caps.
+ * Dashboards and media library UIs tend to look up the same handful of
+ * formats over and over again. Flushed wholesale should it ever grow
+ * beyond any reasonable number of distinct formats. */
+static GHashTable *desc_cache;  /* protected by desc_cache_lock */
+static GMutex desc_cache_lock;
+
+#define DESC_CACHE_MAX_ENTRIES 512
+
 gchar *
 gst_pb_utils_get_codec_description (const GstCaps * caps)
 {
   const FormatInfo *info;
-  gchar *str, *comma;
+  gchar *str, *key, *comma;
   GstCaps *tmp;
 
   g_return_val_if_fail (caps != NULL, NULL);
@@ -1201,6 +1247,23 @@ gst_pb_utils_get_codec_description (const GstCaps * caps)
   tmp = copy_and_clean_caps (caps);
   g_return_val_if_fail (gst_caps_is_fixed (tmp), NULL);
 
+  key = gst_caps_to_string (tmp);
+
+  g_mutex_lock (&desc_cache_lock);
+  if (desc_cache == NULL) {
+    desc_cache =
+        g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+  }
+  str = g_hash_table_lookup (desc_cache, key);
+  if (str != NULL) {
+    str = g_strdup (str);
+    g_mutex_unlock (&desc_cache_lock);
+    g_free (key);
+    gst_caps_unref (tmp);
+    return str;
+  }
+  g_mutex_unlock (&desc_cache_lock);
+
   info = find_format_info (tmp);
 
   if (info) {
@@ -1220,6 +1283,12 @@ gst_pb_utils_get_codec_description (const GstCaps * caps)
   }
   gst_caps_unref (tmp);
 
+  g_mutex_lock (&desc_cache_lock);
+  if (g_hash_table_size (desc_cache) >= DESC_CACHE_MAX_ENTRIES)
+    g_hash_table_remove_all (desc_cache);
+  g_hash_table_insert (desc_cache, key, g_strdup (str));
+  g_mutex_unlock (&desc_cache_lock);
+
   return str;
 }
 
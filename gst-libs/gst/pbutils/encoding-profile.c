@@ -1477,6 +1477,41 @@ gst_encoding_profile_find (const gchar * targetname, const gchar * profilename,
   return res;
 }
 
+/**
+ * gst_encoding_profile_find_cached:
+ * @targetname: (transfer none): The name of the target
+ * @profilename: (transfer none): (allow-none): The name of the profile, if %NULL
+ * provided, it will default to the encoding profile called `default`.
+ * @category: (transfer none) (allow-none): The target category. Can be %NULL
+ *
+ * Like gst_encoding_profile_find(), but resolves the target through the
+ * process-wide registry of gst_encoding_target_load_cached(), so repeated
+ * lookups don't re-scan the target directories or re-parse the keyfiles.
+ *
+ * Returns: (transfer full): The matching #GstEncodingProfile or %NULL.
+ *
+ * Since: 1.14
+ */
+GstEncodingProfile *
+gst_encoding_profile_find_cached (const gchar * targetname,
+    const gchar * profilename, const gchar * category)
+{
+  GstEncodingProfile *res = NULL;
+  GstEncodingTarget *target;
+
+  g_return_val_if_fail (targetname != NULL, NULL);
+
+  target = gst_encoding_target_load_cached (targetname, category);
+  if (target) {
+    res =
+        gst_encoding_target_get_profile (target,
+        profilename ? profilename : "default");
+    gst_encoding_target_unref (target);
+  }
+
+  return res;
+}
+
 static GstEncodingProfile *
 combo_search (const gchar * pname)
 {
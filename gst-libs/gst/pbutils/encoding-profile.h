@@ -198,6 +198,11 @@ GstEncodingProfile * gst_encoding_profile_find (const gchar *targetname,
                                                 const gchar *profilename,
                                                 const gchar *category);
 
+GST_EXPORT
+GstEncodingProfile * gst_encoding_profile_find_cached (const gchar *targetname,
+                                                       const gchar *profilename,
+                                                       const gchar *category);
+
 GST_EXPORT
 gboolean        gst_encoding_profile_is_enabled        (GstEncodingProfile *profile);
 
@@ -25,6 +25,7 @@
 #include <locale.h>
 #include <errno.h>
 #include <string.h>
+#include <glib/gstdio.h>
 #include "encoding-target.h"
 
 /* Documented in encoding-profile.c */
@@ -1222,3 +1223,241 @@ gst_encoding_list_all_targets (const gchar * categoryname)
 
   return res;
 }
+
+/* Process-wide registry of the encoding targets on disk, so repeated
+ * lookups don't re-scan the directories and re-parse the keyfiles.
+ * Maps "name" and "category/name" to a GstEncodingTarget ref. The
+ * modification times of the target directories are recorded when the
+ * registry is built and rechecked on lookup, so on-disk changes
+ * trigger a rebuild. */
+static GMutex target_registry_lock;
+static GHashTable *target_registry = NULL;
+static GList *target_registry_dirs = NULL;
+
+typedef struct
+{
+  gchar *path;
+  gint64 mtime;                 /* -1 if the directory does not exist */
+} TargetRegistryDir;
+
+static void
+target_registry_dir_free (TargetRegistryDir * dir)
+{
+  g_free (dir->path);
+  g_slice_free (TargetRegistryDir, dir);
+}
+
+static GList *
+target_registry_append_dir (GList * dirs, const gchar * path)
+{
+  TargetRegistryDir *dir;
+  GStatBuf sbuf;
+  GDir *d;
+
+  dir = g_slice_new (TargetRegistryDir);
+  dir->path = g_strdup (path);
+  if (g_stat (path, &sbuf) == 0)
+    dir->mtime = (gint64) sbuf.st_mtime;
+  else
+    dir->mtime = -1;
+  dirs = g_list_append (dirs, dir);
+
+  /* also record the category subdirectories, a file change inside one
+   * only updates the mtime of the subdirectory */
+  d = g_dir_open (path, 0, NULL);
+  if (d) {
+    const gchar *subdirname;
+
+    while ((subdirname = g_dir_read_name (d))) {
+      gchar *subdir = g_build_filename (path, subdirname, NULL);
+
+      if (g_file_test (subdir, G_FILE_TEST_IS_DIR)) {
+        TargetRegistryDir *sub = g_slice_new (TargetRegistryDir);
+
+        sub->path = subdir;
+        if (g_stat (subdir, &sbuf) == 0)
+          sub->mtime = (gint64) sbuf.st_mtime;
+        else
+          sub->mtime = -1;
+        dirs = g_list_append (dirs, sub);
+      } else {
+        g_free (subdir);
+      }
+    }
+    g_dir_close (d);
+  }
+
+  return dirs;
+}
+
+static GList *
+target_registry_scan_dirs (void)
+{
+  GList *dirs = NULL;
+  gchar *topdir;
+  const gchar *envvar;
+
+  envvar = g_getenv ("GST_ENCODING_TARGET_PATH");
+  if (envvar) {
+    gchar **encoding_target_dirs;
+    gint i;
+
+    encoding_target_dirs = g_strsplit (envvar, G_SEARCHPATH_SEPARATOR_S, -1);
+    for (i = 0; encoding_target_dirs[i]; i++)
+      dirs = target_registry_append_dir (dirs, encoding_target_dirs[i]);
+    g_strfreev (encoding_target_dirs);
+  }
+
+  topdir =
+      g_build_filename (g_get_user_data_dir (), "gstreamer-" GST_API_VERSION,
+      GST_ENCODING_TARGET_DIRECTORY, NULL);
+  dirs = target_registry_append_dir (dirs, topdir);
+  g_free (topdir);
+
+  topdir = g_build_filename (GST_DATADIR, "gstreamer-" GST_API_VERSION,
+      GST_ENCODING_TARGET_DIRECTORY, NULL);
+  dirs = target_registry_append_dir (dirs, topdir);
+  g_free (topdir);
+
+  return dirs;
+}
+
+static gboolean
+target_registry_uptodate (void)
+{
+  GList *current, *walk1, *walk2;
+  gboolean ret = TRUE;
+
+  if (target_registry == NULL)
+    return FALSE;
+
+  current = target_registry_scan_dirs ();
+  for (walk1 = current, walk2 = target_registry_dirs; walk1 && walk2;
+      walk1 = walk1->next, walk2 = walk2->next) {
+    TargetRegistryDir *a = walk1->data, *b = walk2->data;
+
+    if (a->mtime != b->mtime || g_strcmp0 (a->path, b->path)) {
+      ret = FALSE;
+      break;
+    }
+  }
+  if (walk1 || walk2)
+    ret = FALSE;
+
+  g_list_free_full (current, (GDestroyNotify) target_registry_dir_free);
+
+  return ret;
+}
+
+static void
+target_registry_build (void)
+{
+  GList *targets, *tmp;
+
+  if (target_registry) {
+    g_hash_table_unref (target_registry);
+    g_list_free_full (target_registry_dirs,
+        (GDestroyNotify) target_registry_dir_free);
+  }
+
+  target_registry_dirs = target_registry_scan_dirs ();
+  target_registry = g_hash_table_new_full (g_str_hash, g_str_equal,
+      g_free, gst_object_unref);
+
+  targets = gst_encoding_list_all_targets (NULL);
+  for (tmp = targets; tmp; tmp = tmp->next) {
+    GstEncodingTarget *target = tmp->data;
+    gchar **names = g_strsplit (target->name, ";", -1);
+    gint i;
+
+    for (i = 0; names[i]; i++) {
+      gchar *key;
+
+      /* the list is ordered by priority, first one wins */
+      if (!g_hash_table_contains (target_registry, names[i]))
+        g_hash_table_insert (target_registry, g_strdup (names[i]),
+            gst_object_ref (target));
+
+      key = g_strdup_printf ("%s/%s", target->category, names[i]);
+      if (!g_hash_table_contains (target_registry, key))
+        g_hash_table_insert (target_registry, key, gst_object_ref (target));
+      else
+        g_free (key);
+    }
+    g_strfreev (names);
+  }
+  g_list_free_full (targets, gst_object_unref);
+
+  GST_DEBUG ("registry built with %u entries",
+      g_hash_table_size (target_registry));
+}
+
+/**
+ * gst_encoding_target_load_cached:
+ * @name: the name of the #GstEncodingTarget to load (automatically
+ * converted to lower case internally as capital letters are not
+ * valid for target names).
+ * @category: (allow-none): the name of the target category, like
+ * #GST_ENCODING_CATEGORY_DEVICE. Can be %NULL
+ *
+ * Like gst_encoding_target_load(), but looks the target up in a
+ * process-wide registry that is built by scanning the target
+ * directories once. Subsequent lookups are hash table accesses without
+ * filesystem scans or keyfile parsing. The registry is rebuilt
+ * automatically when the modification time of one of the target
+ * directories changes.
+ *
+ * Returns: (transfer full): The #GstEncodingTarget if available, else %NULL.
+ *
+ * Since: 1.14
+ */
+GstEncodingTarget *
+gst_encoding_target_load_cached (const gchar * name, const gchar * category)
+{
+  GstEncodingTarget *target;
+  gchar *p, *lname, *key;
+
+  g_return_val_if_fail (name != NULL, NULL);
+
+  p = lname = g_str_to_ascii (name, NULL);
+  for (; *p; ++p)
+    *p = g_ascii_tolower (*p);
+
+  if (!validate_name (lname))
+    goto invalid_name;
+
+  if (category && !validate_name (category))
+    goto invalid_category;
+
+  if (category)
+    key = g_strdup_printf ("%s/%s", category, lname);
+  else
+    key = g_strdup (lname);
+
+  g_mutex_lock (&target_registry_lock);
+  if (!target_registry_uptodate ())
+    target_registry_build ();
+
+  target = g_hash_table_lookup (target_registry, key);
+  if (target)
+    gst_object_ref (target);
+  g_mutex_unlock (&target_registry_lock);
+
+  g_free (key);
+  g_free (lname);
+
+  return target;
+
+invalid_name:
+  {
+    GST_ERROR ("Invalid name for encoding target : '%s'", name);
+    g_free (lname);
+    return NULL;
+  }
+invalid_category:
+  {
+    GST_ERROR ("Invalid name for encoding category : '%s'", category);
+    g_free (lname);
+    return NULL;
+  }
+}
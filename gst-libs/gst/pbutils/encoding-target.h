@@ -161,6 +161,10 @@ GstEncodingTarget *     gst_encoding_target_load                (const gchar *na
                                                                  const gchar *category,
                                                                  GError **error);
 
+GST_EXPORT
+GstEncodingTarget *     gst_encoding_target_load_cached         (const gchar *name,
+                                                                 const gchar *category);
+
 GST_EXPORT
 GstEncodingTarget *     gst_encoding_target_load_from_file      (const gchar *filepath,
                                                                  GError **error);
@@ -50,12 +50,14 @@ GST_DEBUG_CATEGORY_STATIC (audio_visualizer_debug);
 
 #define DEFAULT_SHADER GST_AUDIO_VISUALIZER_SHADER_FADE
 #define DEFAULT_SHADE_AMOUNT   0x000a0a0a
+#define DEFAULT_RENDER_ASYNC   FALSE
 
 enum
 {
   PROP_0,
   PROP_SHADER,
-  PROP_SHADE_AMOUNT
+  PROP_SHADE_AMOUNT,
+  PROP_RENDER_ASYNC
 };
 
 static GstBaseTransformClass *parent_class = NULL;
@@ -92,6 +94,13 @@ static GstStateChangeReturn gst_audio_visualizer_change_state (GstElement *
 static gboolean gst_audio_visualizer_do_bufferpool (GstAudioVisualizer * scope,
     GstCaps * outcaps);
 
+static void gst_audio_visualizer_start_render_thread (GstAudioVisualizer *
+    scope);
+static void gst_audio_visualizer_stop_render_thread (GstAudioVisualizer *
+    scope);
+static void gst_audio_visualizer_drain_render_queue (GstAudioVisualizer *
+    scope);
+
 static gboolean
 default_decide_allocation (GstAudioVisualizer * scope, GstQuery * query);
 
@@ -135,8 +144,41 @@ struct _GstAudioVisualizerPrivate
   GMutex config_lock;
 
   GstSegment segment;
+
+  /* band of rows the subclass draws to; 0 height means the whole
+   * frame, see gst_audio_visualizer_set_dirty_region() *//* with config_lock */
+  gint dirty_y;
+  gint dirty_height;
+
+  /* threaded rendering *//* with render_lock */
+  gboolean render_async;        /* property */
+  GThread *render_thread;
+  GQueue render_jobs;
+  gboolean render_busy;         /* a job is being rendered right now */
+  gboolean render_stop;
+  gboolean render_flushing;
+  GstFlowReturn render_ret;
+  GMutex render_lock;
+  GCond render_cond;
 };
 
+/* one frame worth of audio waiting for the render thread */
+typedef struct
+{
+  GstBuffer *audio;
+  GstClockTime ts;
+} RenderJob;
+
+/* max frames queued for the render thread before the chain function blocks */
+#define MAX_RENDER_JOBS 2
+
+static void
+render_job_free (RenderJob * job)
+{
+  gst_buffer_unref (job->audio);
+  g_slice_free (RenderJob, job);
+}
+
 /* shading functions */
 
 /* we're only supporting GST_VIDEO_FORMAT_xRGB right now) */
@@ -162,16 +204,34 @@ G_STMT_START {                                            \
 
 #endif
 
+/* Returns the range of rows the shading functions need to process. When the
+ * subclass marked a dirty region, everything outside of it is known to be
+ * black already and can be skipped; one row of slack on either side keeps
+ * the moving shaders working on pixels that drift out of the region. */
+static void
+get_shade_range (GstAudioVisualizer * scope, gint height, gint * y0, gint * y1)
+{
+  if (scope->priv->dirty_height <= 0) {
+    *y0 = 0;
+    *y1 = height;
+    return;
+  }
+
+  *y0 = CLAMP (scope->priv->dirty_y - 1, 0, height);
+  *y1 = CLAMP (scope->priv->dirty_y + scope->priv->dirty_height + 1, 0,
+      height);
+}
+
 static void
 shader_fade (GstAudioVisualizer * scope, const GstVideoFrame * sframe,
     GstVideoFrame * dframe)
 {
-  guint i, j;
+  gint i, j;
   guint r = (scope->priv->shade_amount >> 16) & 0xff;
   guint g = (scope->priv->shade_amount >> 8) & 0xff;
   guint b = (scope->priv->shade_amount >> 0) & 0xff;
   guint8 *s, *d;
-  gint ss, ds, width, height;
+  gint ss, ds, width, height, y0, y1;
 
   s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
   ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
@@ -181,7 +241,11 @@ shader_fade (GstAudioVisualizer * scope, const GstVideoFrame * sframe,
   width = GST_VIDEO_FRAME_WIDTH (sframe);
   height = GST_VIDEO_FRAME_HEIGHT (sframe);
 
-  for (j = 0; j < height; j++) {
+  get_shade_range (scope, height, &y0, &y1);
+  s += y0 * ss;
+  d += y0 * ds;
+
+  for (j = y0; j < y1; j++) {
     for (i = 0; i < width; i++) {
       SHADE (d, s, i, r, g, b);
     }
@@ -194,12 +258,12 @@ static void
 shader_fade_and_move_up (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
+  gint i, j;
   guint r = (scope->priv->shade_amount >> 16) & 0xff;
   guint g = (scope->priv->shade_amount >> 8) & 0xff;
   guint b = (scope->priv->shade_amount >> 0) & 0xff;
   guint8 *s, *d;
-  gint ss, ds, width, height;
+  gint ss, ds, width, height, y0, y1;
 
   s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
   ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
@@ -209,11 +273,17 @@ shader_fade_and_move_up (GstAudioVisualizer * scope,
   width = GST_VIDEO_FRAME_WIDTH (sframe);
   height = GST_VIDEO_FRAME_HEIGHT (sframe);
 
-  for (j = 1; j < height; j++) {
-    s += ss;
+  /* dest row j is taken from source row j + 1 */
+  get_shade_range (scope, height, &y0, &y1);
+  y1 = MIN (y1, height - 1);
+  s += (y0 + 1) * ss;
+  d += y0 * ds;
+
+  for (j = y0; j < y1; j++) {
     for (i = 0; i < width; i++) {
       SHADE (d, s, i, r, g, b);
     }
+    s += ss;
     d += ds;
   }
 }
@@ -222,12 +292,12 @@ static void
 shader_fade_and_move_down (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
+  gint i, j;
   guint r = (scope->priv->shade_amount >> 16) & 0xff;
   guint g = (scope->priv->shade_amount >> 8) & 0xff;
   guint b = (scope->priv->shade_amount >> 0) & 0xff;
   guint8 *s, *d;
-  gint ss, ds, width, height;
+  gint ss, ds, width, height, y0, y1;
 
   s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
   ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
@@ -237,12 +307,18 @@ shader_fade_and_move_down (GstAudioVisualizer * scope,
   width = GST_VIDEO_FRAME_WIDTH (sframe);
   height = GST_VIDEO_FRAME_HEIGHT (sframe);
 
-  for (j = 1; j < height; j++) {
-    d += ds;
+  /* dest row j is taken from source row j - 1 */
+  get_shade_range (scope, height, &y0, &y1);
+  y0 = MAX (y0, 1);
+  s += (y0 - 1) * ss;
+  d += y0 * ds;
+
+  for (j = y0; j < y1; j++) {
     for (i = 0; i < width; i++) {
       SHADE (d, s, i, r, g, b);
     }
     s += ss;
+    d += ds;
   }
 }
 
@@ -250,12 +326,12 @@ static void
 shader_fade_and_move_left (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
+  gint i, j;
   guint r = (scope->priv->shade_amount >> 16) & 0xff;
   guint g = (scope->priv->shade_amount >> 8) & 0xff;
   guint b = (scope->priv->shade_amount >> 0) & 0xff;
   guint8 *s, *d;
-  gint ss, ds, width, height;
+  gint ss, ds, width, height, y0, y1;
 
   s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
   ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
@@ -268,8 +344,12 @@ shader_fade_and_move_left (GstAudioVisualizer * scope,
   width -= 1;
   s += 4;
 
+  get_shade_range (scope, height, &y0, &y1);
+  s += y0 * ss;
+  d += y0 * ds;
+
   /* move to the left */
-  for (j = 0; j < height; j++) {
+  for (j = y0; j < y1; j++) {
     for (i = 0; i < width; i++) {
       SHADE (d, s, i, r, g, b);
     }
@@ -282,12 +362,12 @@ static void
 shader_fade_and_move_right (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
+  gint i, j;
   guint r = (scope->priv->shade_amount >> 16) & 0xff;
   guint g = (scope->priv->shade_amount >> 8) & 0xff;
   guint b = (scope->priv->shade_amount >> 0) & 0xff;
   guint8 *s, *d;
-  gint ss, ds, width, height;
+  gint ss, ds, width, height, y0, y1;
 
   s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
   ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
@@ -300,8 +380,12 @@ shader_fade_and_move_right (GstAudioVisualizer * scope,
   width -= 1;
   d += 4;
 
+  get_shade_range (scope, height, &y0, &y1);
+  s += y0 * ss;
+  d += y0 * ds;
+
   /* move to the right */
-  for (j = 0; j < height; j++) {
+  for (j = y0; j < y1; j++) {
     for (i = 0; i < width; i++) {
       SHADE (d, s, i, r, g, b);
     }
@@ -314,12 +398,12 @@ static void
 shader_fade_and_move_horiz_out (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
+  gint i, j, jb, jt;
   guint r = (scope->priv->shade_amount >> 16) & 0xff;
   guint g = (scope->priv->shade_amount >> 8) & 0xff;
   guint b = (scope->priv->shade_amount >> 0) & 0xff;
-  guint8 *s, *d;
-  gint ss, ds, width, height;
+  guint8 *s, *s1, *d, *d1;
+  gint ss, ds, width, height, y0, y1;
 
   s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
   ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
@@ -329,21 +413,31 @@ shader_fade_and_move_horiz_out (GstAudioVisualizer * scope,
   width = GST_VIDEO_FRAME_WIDTH (sframe);
   height = GST_VIDEO_FRAME_HEIGHT (sframe);
 
+  get_shade_range (scope, height, &y0, &y1);
+
   /* move upper half up */
-  for (j = 0; j < height / 2; j++) {
-    s += ss;
+  jb = y0;
+  jt = MIN (y1, height / 2);
+  s1 = s + (jb + 1) * ss;
+  d1 = d + jb * ds;
+  for (j = jb; j < jt; j++) {
     for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
+      SHADE (d1, s1, i, r, g, b);
     }
-    d += ds;
+    s1 += ss;
+    d1 += ds;
   }
   /* move lower half down */
-  for (j = 0; j < height / 2; j++) {
-    d += ds;
+  jb = MAX (y0, height / 2);
+  jt = y1;
+  s1 = s + (jb - 1) * ss;
+  d1 = d + jb * ds;
+  for (j = jb; j < jt; j++) {
     for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
+      SHADE (d1, s1, i, r, g, b);
     }
-    s += ss;
+    s1 += ss;
+    d1 += ds;
   }
 }
 
@@ -351,12 +445,12 @@ static void
 shader_fade_and_move_horiz_in (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
+  gint i, j, jb, jt;
   guint r = (scope->priv->shade_amount >> 16) & 0xff;
   guint g = (scope->priv->shade_amount >> 8) & 0xff;
   guint b = (scope->priv->shade_amount >> 0) & 0xff;
-  guint8 *s, *d;
-  gint ss, ds, width, height;
+  guint8 *s, *s1, *d, *d1;
+  gint ss, ds, width, height, y0, y1;
 
   s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
   ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
@@ -366,21 +460,31 @@ shader_fade_and_move_horiz_in (GstAudioVisualizer * scope,
   width = GST_VIDEO_FRAME_WIDTH (sframe);
   height = GST_VIDEO_FRAME_HEIGHT (sframe);
 
+  get_shade_range (scope, height, &y0, &y1);
+
   /* move upper half down */
-  for (j = 0; j < height / 2; j++) {
-    d += ds;
+  jb = MAX (y0, 1);
+  jt = MIN (y1, height / 2);
+  s1 = s + (jb - 1) * ss;
+  d1 = d + jb * ds;
+  for (j = jb; j < jt; j++) {
     for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
+      SHADE (d1, s1, i, r, g, b);
     }
-    s += ss;
+    s1 += ss;
+    d1 += ds;
   }
   /* move lower half up */
-  for (j = 0; j < height / 2; j++) {
-    s += ss;
+  jb = MAX (y0, height / 2);
+  jt = MIN (y1, height - 1);
+  s1 = s + (jb + 1) * ss;
+  d1 = d + jb * ds;
+  for (j = jb; j < jt; j++) {
     for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
+      SHADE (d1, s1, i, r, g, b);
     }
-    d += ds;
+    s1 += ss;
+    d1 += ds;
   }
 }
 
@@ -388,12 +492,12 @@ static void
 shader_fade_and_move_vert_out (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
+  gint i, j;
   guint r = (scope->priv->shade_amount >> 16) & 0xff;
   guint g = (scope->priv->shade_amount >> 8) & 0xff;
   guint b = (scope->priv->shade_amount >> 0) & 0xff;
   guint8 *s, *s1, *d, *d1;
-  gint ss, ds, width, height;
+  gint ss, ds, width, height, y0, y1;
 
   s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
   ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
@@ -403,7 +507,11 @@ shader_fade_and_move_vert_out (GstAudioVisualizer * scope,
   width = GST_VIDEO_FRAME_WIDTH (sframe);
   height = GST_VIDEO_FRAME_HEIGHT (sframe);
 
-  for (j = 0; j < height; j++) {
+  get_shade_range (scope, height, &y0, &y1);
+  s += y0 * ss;
+  d += y0 * ds;
+
+  for (j = y0; j < y1; j++) {
     /* move left half to the left */
     s1 = s + 1;
     for (i = 0; i < width / 2; i++) {
@@ -423,12 +531,12 @@ static void
 shader_fade_and_move_vert_in (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
+  gint i, j;
   guint r = (scope->priv->shade_amount >> 16) & 0xff;
   guint g = (scope->priv->shade_amount >> 8) & 0xff;
   guint b = (scope->priv->shade_amount >> 0) & 0xff;
   guint8 *s, *s1, *d, *d1;
-  gint ss, ds, width, height;
+  gint ss, ds, width, height, y0, y1;
 
   s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
   ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
@@ -438,7 +546,11 @@ shader_fade_and_move_vert_in (GstAudioVisualizer * scope,
   width = GST_VIDEO_FRAME_WIDTH (sframe);
   height = GST_VIDEO_FRAME_HEIGHT (sframe);
 
-  for (j = 0; j < height; j++) {
+  get_shade_range (scope, height, &y0, &y1);
+  s += y0 * ss;
+  d += y0 * ds;
+
+  for (j = y0; j < y1; j++) {
     /* move left half to the right */
     d1 = d + 1;
     for (i = 0; i < width / 2; i++) {
@@ -495,6 +607,73 @@ gst_audio_visualizer_change_shader (GstAudioVisualizer * scope)
   }
 }
 
+/**
+ * gst_audio_visualizer_set_dirty_region:
+ * @scope: a #GstAudioVisualizer
+ * @y: first row the subclass draws to
+ * @height: number of rows the subclass draws to, or 0 for the whole frame
+ *
+ * Tells the base class which band of rows the subclass actually draws to.
+ * The background shading functions then only process that band (plus one
+ * row of slack for the moving shaders) instead of the whole frame, which
+ * saves considerable CPU for visualisations that only use part of the
+ * frame. Content that drifts more than one row outside of the marked
+ * region is discarded instead of faded out.
+ *
+ * Typically called from the setup() vmethod. By default the whole frame
+ * is processed.
+ *
+ * Since: 1.14
+ */
+void
+gst_audio_visualizer_set_dirty_region (GstAudioVisualizer * scope, gint y,
+    gint height)
+{
+  GstAudioVisualizerPrivate *priv;
+  gint rows, old_y0, old_y1, new_y0, new_y1, j;
+
+  g_return_if_fail (GST_IS_SYNAESTHESIA (scope));
+
+  priv = scope->priv;
+
+  g_mutex_lock (&priv->config_lock);
+
+  rows = GST_VIDEO_INFO_HEIGHT (&scope->vinfo);
+
+  if (priv->dirty_height > 0) {
+    old_y0 = CLAMP (priv->dirty_y - 1, 0, rows);
+    old_y1 = CLAMP (priv->dirty_y + priv->dirty_height + 1, 0, rows);
+  } else {
+    old_y0 = 0;
+    old_y1 = rows;
+  }
+
+  priv->dirty_y = y;
+  priv->dirty_height = height;
+
+  if (height > 0) {
+    new_y0 = CLAMP (y - 1, 0, rows);
+    new_y1 = CLAMP (y + height + 1, 0, rows);
+  } else {
+    new_y0 = 0;
+    new_y1 = rows;
+  }
+
+  /* rows leaving the region may still hold shading residue, clear them so
+   * they don't come back as ghosts when the region grows again */
+  if (priv->tempbuf) {
+    guint8 *data = GST_VIDEO_FRAME_PLANE_DATA (&priv->tempframe, 0);
+    gint stride = GST_VIDEO_FRAME_PLANE_STRIDE (&priv->tempframe, 0);
+
+    for (j = old_y0; j < old_y1; j++) {
+      if (j < new_y0 || j >= new_y1)
+        memset (data + j * stride, 0, stride);
+    }
+  }
+
+  g_mutex_unlock (&priv->config_lock);
+}
+
 /* base class */
 
 GType
@@ -557,6 +736,20 @@ gst_audio_visualizer_class_init (GstAudioVisualizerClass * klass)
           "Shading color to use (big-endian ARGB)", 0, G_MAXUINT32,
           DEFAULT_SHADE_AMOUNT,
           G_PARAM_READWRITE | GST_PARAM_CONTROLLABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAudioVisualizer:render-async:
+   *
+   * Render and push frames from a separate thread instead of the
+   * streaming thread, so expensive visualisations don't stall the
+   * audio path. Takes effect on the next READY to PAUSED transition.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_RENDER_ASYNC,
+      g_param_spec_boolean ("render-async", "render asynchronously",
+          "Render frames on a separate thread", DEFAULT_RENDER_ASYNC,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -595,6 +788,7 @@ gst_audio_visualizer_init (GstAudioVisualizer * scope,
   scope->priv->shader_type = DEFAULT_SHADER;
   gst_audio_visualizer_change_shader (scope);
   scope->priv->shade_amount = DEFAULT_SHADE_AMOUNT;
+  scope->priv->render_async = DEFAULT_RENDER_ASYNC;
 
   /* reset the initial video state */
   gst_video_info_init (&scope->vinfo);
@@ -605,6 +799,11 @@ gst_audio_visualizer_init (GstAudioVisualizer * scope,
   gst_video_info_init (&scope->vinfo);
 
   g_mutex_init (&scope->priv->config_lock);
+
+  g_queue_init (&scope->priv->render_jobs);
+  scope->priv->render_ret = GST_FLOW_OK;
+  g_mutex_init (&scope->priv->render_lock);
+  g_cond_init (&scope->priv->render_cond);
 }
 
 static void
@@ -621,6 +820,9 @@ gst_audio_visualizer_set_property (GObject * object, guint prop_id,
     case PROP_SHADE_AMOUNT:
       scope->priv->shade_amount = g_value_get_uint (value);
       break;
+    case PROP_RENDER_ASYNC:
+      scope->priv->render_async = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -640,6 +842,9 @@ gst_audio_visualizer_get_property (GObject * object, guint prop_id,
     case PROP_SHADE_AMOUNT:
       g_value_set_uint (value, scope->priv->shade_amount);
       break;
+    case PROP_RENDER_ASYNC:
+      g_value_set_boolean (value, scope->priv->render_async);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -664,9 +869,12 @@ gst_audio_visualizer_dispose (GObject * object)
     gst_buffer_unref (scope->priv->tempbuf);
     scope->priv->tempbuf = NULL;
   }
+  gst_audio_visualizer_stop_render_thread (scope);
   if (scope->priv->config_lock.p) {
     g_mutex_clear (&scope->priv->config_lock);
     scope->priv->config_lock.p = NULL;
+    g_mutex_clear (&scope->priv->render_lock);
+    g_cond_clear (&scope->priv->render_cond);
   }
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
@@ -729,6 +937,9 @@ gst_audio_visualizer_src_setcaps (GstAudioVisualizer * scope, GstCaps * caps)
 
   klass = GST_AUDIO_VISUALIZER_CLASS (G_OBJECT_GET_CLASS (scope));
 
+  /* the render thread uses the video info and the tempframe */
+  gst_audio_visualizer_drain_render_queue (scope);
+
   scope->vinfo = info;
 
   scope->priv->frame_duration = gst_util_uint64_scale_int (GST_SECOND,
@@ -1026,13 +1237,174 @@ activate_failed:
   }
 }
 
+/* Renders one frame worth of audio into a new video buffer and pushes it
+ * downstream. Runs on the streaming thread, or on the render thread when
+ * the render-async property is enabled. Must be called without the config
+ * lock held. */
+static GstFlowReturn
+gst_audio_visualizer_render_frame (GstAudioVisualizer * scope,
+    GstBuffer * audio, GstClockTime ts)
+{
+  GstAudioVisualizerClass *klass;
+  GstBuffer *outbuf;
+  GstVideoFrame outframe;
+  GstFlowReturn ret;
+
+  klass = GST_AUDIO_VISUALIZER_CLASS (G_OBJECT_GET_CLASS (scope));
+
+  ret = default_prepare_output_buffer (scope, &outbuf);
+  if (ret != GST_FLOW_OK)
+    return ret;
+
+  /* sync controlled properties */
+  if (GST_CLOCK_TIME_IS_VALID (ts))
+    gst_object_sync_values (GST_OBJECT (scope), ts);
+
+  GST_BUFFER_PTS (outbuf) = ts;
+  GST_BUFFER_DURATION (outbuf) = scope->priv->frame_duration;
+
+  gst_video_frame_map (&outframe, &scope->vinfo, outbuf, GST_MAP_READWRITE);
+
+  g_mutex_lock (&scope->priv->config_lock);
+
+  if (scope->priv->shader) {
+    gst_video_frame_copy (&outframe, &scope->priv->tempframe);
+  } else {
+    /* gst_video_frame_clear() or is output frame already cleared */
+    gint i;
+
+    for (i = 0; i < scope->vinfo.finfo->n_planes; i++) {
+      memset (outframe.data[i], 0, outframe.map[i].size);
+    }
+  }
+
+  /* call class->render() vmethod */
+  if (klass->render) {
+    if (!klass->render (scope, audio, &outframe)) {
+      ret = GST_FLOW_ERROR;
+    } else {
+      /* run various post processing (shading and geometric transformation) */
+      /* FIXME: SHADER assumes 32bpp */
+      if (scope->priv->shader &&
+          GST_VIDEO_INFO_COMP_PSTRIDE (&scope->vinfo, 0) == 4) {
+        scope->priv->shader (scope, &outframe, &scope->priv->tempframe);
+      }
+    }
+  }
+
+  g_mutex_unlock (&scope->priv->config_lock);
+
+  gst_video_frame_unmap (&outframe);
+
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (outbuf);
+    return ret;
+  }
+
+  return gst_pad_push (scope->priv->srcpad, outbuf);
+}
+
+static gpointer
+gst_audio_visualizer_render_thread_func (gpointer data)
+{
+  GstAudioVisualizer *scope = data;
+  GstAudioVisualizerPrivate *priv = scope->priv;
+
+  g_mutex_lock (&priv->render_lock);
+  while (TRUE) {
+    RenderJob *job;
+    GstFlowReturn ret;
+
+    while (!priv->render_stop && g_queue_is_empty (&priv->render_jobs))
+      g_cond_wait (&priv->render_cond, &priv->render_lock);
+    if (priv->render_stop)
+      break;
+
+    job = g_queue_pop_head (&priv->render_jobs);
+
+    if (priv->render_flushing) {
+      render_job_free (job);
+      g_cond_broadcast (&priv->render_cond);
+      continue;
+    }
+
+    priv->render_busy = TRUE;
+    g_mutex_unlock (&priv->render_lock);
+
+    ret = gst_audio_visualizer_render_frame (scope, job->audio, job->ts);
+    render_job_free (job);
+
+    g_mutex_lock (&priv->render_lock);
+    priv->render_busy = FALSE;
+    if (ret != GST_FLOW_OK && priv->render_ret == GST_FLOW_OK)
+      priv->render_ret = ret;
+    g_cond_broadcast (&priv->render_cond);
+  }
+  g_mutex_unlock (&priv->render_lock);
+
+  return NULL;
+}
+
+static void
+gst_audio_visualizer_start_render_thread (GstAudioVisualizer * scope)
+{
+  GstAudioVisualizerPrivate *priv = scope->priv;
+
+  if (!priv->render_async || priv->render_thread)
+    return;
+
+  priv->render_stop = FALSE;
+  priv->render_flushing = FALSE;
+  priv->render_ret = GST_FLOW_OK;
+  priv->render_thread = g_thread_new ("visualizer-render",
+      gst_audio_visualizer_render_thread_func, scope);
+}
+
+static void
+gst_audio_visualizer_stop_render_thread (GstAudioVisualizer * scope)
+{
+  GstAudioVisualizerPrivate *priv = scope->priv;
+  RenderJob *job;
+
+  if (priv->render_thread == NULL)
+    return;
+
+  g_mutex_lock (&priv->render_lock);
+  priv->render_stop = TRUE;
+  g_cond_broadcast (&priv->render_cond);
+  g_mutex_unlock (&priv->render_lock);
+
+  g_thread_join (priv->render_thread);
+  priv->render_thread = NULL;
+
+  while ((job = g_queue_pop_head (&priv->render_jobs)))
+    render_job_free (job);
+}
+
+/* Waits until the render thread has processed all queued frames. Called
+ * from the streaming thread before anything the render thread depends on
+ * changes (caps, EOS, shutdown). */
+static void
+gst_audio_visualizer_drain_render_queue (GstAudioVisualizer * scope)
+{
+  GstAudioVisualizerPrivate *priv = scope->priv;
+
+  if (priv->render_thread == NULL)
+    return;
+
+  g_mutex_lock (&priv->render_lock);
+  while ((!g_queue_is_empty (&priv->render_jobs) || priv->render_busy)
+      && !priv->render_stop)
+    g_cond_wait (&priv->render_cond, &priv->render_lock);
+  g_mutex_unlock (&priv->render_lock);
+}
+
 static GstFlowReturn
 gst_audio_visualizer_chain (GstPad * pad, GstObject * parent,
     GstBuffer * buffer)
 {
   GstFlowReturn ret = GST_FLOW_OK;
   GstAudioVisualizer *scope;
-  GstAudioVisualizerClass *klass;
   GstBuffer *inbuf;
   guint64 dist, ts;
   guint avail, sbpf;
@@ -1040,7 +1412,6 @@ gst_audio_visualizer_chain (GstPad * pad, GstObject * parent,
   gint bpf, rate;
 
   scope = GST_AUDIO_VISUALIZER (parent);
-  klass = GST_AUDIO_VISUALIZER_CLASS (G_OBJECT_GET_CLASS (scope));
 
   GST_LOG_OBJECT (scope, "chainfunc called");
 
@@ -1080,9 +1451,6 @@ gst_audio_visualizer_chain (GstPad * pad, GstObject * parent,
   avail = gst_adapter_available (scope->priv->adapter);
   GST_LOG_OBJECT (scope, "avail: %u, bpf: %u", avail, sbpf);
   while (avail >= sbpf) {
-    GstBuffer *outbuf;
-    GstVideoFrame outframe;
-
     /* get timestamp of the current adapter content */
     ts = gst_adapter_prev_pts (scope->priv->adapter, &dist);
     if (GST_CLOCK_TIME_IS_VALID (ts)) {
@@ -1130,65 +1498,51 @@ gst_audio_visualizer_chain (GstPad * pad, GstObject * parent,
 
     ++scope->priv->processed;
 
-    g_mutex_unlock (&scope->priv->config_lock);
-    ret = default_prepare_output_buffer (scope, &outbuf);
-    g_mutex_lock (&scope->priv->config_lock);
-    /* recheck as the value could have changed */
-    sbpf = scope->req_spf * bpf;
-
-    /* no buffer allocated, we don't care why. */
-    if (ret != GST_FLOW_OK)
-      break;
-
-    /* sync controlled properties */
-    if (GST_CLOCK_TIME_IS_VALID (ts))
-      gst_object_sync_values (GST_OBJECT (scope), ts);
-
-    GST_BUFFER_PTS (outbuf) = ts;
-    GST_BUFFER_DURATION (outbuf) = scope->priv->frame_duration;
-
     /* this can fail as the data size we need could have changed */
     if (!(adata = (gpointer) gst_adapter_map (scope->priv->adapter, sbpf)))
       break;
 
-    gst_video_frame_map (&outframe, &scope->vinfo, outbuf, GST_MAP_READWRITE);
-
-    if (scope->priv->shader) {
-      gst_video_frame_copy (&outframe, &scope->priv->tempframe);
-    } else {
-      /* gst_video_frame_clear() or is output frame already cleared */
-      gint i;
-
-      for (i = 0; i < scope->vinfo.finfo->n_planes; i++) {
-        memset (outframe.data[i], 0, outframe.map[i].size);
+    if (scope->priv->render_thread) {
+      RenderJob *job;
+
+      /* the adapter window overlaps between frames, so hand the render
+       * thread its own copy of the audio data */
+      job = g_slice_new (RenderJob);
+      job->audio = gst_buffer_new_allocate (NULL, sbpf, NULL);
+      gst_buffer_fill (job->audio, 0, adata, sbpf);
+      gst_buffer_copy_into (job->audio, inbuf, GST_BUFFER_COPY_METADATA, 0,
+          -1);
+      job->ts = ts;
+
+      g_mutex_unlock (&scope->priv->config_lock);
+
+      g_mutex_lock (&scope->priv->render_lock);
+      /* block until there is room in the queue, this throttles us to the
+       * speed of the render thread without queueing up the whole stream */
+      while (g_queue_get_length (&scope->priv->render_jobs) >=
+          MAX_RENDER_JOBS && !scope->priv->render_flushing
+          && !scope->priv->render_stop)
+        g_cond_wait (&scope->priv->render_cond, &scope->priv->render_lock);
+      ret = scope->priv->render_ret;
+      if (ret == GST_FLOW_OK && !scope->priv->render_flushing
+          && !scope->priv->render_stop) {
+        g_queue_push_tail (&scope->priv->render_jobs, job);
+        g_cond_broadcast (&scope->priv->render_cond);
+      } else {
+        render_job_free (job);
       }
-    }
+      g_mutex_unlock (&scope->priv->render_lock);
 
-    gst_buffer_replace_all_memory (inbuf,
-        gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, adata, sbpf, 0,
-            sbpf, NULL, NULL));
+      g_mutex_lock (&scope->priv->config_lock);
+    } else {
+      gst_buffer_replace_all_memory (inbuf,
+          gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, adata, sbpf, 0,
+              sbpf, NULL, NULL));
 
-    /* call class->render() vmethod */
-    if (klass->render) {
-      if (!klass->render (scope, inbuf, &outframe)) {
-        ret = GST_FLOW_ERROR;
-        gst_video_frame_unmap (&outframe);
-        goto beach;
-      } else {
-        /* run various post processing (shading and geometric transformation) */
-        /* FIXME: SHADER assumes 32bpp */
-        if (scope->priv->shader &&
-            GST_VIDEO_INFO_COMP_PSTRIDE (&scope->vinfo, 0) == 4) {
-          scope->priv->shader (scope, &outframe, &scope->priv->tempframe);
-        }
-      }
+      g_mutex_unlock (&scope->priv->config_lock);
+      ret = gst_audio_visualizer_render_frame (scope, inbuf, ts);
+      g_mutex_lock (&scope->priv->config_lock);
     }
-    gst_video_frame_unmap (&outframe);
-
-    g_mutex_unlock (&scope->priv->config_lock);
-    ret = gst_pad_push (scope->priv->srcpad, outbuf);
-    outbuf = NULL;
-    g_mutex_lock (&scope->priv->config_lock);
 
   skip:
     /* recheck as the value could have changed */
@@ -1288,10 +1642,33 @@ gst_audio_visualizer_sink_event (GstPad * pad, GstObject * parent,
       gst_event_unref (event);
       break;
     }
+    case GST_EVENT_FLUSH_START:
+      if (scope->priv->render_thread) {
+        /* unblock the chain function and drop all queued frames */
+        g_mutex_lock (&scope->priv->render_lock);
+        scope->priv->render_flushing = TRUE;
+        g_cond_broadcast (&scope->priv->render_cond);
+        g_mutex_unlock (&scope->priv->render_lock);
+      }
+      res = gst_pad_event_default (pad, parent, event);
+      break;
     case GST_EVENT_FLUSH_STOP:
+      if (scope->priv->render_thread) {
+        gst_audio_visualizer_drain_render_queue (scope);
+        g_mutex_lock (&scope->priv->render_lock);
+        scope->priv->render_flushing = FALSE;
+        scope->priv->render_ret = GST_FLOW_OK;
+        g_mutex_unlock (&scope->priv->render_lock);
+      }
       gst_audio_visualizer_reset (scope);
       res = gst_pad_push_event (scope->priv->srcpad, event);
       break;
+    case GST_EVENT_EOS:
+      /* make sure all pending frames have been pushed before the EOS
+       * is forwarded */
+      gst_audio_visualizer_drain_render_queue (scope);
+      res = gst_pad_event_default (pad, parent, event);
+      break;
     case GST_EVENT_SEGMENT:
     {
       /* the newsegment values are used to clip the input samples
@@ -1381,6 +1758,7 @@ gst_audio_visualizer_change_state (GstElement * element,
   switch (transition) {
     case GST_STATE_CHANGE_READY_TO_PAUSED:
       gst_audio_visualizer_reset (scope);
+      gst_audio_visualizer_start_render_thread (scope);
       break;
     default:
       break;
@@ -1390,6 +1768,7 @@ gst_audio_visualizer_change_state (GstElement * element,
 
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      gst_audio_visualizer_stop_render_thread (scope);
       gst_audio_visualizer_set_allocation (scope, NULL, NULL, NULL, NULL);
       break;
     case GST_STATE_CHANGE_READY_TO_NULL:
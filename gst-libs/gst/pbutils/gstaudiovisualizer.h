@@ -103,5 +103,9 @@ struct _GstAudioVisualizerClass
 GST_EXPORT
 GType gst_audio_visualizer_get_type (void);
 
+GST_EXPORT
+void gst_audio_visualizer_set_dirty_region (GstAudioVisualizer * scope,
+                                            gint y, gint height);
+
 G_END_DECLS
 #endif /* __GST_AUDIO_VISUALIZER_H__ */
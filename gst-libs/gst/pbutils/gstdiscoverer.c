@@ -50,6 +50,8 @@
 
 #include <string.h>
 
+#include <glib/gstdio.h>
+
 #include "pbutils.h"
 #include "pbutils-private.h"
 
@@ -77,6 +79,15 @@ typedef struct
   gchar *stream_id;
 } PrivateStream;
 
+/* A child discoverer used for concurrent discovery, see
+ * gst_discoverer_set_concurrency() */
+typedef struct
+{
+  GstDiscoverer *parent;
+  GstDiscoverer *dc;
+  gboolean busy;
+} DiscovererWorker;
+
 struct _GstDiscovererPrivate
 {
   gboolean async;
@@ -95,6 +106,20 @@ struct _GstDiscovererPrivate
   /* TRUE if discoverer has been started */
   gboolean running;
 
+  /* maximum number of parallel discoveries in async mode */
+  guint concurrency;
+
+  /* child discoverers, only non-NULL while started with concurrency > 1 */
+  GPtrArray *workers;
+
+  /* TRUE if autoplugging should stop at parsed streams instead of
+   * plugging decoders, see gst_discoverer_set_quick_scan() */
+  gboolean quick_scan;
+
+  /* TRUE if discovery results of local files should be cached on disk,
+   * see gst_discoverer_set_use_cache() */
+  gboolean use_cache;
+
   /* current items */
   GstDiscovererInfo *current_info;
   GError *current_error;
@@ -133,6 +158,7 @@ struct _GstDiscovererPrivate
   gulong no_more_pads_id;
   gulong source_chg_id;
   gulong element_added_id;
+  gulong autoplug_cont_id;
   gulong bus_cb_id;
 };
 
@@ -302,6 +328,31 @@ uridecodebin_element_added_cb (GstElement * uridecodebin,
   }
 }
 
+static gboolean
+uridecodebin_autoplug_continue_cb (GstElement * uridecodebin, GstPad * pad,
+    GstCaps * caps, GstDiscoverer * dc)
+{
+  GstStructure *st;
+  gboolean complete = FALSE;
+
+  if (!dc->priv->quick_scan)
+    return TRUE;
+
+  if (gst_caps_get_size (caps) < 1)
+    return TRUE;
+
+  /* In quick-scan mode we stop autoplugging as soon as a parser delivers
+   * complete frames, so the stream gets exposed with its parsed caps
+   * instead of a decoder being plugged */
+  st = gst_caps_get_structure (caps, 0);
+  if (gst_structure_get_boolean (st, "parsed", &complete) && complete)
+    return FALSE;
+  if (gst_structure_get_boolean (st, "framed", &complete) && complete)
+    return FALSE;
+
+  return TRUE;
+}
+
 static void
 gst_discoverer_init (GstDiscoverer * dc)
 {
@@ -313,6 +364,7 @@ gst_discoverer_init (GstDiscoverer * dc)
 
   dc->priv->timeout = DEFAULT_PROP_TIMEOUT;
   dc->priv->async = FALSE;
+  dc->priv->concurrency = 1;
 
   g_mutex_init (&dc->priv->lock);
 
@@ -346,6 +398,9 @@ gst_discoverer_init (GstDiscoverer * dc)
   dc->priv->source_chg_id =
       g_signal_connect_object (dc->priv->uridecodebin, "notify::source",
       G_CALLBACK (uridecodebin_source_changed_cb), dc, 0);
+  dc->priv->autoplug_cont_id =
+      g_signal_connect_object (dc->priv->uridecodebin, "autoplug-continue",
+      G_CALLBACK (uridecodebin_autoplug_continue_cb), dc, 0);
 
   GST_LOG_OBJECT (dc, "Getting pipeline bus");
   dc->priv->bus = gst_pipeline_get_bus ((GstPipeline *) dc->priv->pipeline);
@@ -407,6 +462,7 @@ gst_discoverer_dispose (GObject * obj)
     DISCONNECT_SIGNAL (dc->priv->uridecodebin, dc->priv->no_more_pads_id);
     DISCONNECT_SIGNAL (dc->priv->uridecodebin, dc->priv->source_chg_id);
     DISCONNECT_SIGNAL (dc->priv->uridecodebin, dc->priv->element_added_id);
+    DISCONNECT_SIGNAL (dc->priv->uridecodebin, dc->priv->autoplug_cont_id);
     DISCONNECT_SIGNAL (dc->priv->bus, dc->priv->bus_cb_id);
 
     /* pipeline was set to NULL in _reset */
@@ -2097,6 +2153,254 @@ out:
   return sinfo;
 }
 
+/* Concurrent discovery.
+ *
+ * The discovery engine itself is strictly serial: one internal pipeline
+ * that processes one URI at a time. When a concurrency higher than 1 is
+ * requested, the discoverer becomes a dispatcher over that many child
+ * discoverers, each running the proven serial engine with its own pipeline
+ * and timeout, and re-emits their signals as its own. */
+
+static void gst_discoverer_dispatch_pending (GstDiscoverer * dc);
+
+static void
+worker_discovered_cb (GstDiscoverer * child, GstDiscovererInfo * info,
+    GError * error, DiscovererWorker * worker)
+{
+  GstDiscoverer *dc = worker->parent;
+  gchar *uri = NULL;
+
+  g_signal_emit (dc, gst_discoverer_signals[SIGNAL_DISCOVERED], 0, info,
+      error);
+
+  /* feed the child the next URI while it is still processing; its cleanup
+   * will then move on to it without going through an idle round-trip */
+  DISCO_LOCK (dc);
+  if (dc->priv->running && dc->priv->pending_uris != NULL) {
+    uri = dc->priv->pending_uris->data;
+    dc->priv->pending_uris =
+        g_list_delete_link (dc->priv->pending_uris, dc->priv->pending_uris);
+  }
+  DISCO_UNLOCK (dc);
+
+  if (uri) {
+    DISCO_LOCK (worker->dc);
+    worker->dc->priv->pending_uris =
+        g_list_append (worker->dc->priv->pending_uris, uri);
+    DISCO_UNLOCK (worker->dc);
+  }
+}
+
+static void
+worker_finished_cb (GstDiscoverer * child, DiscovererWorker * worker)
+{
+  GstDiscoverer *dc = worker->parent;
+  gboolean done = TRUE;
+  guint i;
+
+  DISCO_LOCK (dc);
+  worker->busy = FALSE;
+  if (dc->priv->pending_uris != NULL || !dc->priv->running)
+    done = FALSE;
+  else {
+    for (i = 0; i < dc->priv->workers->len; i++) {
+      DiscovererWorker *w = g_ptr_array_index (dc->priv->workers, i);
+
+      if (w->busy) {
+        done = FALSE;
+        break;
+      }
+    }
+  }
+  DISCO_UNLOCK (dc);
+
+  if (done)
+    g_signal_emit (dc, gst_discoverer_signals[SIGNAL_FINISHED], 0);
+  else
+    gst_discoverer_dispatch_pending (dc);
+}
+
+static void
+worker_source_setup_cb (GstDiscoverer * child, GstElement * source,
+    DiscovererWorker * worker)
+{
+  g_signal_emit (worker->parent, gst_discoverer_signals[SIGNAL_SOURCE_SETUP],
+      0, source);
+}
+
+/* Hands pending URIs to idle workers, one each; the workers keep themselves
+ * fed from worker_discovered_cb() afterwards */
+static void
+gst_discoverer_dispatch_pending (GstDiscoverer * dc)
+{
+  guint i;
+
+  for (i = 0; i < dc->priv->workers->len; i++) {
+    DiscovererWorker *worker = g_ptr_array_index (dc->priv->workers, i);
+    gchar *uri;
+
+    DISCO_LOCK (dc);
+    if (dc->priv->pending_uris == NULL) {
+      DISCO_UNLOCK (dc);
+      break;
+    }
+    if (worker->busy) {
+      DISCO_UNLOCK (dc);
+      continue;
+    }
+    uri = dc->priv->pending_uris->data;
+    dc->priv->pending_uris =
+        g_list_delete_link (dc->priv->pending_uris, dc->priv->pending_uris);
+    worker->busy = TRUE;
+    DISCO_UNLOCK (dc);
+
+    gst_discoverer_discover_uri_async (worker->dc, uri);
+    g_free (uri);
+  }
+}
+
+static gboolean
+gst_discoverer_setup_workers (GstDiscoverer * dc)
+{
+  guint i;
+
+  dc->priv->workers = g_ptr_array_new ();
+
+  for (i = 0; i < dc->priv->concurrency; i++) {
+    DiscovererWorker *worker;
+    GstDiscoverer *child;
+
+    child = gst_discoverer_new (dc->priv->timeout, NULL);
+    if (child == NULL)
+      return FALSE;
+    child->priv->quick_scan = dc->priv->quick_scan;
+
+    worker = g_slice_new0 (DiscovererWorker);
+    worker->parent = dc;
+    worker->dc = child;
+
+    g_signal_connect (child, "discovered",
+        G_CALLBACK (worker_discovered_cb), worker);
+    g_signal_connect (child, "finished",
+        G_CALLBACK (worker_finished_cb), worker);
+    g_signal_connect (child, "source-setup",
+        G_CALLBACK (worker_source_setup_cb), worker);
+
+    g_ptr_array_add (dc->priv->workers, worker);
+
+    gst_discoverer_start (child);
+  }
+
+  return TRUE;
+}
+
+static void
+gst_discoverer_teardown_workers (GstDiscoverer * dc)
+{
+  guint i;
+
+  for (i = 0; i < dc->priv->workers->len; i++) {
+    DiscovererWorker *worker = g_ptr_array_index (dc->priv->workers, i);
+
+    g_signal_handlers_disconnect_by_data (worker->dc, worker);
+    gst_discoverer_stop (worker->dc);
+    g_object_unref (worker->dc);
+    g_slice_free (DiscovererWorker, worker);
+  }
+  g_ptr_array_free (dc->priv->workers, TRUE);
+  dc->priv->workers = NULL;
+}
+
+/**
+ * gst_discoverer_set_concurrency:
+ * @discoverer: A #GstDiscoverer
+ * @concurrency: maximum number of URIs discovered in parallel, minimum 1
+ *
+ * Sets how many URIs may be discovered in parallel in asynchronous mode.
+ * With the default of 1 the pending URIs are processed strictly serially.
+ * With higher values up to @concurrency internal discovery pipelines run
+ * concurrently, each with its own timeout, which speeds up scanning large
+ * URI collections considerably. The 'discovered' signal is emitted once
+ * per URI as usual, but not necessarily in the order the URIs were added.
+ *
+ * Can not be changed while @discoverer is started; set it before calling
+ * gst_discoverer_start().
+ *
+ * Since: 1.14
+ */
+void
+gst_discoverer_set_concurrency (GstDiscoverer * discoverer, guint concurrency)
+{
+  g_return_if_fail (GST_IS_DISCOVERER (discoverer));
+  g_return_if_fail (concurrency >= 1);
+  g_return_if_fail (!discoverer->priv->async);
+
+  discoverer->priv->concurrency = concurrency;
+}
+
+/**
+ * gst_discoverer_get_concurrency:
+ * @discoverer: A #GstDiscoverer
+ *
+ * Returns: the maximum number of URIs discovered in parallel, see
+ * gst_discoverer_set_concurrency().
+ *
+ * Since: 1.14
+ */
+guint
+gst_discoverer_get_concurrency (GstDiscoverer * discoverer)
+{
+  g_return_val_if_fail (GST_IS_DISCOVERER (discoverer), 0);
+
+  return discoverer->priv->concurrency;
+}
+
+/**
+ * gst_discoverer_set_quick_scan:
+ * @discoverer: A #GstDiscoverer
+ * @quick_scan: whether to only scan stream headers
+ *
+ * When @quick_scan is %TRUE, discovery stops plugging elements once
+ * parsers have delivered complete frames, instead of decoding the
+ * streams all the way to raw audio and video. The caps, duration and
+ * tags of each stream are still reported, but fields that can only be
+ * determined by decoding (such as the depth of video streams behind a
+ * decoder) may be missing. This is considerably faster than a full
+ * discovery and is useful to quickly validate large collections of
+ * URIs.
+ *
+ * Streams for which no parser is available are still decoded as in a
+ * normal discovery.
+ *
+ * Takes effect on the next URI being discovered.
+ *
+ * Since: 1.14
+ */
+void
+gst_discoverer_set_quick_scan (GstDiscoverer * discoverer, gboolean quick_scan)
+{
+  g_return_if_fail (GST_IS_DISCOVERER (discoverer));
+
+  discoverer->priv->quick_scan = quick_scan;
+}
+
+/**
+ * gst_discoverer_get_quick_scan:
+ * @discoverer: A #GstDiscoverer
+ *
+ * Returns: %TRUE if discovery stops at parsed streams, see
+ * gst_discoverer_set_quick_scan().
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_discoverer_get_quick_scan (GstDiscoverer * discoverer)
+{
+  g_return_val_if_fail (GST_IS_DISCOVERER (discoverer), FALSE);
+
+  return discoverer->priv->quick_scan;
+}
+
 /**
  * gst_discoverer_start:
  * @discoverer: A #GstDiscoverer
@@ -2123,6 +2427,32 @@ gst_discoverer_start (GstDiscoverer * discoverer)
   discoverer->priv->async = TRUE;
   discoverer->priv->running = TRUE;
 
+  if (discoverer->priv->concurrency > 1) {
+    gboolean have_pending;
+
+    /* Concurrent mode : the child discoverers do the actual work on their
+     * own bus watches, we only dispatch the pending URIs to them */
+    if (!gst_discoverer_setup_workers (discoverer)) {
+      GST_ERROR_OBJECT (discoverer, "Failed to create child discoverers");
+      gst_discoverer_teardown_workers (discoverer);
+      discoverer->priv->running = FALSE;
+      discoverer->priv->async = FALSE;
+      return;
+    }
+
+    DISCO_LOCK (discoverer);
+    have_pending = (discoverer->priv->pending_uris != NULL);
+    DISCO_UNLOCK (discoverer);
+
+    if (have_pending) {
+      g_signal_emit (discoverer, gst_discoverer_signals[SIGNAL_STARTING], 0);
+      gst_discoverer_dispatch_pending (discoverer);
+    }
+    GST_DEBUG_OBJECT (discoverer, "Started with %u workers",
+        discoverer->priv->workers->len);
+    return;
+  }
+
   ctx = g_main_context_get_thread_default ();
 
   /* Connect to bus signals */
@@ -2160,6 +2490,19 @@ gst_discoverer_stop (GstDiscoverer * discoverer)
     return;
   }
 
+  if (discoverer->priv->workers) {
+    DISCO_LOCK (discoverer);
+    discoverer->priv->running = FALSE;
+    DISCO_UNLOCK (discoverer);
+
+    gst_discoverer_teardown_workers (discoverer);
+    discoverer_reset (discoverer);
+    discoverer->priv->async = FALSE;
+
+    GST_DEBUG_OBJECT (discoverer, "Stopped");
+    return;
+  }
+
   DISCO_LOCK (discoverer);
   if (discoverer->priv->processing) {
     /* We prevent any further processing by setting the bus to
@@ -2221,6 +2564,34 @@ gst_discoverer_discover_uri_async (GstDiscoverer * discoverer,
 
   GST_DEBUG_OBJECT (discoverer, "uri : %s", uri);
 
+  if (discoverer->priv->workers) {
+    gboolean was_idle = TRUE;
+    guint i;
+
+    DISCO_LOCK (discoverer);
+    if (discoverer->priv->pending_uris != NULL)
+      was_idle = FALSE;
+    else {
+      for (i = 0; i < discoverer->priv->workers->len; i++) {
+        DiscovererWorker *w = g_ptr_array_index (discoverer->priv->workers, i);
+
+        if (w->busy) {
+          was_idle = FALSE;
+          break;
+        }
+      }
+    }
+    discoverer->priv->pending_uris =
+        g_list_append (discoverer->priv->pending_uris, g_strdup (uri));
+    DISCO_UNLOCK (discoverer);
+
+    if (was_idle)
+      g_signal_emit (discoverer, gst_discoverer_signals[SIGNAL_STARTING], 0);
+    gst_discoverer_dispatch_pending (discoverer);
+
+    return TRUE;
+  }
+
   DISCO_LOCK (discoverer);
   can_run = (discoverer->priv->pending_uris == NULL);
   discoverer->priv->pending_uris =
@@ -2234,6 +2605,139 @@ gst_discoverer_discover_uri_async (GstDiscoverer * discoverer,
 }
 
 
+/* On-disk cache of discovery results */
+
+static gchar *
+_serialized_info_path (const gchar * uri)
+{
+  gchar *location, *key, *checksum, *path;
+  GStatBuf buf;
+
+  /* Only local files have a well-defined identity to key the cache on */
+  location = g_filename_from_uri (uri, NULL, NULL);
+  if (location == NULL)
+    return NULL;
+
+  if (g_stat (location, &buf) < 0) {
+    g_free (location);
+    return NULL;
+  }
+  g_free (location);
+
+  /* Key on (uri, size, mtime) so that modified files are re-scanned */
+  key = g_strdup_printf ("%s-%" G_GUINT64_FORMAT "-%" G_GINT64_FORMAT, uri,
+      (guint64) buf.st_size, (gint64) buf.st_mtime);
+  checksum = g_compute_checksum_for_string (G_CHECKSUM_SHA256, key, -1);
+  g_free (key);
+
+  path = g_build_filename (g_get_user_cache_dir (), "gstreamer-1.0",
+      "discoverer", checksum, NULL);
+  g_free (checksum);
+
+  return path;
+}
+
+static GstDiscovererInfo *
+_load_serialized_info (GstDiscoverer * dc, const gchar * uri)
+{
+  GstDiscovererInfo *info = NULL;
+  gchar *path, *data;
+  gsize length;
+
+  path = _serialized_info_path (uri);
+  if (path == NULL)
+    return NULL;
+
+  if (g_file_get_contents (path, &data, &length, NULL)) {
+    GVariant *variant;
+
+    variant = g_variant_new_from_data (G_VARIANT_TYPE ("v"), data, length,
+        TRUE, (GDestroyNotify) g_free, data);
+    g_variant_ref_sink (variant);
+    info = gst_discoverer_info_from_variant (variant);
+    g_variant_unref (variant);
+
+    GST_INFO_OBJECT (dc, "Read serialized info for %s from %s", uri, path);
+  }
+  g_free (path);
+
+  return info;
+}
+
+static void
+_save_serialized_info (GstDiscoverer * dc, GstDiscovererInfo * info)
+{
+  GVariant *variant;
+  gchar *path, *dir;
+
+  /* Only successful discoveries are worth keeping */
+  if (gst_discoverer_info_get_result (info) != GST_DISCOVERER_OK)
+    return;
+
+  path = _serialized_info_path (info->uri);
+  if (path == NULL)
+    return;
+
+  dir = g_path_get_dirname (path);
+  g_mkdir_with_parents (dir, 0777);
+  g_free (dir);
+
+  variant = gst_discoverer_info_to_variant (info,
+      GST_DISCOVERER_SERIALIZE_ALL);
+  if (variant) {
+    g_variant_ref_sink (variant);
+    g_file_set_contents (path, g_variant_get_data (variant),
+        g_variant_get_size (variant), NULL);
+    g_variant_unref (variant);
+
+    GST_INFO_OBJECT (dc, "Wrote serialized info for %s to %s", info->uri,
+        path);
+  }
+  g_free (path);
+}
+
+/**
+ * gst_discoverer_set_use_cache:
+ * @discoverer: A #GstDiscoverer
+ * @use_cache: whether to use an on-disk cache of discovery results
+ *
+ * When @use_cache is %TRUE, gst_discoverer_discover_uri() first looks up
+ * local file URIs in an on-disk cache below the user cache directory and
+ * returns the stored result without constructing a pipeline when the file
+ * is unchanged. Cache entries are keyed on the URI together with the file
+ * size and modification time, so modified files are always re-scanned.
+ * Successful discoveries are added to the cache, serialized with
+ * gst_discoverer_info_to_variant().
+ *
+ * Non-local URIs are never cached.
+ *
+ * Since: 1.14
+ */
+void
+gst_discoverer_set_use_cache (GstDiscoverer * discoverer, gboolean use_cache)
+{
+  g_return_if_fail (GST_IS_DISCOVERER (discoverer));
+
+  discoverer->priv->use_cache = use_cache;
+}
+
+/**
+ * gst_discoverer_get_use_cache:
+ * @discoverer: A #GstDiscoverer
+ *
+ * Returns: %TRUE if discovery results are cached on disk, see
+ * gst_discoverer_set_use_cache().
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_discoverer_get_use_cache (GstDiscoverer * discoverer)
+{
+  g_return_val_if_fail (GST_IS_DISCOVERER (discoverer), FALSE);
+
+  return discoverer->priv->use_cache;
+}
+
 /* Synchronous mode */
 /**
  * gst_discoverer_discover_uri:
@@ -2261,6 +2765,15 @@ gst_discoverer_discover_uri (GstDiscoverer * discoverer, const gchar * uri,
 
   GST_DEBUG_OBJECT (discoverer, "uri:%s", uri);
 
+  if (discoverer->priv->use_cache) {
+    info = _load_serialized_info (discoverer, uri);
+    if (info) {
+      if (err)
+        *err = NULL;
+      return info;
+    }
+  }
+
   DISCO_LOCK (discoverer);
   if (G_UNLIKELY (discoverer->priv->current_info)) {
     DISCO_UNLOCK (discoverer);
@@ -2294,6 +2807,9 @@ gst_discoverer_discover_uri (GstDiscoverer * discoverer, const gchar * uri,
 
   discoverer_cleanup (discoverer);
 
+  if (discoverer->priv->use_cache && info)
+    _save_serialized_info (discoverer, info);
+
   return info;
 }
 
@@ -385,6 +385,27 @@ GstDiscoverer *gst_discoverer_new (GstClockTime timeout, GError **err);
 
 /* Asynchronous API */
 
+GST_EXPORT
+void           gst_discoverer_set_concurrency (GstDiscoverer *discoverer,
+                                               guint concurrency);
+
+GST_EXPORT
+guint          gst_discoverer_get_concurrency (GstDiscoverer *discoverer);
+
+GST_EXPORT
+void           gst_discoverer_set_quick_scan (GstDiscoverer *discoverer,
+                                              gboolean quick_scan);
+
+GST_EXPORT
+gboolean       gst_discoverer_get_quick_scan (GstDiscoverer *discoverer);
+
+GST_EXPORT
+void           gst_discoverer_set_use_cache (GstDiscoverer *discoverer,
+                                             gboolean use_cache);
+
+GST_EXPORT
+gboolean       gst_discoverer_get_use_cache (GstDiscoverer *discoverer);
+
 GST_EXPORT
 void           gst_discoverer_start (GstDiscoverer *discoverer);
 
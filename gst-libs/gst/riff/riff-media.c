@@ -34,6 +34,89 @@
 GST_DEBUG_CATEGORY_EXTERN (riff_debug);
 #define GST_CAT_DEFAULT riff_debug
 
+/* process-wide cache of fully constructed video caps, keyed by the raw bytes
+ * of all the inputs the construction depends on. Demuxers opening many files
+ * that share the same handful of codec configurations then get their caps
+ * with a hash lookup and a caps copy instead of rerunning the fourcc switch.
+ * The cached caps are reference copies that are never handed out directly,
+ * so callers keep receiving writable caps as before */
+typedef struct
+{
+  GstCaps *caps;
+  gchar *codec_name;
+} RiffCapsCacheEntry;
+
+static GMutex riff_caps_cache_lock;
+static GHashTable *riff_caps_cache; /* GBytes -> RiffCapsCacheEntry */
+
+#define RIFF_CAPS_CACHE_MAX_ENTRIES 64
+/* headers or extra data larger than this bypass the cache */
+#define RIFF_CAPS_CACHE_MAX_EXTRA 4096
+
+static void
+riff_caps_cache_entry_free (gpointer data)
+{
+  RiffCapsCacheEntry *entry = data;
+
+  gst_caps_unref (entry->caps);
+  g_free (entry->codec_name);
+  g_free (entry);
+}
+
+static void
+riff_caps_cache_key_append_buffer (GByteArray * key, GstBuffer * buffer)
+{
+  GstMapInfo map;
+  guint32 size;
+
+  if (gst_buffer_map (buffer, &map, GST_MAP_READ)) {
+    size = map.size;
+    g_byte_array_append (key, (guint8 *) & size, sizeof (size));
+    g_byte_array_append (key, map.data, map.size);
+    gst_buffer_unmap (buffer, &map);
+  }
+}
+
+/* build the lookup key for a video caps construction, or return NULL when
+ * the inputs are too large to be worth caching */
+static GBytes *
+riff_video_caps_cache_key (guint32 codec_fcc, gst_riff_strh * strh,
+    gst_riff_strf_vids * strf, GstBuffer * strf_data, GstBuffer * strd_data)
+{
+  GByteArray *key;
+  gsize strf_size = 0;
+  guint8 present;
+
+  if (strf != NULL) {
+    /* strf may carry extra data beyond the struct, within strf->size */
+    strf_size = MAX (sizeof (gst_riff_strf_vids), (gsize) strf->size);
+    if (strf_size > RIFF_CAPS_CACHE_MAX_EXTRA)
+      return NULL;
+  }
+  if (strf_data && gst_buffer_get_size (strf_data) > RIFF_CAPS_CACHE_MAX_EXTRA)
+    return NULL;
+  if (strd_data && gst_buffer_get_size (strd_data) > RIFF_CAPS_CACHE_MAX_EXTRA)
+    return NULL;
+
+  key = g_byte_array_sized_new (128);
+
+  g_byte_array_append (key, (guint8 *) & codec_fcc, sizeof (codec_fcc));
+  present = (strh ? 1 : 0) | (strf ? 2 : 0) | (strf_data ? 4 : 0) |
+      (strd_data ? 8 : 0);
+  g_byte_array_append (key, &present, 1);
+
+  if (strh)
+    g_byte_array_append (key, (guint8 *) strh, sizeof (gst_riff_strh));
+  if (strf)
+    g_byte_array_append (key, (guint8 *) strf, strf_size);
+  if (strf_data)
+    riff_caps_cache_key_append_buffer (key, strf_data);
+  if (strd_data)
+    riff_caps_cache_key_append_buffer (key, strd_data);
+
+  return g_byte_array_free_to_bytes (key);
+}
+
 /**
  * gst_riff_create_video_caps:
  * @codec_fcc: fourCC codec for this codec.
@@ -48,8 +131,8 @@ GST_DEBUG_CATEGORY_EXTERN (riff_debug);
  * @codec_name: if given, will be filled with a human-readable codec name.
  */
 
-GstCaps *
-gst_riff_create_video_caps (guint32 codec_fcc,
+static GstCaps *
+gst_riff_create_video_caps_internal (guint32 codec_fcc,
     gst_riff_strh * strh, gst_riff_strf_vids * strf,
     GstBuffer * strf_data, GstBuffer * strd_data, char **codec_name)
 {
@@ -1003,6 +1086,69 @@ gst_riff_create_video_caps (guint32 codec_fcc,
   return caps;
 }
 
+GstCaps *
+gst_riff_create_video_caps (guint32 codec_fcc,
+    gst_riff_strh * strh, gst_riff_strf_vids * strf,
+    GstBuffer * strf_data, GstBuffer * strd_data, char **codec_name)
+{
+  RiffCapsCacheEntry *entry;
+  GstCaps *caps;
+  gchar *name = NULL;
+  GBytes *key;
+
+  key = riff_video_caps_cache_key (codec_fcc, strh, strf, strf_data,
+      strd_data);
+  if (key == NULL)
+    return gst_riff_create_video_caps_internal (codec_fcc, strh, strf,
+        strf_data, strd_data, codec_name);
+
+  g_mutex_lock (&riff_caps_cache_lock);
+  if (riff_caps_cache != NULL &&
+      (entry = g_hash_table_lookup (riff_caps_cache, key))) {
+    GST_LOG ("using cached caps for video fourcc %" GST_FOURCC_FORMAT,
+        GST_FOURCC_ARGS (codec_fcc));
+    caps = gst_caps_copy (entry->caps);
+    if (codec_name)
+      *codec_name = g_strdup (entry->codec_name);
+    g_mutex_unlock (&riff_caps_cache_lock);
+    g_bytes_unref (key);
+    return caps;
+  }
+  g_mutex_unlock (&riff_caps_cache_lock);
+
+  /* always ask for the codec name so the cache entry can serve callers
+   * that want it later */
+  caps = gst_riff_create_video_caps_internal (codec_fcc, strh, strf,
+      strf_data, strd_data, &name);
+  if (caps == NULL) {
+    g_bytes_unref (key);
+    g_free (name);
+    return NULL;
+  }
+
+  g_mutex_lock (&riff_caps_cache_lock);
+  if (riff_caps_cache == NULL)
+    riff_caps_cache = g_hash_table_new_full ((GHashFunc) g_bytes_hash,
+        (GEqualFunc) g_bytes_equal, (GDestroyNotify) g_bytes_unref,
+        riff_caps_cache_entry_free);
+  if (g_hash_table_size (riff_caps_cache) < RIFF_CAPS_CACHE_MAX_ENTRIES &&
+      !g_hash_table_contains (riff_caps_cache, key)) {
+    entry = g_new (RiffCapsCacheEntry, 1);
+    entry->caps = gst_caps_copy (caps);
+    entry->codec_name = g_strdup (name);
+    g_hash_table_insert (riff_caps_cache, g_bytes_ref (key), entry);
+  }
+  g_mutex_unlock (&riff_caps_cache_lock);
+  g_bytes_unref (key);
+
+  if (codec_name)
+    *codec_name = name;
+  else
+    g_free (name);
+
+  return caps;
+}
+
 static const struct
 {
   const guint32 ms_mask;
@@ -111,22 +111,26 @@ too_small:
 }
 
 /**
- * gst_riff_parse_chunk:
+ * gst_riff_parse_chunk_info:
  * @element: caller element (used for debugging).
  * @buf: input buffer.
  * @offset: offset in the buffer in the caller. Is incremented
  *          by the read size by this function.
- * @fourcc: fourcc (returned by this function0 of the chunk.
- * @chunk_data: buffer (returned by the function) containing the
- *              chunk data, which may be NULL if chunksize == 0
+ * @fourcc: fourcc (returned by this function) of the chunk.
+ * @size: size (returned by this function) of the chunk data,
+ *        which starts 8 bytes after the original offset.
  *
- * Reads a single chunk.
+ * Reads the header of a single chunk without creating a sub-buffer
+ * for its data. The data of the chunk can be found 8 bytes after the
+ * offset that was passed in.
  *
  * Returns: FALSE on error, TRUE otherwise
+ *
+ * Since: 1.14
  */
 gboolean
-gst_riff_parse_chunk (GstElement * element, GstBuffer * buf,
-    guint * _offset, guint32 * _fourcc, GstBuffer ** chunk_data)
+gst_riff_parse_chunk_info (GstElement * element, GstBuffer * buf,
+    guint * _offset, guint32 * _fourcc, guint * _size)
 {
   guint size, bufsize;
   guint32 fourcc;
@@ -138,10 +142,10 @@ gst_riff_parse_chunk (GstElement * element, GstBuffer * buf,
   g_return_val_if_fail (buf != NULL, FALSE);
   g_return_val_if_fail (_offset != NULL, FALSE);
   g_return_val_if_fail (_fourcc != NULL, FALSE);
-  g_return_val_if_fail (chunk_data != NULL, FALSE);
+  g_return_val_if_fail (_size != NULL, FALSE);
 
-  *chunk_data = NULL;
   *_fourcc = 0;
+  *_size = 0;
 
   bufsize = gst_buffer_get_size (buf);
 
@@ -172,13 +176,8 @@ gst_riff_parse_chunk (GstElement * element, GstBuffer * buf,
     size = bufsize - 8 - offset;
   }
 
-  if (size)
-    *chunk_data =
-        gst_buffer_copy_region (buf, GST_BUFFER_COPY_ALL, offset + 8, size);
-  else
-    *chunk_data = NULL;
-
   *_fourcc = fourcc;
+  *_size = size;
   *_offset += 8 + GST_ROUND_UP_2 (size);
 
   return TRUE;
@@ -203,6 +202,93 @@ bogus_size:
   }
 }
 
+/**
+ * gst_riff_parse_chunk:
+ * @element: caller element (used for debugging).
+ * @buf: input buffer.
+ * @offset: offset in the buffer in the caller. Is incremented
+ *          by the read size by this function.
+ * @fourcc: fourcc (returned by this function0 of the chunk.
+ * @chunk_data: buffer (returned by the function) containing the
+ *              chunk data, which may be NULL if chunksize == 0
+ *
+ * Reads a single chunk.
+ *
+ * Returns: FALSE on error, TRUE otherwise
+ */
+gboolean
+gst_riff_parse_chunk (GstElement * element, GstBuffer * buf,
+    guint * _offset, guint32 * _fourcc, GstBuffer ** chunk_data)
+{
+  guint offset = *_offset;
+  guint size;
+
+  g_return_val_if_fail (chunk_data != NULL, FALSE);
+
+  *chunk_data = NULL;
+
+  if (!gst_riff_parse_chunk_info (element, buf, _offset, _fourcc, &size))
+    return FALSE;
+
+  if (size)
+    *chunk_data =
+        gst_buffer_copy_region (buf, GST_BUFFER_COPY_ALL, offset + 8, size);
+
+  return TRUE;
+}
+
+/**
+ * gst_riff_parse_chunk_index:
+ * @element: caller element (used for debugging).
+ * @buf: input buffer.
+ * @offset: offset in the buffer to start indexing from.
+ *
+ * Walks the chunks in @buf once and builds an index of their location.
+ * LIST chunks are recorded as a single entry covering their whole
+ * contents; to index inside a LIST, call this function again with the
+ * offset of the LIST data plus 4 bytes for the list type.
+ *
+ * The index can be used to locate chunks of interest directly instead
+ * of re-walking the headers, e.g. when remuxing large RIFF trees.
+ *
+ * Returns: (transfer full) (element-type GstRiffChunkEntry): a newly
+ *     allocated array of #GstRiffChunkEntry, free with g_array_unref(),
+ *     or NULL if no chunk could be parsed at @offset.
+ *
+ * Since: 1.14
+ */
+GArray *
+gst_riff_parse_chunk_index (GstElement * element, GstBuffer * buf,
+    guint offset)
+{
+  GArray *index;
+  guint32 fourcc;
+  guint size;
+
+  g_return_val_if_fail (element != NULL, NULL);
+  g_return_val_if_fail (buf != NULL, NULL);
+
+  index = g_array_new (FALSE, FALSE, sizeof (GstRiffChunkEntry));
+
+  while (gst_riff_parse_chunk_info (element, buf, &offset, &fourcc, &size)) {
+    GstRiffChunkEntry entry;
+
+    entry.fourcc = fourcc;
+    entry.offset = offset - (8 + GST_ROUND_UP_2 (size));
+    entry.size = size;
+    g_array_append_val (index, entry);
+  }
+
+  if (index->len == 0) {
+    g_array_unref (index);
+    return NULL;
+  }
+
+  GST_DEBUG_OBJECT (element, "indexed %u chunks", index->len);
+
+  return index;
+}
+
 /**
  * gst_riff_parse_file_header:
  * @element: caller element (used for debugging/error).
@@ -47,6 +47,22 @@ GstFlowReturn gst_riff_read_chunk   (GstElement * element,
  * by the function.
  */
 
+/**
+ * GstRiffChunkEntry:
+ * @fourcc: the fourcc of the chunk
+ * @offset: byte offset of the chunk header from the start of the buffer
+ * @size: size in bytes of the chunk data, which starts 8 bytes after @offset
+ *
+ * One entry of a chunk index built by gst_riff_parse_chunk_index().
+ *
+ * Since: 1.14
+ */
+typedef struct {
+  guint32 fourcc;
+  guint64 offset;
+  guint   size;
+} GstRiffChunkEntry;
+
 GST_EXPORT
 gboolean gst_riff_parse_chunk       (GstElement * element,
                                      GstBuffer  * buf,
@@ -54,6 +70,18 @@ gboolean gst_riff_parse_chunk       (GstElement * element,
                                      guint32    * fourcc,
                                      GstBuffer ** chunk_data);
 
+GST_EXPORT
+gboolean gst_riff_parse_chunk_info  (GstElement * element,
+                                     GstBuffer  * buf,
+                                     guint      * offset,
+                                     guint32    * fourcc,
+                                     guint      * size);
+
+GST_EXPORT
+GArray * gst_riff_parse_chunk_index (GstElement * element,
+                                     GstBuffer  * buf,
+                                     guint        offset);
+
 GST_EXPORT
 gboolean gst_riff_parse_file_header (GstElement * element,
                                      GstBuffer  * buf,
@@ -243,6 +243,76 @@ gst_rtcp_buffer_validate_reduced (GstBuffer * buffer)
   return res;
 }
 
+/**
+ * gst_rtcp_buffer_validate_data_trusted:
+ * @data: (array length=len): the data to validate
+ * @len: the length of @data to validate
+ *
+ * Cheap sanity check of @data: only the length, the version of the first
+ * packet and that the first packet fits in @len are verified, the
+ * individual packets are not walked. This is enough to safely use the
+ * accessor functions of this module on packets that come from a trusted
+ * source, such as another element in the same pipeline; packets from the
+ * network should always go through gst_rtcp_buffer_validate_data() or
+ * gst_rtcp_buffer_validate_data_reduced() instead.
+ *
+ * Returns: TRUE if the data passes the reduced validation.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_rtcp_buffer_validate_data_trusted (guint8 * data, guint len)
+{
+  g_return_val_if_fail (data != NULL, FALSE);
+
+  if (G_UNLIKELY (len < 4))
+    goto wrong_length;
+  if (G_UNLIKELY ((data[0] & 0xc0) != (GST_RTCP_VERSION << 6)))
+    goto wrong_version;
+  if (G_UNLIKELY (((guint) GST_READ_UINT16_BE (data + 2) + 1) * 4 > len))
+    goto wrong_length;
+
+  return TRUE;
+
+  /* ERRORS */
+wrong_length:
+  {
+    GST_DEBUG ("len check failed");
+    return FALSE;
+  }
+wrong_version:
+  {
+    GST_DEBUG ("wrong version (%d < 2)", data[0] >> 6);
+    return FALSE;
+  }
+}
+
+/**
+ * gst_rtcp_buffer_validate_trusted:
+ * @buffer: the buffer to validate
+ *
+ * Check if the data pointed to by @buffer looks like an RTCP packet using
+ * the reduced checks of gst_rtcp_buffer_validate_data_trusted().
+ *
+ * Returns: TRUE if @buffer passes the reduced validation.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_rtcp_buffer_validate_trusted (GstBuffer * buffer)
+{
+  gboolean res;
+  GstMapInfo map;
+
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), FALSE);
+
+  gst_buffer_map (buffer, &map, GST_MAP_READ);
+  res = gst_rtcp_buffer_validate_data_trusted (map.data, map.size);
+  gst_buffer_unmap (buffer, &map);
+
+  return res;
+}
+
 /**
  * gst_rtcp_buffer_validate:
  * @buffer: the buffer to validate
@@ -618,6 +688,237 @@ gst_rtcp_packet_remove (GstRTCPPacket * packet)
   return ret;
 }
 
+/**
+ * gst_rtcp_writer_init:
+ * @rtcp: a writable mapped RTCP buffer
+ * @writer: a #GstRTCPWriter to initialize
+ *
+ * Initialize @writer for appending packets to @rtcp. In contrast to
+ * gst_rtcp_buffer_add_packet() and the per-item functions, which locate
+ * insertion points and shuffle existing data around, the writer only ever
+ * appends: a packet is opened with gst_rtcp_writer_begin_packet(), its
+ * payload is written once with gst_rtcp_writer_reserve(),
+ * gst_rtcp_writer_write_data() or gst_rtcp_writer_write_uint32(), and the
+ * length and count fields in the header are patched when the packet is
+ * closed with gst_rtcp_writer_end_packet(). Writing starts after any
+ * packets already in @rtcp; gst_rtcp_buffer_unmap() finishes the compound
+ * packet as usual.
+ *
+ * Returns: %TRUE if @writer could be initialized.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_rtcp_writer_init (GstRTCPBuffer * rtcp, GstRTCPWriter * writer)
+{
+  g_return_val_if_fail (rtcp != NULL, FALSE);
+  g_return_val_if_fail (GST_IS_BUFFER (rtcp->buffer), FALSE);
+  g_return_val_if_fail (rtcp->map.flags & GST_MAP_WRITE, FALSE);
+  g_return_val_if_fail (writer != NULL, FALSE);
+
+  writer->rtcp = rtcp;
+  /* map.size tracks the bytes used by previously added packets */
+  writer->offset = rtcp->map.size;
+  writer->packet_start = 0;
+  writer->in_packet = FALSE;
+
+  return TRUE;
+}
+
+/**
+ * gst_rtcp_writer_begin_packet:
+ * @writer: a #GstRTCPWriter
+ * @type: the #GstRTCPType of the new packet
+ *
+ * Open a new packet of @type at the current write position. The length and
+ * count fields of the header are left at 0 and patched by
+ * gst_rtcp_writer_end_packet().
+ *
+ * Returns: %FALSE if the buffer has no room for another header.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_rtcp_writer_begin_packet (GstRTCPWriter * writer, GstRTCPType type)
+{
+  guint8 *data;
+
+  g_return_val_if_fail (writer != NULL, FALSE);
+  g_return_val_if_fail (writer->rtcp != NULL, FALSE);
+  g_return_val_if_fail (type != GST_RTCP_TYPE_INVALID, FALSE);
+  g_return_val_if_fail (!writer->in_packet, FALSE);
+
+  if (writer->offset + 4 > writer->rtcp->map.maxsize)
+    return FALSE;
+
+  data = writer->rtcp->map.data + writer->offset;
+  data[0] = (GST_RTCP_VERSION << 6);
+  data[1] = type;
+  data[2] = 0;
+  data[3] = 0;
+
+  writer->packet_start = writer->offset;
+  writer->offset += 4;
+  writer->in_packet = TRUE;
+
+  return TRUE;
+}
+
+/**
+ * gst_rtcp_writer_reserve:
+ * @writer: a #GstRTCPWriter
+ * @size: the number of bytes to claim
+ *
+ * Claim @size bytes in the open packet and return a pointer to the region,
+ * so callers can fill in report blocks or SDES entries directly without an
+ * intermediate copy.
+ *
+ * Returns: (nullable): a pointer to the claimed region, or %NULL if the
+ * buffer is full.
+ *
+ * Since: 1.14
+ */
+guint8 *
+gst_rtcp_writer_reserve (GstRTCPWriter * writer, guint size)
+{
+  guint8 *data;
+
+  g_return_val_if_fail (writer != NULL, NULL);
+  g_return_val_if_fail (writer->rtcp != NULL, NULL);
+  g_return_val_if_fail (writer->in_packet, NULL);
+
+  if (writer->offset + size > writer->rtcp->map.maxsize)
+    return NULL;
+
+  data = writer->rtcp->map.data + writer->offset;
+  writer->offset += size;
+
+  return data;
+}
+
+/**
+ * gst_rtcp_writer_write_data:
+ * @writer: a #GstRTCPWriter
+ * @data: the bytes to append
+ * @size: the number of bytes to append
+ *
+ * Append @size bytes to the open packet.
+ *
+ * Returns: %FALSE if the buffer is full.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_rtcp_writer_write_data (GstRTCPWriter * writer, gconstpointer data,
+    guint size)
+{
+  guint8 *dest;
+
+  dest = gst_rtcp_writer_reserve (writer, size);
+  if (dest == NULL)
+    return FALSE;
+
+  memcpy (dest, data, size);
+
+  return TRUE;
+}
+
+/**
+ * gst_rtcp_writer_write_uint32:
+ * @writer: a #GstRTCPWriter
+ * @value: the value to append
+ *
+ * Append @value in network byte order to the open packet.
+ *
+ * Returns: %FALSE if the buffer is full.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_rtcp_writer_write_uint32 (GstRTCPWriter * writer, guint32 value)
+{
+  guint8 *dest;
+
+  dest = gst_rtcp_writer_reserve (writer, 4);
+  if (dest == NULL)
+    return FALSE;
+
+  GST_WRITE_UINT32_BE (dest, value);
+
+  return TRUE;
+}
+
+/**
+ * gst_rtcp_writer_end_packet:
+ * @writer: a #GstRTCPWriter
+ * @count: the count field for the packet header, e.g. the number of report
+ *   blocks or SDES items written
+ *
+ * Close the packet opened with gst_rtcp_writer_begin_packet(). The payload
+ * is zero-padded to a 32-bit boundary and the length and count fields of
+ * the header are patched in.
+ *
+ * Returns: %FALSE if the padding did not fit in the buffer.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_rtcp_writer_end_packet (GstRTCPWriter * writer, guint count)
+{
+  guint8 *data;
+  guint len, pad;
+
+  g_return_val_if_fail (writer != NULL, FALSE);
+  g_return_val_if_fail (writer->rtcp != NULL, FALSE);
+  g_return_val_if_fail (writer->in_packet, FALSE);
+  g_return_val_if_fail (count <= 0x1f, FALSE);
+
+  /* align the packet to a 32-bit boundary */
+  pad = (4 - ((writer->offset - writer->packet_start) & 3)) & 3;
+  if (pad > 0) {
+    if (writer->offset + pad > writer->rtcp->map.maxsize)
+      return FALSE;
+    memset (writer->rtcp->map.data + writer->offset, 0, pad);
+    writer->offset += pad;
+  }
+
+  data = writer->rtcp->map.data + writer->packet_start;
+  data[0] = (data[0] & 0xe0) | count;
+
+  /* length is stored in multiples of 32 bit words minus the length of the
+   * header */
+  len = ((writer->offset - writer->packet_start) >> 2) - 1;
+  data[2] = len >> 8;
+  data[3] = len & 0xff;
+
+  writer->rtcp->map.size = writer->offset;
+  writer->in_packet = FALSE;
+
+  return TRUE;
+}
+
+/**
+ * gst_rtcp_writer_abort_packet:
+ * @writer: a #GstRTCPWriter
+ *
+ * Discard the packet opened with gst_rtcp_writer_begin_packet(), e.g. when
+ * a region could not be reserved because the buffer is full. The write
+ * position moves back to where the packet started.
+ *
+ * Since: 1.14
+ */
+void
+gst_rtcp_writer_abort_packet (GstRTCPWriter * writer)
+{
+  g_return_if_fail (writer != NULL);
+
+  if (!writer->in_packet)
+    return;
+
+  writer->offset = writer->packet_start;
+  writer->in_packet = FALSE;
+}
+
 /**
  * gst_rtcp_packet_get_padding:
  * @packet: a valid #GstRTCPPacket
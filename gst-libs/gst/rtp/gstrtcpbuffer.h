@@ -220,6 +220,29 @@ struct _GstRTCPPacket
   guint          entry_offset; /* current entry offset for navigating SDES items */
 };
 
+typedef struct _GstRTCPWriter GstRTCPWriter;
+
+/**
+ * GstRTCPWriter:
+ * @rtcp: the mapped RTCP buffer being written to
+ * @offset: current append offset in the buffer data
+ *
+ * Append-only builder for compound RTCP packets, see
+ * gst_rtcp_writer_init(). The size of the structure is made public to
+ * allow stack allocations.
+ *
+ * Since: 1.14
+ */
+struct _GstRTCPWriter
+{
+  GstRTCPBuffer *rtcp;
+  guint          offset;
+
+  /*< private >*/
+  guint          packet_start; /* header offset of the open packet */
+  gboolean       in_packet;    /* between begin_packet and end_packet */
+};
+
 /* creating buffers */
 
 GST_EXPORT
@@ -240,6 +263,12 @@ gboolean        gst_rtcp_buffer_validate_data_reduced   (guint8 *data, guint len
 GST_EXPORT
 gboolean        gst_rtcp_buffer_validate_reduced        (GstBuffer *buffer);
 
+GST_EXPORT
+gboolean        gst_rtcp_buffer_validate_data_trusted   (guint8 *data, guint len);
+
+GST_EXPORT
+gboolean        gst_rtcp_buffer_validate_trusted        (GstBuffer *buffer);
+
 
 GST_EXPORT
 GstBuffer*      gst_rtcp_buffer_new               (guint mtu);
@@ -268,6 +297,29 @@ gboolean        gst_rtcp_buffer_add_packet        (GstRTCPBuffer *rtcp, GstRTCPT
 GST_EXPORT
 gboolean        gst_rtcp_packet_remove            (GstRTCPPacket *packet);
 
+/* append-only building of compound packets */
+
+GST_EXPORT
+gboolean        gst_rtcp_writer_init              (GstRTCPBuffer *rtcp, GstRTCPWriter *writer);
+
+GST_EXPORT
+gboolean        gst_rtcp_writer_begin_packet      (GstRTCPWriter *writer, GstRTCPType type);
+
+GST_EXPORT
+guint8 *        gst_rtcp_writer_reserve           (GstRTCPWriter *writer, guint size);
+
+GST_EXPORT
+gboolean        gst_rtcp_writer_write_data        (GstRTCPWriter *writer, gconstpointer data, guint size);
+
+GST_EXPORT
+gboolean        gst_rtcp_writer_write_uint32      (GstRTCPWriter *writer, guint32 value);
+
+GST_EXPORT
+gboolean        gst_rtcp_writer_end_packet        (GstRTCPWriter *writer, guint count);
+
+GST_EXPORT
+void            gst_rtcp_writer_abort_packet      (GstRTCPWriter *writer);
+
 /* working with packets */
 
 GST_EXPORT
@@ -26,6 +26,8 @@
  * Provides a base class for RTP depayloaders
  */
 
+#include <string.h>
+
 #include "gstrtpbasedepayload.h"
 
 GST_DEBUG_CATEGORY_STATIC (rtpbasedepayload_debug);
@@ -56,6 +58,13 @@ struct _GstRTPBaseDepayloadPrivate
 
   GstCaps *last_caps;
   GstEvent *segment_event;
+
+  /* slab reassembly arena, only set between reassembly_begin and take.
+   * The slab stays mapped for writing while packets are copied in and is
+   * handed out zero-copy when the frame is complete. */
+  GstMemory *reassembly_mem;
+  GstMapInfo reassembly_map;
+  gsize reassembly_used;
 };
 
 /* Filter signals and args */
@@ -221,6 +230,8 @@ gst_rtp_base_depayload_init (GstRTPBaseDepayload * filter,
 static void
 gst_rtp_base_depayload_finalize (GObject * object)
 {
+  gst_rtp_base_depayload_reassembly_abort (GST_RTP_BASE_DEPAYLOAD (object));
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -818,6 +829,196 @@ gst_rtp_base_depayload_push_list (GstRTPBaseDepayload * filter,
   return res;
 }
 
+/**
+ * gst_rtp_base_depayload_reassembly_begin:
+ * @filter: a #GstRTPBaseDepayload
+ * @expected_size: the expected size of the reassembled frame in bytes
+ *
+ * Start reassembling a frame into a preallocated slab of @expected_size
+ * bytes. Packet payloads are appended to the slab with
+ * gst_rtp_base_depayload_reassembly_write() and the finished frame is
+ * taken as a single zero-copy buffer with
+ * gst_rtp_base_depayload_reassembly_take(), so depayloading a fragmented
+ * frame costs one allocation instead of one per packet. The slab grows
+ * automatically when more data than @expected_size arrives.
+ *
+ * A previously started but not yet taken frame is discarded. This
+ * function must be called from the streaming thread.
+ *
+ * Returns: %TRUE if the slab could be allocated.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_rtp_base_depayload_reassembly_begin (GstRTPBaseDepayload * filter,
+    gsize expected_size)
+{
+  GstRTPBaseDepayloadPrivate *priv;
+  GstMemory *mem;
+
+  g_return_val_if_fail (GST_IS_RTP_BASE_DEPAYLOAD (filter), FALSE);
+  g_return_val_if_fail (expected_size > 0, FALSE);
+
+  priv = filter->priv;
+
+  gst_rtp_base_depayload_reassembly_abort (filter);
+
+  mem = gst_allocator_alloc (NULL, expected_size, NULL);
+  if (G_UNLIKELY (mem == NULL))
+    return FALSE;
+
+  if (G_UNLIKELY (!gst_memory_map (mem, &priv->reassembly_map, GST_MAP_WRITE))) {
+    gst_memory_unref (mem);
+    return FALSE;
+  }
+
+  priv->reassembly_mem = mem;
+  priv->reassembly_used = 0;
+
+  GST_LOG_OBJECT (filter, "started reassembly into %" G_GSIZE_FORMAT
+      " byte slab", expected_size);
+
+  return TRUE;
+}
+
+/**
+ * gst_rtp_base_depayload_reassembly_write:
+ * @filter: a #GstRTPBaseDepayload
+ * @data: the payload data to append
+ * @size: the number of bytes to append
+ *
+ * Append @size bytes of packet payload to the reassembly slab started with
+ * gst_rtp_base_depayload_reassembly_begin(). If the slab is too small it
+ * is grown, which costs one reallocation and copy.
+ *
+ * Returns: %FALSE if no reassembly was started or the slab could not be
+ * grown.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_rtp_base_depayload_reassembly_write (GstRTPBaseDepayload * filter,
+    gconstpointer data, gsize size)
+{
+  GstRTPBaseDepayloadPrivate *priv;
+
+  g_return_val_if_fail (GST_IS_RTP_BASE_DEPAYLOAD (filter), FALSE);
+
+  priv = filter->priv;
+
+  if (G_UNLIKELY (priv->reassembly_mem == NULL))
+    return FALSE;
+
+  if (G_UNLIKELY (priv->reassembly_used + size > priv->reassembly_map.size)) {
+    GstMemory *mem;
+    GstMapInfo map;
+    gsize new_size;
+
+    /* subclass underestimated the frame size, grow the slab */
+    new_size = MAX (2 * priv->reassembly_map.size,
+        priv->reassembly_used + size);
+
+    GST_DEBUG_OBJECT (filter, "growing reassembly slab from %" G_GSIZE_FORMAT
+        " to %" G_GSIZE_FORMAT " bytes", priv->reassembly_map.size, new_size);
+
+    mem = gst_allocator_alloc (NULL, new_size, NULL);
+    if (G_UNLIKELY (mem == NULL))
+      return FALSE;
+
+    if (G_UNLIKELY (!gst_memory_map (mem, &map, GST_MAP_WRITE))) {
+      gst_memory_unref (mem);
+      return FALSE;
+    }
+
+    memcpy (map.data, priv->reassembly_map.data, priv->reassembly_used);
+
+    gst_memory_unmap (priv->reassembly_mem, &priv->reassembly_map);
+    gst_memory_unref (priv->reassembly_mem);
+    priv->reassembly_mem = mem;
+    priv->reassembly_map = map;
+  }
+
+  memcpy (priv->reassembly_map.data + priv->reassembly_used, data, size);
+  priv->reassembly_used += size;
+
+  return TRUE;
+}
+
+/**
+ * gst_rtp_base_depayload_reassembly_take:
+ * @filter: a #GstRTPBaseDepayload
+ *
+ * Finish the reassembly started with
+ * gst_rtp_base_depayload_reassembly_begin() and return the frame as a
+ * single buffer wrapping the slab, without copying the data. The buffer
+ * is typically returned from the subclass process function or pushed with
+ * gst_rtp_base_depayload_push().
+ *
+ * Returns: (transfer full) (nullable): a #GstBuffer with the reassembled
+ * frame, or %NULL if no reassembly was started.
+ *
+ * Since: 1.14
+ */
+GstBuffer *
+gst_rtp_base_depayload_reassembly_take (GstRTPBaseDepayload * filter)
+{
+  GstRTPBaseDepayloadPrivate *priv;
+  GstBuffer *buffer;
+
+  g_return_val_if_fail (GST_IS_RTP_BASE_DEPAYLOAD (filter), NULL);
+
+  priv = filter->priv;
+
+  if (G_UNLIKELY (priv->reassembly_mem == NULL))
+    return NULL;
+
+  gst_memory_unmap (priv->reassembly_mem, &priv->reassembly_map);
+
+  if (priv->reassembly_used < priv->reassembly_map.size)
+    gst_memory_resize (priv->reassembly_mem, 0, priv->reassembly_used);
+
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer, priv->reassembly_mem);
+  priv->reassembly_mem = NULL;
+  priv->reassembly_used = 0;
+
+  GST_LOG_OBJECT (filter, "took reassembled frame of %" G_GSIZE_FORMAT
+      " bytes", gst_buffer_get_size (buffer));
+
+  return buffer;
+}
+
+/**
+ * gst_rtp_base_depayload_reassembly_abort:
+ * @filter: a #GstRTPBaseDepayload
+ *
+ * Discard a partially reassembled frame, e.g. when a discont makes the
+ * data collected so far useless. Does nothing when no reassembly was
+ * started.
+ *
+ * Since: 1.14
+ */
+void
+gst_rtp_base_depayload_reassembly_abort (GstRTPBaseDepayload * filter)
+{
+  GstRTPBaseDepayloadPrivate *priv;
+
+  g_return_if_fail (GST_IS_RTP_BASE_DEPAYLOAD (filter));
+
+  priv = filter->priv;
+
+  if (priv->reassembly_mem == NULL)
+    return;
+
+  GST_LOG_OBJECT (filter, "dropping partial frame of %" G_GSIZE_FORMAT
+      " bytes", priv->reassembly_used);
+
+  gst_memory_unmap (priv->reassembly_mem, &priv->reassembly_map);
+  gst_memory_unref (priv->reassembly_mem);
+  priv->reassembly_mem = NULL;
+  priv->reassembly_used = 0;
+}
+
 /* convert the PacketLost event from a jitterbuffer to a GAP event.
  * subclasses can override this.  */
 static gboolean
@@ -886,6 +1087,7 @@ gst_rtp_base_depayload_change_state (GstElement * element,
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_caps_replace (&priv->last_caps, NULL);
       gst_event_replace (&priv->segment_event, NULL);
+      gst_rtp_base_depayload_reassembly_abort (filter);
       break;
     case GST_STATE_CHANGE_READY_TO_NULL:
       break;
@@ -123,6 +123,18 @@ GstFlowReturn   gst_rtp_base_depayload_push       (GstRTPBaseDepayload *filter,
 GST_EXPORT
 GstFlowReturn   gst_rtp_base_depayload_push_list  (GstRTPBaseDepayload *filter, GstBufferList *out_list);
 
+GST_EXPORT
+gboolean        gst_rtp_base_depayload_reassembly_begin (GstRTPBaseDepayload *filter, gsize expected_size);
+
+GST_EXPORT
+gboolean        gst_rtp_base_depayload_reassembly_write (GstRTPBaseDepayload *filter, gconstpointer data, gsize size);
+
+GST_EXPORT
+GstBuffer *     gst_rtp_base_depayload_reassembly_take  (GstRTPBaseDepayload *filter);
+
+GST_EXPORT
+void            gst_rtp_base_depayload_reassembly_abort (GstRTPBaseDepayload *filter);
+
 
 #ifdef G_DEFINE_AUTOPTR_CLEANUP_FUNC
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstRTPBaseDepayload, gst_object_unref)
@@ -62,6 +62,12 @@ struct _GstRTPBasePayloadPrivate
 
   GstCaps *subclass_srccaps;
   GstCaps *sinkcaps;
+
+  /* when aggregating, packets pushed from handle_buffer are collected in
+   * pending_list and pushed downstream as one buffer list per input buffer */
+  gboolean aggregate;
+  gboolean aggregating;
+  GstBufferList *pending_list;
 };
 
 /* RTPBasePayload signals and args */
@@ -139,6 +145,9 @@ static GstStateChangeReturn gst_rtp_base_payload_change_state (GstElement *
 
 static gboolean gst_rtp_base_payload_negotiate (GstRTPBasePayload * payload);
 
+static GstFlowReturn gst_rtp_base_payload_flush_pending (GstRTPBasePayload *
+    payload, GstFlowReturn ret);
+
 
 static GstElementClass *parent_class = NULL;
 
@@ -373,6 +382,11 @@ gst_rtp_base_payload_finalize (GObject * object)
   gst_caps_replace (&rtpbasepayload->priv->subclass_srccaps, NULL);
   gst_caps_replace (&rtpbasepayload->priv->sinkcaps, NULL);
 
+  if (rtpbasepayload->priv->pending_list) {
+    gst_buffer_list_unref (rtpbasepayload->priv->pending_list);
+    rtpbasepayload->priv->pending_list = NULL;
+  }
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -634,8 +648,16 @@ gst_rtp_base_payload_chain (GstPad * pad, GstObject * parent,
     }
   }
 
+  if (rtpbasepayload->priv->aggregate)
+    rtpbasepayload->priv->aggregating = TRUE;
+
   ret = rtpbasepayload_class->handle_buffer (rtpbasepayload, buffer);
 
+  if (rtpbasepayload->priv->aggregating) {
+    rtpbasepayload->priv->aggregating = FALSE;
+    ret = gst_rtp_base_payload_flush_pending (rtpbasepayload, ret);
+  }
+
   return ret;
 
   /* ERRORS */
@@ -1274,6 +1296,82 @@ no_rate:
   }
 }
 
+/* Push the buffer list that was collected while the subclass was payloading
+ * one input buffer. Called from the streaming thread when handle_buffer
+ * returns. An error from the subclass drops what was collected. */
+static GstFlowReturn
+gst_rtp_base_payload_flush_pending (GstRTPBasePayload * payload,
+    GstFlowReturn ret)
+{
+  GstBufferList *list = payload->priv->pending_list;
+
+  payload->priv->pending_list = NULL;
+
+  if (list == NULL)
+    return ret;
+
+  if (G_UNLIKELY (ret != GST_FLOW_OK)) {
+    gst_buffer_list_unref (list);
+    return ret;
+  }
+
+  GST_LOG_OBJECT (payload, "pushing list of %u aggregated packets",
+      gst_buffer_list_length (list));
+
+  if (G_UNLIKELY (payload->priv->pending_segment)) {
+    gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
+    payload->priv->pending_segment = FALSE;
+    payload->priv->delay_segment = FALSE;
+  }
+
+  return gst_pad_push_list (payload->srcpad, list);
+}
+
+/**
+ * gst_rtp_base_payload_set_aggregate_packets:
+ * @payload: a #GstRTPBasePayload
+ * @aggregate: if packets should be aggregated into one buffer list
+ *
+ * Enable or disable packet aggregation. When enabled, all packets pushed
+ * with gst_rtp_base_payload_push() or gst_rtp_base_payload_push_list()
+ * while the subclass payloads one input buffer are collected into a single
+ * #GstBufferList that is pushed downstream once per input buffer, so the
+ * per-packet pad push overhead is paid per frame and sinks like udpsink
+ * can batch their syscalls. The SSRC, payload type, seqnum and timestamp
+ * of each packet are updated exactly as for immediate pushes.
+ *
+ * Subclasses typically call this once from their init function.
+ *
+ * Since: 1.14
+ */
+void
+gst_rtp_base_payload_set_aggregate_packets (GstRTPBasePayload * payload,
+    gboolean aggregate)
+{
+  g_return_if_fail (GST_IS_RTP_BASE_PAYLOAD (payload));
+
+  payload->priv->aggregate = aggregate;
+}
+
+/**
+ * gst_rtp_base_payload_get_aggregate_packets:
+ * @payload: a #GstRTPBasePayload
+ *
+ * Queries whether packets are aggregated into one buffer list per input
+ * buffer, see gst_rtp_base_payload_set_aggregate_packets().
+ *
+ * Returns: %TRUE if packet aggregation is enabled.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_rtp_base_payload_get_aggregate_packets (GstRTPBasePayload * payload)
+{
+  g_return_val_if_fail (GST_IS_RTP_BASE_PAYLOAD (payload), FALSE);
+
+  return payload->priv->aggregate;
+}
+
 /**
  * gst_rtp_base_payload_push_list:
  * @payload: a #GstRTPBasePayload
@@ -1295,6 +1393,17 @@ gst_rtp_base_payload_push_list (GstRTPBasePayload * payload,
   res = gst_rtp_base_payload_prepare_push (payload, list, TRUE);
 
   if (G_LIKELY (res == GST_FLOW_OK)) {
+    if (G_UNLIKELY (payload->priv->aggregating)) {
+      guint i, len = gst_buffer_list_length (list);
+
+      if (payload->priv->pending_list == NULL)
+        payload->priv->pending_list = gst_buffer_list_new ();
+      for (i = 0; i < len; i++)
+        gst_buffer_list_add (payload->priv->pending_list,
+            gst_buffer_ref (gst_buffer_list_get (list, i)));
+      gst_buffer_list_unref (list);
+      return GST_FLOW_OK;
+    }
     if (G_UNLIKELY (payload->priv->pending_segment)) {
       gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
       payload->priv->pending_segment = FALSE;
@@ -1328,6 +1437,12 @@ gst_rtp_base_payload_push (GstRTPBasePayload * payload, GstBuffer * buffer)
   res = gst_rtp_base_payload_prepare_push (payload, buffer, FALSE);
 
   if (G_LIKELY (res == GST_FLOW_OK)) {
+    if (G_UNLIKELY (payload->priv->aggregating)) {
+      if (payload->priv->pending_list == NULL)
+        payload->priv->pending_list = gst_buffer_list_new ();
+      gst_buffer_list_add (payload->priv->pending_list, buffer);
+      return GST_FLOW_OK;
+    }
     if (G_UNLIKELY (payload->priv->pending_segment)) {
       gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
       payload->priv->pending_segment = FALSE;
@@ -1535,6 +1650,11 @@ gst_rtp_base_payload_change_state (GstElement * element,
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_event_replace (&rtpbasepayload->priv->pending_segment, NULL);
+      priv->aggregating = FALSE;
+      if (priv->pending_list) {
+        gst_buffer_list_unref (priv->pending_list);
+        priv->pending_list = NULL;
+      }
       break;
     default:
       break;
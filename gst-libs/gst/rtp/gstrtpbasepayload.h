@@ -171,6 +171,13 @@ GST_EXPORT
 GstFlowReturn   gst_rtp_base_payload_push_list          (GstRTPBasePayload *payload,
                                                          GstBufferList *list);
 
+GST_EXPORT
+void            gst_rtp_base_payload_set_aggregate_packets (GstRTPBasePayload *payload,
+                                                            gboolean aggregate);
+
+GST_EXPORT
+gboolean        gst_rtp_base_payload_get_aggregate_packets (GstRTPBasePayload *payload);
+
 #ifdef G_DEFINE_AUTOPTR_CLEANUP_FUNC
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstRTPBasePayload, gst_object_unref)
 #endif
@@ -343,17 +343,20 @@ gst_rtp_buffer_map (GstBuffer * buffer, GstMapFlags flags, GstRTPBuffer * rtp)
   if (G_UNLIKELY (size < header_len))
     goto wrong_length;
 
-  /* check version */
-  version = (data[0] & 0xc0);
-  if (G_UNLIKELY (version != (GST_RTP_VERSION << 6)))
-    goto wrong_version;
-
-  /* check reserved PT and marker bit, this is to check for RTCP
-   * packets. We do a relaxed check, you can still use 72-76 as long
-   * as the marker bit is cleared. */
-  pt = data[1];
-  if (G_UNLIKELY (pt >= 200 && pt <= 204))
-    goto reserved_pt;
+  /* trusted buffers only get the length sanity checks */
+  if ((flags & GST_RTP_BUFFER_MAP_FLAG_TRUSTED) == 0) {
+    /* check version */
+    version = (data[0] & 0xc0);
+    if (G_UNLIKELY (version != (GST_RTP_VERSION << 6)))
+      goto wrong_version;
+
+    /* check reserved PT and marker bit, this is to check for RTCP
+     * packets. We do a relaxed check, you can still use 72-76 as long
+     * as the marker bit is cleared. */
+    pt = data[1];
+    if (G_UNLIKELY (pt >= 200 && pt <= 204))
+      goto reserved_pt;
+  }
 
   /* calc header length with csrc */
   csrc_count = (data[0] & 0x0f);
@@ -1446,6 +1449,141 @@ gst_rtp_buffer_get_extension_twobytes_header (GstRTPBuffer * rtp,
   return FALSE;
 }
 
+/**
+ * gst_rtp_buffer_parse_extensions:
+ * @rtp: the RTP packet
+ * @index: (out caller-allocates): a #GstRTPHeaderExtensionIndex to fill
+ *
+ * Parses all RFC 5285 style header extensions of @rtp in one pass and
+ * stores their id, size and data location in @index. Both one byte and
+ * two bytes style headers are recognized.
+ *
+ * This is cheaper than calling
+ * gst_rtp_buffer_get_extension_onebyte_header() for every extension id
+ * of interest, which rescans the extension block per call; reading the
+ * extensions of a packet becomes one pass and zero allocations. The data
+ * pointers in @index stay valid as long as @rtp is mapped.
+ *
+ * At most #GST_RTP_BUFFER_MAX_EXTENSION_ENTRIES extensions are indexed,
+ * any further ones are ignored.
+ *
+ * Returns: TRUE if @rtp had a header extension block that could be parsed
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_rtp_buffer_parse_extensions (GstRTPBuffer * rtp,
+    GstRTPHeaderExtensionIndex * index)
+{
+  guint16 bits;
+  guint8 *pdata;
+  guint wordlen;
+  guint bytelen;
+  gulong offset = 0;
+  gboolean onebyte;
+
+  g_return_val_if_fail (rtp != NULL, FALSE);
+  g_return_val_if_fail (index != NULL, FALSE);
+
+  index->bits = 0;
+  index->n_entries = 0;
+
+  if (!gst_rtp_buffer_get_extension_data (rtp, &bits, (gpointer) & pdata,
+          &wordlen))
+    return FALSE;
+
+  index->bits = bits;
+
+  if (bits == 0xBEDE)
+    onebyte = TRUE;
+  else if (bits >> 4 == 0x100)
+    onebyte = FALSE;
+  else
+    return FALSE;
+
+  bytelen = wordlen * 4;
+
+  for (;;) {
+    guint8 read_id, read_len;
+
+    if (offset + (onebyte ? 1 : 2) >= bytelen)
+      break;
+
+    if (onebyte) {
+      read_id = GST_READ_UINT8 (pdata + offset) >> 4;
+      read_len = (GST_READ_UINT8 (pdata + offset) & 0x0F) + 1;
+      offset += 1;
+
+      /* ID 0 means its padding, skip */
+      if (read_id == 0)
+        continue;
+
+      /* ID 15 is special and means we should stop parsing */
+      if (read_id == 15)
+        break;
+    } else {
+      read_id = GST_READ_UINT8 (pdata + offset);
+      offset += 1;
+
+      if (read_id == 0)
+        continue;
+
+      read_len = GST_READ_UINT8 (pdata + offset);
+      offset += 1;
+    }
+
+    /* Ignore extension headers where the size does not fit */
+    if (offset + read_len > bytelen)
+      break;
+
+    if (index->n_entries < GST_RTP_BUFFER_MAX_EXTENSION_ENTRIES) {
+      GstRTPHeaderExtensionEntry *entry = &index->entries[index->n_entries++];
+
+      entry->id = read_id;
+      entry->size = read_len;
+      entry->data = pdata + offset;
+    }
+
+    offset += read_len;
+  }
+
+  return TRUE;
+}
+
+/**
+ * gst_rtp_header_extension_index_get:
+ * @index: a #GstRTPHeaderExtensionIndex
+ * @id: The ID of the header extension to be read
+ * @nth: Read the nth extension with the requested ID
+ *
+ * Finds the nth extension with the requested id in @index, which was
+ * previously filled with gst_rtp_buffer_parse_extensions().
+ *
+ * Returns: (transfer none) (nullable): the matching entry or %NULL
+ *
+ * Since: 1.14
+ */
+const GstRTPHeaderExtensionEntry *
+gst_rtp_header_extension_index_get (const GstRTPHeaderExtensionIndex * index,
+    guint8 id, guint nth)
+{
+  guint i, count = 0;
+
+  g_return_val_if_fail (index != NULL, NULL);
+
+  for (i = 0; i < index->n_entries; i++) {
+    if (index->entries[i].id != id)
+      continue;
+
+    if (count == nth)
+      return &index->entries[i];
+
+    count++;
+  }
+
+  return NULL;
+}
+
 static guint
 get_onebyte_header_end_offset (guint8 * pdata, guint wordlen)
 {
@@ -228,6 +228,59 @@ gboolean       gst_rtp_buffer_add_extension_twobytes_header (GstRTPBuffer *rtp,
                                                              gconstpointer data,
                                                              guint size);
 
+/**
+ * GST_RTP_BUFFER_MAX_EXTENSION_ENTRIES:
+ *
+ * The maximum amount of header extension entries tracked by
+ * #GstRTPHeaderExtensionIndex.
+ *
+ * Since: 1.14
+ */
+#define GST_RTP_BUFFER_MAX_EXTENSION_ENTRIES 16
+
+/**
+ * GstRTPHeaderExtensionEntry:
+ * @id: the extension id
+ * @size: the size of @data in bytes
+ * @data: a pointer to the extension data in the mapped packet
+ *
+ * One RFC 5285 header extension found by
+ * gst_rtp_buffer_parse_extensions().
+ *
+ * Since: 1.14
+ */
+typedef struct {
+  guint8  id;
+  guint16 size;
+  guint8 *data;
+} GstRTPHeaderExtensionEntry;
+
+/**
+ * GstRTPHeaderExtensionIndex:
+ * @bits: the extension bit pattern of the packet
+ * @n_entries: the number of valid entries in @entries
+ * @entries: the parsed header extensions
+ *
+ * Stack-allocatable index of all RFC 5285 header extensions of one
+ * packet, filled in a single pass by gst_rtp_buffer_parse_extensions().
+ *
+ * Since: 1.14
+ */
+typedef struct {
+  guint16 bits;
+  guint   n_entries;
+  GstRTPHeaderExtensionEntry entries[GST_RTP_BUFFER_MAX_EXTENSION_ENTRIES];
+} GstRTPHeaderExtensionIndex;
+
+GST_EXPORT
+gboolean       gst_rtp_buffer_parse_extensions       (GstRTPBuffer *rtp,
+                                                      GstRTPHeaderExtensionIndex *index);
+
+GST_EXPORT
+const GstRTPHeaderExtensionEntry *
+               gst_rtp_header_extension_index_get    (const GstRTPHeaderExtensionIndex *index,
+                                                      guint8 id, guint nth);
+
 /**
  * GstRTPBufferFlags:
  * @GST_RTP_BUFFER_FLAG_RETRANSMISSION: The #GstBuffer was once wrapped
@@ -252,6 +305,10 @@ typedef enum {
  * @GST_RTP_BUFFER_MAP_FLAG_SKIP_PADDING: Skip mapping and validation of RTP
  *           padding and RTP pad count when present. Useful for buffers where
  *           the padding may be encrypted.
+ * @GST_RTP_BUFFER_MAP_FLAG_TRUSTED: Skip the version and reserved
+ *           payload-type checks. Only safe for buffers that come from a
+ *           trusted source such as another element in the same pipeline;
+ *           the length sanity checks are always performed. Since: 1.14
  * @GST_RTP_BUFFER_MAP_FLAG_LAST: Offset to define more flags
  *
  * Additional mapping flags for gst_rtp_buffer_map().
@@ -260,6 +317,7 @@ typedef enum {
  */
 typedef enum {
   GST_RTP_BUFFER_MAP_FLAG_SKIP_PADDING = (GST_MAP_FLAG_LAST << 0),
+  GST_RTP_BUFFER_MAP_FLAG_TRUSTED      = (GST_MAP_FLAG_LAST << 1),
   GST_RTP_BUFFER_MAP_FLAG_LAST         = (GST_MAP_FLAG_LAST << 8)
   /* 8 more flags possible afterwards */
 } GstRTPBufferMapFlags;
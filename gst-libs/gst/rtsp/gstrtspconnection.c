@@ -165,6 +165,11 @@ struct _GstRTSPConnection
 
   gchar *proxy_host;
   guint proxy_port;
+
+  /* state of gst_rtsp_connection_receive_nonblocking(), lazily allocated
+   * so connections driven by a watch or blocking receive pay nothing */
+  gpointer nb_builder;
+  GstRTSPMessage nb_message;
 };
 
 enum
@@ -1444,13 +1449,10 @@ gst_rtsp_connection_write (GstRTSPConnection * conn, const guint8 * data,
   return res;
 }
 
-static GString *
-message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
+static gboolean
+message_append (GstRTSPConnection * conn, GstRTSPMessage * message,
+    GString * str)
 {
-  GString *str = NULL;
-
-  str = g_string_new ("");
-
   switch (message->type) {
     case GST_RTSP_MESSAGE_REQUEST:
       /* create request string, add CSeq */
@@ -1505,8 +1507,7 @@ message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
       break;
     }
     default:
-      g_string_free (str, TRUE);
-      g_return_val_if_reached (NULL);
+      g_return_val_if_reached (FALSE);
       break;
   }
 
@@ -1542,6 +1543,26 @@ message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
     }
   }
 
+  return TRUE;
+}
+
+static GString *
+message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
+{
+  GString *str;
+
+  /* data messages are the body plus a 4 byte header, we can size the string
+   * exactly and avoid reallocations while the body is copied in */
+  if (message->type == GST_RTSP_MESSAGE_DATA)
+    str = g_string_sized_new (4 + message->body_size);
+  else
+    str = g_string_sized_new (256);
+
+  if (G_UNLIKELY (!message_append (conn, message, str))) {
+    g_string_free (str, TRUE);
+    return NULL;
+  }
+
   return str;
 }
 
@@ -2287,6 +2308,74 @@ cleanup:
   }
 }
 
+/**
+ * gst_rtsp_connection_receive_nonblocking:
+ * @conn: a #GstRTSPConnection
+ * @message: the message to read
+ *
+ * Read into @message from the connected @conn without ever blocking.
+ * A partially received message is kept in the connection and completed
+ * by later calls, so a single thread can drive many connections from
+ * its own poll or epoll loop: register the file descriptor of
+ * gst_rtsp_connection_get_read_socket() and call this function whenever
+ * it becomes readable.
+ *
+ * With edge-triggered readiness notification, call this function
+ * repeatedly until it returns #GST_RTSP_EINTR; at that point all
+ * buffered data has been consumed and no complete message is pending.
+ *
+ * HTTP tunneling is not handled by this function; tunneled connections
+ * should be driven with gst_rtsp_connection_receive() or a
+ * #GstRTSPWatch instead.
+ *
+ * Returns: #GST_RTSP_OK when a complete message was stored in @message,
+ *   #GST_RTSP_EINTR when more data is needed.
+ *
+ * Since: 1.14
+ */
+GstRTSPResult
+gst_rtsp_connection_receive_nonblocking (GstRTSPConnection * conn,
+    GstRTSPMessage * message)
+{
+  GstRTSPBuilder *builder;
+  GstRTSPResult res;
+
+  g_return_val_if_fail (conn != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (message != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (conn->read_socket != NULL, GST_RTSP_EINVAL);
+
+  if (conn->nb_builder == NULL)
+    conn->nb_builder = g_new0 (GstRTSPBuilder, 1);
+  builder = conn->nb_builder;
+
+  res = build_next (builder, &conn->nb_message, conn, FALSE);
+  if (res == GST_RTSP_EINTR)
+    return res;
+  if (G_UNLIKELY (res != GST_RTSP_OK))
+    goto read_error;
+
+  if (conn->nb_message.type == GST_RTSP_MESSAGE_HTTP_REQUEST ||
+      conn->nb_message.type == GST_RTSP_MESSAGE_HTTP_RESPONSE) {
+    res = GST_RTSP_EPARSE;
+    goto read_error;
+  }
+
+  /* transfer the message, the next call starts a fresh one */
+  *message = conn->nb_message;
+  memset (&conn->nb_message, 0, sizeof (GstRTSPMessage));
+  build_reset (builder);
+
+  return GST_RTSP_OK;
+
+  /* ERRORS */
+read_error:
+  {
+    build_reset (builder);
+    gst_rtsp_message_unset (&conn->nb_message);
+    return res;
+  }
+}
+
 /**
  * gst_rtsp_connection_close:
  * @conn: a #GstRTSPConnection
@@ -2344,6 +2433,13 @@ gst_rtsp_connection_close (GstRTSPConnection * conn)
   conn->cseq = 0;
   conn->session_id[0] = '\0';
 
+  if (conn->nb_builder) {
+    build_reset (conn->nb_builder);
+    g_free (conn->nb_builder);
+    conn->nb_builder = NULL;
+  }
+  gst_rtsp_message_unset (&conn->nb_message);
+
   return GST_RTSP_OK;
 }
 
@@ -3075,6 +3171,239 @@ gst_rtsp_connection_get_remember_session_id (GstRTSPConnection * conn)
   return conn->remember_session_id;
 }
 
+#define DEFAULT_POOL_MAX_IDLE      16
+#define DEFAULT_POOL_IDLE_TIMEOUT  60
+
+typedef struct
+{
+  GstRTSPConnection *conn;
+  gint64 idle_since;
+} GstRTSPPooledConnection;
+
+struct _GstRTSPConnectionPool
+{
+  /*< private > */
+  GMutex mutex;
+  GQueue idle;
+  guint max_idle;
+  guint idle_timeout;
+};
+
+/* called with the pool lock, drops idle connections that have been unused
+ * for longer than the configured timeout */
+static void
+pool_prune_expired (GstRTSPConnectionPool * pool, gint64 now)
+{
+  GList *walk, *next;
+
+  if (pool->idle_timeout == 0)
+    return;
+
+  for (walk = pool->idle.head; walk; walk = next) {
+    GstRTSPPooledConnection *pconn = walk->data;
+
+    next = walk->next;
+
+    if (now - pconn->idle_since >= pool->idle_timeout * G_USEC_PER_SEC) {
+      g_queue_delete_link (&pool->idle, walk);
+      gst_rtsp_connection_free (pconn->conn);
+      g_slice_free (GstRTSPPooledConnection, pconn);
+    }
+  }
+}
+
+/**
+ * gst_rtsp_connection_pool_new:
+ *
+ * Create a new connection pool. The pool keeps connected
+ * #GstRTSPConnection objects around after use so that a later
+ * gst_rtsp_connection_pool_acquire() for the same host can skip the
+ * TCP and TLS connection setup.
+ *
+ * Returns: a new #GstRTSPConnectionPool. Free with
+ *   gst_rtsp_connection_pool_free() after usage.
+ *
+ * Since: 1.14
+ */
+GstRTSPConnectionPool *
+gst_rtsp_connection_pool_new (void)
+{
+  GstRTSPConnectionPool *pool;
+
+  pool = g_new0 (GstRTSPConnectionPool, 1);
+
+  g_mutex_init (&pool->mutex);
+  g_queue_init (&pool->idle);
+  pool->max_idle = DEFAULT_POOL_MAX_IDLE;
+  pool->idle_timeout = DEFAULT_POOL_IDLE_TIMEOUT;
+
+  return pool;
+}
+
+/**
+ * gst_rtsp_connection_pool_set_limits:
+ * @pool: a #GstRTSPConnectionPool
+ * @max_idle: maximum number of idle connections to keep
+ * @idle_timeout: seconds after which an unused connection is closed
+ *
+ * Configure the limits of @pool. At most @max_idle connections are kept
+ * around and a connection that was not reused for @idle_timeout seconds
+ * is closed. A value of 0 for @idle_timeout means idle connections are
+ * never closed because of their age.
+ *
+ * The default is 16 connections and a timeout of 60 seconds.
+ *
+ * Since: 1.14
+ */
+void
+gst_rtsp_connection_pool_set_limits (GstRTSPConnectionPool * pool,
+    guint max_idle, guint idle_timeout)
+{
+  g_return_if_fail (pool != NULL);
+
+  g_mutex_lock (&pool->mutex);
+  pool->max_idle = max_idle;
+  pool->idle_timeout = idle_timeout;
+  while (pool->idle.length > pool->max_idle) {
+    GstRTSPPooledConnection *pconn = g_queue_pop_tail (&pool->idle);
+
+    gst_rtsp_connection_free (pconn->conn);
+    g_slice_free (GstRTSPPooledConnection, pconn);
+  }
+  g_mutex_unlock (&pool->mutex);
+}
+
+/**
+ * gst_rtsp_connection_pool_acquire:
+ * @pool: a #GstRTSPConnectionPool
+ * @url: a #GstRTSPUrl
+ * @conn: (out): storage for a #GstRTSPConnection
+ *
+ * Get a connection for communicating with the server of @url. When the
+ * pool has an idle connection to the same host, port and transports it
+ * is returned and the connection setup can be skipped, otherwise a newly
+ * created connection is returned that still has to be connected with
+ * gst_rtsp_connection_connect().
+ *
+ * Whether the returned connection is already connected can be checked
+ * with gst_rtsp_connection_get_read_socket().
+ *
+ * Give the connection back with gst_rtsp_connection_pool_release() when
+ * it is no longer needed.
+ *
+ * Returns: #GST_RTSP_OK when @conn contains a valid connection.
+ *
+ * Since: 1.14
+ */
+GstRTSPResult
+gst_rtsp_connection_pool_acquire (GstRTSPConnectionPool * pool,
+    const GstRTSPUrl * url, GstRTSPConnection ** conn)
+{
+  GList *walk;
+
+  g_return_val_if_fail (pool != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (url != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (conn != NULL, GST_RTSP_EINVAL);
+
+  g_mutex_lock (&pool->mutex);
+  pool_prune_expired (pool, g_get_monotonic_time ());
+
+  for (walk = pool->idle.head; walk; walk = walk->next) {
+    GstRTSPPooledConnection *pconn = walk->data;
+    GstRTSPUrl *purl = pconn->conn->url;
+
+    if (purl->transports == url->transports && purl->port == url->port &&
+        g_ascii_strcasecmp (purl->host, url->host) == 0) {
+      g_queue_delete_link (&pool->idle, walk);
+      g_mutex_unlock (&pool->mutex);
+
+      *conn = pconn->conn;
+      g_slice_free (GstRTSPPooledConnection, pconn);
+
+      return GST_RTSP_OK;
+    }
+  }
+  g_mutex_unlock (&pool->mutex);
+
+  return gst_rtsp_connection_create (url, conn);
+}
+
+/**
+ * gst_rtsp_connection_pool_release:
+ * @pool: a #GstRTSPConnectionPool
+ * @conn: a #GstRTSPConnection
+ *
+ * Give @conn back to @pool. When the connection is still connected, it
+ * is kept around for reuse by gst_rtsp_connection_pool_acquire(),
+ * otherwise it is freed. The session id and sequence number are reset so
+ * that the next user starts a fresh RTSP session on the transport.
+ *
+ * This function takes ownership of @conn.
+ *
+ * Since: 1.14
+ */
+void
+gst_rtsp_connection_pool_release (GstRTSPConnectionPool * pool,
+    GstRTSPConnection * conn)
+{
+  GstRTSPPooledConnection *pconn;
+
+  g_return_if_fail (pool != NULL);
+  g_return_if_fail (conn != NULL);
+
+  /* don't pool connections that lost their transport or that are in the
+   * middle of tunneling */
+  if (conn->stream0 == NULL || conn->tunneled) {
+    gst_rtsp_connection_free (conn);
+    return;
+  }
+
+  /* reset the session state, the transport stays up */
+  conn->cseq = 0;
+  conn->session_id[0] = '\0';
+
+  pconn = g_slice_new (GstRTSPPooledConnection);
+  pconn->conn = conn;
+  pconn->idle_since = g_get_monotonic_time ();
+
+  g_mutex_lock (&pool->mutex);
+  pool_prune_expired (pool, pconn->idle_since);
+
+  if (pool->idle.length >= pool->max_idle) {
+    g_mutex_unlock (&pool->mutex);
+    gst_rtsp_connection_free (conn);
+    g_slice_free (GstRTSPPooledConnection, pconn);
+    return;
+  }
+
+  /* most recently used first, it has the best chance of still being alive */
+  g_queue_push_head (&pool->idle, pconn);
+  g_mutex_unlock (&pool->mutex);
+}
+
+/**
+ * gst_rtsp_connection_pool_free:
+ * @pool: a #GstRTSPConnectionPool
+ *
+ * Close all idle connections in @pool and free the pool.
+ *
+ * Since: 1.14
+ */
+void
+gst_rtsp_connection_pool_free (GstRTSPConnectionPool * pool)
+{
+  GstRTSPPooledConnection *pconn;
+
+  g_return_if_fail (pool != NULL);
+
+  while ((pconn = g_queue_pop_head (&pool->idle))) {
+    gst_rtsp_connection_free (pconn->conn);
+    g_slice_free (GstRTSPPooledConnection, pconn);
+  }
+  g_mutex_clear (&pool->mutex);
+  g_free (pool);
+}
+
 
 #define READ_ERR    (G_IO_HUP | G_IO_ERR | G_IO_NVAL)
 #define READ_COND   (G_IO_IN | READ_ERR)
@@ -3113,6 +3442,10 @@ struct _GstRTSPWatch
   guint write_off;
   guint write_size;
   guint write_id;
+  /* reusable scratch buffer for coalescing queued messages into one write */
+  guint8 *batch_data;
+  guint batch_alloc;
+  GArray *batch_ids;
   gsize max_bytes;
   guint max_messages;
   GCond queue_not_full;
@@ -3127,6 +3460,9 @@ struct _GstRTSPWatch
 #define IS_BACKLOG_FULL(w) (((w)->max_bytes != 0 && (w)->messages_bytes >= (w)->max_bytes) || \
       ((w)->max_messages != 0 && (w)->messages->length >= (w)->max_messages))
 
+/* maximum amount of queued message bytes we coalesce into a single write */
+#define MAX_WRITE_BATCH_BYTES (64 * 1024)
+
 static gboolean
 gst_rtsp_source_prepare (GSource * source, gint * timeout)
 {
@@ -3411,11 +3747,47 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
       watch->messages_bytes -= rec->size;
 
       watch->write_off = 0;
-      watch->write_data = rec->data;
-      watch->write_size = rec->size;
       watch->write_id = rec->id;
 
-      g_slice_free (GstRTSPRec, rec);
+      if (g_queue_is_empty (watch->messages)) {
+        /* just one message queued, write its data out directly */
+        watch->write_data = rec->data;
+        watch->write_size = rec->size;
+        g_array_append_val (watch->batch_ids, rec->id);
+
+        g_slice_free (GstRTSPRec, rec);
+      } else {
+        guint batch_size = 0;
+
+        /* more messages are waiting, coalesce them into the scratch buffer
+         * so they go out with a single write call */
+        do {
+          if (batch_size + rec->size > watch->batch_alloc) {
+            watch->batch_alloc =
+                MAX (watch->batch_alloc * 2, batch_size + rec->size);
+            watch->batch_data =
+                g_realloc (watch->batch_data, watch->batch_alloc);
+          }
+          memcpy (watch->batch_data + batch_size, rec->data, rec->size);
+          batch_size += rec->size;
+          g_array_append_val (watch->batch_ids, rec->id);
+
+          g_free (rec->data);
+          g_slice_free (GstRTSPRec, rec);
+
+          if (batch_size >= MAX_WRITE_BATCH_BYTES)
+            break;
+
+          rec = g_queue_pop_tail (watch->messages);
+          if (rec == NULL)
+            break;
+
+          watch->messages_bytes -= rec->size;
+        } while (TRUE);
+
+        watch->write_data = watch->batch_data;
+        watch->write_size = batch_size;
+      }
     }
 
     res = write_bytes (conn->output_stream, watch->write_data,
@@ -3428,15 +3800,22 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
     if (res == GST_RTSP_EINTR)
       goto write_blocked;
     else if (G_LIKELY (res == GST_RTSP_OK)) {
-      if (watch->funcs.message_sent)
-        watch->funcs.message_sent (watch, watch->write_id, watch->user_data);
+      if (watch->funcs.message_sent) {
+        guint i;
+
+        for (i = 0; i < watch->batch_ids->len; i++)
+          watch->funcs.message_sent (watch,
+              g_array_index (watch->batch_ids, guint, i), watch->user_data);
+      }
     } else {
       goto write_error;
     }
     g_mutex_lock (&watch->mutex);
 
-    g_free (watch->write_data);
+    if (watch->write_data != watch->batch_data)
+      g_free (watch->write_data);
     watch->write_data = NULL;
+    g_array_set_size (watch->batch_ids, 0);
   } while (TRUE);
   g_mutex_unlock (&watch->mutex);
 
@@ -3485,7 +3864,10 @@ gst_rtsp_source_finalize (GSource * source)
   watch->messages = NULL;
   watch->messages_bytes = 0;
 
-  g_free (watch->write_data);
+  if (watch->write_data != watch->batch_data)
+    g_free (watch->write_data);
+  g_free (watch->batch_data);
+  g_array_free (watch->batch_ids, TRUE);
   g_cond_clear (&watch->queue_not_full);
 
   if (watch->readsrc)
@@ -3544,6 +3926,7 @@ gst_rtsp_watch_new (GstRTSPConnection * conn,
 
   g_mutex_init (&result->mutex);
   result->messages = g_queue_new ();
+  result->batch_ids = g_array_new (FALSE, FALSE, sizeof (guint));
   g_cond_init (&result->queue_not_full);
 
   gst_rtsp_watch_reset (result);
@@ -3861,6 +4244,63 @@ gst_rtsp_watch_send_message (GstRTSPWatch * watch, GstRTSPMessage * message,
       (guint8 *) g_string_free (str, FALSE), size, id);
 }
 
+/**
+ * gst_rtsp_watch_send_messages:
+ * @watch: a #GstRTSPWatch
+ * @messages: (array length=n_messages): the messages to send
+ * @n_messages: the number of messages to send
+ * @id: (out) (allow-none): location for a message ID or %NULL
+ *
+ * Sends @messages using the connection of the @watch. If they cannot be sent
+ * immediately, they will be queued for transmission in @watch. The contents of
+ * @messages will then be serialized and transmitted when the connection of the
+ * @watch becomes writable. In case the messages are queued, the ID returned in
+ * @id will be non-zero and used as the ID argument in the message_sent
+ * callback once the last message is sent.
+ *
+ * The messages are serialized back to back and written out together, which
+ * is considerably cheaper than queueing them one by one with
+ * gst_rtsp_watch_send_message() when many small data messages have to be
+ * sent, as is typical for interleaved streams.
+ *
+ * Returns: #GST_RTSP_OK on success.
+ *
+ * Since: 1.14
+ */
+GstRTSPResult
+gst_rtsp_watch_send_messages (GstRTSPWatch * watch, GstRTSPMessage * messages,
+    guint n_messages, guint * id)
+{
+  GString *str;
+  guint size, i;
+
+  g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (messages != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (n_messages > 0, GST_RTSP_EINVAL);
+
+  /* the data messages dominate the size, use them as the size hint so the
+   * string rarely has to grow while we serialize */
+  size = 0;
+  for (i = 0; i < n_messages; i++) {
+    if (messages[i].type == GST_RTSP_MESSAGE_DATA)
+      size += 4 + messages[i].body_size;
+  }
+
+  /* serialize all messages into one block so they are written with a single
+   * write call */
+  str = g_string_sized_new (MAX (size, 256));
+  for (i = 0; i < n_messages; i++) {
+    if (G_UNLIKELY (!message_append (watch->conn, &messages[i], str))) {
+      g_string_free (str, TRUE);
+      g_return_val_if_reached (GST_RTSP_EINVAL);
+    }
+  }
+
+  size = str->len;
+  return gst_rtsp_watch_write_data (watch,
+      (guint8 *) g_string_free (str, FALSE), size, id);
+}
+
 /**
  * gst_rtsp_watch_wait_backlog:
  * @watch: a #GstRTSPWatch
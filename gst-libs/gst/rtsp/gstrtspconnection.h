@@ -130,6 +130,9 @@ GST_EXPORT
 GstRTSPResult      gst_rtsp_connection_receive        (GstRTSPConnection *conn, GstRTSPMessage *message,
                                                        GTimeVal *timeout);
 
+GST_EXPORT
+GstRTSPResult      gst_rtsp_connection_receive_nonblocking (GstRTSPConnection *conn, GstRTSPMessage *message);
+
 /* status management */
 
 GST_EXPORT
@@ -216,6 +219,37 @@ void               gst_rtsp_connection_set_remember_session_id (GstRTSPConnectio
 GST_EXPORT
 gboolean           gst_rtsp_connection_get_remember_session_id (GstRTSPConnection *conn);
 
+/* connection pooling */
+
+/**
+ * GstRTSPConnectionPool:
+ *
+ * Opaque pool of reusable RTSP connections.
+ *
+ * Since: 1.14
+ */
+typedef struct _GstRTSPConnectionPool GstRTSPConnectionPool;
+
+GST_EXPORT
+GstRTSPConnectionPool * gst_rtsp_connection_pool_new        (void);
+
+GST_EXPORT
+void               gst_rtsp_connection_pool_set_limits      (GstRTSPConnectionPool *pool,
+                                                             guint max_idle,
+                                                             guint idle_timeout);
+
+GST_EXPORT
+GstRTSPResult      gst_rtsp_connection_pool_acquire         (GstRTSPConnectionPool *pool,
+                                                             const GstRTSPUrl *url,
+                                                             GstRTSPConnection **conn);
+
+GST_EXPORT
+void               gst_rtsp_connection_pool_release         (GstRTSPConnectionPool *pool,
+                                                             GstRTSPConnection *conn);
+
+GST_EXPORT
+void               gst_rtsp_connection_pool_free            (GstRTSPConnectionPool *pool);
+
 /* async IO */
 
 /**
@@ -303,6 +337,12 @@ GstRTSPResult      gst_rtsp_watch_send_message       (GstRTSPWatch *watch,
                                                       GstRTSPMessage *message,
                                                       guint *id);
 
+GST_EXPORT
+GstRTSPResult      gst_rtsp_watch_send_messages      (GstRTSPWatch *watch,
+                                                      GstRTSPMessage *messages,
+                                                      guint n_messages,
+                                                      guint *id);
+
 GST_EXPORT
 GstRTSPResult      gst_rtsp_watch_wait_backlog       (GstRTSPWatch * watch,
                                                       GTimeVal *timeout);
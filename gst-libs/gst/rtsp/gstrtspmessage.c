@@ -61,8 +61,108 @@ typedef struct _RTSPKeyValue
   GstRTSPHeaderField field;
   gchar *value;
   gchar *custom_key;            /* custom header string (field is INVALID then) */
+  guint value_in_arena:1;       /* value lives in the message string arena */
+  guint key_in_arena:1;         /* custom_key lives in the message string arena */
 } RTSPKeyValue;
 
+/* per-message bump allocator for header strings, kept in the private padding
+ * of the message. Strings copied into it are released all at once by
+ * gst_rtsp_message_unset() instead of one g_free() per header, and removing
+ * a single header just abandons its span until the message is unset */
+#define ARENA_BLOCK_SIZE 1024
+
+typedef struct
+{
+  GSList *blocks;               /* ARENA_BLOCK_SIZE byte blocks, newest first */
+  gsize avail;                  /* bytes left in the newest block */
+} RTSPStringArena;
+
+#define MSG_STRING_ARENA(msg) ((RTSPStringArena *) (msg)->_gst_reserved[1])
+
+/* copy @str into the arena of @msg, creating the arena on first use.
+ * Returns NULL for oversized strings, which then stay on the heap */
+static gchar *
+msg_arena_strdup (GstRTSPMessage * msg, const gchar * str)
+{
+  RTSPStringArena *arena;
+  gsize len = strlen (str) + 1;
+  gchar *dest;
+
+  if (len > ARENA_BLOCK_SIZE / 2)
+    return NULL;
+
+  if ((arena = MSG_STRING_ARENA (msg)) == NULL) {
+    arena = g_new0 (RTSPStringArena, 1);
+    msg->_gst_reserved[1] = arena;
+  }
+  if (arena->avail < len) {
+    arena->blocks =
+        g_slist_prepend (arena->blocks, g_malloc (ARENA_BLOCK_SIZE));
+    arena->avail = ARENA_BLOCK_SIZE;
+  }
+  dest = (gchar *) arena->blocks->data + (ARENA_BLOCK_SIZE - arena->avail);
+  memcpy (dest, str, len);
+  arena->avail -= len;
+
+  return dest;
+}
+
+static void
+msg_free_string_arena (GstRTSPMessage * msg)
+{
+  RTSPStringArena *arena = MSG_STRING_ARENA (msg);
+
+  if (arena == NULL)
+    return;
+
+  g_slist_free_full (arena->blocks, g_free);
+  g_free (arena);
+  msg->_gst_reserved[1] = NULL;
+}
+
+/* index of the first occurrence of each known header field, built lazily on
+ * the first lookup and kept in the private padding of the message. It is
+ * dropped whenever the headers change and rebuilt on the next lookup, so
+ * repeated gst_rtsp_message_get_header() calls on a parsed message don't
+ * rescan the header array for every field */
+typedef struct
+{
+  /* position of the first header with that field + 1, 0 when absent */
+  guint first[GST_RTSP_HDR_LAST];
+} RTSPHeaderIndex;
+
+#define MSG_HEADER_INDEX(msg) ((RTSPHeaderIndex *) (msg)->_gst_reserved[0])
+
+static void
+msg_invalidate_header_index (GstRTSPMessage * msg)
+{
+  g_free (msg->_gst_reserved[0]);
+  msg->_gst_reserved[0] = NULL;
+}
+
+static RTSPHeaderIndex *
+msg_ensure_header_index (const GstRTSPMessage * msg)
+{
+  GstRTSPMessage *wmsg = (GstRTSPMessage *) msg;
+  RTSPHeaderIndex *index;
+  guint i;
+
+  if ((index = MSG_HEADER_INDEX (wmsg)))
+    return index;
+
+  index = g_new0 (RTSPHeaderIndex, 1);
+  for (i = 0; i < msg->hdr_fields->len; i++) {
+    RTSPKeyValue *kv = &g_array_index (msg->hdr_fields, RTSPKeyValue, i);
+
+    if (kv->field > GST_RTSP_HDR_INVALID && kv->field < GST_RTSP_HDR_LAST &&
+        index->first[kv->field] == 0)
+      index->first[kv->field] = i + 1;
+  }
+  wmsg->_gst_reserved[0] = index;
+
+  return index;
+}
+
 static void
 key_value_foreach (GArray * array, GFunc func, gpointer user_data)
 {
@@ -464,12 +564,16 @@ gst_rtsp_message_unset (GstRTSPMessage * msg)
     for (i = 0; i < msg->hdr_fields->len; i++) {
       RTSPKeyValue *keyval = &g_array_index (msg->hdr_fields, RTSPKeyValue, i);
 
-      g_free (keyval->value);
-      g_free (keyval->custom_key);
+      if (!keyval->value_in_arena)
+        g_free (keyval->value);
+      if (!keyval->key_in_arena)
+        g_free (keyval->custom_key);
     }
     g_array_free (msg->hdr_fields, TRUE);
   }
   g_free (msg->body);
+  msg_invalidate_header_index (msg);
+  msg_free_string_arena (msg);
 
   memset (msg, 0, sizeof (GstRTSPMessage));
 
@@ -521,8 +625,11 @@ gst_rtsp_message_take_header (GstRTSPMessage * msg, GstRTSPHeaderField field,
   key_value.field = field;
   key_value.value = value;
   key_value.custom_key = NULL;
+  key_value.value_in_arena = FALSE;
+  key_value.key_in_arena = FALSE;
 
   g_array_append_val (msg->hdr_fields, key_value);
+  msg_invalidate_header_index (msg);
 
   return GST_RTSP_OK;
 }
@@ -542,7 +649,24 @@ GstRTSPResult
 gst_rtsp_message_add_header (GstRTSPMessage * msg, GstRTSPHeaderField field,
     const gchar * value)
 {
-  return gst_rtsp_message_take_header (msg, field, g_strdup (value));
+  RTSPKeyValue key_value;
+
+  g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (value != NULL, GST_RTSP_EINVAL);
+
+  key_value.value = msg_arena_strdup (msg, value);
+  if (key_value.value == NULL)
+    return gst_rtsp_message_take_header (msg, field, g_strdup (value));
+
+  key_value.field = field;
+  key_value.custom_key = NULL;
+  key_value.value_in_arena = TRUE;
+  key_value.key_in_arena = FALSE;
+
+  g_array_append_val (msg->hdr_fields, key_value);
+  msg_invalidate_header_index (msg);
+
+  return GST_RTSP_OK;
 }
 
 /**
@@ -570,8 +694,10 @@ gst_rtsp_message_remove_header (GstRTSPMessage * msg, GstRTSPHeaderField field,
     RTSPKeyValue *key_value = &g_array_index (msg->hdr_fields, RTSPKeyValue, i);
 
     if (key_value->field == field && (indx == -1 || cnt++ == indx)) {
-      g_free (key_value->value);
+      if (!key_value->value_in_arena)
+        g_free (key_value->value);
       g_array_remove_index (msg->hdr_fields, i);
+      msg_invalidate_header_index (msg);
       res = GST_RTSP_OK;
       if (indx != -1)
         break;
@@ -599,7 +725,7 @@ GstRTSPResult
 gst_rtsp_message_get_header (const GstRTSPMessage * msg,
     GstRTSPHeaderField field, gchar ** value, gint indx)
 {
-  guint i;
+  guint i = 0;
   gint cnt = 0;
 
   g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
@@ -608,7 +734,18 @@ gst_rtsp_message_get_header (const GstRTSPMessage * msg,
   if (msg->hdr_fields == NULL)
     return GST_RTSP_ENOTIMPL;
 
-  for (i = 0; i < msg->hdr_fields->len; i++) {
+  /* for known fields the index tells us immediately whether the field is
+   * present and where its first occurrence is */
+  if (field > GST_RTSP_HDR_INVALID && field < GST_RTSP_HDR_LAST) {
+    RTSPHeaderIndex *index = msg_ensure_header_index (msg);
+
+    if (index->first[field] == 0)
+      return GST_RTSP_ENOTIMPL;
+
+    i = index->first[field] - 1;
+  }
+
+  for (; i < msg->hdr_fields->len; i++) {
     RTSPKeyValue *key_value = &g_array_index (msg->hdr_fields, RTSPKeyValue, i);
 
     if (key_value->field == field && cnt++ == indx) {
@@ -639,6 +776,7 @@ gst_rtsp_message_add_header_by_name (GstRTSPMessage * msg,
     const gchar * header, const gchar * value)
 {
   GstRTSPHeaderField field;
+  RTSPKeyValue key_value;
 
   g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (header != NULL, GST_RTSP_EINVAL);
@@ -646,9 +784,29 @@ gst_rtsp_message_add_header_by_name (GstRTSPMessage * msg,
 
   field = gst_rtsp_find_header_field (header);
   if (field != GST_RTSP_HDR_INVALID)
-    return gst_rtsp_message_take_header (msg, field, g_strdup (value));
+    return gst_rtsp_message_add_header (msg, field, value);
 
-  return gst_rtsp_message_take_header_by_name (msg, header, g_strdup (value));
+  key_value.field = GST_RTSP_HDR_INVALID;
+  key_value.value_in_arena = FALSE;
+  key_value.key_in_arena = FALSE;
+
+  /* oversized strings stay on the heap, everything else goes to the arena */
+  key_value.value = msg_arena_strdup (msg, value);
+  if (key_value.value != NULL)
+    key_value.value_in_arena = TRUE;
+  else
+    key_value.value = g_strdup (value);
+
+  key_value.custom_key = msg_arena_strdup (msg, header);
+  if (key_value.custom_key != NULL)
+    key_value.key_in_arena = TRUE;
+  else
+    key_value.custom_key = g_strdup (header);
+
+  g_array_append_val (msg->hdr_fields, key_value);
+  msg_invalidate_header_index (msg);
+
+  return GST_RTSP_OK;
 }
 
 /**
@@ -677,8 +835,11 @@ gst_rtsp_message_take_header_by_name (GstRTSPMessage * msg,
   key_value.field = GST_RTSP_HDR_INVALID;
   key_value.value = value;
   key_value.custom_key = g_strdup (header);
+  key_value.value_in_arena = FALSE;
+  key_value.key_in_arena = FALSE;
 
   g_array_append_val (msg->hdr_fields, key_value);
+  msg_invalidate_header_index (msg);
 
   return GST_RTSP_OK;
 }
@@ -747,9 +908,12 @@ gst_rtsp_message_remove_header_by_name (GstRTSPMessage * msg,
       break;
 
     kv = &g_array_index (msg->hdr_fields, RTSPKeyValue, pos);
-    g_free (kv->value);
-    g_free (kv->custom_key);
+    if (!kv->value_in_arena)
+      g_free (kv->value);
+    if (!kv->key_in_arena)
+      g_free (kv->custom_key);
     g_array_remove_index (msg->hdr_fields, pos);
+    msg_invalidate_header_index (msg);
     res = GST_RTSP_OK;
   } while (index < 0);
 
@@ -458,6 +458,9 @@ gst_sdp_address_is_multicast (const gchar * nettype, const gchar * addrtype,
   return ret;
 }
 
+static void gst_sdp_media_as_text_append (const GstSDPMedia * media,
+    GString * lines);
+
 /**
  * gst_sdp_message_as_text:
  * @msg: a #GstSDPMessage
@@ -475,7 +478,9 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
 
   g_return_val_if_fail (msg != NULL, NULL);
 
-  lines = g_string_new ("");
+  /* start with enough room for a typical description so the append calls
+   * below don't need to grow the string repeatedly */
+  lines = g_string_sized_new (256 * (1 + gst_sdp_message_medias_len (msg)));
 
   if (msg->version)
     g_string_append_printf (lines, "v=%s\r\n", msg->version);
@@ -576,14 +581,8 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
     }
   }
 
-  for (i = 0; i < gst_sdp_message_medias_len (msg); i++) {
-    const GstSDPMedia *media = gst_sdp_message_get_media (msg, i);
-    gchar *sdp_media_str;
-
-    sdp_media_str = gst_sdp_media_as_text (media);
-    g_string_append_printf (lines, "%s", sdp_media_str);
-    g_free (sdp_media_str);
-  }
+  for (i = 0; i < gst_sdp_message_medias_len (msg); i++)
+    gst_sdp_media_as_text_append (gst_sdp_message_get_media (msg, i), lines);
 
   return g_string_free (lines, FALSE);
 }
@@ -1936,24 +1935,13 @@ gst_sdp_media_copy (const GstSDPMedia * media, GstSDPMedia ** copy)
   return GST_SDP_OK;
 }
 
-/**
- * gst_sdp_media_as_text:
- * @media: a #GstSDPMedia
- *
- * Convert the contents of @media to a text string.
- *
- * Returns: A dynamically allocated string representing the media.
- */
-gchar *
-gst_sdp_media_as_text (const GstSDPMedia * media)
+/* serialize @media into @lines, the shared core of gst_sdp_media_as_text()
+ * and gst_sdp_message_as_text() */
+static void
+gst_sdp_media_as_text_append (const GstSDPMedia * media, GString * lines)
 {
-  GString *lines;
   guint i;
 
-  g_return_val_if_fail (media != NULL, NULL);
-
-  lines = g_string_new ("");
-
   if (media->media)
     g_string_append_printf (lines, "m=%s", media->media);
 
@@ -2013,6 +2001,25 @@ gst_sdp_media_as_text (const GstSDPMedia * media)
       g_string_append_printf (lines, "\r\n");
     }
   }
+}
+
+/**
+ * gst_sdp_media_as_text:
+ * @media: a #GstSDPMedia
+ *
+ * Convert the contents of @media to a text string.
+ *
+ * Returns: A dynamically allocated string representing the media.
+ */
+gchar *
+gst_sdp_media_as_text (const GstSDPMedia * media)
+{
+  GString *lines;
+
+  g_return_val_if_fail (media != NULL, NULL);
+
+  lines = g_string_sized_new (256);
+  gst_sdp_media_as_text_append (media, lines);
 
   return g_string_free (lines, FALSE);
 }
@@ -3191,6 +3198,86 @@ out:
   return GST_SDP_OK;
 }
 
+/**
+ * gst_sdp_message_parse_buffer_fast:
+ * @data: (array length=size): the start of the buffer
+ * @size: the size of the buffer
+ * @msg: the result #GstSDPMessage
+ *
+ * Parse the contents of @size bytes pointed to by @data and store the result in
+ * @msg.
+ *
+ * Unlike gst_sdp_message_parse_buffer(), this function makes one copy of the
+ * complete buffer up front and then tokenizes the lines in place in a single
+ * pass, instead of copying every line into a scratch buffer first. The
+ * resulting message is identical and owns its strings like any other
+ * #GstSDPMessage, this is purely a cheaper way to parse when many messages
+ * have to be handled per second.
+ *
+ * Returns: #GST_SDP_OK on success.
+ *
+ * Since: 1.14
+ */
+GstSDPResult
+gst_sdp_message_parse_buffer_fast (const guint8 * data, guint size,
+    GstSDPMessage * msg)
+{
+  SDPContext c;
+  gchar *copy, *p, *end;
+
+  g_return_val_if_fail (msg != NULL, GST_SDP_EINVAL);
+  g_return_val_if_fail (data != NULL, GST_SDP_EINVAL);
+  g_return_val_if_fail (size != 0, GST_SDP_EINVAL);
+
+  c.state = SDP_SESSION;
+  c.msg = msg;
+  c.media = NULL;
+
+  /* one backing copy of the whole message, the lines are terminated in
+   * place and handed to the line parser without further copying */
+  copy = g_malloc (size + 1);
+  memcpy (copy, data, size);
+  copy[size] = '\0';
+  end = copy + size;
+
+  p = copy;
+  while (p < end) {
+    gchar type, *line;
+
+    /* skip line endings and stray whitespace */
+    while (p < end && g_ascii_isspace (*p))
+      p++;
+    if (p >= end || *p == '\0')
+      break;
+
+    type = *p++;
+    if (p >= end)
+      break;
+    if (*p != '=')
+      goto line_done;
+    p++;
+
+    line = p;
+    while (p < end && *p != '\n' && *p != '\r' && *p != '\0')
+      p++;
+    /* terminate the line in place, the line ending was consumed above and
+     * what is left of it is skipped as whitespace in the next iteration */
+    if (p < end)
+      *p++ = '\0';
+
+    gst_sdp_parse_line (&c, type, line);
+    continue;
+
+  line_done:
+    while (p < end && *p != '\n' && *p != '\0')
+      p++;
+  }
+
+  g_free (copy);
+
+  return GST_SDP_OK;
+}
+
 static void
 print_media (GstSDPMedia * media)
 {
@@ -3518,6 +3605,47 @@ gst_sdp_media_add_rtcp_fb_attributes_from_media (const GstSDPMedia * media,
   return GST_SDP_OK;
 }
 
+/* cache of serialized media blocks to parsed caps. RTSP reconnect storms
+ * convert the same media descriptions (same camera models, same profiles)
+ * over and over, so repeated conversions are the common case */
+#define CAPS_CACHE_MAX_ENTRIES 64
+
+static GMutex caps_cache_lock;
+static GHashTable *caps_cache;
+
+static GstCaps *
+caps_cache_lookup (const gchar * key)
+{
+  GstCaps *caps = NULL;
+
+  g_mutex_lock (&caps_cache_lock);
+  if (caps_cache != NULL) {
+    caps = g_hash_table_lookup (caps_cache, key);
+    /* return a writable copy, callers own the result and often add to it */
+    if (caps != NULL)
+      caps = gst_caps_copy (caps);
+  }
+  g_mutex_unlock (&caps_cache_lock);
+
+  return caps;
+}
+
+/* takes ownership of @key */
+static void
+caps_cache_insert (gchar * key, const GstCaps * caps)
+{
+  g_mutex_lock (&caps_cache_lock);
+  if (caps_cache == NULL)
+    caps_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+        (GDestroyNotify) gst_caps_unref);
+  /* simple bounded cache, identical media blocks cluster in time so
+   * flushing everything when full is good enough */
+  if (g_hash_table_size (caps_cache) >= CAPS_CACHE_MAX_ENTRIES)
+    g_hash_table_remove_all (caps_cache);
+  g_hash_table_replace (caps_cache, key, gst_caps_copy (caps));
+  g_mutex_unlock (&caps_cache_lock);
+}
+
 /**
  * gst_sdp_media_get_caps_from_media:
  * @media: a #GstSDPMedia
@@ -3531,6 +3659,9 @@ gst_sdp_media_add_rtcp_fb_attributes_from_media (const GstSDPMedia * media,
  *
  * a=fmtp:(payload) (param)[=(value)];...
  *
+ * Repeated conversions of identical media descriptions are served from a
+ * small internal cache, the returned caps are always owned by the caller.
+ *
  * Returns: a #GstCaps, or %NULL if an error happened
  *
  * Since: 1.8
@@ -3539,6 +3670,7 @@ GstCaps *
 gst_sdp_media_get_caps_from_media (const GstSDPMedia * media, gint pt)
 {
   GstCaps *caps;
+  gchar *cache_key;
   const gchar *rtpmap;
   gchar *fmtp = NULL;
   gchar *framesize = NULL;
@@ -3552,6 +3684,17 @@ gst_sdp_media_get_caps_from_media (const GstSDPMedia * media, gint pt)
 
   g_return_val_if_fail (media != NULL, NULL);
 
+  /* key the cache on the whole serialized media block, everything the
+   * conversion below reads is part of it */
+  tmp = gst_sdp_media_as_text (media);
+  cache_key = g_strdup_printf ("%d %s", pt, tmp);
+  g_free (tmp);
+
+  if ((caps = caps_cache_lookup (cache_key))) {
+    g_free (cache_key);
+    return caps;
+  }
+
   /* get and parse rtpmap */
   rtpmap = gst_sdp_get_attribute_for_pt (media, "rtpmap", pt);
 
@@ -3693,7 +3836,11 @@ gst_sdp_media_get_caps_from_media (const GstSDPMedia * media, gint pt)
   /* parse rtcp-fb: field */
   gst_sdp_media_add_rtcp_fb_attributes_from_media (media, pt, caps);
 
+  caps_cache_insert (cache_key, caps);
+  cache_key = NULL;
+
 out:
+  g_free (cache_key);
   g_free (framesize);
   g_free (fmtp);
   g_free (name);
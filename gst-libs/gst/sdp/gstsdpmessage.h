@@ -337,6 +337,9 @@ GstSDPResult            gst_sdp_message_copy                (const GstSDPMessage
 GST_EXPORT
 GstSDPResult            gst_sdp_message_parse_buffer        (const guint8 *data, guint size, GstSDPMessage *msg);
 
+GST_EXPORT
+GstSDPResult            gst_sdp_message_parse_buffer_fast   (const guint8 *data, guint size, GstSDPMessage *msg);
+
 GST_EXPORT
 gchar*                  gst_sdp_message_as_text             (const GstSDPMessage *msg);
 
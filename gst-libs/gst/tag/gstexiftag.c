@@ -238,6 +238,10 @@ struct _GstExifReader
 
   /* tags waiting for their complementary tags */
   GSList *pending_tags;
+
+  /* NULL-terminated array of the only gst tags to materialize,
+   * or NULL to extract everything */
+  const gchar **tag_filter;
 };
 
 EXIF_SERIALIZATION_DESERIALIZATION_FUNC (aperture_value);
@@ -467,6 +471,7 @@ gst_exif_reader_init (GstExifReader * reader, gint byte_order,
   reader->base_offset = base_offset;
   reader->byte_order = byte_order;
   reader->pending_tags = NULL;
+  reader->tag_filter = NULL;
   if (reader->byte_order != G_LITTLE_ENDIAN &&
       reader->byte_order != G_BIG_ENDIAN) {
     GST_WARNING ("Unexpected byte order %d, using system default: %d",
@@ -475,6 +480,22 @@ gst_exif_reader_init (GstExifReader * reader, gint byte_order,
   }
 }
 
+/* checks if the reader's tag filter (if any) includes this gst tag */
+static gboolean
+gst_exif_reader_tag_wanted (GstExifReader * reader, const gchar * gst_tag)
+{
+  gint i;
+
+  if (reader->tag_filter == NULL)
+    return TRUE;
+
+  for (i = 0; reader->tag_filter[i]; i++) {
+    if (strcmp (reader->tag_filter[i], gst_tag) == 0)
+      return TRUE;
+  }
+  return FALSE;
+}
+
 static void
 gst_exif_reader_add_pending_tag (GstExifReader * reader, GstExifTagData * data)
 {
@@ -1773,6 +1794,13 @@ parse_exif_ifd (GstExifReader * exif_reader, gint buf_offset,
       continue;
     }
 
+    /* with a tag filter in place only materialize the values the caller
+     * asked for; entries without a direct gst tag carry complementary
+     * data and are always processed */
+    if (tag_map[map_index].gst_tag != NULL &&
+        !gst_exif_reader_tag_wanted (exif_reader, tag_map[map_index].gst_tag))
+      continue;
+
     /* tags that need specialized deserialization */
     if (tag_map[map_index].deserialize) {
       i += tag_map[map_index].deserialize (exif_reader, &reader,
@@ -1971,6 +1999,49 @@ read_error:
   }
 }
 
+/**
+ * gst_tag_list_from_exif_buffer_filtered:
+ * @buffer: The exif buffer
+ * @byte_order: byte order of the data
+ * @base_offset: Offset from the tiff header to this buffer
+ * @tags: (array zero-terminated=1): %NULL-terminated array of GStreamer
+ *     tag names to extract
+ *
+ * Like gst_tag_list_from_exif_buffer(), but only converts the values of
+ * the tags in @tags into the resulting taglist. The IFD entries are still
+ * walked, but the value data of entries mapping to other tags is neither
+ * read nor converted, which avoids most per-tag allocations when only a
+ * few fields of a file are of interest.
+ *
+ * Returns: The parsed taglist
+ *
+ * Since: 1.14
+ */
+GstTagList *
+gst_tag_list_from_exif_buffer_filtered (GstBuffer * buffer, gint byte_order,
+    guint32 base_offset, const gchar ** tags)
+{
+  GstExifReader reader;
+  g_return_val_if_fail (byte_order == G_LITTLE_ENDIAN
+      || byte_order == G_BIG_ENDIAN, NULL);
+  g_return_val_if_fail (tags != NULL, NULL);
+
+  gst_exif_reader_init (&reader, byte_order, buffer, base_offset);
+  reader.tag_filter = tags;
+
+  if (!parse_exif_ifd (&reader, 0, tag_map_ifd0))
+    goto read_error;
+
+  return gst_exif_reader_reset (&reader, TRUE);
+
+read_error:
+  {
+    gst_exif_reader_reset (&reader, FALSE);
+    GST_WARNING ("Failed to parse the exif buffer");
+    return NULL;
+  }
+}
+
 /**
  * gst_tag_list_from_exif_buffer_with_tiff_header:
  * @buffer: The exif buffer
@@ -176,18 +176,8 @@ id3v2_ununsync_data (const guint8 * unsync_data, guint32 * size)
   return out;
 }
 
-/**
- * gst_tag_list_from_id3v2_tag:
- * @buffer: buffer to convert
- *
- * Creates a new tag list that contains the information parsed out of a
- * ID3 tag.
- *
- * Returns: A new #GstTagList with all tags that could be extracted from the
- *          given vorbiscomment buffer or NULL on error.
- */
-GstTagList *
-gst_tag_list_from_id3v2_tag (GstBuffer * buffer)
+static GstTagList *
+id3v2_tag_to_tag_list (GstBuffer * buffer, const gchar ** tag_filter)
 {
   GstMapInfo info;
   guint8 *uu_data = NULL;
@@ -233,6 +223,7 @@ gst_tag_list_from_id3v2_tag (GstBuffer * buffer)
 
   memset (&work, 0, sizeof (ID3TagsWorking));
   work.buffer = buffer;
+  work.tag_filter = tag_filter;
   work.hdr.version = version;
   work.hdr.size = read_size;
   work.hdr.flags = flags;
@@ -285,6 +276,48 @@ not_enough_data:
   }
 }
 
+/**
+ * gst_tag_list_from_id3v2_tag:
+ * @buffer: buffer to convert
+ *
+ * Creates a new tag list that contains the information parsed out of a
+ * ID3 tag.
+ *
+ * Returns: A new #GstTagList with all tags that could be extracted from the
+ *          given vorbiscomment buffer or NULL on error.
+ */
+GstTagList *
+gst_tag_list_from_id3v2_tag (GstBuffer * buffer)
+{
+  return id3v2_tag_to_tag_list (buffer, NULL);
+}
+
+/**
+ * gst_tag_list_from_id3v2_tag_filtered:
+ * @buffer: buffer to convert
+ * @tags: (array zero-terminated=1): %NULL-terminated array of GStreamer
+ *     tag names to extract
+ *
+ * Like gst_tag_list_from_id3v2_tag(), but only extracts the tags in @tags.
+ * Frames mapping to other tags are skipped without decoding or converting
+ * their content, which avoids most per-frame allocations when only a few
+ * fields of a file are of interest. Note that user frames such as TXXX
+ * reveal their tag mapping only once their description has been decoded
+ * and are therefore always parsed.
+ *
+ * Returns: A new #GstTagList with the matching tags that could be extracted
+ *          from the given buffer or NULL on error.
+ *
+ * Since: 1.14
+ */
+GstTagList *
+gst_tag_list_from_id3v2_tag_filtered (GstBuffer * buffer, const gchar ** tags)
+{
+  g_return_val_if_fail (tags != NULL, NULL);
+
+  return id3v2_tag_to_tag_list (buffer, tags);
+}
+
 static guint
 id3v2_frame_hdr_size (guint id3v2ver)
 {
@@ -439,6 +472,22 @@ id3v2_add_id3v2_frame_blob_to_taglist (ID3TagsWorking * work,
   gst_sample_unref (sample);
 }
 
+/* checks if the working state's tag filter (if any) includes this gst tag */
+static gboolean
+id3v2_tag_wanted (ID3TagsWorking * work, const gchar * gst_tag)
+{
+  gint i;
+
+  if (work->tag_filter == NULL)
+    return TRUE;
+
+  for (i = 0; work->tag_filter[i]; i++) {
+    if (strcmp (work->tag_filter[i], gst_tag) == 0)
+      return TRUE;
+  }
+  return FALSE;
+}
+
 static gboolean
 id3v2_frames_to_tag_list (ID3TagsWorking * work, guint size)
 {
@@ -568,19 +617,32 @@ id3v2_frames_to_tag_list (ID3TagsWorking * work, guint size)
 #endif
 
     if (!obsolete_id) {
-      /* Now, read, decompress etc the contents of the frame
-       * into a TagList entry */
-      work->cur_frame_size = frame_size;
-      work->frame_id = frame_id;
-      work->frame_flags = frame_flags;
-
-      if (id3v2_parse_frame (work)) {
-        GST_LOG ("Extracted frame with id %s", frame_id);
-      } else {
-        GST_LOG ("Failed to extract frame with id %s", frame_id);
-        /* Rewind the frame data / size to pass the header too */
-        id3v2_add_id3v2_frame_blob_to_taglist (work,
-            work->hdr.frame_data - frame_hdr_size, frame_hdr_size + frame_size);
+      const gchar *gst_tag = NULL;
+
+      /* with a tag filter in place, skip frames mapping to other tags
+       * without decoding them; frames with no direct mapping (such as
+       * TXXX user frames) are always parsed as their mapping is only
+       * known once the frame content has been decoded */
+      if (work->tag_filter != NULL)
+        gst_tag = gst_tag_from_id3_tag (frame_id);
+
+      if (work->tag_filter == NULL || gst_tag == NULL ||
+          id3v2_tag_wanted (work, gst_tag)) {
+        /* Now, read, decompress etc the contents of the frame
+         * into a TagList entry */
+        work->cur_frame_size = frame_size;
+        work->frame_id = frame_id;
+        work->frame_flags = frame_flags;
+
+        if (id3v2_parse_frame (work)) {
+          GST_LOG ("Extracted frame with id %s", frame_id);
+        } else if (id3v2_tag_wanted (work, GST_TAG_ID3V2_FRAME)) {
+          GST_LOG ("Failed to extract frame with id %s", frame_id);
+          /* Rewind the frame data / size to pass the header too */
+          id3v2_add_id3v2_frame_blob_to_taglist (work,
+              work->hdr.frame_data - frame_hdr_size,
+              frame_hdr_size + frame_size);
+        }
       }
     }
     work->hdr.frame_data += frame_size;
@@ -64,6 +64,10 @@ typedef struct {
   /* To collect day/month from obsolete TDAT frame if it exists */
   guint pending_month;
   guint pending_day;
+
+  /* NULL-terminated array of the only gst tags to extract,
+   * or NULL to extract everything */
+  const gchar **tag_filter;
 } ID3TagsWorking;
 
 enum {
@@ -493,6 +493,10 @@ gboolean                gst_tag_list_add_id3_image (GstTagList   * tag_list,
 GST_EXPORT
 GstTagList *            gst_tag_list_from_id3v2_tag (GstBuffer * buffer);
 
+GST_EXPORT
+GstTagList *            gst_tag_list_from_id3v2_tag_filtered (GstBuffer * buffer,
+                                                              const gchar ** tags);
+
 GST_EXPORT
 guint                   gst_tag_get_id3v2_tag_size  (GstBuffer * buffer);
 
@@ -524,12 +528,29 @@ GstTagList *            gst_tag_list_from_exif_buffer (GstBuffer * buffer,
                                                        gint byte_order,
                                                        guint32 base_offset);
 
+GST_EXPORT
+GstTagList *            gst_tag_list_from_exif_buffer_filtered (GstBuffer * buffer,
+                                                                gint byte_order,
+                                                                guint32 base_offset,
+                                                                const gchar ** tags);
+
 GST_EXPORT
 GstTagList *            gst_tag_list_from_exif_buffer_with_tiff_header (
                                                       GstBuffer * buffer);
 
 /* other tag-related functions */
 
+GST_EXPORT
+const gchar *           gst_tag_intern_string          (const gchar * str);
+
+GST_EXPORT
+void                    gst_tag_intern_string_release  (const gchar * str);
+
+GST_EXPORT
+gboolean                gst_tag_list_get_string_interned (const GstTagList * list,
+                                                          const gchar      * tag,
+                                                          const gchar     ** value);
+
 GST_EXPORT
 gboolean                gst_tag_parse_extended_comment (const gchar  * ext_comment,
                                                         gchar       ** key,
@@ -587,5 +587,126 @@ alloc_failed:
     gst_buffer_unref (image);
     return NULL;
   }
+}
+
+/* process-wide pool of refcounted tag strings, maps the string to its
+ * refcount. The key of an entry owns the string memory. */
+static GHashTable *tag_string_pool = NULL;
+static GMutex tag_string_pool_lock;
+
+/**
+ * gst_tag_intern_string:
+ * @str: a string
+ *
+ * Acquires a reference to a pooled copy of @str from a process-wide pool
+ * of tag strings. All callers interning equal strings get the very same
+ * pointer, so applications keeping tag values from many streams around
+ * (artist and album names of a large collection, for example) only pay
+ * for one copy of each distinct string.
+ *
+ * Release the returned string with gst_tag_intern_string_release() when
+ * done with it; it is removed from the pool when the last reference is
+ * released.
+ *
+ * Returns: a pooled copy of @str, valid until released
+ *
+ * Since: 1.14
+ */
+const gchar *
+gst_tag_intern_string (const gchar * str)
+{
+  gpointer key, value;
+  gchar *pooled;
+
+  g_return_val_if_fail (str != NULL, NULL);
 
+  g_mutex_lock (&tag_string_pool_lock);
+  if (G_UNLIKELY (tag_string_pool == NULL))
+    tag_string_pool = g_hash_table_new (g_str_hash, g_str_equal);
+
+  if (g_hash_table_lookup_extended (tag_string_pool, str, &key, &value)) {
+    pooled = key;
+    g_hash_table_insert (tag_string_pool, pooled,
+        GINT_TO_POINTER (GPOINTER_TO_INT (value) + 1));
+  } else {
+    pooled = g_strdup (str);
+    g_hash_table_insert (tag_string_pool, pooled, GINT_TO_POINTER (1));
+  }
+  g_mutex_unlock (&tag_string_pool_lock);
+
+  return pooled;
+}
+
+/**
+ * gst_tag_intern_string_release:
+ * @str: a string returned by gst_tag_intern_string()
+ *
+ * Releases a reference to a pooled tag string. When the last reference
+ * is released the string is removed from the pool and freed.
+ *
+ * Since: 1.14
+ */
+void
+gst_tag_intern_string_release (const gchar * str)
+{
+  gpointer key, value;
+  gint refcount;
+
+  g_return_if_fail (str != NULL);
+
+  g_mutex_lock (&tag_string_pool_lock);
+  if (tag_string_pool == NULL ||
+      !g_hash_table_lookup_extended (tag_string_pool, str, &key, &value)) {
+    g_mutex_unlock (&tag_string_pool_lock);
+    g_warning ("%s: string '%s' is not in the tag string pool", G_STRFUNC,
+        str);
+    return;
+  }
+
+  refcount = GPOINTER_TO_INT (value) - 1;
+  if (refcount == 0) {
+    g_hash_table_remove (tag_string_pool, key);
+    g_free (key);
+  } else {
+    g_hash_table_insert (tag_string_pool, key, GINT_TO_POINTER (refcount));
+  }
+  g_mutex_unlock (&tag_string_pool_lock);
+}
+
+/**
+ * gst_tag_list_get_string_interned:
+ * @list: a #GstTagList
+ * @tag: tag to read out
+ * @value: (out) (transfer full): location for the interned string
+ *
+ * Like gst_tag_list_get_string(), but instead of copying the value this
+ * peeks it and returns a reference to a pooled copy acquired with
+ * gst_tag_intern_string(). Release it with
+ * gst_tag_intern_string_release() instead of g_free().
+ *
+ * Returns: %TRUE if a string value for @tag was found, otherwise %FALSE
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_tag_list_get_string_interned (const GstTagList * list, const gchar * tag,
+    const gchar ** value)
+{
+  const GValue *v;
+  const gchar *str;
+
+  g_return_val_if_fail (GST_IS_TAG_LIST (list), FALSE);
+  g_return_val_if_fail (tag != NULL, FALSE);
+  g_return_val_if_fail (value != NULL, FALSE);
+
+  v = gst_tag_list_get_value_index (list, tag, 0);
+  if (v == NULL || !G_VALUE_HOLDS_STRING (v))
+    return FALSE;
+
+  str = g_value_get_string (v);
+  if (str == NULL)
+    return FALSE;
+
+  *value = gst_tag_intern_string (str);
+  return TRUE;
 }
@@ -277,6 +277,112 @@ link_failed:
   }
 }
 
+/* Process-level cache of idle converter pipelines, keyed by the caps they
+ * were built for. Building and linking the pipeline is far more expensive
+ * than the actual conversion for small frames, so applications that convert
+ * many samples with the same caps (e.g. thumbnailers) get to skip it. */
+typedef struct
+{
+  GstCaps *from_caps;
+  GstCaps *to_caps;
+  GstElement *pipeline;
+  /* borrowed from the pipeline */
+  GstElement *src;
+  GstElement *sink;
+} CachedConvertPipeline;
+
+#define MAX_CACHED_CONVERT_PIPELINES 4
+
+static GMutex convert_pipeline_cache_lock;
+static GQueue convert_pipeline_cache = G_QUEUE_INIT;
+
+static void
+cached_convert_pipeline_free (CachedConvertPipeline * cached)
+{
+  gst_element_set_state (cached->pipeline, GST_STATE_NULL);
+  gst_object_unref (cached->pipeline);
+  gst_caps_unref (cached->from_caps);
+  gst_caps_unref (cached->to_caps);
+  g_slice_free (CachedConvertPipeline, cached);
+}
+
+/* Returns a pipeline for converting @from_caps to @to_caps, either taken
+ * from the cache or newly built. Pipelines for buffers with crop metadata
+ * carry buffer-specific crop settings and are never cached. */
+static GstElement *
+acquire_convert_frame_pipeline (GstElement ** src_element,
+    GstElement ** sink_element, const GstCaps * from_caps,
+    GstVideoCropMeta * cmeta, const GstCaps * to_caps, GError ** err)
+{
+  GList *l;
+
+  if (cmeta == NULL) {
+    g_mutex_lock (&convert_pipeline_cache_lock);
+    for (l = convert_pipeline_cache.head; l; l = l->next) {
+      CachedConvertPipeline *cached = l->data;
+
+      if (gst_caps_is_equal (cached->from_caps, from_caps) &&
+          gst_caps_is_equal (cached->to_caps, to_caps)) {
+        GstElement *pipeline = cached->pipeline;
+
+        *src_element = cached->src;
+        *sink_element = cached->sink;
+
+        g_queue_delete_link (&convert_pipeline_cache, l);
+        g_mutex_unlock (&convert_pipeline_cache_lock);
+
+        gst_caps_unref (cached->from_caps);
+        gst_caps_unref (cached->to_caps);
+        g_slice_free (CachedConvertPipeline, cached);
+
+        GST_DEBUG ("reusing cached conversion pipeline %" GST_PTR_FORMAT,
+            pipeline);
+        return pipeline;
+      }
+    }
+    g_mutex_unlock (&convert_pipeline_cache_lock);
+  }
+
+  return build_convert_frame_pipeline (src_element, sink_element, from_caps,
+      cmeta, to_caps, err);
+}
+
+/* Shuts down @pipeline and either stores it in the cache for later reuse
+ * or, if @reusable is FALSE or the cache is full, frees it. Takes ownership
+ * of the pipeline reference. */
+static void
+release_convert_frame_pipeline (GstElement * pipeline, GstElement * src,
+    GstElement * sink, const GstCaps * from_caps, const GstCaps * to_caps,
+    gboolean reusable)
+{
+  CachedConvertPipeline *cached;
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+
+  if (!reusable) {
+    gst_object_unref (pipeline);
+    return;
+  }
+
+  cached = g_slice_new0 (CachedConvertPipeline);
+  cached->from_caps = gst_caps_copy (from_caps);
+  cached->to_caps = gst_caps_copy (to_caps);
+  cached->pipeline = pipeline;
+  cached->src = src;
+  cached->sink = sink;
+
+  g_mutex_lock (&convert_pipeline_cache_lock);
+  g_queue_push_head (&convert_pipeline_cache, cached);
+  if (convert_pipeline_cache.length > MAX_CACHED_CONVERT_PIPELINES)
+    cached = g_queue_pop_tail (&convert_pipeline_cache);
+  else
+    cached = NULL;
+  g_mutex_unlock (&convert_pipeline_cache_lock);
+
+  if (cached)
+    cached_convert_pipeline_free (cached);
+}
+
 /**
  * gst_video_convert_sample:
  * @sample: a #GstSample
@@ -305,6 +411,7 @@ gst_video_convert_sample (GstSample * sample, const GstCaps * to_caps,
   GstCaps *from_caps, *to_caps_copy = NULL;
   GstFlowReturn ret;
   GstElement *pipeline, *src, *sink;
+  GstVideoCropMeta *cmeta;
   guint i, n;
 
   g_return_val_if_fail (sample != NULL, NULL);
@@ -327,9 +434,10 @@ gst_video_convert_sample (GstSample * sample, const GstCaps * to_caps,
     gst_caps_append_structure (to_caps_copy, s);
   }
 
+  cmeta = gst_buffer_get_video_crop_meta (buf);
   pipeline =
-      build_convert_frame_pipeline (&src, &sink, from_caps,
-      gst_buffer_get_video_crop_meta (buf), to_caps_copy, &err);
+      acquire_convert_frame_pipeline (&src, &sink, from_caps, cmeta,
+      to_caps_copy, &err);
   if (!pipeline)
     goto no_pipeline;
 
@@ -391,9 +499,9 @@ gst_video_convert_sample (GstSample * sample, const GstCaps * to_caps,
           "Could not convert video frame: timeout during conversion");
   }
 
-  gst_element_set_state (pipeline, GST_STATE_NULL);
   gst_object_unref (bus);
-  gst_object_unref (pipeline);
+  release_convert_frame_pipeline (pipeline, src, sink, from_caps,
+      to_caps_copy, cmeta == NULL);
   gst_caps_unref (to_caps_copy);
 
   return result;
@@ -416,6 +524,12 @@ typedef struct
 {
   GMutex mutex;
   GstElement *pipeline;
+  /* borrowed from the pipeline */
+  GstElement *src;
+  GstElement *sink;
+  GstCaps *from_caps;
+  GstCaps *to_caps;
+  gboolean reusable;
   GstVideoConvertSampleCallback callback;
   gpointer user_data;
   GDestroyNotify destroy_notify;
@@ -423,6 +537,7 @@ typedef struct
   GstSample *sample;
   //GstBuffer *buffer;
   GSource *timeout_source;
+  GSource *bus_watch;
   gboolean finished;
 } GstVideoConvertSampleContext;
 
@@ -447,14 +562,25 @@ gst_video_convert_frame_context_free (GstVideoConvertSampleContext * ctx)
   g_mutex_clear (&ctx->mutex);
   if (ctx->timeout_source)
     g_source_destroy (ctx->timeout_source);
+  if (ctx->bus_watch) {
+    g_source_destroy (ctx->bus_watch);
+    g_source_unref (ctx->bus_watch);
+  }
   //if (ctx->buffer)
   //  gst_buffer_unref (ctx->buffer);
   if (ctx->sample)
     gst_sample_unref (ctx->sample);
   g_main_context_unref (ctx->context);
 
-  gst_element_set_state (ctx->pipeline, GST_STATE_NULL);
-  gst_object_unref (ctx->pipeline);
+  /* make sure nothing references us anymore before the pipeline is
+   * potentially handed to another conversion */
+  g_signal_handlers_disconnect_by_data (ctx->src, ctx);
+  g_signal_handlers_disconnect_by_data (ctx->sink, ctx);
+
+  release_convert_frame_pipeline (ctx->pipeline, ctx->src, ctx->sink,
+      ctx->from_caps, ctx->to_caps, ctx->reusable);
+  gst_caps_unref (ctx->from_caps);
+  gst_caps_unref (ctx->to_caps);
 
   g_slice_free (GstVideoConvertSampleContext, ctx);
 }
@@ -663,6 +789,7 @@ gst_video_convert_sample_async (GstSample * sample,
   GstBuffer *buf;
   GstCaps *from_caps, *to_caps_copy = NULL;
   GstElement *pipeline, *src, *sink;
+  GstVideoCropMeta *cmeta;
   guint i, n;
   GSource *source;
   GstVideoConvertSampleContext *ctx;
@@ -692,9 +819,10 @@ gst_video_convert_sample_async (GstSample * sample,
     gst_caps_append_structure (to_caps_copy, s);
   }
 
+  cmeta = gst_buffer_get_video_crop_meta (buf);
   pipeline =
-      build_convert_frame_pipeline (&src, &sink, from_caps,
-      gst_buffer_get_video_crop_meta (buf), to_caps_copy, &error);
+      acquire_convert_frame_pipeline (&src, &sink, from_caps, cmeta,
+      to_caps_copy, &error);
   if (!pipeline)
     goto no_pipeline;
 
@@ -710,6 +838,11 @@ gst_video_convert_sample_async (GstSample * sample,
   ctx->context = g_main_context_ref (context);
   ctx->finished = FALSE;
   ctx->pipeline = pipeline;
+  ctx->src = src;
+  ctx->sink = sink;
+  ctx->from_caps = gst_caps_copy (from_caps);
+  ctx->to_caps = gst_caps_ref (to_caps_copy);
+  ctx->reusable = (cmeta == NULL);
 
   if (timeout != GST_CLOCK_TIME_NONE) {
     ctx->timeout_source = g_timeout_source_new (timeout / GST_MSECOND);
@@ -727,7 +860,7 @@ gst_video_convert_sample_async (GstSample * sample,
   g_source_set_callback (source, (GSourceFunc) convert_frame_bus_callback,
       ctx, NULL);
   g_source_attach (source, context);
-  g_source_unref (source);
+  ctx->bus_watch = source;
 
   gst_element_set_state (pipeline, GST_STATE_PLAYING);
 
@@ -275,6 +275,10 @@
  *  Leftover buffer 1 cannot be decoded and must be discarded.
  */
 
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
 #include "gstvideodecoder.h"
 #include "gstvideoutils.h"
 #include "gstvideoutilsprivate.h"
@@ -283,7 +287,12 @@
 #include <gst/video/video-event.h>
 #include <gst/video/gstvideopool.h>
 #include <gst/video/gstvideometa.h>
+#include <glib/gstdio.h>
 #include <string.h>
+#include <errno.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
 
 GST_DEBUG_CATEGORY (videodecoder_debug);
 #define GST_CAT_DEFAULT videodecoder_debug
@@ -292,6 +301,29 @@ GST_DEBUG_CATEGORY (videodecoder_debug);
     (G_TYPE_INSTANCE_GET_PRIVATE ((obj), GST_TYPE_VIDEO_DECODER, \
         GstVideoDecoderPrivate))
 
+#define DEFAULT_MAX_REVERSE_MEMORY 0
+
+/* log2-ms histogram of the time spent in the subclass per frame */
+#define N_TIMING_BUCKETS 14
+
+/* predictive QoS: decode-time model classes and EWMA parameters */
+#define QOS_MODEL_DELTA 0
+#define QOS_MODEL_SYNC 1
+#define QOS_MODEL_CLASSES 2
+/* samples needed before the model is trusted to drop anything */
+#define QOS_MODEL_MIN_SAMPLES 8
+/* EWMA weight, new samples count for 1/8 */
+#define QOS_MODEL_WEIGHT 8
+
+enum
+{
+  PROP_0,
+  PROP_MAX_REVERSE_MEMORY,
+  PROP_ENABLE_STATS,
+  PROP_STATS,
+  PROP_PREDICTIVE_QOS
+};
+
 struct _GstVideoDecoderPrivate
 {
   /* FIXME introduce a context ? */
@@ -300,6 +332,12 @@ struct _GstVideoDecoderPrivate
   GstAllocator *allocator;
   GstAllocationParams params;
 
+  /* maximum geometry to negotiate output allocation for, 0/0 when disabled.
+   * Within this envelope the pool is kept across renegotiations and the
+   * GstVideoMeta on each output buffer is adjusted to the actual geometry */
+  guint alloc_headroom_width;
+  guint alloc_headroom_height;
+
   /* parse tracking */
   /* input data */
   GstAdapter *input_adapter;
@@ -313,6 +351,10 @@ struct _GstVideoDecoderPrivate
   /* Whether input is considered packetized or not */
   gboolean packetized;
 
+  /* Whether input buffers are subframes (e.g. slices) of the current frame
+   * rather than complete access units */
+  gboolean subframe_mode;
+
   /* Error handling */
   gint max_errors;
   gint error_count;
@@ -356,6 +398,22 @@ struct _GstVideoDecoderPrivate
   /* collected output - of buffer objects, not frames */
   GList *output_queued;
 
+  /* memory budget for gathered buffers before spilling to disk, 0 = never */
+  guint64 max_reverse_memory;
+  /* bytes held by the gathered input buffers */
+  guint64 gather_size;
+  /* coldest gathered buffer that has not been spilled to disk yet */
+  GList *gather_cold;
+  /* maps gathered buffers to their location in the spill file */
+  GHashTable *spill_index;
+
+  /* recycles frame structures to avoid per-frame allocations */
+  GstVideoCodecFramePool *frame_pool;
+  /* unlinked temporary file holding spilled buffer content */
+  gint spill_fd;
+  /* write position in the spill file */
+  guint64 spill_offset;
+
 
   /* base_picture_number is the picture number of the reference picture */
   guint64 base_picture_number;
@@ -369,7 +427,10 @@ struct _GstVideoDecoderPrivate
   guint32 system_frame_number;
   guint32 decode_frame_number;
 
-  GList *frames;                /* Protected with OBJECT_LOCK */
+  /* Pending frames in decode order; frames_index maps a frame's
+   * system_frame_number to its queue link for O(1) lookup and removal. */
+  GQueue frames;                /* Protected with OBJECT_LOCK */
+  GHashTable *frames_index;     /* Protected with OBJECT_LOCK */
   GstVideoCodecState *input_state;
   GstVideoCodecState *output_state;     /* OBJECT_LOCK and STREAM_LOCK */
   gboolean output_state_changed;
@@ -402,6 +463,23 @@ struct _GstVideoDecoderPrivate
   /* flags */
   gboolean use_default_pad_acceptcaps;
 
+  /* predictive QoS, model state under OBJECT_LOCK */
+  gboolean predictive_qos;
+  /* EWMA of the decode time per frame class, in microseconds */
+  guint64 qos_decode_time[QOS_MODEL_CLASSES];
+  guint qos_samples[QOS_MODEL_CLASSES];
+  /* TRUE directly after a predictive drop, cleared by the next decoded
+   * frame so drops are spread instead of hitting runs of frames */
+  gboolean qos_dropped_last;
+
+  /* handle_frame() timing statistics, all counters under OBJECT_LOCK */
+  gboolean enable_stats;
+  guint64 stat_frames;
+  guint64 stat_time_sum;        /* microseconds */
+  guint64 stat_time_max;
+  guint64 stat_time_hist[N_TIMING_BUCKETS];
+  guint stat_max_queued;
+
 #ifndef GST_DISABLE_DEBUG
   /* Diagnostic time for reporting the time
    * from flush to first output */
@@ -415,6 +493,11 @@ static void gst_video_decoder_init (GstVideoDecoder * dec,
     GstVideoDecoderClass * klass);
 
 static void gst_video_decoder_finalize (GObject * object);
+static GstStructure *gst_video_decoder_create_stats (GstVideoDecoder * decoder);
+static void gst_video_decoder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_video_decoder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
 
 static gboolean gst_video_decoder_setcaps (GstVideoDecoder * dec,
     GstCaps * caps);
@@ -435,6 +518,8 @@ static void gst_video_decoder_reset (GstVideoDecoder * decoder, gboolean full,
 
 static GstFlowReturn gst_video_decoder_decode_frame (GstVideoDecoder * decoder,
     GstVideoCodecFrame * frame);
+static GstFlowReturn gst_video_decoder_decode_subframe (GstVideoDecoder *
+    decoder, GstVideoCodecFrame * frame, GstBuffer * buf);
 
 static void gst_video_decoder_push_event_list (GstVideoDecoder * decoder,
     GList * events);
@@ -514,6 +599,82 @@ gst_video_decoder_class_init (GstVideoDecoderClass * klass)
   g_type_class_add_private (klass, sizeof (GstVideoDecoderPrivate));
 
   gobject_class->finalize = gst_video_decoder_finalize;
+  gobject_class->set_property = gst_video_decoder_set_property;
+  gobject_class->get_property = gst_video_decoder_get_property;
+
+  /**
+   * GstVideoDecoder:max-reverse-memory:
+   *
+   * Maximum number of bytes of input gathered for reverse playback to
+   * keep in memory; beyond this budget the coldest gathered buffers are
+   * spilled to an unlinked temporary file and read back when they are
+   * decoded. 0 keeps everything in memory.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_REVERSE_MEMORY,
+      g_param_spec_uint64 ("max-reverse-memory", "Max reverse memory",
+          "Maximum memory to use for buffers gathered for reverse playback "
+          "before spilling to disk (in bytes, 0 = unlimited)",
+          0, G_MAXUINT64, DEFAULT_MAX_REVERSE_MEMORY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstVideoDecoder:enable-stats:
+   *
+   * Enable recording of handle_frame() timing statistics. Off by
+   * default since it adds two monotonic clock reads per frame.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_ENABLE_STATS,
+      g_param_spec_boolean ("enable-stats", "Enable stats",
+          "Record decode timing statistics for the stats property",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstVideoDecoder:stats:
+   *
+   * A #GstStructure "video-decoder-stats" with the statistics recorded
+   * since the decoder was started, all times in microseconds:
+   *
+   * * "frames" G_TYPE_UINT64 number of timed handle_frame() calls
+   * * "avg-time" G_TYPE_UINT64 average time spent in handle_frame()
+   * * "max-time" G_TYPE_UINT64 longest handle_frame() call
+   * * "time-histogram" #GST_TYPE_ARRAY of G_TYPE_UINT64 counters; bucket 0
+   *   counts calls that took less than 1 millisecond, bucket n calls that
+   *   took between 2^(n-1) and 2^n milliseconds and the last bucket
+   *   everything longer
+   * * "current-queued-frames" G_TYPE_UINT frames pending in the decoder
+   * * "max-queued-frames" G_TYPE_UINT highest number of pending frames
+   *
+   * All zero unless #GstVideoDecoder:enable-stats has been set.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Decode timing statistics", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstVideoDecoder:predictive-qos:
+   *
+   * Drop frames before decoding when a model of past decode times says
+   * the QoS deadline will be missed anyway. The base class keeps one
+   * decode-time EWMA per frame class (sync points and delta frames) and
+   * drops delta frames whose predicted decode time exceeds the time left
+   * until their deadline. At most every second frame is dropped this
+   * way, so overload spreads drops smoothly instead of stalling on a
+   * late frame and then dumping the rest of the GOP. Sync points are
+   * never dropped.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_PREDICTIVE_QOS,
+      g_param_spec_boolean ("predictive-qos", "Predictive QoS",
+          "Proactively drop delta frames predicted to miss their deadline",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_video_decoder_change_state);
@@ -570,8 +731,16 @@ gst_video_decoder_init (GstVideoDecoder * decoder, GstVideoDecoderClass * klass)
 
   decoder->priv->input_adapter = gst_adapter_new ();
   decoder->priv->output_adapter = gst_adapter_new ();
+  g_queue_init (&decoder->priv->frames);
+  decoder->priv->frames_index = g_hash_table_new (NULL, NULL);
+  decoder->priv->max_reverse_memory = DEFAULT_MAX_REVERSE_MEMORY;
+  decoder->priv->spill_index = g_hash_table_new_full (NULL, NULL, NULL, g_free);
+  decoder->priv->spill_fd = -1;
+  decoder->priv->frame_pool = __gst_video_codec_frame_pool_new ();
   decoder->priv->packetized = TRUE;
   decoder->priv->needs_format = FALSE;
+  decoder->priv->alloc_headroom_width = 0;
+  decoder->priv->alloc_headroom_height = 0;
 
   decoder->priv->min_latency = 0;
   decoder->priv->max_latency = 0;
@@ -754,6 +923,22 @@ gst_video_decoder_finalize (GObject * object)
     g_object_unref (decoder->priv->output_adapter);
     decoder->priv->output_adapter = NULL;
   }
+  if (decoder->priv->frames_index) {
+    g_hash_table_destroy (decoder->priv->frames_index);
+    decoder->priv->frames_index = NULL;
+  }
+  if (decoder->priv->spill_index) {
+    g_hash_table_destroy (decoder->priv->spill_index);
+    decoder->priv->spill_index = NULL;
+  }
+  if (decoder->priv->spill_fd >= 0) {
+    g_close (decoder->priv->spill_fd, NULL);
+    decoder->priv->spill_fd = -1;
+  }
+  if (decoder->priv->frame_pool) {
+    __gst_video_codec_frame_pool_release (decoder->priv->frame_pool);
+    decoder->priv->frame_pool = NULL;
+  }
 
   if (decoder->priv->input_state)
     gst_video_codec_state_unref (decoder->priv->input_state);
@@ -773,6 +958,185 @@ gst_video_decoder_finalize (GObject * object)
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+static void
+gst_video_decoder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstVideoDecoder *decoder = GST_VIDEO_DECODER (object);
+
+  switch (prop_id) {
+    case PROP_MAX_REVERSE_MEMORY:
+      GST_OBJECT_LOCK (decoder);
+      decoder->priv->max_reverse_memory = g_value_get_uint64 (value);
+      GST_OBJECT_UNLOCK (decoder);
+      break;
+    case PROP_ENABLE_STATS:
+      GST_OBJECT_LOCK (decoder);
+      decoder->priv->enable_stats = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (decoder);
+      break;
+    case PROP_PREDICTIVE_QOS:
+      GST_OBJECT_LOCK (decoder);
+      decoder->priv->predictive_qos = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (decoder);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_video_decoder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVideoDecoder *decoder = GST_VIDEO_DECODER (object);
+
+  switch (prop_id) {
+    case PROP_MAX_REVERSE_MEMORY:
+      GST_OBJECT_LOCK (decoder);
+      g_value_set_uint64 (value, decoder->priv->max_reverse_memory);
+      GST_OBJECT_UNLOCK (decoder);
+      break;
+    case PROP_ENABLE_STATS:
+      GST_OBJECT_LOCK (decoder);
+      g_value_set_boolean (value, decoder->priv->enable_stats);
+      GST_OBJECT_UNLOCK (decoder);
+      break;
+    case PROP_STATS:
+      g_value_take_boxed (value, gst_video_decoder_create_stats (decoder));
+      break;
+    case PROP_PREDICTIVE_QOS:
+      GST_OBJECT_LOCK (decoder);
+      g_value_set_boolean (value, decoder->priv->predictive_qos);
+      GST_OBJECT_UNLOCK (decoder);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/* records one timed subclass call of @elapsed microseconds together with
+ * the current depth of the pending frame queue */
+static void
+gst_video_decoder_stats_record (GstVideoDecoder * decoder, gint64 elapsed)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  guint64 ms;
+  guint bucket = 0;
+
+  GST_OBJECT_LOCK (decoder);
+  priv->stat_frames++;
+  priv->stat_time_sum += elapsed;
+  if ((guint64) elapsed > priv->stat_time_max)
+    priv->stat_time_max = elapsed;
+  for (ms = elapsed / 1000; ms > 0; ms >>= 1) {
+    if (++bucket == N_TIMING_BUCKETS - 1)
+      break;
+  }
+  priv->stat_time_hist[bucket]++;
+  if (priv->frames.length > priv->stat_max_queued)
+    priv->stat_max_queued = priv->frames.length;
+  GST_OBJECT_UNLOCK (decoder);
+}
+
+static GstStructure *
+gst_video_decoder_create_stats (GstVideoDecoder * decoder)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstStructure *s;
+  GValue hist = G_VALUE_INIT;
+  GValue v = G_VALUE_INIT;
+  guint64 avg;
+  gint i;
+
+  GST_OBJECT_LOCK (decoder);
+  avg = priv->stat_frames ? priv->stat_time_sum / priv->stat_frames : 0;
+  s = gst_structure_new ("video-decoder-stats",
+      "frames", G_TYPE_UINT64, priv->stat_frames,
+      "avg-time", G_TYPE_UINT64, avg,
+      "max-time", G_TYPE_UINT64, priv->stat_time_max,
+      "current-queued-frames", G_TYPE_UINT, priv->frames.length,
+      "max-queued-frames", G_TYPE_UINT, priv->stat_max_queued, NULL);
+
+  g_value_init (&hist, GST_TYPE_ARRAY);
+  g_value_init (&v, G_TYPE_UINT64);
+  for (i = 0; i < N_TIMING_BUCKETS; i++) {
+    g_value_set_uint64 (&v, priv->stat_time_hist[i]);
+    gst_value_array_append_value (&hist, &v);
+  }
+  g_value_unset (&v);
+  gst_structure_take_value (s, "time-histogram", &hist);
+  GST_OBJECT_UNLOCK (decoder);
+
+  return s;
+}
+
+/* folds one measured decode time of @elapsed microseconds into the
+ * predictive QoS model */
+static void
+gst_video_decoder_qos_update_model (GstVideoDecoder * decoder,
+    gboolean sync_point, gint64 elapsed)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  gint idx = sync_point ? QOS_MODEL_SYNC : QOS_MODEL_DELTA;
+
+  GST_OBJECT_LOCK (decoder);
+  if (priv->qos_samples[idx] == 0)
+    priv->qos_decode_time[idx] = elapsed;
+  else
+    priv->qos_decode_time[idx] +=
+        ((gint64) elapsed -
+        (gint64) priv->qos_decode_time[idx]) / QOS_MODEL_WEIGHT;
+  priv->qos_samples[idx]++;
+  priv->qos_dropped_last = FALSE;
+  GST_OBJECT_UNLOCK (decoder);
+}
+
+/* decides whether @frame should be dropped before decoding because the
+ * model predicts its deadline will be missed */
+static gboolean
+gst_video_decoder_qos_predict_late (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstClockTimeDiff deadline;
+  guint64 estimate;
+  gboolean trained, spread;
+
+  /* sync points are never dropped, their loss would corrupt everything
+   * until the next one */
+  if (GST_VIDEO_CODEC_FRAME_IS_SYNC_POINT (frame))
+    return FALSE;
+
+  GST_OBJECT_LOCK (decoder);
+  trained = priv->qos_samples[QOS_MODEL_DELTA] >= QOS_MODEL_MIN_SAMPLES;
+  spread = priv->qos_dropped_last;
+  estimate = priv->qos_decode_time[QOS_MODEL_DELTA] * GST_USECOND;
+  GST_OBJECT_UNLOCK (decoder);
+
+  /* after a predictive drop at least one frame is decoded before the
+   * model may drop again */
+  if (!trained || spread)
+    return FALSE;
+
+  deadline = gst_video_decoder_get_max_decode_time (decoder, frame);
+  if (deadline == G_MAXINT64 || (GstClockTimeDiff) estimate <= deadline)
+    return FALSE;
+
+  GST_DEBUG_OBJECT (decoder, "predicted decode time %" GST_TIME_FORMAT
+      " exceeds deadline in %" GST_STIME_FORMAT ", dropping frame %d",
+      GST_TIME_ARGS (estimate), GST_STIME_ARGS (deadline),
+      frame->system_frame_number);
+
+  GST_OBJECT_LOCK (decoder);
+  priv->qos_dropped_last = TRUE;
+  GST_OBJECT_UNLOCK (decoder);
+
+  return TRUE;
+}
+
 /* hard == FLUSH, otherwise discont */
 static GstFlowReturn
 gst_video_decoder_flush (GstVideoDecoder * dec, gboolean hard)
@@ -1296,7 +1660,7 @@ gst_video_decoder_sink_event_default (GstVideoDecoder * decoder,
       GList *l;
 
       GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-      for (l = priv->frames; l; l = l->next) {
+      for (l = priv->frames.head; l; l = l->next) {
         GstVideoCodecFrame *frame = l->data;
 
         frame->events = _flush_events (decoder->srcpad, frame->events);
@@ -1969,11 +2333,154 @@ gst_video_decoder_get_buffer_info_at_offset (GstVideoDecoder *
       GST_TIME_ARGS (*pts), GST_TIME_ARGS (*dts), *flags, got_offset, offset);
 }
 
+/* A buffer gathered for reverse playback whose content has been written
+ * to the spill file; the buffer itself stays in the gather/parse queues
+ * with its memory removed until it is needed for decoding. */
+typedef struct
+{
+  guint64 offset;
+  gsize size;
+} GstVideoDecoderSpillRecord;
+
+/* Write the content of @buf to the spill file and drop its memory,
+ * keeping the buffer (and thus its timestamps and flags) in the queue.
+ * Call with the stream lock. */
+static gboolean
+gst_video_decoder_spill_buffer (GstVideoDecoder * dec, GstBuffer * buf)
+{
+#ifdef HAVE_UNISTD_H
+  GstVideoDecoderPrivate *priv = dec->priv;
+  GstVideoDecoderSpillRecord *rec;
+  GstMapInfo map;
+
+  /* a non-writable buffer is shared with someone else, removing its
+   * memory would corrupt it for them */
+  if (!gst_buffer_is_writable (buf))
+    return FALSE;
+
+  if (priv->spill_fd < 0) {
+    GError *err = NULL;
+    gchar *name = NULL;
+
+    priv->spill_fd = g_file_open_tmp ("gstvideodec-XXXXXX", &name, &err);
+    if (priv->spill_fd < 0) {
+      GST_WARNING_OBJECT (dec, "failed to create spill file: %s",
+          err->message);
+      g_error_free (err);
+      return FALSE;
+    }
+    /* unlink right away, the descriptor keeps the file alive */
+    g_unlink (name);
+    g_free (name);
+  }
+
+  if (!gst_buffer_map (buf, &map, GST_MAP_READ))
+    return FALSE;
+
+  if (lseek (priv->spill_fd, priv->spill_offset, SEEK_SET) < 0 ||
+      write (priv->spill_fd, map.data, map.size) != (gssize) map.size) {
+    GST_WARNING_OBJECT (dec, "failed to write spill file: %s",
+        g_strerror (errno));
+    gst_buffer_unmap (buf, &map);
+    return FALSE;
+  }
+  gst_buffer_unmap (buf, &map);
+
+  rec = g_new (GstVideoDecoderSpillRecord, 1);
+  rec->offset = priv->spill_offset;
+  rec->size = gst_buffer_get_size (buf);
+  priv->spill_offset += rec->size;
+
+  GST_LOG_OBJECT (dec, "spilled buffer %p, %" G_GSIZE_FORMAT " bytes @ %"
+      G_GUINT64_FORMAT, buf, rec->size, rec->offset);
+
+  gst_buffer_remove_all_memory (buf);
+  g_hash_table_insert (priv->spill_index, buf, rec);
+
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
+/* Read the content of a previously spilled buffer back from the spill
+ * file. Call with the stream lock. */
+static void
+gst_video_decoder_unspill_buffer (GstVideoDecoder * dec, GstBuffer * buf)
+{
+#ifdef HAVE_UNISTD_H
+  GstVideoDecoderPrivate *priv = dec->priv;
+  GstVideoDecoderSpillRecord *rec;
+  GstMapInfo map;
+  GstMemory *mem;
+
+  rec = g_hash_table_lookup (priv->spill_index, buf);
+  if (rec == NULL)
+    return;
+
+  GST_LOG_OBJECT (dec, "restoring buffer %p, %" G_GSIZE_FORMAT " bytes @ %"
+      G_GUINT64_FORMAT, buf, rec->size, rec->offset);
+
+  mem = gst_allocator_alloc (NULL, rec->size, NULL);
+  gst_memory_map (mem, &map, GST_MAP_WRITE);
+  if (lseek (priv->spill_fd, rec->offset, SEEK_SET) < 0 ||
+      read (priv->spill_fd, map.data, map.size) != (gssize) map.size) {
+    GST_ERROR_OBJECT (dec, "failed to read back spilled buffer: %s",
+        g_strerror (errno));
+  }
+  gst_memory_unmap (mem, &map);
+  gst_buffer_append_memory (buf, mem);
+
+  g_hash_table_remove (priv->spill_index, buf);
+#endif
+}
+
+/* Spill gathered buffers, coldest first, until the gather queue is back
+ * within the configured memory budget. Call with the stream lock. */
+static void
+gst_video_decoder_spill_gather (GstVideoDecoder * dec)
+{
+  GstVideoDecoderPrivate *priv = dec->priv;
+  guint64 max_memory;
+
+  GST_OBJECT_LOCK (dec);
+  max_memory = priv->max_reverse_memory;
+  GST_OBJECT_UNLOCK (dec);
+
+  if (max_memory == 0)
+    return;
+
+  while (priv->gather_cold && priv->gather_size > max_memory) {
+    GstBuffer *buf = priv->gather_cold->data;
+    gsize size = gst_buffer_get_size (buf);
+
+    if (size > 0) {
+      if (!gst_video_decoder_spill_buffer (dec, buf))
+        break;
+      priv->gather_size -= size;
+    }
+    priv->gather_cold = priv->gather_cold->prev;
+  }
+}
+
+static void
+gst_video_decoder_clear_spill (GstVideoDecoder * dec)
+{
+  GstVideoDecoderPrivate *priv = dec->priv;
+
+  g_hash_table_remove_all (priv->spill_index);
+  priv->gather_size = 0;
+  priv->gather_cold = NULL;
+  priv->spill_offset = 0;
+}
+
 static void
 gst_video_decoder_clear_queues (GstVideoDecoder * dec)
 {
   GstVideoDecoderPrivate *priv = dec->priv;
 
+  gst_video_decoder_clear_spill (dec);
+
   g_list_free_full (priv->output_queued,
       (GDestroyNotify) gst_mini_object_unref);
   priv->output_queued = NULL;
@@ -1987,8 +2494,10 @@ gst_video_decoder_clear_queues (GstVideoDecoder * dec)
   g_list_free_full (priv->parse_gather,
       (GDestroyNotify) gst_video_codec_frame_unref);
   priv->parse_gather = NULL;
-  g_list_free_full (priv->frames, (GDestroyNotify) gst_video_codec_frame_unref);
-  priv->frames = NULL;
+  g_hash_table_remove_all (priv->frames_index);
+  g_list_free_full (priv->frames.head,
+      (GDestroyNotify) gst_video_codec_frame_unref);
+  g_queue_init (&priv->frames);
 }
 
 static void
@@ -2055,6 +2564,18 @@ gst_video_decoder_reset (GstVideoDecoder * decoder, gboolean full,
     priv->dropped = 0;
     priv->processed = 0;
 
+    GST_OBJECT_LOCK (decoder);
+    priv->stat_frames = 0;
+    priv->stat_time_sum = 0;
+    priv->stat_time_max = 0;
+    memset (priv->stat_time_hist, 0, sizeof (priv->stat_time_hist));
+    priv->stat_max_queued = 0;
+
+    memset (priv->qos_decode_time, 0, sizeof (priv->qos_decode_time));
+    memset (priv->qos_samples, 0, sizeof (priv->qos_samples));
+    priv->qos_dropped_last = FALSE;
+    GST_OBJECT_UNLOCK (decoder);
+
     priv->decode_frame_number = 0;
     priv->base_picture_number = 0;
 
@@ -2132,15 +2653,23 @@ gst_video_decoder_chain_forward (GstVideoDecoder * decoder,
       GST_VIDEO_CODEC_FRAME_SET_SYNC_POINT (priv->current_frame);
     }
 
-    priv->current_frame->input_buffer = buf;
-
-    if (decoder->input_segment.rate < 0.0) {
-      priv->parse_gather =
-          g_list_prepend (priv->parse_gather, priv->current_frame);
+    if (priv->subframe_mode && klass->handle_subframe != NULL
+        && decoder->input_segment.rate > 0.0) {
+      /* hand the slice to the subclass right away; the frame stays
+       * current until the last subframe has been collected */
+      ret = gst_video_decoder_decode_subframe (decoder, priv->current_frame,
+          buf);
     } else {
-      ret = gst_video_decoder_decode_frame (decoder, priv->current_frame);
+      priv->current_frame->input_buffer = buf;
+
+      if (decoder->input_segment.rate < 0.0) {
+        priv->parse_gather =
+            g_list_prepend (priv->parse_gather, priv->current_frame);
+      } else {
+        ret = gst_video_decoder_decode_frame (decoder, priv->current_frame);
+      }
+      priv->current_frame = NULL;
     }
-    priv->current_frame = NULL;
     /* If in trick mode and it was a keyframe, drain decoder to avoid extra
      * latency. Only do this for forwards playback as reverse playback handles
      * draining on keyframes in flush_parse(), and would otherwise call back
@@ -2148,7 +2677,8 @@ gst_video_decoder_chain_forward (GstVideoDecoder * decoder,
      * Also this function is only called for reverse playback to gather frames
      * GOP by GOP, and does not do any actual decoding. That would be done by
      * flush_decode() */
-    if (ret == GST_FLOW_OK && was_keyframe && decoder->input_segment.rate > 0.0
+    if (ret == GST_FLOW_OK && was_keyframe && priv->current_frame == NULL
+        && decoder->input_segment.rate > 0.0
         && (decoder->input_segment.flags & GST_SEEK_FLAG_TRICKMODE_KEY_UNITS))
       ret = gst_video_decoder_drain_out (decoder, FALSE);
   } else {
@@ -2221,6 +2751,10 @@ gst_video_decoder_flush_parse (GstVideoDecoder * dec, gboolean at_eos)
   priv->gather = g_list_reverse (priv->gather);
   priv->parse = g_list_concat (priv->gather, priv->parse);
   priv->gather = NULL;
+  /* spilled buffers now belong to the parse list and are read back as
+   * they get decoded below */
+  priv->gather_size = 0;
+  priv->gather_cold = NULL;
 
   /* clear buffer and decoder state */
   gst_video_decoder_flush (dec, FALSE);
@@ -2235,6 +2769,9 @@ gst_video_decoder_flush_parse (GstVideoDecoder * dec, gboolean at_eos)
         GST_TIME_ARGS (GST_BUFFER_PTS (buf)),
         GST_TIME_ARGS (GST_BUFFER_DTS (buf)), GST_BUFFER_FLAGS (buf));
 
+    /* bring back any content that was spilled to disk while gathering */
+    gst_video_decoder_unspill_buffer (dec, buf);
+
     /* parse buffer, resulting frames prepended to parse_gather queue */
     gst_buffer_ref (buf);
     res = gst_video_decoder_chain_forward (dec, buf, at_eos);
@@ -2403,6 +2940,12 @@ gst_video_decoder_chain_reverse (GstVideoDecoder * dec, GstBuffer * buf)
 
     /* add buffer to gather queue */
     priv->gather = g_list_prepend (priv->gather, buf);
+    priv->gather_size += gst_buffer_get_size (buf);
+    if (priv->gather_cold == NULL)
+      priv->gather_cold = priv->gather;
+
+    /* and move cold buffers out to disk if a memory budget is set */
+    gst_video_decoder_spill_gather (dec);
   }
 
   return result;
@@ -2563,9 +3106,7 @@ gst_video_decoder_new_frame (GstVideoDecoder * decoder)
   GstVideoDecoderPrivate *priv = decoder->priv;
   GstVideoCodecFrame *frame;
 
-  frame = g_slice_new0 (GstVideoCodecFrame);
-
-  frame->ref_count = 1;
+  frame = __gst_video_codec_frame_pool_acquire (priv->frame_pool);
 
   GST_VIDEO_DECODER_STREAM_LOCK (decoder);
   frame->system_frame_number = priv->system_frame_number;
@@ -2610,7 +3151,7 @@ gst_video_decoder_prepare_finish_frame (GstVideoDecoder *
 
 #ifndef GST_DISABLE_GST_DEBUG
   GST_LOG_OBJECT (decoder, "n %d in %" G_GSIZE_FORMAT " out %" G_GSIZE_FORMAT,
-      g_list_length (priv->frames),
+      priv->frames.length,
       gst_adapter_available (priv->input_adapter),
       gst_adapter_available (priv->output_adapter));
 #endif
@@ -2624,7 +3165,7 @@ gst_video_decoder_prepare_finish_frame (GstVideoDecoder *
       sync, GST_TIME_ARGS (frame->pts), GST_TIME_ARGS (frame->dts));
 
   /* Push all pending events that arrived before this frame */
-  for (l = priv->frames; l; l = l->next) {
+  for (l = priv->frames.head; l; l = l->next) {
     GstVideoCodecFrame *tmp = l->data;
 
     if (tmp->events) {
@@ -2684,7 +3225,7 @@ gst_video_decoder_prepare_finish_frame (GstVideoDecoder *
     gboolean seen_none = FALSE;
 
     /* some maintenance regardless */
-    for (l = priv->frames; l; l = l->next) {
+    for (l = priv->frames.head; l; l = l->next) {
       GstVideoCodecFrame *tmp = l->data;
 
       if (!GST_CLOCK_TIME_IS_VALID (tmp->abidata.ABI.ts)) {
@@ -2718,7 +3259,7 @@ gst_video_decoder_prepare_finish_frame (GstVideoDecoder *
     /* some more maintenance, ts2 holds PTS */
     min_ts = GST_CLOCK_TIME_NONE;
     seen_none = FALSE;
-    for (l = priv->frames; l; l = l->next) {
+    for (l = priv->frames.head; l; l = l->next) {
       GstVideoCodecFrame *tmp = l->data;
 
       if (!GST_CLOCK_TIME_IS_VALID (tmp->abidata.ABI.ts2)) {
@@ -2814,10 +3355,13 @@ gst_video_decoder_release_frame (GstVideoDecoder * dec,
 
   /* unref once from the list */
   GST_VIDEO_DECODER_STREAM_LOCK (dec);
-  link = g_list_find (dec->priv->frames, frame);
-  if (link) {
+  link = g_hash_table_lookup (dec->priv->frames_index,
+      GUINT_TO_POINTER (frame->system_frame_number));
+  if (link && link->data == frame) {
+    g_hash_table_remove (dec->priv->frames_index,
+        GUINT_TO_POINTER (frame->system_frame_number));
+    g_queue_delete_link (&dec->priv->frames, link);
     gst_video_codec_frame_unref (frame);
-    dec->priv->frames = g_list_delete_link (dec->priv->frames, link);
   }
   if (frame->events) {
     dec->priv->pending_events =
@@ -3067,6 +3611,36 @@ done:
   return ret;
 }
 
+/**
+ * gst_video_decoder_finish_subframe:
+ * @decoder: a #GstVideoDecoder
+ * @frame: (transfer none): the #GstVideoCodecFrame
+ *
+ * Indicate that one subframe of @frame has been decoded. The frame itself
+ * stays in the list of pending frames; the subclass still finishes it with
+ * gst_video_decoder_finish_frame() or drops it once all subframes have been
+ * handled.
+ *
+ * Returns: a #GstFlowReturn.
+ *
+ * Since: 1.14
+ */
+GstFlowReturn
+gst_video_decoder_finish_subframe (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame)
+{
+  g_return_val_if_fail (GST_IS_VIDEO_DECODER (decoder), GST_FLOW_ERROR);
+  g_return_val_if_fail (frame != NULL, GST_FLOW_ERROR);
+
+  GST_VIDEO_DECODER_STREAM_LOCK (decoder);
+  frame->abidata.ABI.subframes_processed++;
+  GST_LOG_OBJECT (decoder, "processed subframe %u of frame #%d",
+      frame->abidata.ABI.subframes_processed, frame->system_frame_number);
+  GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+
+  return GST_FLOW_OK;
+}
+
 /* With stream lock, takes the frame reference */
 static GstFlowReturn
 gst_video_decoder_clip_and_push_buf (GstVideoDecoder * decoder, GstBuffer * buf)
@@ -3354,28 +3928,20 @@ gst_video_decoder_have_frame (GstVideoDecoder * decoder)
   return ret;
 }
 
-/* Pass the frame in priv->current_frame through the
- * handle_frame() callback for decoding and passing to gvd_finish_frame(),
- * or dropping by passing to gvd_drop_frame() */
-static GstFlowReturn
-gst_video_decoder_decode_frame (GstVideoDecoder * decoder,
-    GstVideoCodecFrame * frame)
+/* Register @frame in the list of pending frames, taking timestamps and
+ * keyframe information from @buffer; used for complete frames and for the
+ * first subframe of a frame alike */
+static void
+gst_video_decoder_register_frame (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame, GstBuffer * buffer)
 {
   GstVideoDecoderPrivate *priv = decoder->priv;
-  GstVideoDecoderClass *decoder_class;
-  GstFlowReturn ret = GST_FLOW_OK;
-
-  decoder_class = GST_VIDEO_DECODER_GET_CLASS (decoder);
-
-  /* FIXME : This should only have to be checked once (either the subclass has an
-   * implementation, or it doesn't) */
-  g_return_val_if_fail (decoder_class->handle_frame != NULL, GST_FLOW_ERROR);
 
   frame->distance_from_sync = priv->distance_from_sync;
   priv->distance_from_sync++;
-  frame->pts = GST_BUFFER_PTS (frame->input_buffer);
-  frame->dts = GST_BUFFER_DTS (frame->input_buffer);
-  frame->duration = GST_BUFFER_DURATION (frame->input_buffer);
+  frame->pts = GST_BUFFER_PTS (buffer);
+  frame->dts = GST_BUFFER_DTS (buffer);
+  frame->duration = GST_BUFFER_DURATION (buffer);
 
   /* For keyframes, PTS = DTS + constant_offset, usually 0 to 3 frame
    * durations. */
@@ -3400,19 +3966,59 @@ gst_video_decoder_decode_frame (GstVideoDecoder * decoder,
       frame->distance_from_sync);
 
   gst_video_codec_frame_ref (frame);
-  priv->frames = g_list_append (priv->frames, frame);
+  g_queue_push_tail (&priv->frames, frame);
+  g_hash_table_insert (priv->frames_index,
+      GUINT_TO_POINTER (frame->system_frame_number),
+      g_queue_peek_tail_link (&priv->frames));
 
-  if (g_list_length (priv->frames) > 10) {
+  if (priv->frames.length > 10) {
     GST_DEBUG_OBJECT (decoder, "decoder frame list getting long: %d frames,"
-        "possible internal leaking?", g_list_length (priv->frames));
+        "possible internal leaking?", priv->frames.length);
   }
 
   frame->deadline =
       gst_segment_to_running_time (&decoder->input_segment, GST_FORMAT_TIME,
       frame->pts);
+}
+
+/* Pass the frame in priv->current_frame through the
+ * handle_frame() callback for decoding and passing to gvd_finish_frame(),
+ * or dropping by passing to gvd_drop_frame() */
+static GstFlowReturn
+gst_video_decoder_decode_frame (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame)
+{
+  GstVideoDecoderClass *decoder_class;
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  decoder_class = GST_VIDEO_DECODER_GET_CLASS (decoder);
+
+  /* FIXME : This should only have to be checked once (either the subclass has an
+   * implementation, or it doesn't) */
+  g_return_val_if_fail (decoder_class->handle_frame != NULL, GST_FLOW_ERROR);
+
+  gst_video_decoder_register_frame (decoder, frame, frame->input_buffer);
+
+  if (G_UNLIKELY (decoder->priv->predictive_qos) &&
+      gst_video_decoder_qos_predict_late (decoder, frame))
+    return gst_video_decoder_drop_frame (decoder, frame);
 
   /* do something with frame */
-  ret = decoder_class->handle_frame (decoder, frame);
+  if (G_UNLIKELY (decoder->priv->enable_stats
+          || decoder->priv->predictive_qos)) {
+    gboolean sync_point = GST_VIDEO_CODEC_FRAME_IS_SYNC_POINT (frame);
+    gint64 start = g_get_monotonic_time ();
+    gint64 elapsed;
+
+    ret = decoder_class->handle_frame (decoder, frame);
+    elapsed = g_get_monotonic_time () - start;
+    if (decoder->priv->enable_stats)
+      gst_video_decoder_stats_record (decoder, elapsed);
+    if (decoder->priv->predictive_qos)
+      gst_video_decoder_qos_update_model (decoder, sync_point, elapsed);
+  } else {
+    ret = decoder_class->handle_frame (decoder, frame);
+  }
   if (ret != GST_FLOW_OK)
     GST_DEBUG_OBJECT (decoder, "flow error %s", gst_flow_get_name (ret));
 
@@ -3421,6 +4027,62 @@ gst_video_decoder_decode_frame (GstVideoDecoder * decoder,
   return ret;
 }
 
+/* Pass one subframe (e.g. slice) of priv->current_frame through the
+ * handle_subframe() callback. The first subframe registers the frame in the
+ * list of pending frames, so the subclass can start decoding before the tail
+ * of the frame has arrived. When a buffer carrying
+ * GST_VIDEO_BUFFER_FLAG_MARKER has been handled the frame is complete and
+ * ownership of our reference passes to the subclass, which finishes or drops
+ * it like a frame received through handle_frame(). */
+static GstFlowReturn
+gst_video_decoder_decode_subframe (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame, GstBuffer * buf)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstVideoDecoderClass *decoder_class;
+  gboolean last_subframe;
+  GstFlowReturn ret;
+
+  decoder_class = GST_VIDEO_DECODER_GET_CLASS (decoder);
+
+  last_subframe = GST_BUFFER_FLAG_IS_SET (buf, GST_VIDEO_BUFFER_FLAG_MARKER);
+
+  if (frame->abidata.ABI.num_subframes == 0)
+    gst_video_decoder_register_frame (decoder, frame, buf);
+
+  frame->abidata.ABI.num_subframes++;
+
+  GST_LOG_OBJECT (decoder,
+      "subframe %u of frame #%d, %" G_GSIZE_FORMAT " bytes, last:%d",
+      frame->abidata.ABI.num_subframes, frame->system_frame_number,
+      gst_buffer_get_size (buf), last_subframe);
+
+  if (G_UNLIKELY (priv->enable_stats)) {
+    gint64 start = g_get_monotonic_time ();
+
+    ret = decoder_class->handle_subframe (decoder, frame, buf);
+    gst_video_decoder_stats_record (decoder, g_get_monotonic_time () - start);
+  } else {
+    ret = decoder_class->handle_subframe (decoder, frame, buf);
+  }
+  if (ret != GST_FLOW_OK)
+    GST_DEBUG_OBJECT (decoder, "flow error %s", gst_flow_get_name (ret));
+
+  /* keep the complete access unit around, like the whole-frame path does */
+  if (frame->input_buffer == NULL)
+    frame->input_buffer = buf;
+  else
+    frame->input_buffer = gst_buffer_append (frame->input_buffer, buf);
+
+  if (last_subframe) {
+    GST_LOG_OBJECT (decoder, "frame #%d complete after %u subframes",
+        frame->system_frame_number, frame->abidata.ABI.num_subframes);
+    priv->current_frame = NULL;
+  }
+
+  return ret;
+}
+
 
 /**
  * gst_video_decoder_get_output_state:
@@ -3522,8 +4184,8 @@ gst_video_decoder_get_oldest_frame (GstVideoDecoder * decoder)
   GstVideoCodecFrame *frame = NULL;
 
   GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-  if (decoder->priv->frames)
-    frame = gst_video_codec_frame_ref (decoder->priv->frames->data);
+  if (decoder->priv->frames.head)
+    frame = gst_video_codec_frame_ref (decoder->priv->frames.head->data);
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
   return (GstVideoCodecFrame *) frame;
@@ -3541,20 +4203,16 @@ gst_video_decoder_get_oldest_frame (GstVideoDecoder * decoder)
 GstVideoCodecFrame *
 gst_video_decoder_get_frame (GstVideoDecoder * decoder, int frame_number)
 {
-  GList *g;
+  GList *link;
   GstVideoCodecFrame *frame = NULL;
 
   GST_DEBUG_OBJECT (decoder, "frame_number : %d", frame_number);
 
   GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-  for (g = decoder->priv->frames; g; g = g->next) {
-    GstVideoCodecFrame *tmp = g->data;
-
-    if (tmp->system_frame_number == frame_number) {
-      frame = gst_video_codec_frame_ref (tmp);
-      break;
-    }
-  }
+  link = g_hash_table_lookup (decoder->priv->frames_index,
+      GUINT_TO_POINTER (frame_number));
+  if (link)
+    frame = gst_video_codec_frame_ref (link->data);
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
   return frame;
@@ -3574,7 +4232,7 @@ gst_video_decoder_get_frames (GstVideoDecoder * decoder)
   GList *frames;
 
   GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-  frames = g_list_copy (decoder->priv->frames);
+  frames = g_list_copy (decoder->priv->frames.head);
   g_list_foreach (frames, (GFunc) gst_video_codec_frame_ref, NULL);
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
@@ -3773,6 +4431,61 @@ no_decide_allocation:
   }
 }
 
+/* build allocation caps at the configured headroom geometry, or return NULL
+ * when no headroom is set or the output does not fit in the envelope */
+static GstCaps *
+gst_video_decoder_make_headroom_caps (GstVideoDecoder * decoder,
+    GstVideoCodecState * state)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstCaps *caps;
+
+  if (priv->alloc_headroom_width == 0 || priv->alloc_headroom_height == 0)
+    return NULL;
+
+  if ((guint) GST_VIDEO_INFO_WIDTH (&state->info) > priv->alloc_headroom_width
+      || (guint) GST_VIDEO_INFO_HEIGHT (&state->info) >
+      priv->alloc_headroom_height) {
+    GST_DEBUG_OBJECT (decoder, "output %dx%d exceeds allocation headroom "
+        "%ux%u", GST_VIDEO_INFO_WIDTH (&state->info),
+        GST_VIDEO_INFO_HEIGHT (&state->info), priv->alloc_headroom_width,
+        priv->alloc_headroom_height);
+    return NULL;
+  }
+
+  caps = gst_caps_copy (state->caps);
+  gst_caps_set_simple (caps, "width", G_TYPE_INT,
+      (gint) priv->alloc_headroom_width, "height", G_TYPE_INT,
+      (gint) priv->alloc_headroom_height, NULL);
+
+  return caps;
+}
+
+/* TRUE if the active pool was negotiated for the same allocation caps and
+ * can simply be kept, which avoids the ALLOCATION query and the pool
+ * replacement (and hence the drain) on a renegotiation within the
+ * configured headroom */
+static gboolean
+gst_video_decoder_can_keep_pool (GstVideoDecoder * decoder, GstCaps * caps)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstStructure *config;
+  GstCaps *poolcaps = NULL;
+  gboolean keep;
+
+  if (priv->alloc_headroom_width == 0 || priv->alloc_headroom_height == 0)
+    return FALSE;
+  if (priv->pool == NULL || !gst_buffer_pool_is_active (priv->pool))
+    return FALSE;
+
+  config = gst_buffer_pool_get_config (priv->pool);
+  gst_buffer_pool_config_get_params (config, &poolcaps, NULL, NULL, NULL);
+  keep = poolcaps != NULL && gst_caps_is_equal (poolcaps, caps);
+  gst_structure_free (config);
+
+  return keep;
+}
+
 static gboolean
 gst_video_decoder_negotiate_default (GstVideoDecoder * decoder)
 {
@@ -3807,14 +4520,18 @@ gst_video_decoder_negotiate_default (GstVideoDecoder * decoder)
 
   if (state->caps == NULL)
     state->caps = gst_video_info_to_caps (&state->info);
-  if (state->allocation_caps == NULL)
-    state->allocation_caps = gst_caps_ref (state->caps);
+  if (state->allocation_caps == NULL) {
+    state->allocation_caps =
+        gst_video_decoder_make_headroom_caps (decoder, state);
+    if (state->allocation_caps == NULL)
+      state->allocation_caps = gst_caps_ref (state->caps);
+  }
 
   GST_DEBUG_OBJECT (decoder, "setting caps %" GST_PTR_FORMAT, state->caps);
 
   /* Push all pending pre-caps events of the oldest frame before
    * setting caps */
-  frame = decoder->priv->frames ? decoder->priv->frames->data : NULL;
+  frame = g_queue_peek_head (&decoder->priv->frames);
   if (frame || decoder->priv->current_frame_events) {
     GList **events, *l;
 
@@ -3856,8 +4573,17 @@ gst_video_decoder_negotiate_default (GstVideoDecoder * decoder)
   if (!ret)
     goto done;
   decoder->priv->output_state_changed = FALSE;
-  /* Negotiate pool */
-  ret = gst_video_decoder_negotiate_pool (decoder, state->allocation_caps);
+  /* Negotiate pool, unless the active one already matches the allocation
+   * caps, which is the common case on a rendition switch within the
+   * configured allocation headroom */
+  if (gst_video_decoder_can_keep_pool (decoder, state->allocation_caps)) {
+    GST_DEBUG_OBJECT (decoder, "keeping pool %" GST_PTR_FORMAT
+        " negotiated for %" GST_PTR_FORMAT, decoder->priv->pool,
+        state->allocation_caps);
+    ret = TRUE;
+  } else {
+    ret = gst_video_decoder_negotiate_pool (decoder, state->allocation_caps);
+  }
 
 done:
   return ret;
@@ -3907,6 +4633,43 @@ gst_video_decoder_negotiate (GstVideoDecoder * decoder)
   return ret;
 }
 
+/* with allocation headroom the pool attaches a #GstVideoMeta describing the
+ * envelope geometry; rewrite it to the actual output geometry so both the
+ * subclass (mapping the frame for writing) and downstream see the real
+ * frame layout inside the larger buffer */
+static void
+gst_video_decoder_fixup_output_meta (GstVideoDecoder * decoder,
+    GstBuffer * buffer)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstVideoMeta *meta;
+  GstVideoInfo *info;
+  guint i;
+
+  if (priv->alloc_headroom_width == 0 || priv->alloc_headroom_height == 0)
+    return;
+  if (priv->output_state == NULL)
+    return;
+
+  meta = gst_buffer_get_video_meta (buffer);
+  if (meta == NULL)
+    return;
+
+  info = &priv->output_state->info;
+  if (meta->width == (guint) GST_VIDEO_INFO_WIDTH (info) &&
+      meta->height == (guint) GST_VIDEO_INFO_HEIGHT (info))
+    return;
+
+  meta->format = GST_VIDEO_INFO_FORMAT (info);
+  meta->width = GST_VIDEO_INFO_WIDTH (info);
+  meta->height = GST_VIDEO_INFO_HEIGHT (info);
+  meta->n_planes = GST_VIDEO_INFO_N_PLANES (info);
+  for (i = 0; i < meta->n_planes; i++) {
+    meta->offset[i] = GST_VIDEO_INFO_PLANE_OFFSET (info, i);
+    meta->stride[i] = GST_VIDEO_INFO_PLANE_STRIDE (info, i);
+  }
+}
+
 /**
  * gst_video_decoder_allocate_output_buffer:
  * @decoder: a #GstVideoDecoder
@@ -3955,6 +4718,7 @@ gst_video_decoder_allocate_output_buffer (GstVideoDecoder * decoder)
     else
       goto failed_allocation;
   }
+  gst_video_decoder_fixup_output_meta (decoder, buffer);
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
   return buffer;
@@ -4046,6 +4810,9 @@ gst_video_decoder_allocate_output_frame_with_params (GstVideoDecoder *
   flow_ret = gst_buffer_pool_acquire_buffer (decoder->priv->pool,
       &frame->output_buffer, params);
 
+  if (flow_ret == GST_FLOW_OK)
+    gst_video_decoder_fixup_output_meta (decoder, frame->output_buffer);
+
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
   return flow_ret;
@@ -4216,6 +4983,63 @@ gst_video_decoder_get_needs_format (GstVideoDecoder * dec)
   return result;
 }
 
+/**
+ * gst_video_decoder_set_allocation_headroom:
+ * @dec: a #GstVideoDecoder
+ * @max_width: maximum output width to allocate for, or 0 to disable
+ * @max_height: maximum output height to allocate for, or 0 to disable
+ *
+ * Configures a maximum geometry to negotiate output buffer allocation for.
+ * When set, the ALLOCATION query and the output buffer pool are negotiated
+ * at @max_width x @max_height and the pool is kept across renegotiations
+ * whose output fits inside that envelope, with the #GstVideoMeta on each
+ * output buffer rewritten to the actual geometry. Adaptive streams that
+ * switch between renditions then reuse the same buffers instead of
+ * draining and reallocating the pool on every switch.
+ *
+ * Outputs larger than the envelope negotiate as usual.
+ *
+ * Takes effect on the next negotiation.
+ *
+ * Since: 1.14
+ */
+void
+gst_video_decoder_set_allocation_headroom (GstVideoDecoder * dec,
+    guint max_width, guint max_height)
+{
+  g_return_if_fail (GST_IS_VIDEO_DECODER (dec));
+
+  GST_VIDEO_DECODER_STREAM_LOCK (dec);
+  dec->priv->alloc_headroom_width = max_width;
+  dec->priv->alloc_headroom_height = max_height;
+  GST_VIDEO_DECODER_STREAM_UNLOCK (dec);
+}
+
+/**
+ * gst_video_decoder_get_allocation_headroom:
+ * @dec: a #GstVideoDecoder
+ * @max_width: (out) (allow-none): the configured maximum width, or %NULL
+ * @max_height: (out) (allow-none): the configured maximum height, or %NULL
+ *
+ * Queries the allocation headroom geometry configured with
+ * gst_video_decoder_set_allocation_headroom(), 0/0 when disabled.
+ *
+ * Since: 1.14
+ */
+void
+gst_video_decoder_get_allocation_headroom (GstVideoDecoder * dec,
+    guint * max_width, guint * max_height)
+{
+  g_return_if_fail (GST_IS_VIDEO_DECODER (dec));
+
+  GST_VIDEO_DECODER_STREAM_LOCK (dec);
+  if (max_width)
+    *max_width = dec->priv->alloc_headroom_width;
+  if (max_height)
+    *max_height = dec->priv->alloc_headroom_height;
+  GST_VIDEO_DECODER_STREAM_UNLOCK (dec);
+}
+
 /**
  * gst_video_decoder_set_packetized:
  * @decoder: a #GstVideoDecoder
@@ -4246,6 +5070,83 @@ gst_video_decoder_get_packetized (GstVideoDecoder * decoder)
   return decoder->priv->packetized;
 }
 
+/**
+ * gst_video_decoder_set_subframe_mode:
+ * @decoder: a #GstVideoDecoder
+ * @subframe_mode: whether input should be considered as subframes.
+ *
+ * If this is set to TRUE, it informs the base class that the subclass
+ * can receive the data at a granularity lower than one frame. Each
+ * packetized input buffer is then handed to the @handle_subframe vfunc
+ * as it arrives, and a buffer carrying %GST_VIDEO_BUFFER_FLAG_MARKER
+ * completes the frame. This is useful for decoders able to start
+ * decoding slices before the whole access unit has been received.
+ *
+ * It can only be used in combination with packetized input.
+ *
+ * Since: 1.14
+ */
+void
+gst_video_decoder_set_subframe_mode (GstVideoDecoder * decoder,
+    gboolean subframe_mode)
+{
+  decoder->priv->subframe_mode = subframe_mode;
+}
+
+/**
+ * gst_video_decoder_get_subframe_mode:
+ * @decoder: a #GstVideoDecoder
+ *
+ * Queries whether input data is considered to be subframes.
+ *
+ * Returns: TRUE if input data is considered subframes.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_video_decoder_get_subframe_mode (GstVideoDecoder * decoder)
+{
+  return decoder->priv->subframe_mode;
+}
+
+/**
+ * gst_video_decoder_get_input_subframe_index:
+ * @decoder: a #GstVideoDecoder
+ * @frame: the #GstVideoCodecFrame to update
+ *
+ * Queries the number of subframes the base class has received for
+ * @frame.
+ *
+ * Returns: the number of subframes received for @frame.
+ *
+ * Since: 1.14
+ */
+guint
+gst_video_decoder_get_input_subframe_index (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame)
+{
+  return frame->abidata.ABI.num_subframes;
+}
+
+/**
+ * gst_video_decoder_get_processed_subframe_index:
+ * @decoder: a #GstVideoDecoder
+ * @frame: the #GstVideoCodecFrame to update
+ *
+ * Queries the number of subframes of @frame that the subclass has
+ * finished with gst_video_decoder_finish_subframe().
+ *
+ * Returns: the number of subframes processed for @frame.
+ *
+ * Since: 1.14
+ */
+guint
+gst_video_decoder_get_processed_subframe_index (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame)
+{
+  return frame->abidata.ABI.subframes_processed;
+}
+
 /**
  * gst_video_decoder_set_estimate_rate:
  * @dec: a #GstVideoDecoder
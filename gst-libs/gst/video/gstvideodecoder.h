@@ -272,6 +272,12 @@ struct _GstVideoDecoder
  *                  tags and meta with only the "video" tag. subclasses can
  *                  implement this method and return %TRUE if the metadata is to be
  *                  copied. Since 1.6
+ * @handle_subframe: Optional. Called with each subframe (e.g. slice) of the
+ *                  current frame as it arrives, when subframe mode has been
+ *                  enabled with gst_video_decoder_set_subframe_mode(). The
+ *                  frame is completed when a buffer carrying
+ *                  %GST_VIDEO_BUFFER_FLAG_MARKER has been handled, after
+ *                  which it must be finished or dropped as usual. Since 1.14
  *
  * Subclasses can override any of the available virtual methods or not, as
  * needed. At minimum @handle_frame needs to be overridden, and @set_format
@@ -337,8 +343,12 @@ struct _GstVideoDecoderClass
                                    GstVideoCodecFrame *frame,
                                    GstMeta * meta);
 
+  GstFlowReturn (*handle_subframe) (GstVideoDecoder *decoder,
+                                    GstVideoCodecFrame *frame,
+                                    GstBuffer *subframe);
+
   /*< private >*/
-  void         *padding[GST_PADDING_LARGE-6];
+  void         *padding[GST_PADDING_LARGE-7];
 };
 
 GST_EXPORT
@@ -353,6 +363,21 @@ void     gst_video_decoder_set_packetized (GstVideoDecoder * decoder,
 GST_EXPORT
 gboolean gst_video_decoder_get_packetized (GstVideoDecoder * decoder);
 
+GST_EXPORT
+void     gst_video_decoder_set_subframe_mode (GstVideoDecoder * decoder,
+					      gboolean subframe_mode);
+
+GST_EXPORT
+gboolean gst_video_decoder_get_subframe_mode (GstVideoDecoder * decoder);
+
+GST_EXPORT
+guint    gst_video_decoder_get_input_subframe_index (GstVideoDecoder * decoder,
+						     GstVideoCodecFrame * frame);
+
+GST_EXPORT
+guint    gst_video_decoder_get_processed_subframe_index (GstVideoDecoder * decoder,
+							 GstVideoCodecFrame * frame);
+
 GST_EXPORT
 void     gst_video_decoder_set_estimate_rate (GstVideoDecoder * dec,
 					      gboolean          enabled);
@@ -374,6 +399,16 @@ void     gst_video_decoder_set_needs_format (GstVideoDecoder * dec,
 GST_EXPORT
 gboolean gst_video_decoder_get_needs_format (GstVideoDecoder * dec);
 
+GST_EXPORT
+void     gst_video_decoder_set_allocation_headroom (GstVideoDecoder * dec,
+                                                    guint max_width,
+                                                    guint max_height);
+
+GST_EXPORT
+void     gst_video_decoder_get_allocation_headroom (GstVideoDecoder * dec,
+                                                    guint * max_width,
+                                                    guint * max_height);
+
 GST_EXPORT
 void     gst_video_decoder_set_latency (GstVideoDecoder *decoder,
 					GstClockTime min_latency,
@@ -450,6 +485,10 @@ GST_EXPORT
 GstFlowReturn    gst_video_decoder_finish_frame (GstVideoDecoder *decoder,
 						 GstVideoCodecFrame *frame);
 
+GST_EXPORT
+GstFlowReturn    gst_video_decoder_finish_subframe (GstVideoDecoder *decoder,
+						    GstVideoCodecFrame *frame);
+
 GST_EXPORT
 GstFlowReturn    gst_video_decoder_drop_frame (GstVideoDecoder *dec,
 					       GstVideoCodecFrame *frame);
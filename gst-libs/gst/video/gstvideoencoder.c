@@ -108,6 +108,19 @@ GST_DEBUG_CATEGORY (videoencoder_debug);
     (G_TYPE_INSTANCE_GET_PRIVATE ((obj), GST_TYPE_VIDEO_ENCODER, \
         GstVideoEncoderPrivate))
 
+/* log2-ms histogram of the time spent in the subclass per frame */
+#define N_TIMING_BUCKETS 14
+
+#define DEFAULT_FORCE_KEY_UNIT_DEDUP_WINDOW 0
+
+enum
+{
+  PROP_0,
+  PROP_ENABLE_STATS,
+  PROP_STATS,
+  PROP_FORCE_KEY_UNIT_DEDUP_WINDOW
+};
+
 struct _GstVideoEncoderPrivate
 {
   guint64 presentation_frame_number;
@@ -125,6 +138,9 @@ struct _GstVideoEncoderPrivate
   gboolean new_headers;         /* Whether new headers were just set */
 
   GList *force_key_unit;        /* List of pending forced keyunits */
+  /* requests this close together are answered with one keyframe,
+   * protected with OBJECT_LOCK */
+  GstClockTime force_key_unit_dedup_window;
 
   guint32 system_frame_number;
 
@@ -133,6 +149,20 @@ struct _GstVideoEncoderPrivate
   GstVideoCodecState *output_state;
   gboolean output_state_changed;
 
+  /* recycles frame structures to avoid per-frame allocations */
+  GstVideoCodecFramePool *frame_pool;
+
+  /* deferred output: when enabled, finished frames are deposited in a
+   * lock-free queue by the subclass's encoding threads and pushed in
+   * order by a task on the srcpad */
+  gboolean async_push;
+  GstAtomicQueue *output_queue;
+  GMutex output_lock;           /* protects the wakeup/drain state below */
+  GCond output_cond;
+  guint output_pending;         /* queued frames not yet pushed downstream */
+  gboolean output_task_running;
+  GstFlowReturn output_flow;    /* last flow result seen by the output task */
+
   gint64 bytes;
   gint64 time;
 
@@ -152,6 +182,14 @@ struct _GstVideoEncoderPrivate
   /* adjustment needed on pts, dts, segment start and stop to accomodate
    * min_pts */
   GstClockTime time_adjustment;
+
+  /* handle_frame() timing statistics, all counters under OBJECT_LOCK */
+  gboolean enable_stats;
+  guint64 stat_frames;
+  guint64 stat_time_sum;        /* microseconds */
+  guint64 stat_time_max;
+  guint64 stat_time_hist[N_TIMING_BUCKETS];
+  guint stat_max_queued;
 };
 
 typedef struct _ForcedKeyUnitEvent ForcedKeyUnitEvent;
@@ -183,12 +221,62 @@ forced_key_unit_event_new (GstClockTime running_time, gboolean all_headers,
   return evt;
 }
 
+/* queues a force-key-unit request, or merges it into a pending one when
+ * it falls inside the dedup window. Called with OBJECT_LOCK. */
+static void
+gst_video_encoder_add_force_key_unit (GstVideoEncoder * encoder,
+    GstClockTime running_time, gboolean all_headers, guint count)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+  GstClockTime window = priv->force_key_unit_dedup_window;
+  ForcedKeyUnitEvent *fevt;
+  GList *l;
+
+  if (window > 0) {
+    for (l = priv->force_key_unit; l; l = l->next) {
+      ForcedKeyUnitEvent *tmp = l->data;
+
+      /* already bound to a frame */
+      if (tmp->pending)
+        continue;
+
+      if (running_time == GST_CLOCK_TIME_NONE
+          || tmp->running_time == GST_CLOCK_TIME_NONE) {
+        /* immediate requests only coalesce with each other */
+        if (running_time != tmp->running_time)
+          continue;
+      } else if (ABS (GST_CLOCK_DIFF (tmp->running_time, running_time)) >
+          (GstClockTimeDiff) window) {
+        continue;
+      }
+
+      /* answer both requests with one keyframe at the earlier time */
+      if (running_time != GST_CLOCK_TIME_NONE
+          && running_time < tmp->running_time)
+        tmp->running_time = running_time;
+      tmp->all_headers |= all_headers;
+
+      GST_LOG_OBJECT (encoder,
+          "coalesced force-key-unit request into pending one at %"
+          GST_TIME_FORMAT, GST_TIME_ARGS (tmp->running_time));
+      return;
+    }
+  }
+
+  fevt = forced_key_unit_event_new (running_time, all_headers, count);
+  priv->force_key_unit = g_list_append (priv->force_key_unit, fevt);
+}
+
 static GstElementClass *parent_class = NULL;
 static void gst_video_encoder_class_init (GstVideoEncoderClass * klass);
 static void gst_video_encoder_init (GstVideoEncoder * enc,
     GstVideoEncoderClass * klass);
 
 static void gst_video_encoder_finalize (GObject * object);
+static void gst_video_encoder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_video_encoder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
 
 static gboolean gst_video_encoder_setcaps (GstVideoEncoder * enc,
     GstCaps * caps);
@@ -230,6 +318,12 @@ static gboolean gst_video_encoder_src_query_default (GstVideoEncoder * encoder,
 static gboolean gst_video_encoder_transform_meta_default (GstVideoEncoder *
     encoder, GstVideoCodecFrame * frame, GstMeta * meta);
 
+static GstFlowReturn gst_video_encoder_finish_frame_real (GstVideoEncoder *
+    encoder, GstVideoCodecFrame * frame);
+static void gst_video_encoder_output_loop (GstVideoEncoder * encoder);
+static void gst_video_encoder_drain_output_queue (GstVideoEncoder * encoder);
+static void gst_video_encoder_stop_output_task (GstVideoEncoder * encoder);
+
 /* we can't use G_DEFINE_ABSTRACT_TYPE because we need the klass in the _init
  * method to get to the padtemplates */
 GType
@@ -282,6 +376,70 @@ gst_video_encoder_class_init (GstVideoEncoderClass * klass)
   g_type_class_add_private (klass, sizeof (GstVideoEncoderPrivate));
 
   gobject_class->finalize = gst_video_encoder_finalize;
+  gobject_class->set_property = gst_video_encoder_set_property;
+  gobject_class->get_property = gst_video_encoder_get_property;
+
+  /**
+   * GstVideoEncoder:enable-stats:
+   *
+   * Enable recording of handle_frame() timing statistics. Off by
+   * default since it adds two monotonic clock reads per frame.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_ENABLE_STATS,
+      g_param_spec_boolean ("enable-stats", "Enable stats",
+          "Record encode timing statistics for the stats property",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstVideoEncoder:stats:
+   *
+   * A #GstStructure "video-encoder-stats" with the statistics recorded
+   * since the encoder was started, all times in microseconds:
+   *
+   * * "frames" G_TYPE_UINT64 number of timed handle_frame() calls
+   * * "avg-time" G_TYPE_UINT64 average time spent in handle_frame()
+   * * "max-time" G_TYPE_UINT64 longest handle_frame() call
+   * * "time-histogram" #GST_TYPE_ARRAY of G_TYPE_UINT64 counters; bucket 0
+   *   counts calls that took less than 1 millisecond, bucket n calls that
+   *   took between 2^(n-1) and 2^n milliseconds and the last bucket
+   *   everything longer
+   * * "current-queued-frames" G_TYPE_UINT frames pending in the encoder
+   * * "max-queued-frames" G_TYPE_UINT highest number of pending frames
+   *
+   * All zero unless #GstVideoEncoder:enable-stats has been set.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Encode timing statistics", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstVideoEncoder:force-key-unit-dedup-window:
+   *
+   * Coalesce force-key-unit requests whose running times are at most
+   * this far apart into a single request, answered with one keyframe at
+   * the earliest requested running time and with all-headers set when
+   * any of the merged requests asked for it. Immediate requests (no
+   * running time) only coalesce with each other. 0 keeps every request
+   * separate.
+   *
+   * Useful when keyframe requests fan in from many receivers and bursts
+   * of them should cost one keyframe instead of one per request.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_FORCE_KEY_UNIT_DEDUP_WINDOW,
+      g_param_spec_uint64 ("force-key-unit-dedup-window",
+          "Force-key-unit dedup window",
+          "Merge force-key-unit requests at most this far apart "
+          "(in nanoseconds, 0 = disabled)",
+          0, G_MAXUINT64, DEFAULT_FORCE_KEY_UNIT_DEDUP_WINDOW,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_video_encoder_change_state);
@@ -340,6 +498,14 @@ gst_video_encoder_reset (GstVideoEncoder * encoder, gboolean hard)
   priv->time_adjustment = GST_CLOCK_TIME_NONE;
 
   if (hard) {
+    GST_OBJECT_LOCK (encoder);
+    priv->stat_frames = 0;
+    priv->stat_time_sum = 0;
+    priv->stat_time_max = 0;
+    memset (priv->stat_time_hist, 0, sizeof (priv->stat_time_hist));
+    priv->stat_max_queued = 0;
+    GST_OBJECT_UNLOCK (encoder);
+
     gst_segment_init (&encoder->input_segment, GST_FORMAT_TIME);
     gst_segment_init (&encoder->output_segment, GST_FORMAT_TIME);
 
@@ -453,6 +619,12 @@ gst_video_encoder_init (GstVideoEncoder * encoder, GstVideoEncoderClass * klass)
 
   priv->headers = NULL;
   priv->new_headers = FALSE;
+  priv->frame_pool = __gst_video_codec_frame_pool_new ();
+
+  priv->output_queue = gst_atomic_queue_new (8);
+  g_mutex_init (&priv->output_lock);
+  g_cond_init (&priv->output_cond);
+  priv->output_flow = GST_FLOW_OK;
 
   priv->min_latency = 0;
   priv->max_latency = 0;
@@ -842,9 +1014,131 @@ gst_video_encoder_finalize (GObject * object)
     encoder->priv->allocator = NULL;
   }
 
+  if (encoder->priv->frame_pool) {
+    __gst_video_codec_frame_pool_release (encoder->priv->frame_pool);
+    encoder->priv->frame_pool = NULL;
+  }
+
+  if (encoder->priv->output_queue) {
+    GstVideoCodecFrame *frame;
+
+    while ((frame = gst_atomic_queue_pop (encoder->priv->output_queue)))
+      gst_video_codec_frame_unref (frame);
+    gst_atomic_queue_unref (encoder->priv->output_queue);
+    encoder->priv->output_queue = NULL;
+  }
+  g_mutex_clear (&encoder->priv->output_lock);
+  g_cond_clear (&encoder->priv->output_cond);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/* records one timed handle_frame() call of @elapsed microseconds together
+ * with the current depth of the pending frame list */
+static void
+gst_video_encoder_stats_record (GstVideoEncoder * encoder, gint64 elapsed)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+  guint64 ms;
+  guint bucket = 0, queued;
+
+  GST_OBJECT_LOCK (encoder);
+  priv->stat_frames++;
+  priv->stat_time_sum += elapsed;
+  if ((guint64) elapsed > priv->stat_time_max)
+    priv->stat_time_max = elapsed;
+  for (ms = elapsed / 1000; ms > 0; ms >>= 1) {
+    if (++bucket == N_TIMING_BUCKETS - 1)
+      break;
+  }
+  priv->stat_time_hist[bucket]++;
+  queued = g_list_length (priv->frames);
+  if (queued > priv->stat_max_queued)
+    priv->stat_max_queued = queued;
+  GST_OBJECT_UNLOCK (encoder);
+}
+
+static GstStructure *
+gst_video_encoder_create_stats (GstVideoEncoder * encoder)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+  GstStructure *s;
+  GValue hist = G_VALUE_INIT;
+  GValue v = G_VALUE_INIT;
+  guint64 avg;
+  gint i;
+
+  GST_OBJECT_LOCK (encoder);
+  avg = priv->stat_frames ? priv->stat_time_sum / priv->stat_frames : 0;
+  s = gst_structure_new ("video-encoder-stats",
+      "frames", G_TYPE_UINT64, priv->stat_frames,
+      "avg-time", G_TYPE_UINT64, avg,
+      "max-time", G_TYPE_UINT64, priv->stat_time_max,
+      "current-queued-frames", G_TYPE_UINT, g_list_length (priv->frames),
+      "max-queued-frames", G_TYPE_UINT, priv->stat_max_queued, NULL);
+
+  g_value_init (&hist, GST_TYPE_ARRAY);
+  g_value_init (&v, G_TYPE_UINT64);
+  for (i = 0; i < N_TIMING_BUCKETS; i++) {
+    g_value_set_uint64 (&v, priv->stat_time_hist[i]);
+    gst_value_array_append_value (&hist, &v);
+  }
+  g_value_unset (&v);
+  gst_structure_take_value (s, "time-histogram", &hist);
+  GST_OBJECT_UNLOCK (encoder);
+
+  return s;
+}
+
+static void
+gst_video_encoder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstVideoEncoder *encoder = GST_VIDEO_ENCODER (object);
+
+  switch (prop_id) {
+    case PROP_ENABLE_STATS:
+      GST_OBJECT_LOCK (encoder);
+      encoder->priv->enable_stats = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (encoder);
+      break;
+    case PROP_FORCE_KEY_UNIT_DEDUP_WINDOW:
+      GST_OBJECT_LOCK (encoder);
+      encoder->priv->force_key_unit_dedup_window = g_value_get_uint64 (value);
+      GST_OBJECT_UNLOCK (encoder);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_video_encoder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVideoEncoder *encoder = GST_VIDEO_ENCODER (object);
+
+  switch (prop_id) {
+    case PROP_ENABLE_STATS:
+      GST_OBJECT_LOCK (encoder);
+      g_value_set_boolean (value, encoder->priv->enable_stats);
+      GST_OBJECT_UNLOCK (encoder);
+      break;
+    case PROP_STATS:
+      g_value_take_boxed (value, gst_video_encoder_create_stats (encoder));
+      break;
+    case PROP_FORCE_KEY_UNIT_DEDUP_WINDOW:
+      GST_OBJECT_LOCK (encoder);
+      g_value_set_uint64 (value, encoder->priv->force_key_unit_dedup_window);
+      GST_OBJECT_UNLOCK (encoder);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
 static gboolean
 gst_video_encoder_push_event (GstVideoEncoder * encoder, GstEvent * event)
 {
@@ -961,6 +1255,13 @@ gst_video_encoder_sink_event_default (GstVideoEncoder * encoder,
         flow_ret = GST_FLOW_OK;
       }
 
+      /* make sure frames handed over to the output task have been
+       * pushed before EOS goes out; the stream lock must be dropped
+       * while waiting as the task needs it to push */
+      GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
+      gst_video_encoder_drain_output_queue (encoder);
+      GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
+
       if (encoder->priv->current_frame_events) {
         GList *l;
 
@@ -1010,12 +1311,9 @@ gst_video_encoder_sink_event_default (GstVideoEncoder * encoder,
 
         if (gst_video_event_parse_downstream_force_key_unit (event,
                 NULL, NULL, &running_time, &all_headers, &count)) {
-          ForcedKeyUnitEvent *fevt;
-
           GST_OBJECT_LOCK (encoder);
-          fevt = forced_key_unit_event_new (running_time, all_headers, count);
-          encoder->priv->force_key_unit =
-              g_list_append (encoder->priv->force_key_unit, fevt);
+          gst_video_encoder_add_force_key_unit (encoder, running_time,
+              all_headers, count);
           GST_OBJECT_UNLOCK (encoder);
 
           GST_DEBUG_OBJECT (encoder,
@@ -1080,6 +1378,19 @@ gst_video_encoder_sink_event_default (GstVideoEncoder * encoder,
       break;
     }
     case GST_EVENT_FLUSH_STOP:{
+      GstVideoEncoderPrivate *priv = encoder->priv;
+      GstVideoCodecFrame *frame;
+
+      /* drop frames still sitting in the output queue; the output task
+       * is either idle or waiting for the stream lock we take below */
+      while ((frame = gst_atomic_queue_pop (priv->output_queue)))
+        gst_video_codec_frame_unref (frame);
+      g_mutex_lock (&priv->output_lock);
+      priv->output_pending = 0;
+      priv->output_flow = GST_FLOW_OK;
+      g_cond_broadcast (&priv->output_cond);
+      g_mutex_unlock (&priv->output_lock);
+
       GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
       gst_video_encoder_flush (encoder);
       gst_segment_init (&encoder->input_segment, GST_FORMAT_TIME);
@@ -1155,12 +1466,9 @@ gst_video_encoder_src_event_default (GstVideoEncoder * encoder,
 
         if (gst_video_event_parse_upstream_force_key_unit (event,
                 &running_time, &all_headers, &count)) {
-          ForcedKeyUnitEvent *fevt;
-
           GST_OBJECT_LOCK (encoder);
-          fevt = forced_key_unit_event_new (running_time, all_headers, count);
-          encoder->priv->force_key_unit =
-              g_list_append (encoder->priv->force_key_unit, fevt);
+          gst_video_encoder_add_force_key_unit (encoder, running_time,
+              all_headers, count);
           GST_OBJECT_UNLOCK (encoder);
 
           GST_DEBUG_OBJECT (encoder,
@@ -1293,9 +1601,7 @@ gst_video_encoder_new_frame (GstVideoEncoder * encoder, GstBuffer * buf,
   GstVideoEncoderPrivate *priv = encoder->priv;
   GstVideoCodecFrame *frame;
 
-  frame = g_slice_new0 (GstVideoCodecFrame);
-
-  frame->ref_count = 1;
+  frame = __gst_video_codec_frame_pool_acquire (priv->frame_pool);
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
   frame->system_frame_number = priv->system_frame_number;
@@ -1435,7 +1741,14 @@ gst_video_encoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   GST_LOG_OBJECT (encoder, "passing frame pfn %d to subclass",
       frame->presentation_frame_number);
 
-  ret = klass->handle_frame (encoder, frame);
+  if (G_UNLIKELY (priv->enable_stats)) {
+    gint64 start = g_get_monotonic_time ();
+
+    ret = klass->handle_frame (encoder, frame);
+    gst_video_encoder_stats_record (encoder, g_get_monotonic_time () - start);
+  } else {
+    ret = klass->handle_frame (encoder, frame);
+  }
 
 done:
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
@@ -1477,6 +1790,9 @@ gst_video_encoder_change_state (GstElement * element, GstStateChange transition)
       if (encoder_class->start && !encoder_class->start (encoder))
         goto start_failed;
       break;
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      gst_video_encoder_stop_output_task (encoder);
+      break;
     default:
       break;
   }
@@ -1902,6 +2218,82 @@ foreach_metadata (GstBuffer * inbuf, GstMeta ** meta, gpointer user_data)
   return TRUE;
 }
 
+/* Srcpad task draining the output queue in order when async push was
+ * enabled by the subclass. Sleeps on @output_cond while the queue is
+ * empty and pauses itself when the task is shut down. */
+static void
+gst_video_encoder_output_loop (GstVideoEncoder * encoder)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+  GstVideoCodecFrame *frame;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&priv->output_lock);
+  while ((frame = gst_atomic_queue_pop (priv->output_queue)) == NULL) {
+    if (!priv->output_task_running)
+      goto paused;
+    g_cond_wait (&priv->output_cond, &priv->output_lock);
+  }
+  g_mutex_unlock (&priv->output_lock);
+
+  ret = gst_video_encoder_finish_frame_real (encoder, frame);
+
+  g_mutex_lock (&priv->output_lock);
+  priv->output_flow = ret;
+  if (priv->output_pending > 0)
+    priv->output_pending--;
+  /* wake up threads waiting in _drain_output_queue() */
+  g_cond_broadcast (&priv->output_cond);
+  g_mutex_unlock (&priv->output_lock);
+
+  return;
+
+paused:
+  GST_LOG_OBJECT (encoder, "pausing output task");
+  g_mutex_unlock (&priv->output_lock);
+  gst_pad_pause_task (encoder->srcpad);
+}
+
+/* Wait until the output task has pushed all frames queued so far.
+ * Call without the stream lock held, the task needs it to push. */
+static void
+gst_video_encoder_drain_output_queue (GstVideoEncoder * encoder)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+
+  g_mutex_lock (&priv->output_lock);
+  while (priv->output_task_running && priv->output_pending > 0)
+    g_cond_wait (&priv->output_cond, &priv->output_lock);
+  g_mutex_unlock (&priv->output_lock);
+}
+
+/* Shut down the output task and drop frames it did not get to push.
+ * Call without the stream lock held. */
+static void
+gst_video_encoder_stop_output_task (GstVideoEncoder * encoder)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+  GstVideoCodecFrame *frame;
+  gboolean was_running;
+
+  g_mutex_lock (&priv->output_lock);
+  was_running = priv->output_task_running;
+  priv->output_task_running = FALSE;
+  g_cond_broadcast (&priv->output_cond);
+  g_mutex_unlock (&priv->output_lock);
+
+  if (was_running)
+    gst_pad_stop_task (encoder->srcpad);
+
+  while ((frame = gst_atomic_queue_pop (priv->output_queue)))
+    gst_video_codec_frame_unref (frame);
+
+  g_mutex_lock (&priv->output_lock);
+  priv->output_pending = 0;
+  priv->output_flow = GST_FLOW_OK;
+  g_mutex_unlock (&priv->output_lock);
+}
+
 /**
  * gst_video_encoder_finish_frame:
  * @encoder: a #GstVideoEncoder
@@ -1917,6 +2309,13 @@ foreach_metadata (GstBuffer * inbuf, GstMeta ** meta, gpointer user_data)
  * considered read-only. This function will also change the metadata
  * of the buffer.
  *
+ * When async push was enabled with gst_video_encoder_set_async_push(),
+ * the frame is deposited in a lock-free queue and pushed from a
+ * separate streaming task instead, so this function does not take the
+ * stream lock and can be called from the subclass's encoding threads
+ * without contending with @handle_frame. The returned value is then
+ * the result of pushing a previously finished frame.
+ *
  * Returns: a #GstFlowReturn resulting from sending data downstream
  */
 GstFlowReturn
@@ -1924,6 +2323,40 @@ gst_video_encoder_finish_frame (GstVideoEncoder * encoder,
     GstVideoCodecFrame * frame)
 {
   GstVideoEncoderPrivate *priv = encoder->priv;
+
+  if (g_atomic_int_get (&priv->async_push)) {
+    GstFlowReturn ret;
+
+    g_mutex_lock (&priv->output_lock);
+    if (!priv->output_task_running) {
+      priv->output_task_running = TRUE;
+      priv->output_flow = GST_FLOW_OK;
+      gst_pad_start_task (encoder->srcpad,
+          (GstTaskFunction) gst_video_encoder_output_loop, encoder, NULL);
+    }
+    priv->output_pending++;
+    ret = priv->output_flow;
+    g_mutex_unlock (&priv->output_lock);
+
+    /* the queue itself is lock-free; the lock is only retaken below so
+     * the wakeup cannot race with the output task going to sleep */
+    gst_atomic_queue_push (priv->output_queue, frame);
+
+    g_mutex_lock (&priv->output_lock);
+    g_cond_broadcast (&priv->output_cond);
+    g_mutex_unlock (&priv->output_lock);
+
+    return ret;
+  }
+
+  return gst_video_encoder_finish_frame_real (encoder, frame);
+}
+
+static GstFlowReturn
+gst_video_encoder_finish_frame_real (GstVideoEncoder * encoder,
+    GstVideoCodecFrame * frame)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
   GstFlowReturn ret = GST_FLOW_OK;
   GstVideoEncoderClass *encoder_class;
   GList *l;
@@ -2199,6 +2632,56 @@ no_output_state:
   }
 }
 
+/**
+ * gst_video_encoder_set_async_push:
+ * @encoder: a #GstVideoEncoder
+ * @enabled: new state
+ *
+ * Configures whether gst_video_encoder_finish_frame() hands finished
+ * frames over to a streaming task on the srcpad instead of pushing them
+ * directly. In that mode the handoff is lock-free, so encoders doing
+ * the actual encoding in background threads (hardware or thread-pool
+ * based encoders) can finish frames without contending with
+ * @handle_frame on the stream lock. Frames are pushed downstream in
+ * the order they were finished.
+ *
+ * By default async push is disabled.
+ *
+ * MT safe.
+ *
+ * Since: 1.14
+ */
+void
+gst_video_encoder_set_async_push (GstVideoEncoder * encoder, gboolean enabled)
+{
+  g_return_if_fail (GST_IS_VIDEO_ENCODER (encoder));
+
+  GST_DEBUG_OBJECT (encoder, "enabled (%d)", enabled);
+
+  g_atomic_int_set (&encoder->priv->async_push, enabled);
+}
+
+/**
+ * gst_video_encoder_get_async_push:
+ * @encoder: a #GstVideoEncoder
+ *
+ * Queries whether finished frames are pushed from a separate streaming
+ * task, see gst_video_encoder_set_async_push().
+ *
+ * MT safe.
+ *
+ * Returns: %TRUE if async push is enabled.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_video_encoder_get_async_push (GstVideoEncoder * encoder)
+{
+  g_return_val_if_fail (GST_IS_VIDEO_ENCODER (encoder), FALSE);
+
+  return g_atomic_int_get (&encoder->priv->async_push);
+}
+
 /**
  * gst_video_encoder_get_output_state:
  * @encoder: a #GstVideoEncoder
@@ -336,6 +336,13 @@ GST_EXPORT
 GstFlowReturn        gst_video_encoder_finish_frame (GstVideoEncoder *encoder,
 						     GstVideoCodecFrame *frame);
 
+GST_EXPORT
+void                 gst_video_encoder_set_async_push (GstVideoEncoder *encoder,
+						       gboolean enabled);
+
+GST_EXPORT
+gboolean             gst_video_encoder_get_async_push (GstVideoEncoder *encoder);
+
 GST_EXPORT
 GstCaps *            gst_video_encoder_proxy_getcaps (GstVideoEncoder * enc,
 						      GstCaps         * caps,
@@ -91,6 +91,8 @@ gst_video_filter_propose_allocation (GstBaseTransform * trans,
     structure = gst_buffer_pool_get_config (pool);
     gst_buffer_pool_config_set_params (structure, caps, size, 0, 0);
     gst_buffer_pool_config_set_allocator (structure, allocator, &params);
+    gst_buffer_pool_config_add_option (structure,
+        GST_BUFFER_POOL_OPTION_VIDEO_META);
 
     if (allocator)
       gst_object_unref (allocator);
@@ -100,9 +102,13 @@ gst_video_filter_propose_allocation (GstBaseTransform * trans,
 
     gst_query_add_allocation_pool (query, pool, size, 0, 0);
     gst_object_unref (pool);
-    gst_query_add_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL);
   }
 
+  /* we can map arbitrary strides and offsets, announce this even when
+   * upstream already supplied a pool so it can output into its own
+   * buffers without a copy */
+  gst_query_add_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL);
+
   return TRUE;
 
   /* ERRORS */
@@ -17,9 +17,21 @@
  * Boston, MA 02110-1301, USA.
  */
 
+#include <string.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
 #include "gst/video/gstvideometa.h"
 #include "gst/video/gstvideopool.h"
 
+/* transparent huge pages are 2MB on all current Linux architectures */
+#define VIDEO_BUFFER_POOL_HUGEPAGE_SIZE (2 * 1024 * 1024)
+
 
 GST_DEBUG_CATEGORY_STATIC (gst_video_pool_debug);
 #define GST_CAT_DEFAULT gst_video_pool_debug
@@ -91,6 +103,59 @@ gst_buffer_pool_config_get_video_alignment (GstStructure * config,
       "stride-align3", G_TYPE_UINT, &align->stride_align[3], NULL);
 }
 
+/**
+ * gst_buffer_pool_config_set_video_placement:
+ * @config: a #GstStructure
+ * @numa_node: the NUMA node to allocate the frames on, or -1 for no binding
+ * @hugepages: whether to back the frames with transparent huge pages
+ *
+ * Set the memory placement parameters in the bufferpool configuration
+ * @config. Only used when #GST_BUFFER_POOL_OPTION_VIDEO_PLACEMENT is
+ * enabled on the bufferpool.
+ *
+ * NUMA binding and huge pages are only implemented on Linux; on other
+ * platforms the parameters are ignored and only the pre-faulting of the
+ * preallocated buffers remains.
+ *
+ * Since: 1.14
+ */
+void
+gst_buffer_pool_config_set_video_placement (GstStructure * config,
+    gint numa_node, gboolean hugepages)
+{
+  g_return_if_fail (config != NULL);
+
+  gst_structure_set (config,
+      "numa-node", G_TYPE_INT, numa_node,
+      "hugepages", G_TYPE_BOOLEAN, hugepages, NULL);
+}
+
+/**
+ * gst_buffer_pool_config_get_video_placement:
+ * @config: a #GstStructure
+ * @numa_node: (out): the NUMA node to allocate the frames on, or -1
+ * @hugepages: (out): whether to back the frames with transparent huge pages
+ *
+ * Get the memory placement parameters from the bufferpool configuration
+ * @config.
+ *
+ * Returns: #TRUE if @config could be parsed correctly.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_buffer_pool_config_get_video_placement (GstStructure * config,
+    gint * numa_node, gboolean * hugepages)
+{
+  g_return_val_if_fail (config != NULL, FALSE);
+  g_return_val_if_fail (numa_node != NULL, FALSE);
+  g_return_val_if_fail (hugepages != NULL, FALSE);
+
+  return gst_structure_get (config,
+      "numa-node", G_TYPE_INT, numa_node,
+      "hugepages", G_TYPE_BOOLEAN, hugepages, NULL);
+}
+
 /* bufferpool */
 struct _GstVideoBufferPoolPrivate
 {
@@ -99,6 +164,9 @@ struct _GstVideoBufferPoolPrivate
   GstVideoAlignment video_align;
   gboolean add_videometa;
   gboolean need_alignment;
+  gboolean need_placement;
+  gint numa_node;
+  gboolean hugepages;
   GstAllocator *allocator;
   GstAllocationParams params;
 };
@@ -115,7 +183,8 @@ static const gchar **
 video_buffer_pool_get_options (GstBufferPool * pool)
 {
   static const gchar *options[] = { GST_BUFFER_POOL_OPTION_VIDEO_META,
-    GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT, NULL
+    GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT,
+    GST_BUFFER_POOL_OPTION_VIDEO_PLACEMENT, NULL
   };
   return options;
 }
@@ -173,6 +242,7 @@ video_buffer_pool_set_config (GstBufferPool * pool, GstStructure * config)
   priv->need_alignment = gst_buffer_pool_config_has_option (config,
       GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT);
 
+
   if (priv->need_alignment && priv->add_videometa) {
     guint max_align, n;
 
@@ -200,6 +270,27 @@ video_buffer_pool_set_config (GstBufferPool * pool, GstStructure * config)
       gst_buffer_pool_config_set_allocator (config, allocator, &priv->params);
     }
   }
+
+  /* parse memory placement info; done after the stride alignment handling
+   * so that the buffer start alignment for huge pages does not end up in
+   * the per plane stride alignment */
+  priv->need_placement = gst_buffer_pool_config_has_option (config,
+      GST_BUFFER_POOL_OPTION_VIDEO_PLACEMENT);
+
+  if (priv->need_placement) {
+    priv->numa_node = -1;
+    priv->hugepages = FALSE;
+    gst_buffer_pool_config_get_video_placement (config, &priv->numa_node,
+        &priv->hugepages);
+
+    if (priv->hugepages &&
+        priv->params.align < VIDEO_BUFFER_POOL_HUGEPAGE_SIZE - 1) {
+      /* huge pages can only back the buffer when it covers whole aligned
+       * 2MB regions */
+      priv->params.align = VIDEO_BUFFER_POOL_HUGEPAGE_SIZE - 1;
+      gst_buffer_pool_config_set_allocator (config, allocator, &priv->params);
+    }
+  }
   info.size = MAX (size, info.size);
   priv->info = info;
 
@@ -238,6 +329,121 @@ failed_to_align:
   }
 }
 
+/* Applies the configured memory placement to a freshly allocated buffer:
+ * advises the kernel about huge pages and NUMA binding where supported and
+ * then touches every page, so that the pages are instantiated here, with
+ * the right placement, and not on the first frame of the stream. */
+static void
+video_buffer_pool_apply_placement (GstVideoBufferPool * vpool,
+    GstBuffer * buffer)
+{
+  GstVideoBufferPoolPrivate *priv = vpool->priv;
+  GstMapInfo map;
+
+  if (!gst_buffer_map (buffer, &map, GST_MAP_WRITE))
+    return;
+
+#ifdef __linux__
+  {
+    gsize page_size = sysconf (_SC_PAGESIZE);
+    guint8 *start, *end;
+
+    /* only whole pages; madvise and mbind would else affect unrelated
+     * allocations sharing the first and last page */
+    start = (guint8 *) (((guintptr) map.data + page_size - 1) &
+        ~(page_size - 1));
+    end = (guint8 *) (((guintptr) map.data + map.size) & ~(page_size - 1));
+
+    if (end > start) {
+#ifdef MADV_HUGEPAGE
+      if (priv->hugepages) {
+        if (madvise (start, end - start, MADV_HUGEPAGE) != 0)
+          GST_WARNING_OBJECT (vpool, "madvise(MADV_HUGEPAGE) failed: %s",
+              g_strerror (errno));
+      }
+#endif
+#ifdef SYS_mbind
+      if (priv->numa_node >= 0 && priv->numa_node < 1024) {
+        unsigned long nodemask[1024 / (8 * sizeof (unsigned long))] = { 0, };
+        /* MPOL_BIND as defined in linux/mempolicy.h */
+        const int mpol_bind = 2;
+
+        nodemask[priv->numa_node / (8 * sizeof (unsigned long))] |=
+            1UL << (priv->numa_node % (8 * sizeof (unsigned long)));
+
+        if (syscall (SYS_mbind, (unsigned long) start,
+                (unsigned long) (end - start), mpol_bind, nodemask,
+                (unsigned long) (8 * sizeof (nodemask) + 1), 0UL) != 0)
+          GST_WARNING_OBJECT (vpool, "mbind to NUMA node %d failed: %s",
+              priv->numa_node, g_strerror (errno));
+      }
+#endif
+    }
+  }
+#endif
+
+  /* touch all pages */
+  memset (map.data, 0, map.size);
+
+  gst_buffer_unmap (buffer, &map);
+}
+
+/* Pool buffers carry exactly one memory block holding all planes, so the
+ * per-plane offset search and range mapping of the generic video meta map
+ * can be skipped: map the block directly with the caller's flags. Each
+ * map call takes its own short-lived lock on the memory, so sharing the
+ * memory into other buffers (tee, shallow copies) keeps working. */
+static gboolean
+video_buffer_pool_direct_map (GstVideoMeta * meta, guint plane,
+    GstMapInfo * info, gpointer * data, gint * stride, GstMapFlags flags)
+{
+  GstBuffer *buffer = meta->buffer;
+  guint idx, length;
+  gsize offset, skip;
+
+  if (G_LIKELY (gst_buffer_n_memory (buffer) == 1)) {
+    GstMemory *mem = gst_buffer_peek_memory (buffer, 0);
+
+    /* a write map must not touch memory another buffer can see; the
+     * generic path copies such memory, so leave it those cases */
+    if ((flags & GST_MAP_WRITE) == 0 || (gst_buffer_is_writable (buffer)
+            && GST_MINI_OBJECT_REFCOUNT_VALUE (mem) == 1)) {
+      if (gst_memory_map (mem, info, flags)) {
+        /* the ref balances the unref in gst_buffer_unmap(), keeping the
+         * same contract as the generic gst_buffer_map_range() path */
+        gst_memory_ref (mem);
+        *stride = meta->stride[plane];
+        *data = (guint8 *) info->data + meta->offset[plane];
+        return TRUE;
+      }
+    }
+  }
+
+  /* the generic lookup for foreign, shared or replaced memory */
+  offset = meta->offset[plane];
+  if (!gst_buffer_find_memory (buffer, offset, 1, &idx, &length, &skip))
+    goto no_memory;
+  if (!gst_buffer_map_range (buffer, idx, length, info, flags))
+    goto cannot_map;
+
+  *stride = meta->stride[plane];
+  *data = (guint8 *) info->data + skip;
+
+  return TRUE;
+
+  /* ERRORS */
+no_memory:
+  {
+    GST_DEBUG ("plane %u, no memory at offset %" G_GSIZE_FORMAT, plane, offset);
+    return FALSE;
+  }
+cannot_map:
+  {
+    GST_DEBUG ("cannot map memory range %u-%u", idx, length);
+    return FALSE;
+  }
+}
+
 static GstFlowReturn
 video_buffer_pool_alloc (GstBufferPool * pool, GstBuffer ** buffer,
     GstBufferPoolAcquireParams * params)
@@ -255,13 +461,29 @@ video_buffer_pool_alloc (GstBufferPool * pool, GstBuffer ** buffer,
   if (*buffer == NULL)
     goto no_memory;
 
+  if (priv->need_placement)
+    video_buffer_pool_apply_placement (vpool, *buffer);
+
   if (priv->add_videometa) {
+    GstVideoMeta *meta;
+
     GST_DEBUG_OBJECT (pool, "adding GstVideoMeta");
 
-    gst_buffer_add_video_meta_full (*buffer, GST_VIDEO_FRAME_FLAG_NONE,
+    meta = gst_buffer_add_video_meta_full (*buffer, GST_VIDEO_FRAME_FLAG_NONE,
         GST_VIDEO_INFO_FORMAT (info),
         GST_VIDEO_INFO_WIDTH (info), GST_VIDEO_INFO_HEIGHT (info),
         GST_VIDEO_INFO_N_PLANES (info), info->offset, info->stride);
+
+    /* the meta describes the fixed layout of the pooled memory and never
+     * changes, so pin it to the buffer: POOLED keeps it across release
+     * and re-acquire instead of having it stripped and re-added every
+     * cycle, LOCKED stops users from removing it from a pooled buffer */
+    GST_META_FLAG_SET (meta, GST_META_FLAG_POOLED);
+    GST_META_FLAG_SET (meta, GST_META_FLAG_LOCKED);
+
+    /* both map paths unmap through gst_buffer_unmap(), so the default
+     * unmap implementation stays in place */
+    meta->map = video_buffer_pool_direct_map;
   }
 
   return GST_FLOW_OK;
@@ -45,6 +45,21 @@ G_BEGIN_DECLS
  */
 #define GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT "GstBufferPoolOptionVideoAlignment"
 
+/**
+ * GST_BUFFER_POOL_OPTION_VIDEO_PLACEMENT:
+ *
+ * A bufferpool option to control the physical placement of the frame
+ * memory. When a bufferpool supports this option,
+ * gst_buffer_pool_config_set_video_placement() can be called.
+ *
+ * When this option is enabled on the bufferpool, all pages of the
+ * preallocated buffers are touched when they are allocated, so that
+ * streaming does not hit first-touch page faults.
+ *
+ * Since: 1.14
+ */
+#define GST_BUFFER_POOL_OPTION_VIDEO_PLACEMENT "GstBufferPoolOptionVideoPlacement"
+
 /* setting a bufferpool config */
 
 GST_EXPORT
@@ -53,6 +68,12 @@ void             gst_buffer_pool_config_set_video_alignment  (GstStructure *conf
 GST_EXPORT
 gboolean         gst_buffer_pool_config_get_video_alignment  (GstStructure *config, GstVideoAlignment *align);
 
+GST_EXPORT
+void             gst_buffer_pool_config_set_video_placement  (GstStructure *config, gint numa_node, gboolean hugepages);
+
+GST_EXPORT
+gboolean         gst_buffer_pool_config_get_video_placement  (GstStructure *config, gint *numa_node, gboolean *hugepages);
+
 /* video bufferpool */
 typedef struct _GstVideoBufferPool GstVideoBufferPool;
 typedef struct _GstVideoBufferPoolClass GstVideoBufferPoolClass;
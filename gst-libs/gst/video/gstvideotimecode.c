@@ -353,68 +353,27 @@ gst_video_time_code_increment_frame (GstVideoTimeCode * tc)
   gst_video_time_code_add_frames (tc, 1);
 }
 
-/**
- * gst_video_time_code_add_frames:
- * @tc: a valid #GstVideoTimeCode
- * @frames: How many frames to add or subtract
- *
- * Adds or subtracts @frames amount of frames to @tc. tc needs to
- * contain valid data, as verified by #gst_video_time_code_is_valid.
- *
- * Since: 1.10
- */
-void
-gst_video_time_code_add_frames (GstVideoTimeCode * tc, gint64 frames)
+/* Decomposes @framecount, a frame number since the daily jam, into the
+ * hours/minutes/seconds/frames fields of @tc. The frame rate parameters
+ * must match tc->config, as computed by the callers. */
+static void
+gst_video_time_code_from_frames_since_daily_jam (GstVideoTimeCode * tc,
+    guint64 framecount, guint ff_nom, guint ff_minutes, guint ff_hours,
+    guint dropframe_multiplier)
 {
-  guint64 framecount;
   guint64 h_notmod24;
   guint64 h_new, min_new, sec_new, frames_new;
-  gdouble ff;
-  guint ff_nom;
   /* This allows for better readability than putting G_GUINT64_CONSTANT(60)
    * into a long calculation line */
   const guint64 sixty = 60;
   /* formulas found in SMPTE ST 2059-1:2015 section 9.4.3
    * and adapted for 60/1.001 as well as 30/1.001 */
 
-  g_return_if_fail (gst_video_time_code_is_valid (tc));
-
-  gst_util_fraction_to_double (tc->config.fps_n, tc->config.fps_d, &ff);
-  if (tc->config.fps_d == 1001) {
-    ff_nom = tc->config.fps_n / 1000;
-  } else {
-    ff_nom = ff;
-    if (tc->config.fps_d != 1)
-      GST_WARNING ("Unsupported frame rate %u/%u, results may be wrong",
-          tc->config.fps_n, tc->config.fps_d);
-  }
   if (tc->config.flags & GST_VIDEO_TIME_CODE_FLAGS_DROP_FRAME) {
-    /* these need to be truncated to integer: side effect, code looks cleaner
-     * */
-    guint ff_minutes = 60 * ff;
-    guint ff_hours = 3600 * ff;
     /* a bunch of intermediate variables, to avoid monster code with possible
      * integer overflows */
     guint64 min_new_tmp1, min_new_tmp2, min_new_tmp3, min_new_denom;
-    /* for 30000/1001 we drop the first 2 frames per minute, for 60000/1001 we
-     * drop the first 4 : so we use this number */
-    guint dropframe_multiplier;
-
-    if (tc->config.fps_n == 30000)
-      dropframe_multiplier = 2;
-    else if (tc->config.fps_n == 60000)
-      dropframe_multiplier = 4;
-    else {
-      GST_ERROR ("Unsupported drop frame rate %u/%u", tc->config.fps_n,
-          tc->config.fps_d);
-      return;
-    }
 
-    framecount =
-        frames + tc->frames + (ff_nom * tc->seconds) +
-        (ff_minutes * tc->minutes) +
-        dropframe_multiplier * ((gint) (tc->minutes / 10)) +
-        (ff_hours * tc->hours);
     h_notmod24 = gst_util_uint64_scale_int (framecount, 1, ff_hours);
 
     min_new_denom = sixty * ff_nom;
@@ -438,9 +397,6 @@ gst_video_time_code_add_frames (GstVideoTimeCode * tc, gint64 frames)
         (dropframe_multiplier * ((gint) (min_new / 10))) -
         (ff_hours * h_notmod24);
   } else {
-    framecount =
-        frames + tc->frames + (ff_nom * (tc->seconds + (sixty * (tc->minutes +
-                    (sixty * tc->hours)))));
     h_notmod24 =
         gst_util_uint64_scale_int (framecount, 1, ff_nom * sixty * sixty);
     min_new =
@@ -466,6 +422,148 @@ gst_video_time_code_add_frames (GstVideoTimeCode * tc, gint64 frames)
   tc->frames = frames_new;
 }
 
+/**
+ * gst_video_time_code_add_frames:
+ * @tc: a valid #GstVideoTimeCode
+ * @frames: How many frames to add or subtract
+ *
+ * Adds or subtracts @frames amount of frames to @tc. tc needs to
+ * contain valid data, as verified by #gst_video_time_code_is_valid.
+ *
+ * Since: 1.10
+ */
+void
+gst_video_time_code_add_frames (GstVideoTimeCode * tc, gint64 frames)
+{
+  guint64 framecount;
+  gdouble ff;
+  guint ff_nom;
+  guint ff_minutes = 0, ff_hours = 0;
+  guint dropframe_multiplier = 0;
+
+  g_return_if_fail (gst_video_time_code_is_valid (tc));
+
+  gst_util_fraction_to_double (tc->config.fps_n, tc->config.fps_d, &ff);
+  if (tc->config.fps_d == 1001) {
+    ff_nom = tc->config.fps_n / 1000;
+  } else {
+    ff_nom = ff;
+    if (tc->config.fps_d != 1)
+      GST_WARNING ("Unsupported frame rate %u/%u, results may be wrong",
+          tc->config.fps_n, tc->config.fps_d);
+  }
+  if (tc->config.flags & GST_VIDEO_TIME_CODE_FLAGS_DROP_FRAME) {
+    /* these need to be truncated to integer: side effect, code looks cleaner
+     * */
+    ff_minutes = 60 * ff;
+    ff_hours = 3600 * ff;
+
+    /* for 30000/1001 we drop the first 2 frames per minute, for 60000/1001 we
+     * drop the first 4 : so we use this number */
+    if (tc->config.fps_n == 30000)
+      dropframe_multiplier = 2;
+    else if (tc->config.fps_n == 60000)
+      dropframe_multiplier = 4;
+    else {
+      GST_ERROR ("Unsupported drop frame rate %u/%u", tc->config.fps_n,
+          tc->config.fps_d);
+      return;
+    }
+
+    framecount =
+        frames + tc->frames + (ff_nom * tc->seconds) +
+        (ff_minutes * tc->minutes) +
+        dropframe_multiplier * ((gint) (tc->minutes / 10)) +
+        (ff_hours * tc->hours);
+  } else {
+    framecount =
+        frames + tc->frames + (ff_nom * (tc->seconds +
+            (G_GUINT64_CONSTANT (60) * (tc->minutes +
+                    (G_GUINT64_CONSTANT (60) * tc->hours)))));
+  }
+
+  gst_video_time_code_from_frames_since_daily_jam (tc, framecount, ff_nom,
+      ff_minutes, ff_hours, dropframe_multiplier);
+}
+
+/**
+ * gst_video_time_code_add_frames_batch:
+ * @tc: a valid #GstVideoTimeCode
+ * @frames: (array length=n_frames): frame offsets to add to @tc
+ * @result: (array length=n_frames): array of #GstVideoTimeCode to fill
+ * @n_frames: how many entries in @frames and @result
+ *
+ * Converts an array of frame offsets relative to @tc into time codes in
+ * one call. result[i] is set to @tc advanced by frames[i], as if by
+ * gst_video_time_code_add_frames(), but the validation of @tc and the
+ * conversion of @tc itself to a frame number since the daily jam are only
+ * done once for the whole array.
+ *
+ * The entries of @result must be freed with gst_video_time_code_clear()
+ * when no longer needed.
+ *
+ * Since: 1.14
+ */
+void
+gst_video_time_code_add_frames_batch (const GstVideoTimeCode * tc,
+    const gint64 * frames, GstVideoTimeCode * result, guint n_frames)
+{
+  guint64 framecount;
+  gdouble ff;
+  guint ff_nom;
+  guint ff_minutes = 0, ff_hours = 0;
+  guint dropframe_multiplier = 0;
+  guint i;
+
+  g_return_if_fail (gst_video_time_code_is_valid (tc));
+  g_return_if_fail (frames != NULL);
+  g_return_if_fail (result != NULL);
+
+  gst_util_fraction_to_double (tc->config.fps_n, tc->config.fps_d, &ff);
+  if (tc->config.fps_d == 1001) {
+    ff_nom = tc->config.fps_n / 1000;
+  } else {
+    ff_nom = ff;
+    if (tc->config.fps_d != 1)
+      GST_WARNING ("Unsupported frame rate %u/%u, results may be wrong",
+          tc->config.fps_n, tc->config.fps_d);
+  }
+  if (tc->config.flags & GST_VIDEO_TIME_CODE_FLAGS_DROP_FRAME) {
+    ff_minutes = 60 * ff;
+    ff_hours = 3600 * ff;
+
+    if (tc->config.fps_n == 30000)
+      dropframe_multiplier = 2;
+    else if (tc->config.fps_n == 60000)
+      dropframe_multiplier = 4;
+    else {
+      GST_ERROR ("Unsupported drop frame rate %u/%u", tc->config.fps_n,
+          tc->config.fps_d);
+      return;
+    }
+
+    framecount =
+        tc->frames + (ff_nom * tc->seconds) +
+        (ff_minutes * tc->minutes) +
+        dropframe_multiplier * ((gint) (tc->minutes / 10)) +
+        (ff_hours * tc->hours);
+  } else {
+    framecount =
+        tc->frames + (ff_nom * (tc->seconds +
+            (G_GUINT64_CONSTANT (60) * (tc->minutes +
+                    (G_GUINT64_CONSTANT (60) * tc->hours)))));
+  }
+
+  for (i = 0; i < n_frames; i++) {
+    gst_video_time_code_init (&result[i], tc->config.fps_n, tc->config.fps_d,
+        tc->config.latest_daily_jam, tc->config.flags, 0, 0, 0, 0,
+        tc->field_count);
+    gst_video_time_code_from_frames_since_daily_jam (&result[i],
+        framecount + frames[i], ff_nom, ff_minutes, ff_hours,
+        dropframe_multiplier);
+  }
+}
+
 /**
  * gst_video_time_code_compare:
  * @tc1: a #GstVideoTimeCode
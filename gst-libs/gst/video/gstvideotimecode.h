@@ -192,6 +192,12 @@ GST_EXPORT
 void gst_video_time_code_add_frames                 (GstVideoTimeCode       * tc,
                                                      gint64                   frames);
 
+GST_EXPORT
+void gst_video_time_code_add_frames_batch           (const GstVideoTimeCode * tc,
+                                                     const gint64           * frames,
+                                                     GstVideoTimeCode       * result,
+                                                     guint                    n_frames);
+
 GST_EXPORT
 gchar *gst_video_time_code_to_string                (const GstVideoTimeCode * tc);
 
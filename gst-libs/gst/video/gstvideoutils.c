@@ -25,6 +25,7 @@
 
 #include <gst/video/video.h>
 #include "gstvideoutils.h"
+#include "gstvideoutilsprivate.h"
 
 #include <string.h>
 
@@ -32,9 +33,99 @@ G_DEFINE_BOXED_TYPE (GstVideoCodecFrame, gst_video_codec_frame,
     (GBoxedCopyFunc) gst_video_codec_frame_ref,
     (GBoxedFreeFunc) gst_video_codec_frame_unref);
 
+/* Number of frame structures each pool keeps around for reuse; enough to
+ * cover the frames a typical decoder has in flight */
+#define FRAME_POOL_MAX_FRAMES 16
+
+struct _GstVideoCodecFramePool
+{
+  /* one reference for the owning element plus one per frame that was
+   * allocated from the pool, so a frame kept by a subclass can outlive
+   * the element */
+  gint ref_count;
+
+  GMutex lock;
+  GstVideoCodecFrame *free_frames[FRAME_POOL_MAX_FRAMES];
+  guint n_free;
+  /* set to FALSE once the owning element released the pool */
+  gboolean active;
+};
+
+static void
+frame_pool_unref (GstVideoCodecFramePool * pool)
+{
+  if (g_atomic_int_dec_and_test (&pool->ref_count)) {
+    g_mutex_clear (&pool->lock);
+    g_slice_free (GstVideoCodecFramePool, pool);
+  }
+}
+
+GstVideoCodecFramePool *
+__gst_video_codec_frame_pool_new (void)
+{
+  GstVideoCodecFramePool *pool;
+
+  pool = g_slice_new0 (GstVideoCodecFramePool);
+  pool->ref_count = 1;
+  g_mutex_init (&pool->lock);
+  pool->active = TRUE;
+
+  return pool;
+}
+
+/* Called by the owning element when it goes away; cached frames are
+ * freed and frames returned later are released immediately */
+void
+__gst_video_codec_frame_pool_release (GstVideoCodecFramePool * pool)
+{
+  GstVideoCodecFrame *frames[FRAME_POOL_MAX_FRAMES];
+  guint i, n;
+
+  g_mutex_lock (&pool->lock);
+  pool->active = FALSE;
+  n = pool->n_free;
+  memcpy (frames, pool->free_frames, n * sizeof (frames[0]));
+  pool->n_free = 0;
+  g_mutex_unlock (&pool->lock);
+
+  for (i = 0; i < n; i++) {
+    g_slice_free (GstVideoCodecFrame, frames[i]);
+    frame_pool_unref (pool);
+  }
+  frame_pool_unref (pool);
+}
+
+/* Get a zero-initialized frame with a refcount of 1, reusing a recycled
+ * frame structure when one is available */
+GstVideoCodecFrame *
+__gst_video_codec_frame_pool_acquire (GstVideoCodecFramePool * pool)
+{
+  GstVideoCodecFrame *frame = NULL;
+
+  g_mutex_lock (&pool->lock);
+  if (pool->n_free > 0)
+    frame = pool->free_frames[--pool->n_free];
+  g_mutex_unlock (&pool->lock);
+
+  if (frame) {
+    /* the cached frame keeps holding its pool reference */
+    memset (frame, 0, sizeof (*frame));
+  } else {
+    frame = g_slice_new0 (GstVideoCodecFrame);
+    g_atomic_int_inc (&pool->ref_count);
+  }
+
+  frame->ref_count = 1;
+  frame->abidata.ABI.frame_pool = pool;
+
+  return frame;
+}
+
 static void
 _gst_video_codec_frame_free (GstVideoCodecFrame * frame)
 {
+  GstVideoCodecFramePool *pool;
+
   g_return_if_fail (frame != NULL);
 
   GST_DEBUG ("free frame %p", frame);
@@ -53,7 +144,24 @@ _gst_video_codec_frame_free (GstVideoCodecFrame * frame)
   if (frame->user_data_destroy_notify)
     frame->user_data_destroy_notify (frame->user_data);
 
-  g_slice_free (GstVideoCodecFrame, frame);
+  pool = frame->abidata.ABI.frame_pool;
+  if (pool) {
+    gboolean cached = FALSE;
+
+    g_mutex_lock (&pool->lock);
+    if (pool->active && pool->n_free < FRAME_POOL_MAX_FRAMES) {
+      pool->free_frames[pool->n_free++] = frame;
+      cached = TRUE;
+    }
+    g_mutex_unlock (&pool->lock);
+
+    if (!cached) {
+      g_slice_free (GstVideoCodecFrame, frame);
+      frame_pool_unref (pool);
+    }
+  } else {
+    g_slice_free (GstVideoCodecFrame, frame);
+  }
 }
 
 /**
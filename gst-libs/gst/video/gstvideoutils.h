@@ -258,6 +258,9 @@ struct _GstVideoCodecFrame
     struct {
       GstClockTime ts;
       GstClockTime ts2;
+      guint num_subframes;
+      guint subframes_processed;
+      gpointer frame_pool;
     } ABI;
     void         *padding[GST_PADDING_LARGE];
   } abidata;
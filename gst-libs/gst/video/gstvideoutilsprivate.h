@@ -30,6 +30,20 @@
 
 G_BEGIN_DECLS
 
+/* Recycling pool for #GstVideoCodecFrame, shared between a codec element
+ * and the frames allocated from it so frames may safely outlive the
+ * element */
+typedef struct _GstVideoCodecFramePool GstVideoCodecFramePool;
+
+G_GNUC_INTERNAL
+GstVideoCodecFramePool *__gst_video_codec_frame_pool_new     (void);
+
+G_GNUC_INTERNAL
+void                    __gst_video_codec_frame_pool_release (GstVideoCodecFramePool * pool);
+
+G_GNUC_INTERNAL
+GstVideoCodecFrame     *__gst_video_codec_frame_pool_acquire (GstVideoCodecFramePool * pool);
+
 /* Element utility functions */
 G_GNUC_INTERNAL
 GstCaps *__gst_video_element_proxy_getcaps (GstElement * element, GstPad * sinkpad,
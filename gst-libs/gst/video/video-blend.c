@@ -294,7 +294,7 @@ gst_video_blend (GstVideoFrame * dest,
   gint i, j, global_alpha_val, src_width, src_height, dest_width, dest_height;
   gint src_xoff = 0, src_yoff = 0;
   guint8 *tmpdestline = NULL, *tmpsrcline = NULL;
-  gboolean src_premultiplied_alpha, dest_premultiplied_alpha;
+  gboolean src_premultiplied_alpha, dest_premultiplied_alpha, orc_blend;
   void (*matrix) (guint8 * tmpline, guint width);
   const GstVideoFormatInfo *sinfo, *dinfo, *dunpackinfo, *sunpackinfo;
 
@@ -359,6 +359,14 @@ gst_video_blend (GstVideoFrame * dest,
     }
   }
 
+  /* for the common case of a non-premultiplied overlay on an opaque
+   * destination with no global alpha, the per-pixel loop reduces to
+   * d = d + (s - d) * a / 255, which the orc kernel implements with
+   * SIMD where available */
+  orc_blend = (global_alpha == 1.0 && !src_premultiplied_alpha
+      && !dest_premultiplied_alpha
+      && !GST_VIDEO_FORMAT_INFO_HAS_ALPHA (dinfo));
+
   /* If we're here we know that the overlay image fully or
    * partially overlaps with the video frame */
 
@@ -385,12 +393,27 @@ gst_video_blend (GstVideoFrame * dest,
 
   /* Mainloop doing the needed conversions, and blending */
   for (i = y; i < y + src_height; i++, src_yoff++) {
+    gboolean row_transparent;
 
-    dinfo->unpack_func (dinfo, 0, tmpdestline, dest->data, dest->info.stride,
-        0, i, dest_width);
     sinfo->unpack_func (sinfo, 0, tmpsrcline, src->data, src->info.stride,
         src_xoff, src_yoff, src_width);
 
+    /* overlay images such as rendered text are mostly transparent; when a
+     * whole source row is, the destination row does not need to be unpacked
+     * and packed back at all */
+    row_transparent = TRUE;
+    for (j = 0; j < src_width * 4; j += 4) {
+      if (tmpsrcline[j]) {
+        row_transparent = FALSE;
+        break;
+      }
+    }
+    if (row_transparent)
+      continue;
+
+    dinfo->unpack_func (dinfo, 0, tmpdestline, dest->data, dest->info.stride,
+        0, i, dest_width);
+
     /* FIXME: use the x parameter of the unpack func once implemented */
     tmpdestline += 4 * x;
 
@@ -418,7 +441,15 @@ gst_video_blend (GstVideoFrame * dest,
     }                                                                                         \
   } G_STMT_END
 
-    if (G_LIKELY (global_alpha == 1.0)) {
+    if (orc_blend) {
+      /* unpacked lines are in AYUV/ARGB byte order, so the alpha byte is
+       * in the low byte of each 32-bit word on little endian */
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+      video_orc_blend_little (tmpdestline, tmpsrcline, src_width);
+#else
+      video_orc_blend_big (tmpdestline, tmpsrcline, src_width);
+#endif
+    } else if (G_LIKELY (global_alpha == 1.0)) {
       if (src_premultiplied_alpha && dest_premultiplied_alpha) {
         BLENDLOOP (OVER11, 255);
       } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
@@ -445,14 +476,6 @@ gst_video_blend (GstVideoFrame * dest,
     /* undo previous pointer adjustments to pass right pointer to g_free */
     tmpdestline -= 4 * x;
 
-    /* FIXME
-     * #if G_BYTE_ORDER == LITTLE_ENDIAN
-     * video_orc_blend_little (tmpdestline, tmpsrcline, dest->width);
-     * #else
-     * video_orc_blend_big (tmpdestline, tmpsrcline, src->width);
-     * #endif
-     */
-
     dinfo->pack_func (dinfo, 0, tmpdestline, dest_width,
         dest->data, dest->info.stride, dest->info.chroma_site, i, dest_width);
   }
@@ -239,13 +239,10 @@ static void                                                             \
 video_chroma_up_vi2_##name (GstVideoChromaResample *resample,           \
     gpointer lines[], gint width)                                       \
 {                                                                       \
-  gint i;                                                               \
   type *l0 = lines[0];                                                  \
   type *l1 = lines[1];                                                  \
   type *l2 = lines[2];                                                  \
   type *l3 = lines[3];                                                  \
-  type tr0, tr1, tr2, tr3;                                              \
-  type tb0, tb1, tb2, tb3;                                              \
                                                                         \
   if (resample->h_resample) {                                           \
     if (l0 != l1) {                                                     \
@@ -258,21 +255,8 @@ video_chroma_up_vi2_##name (GstVideoChromaResample *resample,           \
     }                                                                   \
   }                                                                     \
   if (l0 != l1 && l2 != l3) {                                           \
-    for (i = 0; i < width; i++) {                                       \
-      tr0 = PR0(i), tr2 = PR2(i);                                       \
-      tb0 = PB0(i), tb2 = PB2(i);                                       \
-      tr1 = PR1(i), tr3 = PR3(i);                                       \
-      tb1 = PB1(i), tb3 = PB3(i);                                       \
-                                                                        \
-      PR0(i) = FILT_5_3 (tr0, tr2);                                     \
-      PB0(i) = FILT_5_3 (tb0, tb2);                                     \
-      PR1(i) = FILT_7_1 (tr1, tr3);                                     \
-      PB1(i) = FILT_7_1 (tb1, tb3);                                     \
-      PR2(i) = FILT_1_7 (tr0, tr2);                                     \
-      PB2(i) = FILT_1_7 (tb0, tb2);                                     \
-      PR3(i) = FILT_3_5 (tr1, tr3);                                     \
-      PB3(i) = FILT_3_5 (tb1, tb3);                                     \
-    }                                                                   \
+    video_orc_chroma_up_vi2_##name (l0, l1, l2, l3, l0, l1, l2, l3,     \
+        width);                                                         \
   }                                                                     \
 }
 
@@ -424,13 +408,10 @@ static void                                                             \
 video_chroma_up_v4_##name (GstVideoChromaResample *resample,            \
     gpointer lines[], gint width)                                       \
 {                                                                       \
-  gint i;                                                               \
   type *l0 = lines[0];                                                  \
   type *l1 = lines[1];                                                  \
   type *l2 = lines[2];                                                  \
   type *l3 = lines[3];                                                  \
-  type tr0, tr1;                                                        \
-  type tb0, tb1;                                                        \
                                                                         \
   if (resample->h_resample) {                                           \
     if (l0 != l1) {                                                     \
@@ -443,19 +424,8 @@ video_chroma_up_v4_##name (GstVideoChromaResample *resample,            \
     }                                                                   \
   }                                                                     \
   if (l0 != l1 && l2 != l3) {                                           \
-    for (i = 0; i < width; i++) {                                       \
-      tr0 = PR0(i), tr1 = PR2(i);                                       \
-      tb0 = PB0(i), tb1 = PB2(i);                                       \
-                                                                        \
-      PR0(i) = FILT_7_1 (tr0, tr1);                                     \
-      PB0(i) = FILT_7_1 (tb0, tb1);                                     \
-      PR1(i) = FILT_5_3 (tr0, tr1);                                     \
-      PB1(i) = FILT_5_3 (tb0, tb1);                                     \
-      PR2(i) = FILT_3_5 (tr0, tr1);                                     \
-      PB2(i) = FILT_3_5 (tb0, tb1);                                     \
-      PR3(i) = FILT_1_7 (tr0, tr1);                                     \
-      PB3(i) = FILT_1_7 (tb0, tb1);                                     \
-    }                                                                   \
+    video_orc_chroma_up_v4_##name (l0, l1, l2, l3, l0, l1, l2, l3,      \
+        width);                                                         \
   }                                                                     \
 }
 /* 4x vertical upsampling interlaced without cositing
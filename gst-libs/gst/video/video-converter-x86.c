@@ -0,0 +1,314 @@
+/* GStreamer
+ * Copyright (C) 2017 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "video-converter-x86.h"
+
+/* We rely on function-level target attributes so that the AVX2/AVX-512
+ * kernels can live in a normally compiled object file; the baseline ISA
+ * of the rest of the library is not affected. Old compilers simply get
+ * the scalar fallbacks. */
+#if defined (__x86_64__) && defined (__GNUC__) && __GNUC__ >= 6
+#define HAVE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+guint
+video_converter_get_x86_flags (void)
+{
+  static gsize once = 0;
+
+  if (g_once_init_enter (&once)) {
+    guint flags = VIDEO_CONVERTER_X86_NONE;
+
+#ifdef HAVE_X86_KERNELS
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx2"))
+      flags |= VIDEO_CONVERTER_X86_AVX2;
+    if (__builtin_cpu_supports ("avx512f")
+        && __builtin_cpu_supports ("avx512bw"))
+      flags |= VIDEO_CONVERTER_X86_AVX512;
+#endif
+    g_once_init_leave (&once, flags | 0x80000000);
+  }
+  return (guint) once & ~0x80000000;
+}
+
+#ifdef HAVE_X86_KERNELS
+
+__attribute__ ((target ("avx2")))
+static gint
+deinterleave_uv_avx2 (guint8 * du, guint8 * dv, const guint8 * s, gint width)
+{
+  gint i;
+  const __m256i shuf = _mm256_set_epi8 (15, 13, 11, 9, 7, 5, 3, 1,
+      14, 12, 10, 8, 6, 4, 2, 0,
+      15, 13, 11, 9, 7, 5, 3, 1,
+      14, 12, 10, 8, 6, 4, 2, 0);
+
+  for (i = 0; i + 16 <= width; i += 16) {
+    __m256i uv = _mm256_loadu_si256 ((const __m256i *) (s + 2 * i));
+
+    uv = _mm256_shuffle_epi8 (uv, shuf);
+    uv = _mm256_permute4x64_epi64 (uv, 0xd8);
+    _mm_storeu_si128 ((__m128i *) (du + i), _mm256_castsi256_si128 (uv));
+    _mm_storeu_si128 ((__m128i *) (dv + i),
+        _mm256_extracti128_si256 (uv, 1));
+  }
+  return i;
+}
+
+__attribute__ ((target ("avx512f,avx512bw")))
+static gint
+deinterleave_uv_avx512 (guint8 * du, guint8 * dv, const guint8 * s,
+    gint width)
+{
+  gint i;
+  const __m512i shuf = _mm512_broadcast_i32x4 (_mm_set_epi8 (15, 13, 11, 9,
+          7, 5, 3, 1, 14, 12, 10, 8, 6, 4, 2, 0));
+  const __m512i perm = _mm512_set_epi64 (7, 5, 3, 1, 6, 4, 2, 0);
+
+  for (i = 0; i + 32 <= width; i += 32) {
+    __m512i uv = _mm512_loadu_si512 ((const void *) (s + 2 * i));
+
+    uv = _mm512_shuffle_epi8 (uv, shuf);
+    uv = _mm512_permutexvar_epi64 (perm, uv);
+    _mm256_storeu_si256 ((__m256i *) (du + i),
+        _mm512_extracti64x4_epi64 (uv, 0));
+    _mm256_storeu_si256 ((__m256i *) (dv + i),
+        _mm512_extracti64x4_epi64 (uv, 1));
+  }
+  return i;
+}
+
+__attribute__ ((target ("avx2")))
+static gint
+interleave_uv_avx2 (guint8 * d, const guint8 * su, const guint8 * sv,
+    gint width)
+{
+  gint i;
+
+  for (i = 0; i + 32 <= width; i += 32) {
+    __m256i u = _mm256_loadu_si256 ((const __m256i *) (su + i));
+    __m256i v = _mm256_loadu_si256 ((const __m256i *) (sv + i));
+    __m256i lo = _mm256_unpacklo_epi8 (u, v);
+    __m256i hi = _mm256_unpackhi_epi8 (u, v);
+
+    _mm256_storeu_si256 ((__m256i *) (d + 2 * i),
+        _mm256_permute2x128_si256 (lo, hi, 0x20));
+    _mm256_storeu_si256 ((__m256i *) (d + 2 * i + 32),
+        _mm256_permute2x128_si256 (lo, hi, 0x31));
+  }
+  return i;
+}
+
+__attribute__ ((target ("avx512f,avx512bw")))
+static gint
+interleave_uv_avx512 (guint8 * d, const guint8 * su, const guint8 * sv,
+    gint width)
+{
+  gint i;
+  const __m512i perma = _mm512_set_epi64 (11, 10, 3, 2, 9, 8, 1, 0);
+  const __m512i permb = _mm512_set_epi64 (15, 14, 7, 6, 13, 12, 5, 4);
+
+  for (i = 0; i + 64 <= width; i += 64) {
+    __m512i u = _mm512_loadu_si512 ((const void *) (su + i));
+    __m512i v = _mm512_loadu_si512 ((const void *) (sv + i));
+    __m512i lo = _mm512_unpacklo_epi8 (u, v);
+    __m512i hi = _mm512_unpackhi_epi8 (u, v);
+
+    _mm512_storeu_si512 ((void *) (d + 2 * i),
+        _mm512_permutex2var_epi64 (lo, perma, hi));
+    _mm512_storeu_si512 ((void *) (d + 2 * i + 64),
+        _mm512_permutex2var_epi64 (lo, permb, hi));
+  }
+  return i;
+}
+#endif /* HAVE_X86_KERNELS */
+
+#ifdef HAVE_X86_KERNELS
+
+__attribute__ ((target ("avx2")))
+static gint
+gather_u8_avx2 (guint8 * d, const guint8 * s, const guint32 * offset, gint n)
+{
+  gint i;
+  const __m256i mask = _mm256_set1_epi32 (0xff);
+
+  /* the 32-bit gathers read past the addressed byte; leave a tail for
+   * the scalar loop so we never touch memory after the last element */
+  for (i = 0; i + 8 <= n - 8; i += 8) {
+    __m256i idx = _mm256_loadu_si256 ((const __m256i *) (offset + i));
+    __m256i v = _mm256_i32gather_epi32 ((const int *) s, idx, 1);
+
+    v = _mm256_and_si256 (v, mask);
+    v = _mm256_packus_epi32 (v, v);
+    v = _mm256_packus_epi16 (v, v);
+    v = _mm256_permutevar8x32_epi32 (v, _mm256_set_epi32 (7, 7, 7, 7, 7, 7,
+            4, 0));
+    _mm_storel_epi64 ((__m128i *) (d + i), _mm256_castsi256_si128 (v));
+  }
+  return i;
+}
+
+__attribute__ ((target ("avx2")))
+static gint
+gather_u16_avx2 (guint16 * d, const guint16 * s, const guint32 * offset,
+    gint n)
+{
+  gint i;
+  const __m256i mask = _mm256_set1_epi32 (0xffff);
+
+  for (i = 0; i + 8 <= n - 8; i += 8) {
+    __m256i idx = _mm256_loadu_si256 ((const __m256i *) (offset + i));
+    __m256i v = _mm256_i32gather_epi32 ((const int *) s, idx, 2);
+
+    v = _mm256_and_si256 (v, mask);
+    v = _mm256_packus_epi32 (v, v);
+    v = _mm256_permute4x64_epi64 (v, 0x08);
+    _mm_storeu_si128 ((__m128i *) (d + i), _mm256_castsi256_si128 (v));
+  }
+  return i;
+}
+
+__attribute__ ((target ("avx2")))
+static gint
+gather_u32_avx2 (guint32 * d, const guint32 * s, const guint32 * offset,
+    gint n)
+{
+  gint i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m256i idx = _mm256_loadu_si256 ((const __m256i *) (offset + i));
+
+    _mm256_storeu_si256 ((__m256i *) (d + i),
+        _mm256_i32gather_epi32 ((const int *) s, idx, 4));
+  }
+  return i;
+}
+#endif /* HAVE_X86_KERNELS */
+
+/**
+ * video_converter_gather_u8: (skip)
+ *
+ * Fill @d with the @n bytes of @s selected by @offset, as used by the
+ * horizontal resampler to prepare its tap input arrays.
+ */
+void
+video_converter_gather_u8 (guint8 * d, const guint8 * s,
+    const guint32 * offset, gint n)
+{
+  gint i = 0;
+
+#ifdef HAVE_X86_KERNELS
+  if (video_converter_get_x86_flags () & VIDEO_CONVERTER_X86_AVX2)
+    i = gather_u8_avx2 (d, s, offset, n);
+#endif
+  for (; i < n; i++)
+    d[i] = s[offset[i]];
+}
+
+/**
+ * video_converter_gather_u16: (skip)
+ */
+void
+video_converter_gather_u16 (guint16 * d, const guint16 * s,
+    const guint32 * offset, gint n)
+{
+  gint i = 0;
+
+#ifdef HAVE_X86_KERNELS
+  if (video_converter_get_x86_flags () & VIDEO_CONVERTER_X86_AVX2)
+    i = gather_u16_avx2 (d, s, offset, n);
+#endif
+  for (; i < n; i++)
+    d[i] = s[offset[i]];
+}
+
+/**
+ * video_converter_gather_u32: (skip)
+ */
+void
+video_converter_gather_u32 (guint32 * d, const guint32 * s,
+    const guint32 * offset, gint n)
+{
+  gint i = 0;
+
+#ifdef HAVE_X86_KERNELS
+  if (video_converter_get_x86_flags () & VIDEO_CONVERTER_X86_AVX2)
+    i = gather_u32_avx2 (d, s, offset, n);
+#endif
+  for (; i < n; i++)
+    d[i] = s[offset[i]];
+}
+
+/**
+ * video_converter_deinterleave_uv: (skip)
+ *
+ * Split @width interleaved UV pairs from @s into the planar lines
+ * @du and @dv.
+ */
+void
+video_converter_deinterleave_uv (guint8 * du, guint8 * dv, const guint8 * s,
+    gint width)
+{
+  gint i = 0;
+
+#ifdef HAVE_X86_KERNELS
+  guint flags = video_converter_get_x86_flags ();
+
+  if (flags & VIDEO_CONVERTER_X86_AVX512)
+    i = deinterleave_uv_avx512 (du, dv, s, width);
+  else if (flags & VIDEO_CONVERTER_X86_AVX2)
+    i = deinterleave_uv_avx2 (du, dv, s, width);
+#endif
+  for (; i < width; i++) {
+    du[i] = s[2 * i];
+    dv[i] = s[2 * i + 1];
+  }
+}
+
+/**
+ * video_converter_interleave_uv: (skip)
+ *
+ * Interleave @width U and V samples from the planar lines @su and @sv
+ * into UV pairs in @d.
+ */
+void
+video_converter_interleave_uv (guint8 * d, const guint8 * su,
+    const guint8 * sv, gint width)
+{
+  gint i = 0;
+
+#ifdef HAVE_X86_KERNELS
+  guint flags = video_converter_get_x86_flags ();
+
+  if (flags & VIDEO_CONVERTER_X86_AVX512)
+    i = interleave_uv_avx512 (d, su, sv, width);
+  else if (flags & VIDEO_CONVERTER_X86_AVX2)
+    i = interleave_uv_avx2 (d, su, sv, width);
+#endif
+  for (; i < width; i++) {
+    d[2 * i] = su[i];
+    d[2 * i + 1] = sv[i];
+  }
+}
@@ -0,0 +1,55 @@
+/* GStreamer
+ * Copyright (C) 2017 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_VIDEO_CONVERTER_X86_H__
+#define __GST_VIDEO_CONVERTER_X86_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/* Hand-written x86 SIMD kernels used by the video-converter fast paths.
+ * All entry points transparently fall back to scalar code when the CPU
+ * does not support the wider instruction sets or when the library was
+ * built with a compiler that can't emit them. */
+
+typedef enum
+{
+  VIDEO_CONVERTER_X86_NONE = 0,
+  VIDEO_CONVERTER_X86_AVX2 = (1 << 0),
+  VIDEO_CONVERTER_X86_AVX512 = (1 << 1),
+} VideoConverterX86Flags;
+
+G_GNUC_INTERNAL guint video_converter_get_x86_flags (void);
+
+G_GNUC_INTERNAL void video_converter_deinterleave_uv (guint8 * du,
+    guint8 * dv, const guint8 * s, gint width);
+G_GNUC_INTERNAL void video_converter_interleave_uv (guint8 * d,
+    const guint8 * su, const guint8 * sv, gint width);
+
+G_GNUC_INTERNAL void video_converter_gather_u8 (guint8 * d,
+    const guint8 * s, const guint32 * offset, gint n);
+G_GNUC_INTERNAL void video_converter_gather_u16 (guint16 * d,
+    const guint16 * s, const guint32 * offset, gint n);
+G_GNUC_INTERNAL void video_converter_gather_u32 (guint32 * d,
+    const guint32 * s, const guint32 * offset, gint n);
+
+G_END_DECLS
+
+#endif /* __GST_VIDEO_CONVERTER_X86_H__ */
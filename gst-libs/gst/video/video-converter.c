@@ -36,6 +36,7 @@
 #include <math.h>
 
 #include "video-orc.h"
+#include "video-converter-x86.h"
 
 /**
  * SECTION:videoconverter
@@ -118,105 +119,72 @@ ensure_debug_category (void)
 typedef void (*GstParallelizedTaskFunc) (gpointer user_data);
 
 typedef struct _GstParallelizedTaskRunner GstParallelizedTaskRunner;
-typedef struct _GstParallelizedTaskThread GstParallelizedTaskThread;
-
-struct _GstParallelizedTaskThread
-{
-  GstParallelizedTaskRunner *runner;
-  guint idx;
-  GThread *thread;
-};
 
+/* All runners share one process-wide thread pool sized to the number of
+ * processors. A runner only determines in how many tasks a job is split
+ * (its concurrency cap); the actual workers are shared, so many converter
+ * instances together never oversubscribe the machine. */
 struct _GstParallelizedTaskRunner
 {
-  guint n_threads;
+  GThreadPool *pool;
 
-  GstParallelizedTaskThread *threads;
+  guint n_threads;
 
   GstParallelizedTaskFunc func;
   gpointer *task_data;
 
   GMutex lock;
-  GCond cond_todo, cond_done;
+  GCond cond_done;
   gint n_todo, n_done;
-  gboolean quit;
 };
 
-static gpointer
-gst_parallelized_task_thread_func (gpointer data)
+static void
+gst_parallelized_task_runner_worker (gpointer data, gpointer user_data)
 {
-  GstParallelizedTaskThread *self = data;
-
-#if 0
-#ifdef HAVE_PTHREAD
-  {
-    pthread_t thread = pthread_self ();
-    cpu_set_t cpuset;
-    int r;
-
-    CPU_ZERO (&cpuset);
-    CPU_SET (self->idx, &cpuset);
-    if ((r = pthread_setaffinity_np (thread, sizeof (cpuset), &cpuset)) != 0)
-      GST_ERROR ("Failed to set thread affinity for thread %d: %s", self->idx,
-          g_strerror (r));
-  }
-#endif
-#endif
-
-  g_mutex_lock (&self->runner->lock);
-  self->runner->n_done++;
-  if (self->runner->n_done == self->runner->n_threads - 1)
-    g_cond_signal (&self->runner->cond_done);
-
-  do {
-    gint idx;
-
-    while (self->runner->n_todo == -1 && !self->runner->quit)
-      g_cond_wait (&self->runner->cond_todo, &self->runner->lock);
+  GstParallelizedTaskRunner *self = data;
+  gint idx;
 
-    if (self->runner->quit)
-      break;
+  g_mutex_lock (&self->lock);
+  idx = self->n_todo--;
+  g_assert (self->n_todo >= -1);
+  g_mutex_unlock (&self->lock);
 
-    idx = self->runner->n_todo--;
-    g_assert (self->runner->n_todo >= -1);
-    g_mutex_unlock (&self->runner->lock);
+  g_assert (self->func != NULL);
 
-    g_assert (self->runner->func != NULL);
+  self->func (self->task_data[idx]);
 
-    self->runner->func (self->runner->task_data[idx]);
+  g_mutex_lock (&self->lock);
+  self->n_done++;
+  if (self->n_done == self->n_threads - 1)
+    g_cond_signal (&self->cond_done);
+  g_mutex_unlock (&self->lock);
+}
 
-    g_mutex_lock (&self->runner->lock);
-    self->runner->n_done++;
-    if (self->runner->n_done == self->runner->n_threads - 1)
-      g_cond_signal (&self->runner->cond_done);
-  } while (TRUE);
+static GThreadPool *
+gst_parallelized_task_runner_get_pool (void)
+{
+  static GThreadPool *pool = NULL;
+  static gsize once = 0;
 
-  g_mutex_unlock (&self->runner->lock);
+  if (g_once_init_enter (&once)) {
+    GError *err = NULL;
 
-  return NULL;
+    pool = g_thread_pool_new (gst_parallelized_task_runner_worker, NULL,
+        g_get_num_processors (), FALSE, &err);
+    if (!pool) {
+      GST_ERROR ("Failed to create thread pool: %s", err->message);
+      g_clear_error (&err);
+    }
+    g_once_init_leave (&once, 1);
+  }
+  return pool;
 }
 
 static void
 gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self)
 {
-  guint i;
-
-  g_mutex_lock (&self->lock);
-  self->quit = TRUE;
-  g_cond_broadcast (&self->cond_todo);
-  g_mutex_unlock (&self->lock);
-
-  for (i = 1; i < self->n_threads; i++) {
-    if (!self->threads[i].thread)
-      continue;
-
-    g_thread_join (self->threads[i].thread);
-  }
-
   g_mutex_clear (&self->lock);
-  g_cond_clear (&self->cond_todo);
   g_cond_clear (&self->cond_done);
-  g_free (self->threads);
   g_free (self);
 }
 
@@ -224,57 +192,29 @@ static GstParallelizedTaskRunner *
 gst_parallelized_task_runner_new (guint n_threads)
 {
   GstParallelizedTaskRunner *self;
-  guint i;
-  GError *err = NULL;
 
   if (n_threads == 0)
     n_threads = g_get_num_processors ();
 
   self = g_new0 (GstParallelizedTaskRunner, 1);
   self->n_threads = n_threads;
-  self->threads = g_new0 (GstParallelizedTaskThread, n_threads);
 
-  self->quit = FALSE;
+  if (n_threads > 1) {
+    self->pool = gst_parallelized_task_runner_get_pool ();
+    if (!self->pool)
+      self->n_threads = n_threads = 1;
+  }
+
   self->n_todo = -1;
   self->n_done = 0;
   g_mutex_init (&self->lock);
-  g_cond_init (&self->cond_todo);
   g_cond_init (&self->cond_done);
 
   /* Set when scheduling a job */
   self->func = NULL;
   self->task_data = NULL;
 
-  for (i = 0; i < n_threads; i++) {
-    self->threads[i].runner = self;
-    self->threads[i].idx = i;
-
-    /* First thread is the one calling run() */
-    if (i > 0) {
-      self->threads[i].thread =
-          g_thread_try_new ("videoconvert", gst_parallelized_task_thread_func,
-          &self->threads[i], &err);
-      if (!self->threads[i].thread)
-        goto error;
-    }
-  }
-
-  g_mutex_lock (&self->lock);
-  while (self->n_done < self->n_threads - 1)
-    g_cond_wait (&self->cond_done, &self->lock);
-  self->n_done = 0;
-  g_mutex_unlock (&self->lock);
-
   return self;
-
-error:
-  {
-    GST_ERROR ("Failed to start thread %u: %s", i, err->message);
-    g_clear_error (&err);
-
-    gst_parallelized_task_runner_free (self);
-    return NULL;
-  }
 }
 
 static void
@@ -287,14 +227,19 @@ gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
   self->task_data = task_data;
 
   if (n_threads > 1) {
+    guint i;
+
     g_mutex_lock (&self->lock);
-    self->n_todo = self->n_threads - 2;
+    self->n_todo = n_threads - 2;
     self->n_done = 0;
-    g_cond_broadcast (&self->cond_todo);
     g_mutex_unlock (&self->lock);
+
+    for (i = 0; i < n_threads - 1; i++)
+      g_thread_pool_push (self->pool, self, NULL);
   }
 
-  self->func (self->task_data[self->n_threads - 1]);
+  /* The caller thread is one of the workers and takes the last task */
+  self->func (self->task_data[n_threads - 1]);
 
   if (n_threads > 1) {
     g_mutex_lock (&self->lock);
@@ -361,6 +306,49 @@ typedef struct
 typedef void (*FastConvertFunc) (GstVideoConverter * convert,
     const GstVideoFrame * src, GstVideoFrame * dest, gint plane);
 
+/* the stages of the generic conversion chain, used for optional per-stage
+ * time accounting (GST_VIDEO_CONVERTER_OPT_PROFILE_STAGES) */
+typedef enum
+{
+  STAGE_UNPACK = 0,
+  STAGE_UPSAMPLE,
+  STAGE_TO_RGB,
+  STAGE_HSCALE,
+  STAGE_VSCALE,
+  STAGE_CONVERT,
+  STAGE_ALPHA,
+  STAGE_TO_YUV,
+  STAGE_DOWNSAMPLE,
+  STAGE_DITHER,
+  STAGE_PACK,
+  N_STAGES
+} ConverterStage;
+
+/* the config fields the accumulated times are exposed in */
+static const gchar *stage_stat_fields[N_STAGES] = {
+  "GstVideoConverter.stat-unpack-time",
+  "GstVideoConverter.stat-upsample-time",
+  "GstVideoConverter.stat-to-rgb-time",
+  "GstVideoConverter.stat-hscale-time",
+  "GstVideoConverter.stat-vscale-time",
+  "GstVideoConverter.stat-convert-time",
+  "GstVideoConverter.stat-alpha-time",
+  "GstVideoConverter.stat-to-yuv-time",
+  "GstVideoConverter.stat-downsample-time",
+  "GstVideoConverter.stat-dither-time",
+  "GstVideoConverter.stat-pack-time",
+};
+
+#define STAGE_TIMER_START(convert,start) G_STMT_START {  \
+  if ((convert)->stage_times)                            \
+    (start) = gst_util_get_timestamp ();                 \
+} G_STMT_END
+#define STAGE_TIMER_STOP(convert,idx,stage,start) G_STMT_START {  \
+  if ((convert)->stage_times)                                     \
+    (convert)->stage_times[(idx) * N_STAGES + (stage)] +=         \
+        gst_util_get_timestamp () - (start);                      \
+} G_STMT_END
+
 struct _GstVideoConverter
 {
   gint flags;
@@ -388,9 +376,27 @@ struct _GstVideoConverter
   gint current_bits;
 
   GstStructure *config;
+  gboolean cache_plans;
+
+  /* tiled execution */
+  GstVideoConverter **tiles;
+  guint n_tiles;
+
+  /* async execution */
+  GMutex async_lock;
+  GCond async_done;
+  GQueue async_jobs;
+  gboolean async_running;
+
+  /* region conversion */
+  GQueue region_cache;
 
   GstParallelizedTaskRunner *conversion_runner;
 
+  /* per-stage time accounting, N_STAGES slots for each thread, NULL when
+   * not profiling */
+  guint64 *stage_times;
+
   guint16 **tmpline;
 
   gboolean fill_border;
@@ -648,6 +654,9 @@ gst_line_cache_alloc_line (GstLineCache * cache, gint idx)
 static void video_converter_generic (GstVideoConverter * convert,
     const GstVideoFrame * src, GstVideoFrame * dest);
 static gboolean video_converter_lookup_fastpath (GstVideoConverter * convert);
+
+typedef struct _RegionConverter RegionConverter;
+static void region_converter_free (RegionConverter * region);
 static void video_converter_compute_matrix (GstVideoConverter * convert);
 static void video_converter_compute_resample (GstVideoConverter * convert,
     gint idx);
@@ -807,6 +816,9 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
 #define DEFAULT_OPT_RESAMPLER_TAPS 0
 #define DEFAULT_OPT_DITHER_METHOD GST_VIDEO_DITHER_BAYER
 #define DEFAULT_OPT_DITHER_QUANTIZATION 1
+#define DEFAULT_OPT_CACHE_PLANS FALSE
+#define DEFAULT_OPT_TILE_WIDTH 0
+#define DEFAULT_OPT_PROFILE_STAGES FALSE
 
 #define GET_OPT_FILL_BORDER(c) get_opt_bool(c, \
     GST_VIDEO_CONVERTER_OPT_FILL_BORDER, DEFAULT_OPT_FILL_BORDER)
@@ -837,6 +849,12 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
     DEFAULT_OPT_DITHER_METHOD)
 #define GET_OPT_DITHER_QUANTIZATION(c) get_opt_uint(c, \
     GST_VIDEO_CONVERTER_OPT_DITHER_QUANTIZATION, DEFAULT_OPT_DITHER_QUANTIZATION)
+#define GET_OPT_CACHE_PLANS(c) get_opt_bool(c, \
+    GST_VIDEO_CONVERTER_OPT_CACHE_PLANS, DEFAULT_OPT_CACHE_PLANS)
+#define GET_OPT_TILE_WIDTH(c) get_opt_uint(c, \
+    GST_VIDEO_CONVERTER_OPT_TILE_WIDTH, DEFAULT_OPT_TILE_WIDTH)
+#define GET_OPT_PROFILE_STAGES(c) get_opt_bool(c, \
+    GST_VIDEO_CONVERTER_OPT_PROFILE_STAGES, DEFAULT_OPT_PROFILE_STAGES)
 
 #define CHECK_ALPHA_COPY(c) (GET_OPT_ALPHA_MODE(c) == GST_VIDEO_ALPHA_MODE_COPY)
 #define CHECK_ALPHA_SET(c) (GET_OPT_ALPHA_MODE(c) == GST_VIDEO_ALPHA_MODE_SET)
@@ -1504,12 +1522,113 @@ gamma_convert_u16_u16 (GammaData * data, gpointer dest, gpointer src)
   }
 }
 
+/* Refcounted process-wide cache of gamma tables, keyed by transfer
+ * function, direction and bit depth. The 16-bit tables are 64-128 KiB
+ * each and identical for every converter using the same transfer
+ * function, so instances share them. */
+typedef struct
+{
+  GstVideoTransferFunction func;
+  gboolean decode;
+  gint bits;
+  gint refcount;
+  gpointer table;
+} GammaTableEntry;
+
+static GSList *gamma_table_cache = NULL;
+static GMutex gamma_table_cache_lock;
+
+static gpointer
+gamma_table_acquire (GstVideoTransferFunction func, gboolean decode,
+    gint bits)
+{
+  GammaTableEntry *entry;
+  GSList *walk;
+  gint i;
+
+  g_mutex_lock (&gamma_table_cache_lock);
+  for (walk = gamma_table_cache; walk; walk = walk->next) {
+    entry = walk->data;
+    if (entry->func == func && entry->decode == decode && entry->bits == bits) {
+      entry->refcount++;
+      g_mutex_unlock (&gamma_table_cache_lock);
+      return entry->table;
+    }
+  }
+
+  entry = g_new0 (GammaTableEntry, 1);
+  entry->func = func;
+  entry->decode = decode;
+  entry->bits = bits;
+  entry->refcount = 1;
+
+  if (decode) {
+    guint16 *t;
+
+    if (bits == 8) {
+      t = entry->table = g_malloc (sizeof (guint16) * 256);
+      for (i = 0; i < 256; i++)
+        t[i] =
+            rint (gst_video_color_transfer_decode (func, i / 255.0) * 65535.0);
+    } else {
+      t = entry->table = g_malloc (sizeof (guint16) * 65536);
+      for (i = 0; i < 65536; i++)
+        t[i] =
+            rint (gst_video_color_transfer_decode (func,
+                i / 65535.0) * 65535.0);
+    }
+  } else {
+    if (bits == 8) {
+      guint8 *t;
+
+      t = entry->table = g_malloc (sizeof (guint8) * 65536);
+      for (i = 0; i < 65536; i++)
+        t[i] =
+            rint (gst_video_color_transfer_encode (func, i / 65535.0) * 255.0);
+    } else {
+      guint16 *t;
+
+      t = entry->table = g_malloc (sizeof (guint16) * 65536);
+      for (i = 0; i < 65536; i++)
+        t[i] =
+            rint (gst_video_color_transfer_encode (func,
+                i / 65535.0) * 65535.0);
+    }
+  }
+  gamma_table_cache = g_slist_prepend (gamma_table_cache, entry);
+  g_mutex_unlock (&gamma_table_cache_lock);
+
+  return entry->table;
+}
+
+static void
+gamma_table_release (gpointer table)
+{
+  GSList *walk;
+
+  if (table == NULL)
+    return;
+
+  g_mutex_lock (&gamma_table_cache_lock);
+  for (walk = gamma_table_cache; walk; walk = walk->next) {
+    GammaTableEntry *entry = walk->data;
+
+    if (entry->table == table) {
+      if (--entry->refcount == 0) {
+        gamma_table_cache = g_slist_delete_link (gamma_table_cache, walk);
+        g_free (entry->table);
+        g_free (entry);
+      }
+      break;
+    }
+  }
+  g_mutex_unlock (&gamma_table_cache_lock);
+}
+
 static void
 setup_gamma_decode (GstVideoConverter * convert)
 {
   GstVideoTransferFunction func;
-  guint16 *t;
-  gint i;
 
   func = convert->in_info.colorimetry.transfer;
 
@@ -1517,18 +1636,11 @@ setup_gamma_decode (GstVideoConverter * convert)
   if (convert->current_bits == 8) {
     GST_DEBUG ("gamma decode 8->16: %d", func);
     convert->gamma_dec.gamma_func = gamma_convert_u8_u16;
-    t = convert->gamma_dec.gamma_table = g_malloc (sizeof (guint16) * 256);
-
-    for (i = 0; i < 256; i++)
-      t[i] = rint (gst_video_color_transfer_decode (func, i / 255.0) * 65535.0);
+    convert->gamma_dec.gamma_table = gamma_table_acquire (func, TRUE, 8);
   } else {
     GST_DEBUG ("gamma decode 16->16: %d", func);
     convert->gamma_dec.gamma_func = gamma_convert_u16_u16;
-    t = convert->gamma_dec.gamma_table = g_malloc (sizeof (guint16) * 65536);
-
-    for (i = 0; i < 65536; i++)
-      t[i] =
-          rint (gst_video_color_transfer_decode (func, i / 65535.0) * 65535.0);
+    convert->gamma_dec.gamma_table = gamma_table_acquire (func, TRUE, 16);
   }
   convert->current_bits = 16;
   convert->current_pstride = 8;
@@ -1539,30 +1651,18 @@ static void
 setup_gamma_encode (GstVideoConverter * convert, gint target_bits)
 {
   GstVideoTransferFunction func;
-  gint i;
 
   func = convert->out_info.colorimetry.transfer;
 
   convert->gamma_enc.width = convert->current_width;
   if (target_bits == 8) {
-    guint8 *t;
-
     GST_DEBUG ("gamma encode 16->8: %d", func);
     convert->gamma_enc.gamma_func = gamma_convert_u16_u8;
-    t = convert->gamma_enc.gamma_table = g_malloc (sizeof (guint8) * 65536);
-
-    for (i = 0; i < 65536; i++)
-      t[i] = rint (gst_video_color_transfer_encode (func, i / 65535.0) * 255.0);
+    convert->gamma_enc.gamma_table = gamma_table_acquire (func, FALSE, 8);
   } else {
-    guint16 *t;
-
     GST_DEBUG ("gamma encode 16->16: %d", func);
     convert->gamma_enc.gamma_func = gamma_convert_u16_u16;
-    t = convert->gamma_enc.gamma_table = g_malloc (sizeof (guint16) * 65536);
-
-    for (i = 0; i < 65536; i++)
-      t[i] =
-          rint (gst_video_color_transfer_encode (func, i / 65535.0) * 65535.0);
+    convert->gamma_enc.gamma_table = gamma_table_acquire (func, FALSE, 16);
   }
 }
 
@@ -2237,6 +2337,181 @@ convert_get_alpha_mode (GstVideoConverter * convert)
   return ALPHA_MODE_SET;
 }
 
+/* Process-level cache of fully constructed converters, enabled with
+ * GST_VIDEO_CONVERTER_OPT_CACHE_PLANS. Freed converters are parked here
+ * and handed out again when a converter for the same input/output info
+ * and configuration is requested, which skips the whole chain setup. */
+#define CONVERTER_CACHE_MAX_SIZE 8
+
+static GQueue converter_cache = G_QUEUE_INIT;
+static GMutex converter_cache_lock;
+
+static GstVideoConverter *
+video_converter_cache_take (GstVideoInfo * in_info, GstVideoInfo * out_info,
+    GstStructure * config)
+{
+  GstVideoConverter *convert = NULL;
+  GList *l;
+
+  g_mutex_lock (&converter_cache_lock);
+  for (l = converter_cache.head; l; l = l->next) {
+    GstVideoConverter *c = l->data;
+
+    if (gst_video_info_is_equal (&c->in_info, in_info) &&
+        gst_video_info_is_equal (&c->out_info, out_info) &&
+        gst_structure_is_equal (c->config, config)) {
+      g_queue_delete_link (&converter_cache, l);
+      convert = c;
+      break;
+    }
+  }
+  g_mutex_unlock (&converter_cache_lock);
+
+  if (convert)
+    GST_DEBUG ("reusing cached converter %p", convert);
+
+  return convert;
+}
+
+static void
+video_converter_cache_release (GstVideoConverter * convert)
+{
+  GstVideoConverter *evict = NULL;
+
+  g_mutex_lock (&converter_cache_lock);
+  g_queue_push_head (&converter_cache, convert);
+  if (converter_cache.length > CONVERTER_CACHE_MAX_SIZE)
+    evict = g_queue_pop_tail (&converter_cache);
+  g_mutex_unlock (&converter_cache_lock);
+
+  if (evict) {
+    evict->cache_plans = FALSE;
+    gst_video_converter_free (evict);
+  }
+}
+
+/* Tiled execution mode: the frame is split into vertical columns that are
+ * converted by independent sub-converters working on crop rectangles. All
+ * temporary lines of a column then fit in the cache, which matters on 4K
+ * and 8K frames where full-width lines evict each other between stages. */
+typedef struct
+{
+  GstVideoConverter *convert;
+  const GstVideoFrame *src;
+  GstVideoFrame *dest;
+  guint first, n_tiles;
+} FConvertTileTask;
+
+static void
+convert_tiled_task (FConvertTileTask * task)
+{
+  guint i;
+
+  for (i = 0; i < task->n_tiles; i++)
+    gst_video_converter_frame (task->convert->tiles[task->first + i],
+        task->src, task->dest);
+}
+
+static void
+convert_tiled (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  FConvertTileTask *tasks;
+  FConvertTileTask **tasks_p;
+  gint n_threads;
+  guint tiles_per_thread;
+  gint i;
+
+  n_threads = convert->conversion_runner->n_threads;
+  tasks = g_newa (FConvertTileTask, n_threads);
+  tasks_p = g_newa (FConvertTileTask *, n_threads);
+
+  tiles_per_thread = (convert->n_tiles + n_threads - 1) / n_threads;
+
+  for (i = 0; i < n_threads; i++) {
+    tasks[i].convert = convert;
+    tasks[i].src = src;
+    tasks[i].dest = dest;
+    tasks[i].first = i * tiles_per_thread;
+    tasks[i].n_tiles = (i + 1) * tiles_per_thread;
+    tasks[i].n_tiles = MIN (tasks[i].n_tiles, convert->n_tiles);
+    tasks[i].n_tiles -= MIN (tasks[i].n_tiles, tasks[i].first);
+
+    tasks_p[i] = &tasks[i];
+  }
+
+  gst_parallelized_task_runner_run (convert->conversion_runner,
+      (GstParallelizedTaskFunc) convert_tiled_task, (gpointer) tasks_p);
+}
+
+static gboolean
+video_converter_setup_tiles (GstVideoConverter * convert)
+{
+  guint tile_width = GET_OPT_TILE_WIDTH (convert);
+  guint n_tiles, i;
+  gint width = convert->in_width;
+
+  if (tile_width == 0)
+    return FALSE;
+
+  /* keep tile boundaries aligned to the chroma subsampling of both
+   * formats; 8 covers all subsampling factors we support */
+  tile_width = GST_ROUND_UP_8 (tile_width);
+
+  /* tiles only work without scaling, cropping or borders; the crop
+   * rectangles of the sub-converters do the splitting */
+  if (convert->in_width != convert->out_width
+      || convert->in_height != convert->out_height
+      || convert->in_x != 0 || convert->in_y != 0
+      || convert->out_x != 0 || convert->out_y != 0
+      || convert->in_width != convert->in_maxwidth
+      || convert->out_width != convert->out_maxwidth
+      || (gint) tile_width >= width)
+    return FALSE;
+
+  n_tiles = (width + tile_width - 1) / tile_width;
+
+  convert->tiles = g_new0 (GstVideoConverter *, n_tiles);
+  convert->n_tiles = n_tiles;
+
+  for (i = 0; i < n_tiles; i++) {
+    GstStructure *config = gst_structure_copy (convert->config);
+    guint x = i * tile_width;
+    guint w = MIN (tile_width, width - x);
+
+    gst_structure_set (config,
+        GST_VIDEO_CONVERTER_OPT_TILE_WIDTH, G_TYPE_UINT, 0,
+        GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, 1,
+        GST_VIDEO_CONVERTER_OPT_CACHE_PLANS, G_TYPE_BOOLEAN, FALSE,
+        GST_VIDEO_CONVERTER_OPT_FILL_BORDER, G_TYPE_BOOLEAN, FALSE,
+        GST_VIDEO_CONVERTER_OPT_SRC_X, G_TYPE_INT, (gint) x,
+        GST_VIDEO_CONVERTER_OPT_SRC_WIDTH, G_TYPE_INT, (gint) w,
+        GST_VIDEO_CONVERTER_OPT_DEST_X, G_TYPE_INT, (gint) x,
+        GST_VIDEO_CONVERTER_OPT_DEST_WIDTH, G_TYPE_INT, (gint) w, NULL);
+
+    convert->tiles[i] =
+        gst_video_converter_new (&convert->in_info, &convert->out_info,
+        config);
+    if (!convert->tiles[i])
+      goto failed;
+  }
+
+  convert->convert = convert_tiled;
+  GST_DEBUG ("using %u tiles of width %u", n_tiles, tile_width);
+  return TRUE;
+
+failed:
+  {
+    for (i = 0; i < n_tiles; i++)
+      if (convert->tiles[i])
+        gst_video_converter_free (convert->tiles[i]);
+    g_free (convert->tiles);
+    convert->tiles = NULL;
+    convert->n_tiles = 0;
+    return FALSE;
+  }
+}
+
 /**
  * gst_video_converter_new: (skip)
  * @in_info: a #GstVideoInfo
@@ -2269,8 +2544,19 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
   g_return_val_if_fail (in_info->interlace_mode == out_info->interlace_mode,
       NULL);
 
+  if (config
+      && (convert = video_converter_cache_take (in_info, out_info, config))) {
+    gst_structure_free (config);
+    return convert;
+  }
+
   convert = g_slice_new0 (GstVideoConverter);
 
+  g_mutex_init (&convert->async_lock);
+  g_cond_init (&convert->async_done);
+  g_queue_init (&convert->async_jobs);
+  g_queue_init (&convert->region_cache);
+
   fin = in_info->finfo;
   fout = out_info->finfo;
 
@@ -2363,6 +2649,12 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
     n_threads = (MAX (convert->out_height, convert->in_height) + 199) / 200;
   convert->conversion_runner = gst_parallelized_task_runner_new (n_threads);
 
+  if (GET_OPT_PROFILE_STAGES (convert))
+    convert->stage_times = g_new0 (guint64, n_threads * N_STAGES);
+
+  if (video_converter_setup_tiles (convert))
+    goto done;
+
   if (video_converter_lookup_fastpath (convert))
     goto done;
 
@@ -2428,6 +2720,7 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
   setup_allocators (convert);
 
 done:
+  convert->cache_plans = GET_OPT_CACHE_PLANS (convert);
   return convert;
 
   /* ERRORS */
@@ -2470,6 +2763,14 @@ gst_video_converter_free (GstVideoConverter * convert)
 
   g_return_if_fail (convert != NULL);
 
+  /* wait for pending async conversions */
+  gst_video_converter_frame_finish (convert);
+
+  if (convert->cache_plans) {
+    video_converter_cache_release (convert);
+    return;
+  }
+
   for (i = 0; i < convert->conversion_runner->n_threads; i++) {
     if (convert->upsample_p && convert->upsample_p[i])
       gst_video_chroma_resample_free (convert->upsample_p[i]);
@@ -2528,8 +2829,8 @@ gst_video_converter_free (GstVideoConverter * convert)
   g_free (convert->dither_lines);
   g_free (convert->dither);
 
-  g_free (convert->gamma_dec.gamma_table);
-  g_free (convert->gamma_enc.gamma_table);
+  gamma_table_release (convert->gamma_dec.gamma_table);
+  gamma_table_release (convert->gamma_enc.gamma_table);
 
   if (convert->tmpline) {
     for (i = 0; i < convert->conversion_runner->n_threads; i++)
@@ -2538,6 +2839,7 @@ gst_video_converter_free (GstVideoConverter * convert)
   }
 
   g_free (convert->borderline);
+  g_free (convert->stage_times);
 
   if (convert->config)
     gst_structure_free (convert->config);
@@ -2560,6 +2862,16 @@ gst_video_converter_free (GstVideoConverter * convert)
   clear_matrix_data (&convert->convert_matrix);
   clear_matrix_data (&convert->to_YUV_matrix);
 
+  for (i = 0; i < convert->n_tiles; i++)
+    gst_video_converter_free (convert->tiles[i]);
+  g_free (convert->tiles);
+
+  while (!g_queue_is_empty (&convert->region_cache))
+    region_converter_free (g_queue_pop_head (&convert->region_cache));
+
+  g_mutex_clear (&convert->async_lock);
+  g_cond_clear (&convert->async_done);
+
   g_slice_free (GstVideoConverter, convert);
 }
 
@@ -2618,6 +2930,21 @@ gst_video_converter_get_config (GstVideoConverter * convert)
 {
   g_return_val_if_fail (convert != NULL, NULL);
 
+  if (convert->stage_times) {
+    gint i, t, n_threads = convert->conversion_runner->n_threads;
+
+    /* fold the per-thread counters into the config so the caller can
+     * attribute the conversion time to the individual stages */
+    for (i = 0; i < N_STAGES; i++) {
+      guint64 total = 0;
+
+      for (t = 0; t < n_threads; t++)
+        total += convert->stage_times[t * N_STAGES + i];
+      gst_structure_set (convert->config, stage_stat_fields[i],
+          G_TYPE_UINT64, total, NULL);
+    }
+  }
+
   return convert->config;
 }
 
@@ -2642,6 +2969,279 @@ gst_video_converter_frame (GstVideoConverter * convert,
   convert->convert (convert, src, dest);
 }
 
+/* Async execution. Jobs of one converter are serialized on a queue that
+ * is drained by a single outstanding work item, so the converter state
+ * is never used concurrently. The async pool is separate from the
+ * conversion worker pool: async jobs block on their worker tasks and
+ * must not occupy the threads that execute those tasks. */
+typedef struct
+{
+  const GstVideoFrame *src;
+  GstVideoFrame *dest;
+  GstVideoConverterAsyncFunc callback;
+  gpointer user_data;
+} AsyncConvertJob;
+
+static void video_converter_async_drain (gpointer data, gpointer user_data);
+
+static GThreadPool *
+video_converter_get_async_pool (void)
+{
+  static GThreadPool *pool = NULL;
+  static gsize once = 0;
+
+  if (g_once_init_enter (&once)) {
+    GError *err = NULL;
+
+    pool = g_thread_pool_new (video_converter_async_drain, NULL,
+        g_get_num_processors (), FALSE, &err);
+    if (!pool) {
+      GST_ERROR ("Failed to create async thread pool: %s", err->message);
+      g_clear_error (&err);
+    }
+    g_once_init_leave (&once, 1);
+  }
+  return pool;
+}
+
+static void
+video_converter_async_drain (gpointer data, gpointer user_data)
+{
+  GstVideoConverter *convert = data;
+  AsyncConvertJob *job;
+
+  g_mutex_lock (&convert->async_lock);
+  while ((job = g_queue_pop_head (&convert->async_jobs))) {
+    g_mutex_unlock (&convert->async_lock);
+
+    convert->convert (convert, job->src, job->dest);
+    if (job->callback)
+      job->callback (convert, job->dest, job->user_data);
+    g_slice_free (AsyncConvertJob, job);
+
+    g_mutex_lock (&convert->async_lock);
+  }
+  convert->async_running = FALSE;
+  g_cond_broadcast (&convert->async_done);
+  g_mutex_unlock (&convert->async_lock);
+}
+
+/**
+ * gst_video_converter_frame_async:
+ * @convert: a #GstVideoConverter
+ * @src: a #GstVideoFrame
+ * @dest: a #GstVideoFrame
+ * @func: (scope async): a #GstVideoConverterAsyncFunc
+ * @user_data: user data passed to @func
+ *
+ * Like gst_video_converter_frame() but enqueues the conversion on a
+ * worker thread and returns immediately. @func is invoked from the
+ * worker thread when the conversion of @src to @dest is done. @src and
+ * @dest must stay valid until then. Conversions of one converter are
+ * executed in the order they were queued.
+ *
+ * Use gst_video_converter_frame_finish() to wait for all pending
+ * conversions.
+ *
+ * Since: 1.14
+ */
+void
+gst_video_converter_frame_async (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest,
+    GstVideoConverterAsyncFunc func, gpointer user_data)
+{
+  AsyncConvertJob *job;
+  GThreadPool *pool;
+  gboolean start;
+
+  g_return_if_fail (convert != NULL);
+  g_return_if_fail (src != NULL);
+  g_return_if_fail (dest != NULL);
+
+  pool = video_converter_get_async_pool ();
+  if (G_UNLIKELY (pool == NULL)) {
+    /* no pool, convert synchronously */
+    convert->convert (convert, src, dest);
+    if (func)
+      func (convert, dest, user_data);
+    return;
+  }
+
+  job = g_slice_new0 (AsyncConvertJob);
+  job->src = src;
+  job->dest = dest;
+  job->callback = func;
+  job->user_data = user_data;
+
+  g_mutex_lock (&convert->async_lock);
+  g_queue_push_tail (&convert->async_jobs, job);
+  start = !convert->async_running;
+  convert->async_running = TRUE;
+  g_mutex_unlock (&convert->async_lock);
+
+  if (start)
+    g_thread_pool_push (pool, convert, NULL);
+}
+
+/* Region conversion. A converted rectangle is handled by a sub-converter
+ * with matching crop options; recently used rectangles are kept on a
+ * small per-converter LRU so repeated dirty regions (cursor areas,
+ * tickers, ...) don't pay the sub-converter construction again. */
+#define REGION_CACHE_MAX_SIZE 4
+
+struct _RegionConverter
+{
+  gint x, y, width, height;
+  GstVideoConverter *convert;
+};
+
+static void
+region_converter_free (RegionConverter * region)
+{
+  gst_video_converter_free (region->convert);
+  g_slice_free (RegionConverter, region);
+}
+
+static GstVideoConverter *
+video_converter_get_region_converter (GstVideoConverter * convert,
+    gint x, gint y, gint width, gint height)
+{
+  RegionConverter *region;
+  GstStructure *config;
+  GList *l;
+
+  for (l = convert->region_cache.head; l; l = l->next) {
+    region = l->data;
+    if (region->x == x && region->y == y && region->width == width
+        && region->height == height) {
+      /* move to front */
+      g_queue_unlink (&convert->region_cache, l);
+      g_queue_push_head_link (&convert->region_cache, l);
+      return region->convert;
+    }
+  }
+
+  config = gst_structure_copy (convert->config);
+  gst_structure_set (config,
+      GST_VIDEO_CONVERTER_OPT_TILE_WIDTH, G_TYPE_UINT, 0,
+      GST_VIDEO_CONVERTER_OPT_CACHE_PLANS, G_TYPE_BOOLEAN, FALSE,
+      GST_VIDEO_CONVERTER_OPT_FILL_BORDER, G_TYPE_BOOLEAN, FALSE,
+      GST_VIDEO_CONVERTER_OPT_SRC_X, G_TYPE_INT, x,
+      GST_VIDEO_CONVERTER_OPT_SRC_Y, G_TYPE_INT, y,
+      GST_VIDEO_CONVERTER_OPT_SRC_WIDTH, G_TYPE_INT, width,
+      GST_VIDEO_CONVERTER_OPT_SRC_HEIGHT, G_TYPE_INT, height,
+      GST_VIDEO_CONVERTER_OPT_DEST_X, G_TYPE_INT, x,
+      GST_VIDEO_CONVERTER_OPT_DEST_Y, G_TYPE_INT, y,
+      GST_VIDEO_CONVERTER_OPT_DEST_WIDTH, G_TYPE_INT, width,
+      GST_VIDEO_CONVERTER_OPT_DEST_HEIGHT, G_TYPE_INT, height, NULL);
+
+  region = g_slice_new0 (RegionConverter);
+  region->x = x;
+  region->y = y;
+  region->width = width;
+  region->height = height;
+  region->convert =
+      gst_video_converter_new (&convert->in_info, &convert->out_info, config);
+
+  if (region->convert == NULL) {
+    g_slice_free (RegionConverter, region);
+    return NULL;
+  }
+
+  g_queue_push_head (&convert->region_cache, region);
+  if (convert->region_cache.length > REGION_CACHE_MAX_SIZE)
+    region_converter_free (g_queue_pop_tail (&convert->region_cache));
+
+  return region->convert;
+}
+
+/**
+ * gst_video_converter_frame_region:
+ * @convert: a #GstVideoConverter
+ * @src: a #GstVideoFrame
+ * @dest: a #GstVideoFrame
+ * @x: the left edge of the region
+ * @y: the top edge of the region
+ * @width: the width of the region
+ * @height: the height of the region
+ *
+ * Convert only the given rectangle of @src into the same rectangle of
+ * @dest, leaving the remaining destination pixels untouched. This is
+ * cheaper than gst_video_converter_frame() when only a small part of
+ * the image changed. The rectangle is expanded as needed to stay
+ * aligned with the chroma subsampling of both formats.
+ *
+ * Only converters that don't scale, crop or fill borders can convert
+ * regions; %FALSE is returned otherwise and the caller should convert
+ * the full frame instead.
+ *
+ * Returns: %TRUE if the region was converted
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_video_converter_frame_region (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest,
+    gint x, gint y, gint width, gint height)
+{
+  GstVideoConverter *region;
+  gint x2, y2;
+
+  g_return_val_if_fail (convert != NULL, FALSE);
+  g_return_val_if_fail (src != NULL, FALSE);
+  g_return_val_if_fail (dest != NULL, FALSE);
+  g_return_val_if_fail (width > 0 && height > 0, FALSE);
+
+  if (convert->in_width != convert->out_width
+      || convert->in_height != convert->out_height
+      || convert->in_x != 0 || convert->in_y != 0
+      || convert->out_x != 0 || convert->out_y != 0
+      || convert->in_width != convert->in_maxwidth
+      || convert->out_width != convert->out_maxwidth)
+    return FALSE;
+
+  /* expand to chroma subsampling alignment; 8x4 covers all formats */
+  x2 = MIN (GST_ROUND_UP_8 (x + width), convert->in_maxwidth);
+  y2 = MIN (GST_ROUND_UP_4 (y + height), convert->in_maxheight);
+  x = MAX (x & ~7, 0);
+  y = MAX (y & ~3, 0);
+  width = x2 - x;
+  height = y2 - y;
+
+  if (width <= 0 || height <= 0)
+    return FALSE;
+
+  region = video_converter_get_region_converter (convert, x, y, width,
+      height);
+  if (region == NULL)
+    return FALSE;
+
+  gst_video_converter_frame (region, src, dest);
+
+  return TRUE;
+}
+
+/**
+ * gst_video_converter_frame_finish:
+ * @convert: a #GstVideoConverter
+ *
+ * Wait until all conversions queued with
+ * gst_video_converter_frame_async() have completed and their callbacks
+ * have been invoked.
+ *
+ * Since: 1.14
+ */
+void
+gst_video_converter_frame_finish (GstVideoConverter * convert)
+{
+  g_return_if_fail (convert != NULL);
+
+  g_mutex_lock (&convert->async_lock);
+  while (convert->async_running)
+    g_cond_wait (&convert->async_done, &convert->async_lock);
+  g_mutex_unlock (&convert->async_lock);
+}
+
 static void
 video_converter_compute_matrix (GstVideoConverter * convert)
 {
@@ -2776,7 +3376,9 @@ do_unpack_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
   GstVideoConverter *convert = user_data;
   gpointer tmpline;
   guint cline;
+  GstClockTime stage_start = 0;
 
+  STAGE_TIMER_START (convert, stage_start);
   cline = CLAMP (in_line + convert->in_y, 0, convert->in_maxheight - 1);
 
   if (cache->alloc_writable || !convert->identity_unpack) {
@@ -2790,6 +3392,7 @@ do_unpack_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
     GST_DEBUG ("get src line %d (%u) %p", in_line, cline, tmpline);
   }
   gst_line_cache_add_line (cache, in_line, tmpline);
+  STAGE_TIMER_STOP (convert, idx, STAGE_UNPACK, stage_start);
 
   return TRUE;
 }
@@ -2801,6 +3404,7 @@ do_upsample_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
   GstVideoConverter *convert = user_data;
   gpointer *lines;
   gint i, start_line, n_lines;
+  GstClockTime stage_start = 0;
 
   n_lines = convert->up_n_lines;
   start_line = in_line;
@@ -2814,6 +3418,7 @@ do_upsample_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
       gst_line_cache_get_lines (cache->prev, idx, out_line, start_line,
       n_lines);
 
+  STAGE_TIMER_START (convert, stage_start);
   if (convert->upsample) {
     GST_DEBUG ("doing upsample %d-%d %p", start_line, start_line + n_lines - 1,
         lines[0]);
@@ -2823,6 +3428,7 @@ do_upsample_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
 
   for (i = 0; i < n_lines; i++)
     gst_line_cache_add_line (cache, start_line + i, lines[i]);
+  STAGE_TIMER_STOP (convert, idx, STAGE_UPSAMPLE, stage_start);
 
   return TRUE;
 }
@@ -2834,10 +3440,12 @@ do_convert_to_RGB_lines (GstLineCache * cache, gint idx, gint out_line,
   GstVideoConverter *convert = user_data;
   MatrixData *data = &convert->to_RGB_matrix;
   gpointer *lines, destline;
+  GstClockTime stage_start = 0;
 
   lines = gst_line_cache_get_lines (cache->prev, idx, out_line, in_line, 1);
   destline = lines[0];
 
+  STAGE_TIMER_START (convert, stage_start);
   if (data->matrix_func) {
     GST_DEBUG ("to RGB line %d %p", in_line, destline);
     data->matrix_func (data, destline);
@@ -2849,6 +3457,7 @@ do_convert_to_RGB_lines (GstLineCache * cache, gint idx, gint out_line,
     convert->gamma_dec.gamma_func (&convert->gamma_dec, destline, lines[0]);
   }
   gst_line_cache_add_line (cache, in_line, destline);
+  STAGE_TIMER_STOP (convert, idx, STAGE_TO_RGB, stage_start);
 
   return TRUE;
 }
@@ -2859,9 +3468,11 @@ do_hscale_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
 {
   GstVideoConverter *convert = user_data;
   gpointer *lines, destline;
+  GstClockTime stage_start = 0;
 
   lines = gst_line_cache_get_lines (cache->prev, idx, out_line, in_line, 1);
 
+  STAGE_TIMER_START (convert, stage_start);
   destline = gst_line_cache_alloc_line (cache, out_line);
 
   GST_DEBUG ("hresample line %d %p->%p", in_line, lines[0], destline);
@@ -2869,6 +3480,7 @@ do_hscale_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
       lines[0], destline, 0, convert->out_width);
 
   gst_line_cache_add_line (cache, in_line, destline);
+  STAGE_TIMER_STOP (convert, idx, STAGE_HSCALE, stage_start);
 
   return TRUE;
 }
@@ -2881,12 +3493,14 @@ do_vscale_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
   gpointer *lines, destline;
   guint sline, n_lines;
   guint cline;
+  GstClockTime stage_start = 0;
 
   cline = CLAMP (in_line, 0, convert->out_height - 1);
 
   gst_video_scaler_get_coeff (convert->v_scaler[idx], cline, &sline, &n_lines);
   lines = gst_line_cache_get_lines (cache->prev, idx, out_line, sline, n_lines);
 
+  STAGE_TIMER_START (convert, stage_start);
   destline = gst_line_cache_alloc_line (cache, out_line);
 
   GST_DEBUG ("vresample line %d %d-%d %p->%p", in_line, sline,
@@ -2895,6 +3509,7 @@ do_vscale_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
       lines, destline, cline, convert->v_scale_width);
 
   gst_line_cache_add_line (cache, in_line, destline);
+  STAGE_TIMER_STOP (convert, idx, STAGE_VSCALE, stage_start);
 
   return TRUE;
 }
@@ -2908,9 +3523,11 @@ do_convert_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
   gpointer *lines, destline;
   guint in_bits, out_bits;
   gint width;
+  GstClockTime stage_start = 0;
 
   lines = gst_line_cache_get_lines (cache->prev, idx, out_line, in_line, 1);
 
+  STAGE_TIMER_START (convert, stage_start);
   destline = lines[0];
 
   in_bits = convert->in_bits;
@@ -2948,6 +3565,7 @@ do_convert_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
     }
   }
   gst_line_cache_add_line (cache, in_line, destline);
+  STAGE_TIMER_STOP (convert, idx, STAGE_CONVERT, stage_start);
 
   return TRUE;
 }
@@ -2959,14 +3577,17 @@ do_alpha_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
   gpointer *lines, destline;
   GstVideoConverter *convert = user_data;
   gint width = MIN (convert->in_width, convert->out_width);
+  GstClockTime stage_start = 0;
 
   lines = gst_line_cache_get_lines (cache->prev, idx, out_line, in_line, 1);
   destline = lines[0];
 
+  STAGE_TIMER_START (convert, stage_start);
   GST_DEBUG ("alpha line %d %p", in_line, destline);
   convert->alpha_func (convert, destline, width);
 
   gst_line_cache_add_line (cache, in_line, destline);
+  STAGE_TIMER_STOP (convert, idx, STAGE_ALPHA, stage_start);
 
   return TRUE;
 }
@@ -2978,10 +3599,12 @@ do_convert_to_YUV_lines (GstLineCache * cache, gint idx, gint out_line,
   GstVideoConverter *convert = user_data;
   MatrixData *data = &convert->to_YUV_matrix;
   gpointer *lines, destline;
+  GstClockTime stage_start = 0;
 
   lines = gst_line_cache_get_lines (cache->prev, idx, out_line, in_line, 1);
   destline = lines[0];
 
+  STAGE_TIMER_START (convert, stage_start);
   if (convert->gamma_enc.gamma_func) {
     destline = gst_line_cache_alloc_line (cache, out_line);
 
@@ -2993,6 +3616,7 @@ do_convert_to_YUV_lines (GstLineCache * cache, gint idx, gint out_line,
     data->matrix_func (data, destline);
   }
   gst_line_cache_add_line (cache, in_line, destline);
+  STAGE_TIMER_STOP (convert, idx, STAGE_TO_YUV, stage_start);
 
   return TRUE;
 }
@@ -3004,6 +3628,7 @@ do_downsample_lines (GstLineCache * cache, gint idx, gint out_line,
   GstVideoConverter *convert = user_data;
   gpointer *lines;
   gint i, start_line, n_lines;
+  GstClockTime stage_start = 0;
 
   n_lines = convert->down_n_lines;
   start_line = in_line;
@@ -3015,6 +3640,7 @@ do_downsample_lines (GstLineCache * cache, gint idx, gint out_line,
       gst_line_cache_get_lines (cache->prev, idx, out_line, start_line,
       n_lines);
 
+  STAGE_TIMER_START (convert, stage_start);
   if (convert->downsample) {
     GST_DEBUG ("downsample line %d %d-%d %p", in_line, start_line,
         start_line + n_lines - 1, lines[0]);
@@ -3024,6 +3650,7 @@ do_downsample_lines (GstLineCache * cache, gint idx, gint out_line,
 
   for (i = 0; i < n_lines; i++)
     gst_line_cache_add_line (cache, start_line + i, lines[i]);
+  STAGE_TIMER_STOP (convert, idx, STAGE_DOWNSAMPLE, stage_start);
 
   return TRUE;
 }
@@ -3034,22 +3661,26 @@ do_dither_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
 {
   GstVideoConverter *convert = user_data;
   gpointer *lines, destline;
+  GstClockTime stage_start = 0;
 
   lines = gst_line_cache_get_lines (cache->prev, idx, out_line, in_line, 1);
   destline = lines[0];
 
+  STAGE_TIMER_START (convert, stage_start);
   if (convert->dither) {
     GST_DEBUG ("Dither line %d %p", in_line, destline);
     gst_video_dither_line (convert->dither[idx], destline, 0, out_line,
         convert->out_width);
   }
   gst_line_cache_add_line (cache, in_line, destline);
+  STAGE_TIMER_STOP (convert, idx, STAGE_DITHER, stage_start);
 
   return TRUE;
 }
 
 typedef struct
 {
+  GstVideoConverter *convert;
   GstLineCache *pack_lines;
   gint idx;
   gint h_0, h_1;
@@ -3064,6 +3695,7 @@ static void
 convert_generic_task (ConvertTask * task)
 {
   gint i;
+  GstClockTime stage_start = 0;
 
   for (i = task->h_0; i < task->h_1; i += task->pack_lines_count) {
     gpointer *lines;
@@ -3078,7 +3710,9 @@ convert_generic_task (ConvertTask * task)
       guint8 *l = ((guint8 *) lines[0]) - task->lb_width;
       /* and pack into destination */
       GST_DEBUG ("pack line %d %p (%p)", i + task->out_y, lines[0], l);
+      STAGE_TIMER_START (task->convert, stage_start);
       PACK_FRAME (task->dest, l, i + task->out_y, task->out_maxwidth);
+      STAGE_TIMER_STOP (task->convert, task->idx, STAGE_PACK, stage_start);
     }
   }
 }
@@ -3152,6 +3786,7 @@ video_converter_generic (GstVideoConverter * convert, const GstVideoFrame * src,
       GST_ROUND_UP_N ((out_height + n_threads - 1) / n_threads, pack_lines);
 
   for (i = 0; i < n_threads; i++) {
+    tasks[i].convert = convert;
     tasks[i].dest = dest;
     tasks[i].pack_lines = convert->pack_lines[i];
     tasks[i].idx = i;
@@ -6191,6 +6826,142 @@ setup_scale (GstVideoConverter * convert)
   return TRUE;
 }
 
+static void
+convert_NV12_I420_task (FConvertPlaneTask * task)
+{
+  gint i;
+
+  video_orc_memcpy_2d (task->d, task->dstride, task->s, task->sstride,
+      task->width, task->height);
+
+  for (i = 0; i < task->height / 2; i++)
+    video_converter_deinterleave_uv (task->du + i * task->dustride,
+        task->dv + i * task->dvstride, task->s2 + i * task->sustride,
+        task->width / 2);
+}
+
+static void
+convert_NV12_I420 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  guint8 *sy, *suv, *dy, *du, *dv;
+  FConvertPlaneTask *tasks;
+  FConvertPlaneTask **tasks_p;
+  gint n_threads;
+  gint lines_per_thread;
+  gint i;
+
+  sy = FRAME_GET_Y_LINE (src, 0);
+  suv = FRAME_GET_U_LINE (src, 0);
+
+  dy = FRAME_GET_Y_LINE (dest, 0);
+  du = FRAME_GET_U_LINE (dest, 0);
+  dv = FRAME_GET_V_LINE (dest, 0);
+
+  n_threads = convert->conversion_runner->n_threads;
+  tasks = g_newa (FConvertPlaneTask, n_threads);
+  tasks_p = g_newa (FConvertPlaneTask *, n_threads);
+
+  /* split on even line boundaries so that each task gets matching
+   * luma and chroma regions */
+  lines_per_thread = GST_ROUND_UP_2 ((height + n_threads - 1) / n_threads);
+
+  for (i = 0; i < n_threads; i++) {
+    tasks[i].dstride = FRAME_GET_Y_STRIDE (dest);
+    tasks[i].dustride = FRAME_GET_U_STRIDE (dest);
+    tasks[i].dvstride = FRAME_GET_V_STRIDE (dest);
+    tasks[i].sstride = FRAME_GET_Y_STRIDE (src);
+    tasks[i].sustride = FRAME_GET_U_STRIDE (src);
+    tasks[i].d = dy + i * lines_per_thread * tasks[i].dstride;
+    tasks[i].du = du + i * (lines_per_thread / 2) * tasks[i].dustride;
+    tasks[i].dv = dv + i * (lines_per_thread / 2) * tasks[i].dvstride;
+    tasks[i].s = sy + i * lines_per_thread * tasks[i].sstride;
+    tasks[i].s2 = suv + i * (lines_per_thread / 2) * tasks[i].sustride;
+
+    tasks[i].width = width;
+    tasks[i].height = (i + 1) * lines_per_thread;
+    tasks[i].height = MIN (tasks[i].height, height);
+    tasks[i].height -= i * lines_per_thread;
+    tasks[i].height = MAX (tasks[i].height, 0);
+
+    tasks_p[i] = &tasks[i];
+  }
+
+  gst_parallelized_task_runner_run (convert->conversion_runner,
+      (GstParallelizedTaskFunc) convert_NV12_I420_task, (gpointer) tasks_p);
+
+  convert_fill_border (convert, dest);
+}
+
+static void
+convert_I420_NV12_task (FConvertPlaneTask * task)
+{
+  gint i;
+
+  video_orc_memcpy_2d (task->d, task->dstride, task->s, task->sstride,
+      task->width, task->height);
+
+  for (i = 0; i < task->height / 2; i++)
+    video_converter_interleave_uv (task->d2 + i * task->dustride,
+        task->su + i * task->sustride, task->sv + i * task->svstride,
+        task->width / 2);
+}
+
+static void
+convert_I420_NV12 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  guint8 *sy, *su, *sv, *dy, *duv;
+  FConvertPlaneTask *tasks;
+  FConvertPlaneTask **tasks_p;
+  gint n_threads;
+  gint lines_per_thread;
+  gint i;
+
+  sy = FRAME_GET_Y_LINE (src, 0);
+  su = FRAME_GET_U_LINE (src, 0);
+  sv = FRAME_GET_V_LINE (src, 0);
+
+  dy = FRAME_GET_Y_LINE (dest, 0);
+  duv = FRAME_GET_U_LINE (dest, 0);
+
+  n_threads = convert->conversion_runner->n_threads;
+  tasks = g_newa (FConvertPlaneTask, n_threads);
+  tasks_p = g_newa (FConvertPlaneTask *, n_threads);
+
+  lines_per_thread = GST_ROUND_UP_2 ((height + n_threads - 1) / n_threads);
+
+  for (i = 0; i < n_threads; i++) {
+    tasks[i].dstride = FRAME_GET_Y_STRIDE (dest);
+    tasks[i].dustride = FRAME_GET_U_STRIDE (dest);
+    tasks[i].sstride = FRAME_GET_Y_STRIDE (src);
+    tasks[i].sustride = FRAME_GET_U_STRIDE (src);
+    tasks[i].svstride = FRAME_GET_V_STRIDE (src);
+    tasks[i].d = dy + i * lines_per_thread * tasks[i].dstride;
+    tasks[i].d2 = duv + i * (lines_per_thread / 2) * tasks[i].dustride;
+    tasks[i].s = sy + i * lines_per_thread * tasks[i].sstride;
+    tasks[i].su = su + i * (lines_per_thread / 2) * tasks[i].sustride;
+    tasks[i].sv = sv + i * (lines_per_thread / 2) * tasks[i].svstride;
+
+    tasks[i].width = width;
+    tasks[i].height = (i + 1) * lines_per_thread;
+    tasks[i].height = MIN (tasks[i].height, height);
+    tasks[i].height -= i * lines_per_thread;
+    tasks[i].height = MAX (tasks[i].height, 0);
+
+    tasks_p[i] = &tasks[i];
+  }
+
+  gst_parallelized_task_runner_run (convert->conversion_runner,
+      (GstParallelizedTaskFunc) convert_I420_NV12_task, (gpointer) tasks_p);
+
+  convert_fill_border (convert, dest);
+}
+
 /* Fast paths */
 
 typedef struct
@@ -6464,6 +7235,16 @@ static const VideoTransform transforms[] = {
   {GST_VIDEO_FORMAT_YVU9, GST_VIDEO_FORMAT_YVU9, FALSE, FALSE, FALSE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_scale_planes},
 
+  /* planar <-> semiplanar */
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_I420, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 1, 1, convert_NV12_I420},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_YV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 1, 1, convert_NV12_I420},
+  {GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 1, 1, convert_I420_NV12},
+  {GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 1, 1, convert_I420_NV12},
+
   /* sempiplanar -> semiplanar */
   {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, FALSE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_scale_planes},
@@ -269,10 +269,55 @@ typedef enum {
  * GST_VIDEO_CONVERTER_OPT_THREADS:
  *
  * #G_TYPE_UINT, maximum number of threads to use. Default 1, 0 for the number
- * of cores.
+ * of cores. Worker threads are taken from a pool shared by all converter
+ * instances in the process, so the sum of all converters never uses more
+ * threads than there are cores.
  */
 #define GST_VIDEO_CONVERTER_OPT_THREADS   "GstVideoConverter.threads"
 
+/**
+ * GST_VIDEO_CONVERTER_OPT_CACHE_PLANS:
+ *
+ * #G_TYPE_BOOLEAN, when %TRUE, park freed converters in a small
+ * process-wide cache and reuse them when a converter for the same
+ * input/output info and configuration is requested again, skipping
+ * the conversion chain setup entirely. Default %FALSE.
+ *
+ * Since: 1.14
+ */
+#define GST_VIDEO_CONVERTER_OPT_CACHE_PLANS   "GstVideoConverter.cache-plans"
+
+/**
+ * GST_VIDEO_CONVERTER_OPT_TILE_WIDTH:
+ *
+ * #G_TYPE_UINT, width in pixels of the vertical columns the frame is
+ * split into for cache-blocked execution, 0 to disable tiling (default).
+ * With tiling, all temporary lines of a column fit in the CPU cache,
+ * which helps for very wide frames. Only used when no scaling, cropping
+ * or border filling is performed; tile boundaries are kept aligned to
+ * the chroma subsampling and horizontal chroma interpolation does not
+ * cross them.
+ *
+ * Since: 1.14
+ */
+#define GST_VIDEO_CONVERTER_OPT_TILE_WIDTH   "GstVideoConverter.tile-width"
+
+/**
+ * GST_VIDEO_CONVERTER_OPT_PROFILE_STAGES:
+ *
+ * #G_TYPE_BOOLEAN, when %TRUE, record the processing time spent in each
+ * stage of the conversion chain (unpack, chroma up/downsample, matrix,
+ * gamma, scaling, dither, pack) while converting. The accumulated times
+ * are exposed as "GstVideoConverter.stat-&lt;stage&gt;-time" #G_TYPE_UINT64
+ * fields (in nanoseconds) of the #GstStructure returned by
+ * gst_video_converter_get_config(). Only the generic conversion path is
+ * instrumented; fastpath conversions report no stage times.
+ * Default %FALSE.
+ *
+ * Since: 1.14
+ */
+#define GST_VIDEO_CONVERTER_OPT_PROFILE_STAGES   "GstVideoConverter.profile-stages"
+
 typedef struct _GstVideoConverter GstVideoConverter;
 
 GST_EXPORT
@@ -293,6 +338,34 @@ GST_EXPORT
 void                 gst_video_converter_frame          (GstVideoConverter * convert,
                                                          const GstVideoFrame *src, GstVideoFrame *dest);
 
+/**
+ * GstVideoConverterAsyncFunc:
+ * @convert: the #GstVideoConverter
+ * @dest: the converted destination frame
+ * @user_data: user data
+ *
+ * Callback invoked from a worker thread when a frame queued with
+ * gst_video_converter_frame_async() has been converted.
+ *
+ * Since: 1.14
+ */
+typedef void (*GstVideoConverterAsyncFunc) (GstVideoConverter * convert,
+                                            GstVideoFrame * dest,
+                                            gpointer user_data);
+
+GST_EXPORT
+void                 gst_video_converter_frame_async    (GstVideoConverter * convert,
+                                                         const GstVideoFrame *src, GstVideoFrame *dest,
+                                                         GstVideoConverterAsyncFunc func, gpointer user_data);
+
+GST_EXPORT
+void                 gst_video_converter_frame_finish   (GstVideoConverter * convert);
+
+GST_EXPORT
+gboolean             gst_video_converter_frame_region   (GstVideoConverter * convert,
+                                                         const GstVideoFrame *src, GstVideoFrame *dest,
+                                                         gint x, gint y, gint width, gint height);
+
 
 G_END_DECLS
 
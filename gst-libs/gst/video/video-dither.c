@@ -94,19 +94,23 @@ dither_verterr_u16 (GstVideoDither * dither, gpointer pixels, guint x, guint y,
     memset (e + (x * 4), 0, width * 8);
 
   {
-    gint i, end;
+    gint i, j, end;
     guint16 *m = dither->mask;
-    guint32 v, mp;
 
     end = (width + x) * 4;
-    for (i = x * 4; i < end; i++) {
-      mp = m[i & 3];
-      v = p[i] + e[i];
-      /* take new error and store */
-      e[i] = v & mp;
-      /* quantize and store */
-      v &= ~mp;
-      p[i] = MIN (v, 65535);
+    /* the components of a pixel are independent lanes; processing them as a
+     * block lets the compiler use SIMD for the adds and masking */
+    for (i = x * 4; i < end; i += 4) {
+      for (j = 0; j < 4; j++) {
+        guint32 mp = m[j];
+        guint32 v = p[i + j] + e[i + j];
+
+        /* take new error and store */
+        e[i + j] = v & mp;
+        /* quantize and store */
+        v &= ~mp;
+        p[i + j] = MIN (v, 65535);
+      }
     }
   }
 }
@@ -125,20 +129,25 @@ dither_floyd_steinberg_u8 (GstVideoDither * dither, gpointer pixels, guint x,
   video_orc_dither_fs_muladd_u8 (e + x * 4, width * 4);
 #if 1
   {
-    gint i, end;
-    guint16 *m = dither->mask, mp;
-    guint16 v;
+    gint i, j, end;
+    guint16 *m = dither->mask;
 
     end = (width + x) * 4;
 
-    for (i = x * 4; i < end; i++) {
-      mp = m[i & 3];
-      v = p[i] + ((7 * e[i] + e[i + 4]) >> 4);
-      /* take new error and store */
-      e[i + 4] = v & mp;
-      /* quantize and store */
-      v &= ~mp;
-      p[i] = MIN (v, 255);
+    /* the error only propagates between pixels, never between components,
+     * so each pixel is a block of 4 independent lanes the compiler can
+     * process with SIMD */
+    for (i = x * 4; i < end; i += 4) {
+      for (j = 0; j < 4; j++) {
+        guint16 mp = m[j];
+        guint16 v = p[i + j] + ((7 * e[i + j] + e[i + j + 4]) >> 4);
+
+        /* take new error and store */
+        e[i + j + 4] = v & mp;
+        /* quantize and store */
+        v &= ~mp;
+        p[i + j] = MIN (v, 255);
+      }
     }
   }
 #else
@@ -158,20 +167,25 @@ dither_floyd_steinberg_u16 (GstVideoDither * dither, gpointer pixels, guint x,
     memset (e + (x * 4), 0, (width + 1) * 8);
 
   {
-    gint i, end;
-    guint16 *m = dither->mask, mp;
-    guint32 v;
+    gint i, j, end;
+    guint16 *m = dither->mask;
 
     end = (width + x) * 4;
-    for (i = x * 4; i < end; i++) {
-      mp = m[i & 3];
-      /* apply previous errors to pixel */
-      v = p[i] + ((7 * e[i] + e[i + 4] + 5 * e[i + 8] + 3 * e[i + 12]) >> 4);
-      /* take new error and store */
-      e[i + 4] = v & mp;
-      /* quantize and store */
-      v &= ~mp;
-      p[i] = MIN (v, 65535);
+    /* same component-lane blocking as the 8-bit variant */
+    for (i = x * 4; i < end; i += 4) {
+      for (j = 0; j < 4; j++) {
+        guint32 mp = m[j];
+        guint32 v;
+
+        /* apply previous errors to pixel */
+        v = p[i + j] + ((7 * e[i + j] + e[i + j + 4] + 5 * e[i + j + 8] +
+                3 * e[i + j + 12]) >> 4);
+        /* take new error and store */
+        e[i + j + 4] = v & mp;
+        /* quantize and store */
+        v &= ~mp;
+        p[i + j] = MIN (v, 65535);
+      }
     }
   }
 }
@@ -182,23 +196,28 @@ dither_sierra_lite_u8 (GstVideoDither * dither, gpointer pixels, guint x,
 {
   guint8 *p = pixels;
   guint16 *e = dither->errors;
-  gint i, end;
-  guint16 *m = dither->mask, mp;
-  guint16 v;
+  gint i, j, end;
+  guint16 *m = dither->mask;
 
   if (y == 0)
     memset (e + (x * 4), 0, (width + 4) * 8);
 
   end = (width + x) * 4;
-  for (i = x; i < end; i++) {
-    mp = m[i & 3];
-    /* apply previous errors to pixel */
-    v = p[i] + ((2 * e[i] + e[i + 8] + e[i + 12]) >> 2);
-    /* store new error */
-    e[i + 4] = v & mp;
-    /* quantize and store */
-    v &= ~mp;
-    p[i] = MIN (v, 255);
+  /* component lanes are independent, process each pixel as a SIMD-friendly
+   * block of 4 */
+  for (i = x * 4; i < end; i += 4) {
+    for (j = 0; j < 4; j++) {
+      guint16 mp = m[j];
+      guint16 v;
+
+      /* apply previous errors to pixel */
+      v = p[i + j] + ((2 * e[i + j] + e[i + j + 8] + e[i + j + 12]) >> 2);
+      /* store new error */
+      e[i + j + 4] = v & mp;
+      /* quantize and store */
+      v &= ~mp;
+      p[i + j] = MIN (v, 255);
+    }
   }
 }
 
@@ -208,23 +227,27 @@ dither_sierra_lite_u16 (GstVideoDither * dither, gpointer pixels, guint x,
 {
   guint16 *p = pixels;
   guint16 *e = dither->errors;
-  gint i, end;
-  guint16 *m = dither->mask, mp;
-  guint32 v;
+  gint i, j, end;
+  guint16 *m = dither->mask;
 
   if (y == 0)
     memset (e + (x * 4), 0, (width + 4) * 8);
 
   end = (width + x) * 4;
-  for (i = x; i < end; i++) {
-    mp = m[i & 3];
-    /* apply previous errors to pixel */
-    v = p[i] + ((2 * e[i] + e[i + 8] + e[i + 12]) >> 2);
-    /* store new error */
-    e[i + 4] = v & mp;
-    /* quantize and store */
-    v &= ~mp;
-    p[i] = MIN (v & ~mp, 65535);
+  /* same component-lane blocking as the 8-bit variant */
+  for (i = x * 4; i < end; i += 4) {
+    for (j = 0; j < 4; j++) {
+      guint32 mp = m[j];
+      guint32 v;
+
+      /* apply previous errors to pixel */
+      v = p[i + j] + ((2 * e[i + j] + e[i + j + 8] + e[i + j + 12]) >> 2);
+      /* store new error */
+      e[i + j + 4] = v & mp;
+      /* quantize and store */
+      v &= ~mp;
+      p[i + j] = MIN (v, 65535);
+    }
   }
 }
 
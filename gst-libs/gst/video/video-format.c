@@ -25,6 +25,7 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "video-format.h"
 #include "video-orc.h"
@@ -5102,16 +5103,58 @@ gst_video_format_from_fourcc (guint32 fourcc)
  * Returns: the #GstVideoFormat for @format or GST_VIDEO_FORMAT_UNKNOWN when the
  * string is not a known format.
  */
+/* index into formats[], sorted by format name, so that format lookup by
+ * string is a binary search instead of a linear scan with a strcmp per
+ * entry. Built once on first use. */
+static guint16 format_name_index[G_N_ELEMENTS (formats)];
+
+static gint
+format_name_index_compare (gconstpointer a, gconstpointer b)
+{
+  const guint16 *ia = a, *ib = b;
+
+  return strcmp (GST_VIDEO_FORMAT_INFO_NAME (&formats[*ia].info),
+      GST_VIDEO_FORMAT_INFO_NAME (&formats[*ib].info));
+}
+
+static void
+ensure_format_name_index (void)
+{
+  static gsize once = 0;
+
+  if (g_once_init_enter (&once)) {
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (formats); i++)
+      format_name_index[i] = i;
+    qsort (format_name_index, G_N_ELEMENTS (formats),
+        sizeof (format_name_index[0]), format_name_index_compare);
+    g_once_init_leave (&once, 1);
+  }
+}
+
 GstVideoFormat
 gst_video_format_from_string (const gchar * format)
 {
-  guint i;
+  gint lo, hi;
 
   g_return_val_if_fail (format != NULL, GST_VIDEO_FORMAT_UNKNOWN);
 
-  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
-    if (strcmp (GST_VIDEO_FORMAT_INFO_NAME (&formats[i].info), format) == 0)
-      return GST_VIDEO_FORMAT_INFO_FORMAT (&formats[i].info);
+  ensure_format_name_index ();
+
+  lo = 0;
+  hi = G_N_ELEMENTS (formats) - 1;
+  while (lo <= hi) {
+    gint mid = (lo + hi) / 2;
+    const GstVideoFormatInfo *info = &formats[format_name_index[mid]].info;
+    gint cmp = strcmp (format, GST_VIDEO_FORMAT_INFO_NAME (info));
+
+    if (cmp == 0)
+      return GST_VIDEO_FORMAT_INFO_FORMAT (info);
+    else if (cmp < 0)
+      hi = mid - 1;
+    else
+      lo = mid + 1;
   }
   return GST_VIDEO_FORMAT_UNKNOWN;
 }
@@ -460,6 +460,26 @@ void video_orc_chroma_down_v4_u8 (guint8 * ORC_RESTRICT d1,
 void video_orc_chroma_down_v4_u16 (guint16 * ORC_RESTRICT d1,
     const guint16 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2,
     const guint16 * ORC_RESTRICT s3, const guint16 * ORC_RESTRICT s4, int n);
+void video_orc_chroma_up_v4_u8 (guint8 * ORC_RESTRICT d1,
+    guint8 * ORC_RESTRICT d2, guint8 * ORC_RESTRICT d3,
+    guint8 * ORC_RESTRICT d4, const guint8 * ORC_RESTRICT s1,
+    const guint8 * ORC_RESTRICT s2, const guint8 * ORC_RESTRICT s3,
+    const guint8 * ORC_RESTRICT s4, int n);
+void video_orc_chroma_up_v4_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n);
+void video_orc_chroma_up_vi2_u8 (guint8 * ORC_RESTRICT d1,
+    guint8 * ORC_RESTRICT d2, guint8 * ORC_RESTRICT d3,
+    guint8 * ORC_RESTRICT d4, const guint8 * ORC_RESTRICT s1,
+    const guint8 * ORC_RESTRICT s2, const guint8 * ORC_RESTRICT s3,
+    const guint8 * ORC_RESTRICT s4, int n);
+void video_orc_chroma_up_vi2_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n);
 void video_orc_dither_none_4u8_mask (guint8 * ORC_RESTRICT d1, int p1, int n);
 void video_orc_dither_none_4u16_mask (guint16 * ORC_RESTRICT d1, orc_int64 p1,
     int n);
@@ -31618,6 +31638,2710 @@ video_orc_chroma_down_v4_u16 (guint16 * ORC_RESTRICT d1,
 #endif
 
 
+/* video_orc_chroma_up_v4_u8 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_up_v4_u8 (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+    guint8 * ORC_RESTRICT d3, guint8 * ORC_RESTRICT d4,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 *ORC_RESTRICT ptr1;
+  orc_union32 *ORC_RESTRICT ptr2;
+  orc_union32 *ORC_RESTRICT ptr3;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  const orc_union32 *ORC_RESTRICT ptr6;
+  const orc_union32 *ORC_RESTRICT ptr7;
+  orc_union32 var41;
+  orc_union32 var42;
+  orc_union32 var43;
+  orc_union32 var44;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var45;
+#else
+  orc_union32 var45;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var46;
+#else
+  orc_union32 var46;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var47;
+#else
+  orc_union32 var47;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var48;
+#else
+  orc_union32 var48;
+#endif
+  orc_union32 var49;
+  orc_union32 var50;
+  orc_union32 var51;
+  orc_union32 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union32 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union32 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union32 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union32 var66;
+  orc_union16 var67;
+  orc_union32 var68;
+  orc_union32 var69;
+  orc_union32 var70;
+  orc_union32 var71;
+  orc_union32 var72;
+  orc_union16 var73;
+  orc_union32 var74;
+  orc_union32 var75;
+  orc_union32 var76;
+  orc_union32 var77;
+  orc_union32 var78;
+  orc_union16 var79;
+  orc_union32 var80;
+  orc_union32 var81;
+  orc_union32 var82;
+  orc_union32 var83;
+  orc_union16 var84;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr1 = (orc_union32 *) d2;
+  ptr2 = (orc_union32 *) d3;
+  ptr3 = (orc_union32 *) d4;
+  ptr4 = (orc_union32 *) s1;
+  ptr5 = (orc_union32 *) s2;
+  ptr6 = (orc_union32 *) s3;
+  ptr7 = (orc_union32 *) s4;
+
+  /* 10: loadpw */
+  var45.x2[0] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+  var45.x2[1] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+  /* 13: loadpw */
+  var46.x2[0] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  var46.x2[1] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  /* 19: loadpw */
+  var47.x2[0] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  var47.x2[1] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  /* 21: loadpw */
+  var48.x2[0] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+  var48.x2[1] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var41 = ptr4[i];
+    /* 1: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var41.i;
+      var53.i = _src.x2[1];
+      var54.i = _src.x2[0];
+    }
+    /* 2: convubw */
+    var55.x2[0] = (orc_uint8) var53.x2[0];
+    var55.x2[1] = (orc_uint8) var53.x2[1];
+    /* 3: loadl */
+    var42 = ptr5[i];
+    /* 4: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var42.i;
+      var56.i = _src.x2[1];
+      var57.i = _src.x2[0];
+    }
+    /* 5: loadl */
+    var43 = ptr6[i];
+    /* 6: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var43.i;
+      var58.i = _src.x2[1];
+      var59.i = _src.x2[0];
+    }
+    /* 7: convubw */
+    var60.x2[0] = (orc_uint8) var58.x2[0];
+    var60.x2[1] = (orc_uint8) var58.x2[1];
+    /* 8: loadl */
+    var44 = ptr7[i];
+    /* 9: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var44.i;
+      var61.i = _src.x2[1];
+      var62.i = _src.x2[0];
+    }
+    /* 11: mullw */
+    var63.x2[0] = (var55.x2[0] * var45.x2[0]) & 0xffff;
+    var63.x2[1] = (var55.x2[1] * var45.x2[1]) & 0xffff;
+    /* 12: addw */
+    var64.x2[0] = var63.x2[0] + var60.x2[0];
+    var64.x2[1] = var63.x2[1] + var60.x2[1];
+    /* 14: addw */
+    var65.x2[0] = var64.x2[0] + var46.x2[0];
+    var65.x2[1] = var64.x2[1] + var46.x2[1];
+    /* 15: shruw */
+    var66.x2[0] = ((orc_uint16) var65.x2[0]) >> 3;
+    var66.x2[1] = ((orc_uint16) var65.x2[1]) >> 3;
+    /* 16: convsuswb */
+    var67.x2[0] = ORC_CLAMP_UB (var66.x2[0]);
+    var67.x2[1] = ORC_CLAMP_UB (var66.x2[1]);
+    /* 17: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var54.i;
+      _dest.x2[1] = var67.i;
+      var49.i = _dest.i;
+    }
+    /* 18: storel */
+    ptr0[i] = var49;
+    /* 20: mullw */
+    var68.x2[0] = (var55.x2[0] * var47.x2[0]) & 0xffff;
+    var68.x2[1] = (var55.x2[1] * var47.x2[1]) & 0xffff;
+    /* 22: mullw */
+    var69.x2[0] = (var60.x2[0] * var48.x2[0]) & 0xffff;
+    var69.x2[1] = (var60.x2[1] * var48.x2[1]) & 0xffff;
+    /* 23: addw */
+    var70.x2[0] = var68.x2[0] + var69.x2[0];
+    var70.x2[1] = var68.x2[1] + var69.x2[1];
+    /* 24: addw */
+    var71.x2[0] = var70.x2[0] + var46.x2[0];
+    var71.x2[1] = var70.x2[1] + var46.x2[1];
+    /* 25: shruw */
+    var72.x2[0] = ((orc_uint16) var71.x2[0]) >> 3;
+    var72.x2[1] = ((orc_uint16) var71.x2[1]) >> 3;
+    /* 26: convsuswb */
+    var73.x2[0] = ORC_CLAMP_UB (var72.x2[0]);
+    var73.x2[1] = ORC_CLAMP_UB (var72.x2[1]);
+    /* 27: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var57.i;
+      _dest.x2[1] = var73.i;
+      var50.i = _dest.i;
+    }
+    /* 28: storel */
+    ptr1[i] = var50;
+    /* 29: mullw */
+    var74.x2[0] = (var55.x2[0] * var48.x2[0]) & 0xffff;
+    var74.x2[1] = (var55.x2[1] * var48.x2[1]) & 0xffff;
+    /* 30: mullw */
+    var75.x2[0] = (var60.x2[0] * var47.x2[0]) & 0xffff;
+    var75.x2[1] = (var60.x2[1] * var47.x2[1]) & 0xffff;
+    /* 31: addw */
+    var76.x2[0] = var74.x2[0] + var75.x2[0];
+    var76.x2[1] = var74.x2[1] + var75.x2[1];
+    /* 32: addw */
+    var77.x2[0] = var76.x2[0] + var46.x2[0];
+    var77.x2[1] = var76.x2[1] + var46.x2[1];
+    /* 33: shruw */
+    var78.x2[0] = ((orc_uint16) var77.x2[0]) >> 3;
+    var78.x2[1] = ((orc_uint16) var77.x2[1]) >> 3;
+    /* 34: convsuswb */
+    var79.x2[0] = ORC_CLAMP_UB (var78.x2[0]);
+    var79.x2[1] = ORC_CLAMP_UB (var78.x2[1]);
+    /* 35: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var59.i;
+      _dest.x2[1] = var79.i;
+      var51.i = _dest.i;
+    }
+    /* 36: storel */
+    ptr2[i] = var51;
+    /* 37: mullw */
+    var80.x2[0] = (var60.x2[0] * var45.x2[0]) & 0xffff;
+    var80.x2[1] = (var60.x2[1] * var45.x2[1]) & 0xffff;
+    /* 38: addw */
+    var81.x2[0] = var80.x2[0] + var55.x2[0];
+    var81.x2[1] = var80.x2[1] + var55.x2[1];
+    /* 39: addw */
+    var82.x2[0] = var81.x2[0] + var46.x2[0];
+    var82.x2[1] = var81.x2[1] + var46.x2[1];
+    /* 40: shruw */
+    var83.x2[0] = ((orc_uint16) var82.x2[0]) >> 3;
+    var83.x2[1] = ((orc_uint16) var82.x2[1]) >> 3;
+    /* 41: convsuswb */
+    var84.x2[0] = ORC_CLAMP_UB (var83.x2[0]);
+    var84.x2[1] = ORC_CLAMP_UB (var83.x2[1]);
+    /* 42: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var62.i;
+      _dest.x2[1] = var84.i;
+      var52.i = _dest.i;
+    }
+    /* 43: storel */
+    ptr3[i] = var52;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_up_v4_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 *ORC_RESTRICT ptr1;
+  orc_union32 *ORC_RESTRICT ptr2;
+  orc_union32 *ORC_RESTRICT ptr3;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  const orc_union32 *ORC_RESTRICT ptr6;
+  const orc_union32 *ORC_RESTRICT ptr7;
+  orc_union32 var41;
+  orc_union32 var42;
+  orc_union32 var43;
+  orc_union32 var44;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var45;
+#else
+  orc_union32 var45;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var46;
+#else
+  orc_union32 var46;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var47;
+#else
+  orc_union32 var47;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var48;
+#else
+  orc_union32 var48;
+#endif
+  orc_union32 var49;
+  orc_union32 var50;
+  orc_union32 var51;
+  orc_union32 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union32 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union32 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union32 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union32 var66;
+  orc_union16 var67;
+  orc_union32 var68;
+  orc_union32 var69;
+  orc_union32 var70;
+  orc_union32 var71;
+  orc_union32 var72;
+  orc_union16 var73;
+  orc_union32 var74;
+  orc_union32 var75;
+  orc_union32 var76;
+  orc_union32 var77;
+  orc_union32 var78;
+  orc_union16 var79;
+  orc_union32 var80;
+  orc_union32 var81;
+  orc_union32 var82;
+  orc_union32 var83;
+  orc_union16 var84;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr1 = (orc_union32 *) ex->arrays[1];
+  ptr2 = (orc_union32 *) ex->arrays[2];
+  ptr3 = (orc_union32 *) ex->arrays[3];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+  ptr5 = (orc_union32 *) ex->arrays[5];
+  ptr6 = (orc_union32 *) ex->arrays[6];
+  ptr7 = (orc_union32 *) ex->arrays[7];
+
+  /* 10: loadpw */
+  var45.x2[0] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+  var45.x2[1] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+  /* 13: loadpw */
+  var46.x2[0] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  var46.x2[1] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  /* 19: loadpw */
+  var47.x2[0] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  var47.x2[1] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  /* 21: loadpw */
+  var48.x2[0] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+  var48.x2[1] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var41 = ptr4[i];
+    /* 1: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var41.i;
+      var53.i = _src.x2[1];
+      var54.i = _src.x2[0];
+    }
+    /* 2: convubw */
+    var55.x2[0] = (orc_uint8) var53.x2[0];
+    var55.x2[1] = (orc_uint8) var53.x2[1];
+    /* 3: loadl */
+    var42 = ptr5[i];
+    /* 4: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var42.i;
+      var56.i = _src.x2[1];
+      var57.i = _src.x2[0];
+    }
+    /* 5: loadl */
+    var43 = ptr6[i];
+    /* 6: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var43.i;
+      var58.i = _src.x2[1];
+      var59.i = _src.x2[0];
+    }
+    /* 7: convubw */
+    var60.x2[0] = (orc_uint8) var58.x2[0];
+    var60.x2[1] = (orc_uint8) var58.x2[1];
+    /* 8: loadl */
+    var44 = ptr7[i];
+    /* 9: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var44.i;
+      var61.i = _src.x2[1];
+      var62.i = _src.x2[0];
+    }
+    /* 11: mullw */
+    var63.x2[0] = (var55.x2[0] * var45.x2[0]) & 0xffff;
+    var63.x2[1] = (var55.x2[1] * var45.x2[1]) & 0xffff;
+    /* 12: addw */
+    var64.x2[0] = var63.x2[0] + var60.x2[0];
+    var64.x2[1] = var63.x2[1] + var60.x2[1];
+    /* 14: addw */
+    var65.x2[0] = var64.x2[0] + var46.x2[0];
+    var65.x2[1] = var64.x2[1] + var46.x2[1];
+    /* 15: shruw */
+    var66.x2[0] = ((orc_uint16) var65.x2[0]) >> 3;
+    var66.x2[1] = ((orc_uint16) var65.x2[1]) >> 3;
+    /* 16: convsuswb */
+    var67.x2[0] = ORC_CLAMP_UB (var66.x2[0]);
+    var67.x2[1] = ORC_CLAMP_UB (var66.x2[1]);
+    /* 17: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var54.i;
+      _dest.x2[1] = var67.i;
+      var49.i = _dest.i;
+    }
+    /* 18: storel */
+    ptr0[i] = var49;
+    /* 20: mullw */
+    var68.x2[0] = (var55.x2[0] * var47.x2[0]) & 0xffff;
+    var68.x2[1] = (var55.x2[1] * var47.x2[1]) & 0xffff;
+    /* 22: mullw */
+    var69.x2[0] = (var60.x2[0] * var48.x2[0]) & 0xffff;
+    var69.x2[1] = (var60.x2[1] * var48.x2[1]) & 0xffff;
+    /* 23: addw */
+    var70.x2[0] = var68.x2[0] + var69.x2[0];
+    var70.x2[1] = var68.x2[1] + var69.x2[1];
+    /* 24: addw */
+    var71.x2[0] = var70.x2[0] + var46.x2[0];
+    var71.x2[1] = var70.x2[1] + var46.x2[1];
+    /* 25: shruw */
+    var72.x2[0] = ((orc_uint16) var71.x2[0]) >> 3;
+    var72.x2[1] = ((orc_uint16) var71.x2[1]) >> 3;
+    /* 26: convsuswb */
+    var73.x2[0] = ORC_CLAMP_UB (var72.x2[0]);
+    var73.x2[1] = ORC_CLAMP_UB (var72.x2[1]);
+    /* 27: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var57.i;
+      _dest.x2[1] = var73.i;
+      var50.i = _dest.i;
+    }
+    /* 28: storel */
+    ptr1[i] = var50;
+    /* 29: mullw */
+    var74.x2[0] = (var55.x2[0] * var48.x2[0]) & 0xffff;
+    var74.x2[1] = (var55.x2[1] * var48.x2[1]) & 0xffff;
+    /* 30: mullw */
+    var75.x2[0] = (var60.x2[0] * var47.x2[0]) & 0xffff;
+    var75.x2[1] = (var60.x2[1] * var47.x2[1]) & 0xffff;
+    /* 31: addw */
+    var76.x2[0] = var74.x2[0] + var75.x2[0];
+    var76.x2[1] = var74.x2[1] + var75.x2[1];
+    /* 32: addw */
+    var77.x2[0] = var76.x2[0] + var46.x2[0];
+    var77.x2[1] = var76.x2[1] + var46.x2[1];
+    /* 33: shruw */
+    var78.x2[0] = ((orc_uint16) var77.x2[0]) >> 3;
+    var78.x2[1] = ((orc_uint16) var77.x2[1]) >> 3;
+    /* 34: convsuswb */
+    var79.x2[0] = ORC_CLAMP_UB (var78.x2[0]);
+    var79.x2[1] = ORC_CLAMP_UB (var78.x2[1]);
+    /* 35: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var59.i;
+      _dest.x2[1] = var79.i;
+      var51.i = _dest.i;
+    }
+    /* 36: storel */
+    ptr2[i] = var51;
+    /* 37: mullw */
+    var80.x2[0] = (var60.x2[0] * var45.x2[0]) & 0xffff;
+    var80.x2[1] = (var60.x2[1] * var45.x2[1]) & 0xffff;
+    /* 38: addw */
+    var81.x2[0] = var80.x2[0] + var55.x2[0];
+    var81.x2[1] = var80.x2[1] + var55.x2[1];
+    /* 39: addw */
+    var82.x2[0] = var81.x2[0] + var46.x2[0];
+    var82.x2[1] = var81.x2[1] + var46.x2[1];
+    /* 40: shruw */
+    var83.x2[0] = ((orc_uint16) var82.x2[0]) >> 3;
+    var83.x2[1] = ((orc_uint16) var82.x2[1]) >> 3;
+    /* 41: convsuswb */
+    var84.x2[0] = ORC_CLAMP_UB (var83.x2[0]);
+    var84.x2[1] = ORC_CLAMP_UB (var83.x2[1]);
+    /* 42: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var62.i;
+      _dest.x2[1] = var84.i;
+      var52.i = _dest.i;
+    }
+    /* 43: storel */
+    ptr3[i] = var52;
+  }
+
+}
+
+void
+video_orc_chroma_up_v4_u8 (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+    guint8 * ORC_RESTRICT d3, guint8 * ORC_RESTRICT d4,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 25, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 117, 112, 95, 118, 52, 95, 117, 56, 11, 4, 4, 11,
+        4, 4, 11, 4, 4, 11, 4, 4, 12, 4, 4, 12, 4, 4, 12, 4,
+        4, 12, 4, 4, 14, 2, 7, 0, 0, 0, 14, 2, 4, 0, 0, 0,
+        14, 2, 3, 0, 0, 0, 14, 2, 5, 0, 0, 0, 20, 2, 20, 2,
+        20, 2, 20, 2, 20, 2, 20, 4, 20, 4, 20, 4, 20, 4, 198, 36,
+        32, 4, 21, 1, 150, 37, 36, 198, 36, 33, 5, 198, 36, 34, 6, 21,
+        1, 150, 38, 36, 198, 36, 35, 7, 21, 1, 89, 39, 37, 16, 21, 1,
+        70, 39, 39, 38, 21, 1, 70, 39, 39, 17, 21, 1, 95, 39, 39, 18,
+        21, 1, 160, 36, 39, 195, 0, 32, 36, 21, 1, 89, 39, 37, 19, 21,
+        1, 89, 40, 38, 18, 21, 1, 70, 39, 39, 40, 21, 1, 70, 39, 39,
+        17, 21, 1, 95, 39, 39, 18, 21, 1, 160, 36, 39, 195, 1, 33, 36,
+        21, 1, 89, 39, 37, 18, 21, 1, 89, 40, 38, 19, 21, 1, 70, 39,
+        39, 40, 21, 1, 70, 39, 39, 17, 21, 1, 95, 39, 39, 18, 21, 1,
+        160, 36, 39, 195, 2, 34, 36, 21, 1, 89, 39, 38, 16, 21, 1, 70,
+        39, 39, 37, 21, 1, 70, 39, 39, 17, 21, 1, 95, 39, 39, 18, 21,
+        1, 160, 36, 39, 195, 3, 35, 36, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_v4_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_up_v4_u8");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_v4_u8);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_destination (p, 4, "d2");
+      orc_program_add_destination (p, 4, "d3");
+      orc_program_add_destination (p, 4, "d4");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_source (p, 4, "s2");
+      orc_program_add_source (p, 4, "s3");
+      orc_program_add_source (p, 4, "s4");
+      orc_program_add_constant (p, 2, 0x00000007, "c1");
+      orc_program_add_constant (p, 2, 0x00000004, "c2");
+      orc_program_add_constant (p, 2, 0x00000003, "c3");
+      orc_program_add_constant (p, 2, 0x00000005, "c4");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+      orc_program_add_temporary (p, 4, "t6");
+      orc_program_add_temporary (p, 4, "t7");
+      orc_program_add_temporary (p, 4, "t8");
+      orc_program_add_temporary (p, 4, "t9");
+
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T5, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T6, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T5, ORC_VAR_T2, ORC_VAR_S2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_S3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T5, ORC_VAR_T4, ORC_VAR_S4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T5, ORC_VAR_T8,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T9, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T5, ORC_VAR_T8,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D2, ORC_VAR_T2, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T9, ORC_VAR_T7, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T5, ORC_VAR_T8,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D3, ORC_VAR_T3, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T8, ORC_VAR_T7, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T5, ORC_VAR_T8,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D4, ORC_VAR_T4, ORC_VAR_T5,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_D3] = d3;
+  ex->arrays[ORC_VAR_D4] = d4;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_chroma_up_v4_u16 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_up_v4_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n)
+{
+  int i;
+  orc_union64 *ORC_RESTRICT ptr0;
+  orc_union64 *ORC_RESTRICT ptr1;
+  orc_union64 *ORC_RESTRICT ptr2;
+  orc_union64 *ORC_RESTRICT ptr3;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  const orc_union64 *ORC_RESTRICT ptr6;
+  const orc_union64 *ORC_RESTRICT ptr7;
+  orc_union64 var41;
+  orc_union64 var42;
+  orc_union64 var43;
+  orc_union64 var44;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var45;
+#else
+  orc_union64 var45;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var46;
+#else
+  orc_union64 var46;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var47;
+#else
+  orc_union64 var47;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var48;
+#else
+  orc_union64 var48;
+#endif
+  orc_union64 var49;
+  orc_union64 var50;
+  orc_union64 var51;
+  orc_union64 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union64 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union64 var60;
+  orc_union32 var61;
+  orc_union32 var62;
+  orc_union64 var63;
+  orc_union64 var64;
+  orc_union64 var65;
+  orc_union64 var66;
+  orc_union32 var67;
+  orc_union64 var68;
+  orc_union64 var69;
+  orc_union64 var70;
+  orc_union64 var71;
+  orc_union64 var72;
+  orc_union32 var73;
+  orc_union64 var74;
+  orc_union64 var75;
+  orc_union64 var76;
+  orc_union64 var77;
+  orc_union64 var78;
+  orc_union32 var79;
+  orc_union64 var80;
+  orc_union64 var81;
+  orc_union64 var82;
+  orc_union64 var83;
+  orc_union32 var84;
+
+  ptr0 = (orc_union64 *) d1;
+  ptr1 = (orc_union64 *) d2;
+  ptr2 = (orc_union64 *) d3;
+  ptr3 = (orc_union64 *) d4;
+  ptr4 = (orc_union64 *) s1;
+  ptr5 = (orc_union64 *) s2;
+  ptr6 = (orc_union64 *) s3;
+  ptr7 = (orc_union64 *) s4;
+
+  /* 10: loadpl */
+  var45.x2[0] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+  var45.x2[1] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+  /* 13: loadpl */
+  var46.x2[0] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  var46.x2[1] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  /* 19: loadpl */
+  var47.x2[0] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  var47.x2[1] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  /* 21: loadpl */
+  var48.x2[0] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+  var48.x2[1] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var41 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var41.i;
+      var53.i = _src.x2[1];
+      var54.i = _src.x2[0];
+    }
+    /* 2: convuwl */
+    var55.x2[0] = (orc_uint16) var53.x2[0];
+    var55.x2[1] = (orc_uint16) var53.x2[1];
+    /* 3: loadq */
+    var42 = ptr5[i];
+    /* 4: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var42.i;
+      var56.i = _src.x2[1];
+      var57.i = _src.x2[0];
+    }
+    /* 5: loadq */
+    var43 = ptr6[i];
+    /* 6: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var43.i;
+      var58.i = _src.x2[1];
+      var59.i = _src.x2[0];
+    }
+    /* 7: convuwl */
+    var60.x2[0] = (orc_uint16) var58.x2[0];
+    var60.x2[1] = (orc_uint16) var58.x2[1];
+    /* 8: loadq */
+    var44 = ptr7[i];
+    /* 9: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var44.i;
+      var61.i = _src.x2[1];
+      var62.i = _src.x2[0];
+    }
+    /* 11: mulll */
+    var63.x2[0] =
+        (((orc_uint32) var55.x2[0]) * ((orc_uint32) var45.x2[0])) & 0xffffffff;
+    var63.x2[1] =
+        (((orc_uint32) var55.x2[1]) * ((orc_uint32) var45.x2[1])) & 0xffffffff;
+    /* 12: addl */
+    var64.x2[0] = ((orc_uint32) var63.x2[0]) + ((orc_uint32) var60.x2[0]);
+    var64.x2[1] = ((orc_uint32) var63.x2[1]) + ((orc_uint32) var60.x2[1]);
+    /* 14: addl */
+    var65.x2[0] = ((orc_uint32) var64.x2[0]) + ((orc_uint32) var46.x2[0]);
+    var65.x2[1] = ((orc_uint32) var64.x2[1]) + ((orc_uint32) var46.x2[1]);
+    /* 15: shrul */
+    var66.x2[0] = ((orc_uint32) var65.x2[0]) >> 3;
+    var66.x2[1] = ((orc_uint32) var65.x2[1]) >> 3;
+    /* 16: convsuslw */
+    var67.x2[0] = ORC_CLAMP_UW (var66.x2[0]);
+    var67.x2[1] = ORC_CLAMP_UW (var66.x2[1]);
+    /* 17: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var54.i;
+      _dest.x2[1] = var67.i;
+      var49.i = _dest.i;
+    }
+    /* 18: storeq */
+    ptr0[i] = var49;
+    /* 20: mulll */
+    var68.x2[0] =
+        (((orc_uint32) var55.x2[0]) * ((orc_uint32) var47.x2[0])) & 0xffffffff;
+    var68.x2[1] =
+        (((orc_uint32) var55.x2[1]) * ((orc_uint32) var47.x2[1])) & 0xffffffff;
+    /* 22: mulll */
+    var69.x2[0] =
+        (((orc_uint32) var60.x2[0]) * ((orc_uint32) var48.x2[0])) & 0xffffffff;
+    var69.x2[1] =
+        (((orc_uint32) var60.x2[1]) * ((orc_uint32) var48.x2[1])) & 0xffffffff;
+    /* 23: addl */
+    var70.x2[0] = ((orc_uint32) var68.x2[0]) + ((orc_uint32) var69.x2[0]);
+    var70.x2[1] = ((orc_uint32) var68.x2[1]) + ((orc_uint32) var69.x2[1]);
+    /* 24: addl */
+    var71.x2[0] = ((orc_uint32) var70.x2[0]) + ((orc_uint32) var46.x2[0]);
+    var71.x2[1] = ((orc_uint32) var70.x2[1]) + ((orc_uint32) var46.x2[1]);
+    /* 25: shrul */
+    var72.x2[0] = ((orc_uint32) var71.x2[0]) >> 3;
+    var72.x2[1] = ((orc_uint32) var71.x2[1]) >> 3;
+    /* 26: convsuslw */
+    var73.x2[0] = ORC_CLAMP_UW (var72.x2[0]);
+    var73.x2[1] = ORC_CLAMP_UW (var72.x2[1]);
+    /* 27: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var57.i;
+      _dest.x2[1] = var73.i;
+      var50.i = _dest.i;
+    }
+    /* 28: storeq */
+    ptr1[i] = var50;
+    /* 29: mulll */
+    var74.x2[0] =
+        (((orc_uint32) var55.x2[0]) * ((orc_uint32) var48.x2[0])) & 0xffffffff;
+    var74.x2[1] =
+        (((orc_uint32) var55.x2[1]) * ((orc_uint32) var48.x2[1])) & 0xffffffff;
+    /* 30: mulll */
+    var75.x2[0] =
+        (((orc_uint32) var60.x2[0]) * ((orc_uint32) var47.x2[0])) & 0xffffffff;
+    var75.x2[1] =
+        (((orc_uint32) var60.x2[1]) * ((orc_uint32) var47.x2[1])) & 0xffffffff;
+    /* 31: addl */
+    var76.x2[0] = ((orc_uint32) var74.x2[0]) + ((orc_uint32) var75.x2[0]);
+    var76.x2[1] = ((orc_uint32) var74.x2[1]) + ((orc_uint32) var75.x2[1]);
+    /* 32: addl */
+    var77.x2[0] = ((orc_uint32) var76.x2[0]) + ((orc_uint32) var46.x2[0]);
+    var77.x2[1] = ((orc_uint32) var76.x2[1]) + ((orc_uint32) var46.x2[1]);
+    /* 33: shrul */
+    var78.x2[0] = ((orc_uint32) var77.x2[0]) >> 3;
+    var78.x2[1] = ((orc_uint32) var77.x2[1]) >> 3;
+    /* 34: convsuslw */
+    var79.x2[0] = ORC_CLAMP_UW (var78.x2[0]);
+    var79.x2[1] = ORC_CLAMP_UW (var78.x2[1]);
+    /* 35: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var59.i;
+      _dest.x2[1] = var79.i;
+      var51.i = _dest.i;
+    }
+    /* 36: storeq */
+    ptr2[i] = var51;
+    /* 37: mulll */
+    var80.x2[0] =
+        (((orc_uint32) var60.x2[0]) * ((orc_uint32) var45.x2[0])) & 0xffffffff;
+    var80.x2[1] =
+        (((orc_uint32) var60.x2[1]) * ((orc_uint32) var45.x2[1])) & 0xffffffff;
+    /* 38: addl */
+    var81.x2[0] = ((orc_uint32) var80.x2[0]) + ((orc_uint32) var55.x2[0]);
+    var81.x2[1] = ((orc_uint32) var80.x2[1]) + ((orc_uint32) var55.x2[1]);
+    /* 39: addl */
+    var82.x2[0] = ((orc_uint32) var81.x2[0]) + ((orc_uint32) var46.x2[0]);
+    var82.x2[1] = ((orc_uint32) var81.x2[1]) + ((orc_uint32) var46.x2[1]);
+    /* 40: shrul */
+    var83.x2[0] = ((orc_uint32) var82.x2[0]) >> 3;
+    var83.x2[1] = ((orc_uint32) var82.x2[1]) >> 3;
+    /* 41: convsuslw */
+    var84.x2[0] = ORC_CLAMP_UW (var83.x2[0]);
+    var84.x2[1] = ORC_CLAMP_UW (var83.x2[1]);
+    /* 42: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var62.i;
+      _dest.x2[1] = var84.i;
+      var52.i = _dest.i;
+    }
+    /* 43: storeq */
+    ptr3[i] = var52;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_up_v4_u16 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union64 *ORC_RESTRICT ptr0;
+  orc_union64 *ORC_RESTRICT ptr1;
+  orc_union64 *ORC_RESTRICT ptr2;
+  orc_union64 *ORC_RESTRICT ptr3;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  const orc_union64 *ORC_RESTRICT ptr6;
+  const orc_union64 *ORC_RESTRICT ptr7;
+  orc_union64 var41;
+  orc_union64 var42;
+  orc_union64 var43;
+  orc_union64 var44;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var45;
+#else
+  orc_union64 var45;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var46;
+#else
+  orc_union64 var46;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var47;
+#else
+  orc_union64 var47;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var48;
+#else
+  orc_union64 var48;
+#endif
+  orc_union64 var49;
+  orc_union64 var50;
+  orc_union64 var51;
+  orc_union64 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union64 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union64 var60;
+  orc_union32 var61;
+  orc_union32 var62;
+  orc_union64 var63;
+  orc_union64 var64;
+  orc_union64 var65;
+  orc_union64 var66;
+  orc_union32 var67;
+  orc_union64 var68;
+  orc_union64 var69;
+  orc_union64 var70;
+  orc_union64 var71;
+  orc_union64 var72;
+  orc_union32 var73;
+  orc_union64 var74;
+  orc_union64 var75;
+  orc_union64 var76;
+  orc_union64 var77;
+  orc_union64 var78;
+  orc_union32 var79;
+  orc_union64 var80;
+  orc_union64 var81;
+  orc_union64 var82;
+  orc_union64 var83;
+  orc_union32 var84;
+
+  ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr1 = (orc_union64 *) ex->arrays[1];
+  ptr2 = (orc_union64 *) ex->arrays[2];
+  ptr3 = (orc_union64 *) ex->arrays[3];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+  ptr5 = (orc_union64 *) ex->arrays[5];
+  ptr6 = (orc_union64 *) ex->arrays[6];
+  ptr7 = (orc_union64 *) ex->arrays[7];
+
+  /* 10: loadpl */
+  var45.x2[0] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+  var45.x2[1] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+  /* 13: loadpl */
+  var46.x2[0] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  var46.x2[1] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  /* 19: loadpl */
+  var47.x2[0] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  var47.x2[1] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  /* 21: loadpl */
+  var48.x2[0] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+  var48.x2[1] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var41 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var41.i;
+      var53.i = _src.x2[1];
+      var54.i = _src.x2[0];
+    }
+    /* 2: convuwl */
+    var55.x2[0] = (orc_uint16) var53.x2[0];
+    var55.x2[1] = (orc_uint16) var53.x2[1];
+    /* 3: loadq */
+    var42 = ptr5[i];
+    /* 4: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var42.i;
+      var56.i = _src.x2[1];
+      var57.i = _src.x2[0];
+    }
+    /* 5: loadq */
+    var43 = ptr6[i];
+    /* 6: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var43.i;
+      var58.i = _src.x2[1];
+      var59.i = _src.x2[0];
+    }
+    /* 7: convuwl */
+    var60.x2[0] = (orc_uint16) var58.x2[0];
+    var60.x2[1] = (orc_uint16) var58.x2[1];
+    /* 8: loadq */
+    var44 = ptr7[i];
+    /* 9: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var44.i;
+      var61.i = _src.x2[1];
+      var62.i = _src.x2[0];
+    }
+    /* 11: mulll */
+    var63.x2[0] =
+        (((orc_uint32) var55.x2[0]) * ((orc_uint32) var45.x2[0])) & 0xffffffff;
+    var63.x2[1] =
+        (((orc_uint32) var55.x2[1]) * ((orc_uint32) var45.x2[1])) & 0xffffffff;
+    /* 12: addl */
+    var64.x2[0] = ((orc_uint32) var63.x2[0]) + ((orc_uint32) var60.x2[0]);
+    var64.x2[1] = ((orc_uint32) var63.x2[1]) + ((orc_uint32) var60.x2[1]);
+    /* 14: addl */
+    var65.x2[0] = ((orc_uint32) var64.x2[0]) + ((orc_uint32) var46.x2[0]);
+    var65.x2[1] = ((orc_uint32) var64.x2[1]) + ((orc_uint32) var46.x2[1]);
+    /* 15: shrul */
+    var66.x2[0] = ((orc_uint32) var65.x2[0]) >> 3;
+    var66.x2[1] = ((orc_uint32) var65.x2[1]) >> 3;
+    /* 16: convsuslw */
+    var67.x2[0] = ORC_CLAMP_UW (var66.x2[0]);
+    var67.x2[1] = ORC_CLAMP_UW (var66.x2[1]);
+    /* 17: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var54.i;
+      _dest.x2[1] = var67.i;
+      var49.i = _dest.i;
+    }
+    /* 18: storeq */
+    ptr0[i] = var49;
+    /* 20: mulll */
+    var68.x2[0] =
+        (((orc_uint32) var55.x2[0]) * ((orc_uint32) var47.x2[0])) & 0xffffffff;
+    var68.x2[1] =
+        (((orc_uint32) var55.x2[1]) * ((orc_uint32) var47.x2[1])) & 0xffffffff;
+    /* 22: mulll */
+    var69.x2[0] =
+        (((orc_uint32) var60.x2[0]) * ((orc_uint32) var48.x2[0])) & 0xffffffff;
+    var69.x2[1] =
+        (((orc_uint32) var60.x2[1]) * ((orc_uint32) var48.x2[1])) & 0xffffffff;
+    /* 23: addl */
+    var70.x2[0] = ((orc_uint32) var68.x2[0]) + ((orc_uint32) var69.x2[0]);
+    var70.x2[1] = ((orc_uint32) var68.x2[1]) + ((orc_uint32) var69.x2[1]);
+    /* 24: addl */
+    var71.x2[0] = ((orc_uint32) var70.x2[0]) + ((orc_uint32) var46.x2[0]);
+    var71.x2[1] = ((orc_uint32) var70.x2[1]) + ((orc_uint32) var46.x2[1]);
+    /* 25: shrul */
+    var72.x2[0] = ((orc_uint32) var71.x2[0]) >> 3;
+    var72.x2[1] = ((orc_uint32) var71.x2[1]) >> 3;
+    /* 26: convsuslw */
+    var73.x2[0] = ORC_CLAMP_UW (var72.x2[0]);
+    var73.x2[1] = ORC_CLAMP_UW (var72.x2[1]);
+    /* 27: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var57.i;
+      _dest.x2[1] = var73.i;
+      var50.i = _dest.i;
+    }
+    /* 28: storeq */
+    ptr1[i] = var50;
+    /* 29: mulll */
+    var74.x2[0] =
+        (((orc_uint32) var55.x2[0]) * ((orc_uint32) var48.x2[0])) & 0xffffffff;
+    var74.x2[1] =
+        (((orc_uint32) var55.x2[1]) * ((orc_uint32) var48.x2[1])) & 0xffffffff;
+    /* 30: mulll */
+    var75.x2[0] =
+        (((orc_uint32) var60.x2[0]) * ((orc_uint32) var47.x2[0])) & 0xffffffff;
+    var75.x2[1] =
+        (((orc_uint32) var60.x2[1]) * ((orc_uint32) var47.x2[1])) & 0xffffffff;
+    /* 31: addl */
+    var76.x2[0] = ((orc_uint32) var74.x2[0]) + ((orc_uint32) var75.x2[0]);
+    var76.x2[1] = ((orc_uint32) var74.x2[1]) + ((orc_uint32) var75.x2[1]);
+    /* 32: addl */
+    var77.x2[0] = ((orc_uint32) var76.x2[0]) + ((orc_uint32) var46.x2[0]);
+    var77.x2[1] = ((orc_uint32) var76.x2[1]) + ((orc_uint32) var46.x2[1]);
+    /* 33: shrul */
+    var78.x2[0] = ((orc_uint32) var77.x2[0]) >> 3;
+    var78.x2[1] = ((orc_uint32) var77.x2[1]) >> 3;
+    /* 34: convsuslw */
+    var79.x2[0] = ORC_CLAMP_UW (var78.x2[0]);
+    var79.x2[1] = ORC_CLAMP_UW (var78.x2[1]);
+    /* 35: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var59.i;
+      _dest.x2[1] = var79.i;
+      var51.i = _dest.i;
+    }
+    /* 36: storeq */
+    ptr2[i] = var51;
+    /* 37: mulll */
+    var80.x2[0] =
+        (((orc_uint32) var60.x2[0]) * ((orc_uint32) var45.x2[0])) & 0xffffffff;
+    var80.x2[1] =
+        (((orc_uint32) var60.x2[1]) * ((orc_uint32) var45.x2[1])) & 0xffffffff;
+    /* 38: addl */
+    var81.x2[0] = ((orc_uint32) var80.x2[0]) + ((orc_uint32) var55.x2[0]);
+    var81.x2[1] = ((orc_uint32) var80.x2[1]) + ((orc_uint32) var55.x2[1]);
+    /* 39: addl */
+    var82.x2[0] = ((orc_uint32) var81.x2[0]) + ((orc_uint32) var46.x2[0]);
+    var82.x2[1] = ((orc_uint32) var81.x2[1]) + ((orc_uint32) var46.x2[1]);
+    /* 40: shrul */
+    var83.x2[0] = ((orc_uint32) var82.x2[0]) >> 3;
+    var83.x2[1] = ((orc_uint32) var82.x2[1]) >> 3;
+    /* 41: convsuslw */
+    var84.x2[0] = ORC_CLAMP_UW (var83.x2[0]);
+    var84.x2[1] = ORC_CLAMP_UW (var83.x2[1]);
+    /* 42: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var62.i;
+      _dest.x2[1] = var84.i;
+      var52.i = _dest.i;
+    }
+    /* 43: storeq */
+    ptr3[i] = var52;
+  }
+
+}
+
+void
+video_orc_chroma_up_v4_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 26, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 117, 112, 95, 118, 52, 95, 117, 49, 54, 11, 8, 8,
+        11, 8, 8, 11, 8, 8, 11, 8, 8, 12, 8, 8, 12, 8, 8, 12,
+        8, 8, 12, 8, 8, 14, 4, 7, 0, 0, 0, 14, 4, 4, 0, 0,
+        0, 14, 4, 3, 0, 0, 0, 14, 4, 5, 0, 0, 0, 20, 4, 20,
+        4, 20, 4, 20, 4, 20, 4, 20, 8, 20, 8, 20, 8, 20, 8, 197,
+        36, 32, 4, 21, 1, 154, 37, 36, 197, 36, 33, 5, 197, 36, 34, 6,
+        21, 1, 154, 38, 36, 197, 36, 35, 7, 21, 1, 120, 39, 37, 16, 21,
+        1, 103, 39, 39, 38, 21, 1, 103, 39, 39, 17, 21, 1, 126, 39, 39,
+        18, 21, 1, 166, 36, 39, 194, 0, 32, 36, 21, 1, 120, 39, 37, 19,
+        21, 1, 120, 40, 38, 18, 21, 1, 103, 39, 39, 40, 21, 1, 103, 39,
+        39, 17, 21, 1, 126, 39, 39, 18, 21, 1, 166, 36, 39, 194, 1, 33,
+        36, 21, 1, 120, 39, 37, 18, 21, 1, 120, 40, 38, 19, 21, 1, 103,
+        39, 39, 40, 21, 1, 103, 39, 39, 17, 21, 1, 126, 39, 39, 18, 21,
+        1, 166, 36, 39, 194, 2, 34, 36, 21, 1, 120, 39, 38, 16, 21, 1,
+        103, 39, 39, 37, 21, 1, 103, 39, 39, 17, 21, 1, 126, 39, 39, 18,
+        21, 1, 166, 36, 39, 194, 3, 35, 36, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_v4_u16);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_up_v4_u16");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_v4_u16);
+      orc_program_add_destination (p, 8, "d1");
+      orc_program_add_destination (p, 8, "d2");
+      orc_program_add_destination (p, 8, "d3");
+      orc_program_add_destination (p, 8, "d4");
+      orc_program_add_source (p, 8, "s1");
+      orc_program_add_source (p, 8, "s2");
+      orc_program_add_source (p, 8, "s3");
+      orc_program_add_source (p, 8, "s4");
+      orc_program_add_constant (p, 4, 0x00000007, "c1");
+      orc_program_add_constant (p, 4, 0x00000004, "c2");
+      orc_program_add_constant (p, 4, 0x00000003, "c3");
+      orc_program_add_constant (p, 4, 0x00000005, "c4");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+      orc_program_add_temporary (p, 4, "t4");
+      orc_program_add_temporary (p, 4, "t5");
+      orc_program_add_temporary (p, 8, "t6");
+      orc_program_add_temporary (p, 8, "t7");
+      orc_program_add_temporary (p, 8, "t8");
+      orc_program_add_temporary (p, 8, "t9");
+
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T5, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T6, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T5, ORC_VAR_T2, ORC_VAR_S2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_S3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T5, ORC_VAR_T4, ORC_VAR_S4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T5, ORC_VAR_T8,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T9, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T5, ORC_VAR_T8,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D2, ORC_VAR_T2, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T9, ORC_VAR_T7, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T5, ORC_VAR_T8,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D3, ORC_VAR_T3, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T8, ORC_VAR_T7, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T5, ORC_VAR_T8,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D4, ORC_VAR_T4, ORC_VAR_T5,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_D3] = d3;
+  ex->arrays[ORC_VAR_D4] = d4;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_chroma_up_vi2_u8 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_up_vi2_u8 (guint8 * ORC_RESTRICT d1,
+    guint8 * ORC_RESTRICT d2, guint8 * ORC_RESTRICT d3,
+    guint8 * ORC_RESTRICT d4, const guint8 * ORC_RESTRICT s1,
+    const guint8 * ORC_RESTRICT s2, const guint8 * ORC_RESTRICT s3,
+    const guint8 * ORC_RESTRICT s4, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 *ORC_RESTRICT ptr1;
+  orc_union32 *ORC_RESTRICT ptr2;
+  orc_union32 *ORC_RESTRICT ptr3;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  const orc_union32 *ORC_RESTRICT ptr6;
+  const orc_union32 *ORC_RESTRICT ptr7;
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union32 var45;
+  orc_union32 var46;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var47;
+#else
+  orc_union32 var47;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var48;
+#else
+  orc_union32 var48;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var49;
+#else
+  orc_union32 var49;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var50;
+#else
+  orc_union32 var50;
+#endif
+  orc_union32 var51;
+  orc_union32 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union16 var55;
+  orc_union16 var56;
+  orc_union32 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union32 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union32 var63;
+  orc_union16 var64;
+  orc_union16 var65;
+  orc_union32 var66;
+  orc_union32 var67;
+  orc_union32 var68;
+  orc_union32 var69;
+  orc_union32 var70;
+  orc_union32 var71;
+  orc_union16 var72;
+  orc_union32 var73;
+  orc_union32 var74;
+  orc_union32 var75;
+  orc_union32 var76;
+  orc_union16 var77;
+  orc_union32 var78;
+  orc_union32 var79;
+  orc_union32 var80;
+  orc_union32 var81;
+  orc_union16 var82;
+  orc_union32 var83;
+  orc_union32 var84;
+  orc_union32 var85;
+  orc_union32 var86;
+  orc_union32 var87;
+  orc_union16 var88;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr1 = (orc_union32 *) d2;
+  ptr2 = (orc_union32 *) d3;
+  ptr3 = (orc_union32 *) d4;
+  ptr4 = (orc_union32 *) s1;
+  ptr5 = (orc_union32 *) s2;
+  ptr6 = (orc_union32 *) s3;
+  ptr7 = (orc_union32 *) s4;
+
+  /* 12: loadpw */
+  var47.x2[0] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  var47.x2[1] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  /* 14: loadpw */
+  var48.x2[0] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+  var48.x2[1] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+  /* 17: loadpw */
+  var49.x2[0] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  var49.x2[1] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  /* 23: loadpw */
+  var50.x2[0] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+  var50.x2[1] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var43 = ptr4[i];
+    /* 1: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var43.i;
+      var55.i = _src.x2[1];
+      var56.i = _src.x2[0];
+    }
+    /* 2: convubw */
+    var57.x2[0] = (orc_uint8) var55.x2[0];
+    var57.x2[1] = (orc_uint8) var55.x2[1];
+    /* 3: loadl */
+    var44 = ptr5[i];
+    /* 4: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var44.i;
+      var58.i = _src.x2[1];
+      var59.i = _src.x2[0];
+    }
+    /* 5: convubw */
+    var60.x2[0] = (orc_uint8) var58.x2[0];
+    var60.x2[1] = (orc_uint8) var58.x2[1];
+    /* 6: loadl */
+    var45 = ptr6[i];
+    /* 7: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var45.i;
+      var61.i = _src.x2[1];
+      var62.i = _src.x2[0];
+    }
+    /* 8: convubw */
+    var63.x2[0] = (orc_uint8) var61.x2[0];
+    var63.x2[1] = (orc_uint8) var61.x2[1];
+    /* 9: loadl */
+    var46 = ptr7[i];
+    /* 10: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var46.i;
+      var64.i = _src.x2[1];
+      var65.i = _src.x2[0];
+    }
+    /* 11: convubw */
+    var66.x2[0] = (orc_uint8) var64.x2[0];
+    var66.x2[1] = (orc_uint8) var64.x2[1];
+    /* 13: mullw */
+    var67.x2[0] = (var57.x2[0] * var47.x2[0]) & 0xffff;
+    var67.x2[1] = (var57.x2[1] * var47.x2[1]) & 0xffff;
+    /* 15: mullw */
+    var68.x2[0] = (var63.x2[0] * var48.x2[0]) & 0xffff;
+    var68.x2[1] = (var63.x2[1] * var48.x2[1]) & 0xffff;
+    /* 16: addw */
+    var69.x2[0] = var67.x2[0] + var68.x2[0];
+    var69.x2[1] = var67.x2[1] + var68.x2[1];
+    /* 18: addw */
+    var70.x2[0] = var69.x2[0] + var49.x2[0];
+    var70.x2[1] = var69.x2[1] + var49.x2[1];
+    /* 19: shruw */
+    var71.x2[0] = ((orc_uint16) var70.x2[0]) >> 3;
+    var71.x2[1] = ((orc_uint16) var70.x2[1]) >> 3;
+    /* 20: convsuswb */
+    var72.x2[0] = ORC_CLAMP_UB (var71.x2[0]);
+    var72.x2[1] = ORC_CLAMP_UB (var71.x2[1]);
+    /* 21: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var56.i;
+      _dest.x2[1] = var72.i;
+      var51.i = _dest.i;
+    }
+    /* 22: storel */
+    ptr0[i] = var51;
+    /* 24: mullw */
+    var73.x2[0] = (var60.x2[0] * var50.x2[0]) & 0xffff;
+    var73.x2[1] = (var60.x2[1] * var50.x2[1]) & 0xffff;
+    /* 25: addw */
+    var74.x2[0] = var73.x2[0] + var66.x2[0];
+    var74.x2[1] = var73.x2[1] + var66.x2[1];
+    /* 26: addw */
+    var75.x2[0] = var74.x2[0] + var49.x2[0];
+    var75.x2[1] = var74.x2[1] + var49.x2[1];
+    /* 27: shruw */
+    var76.x2[0] = ((orc_uint16) var75.x2[0]) >> 3;
+    var76.x2[1] = ((orc_uint16) var75.x2[1]) >> 3;
+    /* 28: convsuswb */
+    var77.x2[0] = ORC_CLAMP_UB (var76.x2[0]);
+    var77.x2[1] = ORC_CLAMP_UB (var76.x2[1]);
+    /* 29: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var59.i;
+      _dest.x2[1] = var77.i;
+      var52.i = _dest.i;
+    }
+    /* 30: storel */
+    ptr1[i] = var52;
+    /* 31: mullw */
+    var78.x2[0] = (var63.x2[0] * var50.x2[0]) & 0xffff;
+    var78.x2[1] = (var63.x2[1] * var50.x2[1]) & 0xffff;
+    /* 32: addw */
+    var79.x2[0] = var78.x2[0] + var57.x2[0];
+    var79.x2[1] = var78.x2[1] + var57.x2[1];
+    /* 33: addw */
+    var80.x2[0] = var79.x2[0] + var49.x2[0];
+    var80.x2[1] = var79.x2[1] + var49.x2[1];
+    /* 34: shruw */
+    var81.x2[0] = ((orc_uint16) var80.x2[0]) >> 3;
+    var81.x2[1] = ((orc_uint16) var80.x2[1]) >> 3;
+    /* 35: convsuswb */
+    var82.x2[0] = ORC_CLAMP_UB (var81.x2[0]);
+    var82.x2[1] = ORC_CLAMP_UB (var81.x2[1]);
+    /* 36: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var62.i;
+      _dest.x2[1] = var82.i;
+      var53.i = _dest.i;
+    }
+    /* 37: storel */
+    ptr2[i] = var53;
+    /* 38: mullw */
+    var83.x2[0] = (var60.x2[0] * var48.x2[0]) & 0xffff;
+    var83.x2[1] = (var60.x2[1] * var48.x2[1]) & 0xffff;
+    /* 39: mullw */
+    var84.x2[0] = (var66.x2[0] * var47.x2[0]) & 0xffff;
+    var84.x2[1] = (var66.x2[1] * var47.x2[1]) & 0xffff;
+    /* 40: addw */
+    var85.x2[0] = var83.x2[0] + var84.x2[0];
+    var85.x2[1] = var83.x2[1] + var84.x2[1];
+    /* 41: addw */
+    var86.x2[0] = var85.x2[0] + var49.x2[0];
+    var86.x2[1] = var85.x2[1] + var49.x2[1];
+    /* 42: shruw */
+    var87.x2[0] = ((orc_uint16) var86.x2[0]) >> 3;
+    var87.x2[1] = ((orc_uint16) var86.x2[1]) >> 3;
+    /* 43: convsuswb */
+    var88.x2[0] = ORC_CLAMP_UB (var87.x2[0]);
+    var88.x2[1] = ORC_CLAMP_UB (var87.x2[1]);
+    /* 44: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var65.i;
+      _dest.x2[1] = var88.i;
+      var54.i = _dest.i;
+    }
+    /* 45: storel */
+    ptr3[i] = var54;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_up_vi2_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 *ORC_RESTRICT ptr1;
+  orc_union32 *ORC_RESTRICT ptr2;
+  orc_union32 *ORC_RESTRICT ptr3;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  const orc_union32 *ORC_RESTRICT ptr6;
+  const orc_union32 *ORC_RESTRICT ptr7;
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union32 var45;
+  orc_union32 var46;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var47;
+#else
+  orc_union32 var47;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var48;
+#else
+  orc_union32 var48;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var49;
+#else
+  orc_union32 var49;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var50;
+#else
+  orc_union32 var50;
+#endif
+  orc_union32 var51;
+  orc_union32 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union16 var55;
+  orc_union16 var56;
+  orc_union32 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union32 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union32 var63;
+  orc_union16 var64;
+  orc_union16 var65;
+  orc_union32 var66;
+  orc_union32 var67;
+  orc_union32 var68;
+  orc_union32 var69;
+  orc_union32 var70;
+  orc_union32 var71;
+  orc_union16 var72;
+  orc_union32 var73;
+  orc_union32 var74;
+  orc_union32 var75;
+  orc_union32 var76;
+  orc_union16 var77;
+  orc_union32 var78;
+  orc_union32 var79;
+  orc_union32 var80;
+  orc_union32 var81;
+  orc_union16 var82;
+  orc_union32 var83;
+  orc_union32 var84;
+  orc_union32 var85;
+  orc_union32 var86;
+  orc_union32 var87;
+  orc_union16 var88;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr1 = (orc_union32 *) ex->arrays[1];
+  ptr2 = (orc_union32 *) ex->arrays[2];
+  ptr3 = (orc_union32 *) ex->arrays[3];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+  ptr5 = (orc_union32 *) ex->arrays[5];
+  ptr6 = (orc_union32 *) ex->arrays[6];
+  ptr7 = (orc_union32 *) ex->arrays[7];
+
+  /* 12: loadpw */
+  var47.x2[0] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  var47.x2[1] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  /* 14: loadpw */
+  var48.x2[0] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+  var48.x2[1] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+  /* 17: loadpw */
+  var49.x2[0] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  var49.x2[1] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  /* 23: loadpw */
+  var50.x2[0] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+  var50.x2[1] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var43 = ptr4[i];
+    /* 1: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var43.i;
+      var55.i = _src.x2[1];
+      var56.i = _src.x2[0];
+    }
+    /* 2: convubw */
+    var57.x2[0] = (orc_uint8) var55.x2[0];
+    var57.x2[1] = (orc_uint8) var55.x2[1];
+    /* 3: loadl */
+    var44 = ptr5[i];
+    /* 4: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var44.i;
+      var58.i = _src.x2[1];
+      var59.i = _src.x2[0];
+    }
+    /* 5: convubw */
+    var60.x2[0] = (orc_uint8) var58.x2[0];
+    var60.x2[1] = (orc_uint8) var58.x2[1];
+    /* 6: loadl */
+    var45 = ptr6[i];
+    /* 7: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var45.i;
+      var61.i = _src.x2[1];
+      var62.i = _src.x2[0];
+    }
+    /* 8: convubw */
+    var63.x2[0] = (orc_uint8) var61.x2[0];
+    var63.x2[1] = (orc_uint8) var61.x2[1];
+    /* 9: loadl */
+    var46 = ptr7[i];
+    /* 10: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var46.i;
+      var64.i = _src.x2[1];
+      var65.i = _src.x2[0];
+    }
+    /* 11: convubw */
+    var66.x2[0] = (orc_uint8) var64.x2[0];
+    var66.x2[1] = (orc_uint8) var64.x2[1];
+    /* 13: mullw */
+    var67.x2[0] = (var57.x2[0] * var47.x2[0]) & 0xffff;
+    var67.x2[1] = (var57.x2[1] * var47.x2[1]) & 0xffff;
+    /* 15: mullw */
+    var68.x2[0] = (var63.x2[0] * var48.x2[0]) & 0xffff;
+    var68.x2[1] = (var63.x2[1] * var48.x2[1]) & 0xffff;
+    /* 16: addw */
+    var69.x2[0] = var67.x2[0] + var68.x2[0];
+    var69.x2[1] = var67.x2[1] + var68.x2[1];
+    /* 18: addw */
+    var70.x2[0] = var69.x2[0] + var49.x2[0];
+    var70.x2[1] = var69.x2[1] + var49.x2[1];
+    /* 19: shruw */
+    var71.x2[0] = ((orc_uint16) var70.x2[0]) >> 3;
+    var71.x2[1] = ((orc_uint16) var70.x2[1]) >> 3;
+    /* 20: convsuswb */
+    var72.x2[0] = ORC_CLAMP_UB (var71.x2[0]);
+    var72.x2[1] = ORC_CLAMP_UB (var71.x2[1]);
+    /* 21: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var56.i;
+      _dest.x2[1] = var72.i;
+      var51.i = _dest.i;
+    }
+    /* 22: storel */
+    ptr0[i] = var51;
+    /* 24: mullw */
+    var73.x2[0] = (var60.x2[0] * var50.x2[0]) & 0xffff;
+    var73.x2[1] = (var60.x2[1] * var50.x2[1]) & 0xffff;
+    /* 25: addw */
+    var74.x2[0] = var73.x2[0] + var66.x2[0];
+    var74.x2[1] = var73.x2[1] + var66.x2[1];
+    /* 26: addw */
+    var75.x2[0] = var74.x2[0] + var49.x2[0];
+    var75.x2[1] = var74.x2[1] + var49.x2[1];
+    /* 27: shruw */
+    var76.x2[0] = ((orc_uint16) var75.x2[0]) >> 3;
+    var76.x2[1] = ((orc_uint16) var75.x2[1]) >> 3;
+    /* 28: convsuswb */
+    var77.x2[0] = ORC_CLAMP_UB (var76.x2[0]);
+    var77.x2[1] = ORC_CLAMP_UB (var76.x2[1]);
+    /* 29: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var59.i;
+      _dest.x2[1] = var77.i;
+      var52.i = _dest.i;
+    }
+    /* 30: storel */
+    ptr1[i] = var52;
+    /* 31: mullw */
+    var78.x2[0] = (var63.x2[0] * var50.x2[0]) & 0xffff;
+    var78.x2[1] = (var63.x2[1] * var50.x2[1]) & 0xffff;
+    /* 32: addw */
+    var79.x2[0] = var78.x2[0] + var57.x2[0];
+    var79.x2[1] = var78.x2[1] + var57.x2[1];
+    /* 33: addw */
+    var80.x2[0] = var79.x2[0] + var49.x2[0];
+    var80.x2[1] = var79.x2[1] + var49.x2[1];
+    /* 34: shruw */
+    var81.x2[0] = ((orc_uint16) var80.x2[0]) >> 3;
+    var81.x2[1] = ((orc_uint16) var80.x2[1]) >> 3;
+    /* 35: convsuswb */
+    var82.x2[0] = ORC_CLAMP_UB (var81.x2[0]);
+    var82.x2[1] = ORC_CLAMP_UB (var81.x2[1]);
+    /* 36: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var62.i;
+      _dest.x2[1] = var82.i;
+      var53.i = _dest.i;
+    }
+    /* 37: storel */
+    ptr2[i] = var53;
+    /* 38: mullw */
+    var83.x2[0] = (var60.x2[0] * var48.x2[0]) & 0xffff;
+    var83.x2[1] = (var60.x2[1] * var48.x2[1]) & 0xffff;
+    /* 39: mullw */
+    var84.x2[0] = (var66.x2[0] * var47.x2[0]) & 0xffff;
+    var84.x2[1] = (var66.x2[1] * var47.x2[1]) & 0xffff;
+    /* 40: addw */
+    var85.x2[0] = var83.x2[0] + var84.x2[0];
+    var85.x2[1] = var83.x2[1] + var84.x2[1];
+    /* 41: addw */
+    var86.x2[0] = var85.x2[0] + var49.x2[0];
+    var86.x2[1] = var85.x2[1] + var49.x2[1];
+    /* 42: shruw */
+    var87.x2[0] = ((orc_uint16) var86.x2[0]) >> 3;
+    var87.x2[1] = ((orc_uint16) var86.x2[1]) >> 3;
+    /* 43: convsuswb */
+    var88.x2[0] = ORC_CLAMP_UB (var87.x2[0]);
+    var88.x2[1] = ORC_CLAMP_UB (var87.x2[1]);
+    /* 44: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var65.i;
+      _dest.x2[1] = var88.i;
+      var54.i = _dest.i;
+    }
+    /* 45: storel */
+    ptr3[i] = var54;
+  }
+
+}
+
+void
+video_orc_chroma_up_vi2_u8 (guint8 * ORC_RESTRICT d1,
+    guint8 * ORC_RESTRICT d2, guint8 * ORC_RESTRICT d3,
+    guint8 * ORC_RESTRICT d4, const guint8 * ORC_RESTRICT s1,
+    const guint8 * ORC_RESTRICT s2, const guint8 * ORC_RESTRICT s3,
+    const guint8 * ORC_RESTRICT s4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 26, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 117, 112, 95, 118, 105, 50, 95, 117, 56, 11, 4, 4,
+        11, 4, 4, 11, 4, 4, 11, 4, 4, 12, 4, 4, 12, 4, 4, 12,
+        4, 4, 12, 4, 4, 14, 2, 5, 0, 0, 0, 14, 2, 3, 0, 0,
+        0, 14, 2, 4, 0, 0, 0, 14, 2, 7, 0, 0, 0, 20, 2, 20,
+        2, 20, 2, 20, 2, 20, 2, 20, 4, 20, 4, 20, 4, 20, 4, 20,
+        4, 20, 4, 198, 36, 32, 4, 21, 1, 150, 37, 36, 198, 36, 33, 5,
+        21, 1, 150, 38, 36, 198, 36, 34, 6, 21, 1, 150, 39, 36, 198, 36,
+        35, 7, 21, 1, 150, 40, 36, 21, 1, 89, 41, 37, 16, 21, 1, 89,
+        42, 39, 17, 21, 1, 70, 41, 41, 42, 21, 1, 70, 41, 41, 18, 21,
+        1, 95, 41, 41, 17, 21, 1, 160, 36, 41, 195, 0, 32, 36, 21, 1,
+        89, 41, 38, 19, 21, 1, 70, 41, 41, 40, 21, 1, 70, 41, 41, 18,
+        21, 1, 95, 41, 41, 17, 21, 1, 160, 36, 41, 195, 1, 33, 36, 21,
+        1, 89, 41, 39, 19, 21, 1, 70, 41, 41, 37, 21, 1, 70, 41, 41,
+        18, 21, 1, 95, 41, 41, 17, 21, 1, 160, 36, 41, 195, 2, 34, 36,
+        21, 1, 89, 41, 38, 17, 21, 1, 89, 42, 40, 16, 21, 1, 70, 41,
+        41, 42, 21, 1, 70, 41, 41, 18, 21, 1, 95, 41, 41, 17, 21, 1,
+        160, 36, 41, 195, 3, 35, 36, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_vi2_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_up_vi2_u8");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_vi2_u8);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_destination (p, 4, "d2");
+      orc_program_add_destination (p, 4, "d3");
+      orc_program_add_destination (p, 4, "d4");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_source (p, 4, "s2");
+      orc_program_add_source (p, 4, "s3");
+      orc_program_add_source (p, 4, "s4");
+      orc_program_add_constant (p, 2, 0x00000005, "c1");
+      orc_program_add_constant (p, 2, 0x00000003, "c2");
+      orc_program_add_constant (p, 2, 0x00000004, "c3");
+      orc_program_add_constant (p, 2, 0x00000007, "c4");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+      orc_program_add_temporary (p, 4, "t6");
+      orc_program_add_temporary (p, 4, "t7");
+      orc_program_add_temporary (p, 4, "t8");
+      orc_program_add_temporary (p, 4, "t9");
+      orc_program_add_temporary (p, 4, "t10");
+      orc_program_add_temporary (p, 4, "t11");
+
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T5, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T6, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T5, ORC_VAR_T2, ORC_VAR_S2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_S3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T8, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T5, ORC_VAR_T4, ORC_VAR_S4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T9, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T10, ORC_VAR_T6, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T11, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_T11,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T5, ORC_VAR_T10,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T10, ORC_VAR_T7, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T5, ORC_VAR_T10,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D2, ORC_VAR_T2, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T10, ORC_VAR_T8, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T5, ORC_VAR_T10,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D3, ORC_VAR_T3, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T10, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T11, ORC_VAR_T9, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_T11,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T5, ORC_VAR_T10,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D4, ORC_VAR_T4, ORC_VAR_T5,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_D3] = d3;
+  ex->arrays[ORC_VAR_D4] = d4;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_chroma_up_vi2_u16 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_up_vi2_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n)
+{
+  int i;
+  orc_union64 *ORC_RESTRICT ptr0;
+  orc_union64 *ORC_RESTRICT ptr1;
+  orc_union64 *ORC_RESTRICT ptr2;
+  orc_union64 *ORC_RESTRICT ptr3;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  const orc_union64 *ORC_RESTRICT ptr6;
+  const orc_union64 *ORC_RESTRICT ptr7;
+  orc_union64 var43;
+  orc_union64 var44;
+  orc_union64 var45;
+  orc_union64 var46;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var47;
+#else
+  orc_union64 var47;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var48;
+#else
+  orc_union64 var48;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var49;
+#else
+  orc_union64 var49;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var50;
+#else
+  orc_union64 var50;
+#endif
+  orc_union64 var51;
+  orc_union64 var52;
+  orc_union64 var53;
+  orc_union64 var54;
+  orc_union32 var55;
+  orc_union32 var56;
+  orc_union64 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union64 var60;
+  orc_union32 var61;
+  orc_union32 var62;
+  orc_union64 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union64 var66;
+  orc_union64 var67;
+  orc_union64 var68;
+  orc_union64 var69;
+  orc_union64 var70;
+  orc_union64 var71;
+  orc_union32 var72;
+  orc_union64 var73;
+  orc_union64 var74;
+  orc_union64 var75;
+  orc_union64 var76;
+  orc_union32 var77;
+  orc_union64 var78;
+  orc_union64 var79;
+  orc_union64 var80;
+  orc_union64 var81;
+  orc_union32 var82;
+  orc_union64 var83;
+  orc_union64 var84;
+  orc_union64 var85;
+  orc_union64 var86;
+  orc_union64 var87;
+  orc_union32 var88;
+
+  ptr0 = (orc_union64 *) d1;
+  ptr1 = (orc_union64 *) d2;
+  ptr2 = (orc_union64 *) d3;
+  ptr3 = (orc_union64 *) d4;
+  ptr4 = (orc_union64 *) s1;
+  ptr5 = (orc_union64 *) s2;
+  ptr6 = (orc_union64 *) s3;
+  ptr7 = (orc_union64 *) s4;
+
+  /* 12: loadpl */
+  var47.x2[0] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  var47.x2[1] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  /* 14: loadpl */
+  var48.x2[0] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+  var48.x2[1] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+  /* 17: loadpl */
+  var49.x2[0] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  var49.x2[1] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  /* 23: loadpl */
+  var50.x2[0] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+  var50.x2[1] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var43 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var43.i;
+      var55.i = _src.x2[1];
+      var56.i = _src.x2[0];
+    }
+    /* 2: convuwl */
+    var57.x2[0] = (orc_uint16) var55.x2[0];
+    var57.x2[1] = (orc_uint16) var55.x2[1];
+    /* 3: loadq */
+    var44 = ptr5[i];
+    /* 4: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var44.i;
+      var58.i = _src.x2[1];
+      var59.i = _src.x2[0];
+    }
+    /* 5: convuwl */
+    var60.x2[0] = (orc_uint16) var58.x2[0];
+    var60.x2[1] = (orc_uint16) var58.x2[1];
+    /* 6: loadq */
+    var45 = ptr6[i];
+    /* 7: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var45.i;
+      var61.i = _src.x2[1];
+      var62.i = _src.x2[0];
+    }
+    /* 8: convuwl */
+    var63.x2[0] = (orc_uint16) var61.x2[0];
+    var63.x2[1] = (orc_uint16) var61.x2[1];
+    /* 9: loadq */
+    var46 = ptr7[i];
+    /* 10: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var46.i;
+      var64.i = _src.x2[1];
+      var65.i = _src.x2[0];
+    }
+    /* 11: convuwl */
+    var66.x2[0] = (orc_uint16) var64.x2[0];
+    var66.x2[1] = (orc_uint16) var64.x2[1];
+    /* 13: mulll */
+    var67.x2[0] =
+        (((orc_uint32) var57.x2[0]) * ((orc_uint32) var47.x2[0])) & 0xffffffff;
+    var67.x2[1] =
+        (((orc_uint32) var57.x2[1]) * ((orc_uint32) var47.x2[1])) & 0xffffffff;
+    /* 15: mulll */
+    var68.x2[0] =
+        (((orc_uint32) var63.x2[0]) * ((orc_uint32) var48.x2[0])) & 0xffffffff;
+    var68.x2[1] =
+        (((orc_uint32) var63.x2[1]) * ((orc_uint32) var48.x2[1])) & 0xffffffff;
+    /* 16: addl */
+    var69.x2[0] = ((orc_uint32) var67.x2[0]) + ((orc_uint32) var68.x2[0]);
+    var69.x2[1] = ((orc_uint32) var67.x2[1]) + ((orc_uint32) var68.x2[1]);
+    /* 18: addl */
+    var70.x2[0] = ((orc_uint32) var69.x2[0]) + ((orc_uint32) var49.x2[0]);
+    var70.x2[1] = ((orc_uint32) var69.x2[1]) + ((orc_uint32) var49.x2[1]);
+    /* 19: shrul */
+    var71.x2[0] = ((orc_uint32) var70.x2[0]) >> 3;
+    var71.x2[1] = ((orc_uint32) var70.x2[1]) >> 3;
+    /* 20: convsuslw */
+    var72.x2[0] = ORC_CLAMP_UW (var71.x2[0]);
+    var72.x2[1] = ORC_CLAMP_UW (var71.x2[1]);
+    /* 21: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var56.i;
+      _dest.x2[1] = var72.i;
+      var51.i = _dest.i;
+    }
+    /* 22: storeq */
+    ptr0[i] = var51;
+    /* 24: mulll */
+    var73.x2[0] =
+        (((orc_uint32) var60.x2[0]) * ((orc_uint32) var50.x2[0])) & 0xffffffff;
+    var73.x2[1] =
+        (((orc_uint32) var60.x2[1]) * ((orc_uint32) var50.x2[1])) & 0xffffffff;
+    /* 25: addl */
+    var74.x2[0] = ((orc_uint32) var73.x2[0]) + ((orc_uint32) var66.x2[0]);
+    var74.x2[1] = ((orc_uint32) var73.x2[1]) + ((orc_uint32) var66.x2[1]);
+    /* 26: addl */
+    var75.x2[0] = ((orc_uint32) var74.x2[0]) + ((orc_uint32) var49.x2[0]);
+    var75.x2[1] = ((orc_uint32) var74.x2[1]) + ((orc_uint32) var49.x2[1]);
+    /* 27: shrul */
+    var76.x2[0] = ((orc_uint32) var75.x2[0]) >> 3;
+    var76.x2[1] = ((orc_uint32) var75.x2[1]) >> 3;
+    /* 28: convsuslw */
+    var77.x2[0] = ORC_CLAMP_UW (var76.x2[0]);
+    var77.x2[1] = ORC_CLAMP_UW (var76.x2[1]);
+    /* 29: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var59.i;
+      _dest.x2[1] = var77.i;
+      var52.i = _dest.i;
+    }
+    /* 30: storeq */
+    ptr1[i] = var52;
+    /* 31: mulll */
+    var78.x2[0] =
+        (((orc_uint32) var63.x2[0]) * ((orc_uint32) var50.x2[0])) & 0xffffffff;
+    var78.x2[1] =
+        (((orc_uint32) var63.x2[1]) * ((orc_uint32) var50.x2[1])) & 0xffffffff;
+    /* 32: addl */
+    var79.x2[0] = ((orc_uint32) var78.x2[0]) + ((orc_uint32) var57.x2[0]);
+    var79.x2[1] = ((orc_uint32) var78.x2[1]) + ((orc_uint32) var57.x2[1]);
+    /* 33: addl */
+    var80.x2[0] = ((orc_uint32) var79.x2[0]) + ((orc_uint32) var49.x2[0]);
+    var80.x2[1] = ((orc_uint32) var79.x2[1]) + ((orc_uint32) var49.x2[1]);
+    /* 34: shrul */
+    var81.x2[0] = ((orc_uint32) var80.x2[0]) >> 3;
+    var81.x2[1] = ((orc_uint32) var80.x2[1]) >> 3;
+    /* 35: convsuslw */
+    var82.x2[0] = ORC_CLAMP_UW (var81.x2[0]);
+    var82.x2[1] = ORC_CLAMP_UW (var81.x2[1]);
+    /* 36: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var62.i;
+      _dest.x2[1] = var82.i;
+      var53.i = _dest.i;
+    }
+    /* 37: storeq */
+    ptr2[i] = var53;
+    /* 38: mulll */
+    var83.x2[0] =
+        (((orc_uint32) var60.x2[0]) * ((orc_uint32) var48.x2[0])) & 0xffffffff;
+    var83.x2[1] =
+        (((orc_uint32) var60.x2[1]) * ((orc_uint32) var48.x2[1])) & 0xffffffff;
+    /* 39: mulll */
+    var84.x2[0] =
+        (((orc_uint32) var66.x2[0]) * ((orc_uint32) var47.x2[0])) & 0xffffffff;
+    var84.x2[1] =
+        (((orc_uint32) var66.x2[1]) * ((orc_uint32) var47.x2[1])) & 0xffffffff;
+    /* 40: addl */
+    var85.x2[0] = ((orc_uint32) var83.x2[0]) + ((orc_uint32) var84.x2[0]);
+    var85.x2[1] = ((orc_uint32) var83.x2[1]) + ((orc_uint32) var84.x2[1]);
+    /* 41: addl */
+    var86.x2[0] = ((orc_uint32) var85.x2[0]) + ((orc_uint32) var49.x2[0]);
+    var86.x2[1] = ((orc_uint32) var85.x2[1]) + ((orc_uint32) var49.x2[1]);
+    /* 42: shrul */
+    var87.x2[0] = ((orc_uint32) var86.x2[0]) >> 3;
+    var87.x2[1] = ((orc_uint32) var86.x2[1]) >> 3;
+    /* 43: convsuslw */
+    var88.x2[0] = ORC_CLAMP_UW (var87.x2[0]);
+    var88.x2[1] = ORC_CLAMP_UW (var87.x2[1]);
+    /* 44: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var65.i;
+      _dest.x2[1] = var88.i;
+      var54.i = _dest.i;
+    }
+    /* 45: storeq */
+    ptr3[i] = var54;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_up_vi2_u16 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union64 *ORC_RESTRICT ptr0;
+  orc_union64 *ORC_RESTRICT ptr1;
+  orc_union64 *ORC_RESTRICT ptr2;
+  orc_union64 *ORC_RESTRICT ptr3;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  const orc_union64 *ORC_RESTRICT ptr6;
+  const orc_union64 *ORC_RESTRICT ptr7;
+  orc_union64 var43;
+  orc_union64 var44;
+  orc_union64 var45;
+  orc_union64 var46;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var47;
+#else
+  orc_union64 var47;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var48;
+#else
+  orc_union64 var48;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var49;
+#else
+  orc_union64 var49;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var50;
+#else
+  orc_union64 var50;
+#endif
+  orc_union64 var51;
+  orc_union64 var52;
+  orc_union64 var53;
+  orc_union64 var54;
+  orc_union32 var55;
+  orc_union32 var56;
+  orc_union64 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union64 var60;
+  orc_union32 var61;
+  orc_union32 var62;
+  orc_union64 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union64 var66;
+  orc_union64 var67;
+  orc_union64 var68;
+  orc_union64 var69;
+  orc_union64 var70;
+  orc_union64 var71;
+  orc_union32 var72;
+  orc_union64 var73;
+  orc_union64 var74;
+  orc_union64 var75;
+  orc_union64 var76;
+  orc_union32 var77;
+  orc_union64 var78;
+  orc_union64 var79;
+  orc_union64 var80;
+  orc_union64 var81;
+  orc_union32 var82;
+  orc_union64 var83;
+  orc_union64 var84;
+  orc_union64 var85;
+  orc_union64 var86;
+  orc_union64 var87;
+  orc_union32 var88;
+
+  ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr1 = (orc_union64 *) ex->arrays[1];
+  ptr2 = (orc_union64 *) ex->arrays[2];
+  ptr3 = (orc_union64 *) ex->arrays[3];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+  ptr5 = (orc_union64 *) ex->arrays[5];
+  ptr6 = (orc_union64 *) ex->arrays[6];
+  ptr7 = (orc_union64 *) ex->arrays[7];
+
+  /* 12: loadpl */
+  var47.x2[0] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  var47.x2[1] = (int) 0x00000005;       /* 5 or 2.47033e-323f */
+  /* 14: loadpl */
+  var48.x2[0] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+  var48.x2[1] = (int) 0x00000003;       /* 3 or 1.4822e-323f */
+  /* 17: loadpl */
+  var49.x2[0] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  var49.x2[1] = (int) 0x00000004;       /* 4 or 1.97626e-323f */
+  /* 23: loadpl */
+  var50.x2[0] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+  var50.x2[1] = (int) 0x00000007;       /* 7 or 3.45846e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var43 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var43.i;
+      var55.i = _src.x2[1];
+      var56.i = _src.x2[0];
+    }
+    /* 2: convuwl */
+    var57.x2[0] = (orc_uint16) var55.x2[0];
+    var57.x2[1] = (orc_uint16) var55.x2[1];
+    /* 3: loadq */
+    var44 = ptr5[i];
+    /* 4: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var44.i;
+      var58.i = _src.x2[1];
+      var59.i = _src.x2[0];
+    }
+    /* 5: convuwl */
+    var60.x2[0] = (orc_uint16) var58.x2[0];
+    var60.x2[1] = (orc_uint16) var58.x2[1];
+    /* 6: loadq */
+    var45 = ptr6[i];
+    /* 7: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var45.i;
+      var61.i = _src.x2[1];
+      var62.i = _src.x2[0];
+    }
+    /* 8: convuwl */
+    var63.x2[0] = (orc_uint16) var61.x2[0];
+    var63.x2[1] = (orc_uint16) var61.x2[1];
+    /* 9: loadq */
+    var46 = ptr7[i];
+    /* 10: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var46.i;
+      var64.i = _src.x2[1];
+      var65.i = _src.x2[0];
+    }
+    /* 11: convuwl */
+    var66.x2[0] = (orc_uint16) var64.x2[0];
+    var66.x2[1] = (orc_uint16) var64.x2[1];
+    /* 13: mulll */
+    var67.x2[0] =
+        (((orc_uint32) var57.x2[0]) * ((orc_uint32) var47.x2[0])) & 0xffffffff;
+    var67.x2[1] =
+        (((orc_uint32) var57.x2[1]) * ((orc_uint32) var47.x2[1])) & 0xffffffff;
+    /* 15: mulll */
+    var68.x2[0] =
+        (((orc_uint32) var63.x2[0]) * ((orc_uint32) var48.x2[0])) & 0xffffffff;
+    var68.x2[1] =
+        (((orc_uint32) var63.x2[1]) * ((orc_uint32) var48.x2[1])) & 0xffffffff;
+    /* 16: addl */
+    var69.x2[0] = ((orc_uint32) var67.x2[0]) + ((orc_uint32) var68.x2[0]);
+    var69.x2[1] = ((orc_uint32) var67.x2[1]) + ((orc_uint32) var68.x2[1]);
+    /* 18: addl */
+    var70.x2[0] = ((orc_uint32) var69.x2[0]) + ((orc_uint32) var49.x2[0]);
+    var70.x2[1] = ((orc_uint32) var69.x2[1]) + ((orc_uint32) var49.x2[1]);
+    /* 19: shrul */
+    var71.x2[0] = ((orc_uint32) var70.x2[0]) >> 3;
+    var71.x2[1] = ((orc_uint32) var70.x2[1]) >> 3;
+    /* 20: convsuslw */
+    var72.x2[0] = ORC_CLAMP_UW (var71.x2[0]);
+    var72.x2[1] = ORC_CLAMP_UW (var71.x2[1]);
+    /* 21: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var56.i;
+      _dest.x2[1] = var72.i;
+      var51.i = _dest.i;
+    }
+    /* 22: storeq */
+    ptr0[i] = var51;
+    /* 24: mulll */
+    var73.x2[0] =
+        (((orc_uint32) var60.x2[0]) * ((orc_uint32) var50.x2[0])) & 0xffffffff;
+    var73.x2[1] =
+        (((orc_uint32) var60.x2[1]) * ((orc_uint32) var50.x2[1])) & 0xffffffff;
+    /* 25: addl */
+    var74.x2[0] = ((orc_uint32) var73.x2[0]) + ((orc_uint32) var66.x2[0]);
+    var74.x2[1] = ((orc_uint32) var73.x2[1]) + ((orc_uint32) var66.x2[1]);
+    /* 26: addl */
+    var75.x2[0] = ((orc_uint32) var74.x2[0]) + ((orc_uint32) var49.x2[0]);
+    var75.x2[1] = ((orc_uint32) var74.x2[1]) + ((orc_uint32) var49.x2[1]);
+    /* 27: shrul */
+    var76.x2[0] = ((orc_uint32) var75.x2[0]) >> 3;
+    var76.x2[1] = ((orc_uint32) var75.x2[1]) >> 3;
+    /* 28: convsuslw */
+    var77.x2[0] = ORC_CLAMP_UW (var76.x2[0]);
+    var77.x2[1] = ORC_CLAMP_UW (var76.x2[1]);
+    /* 29: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var59.i;
+      _dest.x2[1] = var77.i;
+      var52.i = _dest.i;
+    }
+    /* 30: storeq */
+    ptr1[i] = var52;
+    /* 31: mulll */
+    var78.x2[0] =
+        (((orc_uint32) var63.x2[0]) * ((orc_uint32) var50.x2[0])) & 0xffffffff;
+    var78.x2[1] =
+        (((orc_uint32) var63.x2[1]) * ((orc_uint32) var50.x2[1])) & 0xffffffff;
+    /* 32: addl */
+    var79.x2[0] = ((orc_uint32) var78.x2[0]) + ((orc_uint32) var57.x2[0]);
+    var79.x2[1] = ((orc_uint32) var78.x2[1]) + ((orc_uint32) var57.x2[1]);
+    /* 33: addl */
+    var80.x2[0] = ((orc_uint32) var79.x2[0]) + ((orc_uint32) var49.x2[0]);
+    var80.x2[1] = ((orc_uint32) var79.x2[1]) + ((orc_uint32) var49.x2[1]);
+    /* 34: shrul */
+    var81.x2[0] = ((orc_uint32) var80.x2[0]) >> 3;
+    var81.x2[1] = ((orc_uint32) var80.x2[1]) >> 3;
+    /* 35: convsuslw */
+    var82.x2[0] = ORC_CLAMP_UW (var81.x2[0]);
+    var82.x2[1] = ORC_CLAMP_UW (var81.x2[1]);
+    /* 36: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var62.i;
+      _dest.x2[1] = var82.i;
+      var53.i = _dest.i;
+    }
+    /* 37: storeq */
+    ptr2[i] = var53;
+    /* 38: mulll */
+    var83.x2[0] =
+        (((orc_uint32) var60.x2[0]) * ((orc_uint32) var48.x2[0])) & 0xffffffff;
+    var83.x2[1] =
+        (((orc_uint32) var60.x2[1]) * ((orc_uint32) var48.x2[1])) & 0xffffffff;
+    /* 39: mulll */
+    var84.x2[0] =
+        (((orc_uint32) var66.x2[0]) * ((orc_uint32) var47.x2[0])) & 0xffffffff;
+    var84.x2[1] =
+        (((orc_uint32) var66.x2[1]) * ((orc_uint32) var47.x2[1])) & 0xffffffff;
+    /* 40: addl */
+    var85.x2[0] = ((orc_uint32) var83.x2[0]) + ((orc_uint32) var84.x2[0]);
+    var85.x2[1] = ((orc_uint32) var83.x2[1]) + ((orc_uint32) var84.x2[1]);
+    /* 41: addl */
+    var86.x2[0] = ((orc_uint32) var85.x2[0]) + ((orc_uint32) var49.x2[0]);
+    var86.x2[1] = ((orc_uint32) var85.x2[1]) + ((orc_uint32) var49.x2[1]);
+    /* 42: shrul */
+    var87.x2[0] = ((orc_uint32) var86.x2[0]) >> 3;
+    var87.x2[1] = ((orc_uint32) var86.x2[1]) >> 3;
+    /* 43: convsuslw */
+    var88.x2[0] = ORC_CLAMP_UW (var87.x2[0]);
+    var88.x2[1] = ORC_CLAMP_UW (var87.x2[1]);
+    /* 44: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var65.i;
+      _dest.x2[1] = var88.i;
+      var54.i = _dest.i;
+    }
+    /* 45: storeq */
+    ptr3[i] = var54;
+  }
+
+}
+
+void
+video_orc_chroma_up_vi2_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 27, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 117, 112, 95, 118, 105, 50, 95, 117, 49, 54, 11, 8,
+        8, 11, 8, 8, 11, 8, 8, 11, 8, 8, 12, 8, 8, 12, 8, 8,
+        12, 8, 8, 12, 8, 8, 14, 4, 5, 0, 0, 0, 14, 4, 3, 0,
+        0, 0, 14, 4, 4, 0, 0, 0, 14, 4, 7, 0, 0, 0, 20, 4,
+        20, 4, 20, 4, 20, 4, 20, 4, 20, 8, 20, 8, 20, 8, 20, 8,
+        20, 8, 20, 8, 197, 36, 32, 4, 21, 1, 154, 37, 36, 197, 36, 33,
+        5, 21, 1, 154, 38, 36, 197, 36, 34, 6, 21, 1, 154, 39, 36, 197,
+        36, 35, 7, 21, 1, 154, 40, 36, 21, 1, 120, 41, 37, 16, 21, 1,
+        120, 42, 39, 17, 21, 1, 103, 41, 41, 42, 21, 1, 103, 41, 41, 18,
+        21, 1, 126, 41, 41, 17, 21, 1, 166, 36, 41, 194, 0, 32, 36, 21,
+        1, 120, 41, 38, 19, 21, 1, 103, 41, 41, 40, 21, 1, 103, 41, 41,
+        18, 21, 1, 126, 41, 41, 17, 21, 1, 166, 36, 41, 194, 1, 33, 36,
+        21, 1, 120, 41, 39, 19, 21, 1, 103, 41, 41, 37, 21, 1, 103, 41,
+        41, 18, 21, 1, 126, 41, 41, 17, 21, 1, 166, 36, 41, 194, 2, 34,
+        36, 21, 1, 120, 41, 38, 17, 21, 1, 120, 42, 40, 16, 21, 1, 103,
+        41, 41, 42, 21, 1, 103, 41, 41, 18, 21, 1, 126, 41, 41, 17, 21,
+        1, 166, 36, 41, 194, 3, 35, 36, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_vi2_u16);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_up_vi2_u16");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_vi2_u16);
+      orc_program_add_destination (p, 8, "d1");
+      orc_program_add_destination (p, 8, "d2");
+      orc_program_add_destination (p, 8, "d3");
+      orc_program_add_destination (p, 8, "d4");
+      orc_program_add_source (p, 8, "s1");
+      orc_program_add_source (p, 8, "s2");
+      orc_program_add_source (p, 8, "s3");
+      orc_program_add_source (p, 8, "s4");
+      orc_program_add_constant (p, 4, 0x00000005, "c1");
+      orc_program_add_constant (p, 4, 0x00000003, "c2");
+      orc_program_add_constant (p, 4, 0x00000004, "c3");
+      orc_program_add_constant (p, 4, 0x00000007, "c4");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+      orc_program_add_temporary (p, 4, "t4");
+      orc_program_add_temporary (p, 4, "t5");
+      orc_program_add_temporary (p, 8, "t6");
+      orc_program_add_temporary (p, 8, "t7");
+      orc_program_add_temporary (p, 8, "t8");
+      orc_program_add_temporary (p, 8, "t9");
+      orc_program_add_temporary (p, 8, "t10");
+      orc_program_add_temporary (p, 8, "t11");
+
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T5, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T6, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T5, ORC_VAR_T2, ORC_VAR_S2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_S3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T8, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T5, ORC_VAR_T4, ORC_VAR_S4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T9, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T10, ORC_VAR_T6, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T11, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_T11,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T5, ORC_VAR_T10,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T10, ORC_VAR_T7, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T5, ORC_VAR_T10,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D2, ORC_VAR_T2, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T10, ORC_VAR_T8, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T5, ORC_VAR_T10,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D3, ORC_VAR_T3, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T10, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T11, ORC_VAR_T9, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_T11,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T5, ORC_VAR_T10,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D4, ORC_VAR_T4, ORC_VAR_T5,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_D3] = d3;
+  ex->arrays[ORC_VAR_D4] = d4;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
 /* video_orc_dither_none_4u8_mask */
 #ifdef DISABLE_ORC
 void
@@ -1136,6 +1136,83 @@ gst_video_overlay_rectangle_convert (GstVideoInfo * src, GstBuffer * src_buffer,
   gst_video_frame_unmap (&dest_frame);
 }
 
+/* A small shared cache of scaled/converted rectangle variants, keyed by
+ * the source pixel buffer and the wanted geometry/format/alpha type.
+ * The per-rectangle cache above only helps while the same rectangle
+ * instance is reused; when an unchanged bitmap is repositioned, a new
+ * rectangle is created per frame and would pay a rescale per frame
+ * without this. Entries keep a ref on both the source buffer, which
+ * also makes the pointer a stable identity, and the variant, so the
+ * backing buffers are pooled across rectangle instances. */
+#define SCALED_CACHE_MAX_ENTRIES 32
+
+typedef struct
+{
+  GstBuffer *pixels;            /* identifies the source bitmap */
+  guint width, height;
+  GstVideoFormat format;
+  GstVideoOverlayRectangle *variant;
+} ScaledVariantCacheEntry;
+
+static GMutex scaled_cache_lock;
+static GQueue scaled_cache = G_QUEUE_INIT;
+
+static void
+scaled_variant_cache_entry_free (ScaledVariantCacheEntry * entry)
+{
+  gst_buffer_unref (entry->pixels);
+  gst_video_overlay_rectangle_unref (entry->variant);
+  g_slice_free (ScaledVariantCacheEntry, entry);
+}
+
+static GstVideoOverlayRectangle *
+gst_video_overlay_rectangle_scaled_cache_lookup (GstBuffer * pixels,
+    guint width, guint height, GstVideoFormat format,
+    GstVideoOverlayFormatFlags flags)
+{
+  GstVideoOverlayRectangle *ret = NULL;
+  GList *l;
+
+  g_mutex_lock (&scaled_cache_lock);
+  for (l = scaled_cache.head; l != NULL; l = l->next) {
+    ScaledVariantCacheEntry *entry = l->data;
+
+    if (entry->pixels == pixels && entry->width == width &&
+        entry->height == height && entry->format == format &&
+        gst_video_overlay_rectangle_is_same_alpha_type (entry->variant->flags,
+            flags)) {
+      /* most recently used first */
+      g_queue_unlink (&scaled_cache, l);
+      g_queue_push_head_link (&scaled_cache, l);
+      ret = gst_video_overlay_rectangle_ref (entry->variant);
+      break;
+    }
+  }
+  g_mutex_unlock (&scaled_cache_lock);
+
+  return ret;
+}
+
+static void
+gst_video_overlay_rectangle_scaled_cache_store (GstBuffer * pixels,
+    GstVideoOverlayRectangle * variant)
+{
+  ScaledVariantCacheEntry *entry;
+
+  entry = g_slice_new (ScaledVariantCacheEntry);
+  entry->pixels = gst_buffer_ref (pixels);
+  entry->width = GST_VIDEO_INFO_WIDTH (&variant->info);
+  entry->height = GST_VIDEO_INFO_HEIGHT (&variant->info);
+  entry->format = GST_VIDEO_INFO_FORMAT (&variant->info);
+  entry->variant = gst_video_overlay_rectangle_ref (variant);
+
+  g_mutex_lock (&scaled_cache_lock);
+  g_queue_push_head (&scaled_cache, entry);
+  while (scaled_cache.length > SCALED_CACHE_MAX_ENTRIES)
+    scaled_variant_cache_entry_free (g_queue_pop_tail (&scaled_cache));
+  g_mutex_unlock (&scaled_cache_lock);
+}
+
 static GstBuffer *
 gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
     rectangle, GstVideoOverlayFormatFlags flags, gboolean unscaled,
@@ -1208,6 +1285,26 @@ gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
   if (scaled_rect != NULL)
     goto done;
 
+  /* an unchanged bitmap that is animated around gets a fresh rectangle
+   * per frame; the shared cache still has the scaled variant then. The
+   * cached variants are shared between rectangles, so this is only safe
+   * when no global-alpha processing may modify them. */
+  if (rectangle->global_alpha == 1.0 && !apply_global_alpha
+      && !revert_global_alpha) {
+    scaled_rect =
+        gst_video_overlay_rectangle_scaled_cache_lookup (rectangle->pixels,
+        wanted_width, wanted_height, wanted_format, flags);
+    if (scaled_rect != NULL) {
+      /* the ref is handed to our own cache, which keeps the variant
+       * alive until finalize like the locally created ones */
+      GST_RECTANGLE_LOCK (rectangle);
+      rectangle->scaled_rectangles =
+          g_list_prepend (rectangle->scaled_rectangles, scaled_rect);
+      GST_RECTANGLE_UNLOCK (rectangle);
+      goto done;
+    }
+  }
+
   /* maybe have one in the right format though */
   if (format != wanted_format) {
     GST_RECTANGLE_LOCK (rectangle);
@@ -1299,6 +1396,12 @@ gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
       g_list_prepend (rectangle->scaled_rectangles, scaled_rect);
   GST_RECTANGLE_UNLOCK (rectangle);
 
+  if (rectangle->global_alpha == 1.0 && !apply_global_alpha
+      && !revert_global_alpha) {
+    gst_video_overlay_rectangle_scaled_cache_store (rectangle->pixels,
+        scaled_rect);
+  }
+
 done:
 
   GST_RECTANGLE_LOCK (rectangle);
@@ -43,6 +43,7 @@
 
 #include "video-orc.h"
 #include "video-scaler.h"
+#include "video-converter-x86.h"
 
 #ifndef GST_DISABLE_GST_DEBUG
 #define GST_CAT_DEFAULT ensure_debug_category()
@@ -641,21 +642,15 @@ video_scale_h_ntap_u8 (GstVideoScaler * scale,
   switch (n_elems) {
     case 1:
     {
-      guint8 *s = (guint8 *) src;
-
-      for (i = 0; i < count; i++)
-        pixels[i] = s[offset_n[i]];
+      video_converter_gather_u8 (pixels, (guint8 *) src, offset_n, count);
 
       d = (guint8 *) dest + dest_offset;
       break;
     }
     case 2:
     {
-      guint16 *p16 = (guint16 *) pixels;
-      guint16 *s = (guint16 *) src;
-
-      for (i = 0; i < count; i++)
-        p16[i] = s[offset_n[i]];
+      video_converter_gather_u16 ((guint16 *) pixels, (guint16 *) src,
+          offset_n, count);
 
       d = (guint16 *) dest + dest_offset;
       break;
@@ -675,14 +670,9 @@ video_scale_h_ntap_u8 (GstVideoScaler * scale,
     }
     case 4:
     {
-      guint32 *p32 = (guint32 *) pixels;
-      guint32 *s = (guint32 *) src;
-#if 0
-      video_orc_resample_h_near_u32 (p32, s, offset_n, count);
-#else
-      for (i = 0; i < count; i++)
-        p32[i] = s[offset_n[i]];
-#endif
+      video_converter_gather_u32 ((guint32 *) pixels, (guint32 *) src,
+          offset_n, count);
+
       d = (guint32 *) dest + dest_offset;
       break;
     }
@@ -778,10 +768,7 @@ video_scale_h_ntap_u16 (GstVideoScaler * scale,
   switch (n_elems) {
     case 1:
     {
-      guint16 *s = (guint16 *) src;
-
-      for (i = 0; i < count; i++)
-        pixels[i] = s[offset_n[i]];
+      video_converter_gather_u16 (pixels, (guint16 *) src, offset_n, count);
 
       d = (guint16 *) dest + dest_offset;
       break;
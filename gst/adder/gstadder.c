@@ -125,6 +125,19 @@ gst_adder_pad_set_property (GObject * object, guint prop_id,
   }
 }
 
+static void
+gst_adder_pad_finalize (GObject * object)
+{
+  GstAdderPad *pad = GST_ADDER_PAD (object);
+
+  if (pad->converter) {
+    gst_audio_converter_free (pad->converter);
+    pad->converter = NULL;
+  }
+
+  G_OBJECT_CLASS (gst_adder_pad_parent_class)->finalize (object);
+}
+
 static void
 gst_adder_pad_class_init (GstAdderPadClass * klass)
 {
@@ -132,6 +145,7 @@ gst_adder_pad_class_init (GstAdderPadClass * klass)
 
   gobject_class->set_property = gst_adder_pad_set_property;
   gobject_class->get_property = gst_adder_pad_get_property;
+  gobject_class->finalize = gst_adder_pad_finalize;
 
   g_object_class_install_property (gobject_class, PROP_PAD_VOLUME,
       g_param_spec_double ("volume", "Volume", "Volume of this pad",
@@ -196,6 +210,8 @@ static void gst_adder_get_property (GObject * object, guint prop_id,
 
 static gboolean gst_adder_setcaps (GstAdder * adder, GstPad * pad,
     GstCaps * caps);
+static gboolean gst_adder_pad_setup_converter (GstAdder * adder,
+    GstAdderPad * pad, const GstAudioInfo * in_info);
 static gboolean gst_adder_src_query (GstPad * pad, GstObject * parent,
     GstQuery * query);
 static gboolean gst_adder_sink_query (GstCollectPads * pads,
@@ -218,6 +234,31 @@ static GstFlowReturn gst_adder_do_clip (GstCollectPads * pads,
 static GstFlowReturn gst_adder_collected (GstCollectPads * pads,
     gpointer user_data);
 
+/* minimum number of output bytes for each worker slice */
+#define MIX_MIN_SLICE_SIZE 4096
+
+/* one queued input buffer together with a snapshot of the pad volume */
+typedef struct
+{
+  GstBuffer *buf;
+  GstMapInfo map;
+  gdouble volume;
+  gint volume_i32;
+  gint volume_i16;
+  gint volume_i8;
+} GstAdderInput;
+
+/* a contiguous range of output samples mixed by one worker */
+typedef struct
+{
+  GstAdder *adder;
+  GstAdderInput *inputs;
+  guint n_inputs;
+  guint8 *outdata;
+  gsize offset;
+  gsize length;
+} GstAdderMixSlice;
+
 /* we can only accept caps that we and downstream can handle.
  * if we have filtercaps set, use those to constrain the target caps.
  */
@@ -261,6 +302,18 @@ gst_adder_sink_getcaps (GstPad * pad, GstCaps * filter)
     current_caps = gst_pad_get_pad_template_caps (pad);
     if (!current_caps)
       current_caps = gst_caps_new_any ();
+  } else {
+    /* pads added while the mix format is fixed can use any format and
+     * channel count at the mix rate, we convert their input into the mix
+     * without renegotiating the output */
+    GstCaps *convcaps = gst_pad_get_pad_template_caps (pad);
+
+    convcaps = gst_caps_make_writable (convcaps);
+    gst_caps_set_simple (convcaps, "rate", G_TYPE_INT,
+        GST_AUDIO_INFO_RATE (&adder->info), "layout", G_TYPE_STRING,
+        "interleaved", NULL);
+    current_caps = gst_caps_merge (gst_caps_make_writable (current_caps),
+        convcaps);
   }
   GST_OBJECT_UNLOCK (adder);
 
@@ -366,18 +419,34 @@ gst_adder_setcaps (GstAdder * adder, GstPad * pad, GstCaps * orig_caps)
    * (possibly different) CAPS events, but there's not much we can do about
    * that, upstream needs to deal with it. */
   if (adder->current_caps != NULL) {
+    GstAdderPad *adderpad = GST_ADDER_PAD (pad);
+
     if (gst_audio_info_is_equal (&info, &adder->info)) {
       GST_OBJECT_UNLOCK (adder);
+      /* drop a converter left over from a previous caps change */
+      if (adderpad->converter) {
+        gst_audio_converter_free (adderpad->converter);
+        adderpad->converter = NULL;
+      }
       gst_caps_unref (caps);
       return TRUE;
-    } else {
-      GST_DEBUG_OBJECT (pad, "got input caps %" GST_PTR_FORMAT ", but "
-          "current caps are %" GST_PTR_FORMAT, caps, adder->current_caps);
-      GST_OBJECT_UNLOCK (adder);
-      gst_pad_push_event (pad, gst_event_new_reconfigure ());
+    }
+    GST_OBJECT_UNLOCK (adder);
+
+    /* different caps while the mix format is fixed; mix this pad through
+     * a converter so the output keeps flowing without renegotiation */
+    if (gst_adder_pad_setup_converter (adder, adderpad, &info)) {
+      GST_INFO_OBJECT (pad, "mixing input caps %" GST_PTR_FORMAT
+          " into the fixed mix format through a converter", caps);
       gst_caps_unref (caps);
-      return FALSE;
+      return TRUE;
     }
+
+    GST_DEBUG_OBJECT (pad, "got input caps %" GST_PTR_FORMAT ", but "
+        "current caps are %" GST_PTR_FORMAT, caps, adder->current_caps);
+    gst_pad_push_event (pad, gst_event_new_reconfigure ());
+    gst_caps_unref (caps);
+    return FALSE;
   }
 
   GST_INFO_OBJECT (pad, "setting caps to %" GST_PTR_FORMAT, caps);
@@ -903,6 +972,10 @@ gst_adder_init (GstAdder * adder)
       GST_DEBUG_FUNCPTR (gst_adder_sink_event), adder);
   gst_collect_pads_set_query_function (adder->collect,
       GST_DEBUG_FUNCPTR (gst_adder_sink_query), adder);
+
+  g_mutex_init (&adder->mix_lock);
+  g_cond_init (&adder->mix_cond);
+  adder->mix_inputs = g_array_new (FALSE, FALSE, sizeof (GstAdderInput));
 }
 
 static void
@@ -923,6 +996,13 @@ gst_adder_dispose (GObject * object)
     adder->pending_events = NULL;
   }
 
+  if (adder->mix_inputs) {
+    g_array_free (adder->mix_inputs, TRUE);
+    adder->mix_inputs = NULL;
+    g_mutex_clear (&adder->mix_lock);
+    g_cond_clear (&adder->mix_cond);
+  }
+
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
 
@@ -1045,22 +1125,243 @@ gst_adder_release_pad (GstElement * element, GstPad * pad)
   gst_element_remove_pad (element, pad);
 }
 
+/* set up a converter from @in_info to the mix format on @pad. Only
+ * rate-preserving interleaved conversions are allowed so that the frame
+ * counts, and with them the collected byte math, stay 1:1. Caps events and
+ * buffers are serialized on the pad, so no locking against do_clip is
+ * needed */
+static gboolean
+gst_adder_pad_setup_converter (GstAdder * adder, GstAdderPad * pad,
+    const GstAudioInfo * in_info)
+{
+  GstAudioConverter *converter;
+  GstAudioInfo out_info;
+
+  GST_OBJECT_LOCK (adder);
+  out_info = adder->info;
+  GST_OBJECT_UNLOCK (adder);
+
+  if (GST_AUDIO_INFO_RATE (in_info) != GST_AUDIO_INFO_RATE (&out_info))
+    return FALSE;
+  if (GST_AUDIO_INFO_LAYOUT (in_info) != GST_AUDIO_LAYOUT_INTERLEAVED ||
+      GST_AUDIO_INFO_LAYOUT (&out_info) != GST_AUDIO_LAYOUT_INTERLEAVED)
+    return FALSE;
+
+  converter = gst_audio_converter_new (GST_AUDIO_CONVERTER_FLAG_NONE,
+      (GstAudioInfo *) in_info, &out_info, NULL);
+  if (converter == NULL)
+    return FALSE;
+
+  if (pad->converter)
+    gst_audio_converter_free (pad->converter);
+  pad->converter = converter;
+  pad->in_info = *in_info;
+
+  return TRUE;
+}
+
+/* replace @buffer with its contents converted to the mix format; the
+ * conversion preserves the rate so the number of frames is unchanged */
+static GstBuffer *
+gst_adder_pad_convert_buffer (GstAdder * adder, GstAdderPad * pad,
+    GstBuffer * buffer)
+{
+  GstMapInfo inmap, outmap;
+  GstBuffer *outbuf;
+  gsize frames;
+  gpointer in[1], out[1];
+
+  frames = gst_buffer_get_size (buffer) / GST_AUDIO_INFO_BPF (&pad->in_info);
+  outbuf = gst_buffer_new_allocate (NULL,
+      frames * GST_AUDIO_INFO_BPF (&adder->info), NULL);
+  gst_buffer_copy_into (outbuf, buffer,
+      GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+
+  gst_buffer_map (buffer, &inmap, GST_MAP_READ);
+  gst_buffer_map (outbuf, &outmap, GST_MAP_WRITE);
+  in[0] = inmap.data;
+  out[0] = outmap.data;
+  gst_audio_converter_samples (pad->converter, GST_AUDIO_CONVERTER_FLAG_NONE,
+      in, frames, out, frames);
+  gst_buffer_unmap (outbuf, &outmap);
+  gst_buffer_unmap (buffer, &inmap);
+  gst_buffer_unref (buffer);
+
+  return outbuf;
+}
+
 static GstFlowReturn
 gst_adder_do_clip (GstCollectPads * pads, GstCollectData * data,
     GstBuffer * buffer, GstBuffer ** out, gpointer user_data)
 {
   GstAdder *adder = GST_ADDER (user_data);
+  GstAdderPad *pad = GST_ADDER_PAD (data->pad);
   gint rate, bpf;
 
-  rate = GST_AUDIO_INFO_RATE (&adder->info);
-  bpf = GST_AUDIO_INFO_BPF (&adder->info);
+  /* clip in the pad's own format, it only enters the mix format below */
+  if (pad->converter) {
+    rate = GST_AUDIO_INFO_RATE (&pad->in_info);
+    bpf = GST_AUDIO_INFO_BPF (&pad->in_info);
+  } else {
+    rate = GST_AUDIO_INFO_RATE (&adder->info);
+    bpf = GST_AUDIO_INFO_BPF (&adder->info);
+  }
 
   buffer = gst_audio_buffer_clip (buffer, &data->segment, rate, bpf);
 
+  if (buffer != NULL && pad->converter)
+    buffer = gst_adder_pad_convert_buffer (adder, pad, buffer);
+
   *out = buffer;
   return GST_FLOW_OK;
 }
 
+static void
+gst_adder_mix_range (GstAdder * adder, GstAdderInput * inputs, guint n_inputs,
+    guint8 * outdata, gsize offset, gsize length)
+{
+  gint bps = GST_AUDIO_INFO_BPS (&adder->info);
+  guint n = length / bps;
+  guint i;
+
+  for (i = 0; i < n_inputs; i++) {
+    gpointer out = outdata + offset;
+    gpointer in = inputs[i].map.data + offset;
+
+    if (inputs[i].volume == 1.0) {
+      switch (adder->info.finfo->format) {
+        case GST_AUDIO_FORMAT_U8:
+          adder_orc_add_u8 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_S8:
+          adder_orc_add_s8 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_U16:
+          adder_orc_add_u16 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_S16:
+          adder_orc_add_s16 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_U32:
+          adder_orc_add_u32 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_S32:
+          adder_orc_add_s32 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_F32:
+          adder_orc_add_f32 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_F64:
+          adder_orc_add_f64 (out, in, n);
+          break;
+        default:
+          g_assert_not_reached ();
+          break;
+      }
+    } else {
+      switch (adder->info.finfo->format) {
+        case GST_AUDIO_FORMAT_U8:
+          adder_orc_add_volume_u8 (out, in, inputs[i].volume_i8, n);
+          break;
+        case GST_AUDIO_FORMAT_S8:
+          adder_orc_add_volume_s8 (out, in, inputs[i].volume_i8, n);
+          break;
+        case GST_AUDIO_FORMAT_U16:
+          adder_orc_add_volume_u16 (out, in, inputs[i].volume_i16, n);
+          break;
+        case GST_AUDIO_FORMAT_S16:
+          adder_orc_add_volume_s16 (out, in, inputs[i].volume_i16, n);
+          break;
+        case GST_AUDIO_FORMAT_U32:
+          adder_orc_add_volume_u32 (out, in, inputs[i].volume_i32, n);
+          break;
+        case GST_AUDIO_FORMAT_S32:
+          adder_orc_add_volume_s32 (out, in, inputs[i].volume_i32, n);
+          break;
+        case GST_AUDIO_FORMAT_F32:
+          adder_orc_add_volume_f32 (out, in, inputs[i].volume, n);
+          break;
+        case GST_AUDIO_FORMAT_F64:
+          adder_orc_add_volume_f64 (out, in, inputs[i].volume, n);
+          break;
+        default:
+          g_assert_not_reached ();
+          break;
+      }
+    }
+  }
+}
+
+static void
+gst_adder_mix_slice_func (gpointer data, gpointer user_data)
+{
+  GstAdderMixSlice *slice = data;
+  GstAdder *adder = slice->adder;
+
+  gst_adder_mix_range (adder, slice->inputs, slice->n_inputs,
+      slice->outdata, slice->offset, slice->length);
+
+  g_mutex_lock (&adder->mix_lock);
+  adder->mix_pending--;
+  g_cond_signal (&adder->mix_cond);
+  g_mutex_unlock (&adder->mix_lock);
+}
+
+/* Mix all queued input buffers into the output buffer. With enough data and
+ * a worker pool the output is partitioned into contiguous slices that are
+ * mixed in parallel. Every worker applies the inputs in pad order on its own
+ * sample range, so the output is identical to the serial mix; partitioning
+ * the inputs instead would reorder the saturating additions. */
+static void
+gst_adder_mix_inputs (GstAdder * adder, GstAdderInput * inputs, guint n_inputs,
+    guint8 * outdata, gsize outsize)
+{
+  gint bpf = GST_AUDIO_INFO_BPF (&adder->info);
+  GstAdderMixSlice *slices;
+  gsize slice_len, offset;
+  guint n_slices, i;
+
+  n_slices = MIN (adder->mix_threads, outsize / MIX_MIN_SLICE_SIZE);
+
+  if (adder->mix_pool == NULL || n_inputs < 2 || n_slices < 2) {
+    gst_adder_mix_range (adder, inputs, n_inputs, outdata, 0, outsize);
+    return;
+  }
+
+  GST_LOG_OBJECT (adder, "mixing %u inputs with %u slices", n_inputs,
+      n_slices);
+
+  /* frame-aligned slice size, the last slice takes the remainder */
+  slice_len = ((outsize / n_slices) / bpf) * bpf;
+
+  slices = g_newa (GstAdderMixSlice, n_slices);
+  offset = 0;
+  for (i = 0; i < n_slices; i++) {
+    slices[i].adder = adder;
+    slices[i].inputs = inputs;
+    slices[i].n_inputs = n_inputs;
+    slices[i].outdata = outdata;
+    slices[i].offset = offset;
+    slices[i].length = (i == n_slices - 1) ? (outsize - offset) : slice_len;
+    offset += slices[i].length;
+  }
+
+  g_mutex_lock (&adder->mix_lock);
+  adder->mix_pending = n_slices - 1;
+  g_mutex_unlock (&adder->mix_lock);
+
+  for (i = 1; i < n_slices; i++)
+    g_thread_pool_push (adder->mix_pool, &slices[i], NULL);
+
+  /* mix the first slice in the streaming thread */
+  gst_adder_mix_range (adder, inputs, n_inputs, outdata, 0, slices[0].length);
+
+  g_mutex_lock (&adder->mix_lock);
+  while (adder->mix_pending > 0)
+    g_cond_wait (&adder->mix_cond, &adder->mix_lock);
+  g_mutex_unlock (&adder->mix_lock);
+}
+
 static GstFlowReturn
 gst_adder_collected (GstCollectPads * pads, gpointer user_data)
 {
@@ -1085,6 +1386,8 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
   GstFlowReturn ret;
   GstBuffer *outbuf = NULL, *gapbuf = NULL;
   GstMapInfo outmap = { NULL };
+  GArray *inputs;
+  guint i;
   guint outsize;
   gint64 next_offset;
   gint64 next_timestamp;
@@ -1094,6 +1397,7 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
   gboolean is_discont = FALSE;
 
   adder = GST_ADDER (user_data);
+  inputs = adder->mix_inputs;
 
   /* this is fatal */
   if (G_UNLIKELY (adder->info.finfo->format == GST_AUDIO_FORMAT_UNKNOWN))
@@ -1297,106 +1601,47 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
       }
     } else {
       if (!is_gap) {
-        /* we had a previous output buffer, mix this non-GAP buffer */
-        GstMapInfo inmap;
+        /* we had a previous output buffer, queue this non-GAP buffer for
+         * mixing below */
+        GstAdderInput input;
 
-        gst_buffer_map (inbuf, &inmap, GST_MAP_READ);
+        input.buf = inbuf;
+        gst_buffer_map (inbuf, &input.map, GST_MAP_READ);
 
         /* all buffers should have outsize, there are no short buffers because we
          * asked for the max size above */
-        g_assert (inmap.size == outmap.size);
-
-        GST_LOG_OBJECT (adder, "channel %p: mixing %" G_GSIZE_FORMAT " bytes"
-            " from data %p", collect_data, inmap.size, inmap.data);
-
-        /* further buffers, need to add them */
-        if (pad->volume == 1.0) {
-          switch (adder->info.finfo->format) {
-            case GST_AUDIO_FORMAT_U8:
-              adder_orc_add_u8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S8:
-              adder_orc_add_s8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U16:
-              adder_orc_add_u16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S16:
-              adder_orc_add_s16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U32:
-              adder_orc_add_u32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S32:
-              adder_orc_add_s32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F32:
-              adder_orc_add_f32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F64:
-              adder_orc_add_f64 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            default:
-              g_assert_not_reached ();
-              break;
-          }
-        } else {
-          switch (adder->info.finfo->format) {
-            case GST_AUDIO_FORMAT_U8:
-              adder_orc_add_volume_u8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i8, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S8:
-              adder_orc_add_volume_s8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i8, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U16:
-              adder_orc_add_volume_u16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i16, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S16:
-              adder_orc_add_volume_s16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i16, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U32:
-              adder_orc_add_volume_u32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i32, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S32:
-              adder_orc_add_volume_s32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i32, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F32:
-              adder_orc_add_volume_f32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F64:
-              adder_orc_add_volume_f64 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume, inmap.size / bps);
-              break;
-            default:
-              g_assert_not_reached ();
-              break;
-          }
-        }
-        gst_buffer_unmap (inbuf, &inmap);
+        g_assert (input.map.size == outmap.size);
+
+        GST_LOG_OBJECT (adder, "channel %p: queueing %" G_GSIZE_FORMAT " bytes"
+            " from data %p", collect_data, input.map.size, input.map.data);
+
+        input.volume = pad->volume;
+        input.volume_i8 = pad->volume_i8;
+        input.volume_i16 = pad->volume_i16;
+        input.volume_i32 = pad->volume_i32;
+        g_array_append_val (inputs, input);
       } else {
         /* skip gap buffer */
         GST_LOG_OBJECT (adder, "channel %p: skipping GAP buffer", collect_data);
+        gst_buffer_unref (inbuf);
       }
-      gst_buffer_unref (inbuf);
     }
     GST_OBJECT_UNLOCK (pad);
   }
 
+  /* add the queued buffers to the output buffer */
+  if (outbuf && inputs->len > 0)
+    gst_adder_mix_inputs (adder, (GstAdderInput *) inputs->data, inputs->len,
+        outmap.data, outmap.size);
+
+  for (i = 0; i < inputs->len; i++) {
+    GstAdderInput *input = &g_array_index (inputs, GstAdderInput, i);
+
+    gst_buffer_unmap (input->buf, &input->map);
+    gst_buffer_unref (input->buf);
+  }
+  g_array_set_size (inputs, 0);
+
   if (outbuf)
     gst_buffer_unmap (outbuf, &outmap);
 
@@ -1517,6 +1762,10 @@ gst_adder_change_state (GstElement * element, GstStateChange transition)
       gst_caps_replace (&adder->current_caps, NULL);
       gst_segment_init (&adder->segment, GST_FORMAT_TIME);
       gst_collect_pads_start (adder->collect);
+      adder->mix_threads = g_get_num_processors ();
+      if (adder->mix_threads > 1 && adder->mix_pool == NULL)
+        adder->mix_pool = g_thread_pool_new (gst_adder_mix_slice_func, adder,
+            adder->mix_threads - 1, FALSE, NULL);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
       break;
@@ -1532,6 +1781,13 @@ gst_adder_change_state (GstElement * element, GstStateChange transition)
   ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
 
   switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      /* streaming has stopped now, no mixing can be in progress */
+      if (adder->mix_pool) {
+        g_thread_pool_free (adder->mix_pool, FALSE, TRUE);
+        adder->mix_pool = NULL;
+      }
+      break;
     default:
       break;
   }
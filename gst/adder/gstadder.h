@@ -73,9 +73,18 @@ struct _GstAdder {
 
   /* Pending inline events */
   GList *pending_events;
-  
+
   gboolean send_stream_start;
   gboolean send_caps;
+
+  /* worker pool for partitioned mixing with many sinkpads */
+  GThreadPool    *mix_pool;
+  guint           mix_threads;
+  GMutex          mix_lock;
+  GCond           mix_cond;
+  guint           mix_pending;
+  /* input buffers queued for mixing, reused between cycles */
+  GArray         *mix_inputs;
 };
 
 struct _GstAdderClass {
@@ -99,6 +108,12 @@ struct _GstAdderPad {
   gint volume_i16;
   gint volume_i8;
   gboolean mute;
+
+  /* converts this pad's input to the mix format when its caps differ
+   * from the negotiated mix caps; NULL when the input matches. Only
+   * touched from this pad's streaming thread */
+  GstAudioInfo in_info;
+  GstAudioConverter *converter;
 };
 
 struct _GstAdderPadClass {
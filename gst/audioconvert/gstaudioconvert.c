@@ -98,6 +98,27 @@ static void gst_audio_convert_set_property (GObject * object, guint prop_id,
 static void gst_audio_convert_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 
+/* maximum number of memoized transform_caps results */
+#define TRANSFORM_CAPS_CACHE_SIZE 8
+
+typedef struct
+{
+  GstPadDirection direction;
+  GstCaps *caps;
+  GstCaps *filter;
+  GstCaps *result;
+} TransformCapsCacheEntry;
+
+static void
+transform_caps_cache_entry_free (TransformCapsCacheEntry * entry)
+{
+  gst_caps_unref (entry->caps);
+  if (entry->filter)
+    gst_caps_unref (entry->filter);
+  gst_caps_unref (entry->result);
+  g_slice_free (TransformCapsCacheEntry, entry);
+}
+
 /* AudioConvert signals and args */
 enum
 {
@@ -197,6 +218,8 @@ gst_audio_convert_init (GstAudioConvert * this)
   this->dither = GST_AUDIO_DITHER_TPDF;
   this->ns = GST_AUDIO_NOISE_SHAPING_NONE;
 
+  g_queue_init (&this->transform_caps_cache);
+
   gst_base_transform_set_gap_aware (GST_BASE_TRANSFORM (this), TRUE);
 }
 
@@ -210,6 +233,10 @@ gst_audio_convert_dispose (GObject * obj)
     this->convert = NULL;
   }
 
+  g_queue_foreach (&this->transform_caps_cache,
+      (GFunc) transform_caps_cache_entry_free, NULL);
+  g_queue_clear (&this->transform_caps_cache);
+
   G_OBJECT_CLASS (parent_class)->dispose (obj);
 }
 
@@ -284,13 +311,44 @@ gst_audio_convert_caps_remove_format_info (GstCaps * caps, gboolean channels)
 
 /* The caps can be transformed into any other caps with format info removed.
  * However, we should prefer passthrough, so if passthrough is possible,
- * put it first in the list. */
+ * put it first in the list.
+ *
+ * The result is a pure function of the inputs and caps are immutable, so
+ * recent results are memoized to make the repeated renegotiations of
+ * dynamically routed pipelines cheap. */
 static GstCaps *
 gst_audio_convert_transform_caps (GstBaseTransform * btrans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter)
 {
+  GstAudioConvert *this = GST_AUDIO_CONVERT (btrans);
   GstCaps *tmp, *tmp2;
   GstCaps *result;
+  TransformCapsCacheEntry *entry;
+  GList *walk;
+
+  GST_OBJECT_LOCK (this);
+  for (walk = this->transform_caps_cache.head; walk; walk = walk->next) {
+    entry = walk->data;
+
+    if (entry->direction != direction)
+      continue;
+    if (entry->caps != caps && !gst_caps_is_strictly_equal (entry->caps, caps))
+      continue;
+    if (entry->filter != filter && (entry->filter == NULL || filter == NULL
+            || !gst_caps_is_strictly_equal (entry->filter, filter)))
+      continue;
+
+    /* keep the most recently used entry in front */
+    g_queue_unlink (&this->transform_caps_cache, walk);
+    g_queue_push_head_link (&this->transform_caps_cache, walk);
+    result = gst_caps_ref (entry->result);
+    GST_OBJECT_UNLOCK (this);
+
+    GST_DEBUG_OBJECT (btrans, "returning memoized transform of %"
+        GST_PTR_FORMAT ": %" GST_PTR_FORMAT, caps, result);
+    return result;
+  }
+  GST_OBJECT_UNLOCK (this);
 
   /* Get all possible caps that we can transform to */
   tmp = gst_audio_convert_caps_remove_format_info (caps, TRUE);
@@ -303,6 +361,19 @@ gst_audio_convert_transform_caps (GstBaseTransform * btrans,
 
   result = tmp;
 
+  entry = g_slice_new (TransformCapsCacheEntry);
+  entry->direction = direction;
+  entry->caps = gst_caps_ref (caps);
+  entry->filter = filter ? gst_caps_ref (filter) : NULL;
+  entry->result = gst_caps_ref (result);
+
+  GST_OBJECT_LOCK (this);
+  g_queue_push_head (&this->transform_caps_cache, entry);
+  while (this->transform_caps_cache.length > TRANSFORM_CAPS_CACHE_SIZE)
+    transform_caps_cache_entry_free (g_queue_pop_tail
+        (&this->transform_caps_cache));
+  GST_OBJECT_UNLOCK (this);
+
   GST_DEBUG_OBJECT (btrans, "transformed %" GST_PTR_FORMAT " into %"
       GST_PTR_FORMAT, caps, result);
 
@@ -681,6 +752,11 @@ gst_audio_convert_set_caps (GstBaseTransform * base, GstCaps * incaps,
   in_place = gst_audio_converter_supports_inplace (this->convert);
   gst_base_transform_set_in_place (base, in_place);
 
+  /* forward the input buffers untouched when no conversion will happen,
+   * without even mapping them */
+  gst_base_transform_set_passthrough (base,
+      gst_audio_converter_is_passthrough (this->convert));
+
   this->in_info = in_info;
   this->out_info = out_info;
 
@@ -51,6 +51,9 @@ struct _GstAudioConvert
   GstAudioInfo in_info;
   GstAudioInfo out_info;
   GstAudioConverter *convert;
+
+  /* memoized transform_caps results, protected by the object lock */
+  GQueue transform_caps_cache;
 };
 
 struct _GstAudioConvertClass
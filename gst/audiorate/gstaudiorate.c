@@ -212,6 +212,36 @@ gst_audio_rate_reset (GstAudioRate * audiorate)
   GST_DEBUG_OBJECT (audiorate, "handle reset");
 }
 
+/* Get a buffer with @samples samples of silence. The payload is a slice of
+ * a pre-zeroed buffer that is kept around and shared between all fills for
+ * the current caps, so filling gaps doesn't allocate or clear memory.
+ * The caller gets its own metadata to timestamp but shares the memory. */
+static GstBuffer *
+gst_audio_rate_get_silence_buffer (GstAudioRate * audiorate, guint64 samples)
+{
+  gint bpf = GST_AUDIO_INFO_BPF (&audiorate->info);
+  gint rate = GST_AUDIO_INFO_RATE (&audiorate->info);
+
+  if (audiorate->silence_buf == NULL || audiorate->silence_samples < samples) {
+    GstMapInfo map;
+    /* never less than one second so consecutive small fills all slice the
+     * same buffer instead of growing it repeatedly */
+    guint64 buf_samples = MAX (samples, (guint64) rate);
+
+    if (audiorate->silence_buf)
+      gst_buffer_unref (audiorate->silence_buf);
+
+    audiorate->silence_buf = gst_buffer_new_and_alloc (buf_samples * bpf);
+    gst_buffer_map (audiorate->silence_buf, &map, GST_MAP_WRITE);
+    gst_audio_format_fill_silence (audiorate->info.finfo, map.data, map.size);
+    gst_buffer_unmap (audiorate->silence_buf, &map);
+    audiorate->silence_samples = buf_samples;
+  }
+
+  return gst_buffer_copy_region (audiorate->silence_buf,
+      GST_BUFFER_COPY_MEMORY, 0, samples * bpf);
+}
+
 static gboolean
 gst_audio_rate_setcaps (GstAudioRate * audiorate, GstCaps * caps)
 {
@@ -220,6 +250,14 @@ gst_audio_rate_setcaps (GstAudioRate * audiorate, GstCaps * caps)
   if (!gst_audio_info_from_caps (&info, caps))
     goto wrong_caps;
 
+  /* the silence buffer only matches the old sample layout */
+  if (audiorate->silence_buf &&
+      !gst_audio_info_is_equal (&info, &audiorate->info)) {
+    gst_buffer_unref (audiorate->silence_buf);
+    audiorate->silence_buf = NULL;
+    audiorate->silence_samples = 0;
+  }
+
   audiorate->info = info;
 
   return TRUE;
@@ -527,7 +565,6 @@ gst_audio_rate_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   /* do we need to insert samples */
   if (in_offset > audiorate->next_offset) {
     GstBuffer *fill;
-    gint fillsize;
     guint64 fillsamples;
 
     /* We don't want to allocate a single unreasonably huge buffer - it might
@@ -537,17 +574,10 @@ gst_audio_rate_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
     while (fillsamples > 0) {
       guint64 cursamples = MIN (fillsamples, rate);
-      GstMapInfo fillmap;
 
       fillsamples -= cursamples;
-      fillsize = cursamples * bpf;
 
-      fill = gst_buffer_new_and_alloc (fillsize);
-
-      gst_buffer_map (fill, &fillmap, GST_MAP_WRITE);
-      gst_audio_format_fill_silence (audiorate->info.finfo, fillmap.data,
-          fillmap.size);
-      gst_buffer_unmap (fill, &fillmap);
+      fill = gst_audio_rate_get_silence_buffer (audiorate, cursamples);
 
       GST_DEBUG_OBJECT (audiorate, "inserting %" G_GUINT64_FORMAT " samples",
           cursamples);
@@ -753,6 +783,11 @@ gst_audio_rate_change_state (GstElement * element, GstStateChange transition)
 
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      if (audiorate->silence_buf) {
+        gst_buffer_unref (audiorate->silence_buf);
+        audiorate->silence_buf = NULL;
+        audiorate->silence_samples = 0;
+      }
       break;
     case GST_STATE_CHANGE_READY_TO_PAUSED:
       audiorate->in = 0;
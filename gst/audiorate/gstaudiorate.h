@@ -65,6 +65,10 @@ struct _GstAudioRate
 
   gboolean discont;
 
+  /* pre-zeroed buffer whose memory is shared between gap fills */
+  GstBuffer *silence_buf;
+  guint64 silence_samples;
+
   gboolean new_segment;
   /* we accept all formats on the sink */
   GstSegment sink_segment;
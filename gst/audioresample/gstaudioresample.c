@@ -73,6 +73,12 @@ GST_DEBUG_CATEGORY_STATIC (GST_CAT_PERFORMANCE);
 #define DEFAULT_SINC_FILTER_MODE GST_AUDIO_RESAMPLER_FILTER_MODE_AUTO
 #define DEFAULT_SINC_FILTER_AUTO_THRESHOLD (1*1048576)
 #define DEFAULT_SINC_FILTER_INTERPOLATION GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_CUBIC
+#define DEFAULT_DRIFT_PPM 0.0
+
+/* both configured rates are scaled by this factor before they are given to
+ * the converter, so that the sub-Hz rate offset expressed by drift-ppm
+ * survives the integer rate interface */
+#define DRIFT_RATE_SCALE 4096
 
 enum
 {
@@ -81,7 +87,8 @@ enum
   PROP_RESAMPLE_METHOD,
   PROP_SINC_FILTER_MODE,
   PROP_SINC_FILTER_AUTO_THRESHOLD,
-  PROP_SINC_FILTER_INTERPOLATION
+  PROP_SINC_FILTER_INTERPOLATION,
+  PROP_DRIFT_PPM
 };
 
 #define SUPPORTED_CAPS \
@@ -177,6 +184,25 @@ gst_audio_resample_class_init (GstAudioResampleClass * klass)
           DEFAULT_SINC_FILTER_INTERPOLATION,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioResample:drift-ppm:
+   *
+   * Fractional offset, in parts per million, applied to the configured
+   * input rate. A positive value consumes input slightly faster, a
+   * negative value slightly slower. The resampler is retuned in place
+   * without caps renegotiation, so clock-slaving pipelines can correct
+   * drift continuously and glitch-free.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_DRIFT_PPM,
+      g_param_spec_double ("drift-ppm", "Drift (ppm)",
+          "Fractional adjustment of the input rate in parts per million, "
+          "applied without renegotiation", -10000.0, 10000.0,
+          DEFAULT_DRIFT_PPM,
+          G_PARAM_READWRITE | GST_PARAM_CONTROLLABLE |
+          GST_PARAM_MUTABLE_PLAYING | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_static_pad_template (gstelement_class,
       &gst_audio_resample_src_template);
   gst_element_class_add_static_pad_template (gstelement_class,
@@ -378,6 +404,25 @@ make_options (GstAudioResample * resample, GstAudioInfo * in,
   return options;
 }
 
+/* compute the rates handed to the converter, with the drift-ppm offset
+ * folded into a scaled-up integer rate pair */
+static void
+gst_audio_resample_get_drift_rates (GstAudioResample * resample, gint in_rate,
+    gint out_rate, gint * eff_in_rate, gint * eff_out_rate)
+{
+  gdouble ppm = resample->drift_ppm;
+
+  if (ppm == 0.0) {
+    *eff_in_rate = in_rate;
+    *eff_out_rate = out_rate;
+    return;
+  }
+
+  *eff_in_rate = (gint) (in_rate * (gdouble) DRIFT_RATE_SCALE *
+      (1.0 + ppm / 1000000.0) + 0.5);
+  *eff_out_rate = out_rate * DRIFT_RATE_SCALE;
+}
+
 static gboolean
 gst_audio_resample_update_state (GstAudioResample * resample, GstAudioInfo * in,
     GstAudioInfo * out)
@@ -407,12 +452,25 @@ gst_audio_resample_update_state (GstAudioResample * resample, GstAudioInfo * in,
         out, options);
     if (resample->converter == NULL)
       goto resampler_failed;
+    /* fold a configured drift into the freshly created converter */
+    if (in && out && resample->drift_ppm != 0.0) {
+      gint eff_in_rate, eff_out_rate;
+
+      gst_audio_resample_get_drift_rates (resample, in->rate, out->rate,
+          &eff_in_rate, &eff_out_rate);
+      if (!gst_audio_converter_update_config (resample->converter, eff_in_rate,
+              eff_out_rate, NULL))
+        goto update_failed;
+    }
   } else if (in && out) {
     gboolean ret;
+    gint eff_in_rate, eff_out_rate;
 
+    gst_audio_resample_get_drift_rates (resample, in->rate, out->rate,
+        &eff_in_rate, &eff_out_rate);
     ret =
-        gst_audio_converter_update_config (resample->converter, in->rate,
-        out->rate, options);
+        gst_audio_converter_update_config (resample->converter, eff_in_rate,
+        eff_out_rate, options);
     if (!ret)
       goto update_failed;
   } else {
@@ -1042,6 +1100,23 @@ gst_audio_resample_set_property (GObject * object, guint prop_id,
       resample->sinc_filter_interpolation = g_value_get_enum (value);
       gst_audio_resample_update_state (resample, NULL, NULL);
       break;
+    case PROP_DRIFT_PPM:
+      /* FIXME locking! */
+      resample->drift_ppm = g_value_get_double (value);
+      GST_DEBUG_OBJECT (resample, "new drift %f ppm", resample->drift_ppm);
+      /* a non-zero drift needs the resampler in the dataflow even when the
+       * rates match; restore passthrough when the drift is removed */
+      if (resample->drift_ppm != 0.0)
+        gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (resample),
+            FALSE);
+      else if (resample->in.rate != 0
+          && resample->in.rate == resample->out.rate)
+        gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (resample),
+            TRUE);
+      if (resample->converter)
+        gst_audio_resample_update_state (resample, &resample->in,
+            &resample->out);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1072,6 +1147,9 @@ gst_audio_resample_get_property (GObject * object, guint prop_id,
     case PROP_SINC_FILTER_INTERPOLATION:
       g_value_set_enum (value, resample->sinc_filter_interpolation);
       break;
+    case PROP_DRIFT_PPM:
+      g_value_set_double (value, resample->drift_ppm);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
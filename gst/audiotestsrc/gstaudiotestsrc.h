@@ -137,6 +137,8 @@ struct _GstAudioTestSrc {
   GstPinkNoise pink;
   GstRedNoise red;
   gdouble wave_table[1024];
+  /* unit-amplitude sine wavetable with a guard entry for interpolation */
+  gdouble osc_table[1025];
 };
 
 struct _GstAudioTestSrcClass {
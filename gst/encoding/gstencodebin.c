@@ -174,6 +174,7 @@ struct _GstEncodeBin
   guint queue_buffers_max;
   guint queue_bytes_max;
   guint64 queue_time_max;
+  gboolean adaptive_queue_limits;
 
   guint64 tolerance;
   gboolean avoid_reencoding;
@@ -212,6 +213,10 @@ struct _StreamGroup
   GstElement *formatter;
   GstElement *outqueue;         /* Queue just before the muxer */
   gulong restriction_sid;
+  gulong inqueue_overrun_sid;
+  gulong outqueue_overrun_sid;
+  guint inqueue_growth;
+  guint outqueue_growth;
 };
 
 /* Default for queues (same defaults as queue element) */
@@ -220,8 +225,13 @@ struct _StreamGroup
 #define DEFAULT_QUEUE_TIME_MAX     GST_SECOND
 #define DEFAULT_AUDIO_JITTER_TOLERANCE 20 * GST_MSECOND
 #define DEFAULT_AVOID_REENCODING   FALSE
+#define DEFAULT_ADAPTIVE_QUEUE_LIMITS FALSE
 #define DEFAULT_FLAGS              0
 
+/* Maximum number of times an adaptive queue may double its limits,
+ * i.e. queues can grow up to 2^3 = 8 times the configured sizes */
+#define MAX_QUEUE_GROWTH 3
+
 #define DEFAULT_RAW_CAPS			\
   "video/x-raw; "				\
   "audio/x-raw; "				\
@@ -239,6 +249,7 @@ enum
   PROP_QUEUE_TIME_MAX,
   PROP_AUDIO_JITTER_TOLERANCE,
   PROP_AVOID_REENCODING,
+  PROP_ADAPTIVE_QUEUE_LIMITS,
   PROP_FLAGS
 };
 
@@ -372,6 +383,23 @@ gst_encode_bin_class_init (GstEncodeBinClass * klass)
           DEFAULT_AVOID_REENCODING,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstEncodeBin:adaptive-queue-limits:
+   *
+   * Whether the queues of the different stream branches may grow beyond
+   * their configured limits, up to eight times the configured sizes, when
+   * they fill up. When several branches encode in parallel this keeps one
+   * temporarily slow encoder from stalling upstream and starving the
+   * encoders of all the other branches.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_klass, PROP_ADAPTIVE_QUEUE_LIMITS,
+      g_param_spec_boolean ("adaptive-queue-limits", "Adaptive queue limits",
+          "Grow stream queues beyond their configured limits when they fill up",
+          DEFAULT_ADAPTIVE_QUEUE_LIMITS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstEncodeBin:flags
    *
@@ -512,6 +540,7 @@ gst_encode_bin_init (GstEncodeBin * encode_bin)
   encode_bin->queue_time_max = DEFAULT_QUEUE_TIME_MAX;
   encode_bin->tolerance = DEFAULT_AUDIO_JITTER_TOLERANCE;
   encode_bin->avoid_reencoding = DEFAULT_AVOID_REENCODING;
+  encode_bin->adaptive_queue_limits = DEFAULT_ADAPTIVE_QUEUE_LIMITS;
   encode_bin->flags = DEFAULT_FLAGS;
 
   tmpl = gst_static_pad_template_get (&muxer_src_template);
@@ -547,6 +576,9 @@ gst_encode_bin_set_property (GObject * object, guint prop_id,
     case PROP_AVOID_REENCODING:
       ebin->avoid_reencoding = g_value_get_boolean (value);
       break;
+    case PROP_ADAPTIVE_QUEUE_LIMITS:
+      ebin->adaptive_queue_limits = g_value_get_boolean (value);
+      break;
     case PROP_FLAGS:
       ebin->flags = g_value_get_flags (value);
       break;
@@ -581,6 +613,9 @@ gst_encode_bin_get_property (GObject * object, guint prop_id,
     case PROP_AVOID_REENCODING:
       g_value_set_boolean (value, ebin->avoid_reencoding);
       break;
+    case PROP_ADAPTIVE_QUEUE_LIMITS:
+      g_value_set_boolean (value, ebin->adaptive_queue_limits);
+      break;
     case PROP_FLAGS:
       g_value_set_flags (value, ebin->flags);
       break;
@@ -1201,6 +1236,54 @@ _set_up_fake_encoder_pad_probe (GstEncodeBin * ebin, StreamGroup * sgroup)
  * encoder_not_found: If non NULL, set to TRUE if failure happened because
  * the encoder could not be found
  */
+/* Called from a queue's streaming thread when it fills up, meaning the
+ * branch downstream of it is slower than the producer. With adaptive queue
+ * limits enabled we bump the limits of that queue, up to 2^MAX_QUEUE_GROWTH
+ * times the configured sizes, so a slow branch buffers more instead of
+ * throttling upstream and, with it, all the other branches. */
+static void
+stream_group_queue_overrun_cb (GstElement * queue, StreamGroup * sgroup)
+{
+  GstEncodeBin *ebin = sgroup->ebin;
+  guint shift;
+
+  if (!ebin->adaptive_queue_limits)
+    return;
+
+  GST_OBJECT_LOCK (ebin);
+  if (queue == sgroup->inqueue) {
+    if (sgroup->inqueue_growth >= MAX_QUEUE_GROWTH) {
+      GST_OBJECT_UNLOCK (ebin);
+      return;
+    }
+    shift = ++sgroup->inqueue_growth;
+  } else {
+    if (sgroup->outqueue_growth >= MAX_QUEUE_GROWTH) {
+      GST_OBJECT_UNLOCK (ebin);
+      return;
+    }
+    shift = ++sgroup->outqueue_growth;
+  }
+  GST_OBJECT_UNLOCK (ebin);
+
+  GST_DEBUG_OBJECT (ebin,
+      "%s of stream group %p is full, growing its limits to %ux the "
+      "configured sizes", GST_ELEMENT_NAME (queue), sgroup, 1 << shift);
+
+  if (queue == sgroup->inqueue) {
+    g_object_set (queue,
+        "max-size-buffers", ebin->queue_buffers_max ?
+        (guint) (ebin->queue_buffers_max << shift) : 0,
+        "max-size-bytes", ebin->queue_bytes_max ?
+        (guint) (ebin->queue_bytes_max << shift) : 0,
+        "max-size-time", ebin->queue_time_max ?
+        (guint64) (ebin->queue_time_max << shift) : 0, NULL);
+  } else {
+    g_object_set (queue,
+        "max-size-time", (guint64) ((3 * GST_SECOND) << shift), NULL);
+  }
+}
+
 static StreamGroup *
 _create_stream_group (GstEncodeBin * ebin, GstEncodingProfile * sprof,
     const gchar * sinkpadname, GstCaps * sinkcaps, gboolean * encoder_not_found)
@@ -1252,6 +1335,8 @@ _create_stream_group (GstEncodeBin * ebin, GstEncodingProfile * sprof,
   g_object_set (sgroup->outqueue, "max-size-buffers", (guint) 0,
       "max-size-bytes", (guint) 0, "max-size-time", (guint64) 3 * GST_SECOND,
       "silent", TRUE, NULL);
+  sgroup->outqueue_overrun_sid = g_signal_connect (sgroup->outqueue,
+      "overrun", G_CALLBACK (stream_group_queue_overrun_cb), sgroup);
 
   gst_bin_add (GST_BIN (ebin), sgroup->outqueue);
   tosync = g_list_append (tosync, sgroup->outqueue);
@@ -1331,6 +1416,8 @@ _create_stream_group (GstEncodeBin * ebin, GstEncodingProfile * sprof,
       (guint) ebin->queue_buffers_max, "max-size-bytes",
       (guint) ebin->queue_bytes_max, "max-size-time",
       (guint64) ebin->queue_time_max, "silent", TRUE, NULL);
+  sgroup->inqueue_overrun_sid = g_signal_connect (sgroup->inqueue,
+      "overrun", G_CALLBACK (stream_group_queue_overrun_cb), sgroup);
 
   gst_bin_add (GST_BIN (ebin), sgroup->inqueue);
   tosync = g_list_append (tosync, sgroup->inqueue);
@@ -2021,6 +2108,12 @@ stream_group_free (GstEncodeBin * ebin, StreamGroup * sgroup)
   if (sgroup->restriction_sid != 0)
     g_signal_handler_disconnect (sgroup->profile, sgroup->restriction_sid);
 
+  if (sgroup->inqueue_overrun_sid != 0)
+    g_signal_handler_disconnect (sgroup->inqueue, sgroup->inqueue_overrun_sid);
+  if (sgroup->outqueue_overrun_sid != 0)
+    g_signal_handler_disconnect (sgroup->outqueue,
+        sgroup->outqueue_overrun_sid);
+
   if (sgroup->outqueue) {
     if (ebin->muxer) {
       /* outqueue - Muxer */
@@ -65,6 +65,29 @@ enum
       /* FILL ME */
 };
 
+/* Maximum number of buffers awaiting the output thread before the
+ * streaming thread is made to wait */
+#define MAX_OUTPUT_QUEUED_BUFFERS 100
+
+/* A unit of work for the output thread : either a GOP that needs to go
+ * through the internal decoder/encoder, or buffers to push through
+ * unmodified */
+typedef struct
+{
+  gboolean reencode;
+  GList *buffers;               /* of GstBuffer */
+  GstEvent *newsegment;         /* segment to re-encode against, if reencode */
+} SmartEncoderOutputItem;
+
+static void
+smart_encoder_output_item_free (SmartEncoderOutputItem * item)
+{
+  g_list_free_full (item->buffers, (GDestroyNotify) gst_buffer_unref);
+  if (item->newsegment)
+    gst_event_unref (item->newsegment);
+  g_slice_free (SmartEncoderOutputItem, item);
+}
+
 static void
 _do_init (void)
 {
@@ -75,6 +98,7 @@ G_DEFINE_TYPE_EXTENDED (GstSmartEncoder, gst_smart_encoder, GST_TYPE_ELEMENT, 0,
     _do_init ());
 
 static void gst_smart_encoder_dispose (GObject * object);
+static void gst_smart_encoder_finalize (GObject * object);
 
 static gboolean setup_recoder_pipeline (GstSmartEncoder * smart_encoder);
 
@@ -109,6 +133,7 @@ gst_smart_encoder_class_init (GstSmartEncoderClass * klass)
       "Edward Hervey <bilboed@gmail.com>");
 
   gobject_class->dispose = (GObjectFinalizeFunc) (gst_smart_encoder_dispose);
+  gobject_class->finalize = gst_smart_encoder_finalize;
   element_class->change_state = gst_smart_encoder_change_state;
 
   GST_DEBUG_CATEGORY_INIT (smart_encoder_debug, "smartencoder", 0,
@@ -163,6 +188,10 @@ gst_smart_encoder_init (GstSmartEncoder * smart_encoder)
 
   smart_encoder->segment = gst_segment_new ();
 
+  g_mutex_init (&smart_encoder->output_lock);
+  g_cond_init (&smart_encoder->output_cond);
+  g_queue_init (&smart_encoder->output_queue);
+
   smart_encoder_reset (smart_encoder);
 }
 
@@ -180,8 +209,20 @@ gst_smart_encoder_dispose (GObject * object)
   G_OBJECT_CLASS (gst_smart_encoder_parent_class)->dispose (object);
 }
 
+static void
+gst_smart_encoder_finalize (GObject * object)
+{
+  GstSmartEncoder *smart_encoder = (GstSmartEncoder *) object;
+
+  g_mutex_clear (&smart_encoder->output_lock);
+  g_cond_clear (&smart_encoder->output_cond);
+
+  G_OBJECT_CLASS (gst_smart_encoder_parent_class)->finalize (object);
+}
+
 static GstFlowReturn
-gst_smart_encoder_reencode_gop (GstSmartEncoder * smart_encoder)
+gst_smart_encoder_reencode_gop (GstSmartEncoder * smart_encoder, GList * gop,
+    GstEvent * newsegment)
 {
   GstFlowReturn res = GST_FLOW_OK;
   GList *tmp;
@@ -203,14 +244,15 @@ gst_smart_encoder_reencode_gop (GstSmartEncoder * smart_encoder)
       gst_event_new_flush_stop (TRUE));
 
   /* push newsegment */
-  GST_INFO ("Pushing newsegment %" GST_PTR_FORMAT, smart_encoder->newsegment);
-  gst_pad_push_event (smart_encoder->internal_srcpad,
-      gst_event_ref (smart_encoder->newsegment));
+  GST_INFO ("Pushing newsegment %" GST_PTR_FORMAT, newsegment);
+  if (newsegment)
+    gst_pad_push_event (smart_encoder->internal_srcpad,
+        gst_event_ref (newsegment));
 
   /* Push buffers through our pads */
   GST_DEBUG ("Pushing pending buffers");
 
-  for (tmp = smart_encoder->pending_gop; tmp; tmp = tmp->next) {
+  for (tmp = gop; tmp; tmp = tmp->next) {
     GstBuffer *buf = (GstBuffer *) tmp->data;
 
     res = gst_pad_push (smart_encoder->internal_srcpad, buf);
@@ -221,7 +263,7 @@ gst_smart_encoder_reencode_gop (GstSmartEncoder * smart_encoder)
   if (G_UNLIKELY (res != GST_FLOW_OK)) {
     GST_WARNING ("Error pushing pending buffers : %s", gst_flow_get_name (res));
     /* Remove pending bfufers */
-    for (tmp = smart_encoder->pending_gop; tmp; tmp = tmp->next) {
+    for (tmp = gop; tmp; tmp = tmp->next) {
       gst_buffer_unref ((GstBuffer *) tmp->data);
     }
   } else {
@@ -234,17 +276,204 @@ gst_smart_encoder_reencode_gop (GstSmartEncoder * smart_encoder)
   gst_element_set_state (smart_encoder->encoder, GST_STATE_NULL);
   gst_element_set_state (smart_encoder->decoder, GST_STATE_NULL);
 
-  g_list_free (smart_encoder->pending_gop);
-  smart_encoder->pending_gop = NULL;
+  g_list_free (gop);
 
   return res;
 }
 
+/*****************************************
+ *             Output thread             *
+ *****************************************/
+
+/* Pops items off the output queue and pushes them downstream, either
+ * directly or through the internal re-encoding pipeline. Keeping this
+ * off the streaming thread means upstream can go on delivering (and we
+ * can go on accumulating) the next GOP while a boundary GOP is being
+ * re-encoded. Ordering is preserved since there is a single consumer. */
+static gpointer
+smart_encoder_output_thread (gpointer data)
+{
+  GstSmartEncoder *smart_encoder = (GstSmartEncoder *) data;
+
+  g_mutex_lock (&smart_encoder->output_lock);
+  while (smart_encoder->output_running) {
+    SmartEncoderOutputItem *item;
+    GstFlowReturn res = GST_FLOW_OK;
+
+    item = g_queue_pop_head (&smart_encoder->output_queue);
+    if (item == NULL) {
+      g_cond_wait (&smart_encoder->output_cond, &smart_encoder->output_lock);
+      continue;
+    }
+
+    smart_encoder->output_queued_buffers -= g_list_length (item->buffers);
+    smart_encoder->output_busy = TRUE;
+    /* Wake up a streaming thread waiting for room in the queue */
+    g_cond_broadcast (&smart_encoder->output_cond);
+    g_mutex_unlock (&smart_encoder->output_lock);
+
+    if (item->reencode) {
+      res = gst_smart_encoder_reencode_gop (smart_encoder, item->buffers,
+          item->newsegment);
+      /* the GOP list was consumed by the re-encode */
+      item->buffers = NULL;
+    } else {
+      while (item->buffers) {
+        GstBuffer *buf = (GstBuffer *) item->buffers->data;
+
+        item->buffers = g_list_delete_link (item->buffers, item->buffers);
+        if (G_LIKELY (res == GST_FLOW_OK))
+          res = gst_pad_push (smart_encoder->srcpad, buf);
+        else
+          gst_buffer_unref (buf);
+      }
+    }
+
+    smart_encoder_output_item_free (item);
+
+    g_mutex_lock (&smart_encoder->output_lock);
+    smart_encoder->output_busy = FALSE;
+    if (G_UNLIKELY (res != GST_FLOW_OK) && !smart_encoder->output_flushing
+        && smart_encoder->output_flow == GST_FLOW_OK) {
+      GST_DEBUG_OBJECT (smart_encoder, "Storing flow return %s",
+          gst_flow_get_name (res));
+      smart_encoder->output_flow = res;
+    }
+    /* Wake up anybody draining or waiting for room */
+    g_cond_broadcast (&smart_encoder->output_cond);
+  }
+  g_mutex_unlock (&smart_encoder->output_lock);
+
+  return NULL;
+}
+
+/* Queues buffers for the output thread, waiting if too much data is
+ * already pending. Takes ownership of @buffers. */
+static GstFlowReturn
+smart_encoder_enqueue_output (GstSmartEncoder * smart_encoder,
+    gboolean reencode, GList * buffers)
+{
+  SmartEncoderOutputItem *item;
+  guint n_buffers = g_list_length (buffers);
+  GstFlowReturn res;
+
+  g_mutex_lock (&smart_encoder->output_lock);
+  while (smart_encoder->output_running && !smart_encoder->output_flushing
+      && smart_encoder->output_flow == GST_FLOW_OK
+      && smart_encoder->output_queued_buffers > 0
+      && smart_encoder->output_queued_buffers + n_buffers >
+      MAX_OUTPUT_QUEUED_BUFFERS)
+    g_cond_wait (&smart_encoder->output_cond, &smart_encoder->output_lock);
+
+  res = smart_encoder->output_flow;
+  if (!smart_encoder->output_running || smart_encoder->output_flushing)
+    res = GST_FLOW_FLUSHING;
+
+  if (G_UNLIKELY (res != GST_FLOW_OK)) {
+    g_mutex_unlock (&smart_encoder->output_lock);
+    g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+    return res;
+  }
+
+  item = g_slice_new0 (SmartEncoderOutputItem);
+  item->reencode = reencode;
+  item->buffers = buffers;
+  if (reencode && smart_encoder->newsegment)
+    item->newsegment = gst_event_ref (smart_encoder->newsegment);
+
+  g_queue_push_tail (&smart_encoder->output_queue, item);
+  smart_encoder->output_queued_buffers += n_buffers;
+  g_cond_broadcast (&smart_encoder->output_cond);
+  g_mutex_unlock (&smart_encoder->output_lock);
+
+  return GST_FLOW_OK;
+}
+
+/* Waits until the output thread has pushed out everything that was
+ * queued, so serialized events can't overtake pending buffers. */
+static GstFlowReturn
+smart_encoder_drain_output (GstSmartEncoder * smart_encoder)
+{
+  GstFlowReturn res;
+
+  g_mutex_lock (&smart_encoder->output_lock);
+  while (smart_encoder->output_running && !smart_encoder->output_flushing
+      && smart_encoder->output_flow == GST_FLOW_OK
+      && (smart_encoder->output_queue.length > 0 || smart_encoder->output_busy))
+    g_cond_wait (&smart_encoder->output_cond, &smart_encoder->output_lock);
+  res = smart_encoder->output_flow;
+  g_mutex_unlock (&smart_encoder->output_lock);
+
+  return res;
+}
+
+/* Drops all queued items and waits for the item currently being
+ * processed, if any, to finish. The queue stays flushing until
+ * smart_encoder_unflush_output(). */
+static void
+smart_encoder_flush_output (GstSmartEncoder * smart_encoder)
+{
+  SmartEncoderOutputItem *item;
+
+  g_mutex_lock (&smart_encoder->output_lock);
+  smart_encoder->output_flushing = TRUE;
+  while ((item = g_queue_pop_head (&smart_encoder->output_queue)))
+    smart_encoder_output_item_free (item);
+  smart_encoder->output_queued_buffers = 0;
+  g_cond_broadcast (&smart_encoder->output_cond);
+  while (smart_encoder->output_busy)
+    g_cond_wait (&smart_encoder->output_cond, &smart_encoder->output_lock);
+  g_mutex_unlock (&smart_encoder->output_lock);
+}
+
+static void
+smart_encoder_unflush_output (GstSmartEncoder * smart_encoder)
+{
+  g_mutex_lock (&smart_encoder->output_lock);
+  smart_encoder->output_flushing = FALSE;
+  smart_encoder->output_flow = GST_FLOW_OK;
+  g_mutex_unlock (&smart_encoder->output_lock);
+}
+
+static void
+smart_encoder_start_output (GstSmartEncoder * smart_encoder)
+{
+  g_mutex_lock (&smart_encoder->output_lock);
+  smart_encoder->output_running = TRUE;
+  smart_encoder->output_flushing = FALSE;
+  smart_encoder->output_flow = GST_FLOW_OK;
+  g_mutex_unlock (&smart_encoder->output_lock);
+
+  smart_encoder->output_thread =
+      g_thread_new ("smartencoder-output", smart_encoder_output_thread,
+      smart_encoder);
+}
+
+static void
+smart_encoder_stop_output (GstSmartEncoder * smart_encoder)
+{
+  GThread *thread;
+  SmartEncoderOutputItem *item;
+
+  g_mutex_lock (&smart_encoder->output_lock);
+  smart_encoder->output_running = FALSE;
+  smart_encoder->output_flushing = TRUE;
+  while ((item = g_queue_pop_head (&smart_encoder->output_queue)))
+    smart_encoder_output_item_free (item);
+  smart_encoder->output_queued_buffers = 0;
+  g_cond_broadcast (&smart_encoder->output_cond);
+  thread = smart_encoder->output_thread;
+  smart_encoder->output_thread = NULL;
+  g_mutex_unlock (&smart_encoder->output_lock);
+
+  if (thread)
+    g_thread_join (thread);
+}
+
 static GstFlowReturn
 gst_smart_encoder_push_pending_gop (GstSmartEncoder * smart_encoder)
 {
   guint64 cstart, cstop;
-  GList *tmp;
   GstFlowReturn res = GST_FLOW_OK;
 
   GST_DEBUG ("Pushing pending GOP (%" GST_TIME_FORMAT " -- %" GST_TIME_FORMAT
@@ -258,31 +487,26 @@ gst_smart_encoder_push_pending_gop (GstSmartEncoder * smart_encoder)
         || (cstop != smart_encoder->gop_stop)) {
       GST_DEBUG ("GOP needs to be re-encoded from %" GST_TIME_FORMAT " to %"
           GST_TIME_FORMAT, GST_TIME_ARGS (cstart), GST_TIME_ARGS (cstop));
-      res = gst_smart_encoder_reencode_gop (smart_encoder);
+      res = smart_encoder_enqueue_output (smart_encoder, TRUE,
+          smart_encoder->pending_gop);
     } else {
       /* The whole GOP is within the segment, push all pending buffers downstream */
       GST_DEBUG ("GOP doesn't need to be modified, pushing downstream");
-      for (tmp = smart_encoder->pending_gop; tmp; tmp = tmp->next) {
-        GstBuffer *buf = (GstBuffer *) tmp->data;
-        res = gst_pad_push (smart_encoder->srcpad, buf);
-        if (G_UNLIKELY (res != GST_FLOW_OK))
-          break;
-      }
+      res = smart_encoder_enqueue_output (smart_encoder, FALSE,
+          smart_encoder->pending_gop);
     }
+    /* The output thread now owns the list */
+    smart_encoder->pending_gop = NULL;
   } else {
     /* The whole GOP is outside the segment, there's most likely
      * a bug somewhere. */
     GST_WARNING
         ("GOP is entirely outside of the segment, upstream gave us too much data");
-    for (tmp = smart_encoder->pending_gop; tmp; tmp = tmp->next) {
-      gst_buffer_unref ((GstBuffer *) tmp->data);
-    }
-  }
-
-  if (smart_encoder->pending_gop) {
-    g_list_free (smart_encoder->pending_gop);
+    g_list_free_full (smart_encoder->pending_gop,
+        (GDestroyNotify) gst_buffer_unref);
     smart_encoder->pending_gop = NULL;
   }
+
   smart_encoder->gop_start = GST_CLOCK_TIME_NONE;
   smart_encoder->gop_stop = GST_CLOCK_TIME_NONE;
 
@@ -298,6 +522,15 @@ gst_smart_encoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
   smart_encoder = GST_SMART_ENCODER (parent);
 
+  /* Report errors the output thread ran into downstream */
+  g_mutex_lock (&smart_encoder->output_lock);
+  res = smart_encoder->output_flow;
+  g_mutex_unlock (&smart_encoder->output_lock);
+  if (G_UNLIKELY (res != GST_FLOW_OK)) {
+    gst_buffer_unref (buf);
+    return res;
+  }
+
   discont = GST_BUFFER_IS_DISCONT (buf);
   keyframe = !GST_BUFFER_FLAG_IS_SET (buf, GST_BUFFER_FLAG_DELTA_UNIT);
 
@@ -347,11 +580,20 @@ smart_encoder_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
   GstSmartEncoder *smart_encoder = GST_SMART_ENCODER (parent);
 
   switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_FLUSH_START:
+      smart_encoder_flush_output (smart_encoder);
+      break;
     case GST_EVENT_FLUSH_STOP:
+      /* In case we never saw the FLUSH_START */
+      smart_encoder_flush_output (smart_encoder);
       smart_encoder_reset (smart_encoder);
+      smart_encoder_unflush_output (smart_encoder);
       break;
     case GST_EVENT_SEGMENT:
     {
+      /* Don't overtake buffers queued against the previous segment */
+      smart_encoder_drain_output (smart_encoder);
+
       gst_event_copy_segment (event, smart_encoder->segment);
 
       GST_DEBUG_OBJECT (smart_encoder, "segment: %" GST_SEGMENT_FORMAT,
@@ -373,6 +615,7 @@ smart_encoder_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
       GST_DEBUG ("Eos, flushing remaining data");
       if (smart_encoder->segment->format == GST_FORMAT_TIME)
         gst_smart_encoder_push_pending_gop (smart_encoder);
+      smart_encoder_drain_output (smart_encoder);
       break;
     default:
       break;
@@ -696,6 +939,9 @@ gst_smart_encoder_change_state (GstElement * element, GstStateChange transition)
           GST_STATE_CHANGE_FAILURE)
         goto beach;
       break;
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+      smart_encoder_start_output (smart_encoder);
+      break;
     default:
       break;
   }
@@ -706,6 +952,8 @@ gst_smart_encoder_change_state (GstElement * element, GstStateChange transition)
 
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      /* Stop the output thread before tearing down the elements it uses */
+      smart_encoder_stop_output (smart_encoder);
       smart_encoder_reset (smart_encoder);
       break;
     default:
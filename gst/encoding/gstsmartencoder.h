@@ -56,6 +56,18 @@ struct _GstSmartEncoder {
   GstElement *decoder;
   GstElement *encoder;
 
+  /* Output thread, decoupling boundary GOP re-encodes from the
+   * passthrough of the stream interior */
+  GThread *output_thread;
+  GMutex output_lock;
+  GCond output_cond;
+  GQueue output_queue;          /* of SmartEncoderOutputItem */
+  guint output_queued_buffers;  /* number of buffers in output_queue */
+  gboolean output_running;
+  gboolean output_busy;         /* an item is currently being processed */
+  gboolean output_flushing;
+  GstFlowReturn output_flow;
+
   /* Available caps at runtime */
   GstCaps *available_caps;
 };
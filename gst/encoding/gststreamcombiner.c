@@ -107,7 +107,8 @@ gst_stream_combiner_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   GstStreamCombiner *stream_combiner = (GstStreamCombiner *) parent;
   /* FIXME : IMPLEMENT */
 
-  /* with lock taken, check if we're the active stream, if not drop */
+  /* Lock-free : an atomic read of the active stream would be needed here
+   * to decide whether to drop, see _get_current_sinkpad() */
   return gst_pad_push (stream_combiner->srcpad, buf);
 }
 
@@ -168,19 +169,33 @@ gst_stream_combiner_sink_query (GstPad * pad, GstObject * parent,
   return gst_pad_peer_query (stream_combiner->srcpad, query);
 }
 
+/* Returns the active sinkpad. The current pad is read atomically so the
+ * steady state needs no lock; the lock is only taken for the fallback to
+ * the (writer-protected) list of sinkpads. */
+static GstPad *
+gst_stream_combiner_get_current_sinkpad (GstStreamCombiner * combiner)
+{
+  GstPad *sinkpad;
+
+  sinkpad = g_atomic_pointer_get (&combiner->current);
+  if (sinkpad == NULL) {
+    STREAMS_LOCK (combiner);
+    if (combiner->sinkpads)
+      sinkpad = (GstPad *) combiner->sinkpads->data;
+    STREAMS_UNLOCK (combiner);
+  }
+
+  return sinkpad;
+}
+
 static gboolean
 gst_stream_combiner_src_event (GstPad * pad, GstObject * parent,
     GstEvent * event)
 {
   GstStreamCombiner *stream_combiner = (GstStreamCombiner *) parent;
-  GstPad *sinkpad = NULL;
+  GstPad *sinkpad;
 
-  STREAMS_LOCK (stream_combiner);
-  if (stream_combiner->current)
-    sinkpad = stream_combiner->current;
-  else if (stream_combiner->sinkpads)
-    sinkpad = (GstPad *) stream_combiner->sinkpads->data;
-  STREAMS_UNLOCK (stream_combiner);
+  sinkpad = gst_stream_combiner_get_current_sinkpad (stream_combiner);
 
   if (sinkpad)
     /* Forward upstream as is */
@@ -202,12 +217,7 @@ gst_stream_combiner_src_query (GstPad * pad, GstObject * parent,
       ret = gst_pad_query_default (pad, parent, query);
       break;
     default:
-      STREAMS_LOCK (stream_combiner);
-      if (stream_combiner->current)
-        sinkpad = stream_combiner->current;
-      else if (stream_combiner->sinkpads)
-        sinkpad = (GstPad *) stream_combiner->sinkpads->data;
-      STREAMS_UNLOCK (stream_combiner);
+      sinkpad = gst_stream_combiner_get_current_sinkpad (stream_combiner);
 
       if (sinkpad)
         /* Forward upstream as is */
@@ -282,10 +292,10 @@ gst_stream_combiner_release_pad (GstElement * element, GstPad * pad)
         g_list_delete_link (stream_combiner->sinkpads, tmp);
     stream_combiner->cookie++;
 
-    if (pad == stream_combiner->current) {
+    if (pad == g_atomic_pointer_get (&stream_combiner->current)) {
       /* Deactivate current flow */
       GST_DEBUG_OBJECT (element, "Removed pad was the current one");
-      stream_combiner->current = NULL;
+      g_atomic_pointer_set (&stream_combiner->current, NULL);
     }
     GST_DEBUG_OBJECT (element, "Removing pad from ourself");
     gst_element_remove_pad (element, pad);
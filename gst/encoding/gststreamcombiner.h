@@ -38,11 +38,11 @@ struct _GstStreamCombiner {
   GstPad *srcpad;
 
   /* lock protects:
-   * * the current pad
+   * * updates to the current pad
    * * the list of srcpads
    */
   GMutex lock;
-  /* Currently activated srcpad */
+  /* Currently activated srcpad, read atomically without the lock */
   GstPad *current;
   GList *sinkpads;
   guint32 cookie;
@@ -118,17 +118,47 @@ gst_stream_splitter_push_pending_events (GstStreamSplitter * splitter,
   splitter->pending_events = NULL;
 }
 
+/* Takes a reference on the currently activated srcpad without taking the
+ * streams lock. Paired with gst_stream_splitter_set_current() which waits
+ * for concurrent readers before the old pad can go away. */
+static GstPad *
+gst_stream_splitter_get_current (GstStreamSplitter * splitter)
+{
+  GstPad *srcpad;
+
+  g_atomic_int_inc (&splitter->chain_entered);
+  srcpad = g_atomic_pointer_get (&splitter->current);
+  if (srcpad)
+    gst_object_ref (srcpad);
+  g_atomic_int_inc (&splitter->chain_exited);
+
+  return srcpad;
+}
+
+/* Atomically replaces the currently activated srcpad. Must be called with
+ * the streams lock held (it serializes writers), then waits until every
+ * reader that might have sampled the old pointer has taken its reference,
+ * RCU-style, so the old pad can safely be released afterwards. */
+static void
+gst_stream_splitter_set_current (GstStreamSplitter * splitter, GstPad * srcpad)
+{
+  gint entered;
+
+  g_atomic_pointer_set (&splitter->current, srcpad);
+
+  entered = g_atomic_int_get (&splitter->chain_entered);
+  while (g_atomic_int_get (&splitter->chain_exited) - entered < 0)
+    g_thread_yield ();
+}
+
 static GstFlowReturn
 gst_stream_splitter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 {
   GstStreamSplitter *stream_splitter = (GstStreamSplitter *) parent;
   GstFlowReturn res;
-  GstPad *srcpad = NULL;
+  GstPad *srcpad;
 
-  STREAMS_LOCK (stream_splitter);
-  if (stream_splitter->current)
-    srcpad = gst_object_ref (stream_splitter->current);
-  STREAMS_UNLOCK (stream_splitter);
+  srcpad = gst_stream_splitter_get_current (stream_splitter);
 
   if (G_UNLIKELY (srcpad == NULL))
     goto nopad;
@@ -195,7 +225,8 @@ gst_stream_splitter_sink_event (GstPad * pad, GstObject * parent,
     case GST_EVENT_FLUSH_STOP:
       toall = TRUE;
       STREAMS_LOCK (stream_splitter);
-      stream_splitter->pending_events = _flush_events (stream_splitter->current,
+      stream_splitter->pending_events =
+          _flush_events (g_atomic_pointer_get (&stream_splitter->current),
           stream_splitter->pending_events);
       STREAMS_UNLOCK (stream_splitter);
       break;
@@ -205,12 +236,7 @@ gst_stream_splitter_sink_event (GstPad * pad, GstObject * parent,
     case GST_EVENT_EOS:
 
       if (G_UNLIKELY (stream_splitter->pending_events)) {
-        GstPad *srcpad = NULL;
-
-        STREAMS_LOCK (stream_splitter);
-        if (stream_splitter->current)
-          srcpad = gst_object_ref (stream_splitter->current);
-        STREAMS_UNLOCK (stream_splitter);
+        GstPad *srcpad = gst_stream_splitter_get_current (stream_splitter);
 
         if (srcpad) {
           gst_stream_splitter_push_pending_events (stream_splitter, srcpad);
@@ -261,12 +287,11 @@ gst_stream_splitter_sink_event (GstPad * pad, GstObject * parent,
 
     /* Only send to current pad */
 
-    STREAMS_LOCK (stream_splitter);
-    pad = stream_splitter->current;
-    STREAMS_UNLOCK (stream_splitter);
-    if (pad)
+    pad = gst_stream_splitter_get_current (stream_splitter);
+    if (pad) {
       res = gst_pad_push_event (pad, event);
-    else {
+      gst_object_unref (pad);
+    } else {
       gst_event_unref (event);
       res = FALSE;
     }
@@ -453,7 +478,7 @@ resync:
     if (res) {
       /* FIXME : we need to switch properly */
       GST_DEBUG_OBJECT (srcpad, "Setting caps on this pad was successful");
-      stream_splitter->current = srcpad;
+      gst_stream_splitter_set_current (stream_splitter, srcpad);
       goto beach;
     }
     tmp = tmp->next;
@@ -514,10 +539,12 @@ gst_stream_splitter_release_pad (GstElement * element, GstPad * pad)
         g_list_delete_link (stream_splitter->srcpads, tmp);
     stream_splitter->cookie++;
 
-    if (pad == stream_splitter->current) {
-      /* Deactivate current flow */
+    if (pad == g_atomic_pointer_get (&stream_splitter->current)) {
+      /* Deactivate current flow. The grace period in _set_current()
+       * guarantees no chain function still holds a pointer to the pad
+       * without a reference once we remove it below. */
       GST_DEBUG_OBJECT (element, "Removed pad was the current one");
-      stream_splitter->current = NULL;
+      gst_stream_splitter_set_current (stream_splitter, NULL);
     }
 
     gst_element_remove_pad (element, pad);
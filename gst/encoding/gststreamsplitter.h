@@ -38,12 +38,16 @@ struct _GstStreamSplitter {
   GstPad *sinkpad;
 
   /* lock protects:
-   * * the current pad
+   * * updates to the current pad
    * * the list of srcpads
    */
   GMutex lock;
-  /* Currently activated srcpad */
+  /* Currently activated srcpad. Updated atomically (with lock held),
+   * read atomically without the lock in the chain function. */
   GstPad *current;
+  /* Grace period accounting for lock-free readers of @current */
+  gint chain_entered;
+  gint chain_exited;
   GList *srcpads;
   guint32 cookie;
 
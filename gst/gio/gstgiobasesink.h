@@ -25,6 +25,7 @@
 #include "gstgio.h"
 
 #include <gst/base/gstbasesink.h>
+#include <gst/base/gstadapter.h>
 
 G_BEGIN_DECLS
 
@@ -54,6 +55,13 @@ struct _GstGioBaseSink
 
   /* < private > */
   GOutputStream *stream;
+
+  /* write coalescing, only active when buffer-size > 0 */
+  guint buffer_size;
+  guint64 flush_timeout;
+  gsize chunk_size;
+  GstAdapter *write_adapter;
+  gint64 pending_since;
 };
 
 struct _GstGioBaseSinkClass 
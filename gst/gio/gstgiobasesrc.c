@@ -35,10 +35,22 @@ static GstStaticPadTemplate src_factory = GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS_ANY);
 
+#define DEFAULT_READAHEAD 0
+
+enum
+{
+  PROP_0,
+  PROP_READAHEAD
+};
+
 #define gst_gio_base_src_parent_class parent_class
 G_DEFINE_TYPE (GstGioBaseSrc, gst_gio_base_src, GST_TYPE_BASE_SRC);
 
 static void gst_gio_base_src_finalize (GObject * object);
+static void gst_gio_base_src_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_gio_base_src_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
 
 static gboolean gst_gio_base_src_start (GstBaseSrc * base_src);
 static gboolean gst_gio_base_src_stop (GstBaseSrc * base_src);
@@ -63,6 +75,24 @@ gst_gio_base_src_class_init (GstGioBaseSrcClass * klass)
       "GIO base source");
 
   gobject_class->finalize = gst_gio_base_src_finalize;
+  gobject_class->set_property = gst_gio_base_src_set_property;
+  gobject_class->get_property = gst_gio_base_src_get_property;
+
+  /**
+   * GstGioBaseSrc:readahead:
+   *
+   * Number of blocksize-sized chunks to prefetch ahead of the streaming
+   * thread with a background thread. This hides the per-request latency of
+   * slow backends like GVfs SMB or HTTP mounts for sequential reads.
+   * A value of 0 disables prefetching and reads synchronously as before.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_READAHEAD,
+      g_param_spec_uint ("readahead", "Readahead",
+          "Number of blocksize chunks to prefetch with a background thread "
+          "(0 = disabled)", 0, G_MAXUINT, DEFAULT_READAHEAD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_static_pad_template (gstelement_class, &src_factory);
 
@@ -82,6 +112,9 @@ static void
 gst_gio_base_src_init (GstGioBaseSrc * src)
 {
   src->cancel = g_cancellable_new ();
+  src->readahead = DEFAULT_READAHEAD;
+  g_mutex_init (&src->prefetch_lock);
+  g_cond_init (&src->prefetch_cond);
 }
 
 static void
@@ -94,6 +127,10 @@ gst_gio_base_src_finalize (GObject * object)
     src->cancel = NULL;
   }
 
+  g_mutex_clear (&src->prefetch_lock);
+  g_cond_clear (&src->prefetch_cond);
+  g_clear_error (&src->prefetch_error);
+
   if (src->stream) {
     g_object_unref (src->stream);
     src->stream = NULL;
@@ -107,11 +144,277 @@ gst_gio_base_src_finalize (GObject * object)
   GST_CALL_PARENT (G_OBJECT_CLASS, finalize, (object));
 }
 
+static void
+gst_gio_base_src_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstGioBaseSrc *src = GST_GIO_BASE_SRC (object);
+
+  switch (prop_id) {
+    case PROP_READAHEAD:
+      GST_OBJECT_LOCK (src);
+      /* takes effect on the next start */
+      src->readahead = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (src);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_gio_base_src_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstGioBaseSrc *src = GST_GIO_BASE_SRC (object);
+
+  switch (prop_id) {
+    case PROP_READAHEAD:
+      GST_OBJECT_LOCK (src);
+      g_value_set_uint (value, src->readahead);
+      GST_OBJECT_UNLOCK (src);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/* Background thread that keeps up to readahead * chunk_size bytes of
+ * upcoming stream data in the adapter. GIO only allows a single outstanding
+ * operation per stream, so the chunks are read sequentially; the win is that
+ * the next chunks are already in flight while the streaming thread consumes
+ * the current buffer. The thread is the only one touching the stream while
+ * it runs, seeks are handed to it via prefetch_need_seek. */
+static gpointer
+gst_gio_base_src_prefetch_loop (gpointer data)
+{
+  GstGioBaseSrc *src = GST_GIO_BASE_SRC (data);
+
+  g_mutex_lock (&src->prefetch_lock);
+  while (src->prefetch_running) {
+    guint64 generation;
+    GstMapInfo map;
+    GstMemory *mem;
+    gssize res;
+    GError *err = NULL;
+
+    if (src->prefetch_paused) {
+      g_cond_wait (&src->prefetch_cond, &src->prefetch_lock);
+      continue;
+    }
+
+    if (src->prefetch_need_seek) {
+      guint64 target = src->prefetch_offset;
+      gboolean success;
+
+      generation = src->prefetch_generation;
+      src->prefetch_busy = TRUE;
+      g_mutex_unlock (&src->prefetch_lock);
+
+      GST_DEBUG_OBJECT (src, "prefetcher seeking to %" G_GUINT64_FORMAT,
+          target);
+      success = g_seekable_seek (G_SEEKABLE (src->stream), target, G_SEEK_SET,
+          src->cancel, &err);
+
+      g_mutex_lock (&src->prefetch_lock);
+      src->prefetch_busy = FALSE;
+      if (generation != src->prefetch_generation) {
+        /* a newer seek was requested meanwhile, redo */
+        g_clear_error (&err);
+        g_cond_signal (&src->prefetch_cond);
+        continue;
+      }
+      src->prefetch_need_seek = FALSE;
+      if (!success && src->prefetch_error == NULL) {
+        src->prefetch_error = err;
+        err = NULL;
+      }
+      g_clear_error (&err);
+      g_cond_signal (&src->prefetch_cond);
+      continue;
+    }
+
+    if (src->prefetch_eos || src->prefetch_error != NULL ||
+        gst_adapter_available (src->prefetch_adapter) >=
+        src->readahead * src->chunk_size) {
+      g_cond_wait (&src->prefetch_cond, &src->prefetch_lock);
+      continue;
+    }
+
+    generation = src->prefetch_generation;
+    src->prefetch_busy = TRUE;
+    g_mutex_unlock (&src->prefetch_lock);
+
+    mem = gst_allocator_alloc (NULL, src->chunk_size, NULL);
+    if (mem == NULL) {
+      g_mutex_lock (&src->prefetch_lock);
+      src->prefetch_busy = FALSE;
+      src->prefetch_error = g_error_new (G_IO_ERROR, G_IO_ERROR_FAILED,
+          "Failed to allocate %" G_GSIZE_FORMAT " bytes", src->chunk_size);
+      g_cond_signal (&src->prefetch_cond);
+      continue;
+    }
+
+    gst_memory_map (mem, &map, GST_MAP_WRITE);
+    res = g_input_stream_read (G_INPUT_STREAM (src->stream), map.data,
+        src->chunk_size, src->cancel, &err);
+    gst_memory_unmap (mem, &map);
+
+    g_mutex_lock (&src->prefetch_lock);
+    src->prefetch_busy = FALSE;
+    if (generation != src->prefetch_generation || !src->prefetch_running) {
+      /* a seek or flush happened while we were reading, the data belongs
+       * to the old read position */
+      gst_memory_unref (mem);
+      g_clear_error (&err);
+      g_cond_signal (&src->prefetch_cond);
+      continue;
+    }
+
+    if (res > 0) {
+      GstBuffer *chunk = gst_buffer_new ();
+
+      gst_memory_resize (mem, 0, res);
+      gst_buffer_append_memory (chunk, mem);
+      gst_adapter_push (src->prefetch_adapter, chunk);
+      src->prefetch_offset += res;
+      GST_LOG_OBJECT (src, "prefetched %" G_GSSIZE_FORMAT " bytes, %"
+          G_GSIZE_FORMAT " available", res,
+          gst_adapter_available (src->prefetch_adapter));
+    } else if (res == 0) {
+      gst_memory_unref (mem);
+      GST_DEBUG_OBJECT (src, "prefetcher reached end of stream");
+      src->prefetch_eos = TRUE;
+    } else {
+      gst_memory_unref (mem);
+      if (src->prefetch_error == NULL) {
+        src->prefetch_error = err;
+        err = NULL;
+      }
+      g_clear_error (&err);
+    }
+    g_cond_signal (&src->prefetch_cond);
+  }
+  g_mutex_unlock (&src->prefetch_lock);
+
+  return NULL;
+}
+
+/* Restart the prefetcher at @offset, dropping all prefetched data. Called
+ * from the streaming thread when a seek is needed. */
+static void
+gst_gio_base_src_prefetch_restart (GstGioBaseSrc * src, guint64 offset)
+{
+  g_mutex_lock (&src->prefetch_lock);
+  GST_DEBUG_OBJECT (src, "restarting prefetcher at %" G_GUINT64_FORMAT,
+      offset);
+  gst_adapter_clear (src->prefetch_adapter);
+  src->prefetch_offset = offset;
+  src->prefetch_generation++;
+  src->prefetch_need_seek = TRUE;
+  src->prefetch_eos = FALSE;
+  g_clear_error (&src->prefetch_error);
+  g_cond_signal (&src->prefetch_cond);
+  g_mutex_unlock (&src->prefetch_lock);
+}
+
+/* Read like g_input_stream_read() but served from the prefetch adapter,
+ * blocking until the prefetcher has data, hits EOS or fails. */
+static gssize
+gst_gio_base_src_prefetch_read (GstGioBaseSrc * src, guint8 * data,
+    gsize count, GError ** err)
+{
+  gssize res;
+
+  g_mutex_lock (&src->prefetch_lock);
+  while (gst_adapter_available (src->prefetch_adapter) == 0) {
+    if (src->prefetch_error != NULL) {
+      g_propagate_error (err, src->prefetch_error);
+      src->prefetch_error = NULL;
+      /* let the prefetcher resume from its current position so a retry
+       * after FLUSHING can make progress again */
+      g_cond_signal (&src->prefetch_cond);
+      g_mutex_unlock (&src->prefetch_lock);
+      return -1;
+    }
+    if (src->prefetch_eos) {
+      g_mutex_unlock (&src->prefetch_lock);
+      return 0;
+    }
+    g_cond_wait (&src->prefetch_cond, &src->prefetch_lock);
+  }
+
+  res = MIN (count, gst_adapter_available (src->prefetch_adapter));
+  gst_adapter_copy (src->prefetch_adapter, data, 0, res);
+  gst_adapter_flush (src->prefetch_adapter, res);
+  g_cond_signal (&src->prefetch_cond);
+  g_mutex_unlock (&src->prefetch_lock);
+
+  return res;
+}
+
+/* Park the prefetcher so another thread can safely use the stream. GIO only
+ * allows one outstanding operation per stream, so this waits until the
+ * in-flight read or seek has finished. No-op when prefetching is disabled. */
+static void
+gst_gio_base_src_prefetch_pause (GstGioBaseSrc * src)
+{
+  if (src->prefetch_thread == NULL)
+    return;
+
+  g_mutex_lock (&src->prefetch_lock);
+  src->prefetch_paused = TRUE;
+  while (src->prefetch_busy)
+    g_cond_wait (&src->prefetch_cond, &src->prefetch_lock);
+  g_mutex_unlock (&src->prefetch_lock);
+}
+
+static void
+gst_gio_base_src_prefetch_resume (GstGioBaseSrc * src)
+{
+  if (src->prefetch_thread == NULL)
+    return;
+
+  g_mutex_lock (&src->prefetch_lock);
+  src->prefetch_paused = FALSE;
+  g_cond_signal (&src->prefetch_cond);
+  g_mutex_unlock (&src->prefetch_lock);
+}
+
+static void
+gst_gio_base_src_prefetch_stop (GstGioBaseSrc * src)
+{
+  if (src->prefetch_thread == NULL)
+    return;
+
+  GST_DEBUG_OBJECT (src, "stopping prefetcher");
+  g_mutex_lock (&src->prefetch_lock);
+  src->prefetch_running = FALSE;
+  g_cond_signal (&src->prefetch_cond);
+  g_mutex_unlock (&src->prefetch_lock);
+
+  /* wake the thread if it is blocked inside a read */
+  g_cancellable_cancel (src->cancel);
+  g_thread_join (src->prefetch_thread);
+  src->prefetch_thread = NULL;
+
+  /* the cancellable was fired for shutdown only, reset it for the
+   * remaining stream operations */
+  g_object_unref (src->cancel);
+  src->cancel = g_cancellable_new ();
+
+  g_clear_object (&src->prefetch_adapter);
+  g_clear_error (&src->prefetch_error);
+}
+
 static gboolean
 gst_gio_base_src_start (GstBaseSrc * base_src)
 {
   GstGioBaseSrc *src = GST_GIO_BASE_SRC (base_src);
   GstGioBaseSrcClass *gbsrc_class = GST_GIO_BASE_SRC_GET_CLASS (src);
+  guint readahead;
 
   src->position = 0;
 
@@ -130,6 +433,36 @@ gst_gio_base_src_start (GstBaseSrc * base_src)
   if (G_IS_SEEKABLE (src->stream))
     src->position = g_seekable_tell (G_SEEKABLE (src->stream));
 
+  GST_OBJECT_LOCK (src);
+  readahead = src->readahead;
+  GST_OBJECT_UNLOCK (src);
+
+  if (readahead > 0) {
+    GError *err = NULL;
+
+    src->chunk_size = MAX (4096, gst_base_src_get_blocksize (base_src));
+    src->prefetch_adapter = gst_adapter_new ();
+    src->prefetch_offset = src->position;
+    src->prefetch_generation = 0;
+    src->prefetch_need_seek = FALSE;
+    src->prefetch_paused = FALSE;
+    src->prefetch_busy = FALSE;
+    src->prefetch_eos = FALSE;
+    src->prefetch_running = TRUE;
+    src->prefetch_thread = g_thread_try_new ("giosrc-prefetch",
+        gst_gio_base_src_prefetch_loop, src, &err);
+    if (src->prefetch_thread == NULL) {
+      GST_WARNING_OBJECT (src, "Failed to start prefetch thread, falling "
+          "back to synchronous reads: %s", err->message);
+      g_clear_error (&err);
+      src->prefetch_running = FALSE;
+      g_clear_object (&src->prefetch_adapter);
+    } else {
+      GST_DEBUG_OBJECT (src, "prefetching %u chunks of %" G_GSIZE_FORMAT
+          " bytes", readahead, src->chunk_size);
+    }
+  }
+
   GST_DEBUG_OBJECT (src, "started source");
 
   return TRUE;
@@ -143,6 +476,8 @@ gst_gio_base_src_stop (GstBaseSrc * base_src)
   gboolean success;
   GError *err = NULL;
 
+  gst_gio_base_src_prefetch_stop (src);
+
   if (klass->close_on_stop && G_IS_INPUT_STREAM (src->stream)) {
     GST_DEBUG_OBJECT (src, "closing stream");
 
@@ -172,7 +507,7 @@ gst_gio_base_src_stop (GstBaseSrc * base_src)
 }
 
 static gboolean
-gst_gio_base_src_get_size (GstBaseSrc * base_src, guint64 * size)
+gst_gio_base_src_get_size_internal (GstBaseSrc * base_src, guint64 * size)
 {
   GstGioBaseSrc *src = GST_GIO_BASE_SRC (base_src);
 
@@ -253,6 +588,21 @@ gst_gio_base_src_get_size (GstBaseSrc * base_src, guint64 * size)
   return FALSE;
 }
 
+static gboolean
+gst_gio_base_src_get_size (GstBaseSrc * base_src, guint64 * size)
+{
+  GstGioBaseSrc *src = GST_GIO_BASE_SRC (base_src);
+  gboolean ret;
+
+  /* querying or seeking the stream must not overlap with a prefetch
+   * operation */
+  gst_gio_base_src_prefetch_pause (src);
+  ret = gst_gio_base_src_get_size_internal (base_src, size);
+  gst_gio_base_src_prefetch_resume (src);
+
+  return ret;
+}
+
 static gboolean
 gst_gio_base_src_is_seekable (GstBaseSrc * base_src)
 {
@@ -285,9 +635,22 @@ gst_gio_base_src_unlock_stop (GstBaseSrc * base_src)
 
   GST_LOG_OBJECT (src, "resetting cancellable");
 
+  /* wait until the prefetcher has left its (cancelled) stream operation
+   * before dropping the cancellable it is using */
+  gst_gio_base_src_prefetch_pause (src);
+
   g_object_unref (src->cancel);
   src->cancel = g_cancellable_new ();
 
+  if (src->prefetch_thread != NULL) {
+    /* drop a pending cancellation error so prefetching resumes cleanly */
+    g_mutex_lock (&src->prefetch_lock);
+    g_clear_error (&src->prefetch_error);
+    g_mutex_unlock (&src->prefetch_lock);
+  }
+
+  gst_gio_base_src_prefetch_resume (src);
+
   return TRUE;
 }
 
@@ -357,13 +720,21 @@ gst_gio_base_src_create (GstBaseSrc * base_src, guint64 offset, guint size,
 
       GST_DEBUG_OBJECT (src, "Seeking to position %" G_GUINT64_FORMAT,
           readoffset);
-      ret =
-          gst_gio_seek (src, G_SEEKABLE (src->stream), readoffset, src->cancel);
-
-      if (ret == GST_FLOW_OK)
+      if (src->prefetch_thread != NULL) {
+        /* the prefetcher owns the stream, let it do the seek and refill
+         * from the new position */
+        gst_gio_base_src_prefetch_restart (src, readoffset);
         src->position = readoffset;
-      else
-        return ret;
+      } else {
+        ret =
+            gst_gio_seek (src, G_SEEKABLE (src->stream), readoffset,
+            src->cancel);
+
+        if (ret == GST_FLOW_OK)
+          src->position = readoffset;
+        else
+          return ret;
+      }
     }
 
     /* GIO sometimes gives less bytes than requested although
@@ -379,7 +750,9 @@ gst_gio_base_src_create (GstBaseSrc * base_src, guint64 offset, guint size,
 
     gst_memory_map (mem, &map, GST_MAP_WRITE);
     streamread = 0;
-    while (size - read > 0 && (res =
+    while (size - read > 0 && (res = (src->prefetch_thread != NULL) ?
+            gst_gio_base_src_prefetch_read (src, map.data + streamread,
+                cachesize - streamread, &err) :
             g_input_stream_read (G_INPUT_STREAM (src->stream),
                 map.data + streamread, cachesize - streamread, src->cancel,
                 &err)) > 0) {
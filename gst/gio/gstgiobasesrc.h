@@ -25,6 +25,7 @@
 #include "gstgio.h"
 
 #include <gst/base/gstbasesrc.h>
+#include <gst/base/gstadapter.h>
 
 G_BEGIN_DECLS
 
@@ -55,6 +56,22 @@ struct _GstGioBaseSrc
   /* < private > */
   GInputStream *stream;
   GstBuffer *cache;
+
+  /* readahead prefetcher, only active when readahead > 0 */
+  guint readahead;
+  gsize chunk_size;
+  GThread *prefetch_thread;
+  GMutex prefetch_lock;
+  GCond prefetch_cond;
+  GstAdapter *prefetch_adapter;
+  guint64 prefetch_offset;
+  guint64 prefetch_generation;
+  gboolean prefetch_running;
+  gboolean prefetch_need_seek;
+  gboolean prefetch_paused;
+  gboolean prefetch_busy;
+  gboolean prefetch_eos;
+  GError *prefetch_error;
 };
 
 struct _GstGioBaseSrcClass 
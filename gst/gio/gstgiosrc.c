@@ -79,11 +79,14 @@
 GST_DEBUG_CATEGORY_STATIC (gst_gio_src_debug);
 #define GST_CAT_DEFAULT gst_gio_src_debug
 
+#define DEFAULT_USE_MMAP TRUE
+
 enum
 {
   PROP_0,
   PROP_LOCATION,
-  PROP_FILE
+  PROP_FILE,
+  PROP_USE_MMAP
 };
 
 #define gst_gio_src_parent_class parent_class
@@ -100,6 +103,10 @@ static void gst_gio_src_get_property (GObject * object, guint prop_id,
 static GInputStream *gst_gio_src_get_stream (GstGioBaseSrc * bsrc);
 
 static gboolean gst_gio_src_query (GstBaseSrc * base_src, GstQuery * query);
+static gboolean gst_gio_src_stop (GstBaseSrc * base_src);
+static gboolean gst_gio_src_get_size (GstBaseSrc * base_src, guint64 * size);
+static GstFlowReturn gst_gio_src_create (GstBaseSrc * base_src, guint64 offset,
+    guint size, GstBuffer ** buf);
 
 static void
 gst_gio_src_class_init (GstGioSrcClass * klass)
@@ -128,6 +135,22 @@ gst_gio_src_class_init (GstGioSrcClass * klass)
       g_param_spec_object ("file", "File", "GFile to read from",
           G_TYPE_FILE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstGioSrc:use-mmap:
+   *
+   * Memory-map local files and push buffers that are zero-copy slices
+   * of the mapping, so the page cache serves repeated streams of the
+   * same file directly without any read() copies. Non-native files and
+   * files that fail to map automatically fall back to the normal
+   * stream based reading.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_USE_MMAP,
+      g_param_spec_boolean ("use-mmap", "Use mmap",
+          "Serve local files as zero-copy slices of a memory mapping",
+          DEFAULT_USE_MMAP, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (gstelement_class, "GIO source",
       "Source/File",
       "Read from any GIO-supported location",
@@ -135,6 +158,9 @@ gst_gio_src_class_init (GstGioSrcClass * klass)
       "Sebastian Dröge <sebastian.droege@collabora.co.uk>");
 
   gstbasesrc_class->query = GST_DEBUG_FUNCPTR (gst_gio_src_query);
+  gstbasesrc_class->stop = GST_DEBUG_FUNCPTR (gst_gio_src_stop);
+  gstbasesrc_class->get_size = GST_DEBUG_FUNCPTR (gst_gio_src_get_size);
+  gstbasesrc_class->create = GST_DEBUG_FUNCPTR (gst_gio_src_create);
 
   gstgiobasesrc_class->get_stream = GST_DEBUG_FUNCPTR (gst_gio_src_get_stream);
   gstgiobasesrc_class->close_on_stop = TRUE;
@@ -143,6 +169,7 @@ gst_gio_src_class_init (GstGioSrcClass * klass)
 static void
 gst_gio_src_init (GstGioSrc * src)
 {
+  src->use_mmap = DEFAULT_USE_MMAP;
 }
 
 static void
@@ -155,6 +182,11 @@ gst_gio_src_finalize (GObject * object)
     src->file = NULL;
   }
 
+  if (src->mapped) {
+    g_mapped_file_unref (src->mapped);
+    src->mapped = NULL;
+  }
+
   GST_CALL_PARENT (G_OBJECT_CLASS, finalize, (object));
 }
 
@@ -207,6 +239,12 @@ gst_gio_src_set_property (GObject * object, guint prop_id,
 
       src->file = g_value_dup_object (value);
 
+      GST_OBJECT_UNLOCK (GST_OBJECT (src));
+      break;
+    case PROP_USE_MMAP:
+      GST_OBJECT_LOCK (GST_OBJECT (src));
+      /* takes effect on the next start */
+      src->use_mmap = g_value_get_boolean (value);
       GST_OBJECT_UNLOCK (GST_OBJECT (src));
       break;
     default:
@@ -241,6 +279,11 @@ gst_gio_src_get_property (GObject * object, guint prop_id,
       g_value_set_object (value, src->file);
       GST_OBJECT_UNLOCK (GST_OBJECT (src));
       break;
+    case PROP_USE_MMAP:
+      GST_OBJECT_LOCK (GST_OBJECT (src));
+      g_value_set_boolean (value, src->use_mmap);
+      GST_OBJECT_UNLOCK (GST_OBJECT (src));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -297,6 +340,92 @@ gst_gio_src_query (GstBaseSrc * base_src, GstQuery * query)
   return res;
 }
 
+/* Try to memory-map a native file so create() can push zero-copy slices
+ * of the mapping. Anything that does not map simply keeps using the
+ * GInputStream path. */
+static void
+gst_gio_src_try_mmap (GstGioSrc * src)
+{
+  gchar *path;
+  GError *err = NULL;
+
+  if (!g_file_is_native (src->file))
+    return;
+
+  path = g_file_get_path (src->file);
+  if (path == NULL)
+    return;
+
+  src->mapped = g_mapped_file_new (path, FALSE, &err);
+  if (src->mapped == NULL) {
+    GST_DEBUG_OBJECT (src, "could not map %s, using stream reads: %s",
+        path, err->message);
+    g_clear_error (&err);
+  } else {
+    src->mapped_size = g_mapped_file_get_length (src->mapped);
+    GST_DEBUG_OBJECT (src, "mapped %s (%" G_GUINT64_FORMAT " bytes), "
+        "serving zero-copy slices", path, src->mapped_size);
+  }
+  g_free (path);
+}
+
+static gboolean
+gst_gio_src_stop (GstBaseSrc * base_src)
+{
+  GstGioSrc *src = GST_GIO_SRC (base_src);
+
+  if (src->mapped) {
+    /* buffers still downstream keep their ref on the mapping */
+    g_mapped_file_unref (src->mapped);
+    src->mapped = NULL;
+    src->mapped_size = 0;
+  }
+
+  return GST_BASE_SRC_CLASS (parent_class)->stop (base_src);
+}
+
+static gboolean
+gst_gio_src_get_size (GstBaseSrc * base_src, guint64 * size)
+{
+  GstGioSrc *src = GST_GIO_SRC (base_src);
+
+  if (src->mapped) {
+    *size = src->mapped_size;
+    return TRUE;
+  }
+
+  return GST_BASE_SRC_CLASS (parent_class)->get_size (base_src, size);
+}
+
+static GstFlowReturn
+gst_gio_src_create (GstBaseSrc * base_src, guint64 offset, guint size,
+    GstBuffer ** buf)
+{
+  GstGioSrc *src = GST_GIO_SRC (base_src);
+  guint8 *data;
+
+  if (src->mapped == NULL)
+    return GST_BASE_SRC_CLASS (parent_class)->create (base_src, offset, size,
+        buf);
+
+  if (offset >= src->mapped_size)
+    return GST_FLOW_EOS;
+  if (offset + size > src->mapped_size)
+    size = src->mapped_size - offset;
+
+  GST_LOG_OBJECT (src, "slicing %u bytes at offset %" G_GUINT64_FORMAT
+      " from the mapping", size, offset);
+
+  data = (guint8 *) g_mapped_file_get_contents (src->mapped) + offset;
+  *buf = gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY, data, size,
+      0, size, g_mapped_file_ref (src->mapped),
+      (GDestroyNotify) g_mapped_file_unref);
+  GST_BUFFER_OFFSET (*buf) = offset;
+  GST_BUFFER_OFFSET_END (*buf) = offset + size;
+
+  return GST_FLOW_OK;
+}
+
 static GInputStream *
 gst_gio_src_get_stream (GstGioBaseSrc * bsrc)
 {
@@ -346,5 +475,8 @@ gst_gio_src_get_stream (GstGioBaseSrc * bsrc)
   GST_DEBUG_OBJECT (src, "opened location %s", uri);
   g_free (uri);
 
+  if (src->use_mmap)
+    gst_gio_src_try_mmap (src);
+
   return stream;
 }
@@ -54,6 +54,10 @@ struct _GstGioSrc
   
   /*< private >*/
   GFile *file;
+
+  gboolean use_mmap;
+  GMappedFile *mapped;
+  guint64 mapped_size;
 };
 
 struct _GstGioSrcClass 
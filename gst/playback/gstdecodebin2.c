@@ -187,6 +187,15 @@ struct _GstDecodeBin
   GList *buffering_status;      /* element currently buffering messages */
   GMutex buffering_lock;
   GMutex buffering_post_lock;
+
+  gboolean use_type_cache;      /* consult the process-wide typefind cache */
+  GByteArray *type_cache_data;  /* first bytes collected for the fingerprint */
+  gchar *type_cache_fingerprint;        /* fingerprint of the first bytes */
+  GstCaps *type_cache_caps;     /* found caps waiting for the fingerprint */
+  gulong type_cache_probe_id;   /* buffer probe on the typefind sink pad */
+
+  GstStructure *startup_stats;  /* startup phase timestamps, protected by
+                                 * the object lock */
 };
 
 struct _GstDecodeBinClass
@@ -243,6 +252,13 @@ enum
 #define AUTO_PLAY_SIZE_BUFFERS      5
 #define AUTO_PLAY_SIZE_TIME         0
 
+/* when playing with automatic limits, size the queues to a small multiple
+ * of the measured stream interleave instead of a fixed buffer count; the
+ * limits are grown whenever a larger interleave is observed so that the
+ * multiqueue can not deadlock on unusually interleaved files */
+#define AUTO_PLAY_INTERLEAVE_FACTOR   2
+#define AUTO_PLAY_MINIMUM_INTERLEAVE  (250 * GST_MSECOND)
+
 #define DEFAULT_SUBTITLE_ENCODING NULL
 #define DEFAULT_USE_BUFFERING     FALSE
 #define DEFAULT_LOW_PERCENT       10
@@ -254,6 +270,7 @@ enum
 #define DEFAULT_POST_STREAM_TOPOLOGY FALSE
 #define DEFAULT_EXPOSE_ALL_STREAMS  TRUE
 #define DEFAULT_CONNECTION_SPEED    0
+#define DEFAULT_USE_TYPE_CACHE      FALSE
 
 /* Properties */
 enum
@@ -270,7 +287,9 @@ enum
   PROP_MAX_SIZE_TIME,
   PROP_POST_STREAM_TOPOLOGY,
   PROP_EXPOSE_ALL_STREAMS,
-  PROP_CONNECTION_SPEED
+  PROP_CONNECTION_SPEED,
+  PROP_USE_TYPE_CACHE,
+  PROP_STARTUP_STATS
 };
 
 static GstBinClass *parent_class;
@@ -285,10 +304,13 @@ static void type_found (GstElement * typefind, guint probability,
     GstCaps * caps, GstDecodeBin * decode_bin);
 
 static void decodebin_set_queue_size (GstDecodeBin * dbin,
-    GstElement * multiqueue, gboolean preroll, gboolean seekable);
+    GstElement * multiqueue, gboolean preroll, gboolean seekable,
+    GstClockTime interleave);
+static GstClockTime gst_decode_group_interleave_playing (GstDecodeGroup *
+    group);
 static void decodebin_set_queue_size_full (GstDecodeBin * dbin,
     GstElement * multiqueue, gboolean use_buffering, gboolean preroll,
-    gboolean seekable);
+    gboolean seekable, GstClockTime interleave);
 
 static gboolean gst_decode_bin_autoplug_continue (GstElement * element,
     GstPad * pad, GstCaps * caps);
@@ -433,6 +455,15 @@ struct _GstDecodeGroup
 
   GList *reqpads;               /* List of RequestPads for multiqueue, there is
                                  * exactly one RequestPad per child chain */
+
+  GMutex interleave_lock;       /* Protects the interleave fields below */
+  GHashTable *interleave_times; /* multiqueue sinkpad -> last timestamp */
+  GstClockTime measured_interleave;     /* Largest timestamp spread observed
+                                         * between the streams */
+  GstClockTime applied_interleave;      /* Interleave the current queue
+                                         * limits were computed from */
+  gboolean playing;             /* TRUE once the multiqueue was switched to
+                                 * 'playing' buffering mode */
 };
 
 struct _GstDecodeChain
@@ -983,6 +1014,39 @@ gst_decode_bin_class_init (GstDecodeBinClass * klass)
           0, G_MAXUINT64 / 1000, DEFAULT_CONNECTION_SPEED,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstDecodeBin::use-type-cache
+   *
+   * Remember typefind results in a process-wide cache keyed by a
+   * fingerprint of the first bytes of the stream, and reuse the cached
+   * caps when the same stream is seen again. This skips the typefind
+   * detection round trip when reconnecting to the same source many
+   * times.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_klass, PROP_USE_TYPE_CACHE,
+      g_param_spec_boolean ("use-type-cache", "Use Type Cache",
+          "Reuse typefind results for streams with identical first bytes",
+          DEFAULT_USE_TYPE_CACHE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstDecodeBin::startup-stats
+   *
+   * A #GstStructure with a monotonic timestamp for each startup phase of
+   * the current run: "start" (READY to PAUSED begins), "typefind-done"
+   * (the stream type was found) and "pads-exposed" (the decoded pads were
+   * exposed). Only the first occurrence of each phase is recorded; the
+   * stats are reset on the next READY to PAUSED transition.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_klass, PROP_STARTUP_STATS,
+      g_param_spec_boxed ("startup-stats", "Startup statistics",
+          "Timestamps of the startup phases of the current run",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
 
 
   klass->autoplug_continue =
@@ -1027,15 +1091,94 @@ gst_decode_bin_update_factories_list (GstDecodeBin * dbin)
     if (dbin->factories)
       gst_plugin_feature_list_free (dbin->factories);
     dbin->factories =
-        gst_element_factory_list_get_elements
-        (GST_ELEMENT_FACTORY_TYPE_DECODABLE, GST_RANK_MARGINAL);
-    dbin->factories =
-        g_list_sort (dbin->factories,
-        gst_playback_utils_compare_factories_func);
+        gst_playback_utils_get_factories (GST_ELEMENT_FACTORY_TYPE_DECODABLE,
+        GST_RANK_MARGINAL, gst_playback_utils_compare_factories_func);
     dbin->factories_cookie = cookie;
   }
 }
 
+/* Process wide cache of autoplug decisions: maps the string form of a
+ * fixed caps to the sorted factory array the default autoplug handlers
+ * produce for it. Pipelines for identical inputs are often built over
+ * and over in the same process, and the factory filtering is by far the
+ * most expensive part of analyze_new_pad(). The cache is flushed when
+ * the registry changes and is only consulted while no application
+ * handlers are connected to the autoplug signals, since those can
+ * legitimately return something different every time. */
+#define FACTORY_CACHE_MAX_ENTRIES 64
+
+static GMutex factory_cache_lock;
+static GHashTable *factory_cache;       /* caps string -> GValueArray */
+static guint32 factory_cache_cookie;
+
+static GValueArray *
+gst_decode_bin_factory_cache_lookup (GstCaps * caps)
+{
+  GValueArray *result = NULL;
+  gchar *key;
+
+  key = gst_caps_to_string (caps);
+
+  g_mutex_lock (&factory_cache_lock);
+  if (factory_cache != NULL) {
+    guint32 cookie =
+        gst_registry_get_feature_list_cookie (gst_registry_get ());
+
+    if (cookie != factory_cache_cookie) {
+      /* plugins were installed or removed, old decisions are void */
+      g_hash_table_remove_all (factory_cache);
+      factory_cache_cookie = cookie;
+    } else {
+      GValueArray *cached = g_hash_table_lookup (factory_cache, key);
+
+      if (cached != NULL)
+        result = g_value_array_copy (cached);
+    }
+  }
+  g_mutex_unlock (&factory_cache_lock);
+
+  g_free (key);
+
+  return result;
+}
+
+static void
+gst_decode_bin_factory_cache_store (GstCaps * caps, GValueArray * factories)
+{
+  gchar *key;
+
+  key = gst_caps_to_string (caps);
+
+  g_mutex_lock (&factory_cache_lock);
+  if (factory_cache == NULL) {
+    factory_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+        (GDestroyNotify) g_value_array_free);
+    factory_cache_cookie =
+        gst_registry_get_feature_list_cookie (gst_registry_get ());
+  }
+  if (g_hash_table_size (factory_cache) < FACTORY_CACHE_MAX_ENTRIES &&
+      !g_hash_table_contains (factory_cache, key)) {
+    g_hash_table_insert (factory_cache, key, g_value_array_copy (factories));
+    key = NULL;
+  }
+  g_mutex_unlock (&factory_cache_lock);
+
+  g_free (key);
+}
+
+static gboolean
+gst_decode_bin_has_autoplug_handlers (GstDecodeBin * dbin)
+{
+  return g_signal_has_handler_pending (dbin,
+      gst_decode_bin_signals[SIGNAL_AUTOPLUG_CONTINUE], 0, TRUE)
+      || g_signal_has_handler_pending (dbin,
+      gst_decode_bin_signals[SIGNAL_AUTOPLUG_FACTORIES], 0, TRUE)
+      || g_signal_has_handler_pending (dbin,
+      gst_decode_bin_signals[SIGNAL_AUTOPLUG_SORT], 0, TRUE)
+      || g_signal_has_handler_pending (dbin,
+      gst_decode_bin_signals[SIGNAL_AUTOPLUG_SELECT], 0, TRUE);
+}
+
 static void
 gst_decode_bin_init (GstDecodeBin * decode_bin)
 {
@@ -1096,6 +1239,7 @@ gst_decode_bin_init (GstDecodeBin * decode_bin)
 
   decode_bin->expose_allstreams = DEFAULT_EXPOSE_ALL_STREAMS;
   decode_bin->connection_speed = DEFAULT_CONNECTION_SPEED;
+  decode_bin->use_type_cache = DEFAULT_USE_TYPE_CACHE;
 }
 
 static void
@@ -1123,6 +1267,15 @@ gst_decode_bin_dispose (GObject * object)
   g_list_free (decode_bin->subtitles);
   decode_bin->subtitles = NULL;
 
+  if (decode_bin->type_cache_data)
+    g_byte_array_free (decode_bin->type_cache_data, TRUE);
+  decode_bin->type_cache_data = NULL;
+
+  g_free (decode_bin->type_cache_fingerprint);
+  decode_bin->type_cache_fingerprint = NULL;
+
+  gst_caps_replace (&decode_bin->type_cache_caps, NULL);
+
   unblock_pads (decode_bin);
 
   G_OBJECT_CLASS (parent_class)->dispose (object);
@@ -1141,6 +1294,7 @@ gst_decode_bin_finalize (GObject * object)
   g_mutex_clear (&decode_bin->buffering_lock);
   g_mutex_clear (&decode_bin->buffering_post_lock);
   g_mutex_clear (&decode_bin->factories_lock);
+  gst_playback_utils_reset_startup_stats (&decode_bin->startup_stats);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -1285,6 +1439,9 @@ gst_decode_bin_set_property (GObject * object, guint prop_id,
       dbin->connection_speed = g_value_get_uint64 (value) * 1000;
       GST_OBJECT_UNLOCK (dbin);
       break;
+    case PROP_USE_TYPE_CACHE:
+      dbin->use_type_cache = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1337,12 +1494,30 @@ gst_decode_bin_get_property (GObject * object, guint prop_id,
       g_value_set_uint64 (value, dbin->connection_speed / 1000);
       GST_OBJECT_UNLOCK (dbin);
       break;
+    case PROP_USE_TYPE_CACHE:
+      g_value_set_boolean (value, dbin->use_type_cache);
+      break;
+    case PROP_STARTUP_STATS:
+      GST_OBJECT_LOCK (dbin);
+      g_value_set_boxed (value, dbin->startup_stats);
+      GST_OBJECT_UNLOCK (dbin);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+/* record the monotonic time a startup phase first happened, for the
+ * startup-stats property */
+static void
+mark_startup_phase (GstDecodeBin * dbin, const gchar * phase)
+{
+  GST_OBJECT_LOCK (dbin);
+  gst_playback_utils_mark_startup_phase (&dbin->startup_stats, phase);
+  GST_OBJECT_UNLOCK (dbin);
+}
+
 
 /*****
  * Default autoplug signal handlers
@@ -1608,43 +1783,57 @@ analyze_new_pad (GstDecodeBin * dbin, GstElement * src, GstPad * pad,
   }
 
   /* 1.d else get the factories and if there's no compatible factory goto
-   * unknown_type */
-  g_signal_emit (G_OBJECT (dbin),
-      gst_decode_bin_signals[SIGNAL_AUTOPLUG_FACTORIES], 0, dpad, caps,
-      &factories);
-
-  /* NULL means that we can expose the pad */
-  if (factories == NULL)
-    goto expose_pad;
-
-  /* if the array is empty, we have a type for which we have no decoder */
-  if (factories->n_values == 0) {
-    if (!dbin->expose_allstreams) {
-      GstCaps *raw = gst_static_caps_get (&default_raw_caps);
-
-      /* If the caps are raw, this just means we don't want to expose them */
-      if (gst_caps_is_subset (caps, raw)) {
-        g_value_array_free (factories);
+   * unknown_type. Identical caps always autoplug to the identical factory
+   * list, so consult the shared decision cache first; it is bypassed as
+   * soon as an application connects to any of the autoplug signals. */
+  if (gst_caps_is_fixed (caps) && !gst_decode_bin_has_autoplug_handlers (dbin))
+    factories = gst_decode_bin_factory_cache_lookup (caps);
+
+  if (factories != NULL) {
+    GST_DEBUG_OBJECT (dbin, "Using cached factories for %" GST_PTR_FORMAT,
+        caps);
+  } else {
+    g_signal_emit (G_OBJECT (dbin),
+        gst_decode_bin_signals[SIGNAL_AUTOPLUG_FACTORIES], 0, dpad, caps,
+        &factories);
+
+    /* NULL means that we can expose the pad */
+    if (factories == NULL)
+      goto expose_pad;
+
+    /* if the array is empty, we have a type for which we have no decoder */
+    if (factories->n_values == 0) {
+      if (!dbin->expose_allstreams) {
+        GstCaps *raw = gst_static_caps_get (&default_raw_caps);
+
+        /* If the caps are raw, this just means we don't want to expose them */
+        if (gst_caps_is_subset (caps, raw)) {
+          g_value_array_free (factories);
+          gst_caps_unref (raw);
+          gst_object_unref (dpad);
+          goto discarded_type;
+        }
         gst_caps_unref (raw);
-        gst_object_unref (dpad);
-        goto discarded_type;
       }
-      gst_caps_unref (raw);
+
+      /* if not we have a unhandled type with no compatible factories */
+      g_value_array_free (factories);
+      gst_object_unref (dpad);
+      goto unknown_type;
     }
 
-    /* if not we have a unhandled type with no compatible factories */
-    g_value_array_free (factories);
-    gst_object_unref (dpad);
-    goto unknown_type;
-  }
+    /* 1.e sort some more. */
+    g_signal_emit (G_OBJECT (dbin),
+        gst_decode_bin_signals[SIGNAL_AUTOPLUG_SORT], 0, dpad, caps, factories,
+        &result);
+    if (result) {
+      g_value_array_free (factories);
+      factories = result;
+    }
 
-  /* 1.e sort some more. */
-  g_signal_emit (G_OBJECT (dbin),
-      gst_decode_bin_signals[SIGNAL_AUTOPLUG_SORT], 0, dpad, caps, factories,
-      &result);
-  if (result) {
-    g_value_array_free (factories);
-    factories = result;
+    if (gst_caps_is_fixed (caps) &&
+        !gst_decode_bin_has_autoplug_handlers (dbin))
+      gst_decode_bin_factory_cache_store (caps, factories);
   }
 
   /* At this point we have a potential decoder, but we might not need it
@@ -2823,6 +3012,43 @@ done:
   return seekable;
 }
 
+static void
+/* process-wide cache of typefind results, keyed by a fingerprint of the
+ * first bytes of the stream. Only used when use-type-cache is enabled */
+#define TYPE_CACHE_FINGERPRINT_SIZE 4096
+
+static GHashTable *type_cache;
+G_LOCK_DEFINE_STATIC (type_cache);
+
+static GstCaps *
+type_cache_lookup (const gchar * fingerprint)
+{
+  GstCaps *caps = NULL;
+
+  G_LOCK (type_cache);
+  if (type_cache != NULL) {
+    caps = g_hash_table_lookup (type_cache, fingerprint);
+    if (caps)
+      gst_caps_ref (caps);
+  }
+  G_UNLOCK (type_cache);
+
+  return caps;
+}
+
+static void
+type_cache_store (const gchar * fingerprint, GstCaps * caps)
+{
+  G_LOCK (type_cache);
+  if (type_cache == NULL)
+    type_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+        (GDestroyNotify) gst_caps_unref);
+  if (!g_hash_table_contains (type_cache, fingerprint))
+    g_hash_table_insert (type_cache, g_strdup (fingerprint),
+        gst_caps_ref (caps));
+  G_UNLOCK (type_cache);
+}
+
 static void
 type_found (GstElement * typefind, guint probability,
     GstCaps * caps, GstDecodeBin * decode_bin)
@@ -2832,6 +3058,16 @@ type_found (GstElement * typefind, guint probability,
 
   GST_DEBUG_OBJECT (decode_bin, "typefind found caps %" GST_PTR_FORMAT, caps);
 
+  mark_startup_phase (decode_bin, "typefind-done");
+
+  if (decode_bin->use_type_cache) {
+    if (decode_bin->type_cache_fingerprint)
+      type_cache_store (decode_bin->type_cache_fingerprint, caps);
+    else
+      /* fingerprint not complete yet, the probe stores the caps once it is */
+      gst_caps_replace (&decode_bin->type_cache_caps, caps);
+  }
+
   /* If the typefinder (but not something else) finds text/plain - i.e. that's
    * the top-level type of the file - then error out.
    */
@@ -2875,6 +3111,77 @@ exit:
   return;
 }
 
+/* Collects the first bytes flowing into typefind. Once enough bytes were
+ * seen the fingerprint is computed and the process-wide cache is
+ * consulted; on a hit the cached caps are injected as a caps event, which
+ * typefind takes as authoritative and so skips the full detection */
+static GstPadProbeReturn
+type_cache_probe (GstPad * pad, GstPadProbeInfo * info, GstDecodeBin * dbin)
+{
+  GstBuffer *buf = GST_PAD_PROBE_INFO_BUFFER (info);
+  GstMapInfo map;
+  GstCaps *caps;
+
+  if (!dbin->use_type_cache || dbin->type_cache_data == NULL) {
+    dbin->type_cache_probe_id = 0;
+    return GST_PAD_PROBE_REMOVE;
+  }
+
+  if (gst_buffer_map (buf, &map, GST_MAP_READ)) {
+    gsize missing = TYPE_CACHE_FINGERPRINT_SIZE - dbin->type_cache_data->len;
+
+    g_byte_array_append (dbin->type_cache_data, map.data,
+        MIN (map.size, missing));
+    gst_buffer_unmap (buf, &map);
+  }
+
+  if (dbin->type_cache_data->len < TYPE_CACHE_FINGERPRINT_SIZE)
+    return GST_PAD_PROBE_OK;
+
+  dbin->type_cache_fingerprint =
+      g_compute_checksum_for_data (G_CHECKSUM_SHA256,
+      dbin->type_cache_data->data, dbin->type_cache_data->len);
+  g_byte_array_free (dbin->type_cache_data, TRUE);
+  dbin->type_cache_data = NULL;
+  dbin->type_cache_probe_id = 0;
+
+  if (dbin->type_cache_caps) {
+    /* typefind already found the type, record it now that the
+     * fingerprint is complete */
+    type_cache_store (dbin->type_cache_fingerprint, dbin->type_cache_caps);
+    gst_caps_replace (&dbin->type_cache_caps, NULL);
+  } else if ((caps = type_cache_lookup (dbin->type_cache_fingerprint))) {
+    GST_DEBUG_OBJECT (dbin, "typefind cache hit : %" GST_PTR_FORMAT, caps);
+    gst_pad_send_event (pad, gst_event_new_caps (caps));
+    gst_caps_unref (caps);
+  }
+
+  return GST_PAD_PROBE_REMOVE;
+}
+
+/* prepare fingerprint collection and install the probe on the typefind
+ * sink pad */
+static void
+gst_decode_bin_arm_type_cache (GstDecodeBin * dbin)
+{
+  if (dbin->type_cache_data == NULL)
+    dbin->type_cache_data =
+        g_byte_array_sized_new (TYPE_CACHE_FINGERPRINT_SIZE);
+  g_byte_array_set_size (dbin->type_cache_data, 0);
+  g_free (dbin->type_cache_fingerprint);
+  dbin->type_cache_fingerprint = NULL;
+  gst_caps_replace (&dbin->type_cache_caps, NULL);
+
+  if (dbin->type_cache_probe_id == 0) {
+    GstPad *pad = gst_element_get_static_pad (dbin->typefind, "sink");
+
+    dbin->type_cache_probe_id =
+        gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER,
+        (GstPadProbeCallback) type_cache_probe, dbin, NULL);
+    gst_object_unref (pad);
+  }
+}
+
 static GstPadProbeReturn
 pad_event_cb (GstPad * pad, GstPadProbeInfo * info, gpointer data)
 {
@@ -3080,7 +3387,8 @@ no_more_pads_cb (GstElement * element, GstDecodeChain * chain)
   GST_DEBUG_OBJECT (group->dbin, "Setting group %p multiqueue to "
       "'playing' buffering mode", group);
   decodebin_set_queue_size (group->dbin, group->multiqueue, FALSE,
-      (group->parent ? group->parent->seekable : TRUE));
+      (group->parent ? group->parent->seekable : TRUE),
+      gst_decode_group_interleave_playing (group));
   CHAIN_MUTEX_UNLOCK (chain);
 
   EXPOSE_LOCK (chain->dbin);
@@ -3529,7 +3837,8 @@ multi_queue_overrun_cb (GstElement * queue, GstDecodeGroup * group)
   GST_DEBUG_OBJECT (group->dbin, "Setting group %p multiqueue to "
       "'playing' buffering mode", group);
   decodebin_set_queue_size (group->dbin, group->multiqueue, FALSE,
-      (group->parent ? group->parent->seekable : TRUE));
+      (group->parent ? group->parent->seekable : TRUE),
+      gst_decode_group_interleave_playing (group));
 
   /* FIXME: We should make sure that everything gets exposed now
    * even if child chains are not complete because the will never
@@ -3595,8 +3904,12 @@ gst_decode_group_free_internal (GstDecodeGroup * group, gboolean hide)
 
   GST_DEBUG_OBJECT (group->dbin, "%s group %p", (hide ? "Hid" : "Freed"),
       group);
-  if (!hide)
+  if (!hide) {
+    g_hash_table_unref (group->interleave_times);
+    group->interleave_times = NULL;
+    g_mutex_clear (&group->interleave_lock);
     g_slice_free (GstDecodeGroup, group);
+  }
 }
 
 /* gst_decode_group_free:
@@ -3684,9 +3997,90 @@ gst_decode_chain_start_free_hidden_groups_thread (GstDecodeChain * chain)
   g_thread_unref (thread);
 }
 
+/* Switches @group to 'playing' queue sizing and returns the stream
+ * interleave measured so far, to be used for the queue limits. From this
+ * point on, the buffer probes on the multiqueue sinkpads grow the limits
+ * whenever a larger interleave is observed. */
+static GstClockTime
+gst_decode_group_interleave_playing (GstDecodeGroup * group)
+{
+  GstClockTime interleave;
+
+  g_mutex_lock (&group->interleave_lock);
+  group->playing = TRUE;
+  interleave = group->applied_interleave = group->measured_interleave;
+  g_mutex_unlock (&group->interleave_lock);
+
+  return interleave;
+}
+
+/* buffer probe on the multiqueue sinkpads measuring the actual stream
+ * interleave, i.e. the timestamp spread between the streams. All streams
+ * of a group come from the same demuxer, so their timestamps are
+ * comparable. When the observed interleave outgrows the limits that were
+ * last applied, the multiqueue is resized so that it cannot deadlock on
+ * files with a larger interleave than the limits would allow. */
+static GstPadProbeReturn
+sink_pad_interleave_probe (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstDecodeGroup *group = (GstDecodeGroup *) user_data;
+  GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+  GstClockTime ts, *last;
+  gboolean update = FALSE;
+
+  ts = GST_BUFFER_DTS (buffer);
+  if (!GST_CLOCK_TIME_IS_VALID (ts))
+    ts = GST_BUFFER_PTS (buffer);
+  if (!GST_CLOCK_TIME_IS_VALID (ts))
+    return GST_PAD_PROBE_OK;
+
+  g_mutex_lock (&group->interleave_lock);
+  last = g_hash_table_lookup (group->interleave_times, pad);
+  if (last == NULL) {
+    last = g_new (GstClockTime, 1);
+    g_hash_table_insert (group->interleave_times, pad, last);
+  }
+  *last = ts;
+
+  if (g_hash_table_size (group->interleave_times) > 1) {
+    GstClockTime min = GST_CLOCK_TIME_NONE, max = 0;
+    GHashTableIter iter;
+    gpointer value;
+
+    g_hash_table_iter_init (&iter, group->interleave_times);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+      GstClockTime t = *(GstClockTime *) value;
+
+      min = MIN (min, t);
+      max = MAX (max, t);
+    }
+    if (max - min > group->measured_interleave) {
+      group->measured_interleave = max - min;
+      /* only ever grow the limits, and only once we left preroll mode */
+      update = group->playing
+          && group->measured_interleave > group->applied_interleave;
+      if (update)
+        group->applied_interleave = group->measured_interleave;
+    }
+  }
+  g_mutex_unlock (&group->interleave_lock);
+
+  if (update) {
+    GST_DEBUG_OBJECT (group->dbin, "measured interleave of group %p grew "
+        "to %" GST_TIME_FORMAT ", updating queue limits", group,
+        GST_TIME_ARGS (group->applied_interleave));
+    decodebin_set_queue_size (group->dbin, group->multiqueue, FALSE,
+        (group->parent ? group->parent->seekable : TRUE),
+        group->applied_interleave);
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
 static void
 decodebin_set_queue_size (GstDecodeBin * dbin, GstElement * multiqueue,
-    gboolean preroll, gboolean seekable)
+    gboolean preroll, gboolean seekable, GstClockTime interleave)
 {
   gboolean use_buffering;
 
@@ -3694,14 +4088,15 @@ decodebin_set_queue_size (GstDecodeBin * dbin, GstElement * multiqueue,
   g_object_get (multiqueue, "use-buffering", &use_buffering, NULL);
 
   decodebin_set_queue_size_full (dbin, multiqueue, use_buffering, preroll,
-      seekable);
+      seekable, interleave);
 }
 
 /* configure queue sizes, this depends on the buffering method and if we are
  * playing or prerolling. */
 static void
 decodebin_set_queue_size_full (GstDecodeBin * dbin, GstElement * multiqueue,
-    gboolean use_buffering, gboolean preroll, gboolean seekable)
+    gboolean use_buffering, gboolean preroll, gboolean seekable,
+    GstClockTime interleave)
 {
   guint max_bytes, max_buffers;
   guint64 max_time;
@@ -3723,19 +4118,27 @@ decodebin_set_queue_size_full (GstDecodeBin * dbin, GstElement * multiqueue,
             AUTO_PREROLL_NOT_SEEKABLE_SIZE_TIME;
     }
   } else {
-    /* update runtime limits. At runtime, we try to keep the amount of buffers
-     * in the queues as low as possible (but at least 5 buffers). */
+    /* update runtime limits. With a measured stream interleave we size the
+     * queues to a small multiple of that interleave, otherwise we try to
+     * keep the amount of buffers in the queues as low as possible (but at
+     * least 5 buffers). */
     if (dbin->use_buffering)
       max_bytes = 0;
     else if ((max_bytes = dbin->max_size_bytes) == 0)
       max_bytes = AUTO_PLAY_SIZE_BYTES;
     if ((max_buffers = dbin->max_size_buffers) == 0)
-      max_buffers = AUTO_PLAY_SIZE_BUFFERS;
+      max_buffers = GST_CLOCK_TIME_IS_VALID (interleave) ? 0 :
+          AUTO_PLAY_SIZE_BUFFERS;
     /* this is a multiqueue with disabled buffering, don't limit max_time */
     if (dbin->use_buffering)
       max_time = 0;
-    else if ((max_time = dbin->max_size_time) == 0)
-      max_time = AUTO_PLAY_SIZE_TIME;
+    else if ((max_time = dbin->max_size_time) == 0) {
+      if (GST_CLOCK_TIME_IS_VALID (interleave))
+        max_time = AUTO_PLAY_INTERLEAVE_FACTOR *
+            MAX (interleave, AUTO_PLAY_MINIMUM_INTERLEAVE);
+      else
+        max_time = AUTO_PLAY_SIZE_TIME;
+    }
   }
 
   GST_DEBUG_OBJECT (multiqueue, "setting limits %u bytes, %u buffers, "
@@ -3765,6 +4168,9 @@ gst_decode_group_new (GstDecodeBin * dbin, GstDecodeChain * parent)
   group->dbin = dbin;
   group->parent = parent;
 
+  g_mutex_init (&group->interleave_lock);
+  group->interleave_times = g_hash_table_new_full (NULL, NULL, NULL, g_free);
+
   mq = group->multiqueue = gst_element_factory_make ("multiqueue", NULL);
   if (G_UNLIKELY (!group->multiqueue))
     goto missing_multiqueue;
@@ -3780,7 +4186,8 @@ gst_decode_group_new (GstDecodeBin * dbin, GstDecodeChain * parent)
       gst_object_unref (pad);
     }
   }
-  decodebin_set_queue_size_full (dbin, mq, FALSE, TRUE, seekable);
+  decodebin_set_queue_size_full (dbin, mq, FALSE, TRUE, seekable,
+      GST_CLOCK_TIME_NONE);
 
   group->overrunsig = g_signal_connect (mq, "overrun",
       G_CALLBACK (multi_queue_overrun_cb), group);
@@ -3797,6 +4204,8 @@ missing_multiqueue:
         gst_missing_element_message_new (GST_ELEMENT_CAST (dbin),
             "multiqueue"));
     GST_ELEMENT_ERROR (dbin, CORE, MISSING_PLUGIN, (NULL), ("no multiqueue!"));
+    g_hash_table_unref (group->interleave_times);
+    g_mutex_clear (&group->interleave_lock);
     g_slice_free (GstDecodeGroup, group);
     return NULL;
   }
@@ -3850,6 +4259,8 @@ gst_decode_group_control_demuxer_pad (GstDecodeGroup * group, GstPad * pad)
       sink_pad_event_probe, group, NULL);
   gst_pad_add_probe (sinkpad, GST_PAD_PROBE_TYPE_QUERY_UPSTREAM,
       sink_pad_query_probe, group, NULL);
+  gst_pad_add_probe (sinkpad, GST_PAD_PROBE_TYPE_BUFFER,
+      sink_pad_interleave_probe, group, NULL);
 
   CHAIN_MUTEX_LOCK (group->parent);
   group->reqpads = g_list_prepend (group->reqpads, gst_object_ref (sinkpad));
@@ -4287,7 +4698,8 @@ gst_decode_group_reset_buffering (GstDecodeGroup * group)
   }
 
   decodebin_set_queue_size_full (group->dbin, group->multiqueue, !ret,
-      FALSE, (group->parent ? group->parent->seekable : TRUE));
+      FALSE, (group->parent ? group->parent->seekable : TRUE),
+      gst_decode_group_interleave_playing (group));
 
   if (ret) {
     /* all chains are buffering already, no need to do it here */
@@ -4720,6 +5132,8 @@ retry:
   }
   g_list_free (endpads);
 
+  mark_startup_phase (dbin, "pads-exposed");
+
   do_async_done (dbin);
   GST_DEBUG_OBJECT (dbin, "Exposed everything");
   return TRUE;
@@ -5312,6 +5726,11 @@ gst_decode_bin_change_state (GstElement * element, GstStateChange transition)
       dbin->shutdown = FALSE;
       DYN_UNLOCK (dbin);
       dbin->have_type = FALSE;
+      /* a new run, start collecting startup timing from scratch */
+      GST_OBJECT_LOCK (dbin);
+      gst_playback_utils_reset_startup_stats (&dbin->startup_stats);
+      GST_OBJECT_UNLOCK (dbin);
+      mark_startup_phase (dbin, "start");
       ret = GST_STATE_CHANGE_ASYNC;
       do_async_start (dbin);
 
@@ -5321,12 +5740,23 @@ gst_decode_bin_change_state (GstElement * element, GstStateChange transition)
       dbin->have_type_id =
           g_signal_connect (dbin->typefind, "have-type",
           G_CALLBACK (type_found), dbin);
+      if (dbin->use_type_cache)
+        gst_decode_bin_arm_type_cache (dbin);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
     case GST_STATE_CHANGE_READY_TO_NULL:
       if (dbin->have_type_id)
         g_signal_handler_disconnect (dbin->typefind, dbin->have_type_id);
       dbin->have_type_id = 0;
+      if (dbin->type_cache_probe_id) {
+        GstPad *pad = gst_element_get_static_pad (dbin->typefind, "sink");
+
+        if (pad) {
+          gst_pad_remove_probe (pad, dbin->type_cache_probe_id);
+          gst_object_unref (pad);
+        }
+        dbin->type_cache_probe_id = 0;
+      }
       DYN_LOCK (dbin);
       GST_LOG_OBJECT (dbin, "setting shutdown flag");
       dbin->shutdown = TRUE;
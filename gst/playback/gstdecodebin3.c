@@ -32,6 +32,7 @@
 
 #include "gstplayback.h"
 #include "gstplay-enum.h"
+#include "gstplaybackutils.h"
 #include "gstrawcaps.h"
 
 /**
@@ -217,6 +218,8 @@ struct _GstDecodebin3
 
   /* selection_lock protects access to following variables */
   GMutex selection_lock;
+  /* signalled when a decoder prefetch completes, with selection_lock held */
+  GCond prefetch_cond;
   /* requested selection of stream-id to activate post-multiqueue */
   GList *requested_selection;
   /* list of stream-id currently activated in output */
@@ -230,12 +233,19 @@ struct _GstDecodebin3
   /* TRUE if requested_selection was updated, will become FALSE once
    * it has fully transitioned to active */
   gboolean selection_updated;
+  /* Decoders kept instantiated in the bin after their stream was
+   * deselected, most recently parked first, so that switching back to a
+   * recently used stream is a relink instead of a teardown and rebuild */
+  GList *warm_decoders;
   /* End of variables protected by selection_lock */
 
   /* List of pending collections.
    * FIXME : Is this really needed ? */
   GList *pending_collection;
 
+  /* startup phase timestamps, protected by the object lock */
+  GstStructure *startup_stats;
+
 
   /* Factories */
   GMutex factories_lock;
@@ -252,6 +262,7 @@ struct _GstDecodebin3
 
   /* Properties */
   GstCaps *caps;
+  guint keep_warm_decoders;
 };
 
 struct _GstDecodebin3Class
@@ -310,6 +321,15 @@ typedef struct _MultiQueueSlot
 
   gboolean is_drained;
 
+  /* decoder element created in advance on a helper thread, so that
+   * several streams can instantiate their decoders concurrently.
+   * All fields protected by the selection lock */
+  GstElement *prefetched_decoder;
+  /* caps the prefetched (or pending) decoder was chosen for */
+  GstCaps *prefetch_caps;
+  /* TRUE while a prefetch is running on the helper thread */
+  gboolean prefetch_pending;
+
   DecodebinOutputStream *output;
 } MultiQueueSlot;
 
@@ -354,9 +374,13 @@ typedef struct _PendingPad
 enum
 {
   PROP_0,
-  PROP_CAPS
+  PROP_CAPS,
+  PROP_STARTUP_STATS,
+  PROP_KEEP_WARM_DECODERS
 };
 
+#define DEFAULT_KEEP_WARM_DECODERS 0
+
 /* signals */
 enum
 {
@@ -484,8 +508,17 @@ static void free_output_stream (GstDecodebin3 * dbin,
 static DecodebinOutputStream *create_output_stream (GstDecodebin3 * dbin,
     GstStreamType type);
 
+static gboolean warm_decoder_park (GstDecodebin3 * dbin,
+    DecodebinOutputStream * output);
+static GstElement *warm_decoder_take (GstDecodebin3 * dbin,
+    GstStreamType type, GstCaps * caps, GstPad ** sink, GstPad ** src);
+static void warm_decoders_clear (GstDecodebin3 * dbin);
+
 static GstPadProbeReturn slot_unassign_probe (GstPad * pad,
     GstPadProbeInfo * info, MultiQueueSlot * slot);
+static void decoder_prefetch_start (GstDecodebin3 * dbin,
+    MultiQueueSlot * slot);
+static void decoder_prefetch_discard (GstElement * element);
 static gboolean reassign_slot (GstDecodebin3 * dbin, MultiQueueSlot * slot);
 static MultiQueueSlot *get_slot_for_input (GstDecodebin3 * dbin,
     DecodebinInputStream * input);
@@ -534,6 +567,40 @@ gst_decodebin3_class_init (GstDecodebin3Class * klass)
           "The caps on which to stop decoding. (NULL = default)",
           GST_TYPE_CAPS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstDecodebin3::startup-stats
+   *
+   * A #GstStructure with a monotonic timestamp for each startup phase of
+   * the current run: "start" (READY to PAUSED begins) and "pad-exposed"
+   * (the first output pad was exposed). Only the first occurrence of each
+   * phase is recorded; the stats are reset on the next READY to PAUSED
+   * transition.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_klass, PROP_STARTUP_STATS,
+      g_param_spec_boxed ("startup-stats", "Startup statistics",
+          "Timestamps of the startup phases of the current run",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstDecodebin3::keep-warm-decoders
+   *
+   * The number of decoders to keep instantiated and at state after their
+   * stream was deselected. Switching back to a recently deselected stream
+   * then only relinks the parked decoder instead of tearing it down and
+   * building a new one, which makes the switch near-instantaneous. A
+   * value of 0 (the default) tears decoders down immediately as before.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_klass, PROP_KEEP_WARM_DECODERS,
+      g_param_spec_uint ("keep-warm-decoders", "Keep warm decoders",
+          "Number of decoders of deselected streams to keep instantiated "
+          "for fast re-selection (0 = disabled)", 0, G_MAXUINT,
+          DEFAULT_KEEP_WARM_DECODERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /* FIXME : ADD SIGNALS ! */
   /**
    * GstDecodebin3::select-stream
@@ -597,6 +664,7 @@ gst_decodebin3_init (GstDecodebin3 * dbin)
 
   g_mutex_init (&dbin->factories_lock);
   g_mutex_init (&dbin->selection_lock);
+  g_cond_init (&dbin->prefetch_cond);
   g_mutex_init (&dbin->input_lock);
 
   dbin->caps = gst_static_caps_get (&default_raw_caps);
@@ -623,6 +691,7 @@ gst_decodebin3_dispose (GObject * object)
   g_clear_object (&dbin->collection);
 
   free_input (dbin, dbin->main_input);
+  gst_playback_utils_reset_startup_stats (&dbin->startup_stats);
 
   for (walk = dbin->other_inputs; walk; walk = next) {
     DecodebinInput *input = walk->data;
@@ -651,6 +720,11 @@ gst_decodebin3_set_property (GObject * object, guint prop_id,
       dbin->caps = g_value_dup_boxed (value);
       GST_OBJECT_UNLOCK (dbin);
       break;
+    case PROP_KEEP_WARM_DECODERS:
+      GST_OBJECT_LOCK (dbin);
+      dbin->keep_warm_decoders = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (dbin);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -670,12 +744,32 @@ gst_decodebin3_get_property (GObject * object, guint prop_id, GValue * value,
       g_value_set_boxed (value, dbin->caps);
       GST_OBJECT_UNLOCK (dbin);
       break;
+    case PROP_KEEP_WARM_DECODERS:
+      GST_OBJECT_LOCK (dbin);
+      g_value_set_uint (value, dbin->keep_warm_decoders);
+      GST_OBJECT_UNLOCK (dbin);
+      break;
+    case PROP_STARTUP_STATS:
+      GST_OBJECT_LOCK (dbin);
+      g_value_set_boxed (value, dbin->startup_stats);
+      GST_OBJECT_UNLOCK (dbin);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+/* record the monotonic time a startup phase first happened, for the
+ * startup-stats property */
+static void
+mark_startup_phase (GstDecodebin3 * dbin, const gchar * phase)
+{
+  GST_OBJECT_LOCK (dbin);
+  gst_playback_utils_mark_startup_phase (&dbin->startup_stats, phase);
+  GST_OBJECT_UNLOCK (dbin);
+}
+
 static gboolean
 parsebin_autoplug_continue_cb (GstElement * parsebin, GstPad * pad,
     GstCaps * caps, GstDecodebin3 * dbin)
@@ -967,10 +1061,8 @@ gst_decode_bin_update_factories_list (GstDecodebin3 * dbin)
     if (dbin->decodable_factories)
       g_list_free (dbin->decodable_factories);
     dbin->factories =
-        gst_element_factory_list_get_elements
-        (GST_ELEMENT_FACTORY_TYPE_DECODABLE, GST_RANK_MARGINAL);
-    dbin->factories =
-        g_list_sort (dbin->factories, gst_plugin_feature_rank_compare_func);
+        gst_playback_utils_get_factories (GST_ELEMENT_FACTORY_TYPE_DECODABLE,
+        GST_RANK_MARGINAL, gst_plugin_feature_rank_compare_func);
     dbin->factories_cookie = cookie;
 
     /* Filter decoder and other decodables */
@@ -1515,6 +1607,10 @@ multiqueue_src_probe (GstPad * pad, GstPadProbeInfo * info,
           slot->active_stream = stream;
         } else
           gst_object_unref (stream);
+
+        /* Start creating a decoder for the stream on a helper thread so
+         * it is ready by the time the slot gets configured */
+        decoder_prefetch_start (dbin, slot);
 #if 0                           /* Disabled because stream-start is pushed for every buffer on every unlinked pad */
         {
           gboolean is_active, is_requested;
@@ -1929,10 +2025,12 @@ reconfigure_output_stream (DecodebinOutputStream * output,
       goto cleanup;
     }
 
-    gst_element_set_locked_state (output->decoder, TRUE);
-    gst_element_set_state (output->decoder, GST_STATE_NULL);
+    if (!warm_decoder_park (dbin, output)) {
+      gst_element_set_locked_state (output->decoder, TRUE);
+      gst_element_set_state (output->decoder, GST_STATE_NULL);
 
-    gst_bin_remove ((GstBin *) dbin, output->decoder);
+      gst_bin_remove ((GstBin *) dbin, output->decoder);
+    }
     output->decoder = NULL;
   }
 
@@ -1943,8 +2041,42 @@ reconfigure_output_stream (DecodebinOutputStream * output,
 
   /* If a decoder is required, create one */
   if (needs_decoder) {
-    /* If we don't have a decoder yet, instantiate one */
-    output->decoder = create_decoder (dbin, slot->active_stream);
+    GstCaps *caps;
+    gboolean reuse_warm = FALSE;
+
+    /* If a decoder is still being prefetched for this slot, wait for it.
+     * The selection lock is released while waiting so other streams can
+     * configure their outputs concurrently */
+    while (slot->prefetch_pending)
+      g_cond_wait (&dbin->prefetch_cond, &dbin->selection_lock);
+
+    caps = gst_stream_get_caps (slot->active_stream);
+
+    /* A warm parked decoder takes priority: it is already in the bin at
+     * the right state, so the switch is only a relink */
+    if (caps)
+      output->decoder = warm_decoder_take (dbin, output->type, caps,
+          &output->decoder_sink, &output->decoder_src);
+
+    if (output->decoder) {
+      reuse_warm = TRUE;
+      decoder_prefetch_discard (slot->prefetched_decoder);
+    } else if (slot->prefetched_decoder && caps && slot->prefetch_caps &&
+        gst_caps_is_equal (slot->prefetch_caps, caps)) {
+      /* Use the prefetched decoder if it was created for the current caps */
+      GST_DEBUG_OBJECT (dbin, "Using prefetched decoder %" GST_PTR_FORMAT,
+          slot->prefetched_decoder);
+      output->decoder = slot->prefetched_decoder;
+    } else {
+      decoder_prefetch_discard (slot->prefetched_decoder);
+      /* If we don't have a decoder yet, instantiate one */
+      output->decoder = create_decoder (dbin, slot->active_stream);
+    }
+    slot->prefetched_decoder = NULL;
+    gst_caps_replace (&slot->prefetch_caps, NULL);
+    if (caps)
+      gst_caps_unref (caps);
+
     if (output->decoder == NULL) {
       GstCaps *caps;
 
@@ -1958,12 +2090,15 @@ reconfigure_output_stream (DecodebinOutputStream * output,
       SELECTION_LOCK (dbin);
       goto cleanup;
     }
-    if (!gst_bin_add ((GstBin *) dbin, output->decoder)) {
-      GST_ERROR_OBJECT (dbin, "could not add decoder to pipeline");
-      goto cleanup;
+    if (!reuse_warm) {
+      if (!gst_bin_add ((GstBin *) dbin, output->decoder)) {
+        GST_ERROR_OBJECT (dbin, "could not add decoder to pipeline");
+        goto cleanup;
+      }
+      output->decoder_sink =
+          gst_element_get_static_pad (output->decoder, "sink");
+      output->decoder_src = gst_element_get_static_pad (output->decoder, "src");
     }
-    output->decoder_sink = gst_element_get_static_pad (output->decoder, "sink");
-    output->decoder_src = gst_element_get_static_pad (output->decoder, "src");
     if (output->type & GST_STREAM_TYPE_VIDEO) {
       GST_DEBUG_OBJECT (dbin, "Adding keyframe-waiter probe");
       output->drop_probe_id =
@@ -1989,6 +2124,7 @@ reconfigure_output_stream (DecodebinOutputStream * output,
   if (output->src_exposed == FALSE) {
     output->src_exposed = TRUE;
     gst_element_add_pad (GST_ELEMENT_CAST (dbin), output->src_pad);
+    mark_startup_phase (dbin, "pad-exposed");
   }
 
   if (output->decoder)
@@ -2061,6 +2197,85 @@ find_slot_for_stream_id (GstDecodebin3 * dbin, const gchar * sid)
   return NULL;
 }
 
+/* drop an element that was prefetched but never added to the bin */
+static void
+decoder_prefetch_discard (GstElement * element)
+{
+  if (element == NULL)
+    return;
+  gst_object_ref_sink (element);
+  gst_object_unref (element);
+}
+
+/* Runs on a helper thread. Creates the decoder and hands it to the slot
+ * it was prefetched for, or discards it if the slot went away or moved
+ * on to another stream in the meantime */
+static void
+decoder_prefetch_run (GstDecodebin3 * dbin, GstStream * stream)
+{
+  GstElement *element;
+  MultiQueueSlot *slot;
+
+  element = create_decoder (dbin, stream);
+
+  SELECTION_LOCK (dbin);
+  slot = find_slot_for_stream_id (dbin, gst_stream_get_stream_id (stream));
+  if (slot && slot->prefetch_pending && slot->active_stream == stream) {
+    GST_DEBUG_OBJECT (dbin, "Prefetched decoder %" GST_PTR_FORMAT
+        " for slot %p", element, slot);
+    decoder_prefetch_discard (slot->prefetched_decoder);
+    slot->prefetched_decoder = element;
+    element = NULL;
+    slot->prefetch_pending = FALSE;
+  }
+  /* wake up any slot configuration waiting for its prefetch */
+  g_cond_broadcast (&dbin->prefetch_cond);
+  SELECTION_UNLOCK (dbin);
+
+  decoder_prefetch_discard (element);
+}
+
+/* Kick off creation of a decoder for the active stream of @slot on a
+ * helper thread, so decoders for independent streams are instantiated
+ * concurrently instead of serially on the streaming threads. Only the
+ * final linking and pad exposure stays under the selection lock. */
+static void
+decoder_prefetch_start (GstDecodebin3 * dbin, MultiQueueSlot * slot)
+{
+  GstCaps *caps = gst_stream_get_caps (slot->active_stream);
+
+  if (caps == NULL)
+    return;
+
+  /* raw streams don't need a decoder */
+  if (gst_caps_can_intersect (caps, dbin->caps)) {
+    gst_caps_unref (caps);
+    return;
+  }
+
+  SELECTION_LOCK (dbin);
+  /* already prefetched (or prefetching) for these caps ? */
+  if (slot->prefetch_caps && gst_caps_is_equal (slot->prefetch_caps, caps) &&
+      (slot->prefetch_pending || slot->prefetched_decoder)) {
+    SELECTION_UNLOCK (dbin);
+    gst_caps_unref (caps);
+    return;
+  }
+  decoder_prefetch_discard (slot->prefetched_decoder);
+  slot->prefetched_decoder = NULL;
+  gst_caps_replace (&slot->prefetch_caps, NULL);
+  slot->prefetch_caps = caps;
+  slot->prefetch_pending = TRUE;
+  SELECTION_UNLOCK (dbin);
+
+  GST_DEBUG_OBJECT (dbin, "Prefetching decoder for slot %p, %" GST_PTR_FORMAT,
+      slot, caps);
+
+  gst_element_call_async (GST_ELEMENT_CAST (dbin),
+      (GstElementCallAsyncFunc) decoder_prefetch_run,
+      gst_object_ref (slot->active_stream), gst_object_unref);
+}
+
 /* This function handles the reassignment of a slot. Call this from
  * the streaming thread of a slot. */
 static gboolean
@@ -2498,6 +2713,8 @@ free_multiqueue_slot (GstDecodebin3 * dbin, MultiQueueSlot * slot)
   gst_object_replace ((GstObject **) & slot->sink_pad, NULL);
   gst_object_replace ((GstObject **) & slot->src_pad, NULL);
   gst_object_replace ((GstObject **) & slot->active_stream, NULL);
+  decoder_prefetch_discard (slot->prefetched_decoder);
+  gst_caps_replace (&slot->prefetch_caps, NULL);
   g_free (slot);
 }
 
@@ -2567,6 +2784,114 @@ create_output_stream (GstDecodebin3 * dbin, GstStreamType type)
   return res;
 }
 
+/* A decoder parked after its stream was deselected. The element stays in
+ * the bin, unlinked and at the bin state, so re-activating it is only a
+ * relink. The entries are kept most recently parked first. */
+typedef struct
+{
+  GstElement *decoder;
+  GstPad *decoder_sink, *decoder_src;
+  GstStreamType type;
+} WarmDecoder;
+
+static void
+warm_decoder_free (GstDecodebin3 * dbin, WarmDecoder * wd)
+{
+  GST_DEBUG_OBJECT (dbin, "Discarding warm decoder %" GST_PTR_FORMAT,
+      wd->decoder);
+  gst_object_unref (wd->decoder_sink);
+  gst_object_unref (wd->decoder_src);
+  gst_element_set_locked_state (wd->decoder, TRUE);
+  gst_element_set_state (wd->decoder, GST_STATE_NULL);
+  gst_bin_remove ((GstBin *) dbin, wd->decoder);
+  g_free (wd);
+}
+
+/* Takes ownership of the decoder and pads of @output and parks them for
+ * later re-selection. Returns FALSE, leaving @output untouched, when the
+ * feature is disabled. Evicts the least recently parked decoders over the
+ * configured amount. Called with the SELECTION_LOCK taken */
+static gboolean
+warm_decoder_park (GstDecodebin3 * dbin, DecodebinOutputStream * output)
+{
+  WarmDecoder *wd;
+  guint keep;
+
+  GST_OBJECT_LOCK (dbin);
+  keep = dbin->keep_warm_decoders;
+  GST_OBJECT_UNLOCK (dbin);
+
+  if (keep == 0 || output->decoder == NULL || output->decoder_sink == NULL
+      || output->decoder_src == NULL)
+    return FALSE;
+
+  GST_DEBUG_OBJECT (dbin, "Parking decoder %" GST_PTR_FORMAT " of type %s",
+      output->decoder, gst_stream_type_get_name (output->type));
+
+  wd = g_new0 (WarmDecoder, 1);
+  wd->decoder = output->decoder;
+  wd->decoder_sink = output->decoder_sink;
+  wd->decoder_src = output->decoder_src;
+  wd->type = output->type;
+  output->decoder = NULL;
+  output->decoder_sink = NULL;
+  output->decoder_src = NULL;
+
+  dbin->warm_decoders = g_list_prepend (dbin->warm_decoders, wd);
+  while (g_list_length (dbin->warm_decoders) > keep) {
+    GList *last = g_list_last (dbin->warm_decoders);
+
+    warm_decoder_free (dbin, last->data);
+    dbin->warm_decoders = g_list_delete_link (dbin->warm_decoders, last);
+  }
+
+  return TRUE;
+}
+
+/* Look for a parked decoder of @type accepting @caps, remove it from the
+ * warm list and return its element, with the pads in @sink and @src.
+ * Called with the SELECTION_LOCK taken */
+static GstElement *
+warm_decoder_take (GstDecodebin3 * dbin, GstStreamType type, GstCaps * caps,
+    GstPad ** sink, GstPad ** src)
+{
+  GList *tmp;
+
+  for (tmp = dbin->warm_decoders; tmp; tmp = tmp->next) {
+    WarmDecoder *wd = tmp->data;
+
+    if ((wd->type & type) == 0)
+      continue;
+    if (!gst_pad_query_accept_caps (wd->decoder_sink, caps))
+      continue;
+
+    GST_DEBUG_OBJECT (dbin, "Re-using warm decoder %" GST_PTR_FORMAT,
+        wd->decoder);
+    *sink = wd->decoder_sink;
+    *src = wd->decoder_src;
+    dbin->warm_decoders = g_list_delete_link (dbin->warm_decoders, tmp);
+    {
+      GstElement *decoder = wd->decoder;
+
+      g_free (wd);
+      return decoder;
+    }
+  }
+
+  return NULL;
+}
+
+static void
+warm_decoders_clear (GstDecodebin3 * dbin)
+{
+  GList *tmp;
+
+  for (tmp = dbin->warm_decoders; tmp; tmp = tmp->next)
+    warm_decoder_free (dbin, tmp->data);
+  g_list_free (dbin->warm_decoders);
+  dbin->warm_decoders = NULL;
+}
+
 static void
 free_output_stream (GstDecodebin3 * dbin, DecodebinOutputStream * output)
 {
@@ -2577,17 +2902,17 @@ free_output_stream (GstDecodebin3 * dbin, DecodebinOutputStream * output)
     output->slot->output = NULL;
     output->slot = NULL;
   }
-  gst_object_replace ((GstObject **) & output->decoder_sink, NULL);
   gst_ghost_pad_set_target ((GstGhostPad *) output->src_pad, NULL);
-  gst_object_replace ((GstObject **) & output->decoder_src, NULL);
   if (output->src_exposed) {
     gst_element_remove_pad ((GstElement *) dbin, output->src_pad);
   }
-  if (output->decoder) {
+  if (output->decoder && !warm_decoder_park (dbin, output)) {
     gst_element_set_locked_state (output->decoder, TRUE);
     gst_element_set_state (output->decoder, GST_STATE_NULL);
     gst_bin_remove ((GstBin *) dbin, output->decoder);
   }
+  gst_object_replace ((GstObject **) & output->decoder_sink, NULL);
+  gst_object_replace ((GstObject **) & output->decoder_src, NULL);
   g_free (output);
 }
 
@@ -2599,6 +2924,13 @@ gst_decodebin3_change_state (GstElement * element, GstStateChange transition)
 
   /* Upwards */
   switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+      /* a new run, start collecting startup timing from scratch */
+      GST_OBJECT_LOCK (dbin);
+      gst_playback_utils_reset_startup_stats (&dbin->startup_stats);
+      GST_OBJECT_UNLOCK (dbin);
+      mark_startup_phase (dbin, "start");
+      break;
     default:
       break;
   }
@@ -2625,6 +2957,8 @@ gst_decodebin3_change_state (GstElement * element, GstStateChange transition)
       }
       g_list_free (dbin->slots);
       dbin->slots = NULL;
+      /* Free warm decoders */
+      warm_decoders_clear (dbin);
       /* Free inputs */
     }
       break;
@@ -878,11 +878,8 @@ gst_parse_bin_update_factories_list (GstParseBin * parsebin)
     if (parsebin->factories)
       gst_plugin_feature_list_free (parsebin->factories);
     parsebin->factories =
-        gst_element_factory_list_get_elements
-        (GST_ELEMENT_FACTORY_TYPE_DECODABLE, GST_RANK_MARGINAL);
-    parsebin->factories =
-        g_list_sort (parsebin->factories,
-        gst_playback_utils_compare_factories_func);
+        gst_playback_utils_get_factories (GST_ELEMENT_FACTORY_TYPE_DECODABLE,
+        GST_RANK_MARGINAL, gst_playback_utils_compare_factories_func);
     parsebin->factories_cookie = cookie;
   }
 }
@@ -132,6 +132,99 @@ gst_playback_utils_get_n_common_capsfeatures (GstElementFactory * fact1,
   return n_common_cf;
 }
 
+/* process-wide cache of sorted element factory lists, shared between all
+ * parsebin/decodebin instances. Entries are keyed by the list type, the
+ * minimum rank and the sort function, and refreshed when the registry
+ * cookie changes */
+typedef struct
+{
+  GstElementFactoryListType type;
+  GstRank minrank;
+  GCompareFunc compare;
+  guint32 cookie;
+  GList *factories;
+} FactoryListCacheEntry;
+
+static GList *factory_list_cache;
+G_LOCK_DEFINE_STATIC (factory_list_cache);
+
+GList *
+gst_playback_utils_get_factories (GstElementFactoryListType type,
+    GstRank minrank, GCompareFunc compare)
+{
+  FactoryListCacheEntry *entry = NULL;
+  GList *walk, *res;
+  guint32 cookie;
+
+  cookie = gst_registry_get_feature_list_cookie (gst_registry_get ());
+
+  G_LOCK (factory_list_cache);
+  for (walk = factory_list_cache; walk; walk = g_list_next (walk)) {
+    FactoryListCacheEntry *tmp = walk->data;
+
+    if (tmp->type == type && tmp->minrank == minrank
+        && tmp->compare == compare) {
+      entry = tmp;
+      break;
+    }
+  }
+  if (entry == NULL) {
+    entry = g_new0 (FactoryListCacheEntry, 1);
+    entry->type = type;
+    entry->minrank = minrank;
+    entry->compare = compare;
+    factory_list_cache = g_list_prepend (factory_list_cache, entry);
+  }
+  if (entry->factories == NULL || entry->cookie != cookie) {
+    if (entry->factories)
+      gst_plugin_feature_list_free (entry->factories);
+    entry->factories = gst_element_factory_list_get_elements (type, minrank);
+    if (compare)
+      entry->factories = g_list_sort (entry->factories, compare);
+    entry->cookie = cookie;
+  }
+  /* hand out a copy so the cached list stays valid when the registry
+   * changes under a caller still holding its list */
+  res = gst_plugin_feature_list_copy (entry->factories);
+  G_UNLOCK (factory_list_cache);
+
+  return res;
+}
+
+/* Startup phase instrumentation: elements record a monotonic timestamp for
+ * each startup phase (source creation, typefind, autoplugging, preroll)
+ * into a GstStructure that they expose through a read-only startup-stats
+ * property. Only the first occurrence of a phase is recorded, so the
+ * structure describes the initial startup of the current run.
+ *
+ * The caller is responsible for locking around @stats. */
+void
+gst_playback_utils_mark_startup_phase (GstStructure ** stats,
+    const gchar * phase)
+{
+  g_return_if_fail (stats != NULL);
+  g_return_if_fail (phase != NULL);
+
+  if (*stats == NULL)
+    *stats = gst_structure_new_empty ("startup-latency");
+
+  if (!gst_structure_has_field (*stats, phase))
+    gst_structure_set (*stats, phase, G_TYPE_UINT64,
+        (guint64) gst_util_get_timestamp (), NULL);
+}
+
+/* clear the recorded startup phases for a new run */
+void
+gst_playback_utils_reset_startup_stats (GstStructure ** stats)
+{
+  g_return_if_fail (stats != NULL);
+
+  if (*stats) {
+    gst_structure_free (*stats);
+    *stats = NULL;
+  }
+}
+
 gint
 gst_playback_utils_compare_factories_func (gconstpointer p1, gconstpointer p2)
 {
@@ -36,6 +36,18 @@ gst_playback_utils_get_n_common_capsfeatures (GstElementFactory * fact1,
 G_GNUC_INTERNAL
 gint
 gst_playback_utils_compare_factories_func (gconstpointer p1, gconstpointer p2);
+G_GNUC_INTERNAL
+GList *
+gst_playback_utils_get_factories (GstElementFactoryListType type,
+                                  GstRank minrank,
+                                  GCompareFunc compare);
+G_GNUC_INTERNAL
+void
+gst_playback_utils_mark_startup_phase (GstStructure ** stats,
+                                       const gchar * phase);
+G_GNUC_INTERNAL
+void
+gst_playback_utils_reset_startup_stats (GstStructure ** stats);
 G_END_DECLS
 
 #endif /* __GST_PLAYBACK_UTILS_H__ */
@@ -422,6 +422,9 @@ struct _GstPlayBin
   gint shutdown;
   gboolean async_pending;       /* async-start has been emitted */
 
+  GstStructure *startup_stats;  /* startup phase timestamps, protected by
+                                 * the object lock */
+
   GMutex elements_lock;
   guint32 elements_cookie;
   GList *elements;              /* factories we can use for selecting elements */
@@ -558,7 +561,8 @@ enum
   PROP_AUDIO_FILTER,
   PROP_VIDEO_FILTER,
   PROP_MULTIVIEW_MODE,
-  PROP_MULTIVIEW_FLAGS
+  PROP_MULTIVIEW_FLAGS,
+  PROP_STARTUP_STATS
 };
 
 /* signals */
@@ -1013,6 +1017,22 @@ gst_play_bin_class_init (GstPlayBinClass * klass)
           GST_TYPE_VIDEO_MULTIVIEW_FLAGS, GST_VIDEO_MULTIVIEW_FLAGS_NONE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstPlayBin::startup-stats
+   *
+   * A #GstStructure with a monotonic timestamp for each startup phase of
+   * the current run: "start" (READY to PAUSED begins), "group-activated"
+   * (the source group was activated) and "preroll-done" (the pipeline
+   * prerolled). Only the first occurrence of each phase is recorded; the
+   * stats are reset on the next READY to PAUSED transition.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_klass, PROP_STARTUP_STATS,
+      g_param_spec_boxed ("startup-stats", "Startup statistics",
+          "Timestamps of the startup phases of the current run",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstPlayBin::about-to-finish
    * @playbin: a #GstPlayBin
@@ -1325,6 +1345,16 @@ gst_play_bin_class_init (GstPlayBinClass * klass)
       GST_DEBUG_FUNCPTR (gst_play_bin_deep_element_added);
 }
 
+/* record the monotonic time a startup phase first happened, for the
+ * startup-stats property */
+static void
+mark_startup_phase (GstPlayBin * playbin, const gchar * phase)
+{
+  GST_OBJECT_LOCK (playbin);
+  gst_playback_utils_mark_startup_phase (&playbin->startup_stats, phase);
+  GST_OBJECT_UNLOCK (playbin);
+}
+
 static void
 do_async_start (GstPlayBin * playbin)
 {
@@ -1344,6 +1374,7 @@ do_async_done (GstPlayBin * playbin)
 
   if (playbin->async_pending) {
     GST_DEBUG_OBJECT (playbin, "posting ASYNC_DONE");
+    mark_startup_phase (playbin, "preroll-done");
     message =
         gst_message_new_async_done (GST_OBJECT_CAST (playbin),
         GST_CLOCK_TIME_NONE);
@@ -1613,6 +1644,8 @@ gst_play_bin_finalize (GObject * object)
   if (playbin->elements)
     gst_plugin_feature_list_free (playbin->elements);
 
+  gst_playback_utils_reset_startup_stats (&playbin->startup_stats);
+
   if (playbin->aelements)
     g_sequence_free (playbin->aelements);
 
@@ -2743,6 +2776,11 @@ gst_play_bin_get_property (GObject * object, guint prop_id, GValue * value,
       g_value_set_flags (value, playbin->multiview_flags);
       GST_OBJECT_UNLOCK (playbin);
       break;
+    case PROP_STARTUP_STATS:
+      GST_OBJECT_LOCK (playbin);
+      g_value_set_boxed (value, playbin->startup_stats);
+      GST_OBJECT_UNLOCK (playbin);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -5406,6 +5444,8 @@ activate_group (GstPlayBin * playbin, GstSourceGroup * group, GstState target)
   group->active = TRUE;
   GST_SOURCE_GROUP_UNLOCK (group);
 
+  mark_startup_phase (playbin, "group-activated");
+
   return state_ret;
 
   /* ERRORS */
@@ -5708,6 +5748,11 @@ gst_play_bin_change_state (GstElement * element, GstStateChange transition)
       GST_LOG_OBJECT (playbin, "clearing shutdown flag");
       memset (&playbin->duration, 0, sizeof (playbin->duration));
       g_atomic_int_set (&playbin->shutdown, 0);
+      /* a new run, start collecting startup timing from scratch */
+      GST_OBJECT_LOCK (playbin);
+      gst_playback_utils_reset_startup_stats (&playbin->startup_stats);
+      GST_OBJECT_UNLOCK (playbin);
+      mark_startup_phase (playbin, "start");
       do_async_start (playbin);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
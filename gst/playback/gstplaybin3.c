@@ -351,6 +351,11 @@ struct _GstSourceGroup
 
   gulong block_id;
 
+  /* next-uri pre-warming */
+  gboolean prewarmed;           /* urisourcebin was pre-rolled in advance */
+  gboolean prewarm_failed;      /* the pre-rolled urisourcebin posted an error */
+  gulong prewarm_pad_added_id;
+
   GMutex stream_changed_pending_lock;
   gboolean stream_changed_pending;
 
@@ -447,6 +452,9 @@ struct _GstPlayBin3
   gint shutdown;
   gboolean async_pending;       /* async-start has been emitted */
 
+  GstStructure *startup_stats;  /* startup phase timestamps, protected by
+                                 * the object lock */
+
   GMutex elements_lock;
   guint32 elements_cookie;
   GList *elements;              /* factories we can use for selecting elements */
@@ -558,7 +566,8 @@ enum
   PROP_AUDIO_FILTER,
   PROP_VIDEO_FILTER,
   PROP_MULTIVIEW_MODE,
-  PROP_MULTIVIEW_FLAGS
+  PROP_MULTIVIEW_FLAGS,
+  PROP_STARTUP_STATS
 };
 
 /* signals */
@@ -601,6 +610,11 @@ static GstSample *gst_play_bin3_convert_sample (GstPlayBin3 * playbin,
 static GstStateChangeReturn setup_next_source (GstPlayBin3 * playbin,
     GstState target);
 
+static void source_group_prewarm (GstPlayBin3 * playbin,
+    GstSourceGroup * group);
+static void source_group_unprewarm (GstPlayBin3 * playbin,
+    GstSourceGroup * group);
+
 static void no_more_pads_cb (GstElement * decodebin, GstPlayBin3 * playbin);
 static void pad_removed_cb (GstElement * decodebin, GstPad * pad,
     GstPlayBin3 * playbin);
@@ -951,6 +965,22 @@ gst_play_bin3_class_init (GstPlayBin3Class * klass)
           GST_TYPE_VIDEO_MULTIVIEW_FLAGS, GST_VIDEO_MULTIVIEW_FLAGS_NONE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstPlayBin3::startup-stats
+   *
+   * A #GstStructure with a monotonic timestamp for each startup phase of
+   * the current run: "start" (READY to PAUSED begins), "group-activated"
+   * (the source group was activated) and "preroll-done" (the pipeline
+   * prerolled). Only the first occurrence of each phase is recorded; the
+   * stats are reset on the next READY to PAUSED transition.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_klass, PROP_STARTUP_STATS,
+      g_param_spec_boxed ("startup-stats", "Startup statistics",
+          "Timestamps of the startup phases of the current run",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstPlayBin3::about-to-finish
    * @playbin: a #GstPlayBin3
@@ -1047,6 +1077,16 @@ gst_play_bin3_class_init (GstPlayBin3Class * klass)
       GST_DEBUG_FUNCPTR (gst_play_bin3_deep_element_added);
 }
 
+/* record the monotonic time a startup phase first happened, for the
+ * startup-stats property */
+static void
+mark_startup_phase (GstPlayBin3 * playbin, const gchar * phase)
+{
+  GST_OBJECT_LOCK (playbin);
+  gst_playback_utils_mark_startup_phase (&playbin->startup_stats, phase);
+  GST_OBJECT_UNLOCK (playbin);
+}
+
 static void
 do_async_start (GstPlayBin3 * playbin)
 {
@@ -1066,6 +1106,7 @@ do_async_done (GstPlayBin3 * playbin)
 
   if (playbin->async_pending) {
     GST_DEBUG_OBJECT (playbin, "posting ASYNC_DONE");
+    mark_startup_phase (playbin, "preroll-done");
     message =
         gst_message_new_async_done (GST_OBJECT_CAST (playbin),
         GST_CLOCK_TIME_NONE);
@@ -1416,6 +1457,8 @@ gst_play_bin3_finalize (GObject * object)
     gst_object_unref (playbin->text_stream_combiner);
   }
 
+  gst_playback_utils_reset_startup_stats (&playbin->startup_stats);
+
   g_ptr_array_free (playbin->combiner[PLAYBIN_STREAM_AUDIO].streams, TRUE);
   g_ptr_array_free (playbin->combiner[PLAYBIN_STREAM_VIDEO].streams, TRUE);
   g_ptr_array_free (playbin->combiner[PLAYBIN_STREAM_TEXT].streams, TRUE);
@@ -1496,6 +1539,9 @@ gst_play_bin3_set_uri (GstPlayBin3 * playbin, const gchar * uri)
   GST_PLAY_BIN3_LOCK (playbin);
   group = playbin->next_group;
 
+  /* a previously pre-warmed next uri is no longer valid */
+  source_group_unprewarm (playbin, group);
+
   GST_SOURCE_GROUP_LOCK (group);
   /* store the uri in the next group we will play */
   g_free (group->uri);
@@ -1504,6 +1550,13 @@ gst_play_bin3_set_uri (GstPlayBin3 * playbin, const gchar * uri)
   GST_SOURCE_GROUP_UNLOCK (group);
 
   GST_DEBUG ("set new uri to %s", uri);
+
+  /* if something is playing already, start pre-warming the queued uri so
+   * that the switch-over does not have to connect and buffer from scratch */
+  if (playbin->curr_group && playbin->curr_group->active
+      && GST_STATE (playbin) >= GST_STATE_PAUSED)
+    source_group_prewarm (playbin, group);
+
   GST_PLAY_BIN3_UNLOCK (playbin);
 }
 
@@ -2137,6 +2190,11 @@ gst_play_bin3_get_property (GObject * object, guint prop_id, GValue * value,
       g_value_set_flags (value, playbin->multiview_flags);
       GST_OBJECT_UNLOCK (playbin);
       break;
+    case PROP_STARTUP_STATS:
+      GST_OBJECT_LOCK (playbin);
+      g_value_set_boxed (value, playbin->startup_stats);
+      GST_OBJECT_UNLOCK (playbin);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2483,6 +2541,21 @@ static const gchar *blacklisted_mimes[] = {
   NULL
 };
 
+/* whether @msg originates from the pre-warmed (not yet active) urisourcebin
+ * of @group. Must be called with the group lock */
+static gboolean
+is_prewarmed_group_message (GstSourceGroup * group, GstMessage * msg)
+{
+  if (!group->prewarmed || group->active || group->urisourcebin == NULL)
+    return FALSE;
+  if (GST_MESSAGE_SRC (msg) == NULL)
+    return FALSE;
+
+  return GST_MESSAGE_SRC (msg) == GST_OBJECT_CAST (group->urisourcebin)
+      || gst_object_has_as_ancestor (GST_MESSAGE_SRC (msg),
+      GST_OBJECT_CAST (group->urisourcebin));
+}
+
 static void
 gst_play_bin3_handle_message (GstBin * bin, GstMessage * msg)
 {
@@ -2502,6 +2575,27 @@ gst_play_bin3_handle_message (GstBin * bin, GstMessage * msg)
       }
     }
     g_free (detail);
+  } else if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR) {
+    GstSourceGroup *group = playbin->next_group;
+    gboolean drop = FALSE;
+
+    /* errors from a pre-warmed (not yet active) group must not reach the
+     * application while the current uri still plays. Remember the failure
+     * so that activating the group starts from scratch and surfaces the
+     * error at the natural time */
+    GST_SOURCE_GROUP_LOCK (group);
+    if (is_prewarmed_group_message (group, msg)) {
+      GST_DEBUG_OBJECT (playbin, "dropping error from pre-warmed group %p",
+          group);
+      group->prewarm_failed = TRUE;
+      drop = TRUE;
+    }
+    GST_SOURCE_GROUP_UNLOCK (group);
+
+    if (drop) {
+      gst_message_unref (msg);
+      msg = NULL;
+    }
   } else if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_STREAM_START) {
     GstSourceGroup *new_group = playbin->curr_group;
     GstMessage *buffering_msg = NULL;
@@ -2523,9 +2617,24 @@ gst_play_bin3_handle_message (GstBin * bin, GstMessage * msg)
     }
 
   } else if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_BUFFERING) {
+    GstSourceGroup *next_group = playbin->next_group;
     GstSourceGroup *group = playbin->curr_group;
     gboolean pending;
 
+    /* buffering in a pre-warmed group must not be reported as buffering of
+     * the playing uri, store the last message until the group is switched
+     * in and its streams start */
+    GST_SOURCE_GROUP_LOCK (next_group);
+    if (is_prewarmed_group_message (next_group, msg)) {
+      GST_DEBUG_OBJECT (playbin, "Storing buffering message from pre-warmed "
+          "group %p %" GST_PTR_FORMAT, next_group, msg);
+      gst_message_replace (&next_group->pending_buffering_msg, msg);
+      gst_message_unref (msg);
+      GST_SOURCE_GROUP_UNLOCK (next_group);
+      return;
+    }
+    GST_SOURCE_GROUP_UNLOCK (next_group);
+
     /* drop buffering messages from child queues while we are switching
      * groups (because the application set a new uri in about-to-finish)
      * if the playsink queue still has buffers to play */
@@ -4649,6 +4758,181 @@ deactivate_decodebin (GstPlayBin3 * playbin)
   }
 }
 
+/* Pre-warming: when the application queues the next uri while the current
+ * one is still playing, we already create, configure and pre-roll the next
+ * urisourcebin in the background with its output pads blocked. Activating
+ * the group then only has to route the pads into decodebin3, so the
+ * switch-over does not have to wait for connection setup and buffering.
+ * Decoder setup is covered by decodebin3 reusing and prefetching its
+ * decoder slots. */
+
+static GstPadProbeReturn
+prewarm_pad_blocked_cb (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  /* hold the pad blocked until the group is activated */
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+prewarm_pad_added (GstElement * urisrc, GstPad * pad, GstSourceGroup * group)
+{
+  gulong block_id;
+
+  GST_DEBUG_OBJECT (group->playbin, "pad %s:%s added on pre-warmed group %p",
+      GST_DEBUG_PAD_NAME (pad), group);
+
+  block_id = gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BLOCK_DOWNSTREAM,
+      prewarm_pad_blocked_cb, NULL, NULL);
+  g_object_set_data (G_OBJECT (pad), "playbin3.prewarmblock",
+      GSIZE_TO_POINTER (block_id));
+}
+
+static void
+source_group_prewarm (GstPlayBin3 * playbin, GstSourceGroup * group)
+{
+  GstElement *urisrcbin;
+  GstPlayFlags flags;
+
+  GST_PLAY_BIN3_LOCK (playbin);
+  GST_SOURCE_GROUP_LOCK (group);
+  if (group->prewarmed || group->active || group->uri == NULL)
+    goto done;
+
+  if (!make_or_reuse_element (playbin, "urisourcebin", &group->urisourcebin))
+    goto done;
+  urisrcbin = group->urisourcebin;
+
+  GST_DEBUG_OBJECT (playbin, "pre-warming group %p for uri %s", group,
+      group->uri);
+
+  flags = gst_play_sink_get_flags (playbin->playsink);
+
+  g_object_set (urisrcbin,
+      "connection-speed", playbin->connection_speed / 1000,
+      "uri", group->uri,
+      "download", ((flags & GST_PLAY_FLAG_DOWNLOAD) != 0),
+      "use-buffering", ((flags & GST_PLAY_FLAG_BUFFERING) != 0),
+      "buffer-duration", playbin->buffer_duration,
+      "buffer-size", playbin->buffer_size,
+      "ring-buffer-max-size", playbin->ring_buffer_max_size, NULL);
+
+  /* connect the same signals as activate_group() so that source setup and
+   * autoplugging behave exactly as for a cold start, only the pads are
+   * parked on a blocking probe instead of going to decodebin */
+  group->notify_source_id = g_signal_connect (urisrcbin, "notify::source",
+      G_CALLBACK (notify_source_cb), group);
+  group->autoplug_factories_id =
+      g_signal_connect (urisrcbin, "autoplug-factories",
+      G_CALLBACK (autoplug_factories_cb), group);
+  group->autoplug_select_id =
+      g_signal_connect (urisrcbin, "autoplug-select",
+      G_CALLBACK (autoplug_select_cb), group);
+  group->autoplug_continue_id =
+      g_signal_connect (urisrcbin, "autoplug-continue",
+      G_CALLBACK (autoplug_continue_cb), group);
+  group->autoplug_query_id =
+      g_signal_connect (urisrcbin, "autoplug-query",
+      G_CALLBACK (autoplug_query_cb), group);
+  group->prewarm_pad_added_id = g_signal_connect (urisrcbin, "pad-added",
+      G_CALLBACK (prewarm_pad_added), group);
+
+  group->prewarmed = TRUE;
+  group->prewarm_failed = FALSE;
+  GST_SOURCE_GROUP_UNLOCK (group);
+
+  /* the group is not active yet, keep the element out of our own state
+   * changes and drive it to PAUSED ourselves */
+  gst_element_set_locked_state (urisrcbin, TRUE);
+  if (gst_element_set_state (urisrcbin, GST_STATE_PAUSED) ==
+      GST_STATE_CHANGE_FAILURE) {
+    GST_DEBUG_OBJECT (playbin, "pre-warming group %p failed", group);
+    GST_SOURCE_GROUP_LOCK (group);
+    group->prewarm_failed = TRUE;
+    GST_SOURCE_GROUP_UNLOCK (group);
+  }
+  GST_PLAY_BIN3_UNLOCK (playbin);
+  return;
+
+done:
+  GST_SOURCE_GROUP_UNLOCK (group);
+  GST_PLAY_BIN3_UNLOCK (playbin);
+}
+
+/* undo a pre-warm that will not be used (a new uri was queued, we shut down
+ * or the pre-rolled element posted an error). The element is kept around in
+ * READY for later reuse */
+static void
+source_group_unprewarm (GstPlayBin3 * playbin, GstSourceGroup * group)
+{
+  GstElement *urisrcbin;
+
+  GST_PLAY_BIN3_LOCK (playbin);
+  GST_SOURCE_GROUP_LOCK (group);
+  if (!group->prewarmed) {
+    GST_SOURCE_GROUP_UNLOCK (group);
+    GST_PLAY_BIN3_UNLOCK (playbin);
+    return;
+  }
+  GST_DEBUG_OBJECT (playbin, "dropping pre-warmed group %p", group);
+
+  urisrcbin = group->urisourcebin;
+  REMOVE_SIGNAL (urisrcbin, group->prewarm_pad_added_id);
+  REMOVE_SIGNAL (urisrcbin, group->notify_source_id);
+  REMOVE_SIGNAL (urisrcbin, group->autoplug_factories_id);
+  REMOVE_SIGNAL (urisrcbin, group->autoplug_select_id);
+  REMOVE_SIGNAL (urisrcbin, group->autoplug_continue_id);
+  REMOVE_SIGNAL (urisrcbin, group->autoplug_query_id);
+  group->prewarmed = FALSE;
+  group->prewarm_failed = FALSE;
+  GST_SOURCE_GROUP_UNLOCK (group);
+
+  gst_element_set_state (urisrcbin, GST_STATE_READY);
+  gst_element_set_locked_state (urisrcbin, FALSE);
+  GST_PLAY_BIN3_UNLOCK (playbin);
+}
+
+/* route the pads the pre-rolled urisourcebin already exposed into decodebin
+ * and release their blocks */
+static void
+source_group_replay_prewarmed_pads (GstPlayBin3 * playbin,
+    GstSourceGroup * group)
+{
+  GstIterator *it;
+  GValue item = { 0, };
+  gboolean done = FALSE;
+
+  it = gst_element_iterate_src_pads (group->urisourcebin);
+  while (!done) {
+    switch (gst_iterator_next (it, &item)) {
+      case GST_ITERATOR_OK:{
+        GstPad *pad = g_value_get_object (&item);
+        gulong block_id =
+            GPOINTER_TO_SIZE (g_object_get_data (G_OBJECT (pad),
+                "playbin3.prewarmblock"));
+
+        if (!gst_pad_is_linked (pad))
+          urisrc_pad_added (group->urisourcebin, pad, group);
+        if (block_id) {
+          g_object_set_data (G_OBJECT (pad), "playbin3.prewarmblock", NULL);
+          gst_pad_remove_probe (pad, block_id);
+        }
+        g_value_reset (&item);
+        break;
+      }
+      case GST_ITERATOR_RESYNC:
+        gst_iterator_resync (it);
+        break;
+      case GST_ITERATOR_DONE:
+      case GST_ITERATOR_ERROR:
+        done = TRUE;
+        break;
+    }
+  }
+  g_value_unset (&item);
+  gst_iterator_free (it);
+}
+
 /* must be called with PLAY_BIN_LOCK */
 static GstStateChangeReturn
 activate_group (GstPlayBin3 * playbin, GstSourceGroup * group, GstState target)
@@ -4666,6 +4950,11 @@ activate_group (GstPlayBin3 * playbin, GstSourceGroup * group, GstState target)
 
   GST_DEBUG_OBJECT (playbin, "activating group %p", group);
 
+  /* if pre-warming this group failed, start from scratch; the error will
+   * surface again from the new attempt */
+  if (group->prewarm_failed)
+    source_group_unprewarm (playbin, group);
+
   GST_SOURCE_GROUP_LOCK (group);
 
   /* First set up the custom sinks */
@@ -4721,47 +5010,56 @@ activate_group (GstPlayBin3 * playbin, GstSourceGroup * group, GstState target)
   }
 
 
-  if (!make_or_reuse_element (playbin, "urisourcebin", &group->urisourcebin))
-    goto no_urisrcbin;
-  urisrcbin = group->urisourcebin;
+  if (group->prewarmed) {
+    /* the urisourcebin was already created, configured and pre-rolled when
+     * the uri was queued, we only need to route its pads to decodebin
+     * further below */
+    GST_DEBUG_OBJECT (playbin, "activating pre-warmed group %p", group);
+    urisrcbin = group->urisourcebin;
+    REMOVE_SIGNAL (urisrcbin, group->prewarm_pad_added_id);
+  } else {
+    if (!make_or_reuse_element (playbin, "urisourcebin", &group->urisourcebin))
+      goto no_urisrcbin;
+    urisrcbin = group->urisourcebin;
 
-  flags = gst_play_sink_get_flags (playbin->playsink);
+    flags = gst_play_sink_get_flags (playbin->playsink);
 
-  g_object_set (urisrcbin,
-      /* configure connection speed */
-      "connection-speed", playbin->connection_speed / 1000,
-      /* configure uri */
-      "uri", group->uri,
-      /* configure download buffering */
-      "download", ((flags & GST_PLAY_FLAG_DOWNLOAD) != 0),
-      /* configure buffering of demuxed/parsed data */
-      "use-buffering", ((flags & GST_PLAY_FLAG_BUFFERING) != 0),
-      /* configure buffering parameters */
-      "buffer-duration", playbin->buffer_duration,
-      "buffer-size", playbin->buffer_size,
-      "ring-buffer-max-size", playbin->ring_buffer_max_size, NULL);
+    g_object_set (urisrcbin,
+        /* configure connection speed */
+        "connection-speed", playbin->connection_speed / 1000,
+        /* configure uri */
+        "uri", group->uri,
+        /* configure download buffering */
+        "download", ((flags & GST_PLAY_FLAG_DOWNLOAD) != 0),
+        /* configure buffering of demuxed/parsed data */
+        "use-buffering", ((flags & GST_PLAY_FLAG_BUFFERING) != 0),
+        /* configure buffering parameters */
+        "buffer-duration", playbin->buffer_duration,
+        "buffer-size", playbin->buffer_size,
+        "ring-buffer-max-size", playbin->ring_buffer_max_size, NULL);
+
+    group->notify_source_id = g_signal_connect (urisrcbin, "notify::source",
+        G_CALLBACK (notify_source_cb), group);
+
+    /* will be called when a new media type is found. We return a list of decoders
+     * including sinks for decodebin to try */
+    group->autoplug_factories_id =
+        g_signal_connect (urisrcbin, "autoplug-factories",
+        G_CALLBACK (autoplug_factories_cb), group);
+    group->autoplug_select_id =
+        g_signal_connect (urisrcbin, "autoplug-select",
+        G_CALLBACK (autoplug_select_cb), group);
+    group->autoplug_continue_id =
+        g_signal_connect (urisrcbin, "autoplug-continue",
+        G_CALLBACK (autoplug_continue_cb), group);
+    group->autoplug_query_id =
+        g_signal_connect (urisrcbin, "autoplug-query",
+        G_CALLBACK (autoplug_query_cb), group);
+  }
 
   /* we have 1 pending no-more-pads */
   group->pending = 1;
 
-  group->notify_source_id = g_signal_connect (urisrcbin, "notify::source",
-      G_CALLBACK (notify_source_cb), group);
-
-  /* will be called when a new media type is found. We return a list of decoders
-   * including sinks for decodebin to try */
-  group->autoplug_factories_id =
-      g_signal_connect (urisrcbin, "autoplug-factories",
-      G_CALLBACK (autoplug_factories_cb), group);
-  group->autoplug_select_id =
-      g_signal_connect (urisrcbin, "autoplug-select",
-      G_CALLBACK (autoplug_select_cb), group);
-  group->autoplug_continue_id =
-      g_signal_connect (urisrcbin, "autoplug-continue",
-      G_CALLBACK (autoplug_continue_cb), group);
-  group->autoplug_query_id =
-      g_signal_connect (urisrcbin, "autoplug-query",
-      G_CALLBACK (autoplug_query_cb), group);
-
   group->urisrc_pad_added_id = g_signal_connect (urisrcbin, "pad-added",
       G_CALLBACK (urisrc_pad_added), group);
   group->urisrc_pad_removed_id = g_signal_connect (urisrcbin,
@@ -4830,6 +5128,13 @@ activate_group (GstPlayBin3 * playbin, GstSourceGroup * group, GstState target)
       GST_SOURCE_GROUP_UNLOCK (group);
     }
   }
+  if (group->prewarmed) {
+    /* let the pads the pre-rolled element already exposed flow into
+     * decodebin and let the element follow our state from now on */
+    source_group_replay_prewarmed_pads (playbin, group);
+    gst_element_set_locked_state (urisrcbin, FALSE);
+    group->prewarmed = FALSE;
+  }
   if ((state_ret =
           gst_element_set_state (urisrcbin,
               target)) == GST_STATE_CHANGE_FAILURE)
@@ -4841,6 +5146,8 @@ activate_group (GstPlayBin3 * playbin, GstSourceGroup * group, GstState target)
   group->active = TRUE;
   GST_SOURCE_GROUP_UNLOCK (group);
 
+  mark_startup_phase (playbin, "group-activated");
+
   return state_ret;
 
   /* ERRORS */
@@ -4901,6 +5208,7 @@ error_cleanup:
     group->text_sink = NULL;
 
     if (urisrcbin) {
+      REMOVE_SIGNAL (group->urisourcebin, group->prewarm_pad_added_id);
       REMOVE_SIGNAL (group->urisourcebin, group->urisrc_pad_added_id);
       REMOVE_SIGNAL (group->urisourcebin, group->urisrc_pad_removed_id);
       REMOVE_SIGNAL (group->urisourcebin, group->notify_source_id);
@@ -5143,6 +5451,11 @@ gst_play_bin3_change_state (GstElement * element, GstStateChange transition)
       GST_LOG_OBJECT (playbin, "clearing shutdown flag");
       memset (&playbin->duration, 0, sizeof (playbin->duration));
       g_atomic_int_set (&playbin->shutdown, 0);
+      /* a new run, start collecting startup timing from scratch */
+      GST_OBJECT_LOCK (playbin);
+      gst_playback_utils_reset_startup_stats (&playbin->startup_stats);
+      GST_OBJECT_UNLOCK (playbin);
+      mark_startup_phase (playbin, "start");
       do_async_start (playbin);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
@@ -5197,6 +5510,8 @@ gst_play_bin3_change_state (GstElement * element, GstStateChange transition)
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       save_current_group (playbin);
+      /* a pre-warmed next group must not keep running while we are down */
+      source_group_unprewarm (playbin, playbin->next_group);
       break;
     case GST_STATE_CHANGE_READY_TO_NULL:
     {
@@ -5210,6 +5525,8 @@ gst_play_bin3_change_state (GstElement * element, GstStateChange transition)
        * and unref them.
        */
       for (i = 0; i < 2; i++) {
+        source_group_unprewarm (playbin, &playbin->groups[i]);
+
         if (playbin->groups[i].active && playbin->groups[i].valid) {
           deactivate_group (playbin, &playbin->groups[i]);
           playbin->groups[i].valid = FALSE;
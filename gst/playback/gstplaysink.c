@@ -3072,12 +3072,16 @@ gen_vis_chain (GstPlaySink * playsink)
   bin = GST_BIN_CAST (chain->chain.bin);
   gst_object_ref_sink (bin);
 
-  /* we're queuing raw audio here, we can remove this queue when we can disable
-   * async behaviour in the video sink. */
+  /* we're queuing raw audio here, the queue decouples the visualisation from
+   * the audio path. It is a leaky single-slot queue so that a slow vis
+   * plugin consumes the most recent audio at its own rate and can never
+   * backpressure the tee and stall audio rendering. */
   chain->queue = gst_element_factory_make ("queue", "visqueue");
   if (chain->queue == NULL)
     goto no_queue;
-  g_object_set (chain->queue, "silent", TRUE, NULL);
+  g_object_set (chain->queue, "silent", TRUE, "leaky", 2,
+      "max-size-buffers", 1, "max-size-bytes", 0,
+      "max-size-time", G_GUINT64_CONSTANT (0), NULL);
   gst_bin_add (bin, chain->queue);
 
   chain->conv = gst_element_factory_make ("audioconvert", "aconv");
@@ -136,12 +136,20 @@ gst_play_sink_convert_bin_set_targets (GstPlaySinkConvertBin * self,
   GST_DEBUG_OBJECT (self, "Setting pad targets with passthrough %d",
       passthrough);
   if (self->conversion_elements == NULL || passthrough) {
-    GST_DEBUG_OBJECT (self, "no conversion elements, using identity (%p) as "
-        "head/tail", self->identity);
     if (!passthrough) {
       GST_WARNING_OBJECT (self,
           "Doing passthrough as no converter elements were added");
     }
+    /* link the src ghost pad straight to the sink proxy pad so that no
+     * element at all sits in the dataflow */
+    gst_ghost_pad_set_target (GST_GHOST_PAD_CAST (self->sinkpad), NULL);
+    if (gst_ghost_pad_set_target (GST_GHOST_PAD_CAST (self->srcpad),
+            self->sink_proxypad)) {
+      GST_DEBUG_OBJECT (self, "Ghost pads linked directly");
+      return;
+    }
+    GST_DEBUG_OBJECT (self, "Direct ghost pad link refused, using "
+        "identity (%p) as head/tail", self->identity);
     head = tail = self->identity;
   } else {
     head = GST_ELEMENT (g_list_first (self->conversion_elements)->data);
@@ -186,7 +194,7 @@ pad_blocked_cb (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
   GstPlaySinkConvertBin *self = user_data;
   GstPad *peer;
   GstCaps *caps;
-  gboolean raw;
+  gboolean raw, bypass;
 
   if (GST_IS_EVENT (info->data) && !GST_EVENT_IS_SERIALIZED (info->data)) {
     GST_DEBUG_OBJECT (self, "Letting non-serialized event %s pass",
@@ -200,35 +208,49 @@ pad_blocked_cb (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
   /* There must be a peer at this point */
   peer = gst_pad_get_peer (self->sinkpad);
   caps = gst_pad_get_current_caps (peer);
-  if (!caps)
+  bypass = FALSE;
+  if (caps) {
+    /* with fixed upstream caps that downstream accepts as they are, no
+     * conversion can ever run and the converters can be taken out of the
+     * dataflow completely */
+    bypass = is_raw_caps (caps, self->audio) &&
+        gst_pad_peer_query_accept_caps (self->srcpad, caps);
+  } else {
     caps = gst_pad_query_caps (peer, NULL);
+  }
   gst_object_unref (peer);
 
   raw = is_raw_caps (caps, self->audio);
-  GST_DEBUG_OBJECT (self, "Caps %" GST_PTR_FORMAT " are raw: %d", caps, raw);
+  GST_DEBUG_OBJECT (self, "Caps %" GST_PTR_FORMAT " are raw: %d, bypass: %d",
+      caps, raw, bypass);
   gst_caps_unref (caps);
 
-  if (raw == self->raw)
+  if (raw == self->raw && bypass == self->bypass)
     goto unblock;
   self->raw = raw;
+  self->bypass = bypass;
 
   gst_ghost_pad_set_target (GST_GHOST_PAD_CAST (self->sinkpad), NULL);
   gst_ghost_pad_set_target (GST_GHOST_PAD_CAST (self->srcpad), NULL);
 
-  if (raw) {
+  if (raw && !bypass) {
     GST_DEBUG_OBJECT (self, "Switching to raw conversion pipeline");
 
     if (self->conversion_elements)
       g_list_foreach (self->conversion_elements,
           (GFunc) gst_play_sink_convert_bin_on_element_added, self);
   } else {
-
-    GST_DEBUG_OBJECT (self, "Switch to passthrough pipeline");
-
-    gst_play_sink_convert_bin_on_element_added (self->identity, self);
+    if (bypass)
+      GST_DEBUG_OBJECT (self,
+          "Downstream accepts the caps, bypassing the converters");
+    else
+      GST_DEBUG_OBJECT (self, "Switch to passthrough pipeline");
+
+    if (self->identity)
+      gst_play_sink_convert_bin_on_element_added (self->identity, self);
   }
 
-  gst_play_sink_convert_bin_set_targets (self, !raw);
+  gst_play_sink_convert_bin_set_targets (self, !raw || bypass);
 
 unblock:
   self->sink_proxypad_block_id = 0;
@@ -310,10 +332,20 @@ gst_play_sink_convert_bin_sink_setcaps (GstPlaySinkConvertBin * self,
   if (raw) {
     if (!gst_pad_is_blocked (self->sink_proxypad)) {
       GstPad *target = gst_ghost_pad_get_target (GST_GHOST_PAD (self->sinkpad));
+      gboolean direct = gst_pad_peer_query_accept_caps (self->srcpad, caps);
 
-      if (!self->raw || (target && !gst_pad_query_accept_caps (target, caps))) {
+      if (self->bypass && !direct) {
+        GST_DEBUG_OBJECT (self, "Downstream no longer accepts the caps, "
+            "putting the converters back into the dataflow");
+        reconfigure = TRUE;
+        block_proxypad (self);
+      } else if (!self->bypass && (!self->raw || direct
+              || (target && !gst_pad_query_accept_caps (target, caps)))) {
         if (!self->raw)
           GST_DEBUG_OBJECT (self, "Changing caps from non-raw to raw");
+        else if (direct)
+          GST_DEBUG_OBJECT (self, "Downstream accepts the new caps directly, "
+              "taking the converters out of the dataflow");
         else
           GST_DEBUG_OBJECT (self, "Changing caps in an incompatible way");
 
@@ -543,6 +575,96 @@ gst_play_sink_convert_bin_remove_elements (GstPlaySinkConvertBin * self)
   }
 }
 
+static void
+gst_play_sink_convert_bin_free_stashed_chain (gpointer data)
+{
+  g_list_free_full ((GList *) data, (GDestroyNotify) gst_object_unref);
+}
+
+/* Must be called with the lock. Parks the current conversion elements under
+ * @key instead of destroying them, so that a later reconfiguration back to
+ * the same setup can reuse the already constructed chain */
+void
+gst_play_sink_convert_bin_stash_elements (GstPlaySinkConvertBin * self,
+    const gchar * key)
+{
+  GList *l;
+
+  if (self->conversion_elements == NULL)
+    return;
+
+  GST_DEBUG_OBJECT (self, "Stashing conversion elements under '%s'", key);
+
+  for (l = self->conversion_elements; l; l = l->next) {
+    GstElement *el = l->data;
+    GstPad *pad, *peer;
+
+    gst_element_set_state (el, GST_STATE_NULL);
+
+    /* unlink from the neighbours, the links inside the chain are
+     * re-established when the chain is taken into use again */
+    pad = gst_element_get_static_pad (el, "sink");
+    if ((peer = gst_pad_get_peer (pad))) {
+      gst_pad_unlink (peer, pad);
+      gst_object_unref (peer);
+    }
+    gst_object_unref (pad);
+
+    pad = gst_element_get_static_pad (el, "src");
+    if ((peer = gst_pad_get_peer (pad))) {
+      gst_pad_unlink (pad, peer);
+      gst_object_unref (peer);
+    }
+    gst_object_unref (pad);
+
+    gst_bin_remove (GST_BIN_CAST (self), el);
+  }
+
+  if (self->stashed_chains == NULL)
+    self->stashed_chains = g_hash_table_new_full (g_str_hash, g_str_equal,
+        g_free, gst_play_sink_convert_bin_free_stashed_chain);
+  g_hash_table_replace (self->stashed_chains, g_strdup (key),
+      self->conversion_elements);
+  self->conversion_elements = NULL;
+}
+
+/* Must be called with the lock. Puts a chain previously stashed under @key
+ * back into use. Returns FALSE if no chain was stashed for @key */
+gboolean
+gst_play_sink_convert_bin_unstash_elements (GstPlaySinkConvertBin * self,
+    const gchar * key)
+{
+  GList *chain, *l;
+  GstElement *prev = NULL;
+
+  if (self->stashed_chains == NULL)
+    return FALSE;
+
+  chain = g_hash_table_lookup (self->stashed_chains, key);
+  if (chain == NULL)
+    return FALSE;
+
+  GST_DEBUG_OBJECT (self, "Reusing stashed conversion elements for '%s'", key);
+
+  /* take our own references before dropping the table entry */
+  chain = g_list_copy (chain);
+  g_list_foreach (chain, (GFunc) gst_object_ref, NULL);
+  g_hash_table_remove (self->stashed_chains, key);
+
+  for (l = chain; l; l = l->next) {
+    GstElement *el = l->data;
+
+    gst_bin_add (GST_BIN_CAST (self), el);
+    if (prev && !gst_element_link_pads_full (prev, "src", el, "sink",
+            GST_PAD_LINK_CHECK_TEMPLATE_CAPS))
+      GST_WARNING_OBJECT (self, "Failed to relink stashed elements");
+    prev = el;
+  }
+  self->conversion_elements = chain;
+
+  return TRUE;
+}
+
 static void
 gst_play_sink_convert_bin_dispose (GObject * object)
 {
@@ -550,6 +672,11 @@ gst_play_sink_convert_bin_dispose (GObject * object)
 
   gst_play_sink_convert_bin_remove_elements (self);
 
+  if (self->stashed_chains) {
+    g_hash_table_unref (self->stashed_chains);
+    self->stashed_chains = NULL;
+  }
+
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
 
@@ -611,6 +738,7 @@ gst_play_sink_convert_bin_change_state (GstElement * element,
       GST_PLAY_SINK_CONVERT_BIN_LOCK (self);
       gst_play_sink_convert_bin_set_targets (self, TRUE);
       self->raw = FALSE;
+      self->bypass = FALSE;
       GST_PLAY_SINK_CONVERT_BIN_UNLOCK (self);
       break;
     default:
@@ -626,6 +754,7 @@ gst_play_sink_convert_bin_change_state (GstElement * element,
       GST_PLAY_SINK_CONVERT_BIN_LOCK (self);
       gst_play_sink_convert_bin_set_targets (self, TRUE);
       self->raw = FALSE;
+      self->bypass = FALSE;
       GST_PLAY_SINK_CONVERT_BIN_UNLOCK (self);
       break;
     case GST_STATE_CHANGE_READY_TO_PAUSED:
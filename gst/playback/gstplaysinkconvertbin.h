@@ -70,7 +70,12 @@ struct _GstPlaySinkConvertBin
   GstPad *srcpad;
 
   gboolean raw;
+  /* TRUE when the ghost pads are linked directly and nothing sits in the
+   * dataflow because downstream accepts the raw caps as they are */
+  gboolean bypass;
   GList *conversion_elements;
+  GHashTable *stashed_chains;   /* previously built conversion chains,
+                                 * keyed by a configuration string */
   GstElement *identity;
 
   GstCaps *converter_caps;
@@ -96,6 +101,12 @@ gst_play_sink_convert_bin_cache_converter_caps (GstPlaySinkConvertBin * self);
 void
 gst_play_sink_convert_bin_remove_elements (GstPlaySinkConvertBin * self);
 void
+gst_play_sink_convert_bin_stash_elements (GstPlaySinkConvertBin * self,
+    const gchar * key);
+gboolean
+gst_play_sink_convert_bin_unstash_elements (GstPlaySinkConvertBin * self,
+    const gchar * key);
+void
 gst_play_sink_convert_bin_add_identity (GstPlaySinkConvertBin * self);
 
 G_END_DECLS
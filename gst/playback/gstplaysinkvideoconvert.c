@@ -112,14 +112,23 @@ gst_play_sink_video_convert_finalize (GObject * object)
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+static gchar *
+gst_play_sink_video_convert_config_key (GstPlaySinkVideoConvert * self)
+{
+  return g_strdup_printf ("converters-%d-balance-%d", self->use_converters,
+      self->use_balance);
+}
+
 static void
 gst_play_sink_video_convert_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
 {
   GstPlaySinkVideoConvert *self = GST_PLAY_SINK_VIDEO_CONVERT_CAST (object);
   gboolean v, changed = FALSE;
+  gchar *old_key;
 
   GST_PLAY_SINK_CONVERT_BIN_LOCK (self);
+  old_key = gst_play_sink_video_convert_config_key (self);
   switch (prop_id) {
     case PROP_USE_CONVERTERS:
       v = g_value_get_boolean (value);
@@ -141,12 +150,19 @@ gst_play_sink_video_convert_set_property (GObject * object, guint prop_id,
 
   if (changed) {
     GstPlaySinkConvertBin *cbin = GST_PLAY_SINK_CONVERT_BIN (self);
+    gchar *new_key = gst_play_sink_video_convert_config_key (self);
+
     GST_DEBUG_OBJECT (self, "Rebuilding converter bin");
-    gst_play_sink_convert_bin_remove_elements (cbin);
-    gst_play_sink_video_convert_add_conversion_elements (self);
+    /* keep the old chain around and reuse a previously built one if we
+     * were in this configuration before, instead of building new elements */
+    gst_play_sink_convert_bin_stash_elements (cbin, old_key);
+    if (!gst_play_sink_convert_bin_unstash_elements (cbin, new_key))
+      gst_play_sink_video_convert_add_conversion_elements (self);
     gst_play_sink_convert_bin_add_identity (cbin);
     gst_play_sink_convert_bin_cache_converter_caps (cbin);
+    g_free (new_key);
   }
+  g_free (old_key);
   GST_PLAY_SINK_CONVERT_BIN_UNLOCK (self);
 }
 
@@ -62,15 +62,22 @@ typedef struct
   guint stream_number;
   GstPad *srcpad;
   GstPad *sinkpad;
+
+  /* Protects the per-buffer state below: the segment, seen_data and the
+   * GAP event parameters. The chain function only ever takes this lock,
+   * so buffers on independent streams don't contend on the element lock;
+   * event handlers hold the element lock and additionally take this one
+   * around accesses to these fields. Lock order: element lock first */
+  GMutex lock;
   GstSegment segment;
+  gboolean seen_data;
+  gboolean send_gap_event;
+  GstClockTime gap_duration;
 
   gboolean wait;                /* TRUE if waiting/blocking */
   gboolean is_eos;              /* TRUE if EOS was received */
   gboolean eos_sent;            /* when EOS was sent downstream */
   gboolean flushing;            /* set after flush-start and before flush-stop */
-  gboolean seen_data;
-  gboolean send_gap_event;
-  GstClockTime gap_duration;
 
   GstStreamFlags flags;
 
@@ -117,6 +124,18 @@ out:
   return opad;
 }
 
+/* Must be called with lock! Keeps the atomic EOS-stream counter in sync
+ * so the chain function can cheaply skip the EOS handling */
+static void
+gst_stream_synchronizer_set_eos (GstStreamSynchronizer * self,
+    GstSyncStream * stream, gboolean is_eos)
+{
+  if (stream->is_eos != is_eos) {
+    stream->is_eos = is_eos;
+    g_atomic_int_add (&self->eos_streams, is_eos ? 1 : -1);
+  }
+}
+
 /* Generic pad functions */
 static GstIterator *
 gst_stream_synchronizer_iterate_internal_links (GstPad * pad,
@@ -164,8 +183,11 @@ gst_stream_synchronizer_src_event (GstPad * pad, GstObject * parent,
 
       GST_STREAM_SYNCHRONIZER_LOCK (self);
       stream = gst_pad_get_element_private (pad);
-      if (stream)
+      if (stream) {
+        g_mutex_lock (&stream->lock);
         running_time_diff = stream->segment.base;
+        g_mutex_unlock (&stream->lock);
+      }
       GST_STREAM_SYNCHRONIZER_UNLOCK (self);
 
       if (running_time_diff == -1) {
@@ -229,12 +251,14 @@ gst_stream_synchronizer_wait (GstStreamSynchronizer * self, GstPad * pad)
       break;
     }
 
+    g_mutex_lock (&stream->lock);
     if (stream->send_gap_event) {
       GstEvent *event;
 
       if (!GST_CLOCK_TIME_IS_VALID (stream->segment.position)) {
         GST_WARNING_OBJECT (pad, "Have no position and can't send GAP event");
         stream->send_gap_event = FALSE;
+        g_mutex_unlock (&stream->lock);
         continue;
       }
 
@@ -244,6 +268,7 @@ gst_stream_synchronizer_wait (GstStreamSynchronizer * self, GstPad * pad)
           "Send GAP event, position: %" GST_TIME_FORMAT " duration: %"
           GST_TIME_FORMAT, GST_TIME_ARGS (stream->segment.position),
           GST_TIME_ARGS (stream->gap_duration));
+      g_mutex_unlock (&stream->lock);
 
       /* drop lock when sending GAP event, which may block in e.g. preroll */
       GST_STREAM_SYNCHRONIZER_UNLOCK (self);
@@ -252,12 +277,15 @@ gst_stream_synchronizer_wait (GstStreamSynchronizer * self, GstPad * pad)
       if (!ret) {
         return ret;
       }
+      g_mutex_lock (&stream->lock);
       stream->send_gap_event = FALSE;
+      g_mutex_unlock (&stream->lock);
 
       /* force a check on the loop conditions as we unlocked a
        * few lines above and those variables could have changed */
       continue;
     }
+    g_mutex_unlock (&stream->lock);
 
     g_cond_wait (&stream->stream_finish_cond, &self->lock);
   }
@@ -305,7 +333,7 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
 
       if ((have_group_id && stream->group_id != group_id) || (!have_group_id
               && stream->stream_start_seqnum != seqnum)) {
-        stream->is_eos = FALSE;
+        gst_stream_synchronizer_set_eos (self, stream, FALSE);
         stream->eos_sent = FALSE;
         stream->flushing = FALSE;
         stream->stream_start_seqnum = seqnum;
@@ -373,6 +401,7 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
 
             ostream->wait = FALSE;
 
+            g_mutex_lock (&ostream->lock);
             if (ostream->segment.format == GST_FORMAT_TIME) {
               if (ostream->segment.rate > 0)
                 stop_running_time =
@@ -403,6 +432,7 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
 
               position = MAX (position, position_running_time);
             }
+            g_mutex_unlock (&ostream->lock);
           }
 
           self->group_start_time += position;
@@ -438,6 +468,8 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
       }
 
       stream = gst_pad_get_element_private (pad);
+      if (stream)
+        g_mutex_lock (&stream->lock);
       if (stream && segment.format == GST_FORMAT_TIME) {
         GST_DEBUG_OBJECT (pad,
             "New stream, updating base from %" GST_TIME_FORMAT " to %"
@@ -467,6 +499,8 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
             gst_format_get_name (segment.format));
         gst_segment_init (&stream->segment, GST_FORMAT_UNDEFINED);
       }
+      if (stream)
+        g_mutex_unlock (&stream->lock);
       GST_STREAM_SYNCHRONIZER_UNLOCK (self);
       break;
     }
@@ -494,9 +528,11 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
       if (stream) {
         GST_DEBUG_OBJECT (pad, "Resetting segment for stream %d",
             stream->stream_number);
+        g_mutex_lock (&stream->lock);
         gst_segment_init (&stream->segment, GST_FORMAT_UNDEFINED);
+        g_mutex_unlock (&stream->lock);
 
-        stream->is_eos = FALSE;
+        gst_stream_synchronizer_set_eos (self, stream, FALSE);
         stream->eos_sent = FALSE;
         stream->flushing = FALSE;
         stream->wait = FALSE;
@@ -510,6 +546,7 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
         if (ostream == stream || ostream->flushing)
           continue;
 
+        g_mutex_lock (&ostream->lock);
         if (ostream->segment.format == GST_FORMAT_TIME) {
           if (ostream->segment.rate > 0)
             start_running_time =
@@ -522,6 +559,7 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
 
           new_group_start_time = MAX (new_group_start_time, start_running_time);
         }
+        g_mutex_unlock (&ostream->lock);
       }
 
       GST_DEBUG_OBJECT (pad,
@@ -542,7 +580,7 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
         GST_STREAM_SYNCHRONIZER_LOCK (self);
         stream = gst_pad_get_element_private (pad);
         if (stream) {
-          stream->is_eos = FALSE;
+          gst_stream_synchronizer_set_eos (self, stream, FALSE);
           stream->eos_sent = FALSE;
           stream->wait = FALSE;
           g_cond_broadcast (&stream->stream_finish_cond);
@@ -569,11 +607,13 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
       }
 
       GST_DEBUG_OBJECT (pad, "Have EOS for stream %d", stream->stream_number);
-      stream->is_eos = TRUE;
+      gst_stream_synchronizer_set_eos (self, stream, TRUE);
 
-      seen_data = stream->seen_data;
       srcpad = gst_object_ref (stream->srcpad);
 
+      g_mutex_lock (&stream->lock);
+      seen_data = stream->seen_data;
+
       if (seen_data && stream->segment.position != -1)
         timestamp = stream->segment.position;
       else if (stream->segment.rate < 0.0 || stream->segment.stop == -1)
@@ -582,6 +622,7 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
         timestamp = stream->segment.stop;
 
       stream->segment.position = timestamp;
+      g_mutex_unlock (&stream->lock);
 
       for (l = self->streams; l; l = l->next) {
         GstSyncStream *ostream = l->data;
@@ -621,8 +662,10 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
         g_slist_free (pads);
       } else {
         if (seen_data) {
+          g_mutex_lock (&stream->lock);
           stream->send_gap_event = TRUE;
           stream->gap_duration = GST_CLOCK_TIME_NONE;
+          g_mutex_unlock (&stream->lock);
           stream->wait = TRUE;
           ret = gst_stream_synchronizer_wait (self, srcpad);
         }
@@ -688,10 +731,14 @@ gst_stream_synchronizer_sink_chain (GstPad * pad, GstObject * parent,
       && GST_CLOCK_TIME_IS_VALID (duration))
     timestamp_end = timestamp + duration;
 
-  GST_STREAM_SYNCHRONIZER_LOCK (self);
+  /* The stream stays alive for as long as data can flow on the pad: it is
+   * only freed after the pads were deactivated, which waits for us. So the
+   * element lock is not needed here and buffers on independent streams
+   * don't serialize through it */
   stream = gst_pad_get_element_private (pad);
 
   if (stream) {
+    g_mutex_lock (&stream->lock);
     stream->seen_data = TRUE;
     if (stream->segment.format == GST_FORMAT_TIME
         && GST_CLOCK_TIME_IS_VALID (timestamp)) {
@@ -703,10 +750,14 @@ gst_stream_synchronizer_sink_chain (GstPad * pad, GstObject * parent,
       else
         stream->segment.position = timestamp_end;
     }
+    g_mutex_unlock (&stream->lock);
+
+    opad = gst_stream_get_other_pad (stream, pad);
+  } else {
+    opad = NULL;
+    GST_WARNING_OBJECT (pad, "Trying to get other pad after releasing");
   }
-  GST_STREAM_SYNCHRONIZER_UNLOCK (self);
 
-  opad = gst_stream_get_other_pad_from_pad (self, pad);
   if (opad) {
     ret = gst_pad_push (opad, buffer);
     gst_object_unref (opad);
@@ -716,38 +767,52 @@ gst_stream_synchronizer_sink_chain (GstPad * pad, GstObject * parent,
   if (ret == GST_FLOW_OK) {
     GList *l;
 
-    GST_STREAM_SYNCHRONIZER_LOCK (self);
     stream = gst_pad_get_element_private (pad);
-    if (stream && stream->segment.format == GST_FORMAT_TIME) {
-      GstClockTime position;
-
-      if (stream->segment.rate > 0.0)
-        position = timestamp_end;
-      else
-        position = timestamp;
-
-      if (GST_CLOCK_TIME_IS_VALID (position)) {
-        GST_LOG_OBJECT (pad,
-            "Updating position from %" GST_TIME_FORMAT " to %" GST_TIME_FORMAT,
-            GST_TIME_ARGS (stream->segment.position), GST_TIME_ARGS (position));
-        stream->segment.position = position;
+    if (stream) {
+      g_mutex_lock (&stream->lock);
+      if (stream->segment.format == GST_FORMAT_TIME) {
+        GstClockTime position;
+
+        if (stream->segment.rate > 0.0)
+          position = timestamp_end;
+        else
+          position = timestamp;
+
+        if (GST_CLOCK_TIME_IS_VALID (position)) {
+          GST_LOG_OBJECT (pad,
+              "Updating position from %" GST_TIME_FORMAT " to %"
+              GST_TIME_FORMAT, GST_TIME_ARGS (stream->segment.position),
+              GST_TIME_ARGS (position));
+          stream->segment.position = position;
+        }
       }
+      g_mutex_unlock (&stream->lock);
     }
 
     /* Advance EOS streams if necessary. For non-EOS
-     * streams the demuxers should already do this! */
+     * streams the demuxers should already do this!
+     * Only take the element lock when some stream actually is EOS */
+    if (g_atomic_int_get (&self->eos_streams) == 0)
+      return ret;
+
     if (!GST_CLOCK_TIME_IS_VALID (timestamp_end) &&
         GST_CLOCK_TIME_IS_VALID (timestamp)) {
       timestamp_end = timestamp + GST_SECOND;
     }
 
+    GST_STREAM_SYNCHRONIZER_LOCK (self);
     for (l = self->streams; l; l = l->next) {
       GstSyncStream *ostream = l->data;
       gint64 position;
 
-      if (!ostream->is_eos || ostream->eos_sent ||
-          ostream->segment.format != GST_FORMAT_TIME)
+      if (!ostream->is_eos || ostream->eos_sent)
+        continue;
+
+      g_mutex_lock (&ostream->lock);
+      if (ostream->segment.format != GST_FORMAT_TIME) {
+        g_mutex_unlock (&ostream->lock);
         continue;
+      }
 
       if (ostream->segment.position != -1)
         position = ostream->segment.position;
@@ -770,7 +835,10 @@ gst_stream_synchronizer_sink_chain (GstPad * pad, GstObject * parent,
 
         ostream->send_gap_event = TRUE;
         ostream->gap_duration = new_start - position;
+        g_mutex_unlock (&ostream->lock);
         g_cond_broadcast (&ostream->stream_finish_cond);
+      } else {
+        g_mutex_unlock (&ostream->lock);
       }
     }
     GST_STREAM_SYNCHRONIZER_UNLOCK (self);
@@ -795,6 +863,7 @@ gst_stream_synchronizer_request_new_pad (GstElement * element,
   stream = g_slice_new0 (GstSyncStream);
   stream->transform = self;
   stream->stream_number = self->current_stream_number;
+  g_mutex_init (&stream->lock);
   g_cond_init (&stream->stream_finish_cond);
   stream->stream_start_seqnum = G_MAXUINT32;
   stream->segment_seqnum = G_MAXUINT32;
@@ -856,6 +925,8 @@ gst_stream_synchronizer_release_stream (GstStreamSynchronizer * self,
 
   GST_DEBUG_OBJECT (self, "Releasing stream %d", stream->stream_number);
 
+  gst_stream_synchronizer_set_eos (self, stream, FALSE);
+
   for (l = self->streams; l; l = l->next) {
     if (l->data == stream) {
       self->streams = g_list_delete_link (self->streams, l);
@@ -880,6 +951,7 @@ gst_stream_synchronizer_release_stream (GstStreamSynchronizer * self,
   gst_pad_set_active (stream->sinkpad, FALSE);
   gst_element_remove_pad (GST_ELEMENT_CAST (self), stream->sinkpad);
 
+  g_mutex_clear (&stream->lock);
   g_cond_clear (&stream->stream_finish_cond);
   g_slice_free (GstSyncStream, stream);
 
@@ -969,8 +1041,10 @@ gst_stream_synchronizer_change_state (GstElement * element,
          * chain () will be blocked on pad_push (), so can't trigger the track
          * which reach EOS to send GAP event. */
         if (stream->is_eos && !stream->eos_sent) {
+          g_mutex_lock (&stream->lock);
           stream->send_gap_event = TRUE;
           stream->gap_duration = GST_CLOCK_TIME_NONE;
+          g_mutex_unlock (&stream->lock);
           g_cond_broadcast (&stream->stream_finish_cond);
         }
       }
@@ -987,13 +1061,15 @@ gst_stream_synchronizer_change_state (GstElement * element,
       for (l = self->streams; l; l = l->next) {
         GstSyncStream *stream = l->data;
 
+        g_mutex_lock (&stream->lock);
         gst_segment_init (&stream->segment, GST_FORMAT_UNDEFINED);
         stream->gap_duration = GST_CLOCK_TIME_NONE;
+        stream->send_gap_event = FALSE;
+        g_mutex_unlock (&stream->lock);
         stream->wait = FALSE;
-        stream->is_eos = FALSE;
+        gst_stream_synchronizer_set_eos (self, stream, FALSE);
         stream->eos_sent = FALSE;
         stream->flushing = FALSE;
-        stream->send_gap_event = FALSE;
       }
       GST_STREAM_SYNCHRONIZER_UNLOCK (self);
       break;
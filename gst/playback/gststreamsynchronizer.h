@@ -53,6 +53,8 @@ struct _GstStreamSynchronizer
   GList *streams;
   guint current_stream_number;
 
+  gint eos_streams;             /* number of streams that are EOS, atomic */
+
   GstClockTime group_start_time;
 
   gboolean have_group_id;
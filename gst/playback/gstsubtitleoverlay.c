@@ -76,7 +76,8 @@ enum
   PROP_0,
   PROP_SILENT,
   PROP_FONT_DESC,
-  PROP_SUBTITLE_ENCODING
+  PROP_SUBTITLE_ENCODING,
+  PROP_IDLE_TIMEOUT
 };
 
 #define gst_subtitle_overlay_parent_class parent_class
@@ -278,6 +279,35 @@ _is_video_pad (GstPad * pad, gboolean * hw_accelerated)
   return ret;
 }
 
+/* Checks whether downstream of the src ghostpad offers the overlay
+ * composition meta caps feature. The renderer then negotiates the feature
+ * itself, attaches the compositions to the buffers instead of blending
+ * them, and accepts whatever format downstream uses, so no converters are
+ * needed around it */
+static gboolean
+_downstream_accepts_composition_meta (GstSubtitleOverlay * self)
+{
+  GstCaps *caps;
+  guint i, n;
+  gboolean ret = FALSE;
+
+  caps = gst_pad_peer_query_caps (self->srcpad, NULL);
+  if (!caps)
+    return FALSE;
+
+  n = gst_caps_get_size (caps);
+  for (i = 0; i < n && !ret; i++) {
+    GstCapsFeatures *f = gst_caps_get_features (caps, i);
+
+    if (f != NULL && gst_caps_features_contains (f,
+            GST_CAPS_FEATURE_META_GST_VIDEO_OVERLAY_COMPOSITION))
+      ret = TRUE;
+  }
+  gst_caps_unref (caps);
+
+  return ret;
+}
+
 static GstCaps *
 _get_sub_caps (GstElementFactory * factory)
 {
@@ -823,6 +853,7 @@ _link_renderer (GstSubtitleOverlay * self, GstElement * renderer,
 {
   GstPad *sink, *src;
   gboolean is_video, is_hw;
+  gboolean attach_meta = FALSE;
 
   is_video = _is_video_pad (self->video_sinkpad, &is_hw);
 
@@ -845,7 +876,13 @@ _link_renderer (GstSubtitleOverlay * self, GstElement * renderer,
     }
     gst_object_unref (sink);
 
-    if (!is_hw) {
+    if (!is_hw && _downstream_accepts_composition_meta (self)) {
+      GST_DEBUG_OBJECT (self, "Downstream supports the overlay composition "
+          "meta, linking renderer without converters");
+      attach_meta = TRUE;
+    }
+
+    if (!is_hw && !attach_meta) {
       /* First link everything internally */
       if (G_UNLIKELY (!_create_element (self, &self->post_colorspace,
                   COLORSPACE, NULL, "post-colorspace", FALSE))) {
@@ -907,7 +944,8 @@ _link_renderer (GstSubtitleOverlay * self, GstElement * renderer,
         return FALSE;
       }
     } else {
-      /* Set src ghostpad target in the harware accelerated case */
+      /* Set src ghostpad target directly in the hardware accelerated case
+       * and when the renderer attaches the compositions as meta */
 
       src = gst_element_get_static_pad (renderer, "src");
       if (G_UNLIKELY (!src)) {
@@ -1041,10 +1079,17 @@ _pad_blocked_cb (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
   GST_DEBUG_OBJECT (pad, "Pad blocked");
 
   GST_SUBTITLE_OVERLAY_LOCK (self);
-  if (pad == self->video_block_pad)
+  if (pad == self->video_block_pad) {
     self->video_sink_blocked = TRUE;
-  else if (pad == self->subtitle_block_pad)
+  } else if (pad == self->subtitle_block_pad) {
     self->subtitle_sink_blocked = TRUE;
+    /* only actual subtitle data justifies building the rendering chain,
+     * sticky events also end up here while we wait in passthrough */
+    if (GST_IS_BUFFER (info->data) || GST_IS_BUFFER_LIST (info->data)) {
+      self->subtitle_data_pending = TRUE;
+      self->last_subtitle_activity = gst_util_get_timestamp ();
+    }
+  }
 
   /* Now either both or the video sink are blocked */
 
@@ -1105,6 +1150,18 @@ _pad_blocked_cb (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
     }
   }
 
+  /* Don't build the rendering chain before actual subtitle data arrived.
+   * Keep the video path in plain passthrough, the subtitle chain function
+   * triggers the rebuild for the first buffer */
+  if (!self->subtitle_data_pending) {
+    GST_DEBUG_OBJECT (self,
+        "No subtitle buffers yet, staying in passthrough");
+    self->subtitle_flush = FALSE;
+    _setup_passthrough (self);
+    do_async_done (self);
+    goto out;
+  }
+
   if (self->subtitle_sink_blocked && !self->video_sink_blocked) {
     GST_DEBUG_OBJECT (self, "Subtitle sink blocked but video not blocked");
     block_video (self);
@@ -1343,6 +1400,8 @@ gst_subtitle_overlay_change_state (GstElement * element,
 
       self->subtitle_flush = FALSE;
       self->subtitle_error = FALSE;
+      self->subtitle_data_pending = FALSE;
+      self->last_subtitle_activity = GST_CLOCK_TIME_NONE;
 
       self->downstream_chain_error = FALSE;
 
@@ -1490,6 +1549,11 @@ gst_subtitle_overlay_get_property (GObject * object, guint prop_id,
       g_value_set_string (value, self->encoding);
       GST_SUBTITLE_OVERLAY_UNLOCK (self);
       break;
+    case PROP_IDLE_TIMEOUT:
+      GST_SUBTITLE_OVERLAY_LOCK (self);
+      g_value_set_uint64 (value, self->idle_timeout);
+      GST_SUBTITLE_OVERLAY_UNLOCK (self);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1551,6 +1615,11 @@ gst_subtitle_overlay_set_property (GObject * object, guint prop_id,
         g_object_set (self->parser, "subtitle-encoding", self->encoding, NULL);
       GST_SUBTITLE_OVERLAY_UNLOCK (self);
       break;
+    case PROP_IDLE_TIMEOUT:
+      GST_SUBTITLE_OVERLAY_LOCK (self);
+      self->idle_timeout = g_value_get_uint64 (value);
+      GST_SUBTITLE_OVERLAY_UNLOCK (self);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1589,6 +1658,22 @@ gst_subtitle_overlay_class_init (GstSubtitleOverlayClass * klass)
           "ISO-8859-15 will be assumed.", NULL,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstSubtitleOverlay::idle-timeout
+   *
+   * Tear the subtitle rendering chain back down to plain video
+   * passthrough after this long without any subtitle data, in
+   * nanoseconds. The chain is rebuilt automatically when the next
+   * subtitle buffer arrives. 0 disables the teardown.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_IDLE_TIMEOUT,
+      g_param_spec_uint64 ("idle-timeout", "Idle Timeout",
+          "Return to passthrough after this long without subtitle data "
+          "(in nanoseconds, 0 = disabled)", 0, G_MAXUINT64, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_static_pad_template (element_class, &srctemplate);
 
   gst_element_class_add_static_pad_template (element_class,
@@ -1758,7 +1843,27 @@ gst_subtitle_overlay_video_sink_chain (GstPad * pad, GstObject * parent,
     GstBuffer * buffer)
 {
   GstSubtitleOverlay *self = GST_SUBTITLE_OVERLAY (parent);
-  GstFlowReturn ret = gst_proxy_pad_chain_default (pad, parent, buffer);
+  GstFlowReturn ret;
+
+  /* If the rendering chain did not see subtitle data for longer than the
+   * configured idle period, tear it back down to plain passthrough. The
+   * blocked pad probe rebuilds it when the next subtitle buffer arrives */
+  if (self->idle_timeout > 0 && !self->passthrough_identity &&
+      self->last_subtitle_activity != GST_CLOCK_TIME_NONE &&
+      gst_util_get_timestamp () - self->last_subtitle_activity >
+      self->idle_timeout) {
+    GST_DEBUG_OBJECT (self,
+        "No subtitle data for longer than the idle timeout, "
+        "returning to passthrough");
+    GST_SUBTITLE_OVERLAY_LOCK (self);
+    self->subtitle_data_pending = FALSE;
+    self->subtitle_flush = TRUE;
+    block_subtitle (self);
+    block_video (self);
+    GST_SUBTITLE_OVERLAY_UNLOCK (self);
+  }
+
+  ret = gst_proxy_pad_chain_default (pad, parent, buffer);
 
   if (G_UNLIKELY (self->downstream_chain_error) || self->passthrough_identity) {
     return ret;
@@ -1786,8 +1891,27 @@ gst_subtitle_overlay_subtitle_sink_chain (GstPad * pad, GstObject * parent,
   if (self->subtitle_error) {
     gst_buffer_unref (buffer);
     return GST_FLOW_OK;
+  } else if (self->passthrough_identity) {
+    /* We're lazily in passthrough and real subtitle data just arrived,
+     * block the pads so that the rendering chain gets built. The buffer
+     * itself can't go anywhere, the ghost pad has no target */
+    GST_SUBTITLE_OVERLAY_LOCK (self);
+    if (!self->subtitle_data_pending && !self->silent) {
+      GST_DEBUG_OBJECT (self,
+          "First subtitle buffer, building rendering chain");
+      self->subtitle_data_pending = TRUE;
+      self->last_subtitle_activity = gst_util_get_timestamp ();
+      block_subtitle (self);
+      block_video (self);
+    }
+    GST_SUBTITLE_OVERLAY_UNLOCK (self);
+    gst_buffer_unref (buffer);
+    return GST_FLOW_OK;
   } else {
-    GstFlowReturn ret = gst_proxy_pad_chain_default (pad, parent, buffer);
+    GstFlowReturn ret;
+
+    self->last_subtitle_activity = gst_util_get_timestamp ();
+    ret = gst_proxy_pad_chain_default (pad, parent, buffer);
 
     if (IS_SUBTITLE_CHAIN_IGNORE_ERROR (ret)) {
       GST_DEBUG_OBJECT (self, "Subtitle chain error: %s",
@@ -1904,6 +2028,7 @@ gst_subtitle_overlay_subtitle_sink_unlink (GstPad * pad, GstObject * parent)
 
   GST_SUBTITLE_OVERLAY_LOCK (self);
   self->subtitle_error = FALSE;
+  self->subtitle_data_pending = FALSE;
 
   block_subtitle (self);
   block_video (self);
@@ -1925,6 +2050,8 @@ gst_subtitle_overlay_subtitle_sink_event (GstPad * pad, GstObject * parent,
     GST_SUBTITLE_OVERLAY_LOCK (self);
     self->subtitle_flush = TRUE;
     self->subtitle_error = FALSE;
+    /* a new stream starts out in passthrough until its first buffer */
+    self->subtitle_data_pending = FALSE;
     block_subtitle (self);
     block_video (self);
     GST_SUBTITLE_OVERLAY_UNLOCK (self);
@@ -2070,6 +2197,8 @@ gst_subtitle_overlay_init (GstSubtitleOverlay * self)
 
   self->fps_n = 0;
   self->fps_d = 0;
+
+  self->last_subtitle_activity = GST_CLOCK_TIME_NONE;
 }
 
 gboolean
@@ -83,6 +83,17 @@ struct _GstSubtitleOverlay
   gboolean subtitle_flush;
   gboolean subtitle_error;
 
+  /* TRUE once an actual subtitle buffer arrived for the current stream.
+   * The rendering chain is only built once this is set, before that the
+   * video runs in plain passthrough and the subtitle stream is parked
+   * on its blocked pad */
+  gboolean subtitle_data_pending;
+  /* monotonic time of the last subtitle buffer, for idle-timeout */
+  GstClockTime last_subtitle_activity;
+  /* tear the rendering chain back down to passthrough after this long
+   * without subtitle data (ns, 0 = disabled) */
+  guint64 idle_timeout;
+
   GMutex factories_lock;
   GList *factories;
   guint32 factories_cookie;
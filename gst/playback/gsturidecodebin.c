@@ -68,6 +68,20 @@ typedef struct _GstURIDecodeBinStream
   guint bitrate;
 } GstURIDecodeBinStream;
 
+/* A standby is a hidden, state-locked uridecodebin child that pre-rolls an
+ * alternate URI in the background. Its output pads are kept blocked so that
+ * the first data queues up inside the child. When the uri property is later
+ * switched to a standby URI, setup_source() promotes the child instead of
+ * building and pre-rolling a new source. */
+typedef struct _GstURIDecodeBinStandby
+{
+  GstURIDecodeBin *dbin;
+  gchar *uri;
+  GstElement *child;            /* hidden uridecodebin, state locked */
+  GList *blocked_pads;          /* pads of @child holding a block probe */
+  gboolean failed;              /* the child posted an ERROR message */
+} GstURIDecodeBinStandby;
+
 /**
  * GstURIDecodeBin
  *
@@ -116,6 +130,10 @@ struct _GstURIDecodeBin
   gboolean expose_allstreams;   /* Whether to expose unknow type streams or not */
 
   guint64 ring_buffer_max_size; /* 0 means disabled */
+
+  gchar **standby_uris;         /* URIs to keep pre-rolled for fast switching */
+  GList *standbys;              /* GstURIDecodeBinStandby, protected by lock */
+  GstElement *adopted;          /* promoted standby child, if any */
 };
 
 struct _GstURIDecodeBinClass
@@ -182,6 +200,7 @@ enum
 #define DEFAULT_USE_BUFFERING       FALSE
 #define DEFAULT_EXPOSE_ALL_STREAMS  TRUE
 #define DEFAULT_RING_BUFFER_MAX_SIZE 0
+#define DEFAULT_STANDBY_URIS        NULL
 
 enum
 {
@@ -196,7 +215,8 @@ enum
   PROP_DOWNLOAD,
   PROP_USE_BUFFERING,
   PROP_EXPOSE_ALL_STREAMS,
-  PROP_RING_BUFFER_MAX_SIZE
+  PROP_RING_BUFFER_MAX_SIZE,
+  PROP_STANDBY_URIS
 };
 
 static guint gst_uri_decode_bin_signals[LAST_SIGNAL] = { 0 };
@@ -206,6 +226,7 @@ GType gst_uri_decode_bin_get_type (void);
 G_DEFINE_TYPE (GstURIDecodeBin, gst_uri_decode_bin, GST_TYPE_BIN);
 
 static void remove_decoders (GstURIDecodeBin * bin, gboolean force);
+static void sync_standby_pool (GstURIDecodeBin * dec);
 static void gst_uri_decode_bin_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
 static void gst_uri_decode_bin_get_property (GObject * object, guint prop_id,
@@ -496,6 +517,28 @@ gst_uri_decode_bin_class_init (GstURIDecodeBinClass * klass)
           0, G_MAXUINT, DEFAULT_RING_BUFFER_MAX_SIZE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstURIDecodeBin::standby-uris
+   *
+   * A set of alternate URIs to pre-roll in the background while another URI
+   * is playing. For each URI a hidden uridecodebin child is created, linked
+   * up and pre-rolled to PAUSED with its output blocked. When the
+   * #GstURIDecodeBin:uri property is afterwards switched to one of these
+   * URIs, the prepared instance is promoted instead of building and
+   * pre-rolling a new source chain, which makes the switch almost
+   * instantaneous.
+   *
+   * Standby instances use the default autoplugging, the autoplug-* signals
+   * are not emitted for them. Errors from standby instances are not posted
+   * on the bus, the failing URI is silently dropped from the pool.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_STANDBY_URIS,
+      g_param_spec_boxed ("standby-uris", "Standby URIs",
+          "Alternate URIs to keep pre-rolled for fast switching",
+          G_TYPE_STRV, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstURIDecodeBin::unknown-type:
    * @bin: The uridecodebin.
@@ -747,6 +790,7 @@ gst_uri_decode_bin_finalize (GObject * obj)
   g_mutex_clear (&dec->factories_lock);
   g_free (dec->uri);
   g_free (dec->encoding);
+  g_strfreev (dec->standby_uris);
   if (dec->factories)
     gst_plugin_feature_list_free (dec->factories);
   if (dec->caps)
@@ -823,6 +867,15 @@ gst_uri_decode_bin_set_property (GObject * object, guint prop_id,
     case PROP_RING_BUFFER_MAX_SIZE:
       dec->ring_buffer_max_size = g_value_get_uint64 (value);
       break;
+    case PROP_STANDBY_URIS:
+      GST_OBJECT_LOCK (dec);
+      g_strfreev (dec->standby_uris);
+      dec->standby_uris = g_value_dup_boxed (value);
+      GST_OBJECT_UNLOCK (dec);
+      /* when not running yet, the pool is built on READY_TO_PAUSED */
+      if (GST_STATE (dec) >= GST_STATE_PAUSED || dec->standbys != NULL)
+        sync_standby_pool (dec);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -883,6 +936,11 @@ gst_uri_decode_bin_get_property (GObject * object, guint prop_id,
     case PROP_RING_BUFFER_MAX_SIZE:
       g_value_set_uint64 (value, dec->ring_buffer_max_size);
       break;
+    case PROP_STANDBY_URIS:
+      GST_OBJECT_LOCK (dec);
+      g_value_set_boxed (value, dec->standby_uris);
+      GST_OBJECT_UNLOCK (dec);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2102,6 +2160,246 @@ remove_source (GstURIDecodeBin * bin)
   }
 }
 
+/* remove the promoted standby child, if any */
+static void
+remove_adopted (GstURIDecodeBin * bin)
+{
+  if (bin->adopted) {
+    GST_DEBUG_OBJECT (bin, "removing promoted standby element");
+    gst_element_set_state (bin->adopted, GST_STATE_NULL);
+    g_signal_handlers_disconnect_by_data (bin->adopted, bin);
+    gst_bin_remove (GST_BIN_CAST (bin), bin->adopted);
+    gst_object_unref (bin->adopted);
+    bin->adopted = NULL;
+  }
+}
+
+static GstPadProbeReturn
+standby_pad_blocked (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  /* hold the pad blocked until the standby is promoted */
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+standby_pad_added_cb (GstElement * element, GstPad * pad,
+    GstURIDecodeBinStandby * standby)
+{
+  gulong probe_id;
+
+  GST_DEBUG_OBJECT (standby->dbin, "standby %s exposed pad %s:%s",
+      standby->uri, GST_DEBUG_PAD_NAME (pad));
+
+  probe_id = gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BLOCK_DOWNSTREAM,
+      standby_pad_blocked, NULL, NULL);
+  g_object_set_data (G_OBJECT (pad), "uridecodebin.standbyblock",
+      GSIZE_TO_POINTER (probe_id));
+
+  GST_URI_DECODE_BIN_LOCK (standby->dbin);
+  standby->blocked_pads =
+      g_list_append (standby->blocked_pads, gst_object_ref (pad));
+  GST_URI_DECODE_BIN_UNLOCK (standby->dbin);
+}
+
+static GstURIDecodeBinStandby *
+standby_new (GstURIDecodeBin * dec, const gchar * uri)
+{
+  GstURIDecodeBinStandby *standby;
+  GstElement *child;
+  GstCaps *caps;
+  gchar *encoding;
+  guint64 speed;
+
+  child = gst_element_factory_make ("uridecodebin", NULL);
+  if (child == NULL)
+    return NULL;
+
+  standby = g_slice_new0 (GstURIDecodeBinStandby);
+  standby->dbin = dec;
+  standby->uri = g_strdup (uri);
+  standby->child = child;
+
+  /* mirror the relevant configuration on the child */
+  GST_OBJECT_LOCK (dec);
+  caps = dec->caps ? gst_caps_ref (dec->caps) : NULL;
+  encoding = g_strdup (dec->encoding);
+  speed = dec->connection_speed / 1000;
+  GST_OBJECT_UNLOCK (dec);
+
+  g_object_set (child, "uri", uri, "caps", caps,
+      "subtitle-encoding", encoding, "connection-speed", speed,
+      "buffer-size", dec->buffer_size, "buffer-duration",
+      dec->buffer_duration, "download", dec->download,
+      "use-buffering", dec->use_buffering,
+      "ring-buffer-max-size", dec->ring_buffer_max_size, NULL);
+  if (caps)
+    gst_caps_unref (caps);
+  g_free (encoding);
+
+  g_signal_connect (child, "pad-added",
+      G_CALLBACK (standby_pad_added_cb), standby);
+
+  /* the child lives in our bin but is excluded from our state changes, we
+   * drive it to PAUSED ourselves and keep it there until it is promoted */
+  gst_bin_add (GST_BIN_CAST (dec), child);
+  gst_element_set_locked_state (child, TRUE);
+
+  GST_DEBUG_OBJECT (dec, "created standby instance for %s", uri);
+
+  return standby;
+}
+
+/* start pre-rolling a standby child. Must be called after the standby was
+ * added to the pool so that its messages are filtered out */
+static void
+standby_start (GstURIDecodeBinStandby * standby)
+{
+  if (gst_element_set_state (standby->child, GST_STATE_PAUSED) ==
+      GST_STATE_CHANGE_FAILURE) {
+    GST_DEBUG_OBJECT (standby->dbin, "standby %s failed to start",
+        standby->uri);
+    standby->failed = TRUE;
+  }
+}
+
+static void
+standby_free (GstURIDecodeBinStandby * standby)
+{
+  GList *walk;
+
+  for (walk = standby->blocked_pads; walk; walk = g_list_next (walk)) {
+    GstPad *pad = walk->data;
+    gulong probe_id = GPOINTER_TO_SIZE (g_object_get_data (G_OBJECT (pad),
+            "uridecodebin.standbyblock"));
+
+    if (probe_id) {
+      g_object_set_data (G_OBJECT (pad), "uridecodebin.standbyblock", NULL);
+      gst_pad_remove_probe (pad, probe_id);
+    }
+    gst_object_unref (pad);
+  }
+  g_list_free (standby->blocked_pads);
+
+  if (standby->child) {
+    g_signal_handlers_disconnect_by_data (standby->child, standby);
+    gst_element_set_state (standby->child, GST_STATE_NULL);
+    gst_bin_remove (GST_BIN_CAST (standby->dbin), standby->child);
+  }
+  g_free (standby->uri);
+  g_slice_free (GstURIDecodeBinStandby, standby);
+}
+
+/* must be called with the lock */
+static GstURIDecodeBinStandby *
+find_ready_standby (GstURIDecodeBin * dec, const gchar * uri)
+{
+  GList *walk;
+
+  if (uri == NULL)
+    return NULL;
+
+  for (walk = dec->standbys; walk; walk = g_list_next (walk)) {
+    GstURIDecodeBinStandby *standby = walk->data;
+
+    if (!standby->failed && standby->blocked_pads != NULL
+        && strcmp (standby->uri, uri) == 0)
+      return standby;
+  }
+  return NULL;
+}
+
+/* bring the pool in sync with the standby-uris property: drop entries that
+ * failed, became active or are no longer configured and create entries for
+ * newly configured URIs */
+static void
+sync_standby_pool (GstURIDecodeBin * dec)
+{
+  GList *walk, *remove = NULL;
+  gchar **uris, *current_uri;
+  gint i;
+
+  GST_OBJECT_LOCK (dec);
+  uris = g_strdupv (dec->standby_uris);
+  current_uri = g_strdup (dec->uri);
+  GST_OBJECT_UNLOCK (dec);
+
+  GST_URI_DECODE_BIN_LOCK (dec);
+  walk = dec->standbys;
+  while (walk) {
+    GstURIDecodeBinStandby *standby = walk->data;
+    GList *next = g_list_next (walk);
+    gboolean keep = !standby->failed;
+
+    if (keep && current_uri && strcmp (standby->uri, current_uri) == 0)
+      keep = FALSE;
+    if (keep) {
+      keep = FALSE;
+      for (i = 0; uris != NULL && uris[i] != NULL; i++) {
+        if (strcmp (uris[i], standby->uri) == 0) {
+          keep = TRUE;
+          break;
+        }
+      }
+    }
+    if (!keep) {
+      dec->standbys = g_list_delete_link (dec->standbys, walk);
+      remove = g_list_prepend (remove, standby);
+    }
+    walk = next;
+  }
+  GST_URI_DECODE_BIN_UNLOCK (dec);
+
+  /* tear the dropped entries down without holding the lock, this can block
+   * on their streaming threads */
+  g_list_free_full (remove, (GDestroyNotify) standby_free);
+
+  for (i = 0; uris != NULL && uris[i] != NULL; i++) {
+    GstURIDecodeBinStandby *standby;
+    gboolean have = FALSE;
+
+    if (current_uri && strcmp (uris[i], current_uri) == 0)
+      continue;
+
+    GST_URI_DECODE_BIN_LOCK (dec);
+    for (walk = dec->standbys; walk; walk = g_list_next (walk)) {
+      standby = walk->data;
+      if (strcmp (standby->uri, uris[i]) == 0) {
+        have = TRUE;
+        break;
+      }
+    }
+    GST_URI_DECODE_BIN_UNLOCK (dec);
+    if (have)
+      continue;
+
+    /* created and started without the lock, pre-rolling a raw source can
+     * expose pads from this very thread */
+    standby = standby_new (dec, uris[i]);
+    if (standby) {
+      GST_URI_DECODE_BIN_LOCK (dec);
+      dec->standbys = g_list_append (dec->standbys, standby);
+      GST_URI_DECODE_BIN_UNLOCK (dec);
+      standby_start (standby);
+    }
+  }
+
+  g_strfreev (uris);
+  g_free (current_uri);
+}
+
+static void
+free_standbys (GstURIDecodeBin * dec)
+{
+  GList *standbys;
+
+  GST_URI_DECODE_BIN_LOCK (dec);
+  standbys = dec->standbys;
+  dec->standbys = NULL;
+  GST_URI_DECODE_BIN_UNLOCK (dec);
+
+  g_list_free_full (standbys, (GDestroyNotify) standby_free);
+}
+
 /* is called when a dynamic source element created a new pad. */
 static void
 source_new_pad (GstElement * element, GstPad * pad, GstURIDecodeBin * bin)
@@ -2178,6 +2476,60 @@ is_live_source (GstElement * source)
   return is_live;
 }
 
+/* take over a pre-rolled standby child as our active source. The child
+ * already contains the complete source and decoding chain, we only need to
+ * expose its pads and let it follow our state from now on. */
+static gboolean
+setup_standby_source (GstURIDecodeBin * decoder,
+    GstURIDecodeBinStandby * standby)
+{
+  GstElement *child = standby->child;
+  GList *walk;
+
+  GST_DEBUG_OBJECT (decoder, "promoting standby instance for %s",
+      standby->uri);
+
+  /* remove the old decoders now, if any */
+  remove_decoders (decoder, FALSE);
+
+  /* stream admin setup */
+  decoder->streams = g_hash_table_new_full (NULL, NULL, NULL, free_stream);
+
+  decoder->adopted = gst_object_ref (child);
+  standby->child = NULL;
+
+  /* follow-up pads appearing or disappearing on the promoted child are
+   * handled like those of a decodebin */
+  g_signal_handlers_disconnect_by_func (child, standby_pad_added_cb, standby);
+  g_signal_connect (child, "pad-added",
+      G_CALLBACK (new_decoded_pad_added_cb), decoder);
+  g_signal_connect (child, "pad-removed", G_CALLBACK (pad_removed_cb),
+      decoder);
+
+  /* expose the pre-rolled pads and then let the data flow */
+  for (walk = standby->blocked_pads; walk; walk = g_list_next (walk)) {
+    GstPad *pad = walk->data;
+    gulong probe_id = GPOINTER_TO_SIZE (g_object_get_data (G_OBJECT (pad),
+            "uridecodebin.standbyblock"));
+
+    expose_decoded_pad (child, pad, decoder);
+    if (probe_id) {
+      g_object_set_data (G_OBJECT (pad), "uridecodebin.standbyblock", NULL);
+      gst_pad_remove_probe (pad, probe_id);
+    }
+  }
+
+  /* from now on the child follows our state */
+  gst_element_set_locked_state (child, FALSE);
+
+  gst_element_no_more_pads (GST_ELEMENT_CAST (decoder));
+  do_async_done (decoder);
+
+  standby_free (standby);
+
+  return TRUE;
+}
+
 /* construct and run the source and decoder elements until we found
  * all the streams or until a preroll queue has been filled.
 */
@@ -2185,14 +2537,26 @@ static gboolean
 setup_source (GstURIDecodeBin * decoder)
 {
   gboolean is_raw, have_out, is_dynamic;
+  GstURIDecodeBinStandby *standby;
 
   GST_DEBUG_OBJECT (decoder, "setup source");
 
   /* delete old src */
   remove_source (decoder);
+  remove_adopted (decoder);
 
   decoder->pending = 0;
 
+  /* if a standby instance already pre-rolled this URI we promote it instead
+   * of building and pre-rolling a new source chain */
+  GST_URI_DECODE_BIN_LOCK (decoder);
+  standby = find_ready_standby (decoder, decoder->uri);
+  if (standby)
+    decoder->standbys = g_list_remove (decoder->standbys, standby);
+  GST_URI_DECODE_BIN_UNLOCK (decoder);
+  if (standby)
+    return setup_standby_source (decoder, standby);
+
   /* create and configure an element that can handle the uri */
   if (!(decoder->source = gen_source_element (decoder)))
     goto no_source;
@@ -2397,6 +2761,33 @@ handle_message (GstBin * bin, GstMessage * msg)
 {
   GstURIDecodeBin *dec = GST_URI_DECODE_BIN (bin);
 
+  /* messages from standby instances must not reach the application nor
+   * influence our own (async) state handling. A standby that fails is just
+   * dropped from the pool on the next sync. */
+  if (dec->standbys != NULL && GST_MESSAGE_SRC (msg) != NULL) {
+    GList *walk;
+
+    GST_URI_DECODE_BIN_LOCK (dec);
+    for (walk = dec->standbys; walk; walk = g_list_next (walk)) {
+      GstURIDecodeBinStandby *standby = walk->data;
+
+      if (standby->child != NULL
+          && (GST_MESSAGE_SRC (msg) == GST_OBJECT_CAST (standby->child)
+              || gst_object_has_as_ancestor (GST_MESSAGE_SRC (msg),
+                  GST_OBJECT_CAST (standby->child)))) {
+        if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR) {
+          GST_WARNING_OBJECT (dec, "standby instance for %s failed, "
+              "dropping it from the pool", standby->uri);
+          standby->failed = TRUE;
+        }
+        GST_URI_DECODE_BIN_UNLOCK (dec);
+        gst_message_unref (msg);
+        return;
+      }
+    }
+    GST_URI_DECODE_BIN_UNLOCK (dec);
+  }
+
   switch (GST_MESSAGE_TYPE (msg)) {
     case GST_MESSAGE_ELEMENT:{
       if (gst_message_has_name (msg, "redirect")) {
@@ -2764,20 +3155,28 @@ gst_uri_decode_bin_change_state (GstElement * element,
       if (ret == GST_STATE_CHANGE_SUCCESS)
         ret = GST_STATE_CHANGE_ASYNC;
 
+      /* now that we preroll, start pre-rolling the standby instances too */
+      sync_standby_pool (decoder);
+
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       GST_DEBUG ("paused to ready");
       remove_decoders (decoder, FALSE);
       remove_source (decoder);
+      remove_adopted (decoder);
       do_async_done (decoder);
       g_list_free_full (decoder->missing_plugin_errors,
           (GDestroyNotify) gst_message_unref);
       decoder->missing_plugin_errors = NULL;
+      /* the standby pool stays alive here so that going back to PAUSED
+       * with another uri can promote a prepared instance */
       break;
     case GST_STATE_CHANGE_READY_TO_NULL:
       GST_DEBUG ("ready to null");
       remove_decoders (decoder, TRUE);
       remove_source (decoder);
+      remove_adopted (decoder);
+      free_standbys (decoder);
       break;
     default:
       break;
@@ -138,6 +138,7 @@ struct _GstURISourceBin
   guint buffer_size;            /* When buffering, buffer size (bytes) */
   gboolean download;
   gboolean use_buffering;
+  gboolean file_buffering;
 
   GstElement *source;
   GList *typefinds;             /* list of typefind element */
@@ -163,6 +164,15 @@ struct _GstURISourceBin
   gint last_buffering_pct;      /* Avoid sending buffering over and over */
   GMutex buffering_lock;
   GMutex buffering_post_lock;
+
+  gint buffering_percent;       /* last aggregated level, ATOMIC, -1 unknown */
+  gint buffering_avg_in;        /* last avg input rate, with buffering_post_lock */
+  gint buffering_avg_out;       /* last avg output rate, with buffering_post_lock */
+  gint64 buffering_left;        /* estimated buffering time left (ms) */
+  guint64 buffering_message_interval;   /* min ns between posted messages */
+  gint64 last_buffering_post_time;      /* monotonic time of the last post */
+
+  GstStructure *startup_stats;  /* startup phase timestamps, protected by lock */
 };
 
 struct _GstURISourceBinClass
@@ -225,7 +235,9 @@ enum
 #define DEFAULT_BUFFER_SIZE         -1
 #define DEFAULT_DOWNLOAD            FALSE
 #define DEFAULT_USE_BUFFERING       TRUE
+#define DEFAULT_FILE_BUFFERING      FALSE
 #define DEFAULT_RING_BUFFER_MAX_SIZE 0
+#define DEFAULT_BUFFERING_MESSAGE_INTERVAL 0
 
 #define DEFAULT_CAPS (gst_static_caps_get (&default_raw_caps))
 enum
@@ -238,7 +250,12 @@ enum
   PROP_BUFFER_DURATION,
   PROP_DOWNLOAD,
   PROP_USE_BUFFERING,
-  PROP_RING_BUFFER_MAX_SIZE
+  PROP_FILE_BUFFERING,
+  PROP_RING_BUFFER_MAX_SIZE,
+  PROP_STARTUP_STATS,
+  PROP_BUFFERING_MESSAGE_INTERVAL,
+  PROP_BUFFERING_PERCENT,
+  PROP_BUFFERING_STATS
 };
 
 static void post_missing_plugin_error (GstElement * dec,
@@ -505,6 +522,25 @@ gst_uri_source_bin_class_init (GstURISourceBinClass * klass)
           "Perform buffering on demuxed/parsed media",
           DEFAULT_USE_BUFFERING, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstURISourceBin::file-buffering:
+   *
+   * Perform buffering through a temporary file on disk instead of in
+   * memory. The buffering element pages cold data out to the file and
+   * reads it back on demand, which keeps the memory footprint bounded
+   * for very large streams.
+   *
+   * This property does nothing when download buffering is activated and
+   * used for the current media type, or when the ring buffer is enabled
+   * with #GstURISourceBin::ring-buffer-max-size.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_FILE_BUFFERING,
+      g_param_spec_boolean ("file-buffering", "File buffering",
+          "Perform buffering through a temporary file on disk",
+          DEFAULT_FILE_BUFFERING, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstURISourceBin::ring-buffer-max-size
    *
@@ -519,6 +555,71 @@ gst_uri_source_bin_class_init (GstURISourceBinClass * klass)
           0, G_MAXUINT, DEFAULT_RING_BUFFER_MAX_SIZE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstURISourceBin::startup-stats
+   *
+   * A #GstStructure with a monotonic timestamp (in nanoseconds) for each
+   * startup phase that happened so far: "start", "source-created",
+   * "typefind-done" and "pad-exposed". The differences between the fields
+   * attribute startup time to the individual phases.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_STARTUP_STATS,
+      g_param_spec_boxed ("startup-stats", "Startup statistics",
+          "Timestamps of the startup phases of the current run",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstURISourceBin::buffering-message-interval:
+   *
+   * The minimum interval in nanoseconds between posted BUFFERING
+   * messages, 0 to post every aggregated change. Messages that start or
+   * end a buffering period (a drop below 100%% and the return to 100%%)
+   * are always posted immediately since applications typically pause and
+   * resume the pipeline on them; only intermediate progress is dropped.
+   * The current level remains readable at any rate through
+   * #GstURISourceBin::buffering-percent and
+   * #GstURISourceBin::buffering-stats.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_BUFFERING_MESSAGE_INTERVAL,
+      g_param_spec_uint64 ("buffering-message-interval",
+          "Buffering message interval",
+          "Minimum interval between BUFFERING messages in ns (0 = all)",
+          0, G_MAXUINT64, DEFAULT_BUFFERING_MESSAGE_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstURISourceBin::buffering-percent:
+   *
+   * The last aggregated buffering level in percent, -1 before any
+   * buffering element reported a level. Reading it is a single atomic
+   * load, so it can be polled cheaply without a bus round trip.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_BUFFERING_PERCENT,
+      g_param_spec_int ("buffering-percent", "Buffering percent",
+          "Last aggregated buffering level (-1 = unknown)",
+          -1, 100, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstURISourceBin::buffering-stats:
+   *
+   * A #GstStructure with the last aggregated buffering state: "percent"
+   * (gint), "avg-in-rate" and "avg-out-rate" (gint, bytes per second) and
+   * "buffering-left" (gint64, milliseconds).
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_BUFFERING_STATS,
+      g_param_spec_boxed ("buffering-stats", "Buffering statistics",
+          "Last aggregated buffering level and rates",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstURISourceBin::unknown-type:
    * @bin: The urisourcebin.
@@ -754,8 +855,14 @@ gst_uri_source_bin_init (GstURISourceBin * urisrc)
   urisrc->buffer_size = DEFAULT_BUFFER_SIZE;
   urisrc->download = DEFAULT_DOWNLOAD;
   urisrc->use_buffering = DEFAULT_USE_BUFFERING;
+  urisrc->file_buffering = DEFAULT_FILE_BUFFERING;
   urisrc->ring_buffer_max_size = DEFAULT_RING_BUFFER_MAX_SIZE;
   urisrc->last_buffering_pct = -1;
+  urisrc->buffering_percent = -1;
+  urisrc->buffering_avg_in = -1;
+  urisrc->buffering_avg_out = -1;
+  urisrc->buffering_left = -1;
+  urisrc->buffering_message_interval = DEFAULT_BUFFERING_MESSAGE_INTERVAL;
 
   GST_OBJECT_FLAG_SET (urisrc, GST_ELEMENT_FLAG_SOURCE);
   gst_bin_set_suppressed_flags (GST_BIN (urisrc),
@@ -770,6 +877,7 @@ gst_uri_source_bin_finalize (GObject * obj)
   remove_demuxer (urisrc);
   g_mutex_clear (&urisrc->lock);
   g_mutex_clear (&urisrc->factories_lock);
+  gst_playback_utils_reset_startup_stats (&urisrc->startup_stats);
   g_free (urisrc->uri);
   if (urisrc->factories)
     gst_plugin_feature_list_free (urisrc->factories);
@@ -807,9 +915,15 @@ gst_uri_source_bin_set_property (GObject * object, guint prop_id,
     case PROP_USE_BUFFERING:
       dec->use_buffering = g_value_get_boolean (value);
       break;
+    case PROP_FILE_BUFFERING:
+      dec->file_buffering = g_value_get_boolean (value);
+      break;
     case PROP_RING_BUFFER_MAX_SIZE:
       dec->ring_buffer_max_size = g_value_get_uint64 (value);
       break;
+    case PROP_BUFFERING_MESSAGE_INTERVAL:
+      dec->buffering_message_interval = g_value_get_uint64 (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -854,15 +968,49 @@ gst_uri_source_bin_get_property (GObject * object, guint prop_id,
     case PROP_USE_BUFFERING:
       g_value_set_boolean (value, dec->use_buffering);
       break;
+    case PROP_FILE_BUFFERING:
+      g_value_set_boolean (value, dec->file_buffering);
+      break;
     case PROP_RING_BUFFER_MAX_SIZE:
       g_value_set_uint64 (value, dec->ring_buffer_max_size);
       break;
+    case PROP_STARTUP_STATS:
+      GST_URI_SOURCE_BIN_LOCK (dec);
+      g_value_set_boxed (value, dec->startup_stats);
+      GST_URI_SOURCE_BIN_UNLOCK (dec);
+      break;
+    case PROP_BUFFERING_MESSAGE_INTERVAL:
+      g_value_set_uint64 (value, dec->buffering_message_interval);
+      break;
+    case PROP_BUFFERING_PERCENT:
+      g_value_set_int (value, g_atomic_int_get (&dec->buffering_percent));
+      break;
+    case PROP_BUFFERING_STATS:
+      g_mutex_lock (&dec->buffering_post_lock);
+      g_value_take_boxed (value, gst_structure_new ("urisourcebin-buffering",
+              "percent", G_TYPE_INT,
+              g_atomic_int_get (&dec->buffering_percent),
+              "avg-in-rate", G_TYPE_INT, dec->buffering_avg_in,
+              "avg-out-rate", G_TYPE_INT, dec->buffering_avg_out,
+              "buffering-left", G_TYPE_INT64, dec->buffering_left, NULL));
+      g_mutex_unlock (&dec->buffering_post_lock);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+/* record the monotonic time a startup phase first happened, for the
+ * startup-stats property */
+static void
+mark_startup_phase (GstURISourceBin * urisrc, const gchar * phase)
+{
+  GST_URI_SOURCE_BIN_LOCK (urisrc);
+  gst_playback_utils_mark_startup_phase (&urisrc->startup_stats, phase);
+  GST_URI_SOURCE_BIN_UNLOCK (urisrc);
+}
+
 static void
 do_async_start (GstURISourceBin * dbin)
 {
@@ -1163,6 +1311,33 @@ done:
   return ret;
 }
 
+/* Point the buffering element at a temporary file in the user cache
+ * directory so it can spill its data to disk */
+static void
+set_temp_template (GstURISourceBin * urisrc, GstElement * queue)
+{
+  gchar *temp_template, *filename;
+  const gchar *tmp_dir, *prgname;
+
+  tmp_dir = g_get_user_cache_dir ();
+  prgname = g_get_prgname ();
+  if (prgname == NULL)
+    prgname = "GStreamer";
+
+  filename = g_strdup_printf ("%s-XXXXXX", prgname);
+
+  /* build our filename */
+  temp_template = g_build_filename (tmp_dir, filename, NULL);
+
+  GST_DEBUG_OBJECT (urisrc, "enable file buffering in %s (%s, %s, %s)",
+      temp_template, tmp_dir, prgname, filename);
+
+  g_object_set (queue, "temp-template", temp_template, NULL);
+
+  g_free (filename);
+  g_free (temp_template);
+}
+
 /* Called with lock held */
 static OutputSlotInfo *
 get_output_slot (GstURISourceBin * urisrc, gboolean do_download,
@@ -1210,27 +1385,8 @@ get_output_slot (GstURISourceBin * urisrc, gboolean do_download,
   g_object_set_data (G_OBJECT (queue), "urisourcebin.slotinfo", slot);
 
   if (do_download) {
-    gchar *temp_template, *filename;
-    const gchar *tmp_dir, *prgname;
-
-    tmp_dir = g_get_user_cache_dir ();
-    prgname = g_get_prgname ();
-    if (prgname == NULL)
-      prgname = "GStreamer";
-
-    filename = g_strdup_printf ("%s-XXXXXX", prgname);
-
-    /* build our filename */
-    temp_template = g_build_filename (tmp_dir, filename, NULL);
-
-    GST_DEBUG_OBJECT (urisrc, "enable download buffering in %s (%s, %s, %s)",
-        temp_template, tmp_dir, prgname, filename);
-
     /* configure progressive download for selected media types */
-    g_object_set (queue, "temp-template", temp_template, NULL);
-
-    g_free (filename);
-    g_free (temp_template);
+    set_temp_template (urisrc, queue);
   } else {
     if (is_adaptive) {
       GST_LOG_OBJECT (urisrc, "Adding queue for adaptive streaming stream");
@@ -1240,6 +1396,11 @@ get_output_slot (GstURISourceBin * urisrc, gboolean do_download,
       GST_LOG_OBJECT (urisrc, "Adding queue for buffering");
       g_object_set (queue, "use-buffering", urisrc->use_buffering, NULL);
     }
+    if (urisrc->file_buffering && urisrc->ring_buffer_max_size == 0) {
+      /* let the queue page its data out to a temporary file so the memory
+       * footprint stays bounded for large streams */
+      set_temp_template (urisrc, queue);
+    }
     g_object_set (queue, "ring-buffer-max-size",
         urisrc->ring_buffer_max_size, NULL);
     /* Disable max-size-buffers - queue based on data rate to the default time limit */
@@ -1378,6 +1539,8 @@ expose_output_pad (GstURISourceBin * urisrc, GstPad * pad)
   gst_pad_set_active (pad, TRUE);
   gst_element_add_pad (GST_ELEMENT_CAST (urisrc), pad);
 
+  mark_startup_phase (urisrc, "pad-exposed");
+
   /* Once we expose a pad, we're no longer async */
   do_async_done (urisrc);
 }
@@ -2029,6 +2192,7 @@ type_found (GstElement * typefind, guint probability,
 
   GST_DEBUG_OBJECT (urisrc, "typefind found caps %" GST_PTR_FORMAT
       " on pad %" GST_PTR_FORMAT, caps, srcpad);
+  mark_startup_phase (urisrc, "typefind-done");
   handle_new_pad (urisrc, srcpad, caps);
 
   gst_object_unref (GST_OBJECT (srcpad));
@@ -2230,6 +2394,8 @@ setup_source (GstURISourceBin * urisrc)
   if (!(urisrc->source = gen_source_element (urisrc)))
     goto no_source;
 
+  mark_startup_phase (urisrc, "source-created");
+
   /* state will be merged later - if file is not found, error will be
    * handled by the application right after. */
   gst_bin_add (GST_BIN_CAST (urisrc), urisrc->source);
@@ -2521,18 +2687,45 @@ handle_buffering_message (GstURISourceBin * urisrc, GstMessage * msg)
         g_list_prepend (urisrc->buffering_status, gst_message_ref (msg));
   }
 
+  /* remember the aggregated level so applications can poll the
+   * buffering-percent and buffering-stats properties instead of doing a
+   * bus round trip */
+  {
+    GstMessage *level_msg = smaller ? smaller : msg;
+    GstBufferingMode mode;
+
+    gst_message_parse_buffering_stats (level_msg, &mode,
+        &urisrc->buffering_avg_in, &urisrc->buffering_avg_out,
+        &urisrc->buffering_left);
+    g_atomic_int_set (&urisrc->buffering_percent, smaller_perc);
+  }
+
   if (smaller_perc == urisrc->last_buffering_pct) {
     /* Don't repeat our last buffering status */
     gst_message_replace (&msg, NULL);
   } else {
-    urisrc->last_buffering_pct = smaller_perc;
-
-    /* now compute the buffering message that should be posted */
-    if (smaller_perc == 100) {
-      g_assert (urisrc->buffering_status == NULL);
-      /* we are posting the original received msg */
+    gint64 now = g_get_monotonic_time ();
+
+    /* don't flood the bus: messages that enter or leave the buffering
+     * state are posted at once, intermediate progress at most once per
+     * buffering-message-interval. The levels above are updated anyway. */
+    if (urisrc->buffering_message_interval > 0 && smaller_perc != 100
+        && urisrc->last_buffering_pct != -1
+        && urisrc->last_buffering_pct != 100
+        && now - urisrc->last_buffering_post_time <
+        (gint64) (urisrc->buffering_message_interval / 1000)) {
+      gst_message_replace (&msg, NULL);
     } else {
-      gst_message_replace (&msg, smaller);
+      urisrc->last_buffering_pct = smaller_perc;
+      urisrc->last_buffering_post_time = now;
+
+      /* now compute the buffering message that should be posted */
+      if (smaller_perc == 100) {
+        g_assert (urisrc->buffering_status == NULL);
+        /* we are posting the original received msg */
+      } else {
+        gst_message_replace (&msg, smaller);
+      }
     }
   }
   BUFFERING_UNLOCK (urisrc);
@@ -2908,6 +3101,11 @@ gst_uri_source_bin_change_state (GstElement * element,
 
   switch (transition) {
     case GST_STATE_CHANGE_READY_TO_PAUSED:
+      /* a new run, start collecting startup timing from scratch */
+      GST_URI_SOURCE_BIN_LOCK (urisrc);
+      gst_playback_utils_reset_startup_stats (&urisrc->startup_stats);
+      GST_URI_SOURCE_BIN_UNLOCK (urisrc);
+      mark_startup_phase (urisrc, "start");
       do_async_start (urisrc);
       break;
     default:
@@ -2959,6 +3157,11 @@ gst_uri_source_bin_change_state (GstElement * element,
           (GDestroyNotify) gst_message_unref);
       urisrc->buffering_status = NULL;
       urisrc->last_buffering_pct = -1;
+      g_atomic_int_set (&urisrc->buffering_percent, -1);
+      urisrc->buffering_avg_in = -1;
+      urisrc->buffering_avg_out = -1;
+      urisrc->buffering_left = -1;
+      urisrc->last_buffering_post_time = 0;
       break;
     case GST_STATE_CHANGE_READY_TO_NULL:
       GST_DEBUG ("ready to null");
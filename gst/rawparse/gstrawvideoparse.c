@@ -885,6 +885,29 @@ gst_raw_video_parse_is_config_ready (GstRawBaseParse * raw_base_parse,
   return gst_raw_video_parse_get_config_ptr (raw_video_parse, config)->ready;
 }
 
+/* Checks if the frame starting at the first byte of @buffer is aligned
+ * well enough (to @align, a power of two minus one) that its memory can be
+ * handed downstream as-is. Only the first memory is mapped, so this never
+ * triggers a merge of multi-memory buffers. */
+static gboolean
+gst_raw_video_parse_frame_start_is_aligned (GstBuffer * buffer, gsize align)
+{
+  GstMemory *mem;
+  GstMapInfo map_info;
+  gboolean aligned;
+
+  if (gst_buffer_n_memory (buffer) == 0)
+    return FALSE;
+
+  mem = gst_buffer_peek_memory (buffer, 0);
+  if (!gst_memory_map (mem, &map_info, GST_MAP_READ))
+    return FALSE;
+  aligned = (((guintptr) map_info.data) & align) == 0;
+  gst_memory_unmap (mem, &map_info);
+
+  return aligned;
+}
+
 static gboolean
 gst_raw_video_parse_process (GstRawBaseParse * raw_base_parse,
     GstRawBaseParseConfig config, GstBuffer * in_data,
@@ -900,22 +923,36 @@ gst_raw_video_parse_process (GstRawBaseParse * raw_base_parse,
   GstVideoInfo *video_info = &(config_ptr->info);
   GstBuffer *out_data;
 
-  if (!gst_buffer_map (in_data, &map_info, GST_MAP_READ)) {
-    GST_WARNING_OBJECT (raw_video_parse, "Failed to map input data");
-    return FALSE;
-  }
+  if (gst_raw_video_parse_frame_start_is_aligned (in_data, 31)) {
+    /* The frame is aligned well enough in the input memory, so hand that
+     * memory downstream as-is instead of copying it out. The span may
+     * cover several non-contiguous memories when upstream buffer
+     * boundaries don't line up with the frame size; the video meta added
+     * below describes the frame layout, and consumers that do need one
+     * contiguous block get it from the transparent merge done by
+     * gst_buffer_map(), so the realignment copy only happens when and
+     * where it is unavoidable. */
+    *processed_data = out_data = gst_buffer_copy_region (in_data,
+        GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS |
+        GST_BUFFER_COPY_MEMORY, 0, GST_VIDEO_INFO_SIZE (video_info));
+  } else {
+    if (!gst_buffer_map (in_data, &map_info, GST_MAP_READ)) {
+      GST_WARNING_OBJECT (raw_video_parse, "Failed to map input data");
+      return FALSE;
+    }
 
-  /* Allocate the output memory our required alignment */
-  *processed_data = out_data = gst_buffer_new_allocate (NULL,
-      GST_VIDEO_INFO_SIZE (video_info), &alloc_params);
-  gst_buffer_fill (*processed_data, 0, map_info.data,
-      GST_VIDEO_INFO_SIZE (video_info));
-  gst_buffer_unmap (in_data, &map_info);
-
-  /* And copy the metadata */
-  gst_buffer_copy_into (*processed_data, in_data,
-      GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS, 0,
-      GST_VIDEO_INFO_SIZE (video_info));
+    /* Allocate the output memory our required alignment */
+    *processed_data = out_data = gst_buffer_new_allocate (NULL,
+        GST_VIDEO_INFO_SIZE (video_info), &alloc_params);
+    gst_buffer_fill (*processed_data, 0, map_info.data,
+        GST_VIDEO_INFO_SIZE (video_info));
+    gst_buffer_unmap (in_data, &map_info);
+
+    /* And copy the metadata */
+    gst_buffer_copy_into (*processed_data, in_data,
+        GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS, 0,
+        GST_VIDEO_INFO_SIZE (video_info));
+  }
 
   if (config_ptr->interlaced) {
     GST_BUFFER_FLAG_SET (out_data, GST_VIDEO_BUFFER_FLAG_INTERLACED);
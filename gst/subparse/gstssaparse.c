@@ -47,6 +47,69 @@ static GstStaticPadTemplate src_templ = GST_STATIC_PAD_TEMPLATE ("src",
 #define gst_ssa_parse_parent_class parent_class
 G_DEFINE_TYPE (GstSsaParse, gst_ssa_parse, GST_TYPE_ELEMENT);
 
+/* Looped content (karaoke) and multiple outputs parse the same cue text
+ * over and over; remember the last few converted cues so repeats skip
+ * the override code stripping and markup escaping entirely. */
+#define SSA_CUE_CACHE_MAX 16
+
+typedef struct
+{
+  gchar *raw;                   /* cue text as found in the stream */
+  gchar *markup;                /* converted pango-markup text */
+} SsaCueCacheEntry;
+
+static void
+ssa_cue_cache_entry_free (SsaCueCacheEntry * entry)
+{
+  g_free (entry->raw);
+  g_free (entry->markup);
+  g_slice_free (SsaCueCacheEntry, entry);
+}
+
+static void
+gst_ssa_parse_clear_cue_cache (GstSsaParse * parse)
+{
+  SsaCueCacheEntry *entry;
+
+  while ((entry = g_queue_pop_head (&parse->cue_cache)))
+    ssa_cue_cache_entry_free (entry);
+}
+
+/* returns a copy of the cached markup for @raw, or NULL */
+static gchar *
+gst_ssa_parse_cue_cache_lookup (GstSsaParse * parse, const gchar * raw)
+{
+  GList *l;
+
+  for (l = parse->cue_cache.head; l != NULL; l = l->next) {
+    SsaCueCacheEntry *entry = l->data;
+
+    if (strcmp (entry->raw, raw) == 0) {
+      /* most recently used first */
+      g_queue_unlink (&parse->cue_cache, l);
+      g_queue_push_head_link (&parse->cue_cache, l);
+      return g_strdup (entry->markup);
+    }
+  }
+  return NULL;
+}
+
+/* takes ownership of @raw and @markup */
+static void
+gst_ssa_parse_cue_cache_store (GstSsaParse * parse, gchar * raw,
+    gchar * markup)
+{
+  SsaCueCacheEntry *entry;
+
+  entry = g_slice_new (SsaCueCacheEntry);
+  entry->raw = raw;
+  entry->markup = markup;
+  g_queue_push_head (&parse->cue_cache, entry);
+
+  if (parse->cue_cache.length > SSA_CUE_CACHE_MAX)
+    ssa_cue_cache_entry_free (g_queue_pop_tail (&parse->cue_cache));
+}
+
 static GstStateChangeReturn gst_ssa_parse_change_state (GstElement *
     element, GstStateChange transition);
 static gboolean gst_ssa_parse_setcaps (GstPad * sinkpad, GstCaps * caps);
@@ -65,6 +128,8 @@ gst_ssa_parse_dispose (GObject * object)
   g_free (parse->ini);
   parse->ini = NULL;
 
+  gst_ssa_parse_clear_cue_cache (parse);
+
   GST_CALL_PARENT (G_OBJECT_CLASS, dispose, (object));
 }
 
@@ -87,6 +152,7 @@ gst_ssa_parse_init (GstSsaParse * parse)
   parse->ini = NULL;
   parse->framed = FALSE;
   parse->send_tags = FALSE;
+  g_queue_init (&parse->cue_cache);
 }
 
 static void
@@ -224,34 +290,39 @@ invalid_init:
 static gboolean
 gst_ssa_parse_remove_override_codes (GstSsaParse * parse, gchar * txt)
 {
-  gchar *t, *end;
   gboolean removed_any = FALSE;
-
-  while ((t = strchr (txt, '{'))) {
-    end = strchr (txt, '}');
-    if (end == NULL) {
-      GST_WARNING_OBJECT (parse, "Missing { for style override code");
-      return removed_any;
+  gchar *r, *w;
+
+  /* single in-place pass: drop {...} override blocks and rewrite the
+   * escape markers, instead of rescanning and shifting the whole string
+   * for every override block. We don't handle the different wrapping
+   * modes yet, so \n, \N and \h are just removed from the text for now */
+  for (r = w = txt; *r != '\0';) {
+    if (*r == '{') {
+      gchar *end = strchr (r, '}');
+
+      if (end == NULL) {
+        GST_WARNING_OBJECT (parse, "Missing { for style override code");
+        /* keep the remaining text as it is */
+        if (w != r)
+          memmove (w, r, strlen (r) + 1);
+        return removed_any;
+      }
+      r = end + 1;
+      removed_any = TRUE;
+    } else if (r[0] == '\\' && (r[1] == 'n' || r[1] == 'N')) {
+      *w++ = ' ';
+      *w++ = '\n';
+      r += 2;
+    } else if (r[0] == '\\' && r[1] == 'h') {
+      *w++ = ' ';
+      *w++ = ' ';
+      r += 2;
+    } else {
+      *w++ = *r++;
     }
-    /* move terminating NUL character forward as well */
-    memmove (t, end + 1, strlen (end + 1) + 1);
-    removed_any = TRUE;
-  }
-
-  /* these may occur outside of curly brackets. We don't handle the different
-   * wrapping modes yet, so just remove these markers from the text for now */
-  while ((t = strstr (txt, "\\n"))) {
-    t[0] = ' ';
-    t[1] = '\n';
-  }
-  while ((t = strstr (txt, "\\N"))) {
-    t[0] = ' ';
-    t[1] = '\n';
-  }
-  while ((t = strstr (txt, "\\h"))) {
-    t[0] = ' ';
-    t[1] = ' ';
   }
+  *w = '\0';
 
   return removed_any;
 }
@@ -292,13 +363,22 @@ gst_ssa_parse_push_line (GstSsaParse * parse, gchar * txt,
 
   GST_LOG_OBJECT (parse, "Text : %s", t);
 
-  if (gst_ssa_parse_remove_override_codes (parse, t)) {
-    GST_LOG_OBJECT (parse, "Clean: %s", t);
-  }
+  escaped = gst_ssa_parse_cue_cache_lookup (parse, t);
+  if (escaped == NULL) {
+    /* keep a copy of the raw text as cache key, the conversion below
+     * works in place */
+    gchar *raw = g_strdup (t);
 
-  /* we claim to output pango markup, so we must escape the
-   * text even if we don't actually use any pango markup yet */
-  escaped = g_markup_printf_escaped ("%s", t);
+    if (gst_ssa_parse_remove_override_codes (parse, t)) {
+      GST_LOG_OBJECT (parse, "Clean: %s", t);
+    }
+
+    /* we claim to output pango markup, so we must escape the
+     * text even if we don't actually use any pango markup yet */
+    escaped = g_markup_printf_escaped ("%s", t);
+
+    gst_ssa_parse_cue_cache_store (parse, raw, g_strdup (escaped));
+  }
 
   len = strlen (escaped);
 
@@ -413,6 +493,7 @@ gst_ssa_parse_change_state (GstElement * element, GstStateChange transition)
       g_free (parse->ini);
       parse->ini = NULL;
       parse->framed = FALSE;
+      gst_ssa_parse_clear_cue_cache (parse);
       break;
     default:
       break;
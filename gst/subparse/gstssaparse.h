@@ -43,6 +43,8 @@ struct _GstSsaParse {
   gboolean        send_tags;
 
   gchar          *ini;
+
+  GQueue          cue_cache;       /* of SsaCueCacheEntry, recently used first */
 };
 
 struct _GstSsaParseClass {
@@ -42,6 +42,12 @@ GST_DEBUG_CATEGORY (sub_parse_debug);
 
 #define DEFAULT_ENCODING   NULL
 #define ATTRIBUTE_REGEX "\\s?[a-zA-Z0-9\\. \t\\(\\)]*"
+/* convert at most this much raw input to UTF-8 per round, so that the first
+ * cues of a large file go out long before the whole file is converted */
+#define CONVERT_CHUNK_SIZE (128 * 1024)
+/* drop consumed text from the start of textbuf in batches of this size
+ * instead of memmoving the whole remainder for every parsed line */
+#define TEXTBUF_COMPACT_THRESHOLD (64 * 1024)
 static const gchar *allowed_srt_tags[] = { "i", "b", "u", NULL };
 static const gchar *allowed_vtt_tags[] =
     { "i", "b", "c", "u", "v", "ruby", "rt", NULL };
@@ -509,27 +515,40 @@ static gchar *
 get_next_line (GstSubParse * self)
 {
   char *line = NULL;
-  const char *line_end;
+  const char *line_start, *line_end;
   int line_len;
   gboolean have_r = FALSE;
 
-  line_end = strchr (self->textbuf->str, '\n');
+  line_start = self->textbuf->str + self->textbuf_pos;
+  line_end = strchr (line_start, '\n');
 
   if (!line_end) {
-    /* end-of-line not found; return for more data */
+    /* end-of-line not found; drop what was parsed already and return for
+     * more data */
+    if (self->textbuf_pos > 0) {
+      g_string_erase (self->textbuf, 0, self->textbuf_pos);
+      self->textbuf_pos = 0;
+    }
     return NULL;
   }
 
   /* get rid of '\r' */
-  if (line_end != self->textbuf->str && *(line_end - 1) == '\r') {
+  if (line_end != line_start && *(line_end - 1) == '\r') {
     line_end--;
     have_r = TRUE;
   }
 
-  line_len = line_end - self->textbuf->str;
-  line = g_strndup (self->textbuf->str, line_len);
-  self->textbuf = g_string_erase (self->textbuf, 0,
-      line_len + (have_r ? 2 : 1));
+  line_len = line_end - line_start;
+  line = g_strndup (line_start, line_len);
+
+  /* only advance over the line; moving the whole remainder down for every
+   * single line gets quadratic on large inputs, so the consumed part is
+   * dropped in batches instead */
+  self->textbuf_pos += line_len + (have_r ? 2 : 1);
+  if (self->textbuf_pos >= TEXTBUF_COMPACT_THRESHOLD) {
+    g_string_erase (self->textbuf, 0, self->textbuf_pos);
+    self->textbuf_pos = 0;
+  }
   return line;
 }
 
@@ -1580,12 +1599,12 @@ gst_sub_parse_format_autodetect (GstSubParse * self)
   gchar *data;
   GstSubParseFormat format;
 
-  if (strlen (self->textbuf->str) < 30) {
+  if (strlen (self->textbuf->str + self->textbuf_pos) < 30) {
     GST_DEBUG ("File too small to be a subtitles file");
     return NULL;
   }
 
-  data = g_strndup (self->textbuf->str, 35);
+  data = g_strndup (self->textbuf->str + self->textbuf_pos, 35);
   format = gst_sub_parse_data_format_autodetect (data);
   g_free (data);
 
@@ -1655,15 +1674,45 @@ gst_sub_parse_format_autodetect (GstSubParse * self)
   }
 }
 
-static void
-feed_textbuf (GstSubParse * self, GstBuffer * buf)
+/* converts the next chunk of raw input from the adapter into textbuf;
+ * returns TRUE if any bytes were consumed */
+static gboolean
+feed_textbuf_chunk (GstSubParse * self)
 {
-  gboolean discont;
-  gsize consumed;
+  gsize consumed = 0;
   gchar *input = NULL;
   const guint8 *data;
   gsize avail;
 
+  avail = gst_adapter_available (self->adapter);
+  if (avail == 0)
+    return FALSE;
+
+  /* bound the conversion so the first cues of a large file are parsed and
+   * pushed long before the last chunk is converted */
+  avail = MIN (avail, CONVERT_CHUNK_SIZE);
+
+  data = gst_adapter_map (self->adapter, avail);
+  input = convert_encoding (self, (const gchar *) data, avail, &consumed);
+
+  if (input && consumed > 0) {
+    self->textbuf = g_string_append (self->textbuf, input);
+    gst_adapter_unmap (self->adapter);
+    gst_adapter_flush (self->adapter, consumed);
+  } else {
+    gst_adapter_unmap (self->adapter);
+  }
+
+  g_free (input);
+
+  return consumed > 0;
+}
+
+static void
+feed_textbuf (GstSubParse * self, GstBuffer * buf)
+{
+  gboolean discont;
+
   discont = GST_BUFFER_IS_DISCONT (buf);
 
   if (GST_BUFFER_OFFSET_IS_VALID (buf) &&
@@ -1677,6 +1726,7 @@ feed_textbuf (GstSubParse * self, GstBuffer * buf)
     /* flush the parser state */
     parser_state_init (&self->state);
     g_string_truncate (self->textbuf, 0);
+    self->textbuf_pos = 0;
     gst_adapter_clear (self->adapter);
     if (self->parser_type == GST_SUB_PARSE_FORMAT_SAMI)
       sami_context_reset (&self->state);
@@ -1689,19 +1739,7 @@ feed_textbuf (GstSubParse * self, GstBuffer * buf)
 
   gst_adapter_push (self->adapter, buf);
 
-  avail = gst_adapter_available (self->adapter);
-  data = gst_adapter_map (self->adapter, avail);
-  input = convert_encoding (self, (const gchar *) data, avail, &consumed);
-
-  if (input && consumed > 0) {
-    self->textbuf = g_string_append (self->textbuf, input);
-    gst_adapter_unmap (self->adapter);
-    gst_adapter_flush (self->adapter, consumed);
-  } else {
-    gst_adapter_unmap (self->adapter);
-  }
-
-  g_free (input);
+  feed_textbuf_chunk (self);
 }
 
 static GstFlowReturn
@@ -1758,66 +1796,74 @@ handle_buffer (GstSubParse * self, GstBuffer * buf)
     }
   }
 
-  while (!self->flushing && (line = get_next_line (self))) {
-    guint offset = 0;
-
-    /* Set segment on our parser state machine */
-    self->state.segment = &self->segment;
-    /* Now parse the line, out of segment lines will just return NULL */
-    GST_LOG_OBJECT (self, "State %d. Parsing line '%s'", self->state.state,
-        line + offset);
-    subtitle = self->parse_line (&self->state, line + offset);
-    g_free (line);
-
-    if (subtitle) {
-      guint subtitle_len = strlen (subtitle);
-
-      /* +1 for terminating NUL character */
-      buf = gst_buffer_new_and_alloc (subtitle_len + 1);
-
-      /* copy terminating NUL character as well */
-      gst_buffer_fill (buf, 0, subtitle, subtitle_len + 1);
-      gst_buffer_set_size (buf, subtitle_len);
-
-      GST_BUFFER_TIMESTAMP (buf) = self->state.start_time;
-      GST_BUFFER_DURATION (buf) = self->state.duration;
-
-      /* in some cases (e.g. tmplayer) we can only determine the duration
-       * of a text chunk from the timestamp of the next text chunk; in those
-       * cases, we probably want to limit the duration to something
-       * reasonable, so we don't end up showing some text for e.g. 40 seconds
-       * just because nothing else is being said during that time */
-      if (self->state.max_duration > 0 && GST_BUFFER_DURATION_IS_VALID (buf)) {
-        if (GST_BUFFER_DURATION (buf) > self->state.max_duration)
-          GST_BUFFER_DURATION (buf) = self->state.max_duration;
-      }
+  do {
+    while (!self->flushing && (line = get_next_line (self))) {
+      guint offset = 0;
+
+      /* Set segment on our parser state machine */
+      self->state.segment = &self->segment;
+      /* Now parse the line, out of segment lines will just return NULL */
+      GST_LOG_OBJECT (self, "State %d. Parsing line '%s'", self->state.state,
+          line + offset);
+      subtitle = self->parse_line (&self->state, line + offset);
+      g_free (line);
+
+      if (subtitle) {
+        guint subtitle_len = strlen (subtitle);
+
+        /* +1 for terminating NUL character */
+        buf = gst_buffer_new_and_alloc (subtitle_len + 1);
+
+        /* copy terminating NUL character as well */
+        gst_buffer_fill (buf, 0, subtitle, subtitle_len + 1);
+        gst_buffer_set_size (buf, subtitle_len);
+
+        GST_BUFFER_TIMESTAMP (buf) = self->state.start_time;
+        GST_BUFFER_DURATION (buf) = self->state.duration;
+
+        /* in some cases (e.g. tmplayer) we can only determine the duration
+         * of a text chunk from the timestamp of the next text chunk; in those
+         * cases, we probably want to limit the duration to something
+         * reasonable, so we don't end up showing some text for e.g. 40 seconds
+         * just because nothing else is being said during that time */
+        if (self->state.max_duration > 0 && GST_BUFFER_DURATION_IS_VALID (buf)) {
+          if (GST_BUFFER_DURATION (buf) > self->state.max_duration)
+            GST_BUFFER_DURATION (buf) = self->state.max_duration;
+        }
 
-      self->segment.position = self->state.start_time;
+        self->segment.position = self->state.start_time;
 
-      GST_DEBUG_OBJECT (self, "Sending text '%s', %" GST_TIME_FORMAT " + %"
-          GST_TIME_FORMAT, subtitle, GST_TIME_ARGS (self->state.start_time),
-          GST_TIME_ARGS (self->state.duration));
+        GST_DEBUG_OBJECT (self, "Sending text '%s', %" GST_TIME_FORMAT " + %"
+            GST_TIME_FORMAT, subtitle, GST_TIME_ARGS (self->state.start_time),
+            GST_TIME_ARGS (self->state.duration));
 
-      g_free (self->state.vertical);
-      self->state.vertical = NULL;
-      g_free (self->state.alignment);
-      self->state.alignment = NULL;
+        g_free (self->state.vertical);
+        self->state.vertical = NULL;
+        g_free (self->state.alignment);
+        self->state.alignment = NULL;
 
-      ret = gst_pad_push (self->srcpad, buf);
+        ret = gst_pad_push (self->srcpad, buf);
 
-      /* move this forward (the tmplayer parser needs this) */
-      if (self->state.duration != GST_CLOCK_TIME_NONE)
-        self->state.start_time += self->state.duration;
+        /* move this forward (the tmplayer parser needs this) */
+        if (self->state.duration != GST_CLOCK_TIME_NONE)
+          self->state.start_time += self->state.duration;
 
-      g_free (subtitle);
-      subtitle = NULL;
+        g_free (subtitle);
+        subtitle = NULL;
 
-      if (ret != GST_FLOW_OK) {
-        GST_DEBUG_OBJECT (self, "flow: %s", gst_flow_get_name (ret));
-        break;
+        if (ret != GST_FLOW_OK) {
+          GST_DEBUG_OBJECT (self, "flow: %s", gst_flow_get_name (ret));
+          break;
+        }
       }
     }
-  }
+
+    if (ret != GST_FLOW_OK || self->flushing)
+      break;
+
+    /* all complete lines were parsed; convert the next chunk of pending
+     * input, if any, and keep going */
+  } while (feed_textbuf_chunk (self));
 
   return ret;
 }
@@ -1928,6 +1974,7 @@ gst_sub_parse_change_state (GstElement * element, GstStateChange transition)
       g_free (self->detected_encoding);
       self->detected_encoding = NULL;
       g_string_truncate (self->textbuf, 0);
+      self->textbuf_pos = 0;
       gst_adapter_clear (self->adapter);
       break;
     default:
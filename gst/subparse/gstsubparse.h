@@ -91,6 +91,8 @@ struct _GstSubParse {
   GstAdapter *adapter;
   /* contains the UTF-8 decoded input */
   GString *textbuf;
+  /* start of the not-yet-parsed data in textbuf */
+  gsize textbuf_pos;
 
   GstSubParseFormat parser_type;
   gboolean parser_detected;
@@ -108,6 +108,15 @@
 
 #include <sys/ioctl.h>
 
+#include <gst/allocators/gstfdmemory.h>
+
+#ifdef __linux__
+#include <sys/sendfile.h>
+#include <signal.h>
+#include <pthread.h>
+#define HAVE_SENDFILE_FANOUT
+#endif
+
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -647,6 +656,44 @@ ioctl_failed:
   }
 }
 
+#ifdef HAVE_SENDFILE_FANOUT
+/* sendfile() has no per-call equivalent of the MSG_NOSIGNAL flag we pass
+ * to send(): writing to a disconnected peer raises SIGPIPE instead of
+ * just failing with EPIPE. Block the signal in this thread around the
+ * call and drain the one we may have generated, so a client disconnect
+ * is handled like a send() error instead of killing the process. */
+static gssize
+gst_multi_fd_sink_sendfile_nosigpipe (int out_fd, int in_fd, off_t * offset,
+    size_t count)
+{
+  sigset_t sigpipe_mask, prev_mask, pending;
+  gssize wrote;
+  int saved_errno;
+
+  sigemptyset (&sigpipe_mask);
+  sigaddset (&sigpipe_mask, SIGPIPE);
+  sigemptyset (&pending);
+  sigpending (&pending);
+  pthread_sigmask (SIG_BLOCK, &sigpipe_mask, &prev_mask);
+
+  wrote = sendfile (out_fd, in_fd, offset, count);
+  saved_errno = errno;
+
+  /* only drain a SIGPIPE this call generated; one that was already
+   * pending or blocked before belongs to somebody else */
+  if (wrote < 0 && saved_errno == EPIPE && !sigismember (&prev_mask, SIGPIPE)
+      && !sigismember (&pending, SIGPIPE)) {
+    struct timespec ts = { 0, 0 };
+
+    while (sigtimedwait (&sigpipe_mask, NULL, &ts) < 0 && errno == EINTR);
+  }
+  pthread_sigmask (SIG_SETMASK, &prev_mask, NULL);
+
+  errno = saved_errno;
+  return wrote;
+}
+#endif
+
 /* Handle a write on a client,
  * which indicates a read request from a client.
  *
@@ -733,7 +780,8 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
           goto flushed;
 
         /* grab buffer */
-        buf = g_array_index (mhsink->bufqueue, GstBuffer *, mhclient->bufpos);
+        buf = gst_multi_handle_sink_get_queued_buffer (mhsink,
+            mhclient->bufpos);
         mhclient->bufpos--;
 
         /* update stats */
@@ -764,29 +812,56 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
       GstBuffer *head;
       GstMapInfo info;
       guint8 *data;
+      gboolean used_sendfile = FALSE;
 
       /* pick first buffer from list */
       head = GST_BUFFER (mhclient->sending->data);
 
-      if (!gst_buffer_map (head, &info, GST_MAP_READ))
-        g_return_val_if_reached (FALSE);
+      wrote = -1;
+      maxsize = 0;
+
+#ifdef HAVE_SENDFILE_FANOUT
+      /* fd-backed payload is handed to the kernel directly, which fans
+       * the same pages out to every client without copying them through
+       * user space once per client */
+      if (gst_buffer_n_memory (head) == 1) {
+        GstMemory *mem = gst_buffer_peek_memory (head, 0);
+
+        if (gst_is_fd_memory (mem)) {
+          off_t fdoff = mem->offset + mhclient->bufoffset;
+
+          maxsize = mem->size - mhclient->bufoffset;
+          wrote = gst_multi_fd_sink_sendfile_nosigpipe (fd,
+              gst_fd_memory_get_fd (mem), &fdoff, maxsize);
+          /* EINVAL/ENOSYS mean this fd cannot be spliced to this
+           * descriptor; quietly use the copying path then */
+          used_sendfile = (wrote >= 0
+              || (errno != EINVAL && errno != ENOSYS));
+        }
+      }
+#endif
+
+      if (!used_sendfile) {
+        if (!gst_buffer_map (head, &info, GST_MAP_READ))
+          g_return_val_if_reached (FALSE);
 
-      data = info.data;
-      maxsize = info.size - mhclient->bufoffset;
+        data = info.data;
+        maxsize = info.size - mhclient->bufoffset;
 
-      /* FIXME: specific */
-      /* try to write the complete buffer */
+        /* FIXME: specific */
+        /* try to write the complete buffer */
 #ifdef MSG_NOSIGNAL
 #define FLAGS MSG_NOSIGNAL
 #else
 #define FLAGS 0
 #endif
-      if (client->is_socket) {
-        wrote = send (fd, data + mhclient->bufoffset, maxsize, FLAGS);
-      } else {
-        wrote = write (fd, data + mhclient->bufoffset, maxsize);
+        if (client->is_socket) {
+          wrote = send (fd, data + mhclient->bufoffset, maxsize, FLAGS);
+        } else {
+          wrote = write (fd, data + mhclient->bufoffset, maxsize);
+        }
+        gst_buffer_unmap (head, &info);
       }
-      gst_buffer_unmap (head, &info);
 
       if (wrote < 0) {
         /* hmm error.. */
@@ -197,7 +197,9 @@ enum
 
   PROP_RESEND_STREAMHEADER,
 
-  PROP_NUM_HANDLES
+  PROP_NUM_HANDLES,
+
+  PROP_STATS
 };
 
 GType
@@ -315,6 +317,13 @@ find_limits (GstMultiHandleSink * sink,
     gint * min_idx, gint bytes_min, gint buffers_min, gint64 time_min,
     gint * max_idx, gint bytes_max, gint buffers_max, gint64 time_max);
 
+/* the buffer at position @pos in the global queue, 0 being the most
+ * recently queued buffer. Call with the clients lock held */
+#define BUFQUEUE_AT(sink,pos) \
+  ((sink)->bufqueue[((sink)->bufqueue_head + (pos)) & ((sink)->bufqueue_size - 1)])
+
+#define BUFQUEUE_INITIAL_SIZE 16
+
 
 static void
 gst_multi_handle_sink_class_init (GstMultiHandleSinkClass * klass)
@@ -443,6 +452,27 @@ gst_multi_handle_sink_class_init (GstMultiHandleSinkClass * klass)
           "The current number of client handles",
           0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstMultiHandleSink:stats:
+   *
+   * A snapshot of the stats of all connected clients, refreshed from the
+   * streaming thread at most once per second while data is flowing.
+   * Unlike the get-stats action signal, reading this property never takes
+   * the clients lock, so polling it from a monitoring thread cannot stall
+   * the send loop no matter how many clients are connected.
+   *
+   * The structure holds the client count, bytes-to-serve and bytes-served
+   * of the sink and a client-stats array with one structure per client
+   * containing its id, bytes-sent, buffers-lag (position in the global
+   * buffer queue), buffers-dropped and connect-time.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Stats",
+          "A snapshot of the stats of all connected clients",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstMultiHandleSink::clear:
    * @gstmultihandlesink: the multihandlesink element to emit this signal on
@@ -493,8 +523,14 @@ gst_multi_handle_sink_init (GstMultiHandleSink * this)
 
   CLIENTS_LOCK_INIT (this);
   this->clients = NULL;
-
-  this->bufqueue = g_array_new (FALSE, TRUE, sizeof (GstBuffer *));
+  g_mutex_init (&this->stats_lock);
+  this->stats_snapshot = NULL;
+  this->stats_snapshot_time = 0;
+
+  this->bufqueue = g_new (GstBuffer *, BUFQUEUE_INITIAL_SIZE);
+  this->bufqueue_size = BUFQUEUE_INITIAL_SIZE;
+  this->bufqueue_head = 0;
+  this->bufqueue_len = 0;
   this->unit_format = DEFAULT_UNIT_FORMAT;
   this->units_max = DEFAULT_UNITS_MAX;
   this->units_soft_max = DEFAULT_UNITS_SOFT_MAX;
@@ -522,7 +558,10 @@ gst_multi_handle_sink_finalize (GObject * object)
   this = GST_MULTI_HANDLE_SINK (object);
 
   CLIENTS_LOCK_CLEAR (this);
-  g_array_free (this->bufqueue, TRUE);
+  g_mutex_clear (&this->stats_lock);
+  if (this->stats_snapshot)
+    gst_structure_free (this->stats_snapshot);
+  g_free (this->bufqueue);
   g_hash_table_destroy (this->handle_hash);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
@@ -1147,6 +1186,56 @@ is_sync_frame (GstMultiHandleSink * sink, GstBuffer * buffer)
   return TRUE;
 }
 
+/* Get the buffer at @position in the global queue, 0 being the most
+ * recently queued buffer. For use by the subclasses, call with the
+ * clients lock held. */
+GstBuffer *
+gst_multi_handle_sink_get_queued_buffer (GstMultiHandleSink * sink,
+    guint position)
+{
+  return BUFQUEUE_AT (sink, position);
+}
+
+/* Prepend @buffer to the global queue, taking over the reference.
+ * This is O(1); when the ring is full it is doubled in size and
+ * re-linearised. Call with the clients lock held. */
+static void
+gst_multi_handle_sink_queue_prepend (GstMultiHandleSink * sink,
+    GstBuffer * buffer)
+{
+  if (sink->bufqueue_len == sink->bufqueue_size) {
+    guint newsize = sink->bufqueue_size * 2;
+    GstBuffer **newring = g_new (GstBuffer *, newsize);
+    guint i;
+
+    for (i = 0; i < sink->bufqueue_len; i++)
+      newring[i + 1] = BUFQUEUE_AT (sink, i);
+    g_free (sink->bufqueue);
+    sink->bufqueue = newring;
+    sink->bufqueue_size = newsize;
+    sink->bufqueue_head = 1;
+  }
+  sink->bufqueue_head = (sink->bufqueue_head - 1) & (sink->bufqueue_size - 1);
+  sink->bufqueue[sink->bufqueue_head] = buffer;
+  sink->bufqueue_len++;
+}
+
+/* Remove the oldest buffer from the global queue and return it,
+ * transferring the queue's reference to the caller. O(1). Call with the
+ * clients lock held. */
+static GstBuffer *
+gst_multi_handle_sink_queue_drop_oldest (GstMultiHandleSink * sink)
+{
+  GstBuffer *old;
+
+  g_assert (sink->bufqueue_len > 0);
+
+  old = BUFQUEUE_AT (sink, sink->bufqueue_len - 1);
+  sink->bufqueue_len--;
+
+  return old;
+}
+
 /* find the keyframe in the list of buffers starting the
  * search from @idx. @direction as -1 will search backwards, 
  * 1 will search forwards.
@@ -1158,7 +1247,7 @@ find_syncframe (GstMultiHandleSink * sink, gint idx, gint direction)
   gint i, len, result;
 
   /* take length of queued buffers */
-  len = sink->bufqueue->len;
+  len = sink->bufqueue_len;
 
   /* assume we don't find a keyframe */
   result = -1;
@@ -1167,7 +1256,7 @@ find_syncframe (GstMultiHandleSink * sink, gint idx, gint direction)
   for (i = idx; i >= 0 && i < len; i += direction) {
     GstBuffer *buf;
 
-    buf = g_array_index (sink->bufqueue, GstBuffer *, i);
+    buf = BUFQUEUE_AT (sink, i);
     if (is_sync_frame (sink, buf)) {
       GST_LOG_OBJECT (sink, "found keyframe at %d from %d, direction %d",
           i, idx, direction);
@@ -1196,10 +1285,10 @@ get_buffers_max (GstMultiHandleSink * sink, gint64 max)
       gint64 diff;
       GstClockTime first = GST_CLOCK_TIME_NONE;
 
-      len = sink->bufqueue->len;
+      len = sink->bufqueue_len;
 
       for (i = 0; i < len; i++) {
-        buf = g_array_index (sink->bufqueue, GstBuffer *, i);
+        buf = BUFQUEUE_AT (sink, i);
         if (GST_BUFFER_TIMESTAMP_IS_VALID (buf)) {
           if (first == -1)
             first = GST_BUFFER_TIMESTAMP (buf);
@@ -1219,10 +1308,10 @@ get_buffers_max (GstMultiHandleSink * sink, gint64 max)
       int len;
       gint acc = 0;
 
-      len = sink->bufqueue->len;
+      len = sink->bufqueue_len;
 
       for (i = 0; i < len; i++) {
-        buf = g_array_index (sink->bufqueue, GstBuffer *, i);
+        buf = BUFQUEUE_AT (sink, i);
         acc += gst_buffer_get_size (buf);
 
         if (acc > max)
@@ -1257,7 +1346,7 @@ find_limits (GstMultiHandleSink * sink,
   gboolean result, max_hit;
 
   /* take length of queue */
-  len = sink->bufqueue->len;
+  len = sink->bufqueue_len;
 
   /* this must hold */
   g_assert (len > 0);
@@ -1304,7 +1393,7 @@ find_limits (GstMultiHandleSink * sink,
       result = *min_idx != -1;
       break;
     }
-    buf = g_array_index (sink->bufqueue, GstBuffer *, i);
+    buf = BUFQUEUE_AT (sink, i);
 
     bytes += gst_buffer_get_size (buf);
 
@@ -1420,7 +1509,7 @@ gst_multi_handle_sink_new_client_position (GstMultiHandleSink * sink,
   GST_DEBUG_OBJECT (sink,
       "%s new client, deciding where to start in queue", client->debug);
   GST_DEBUG_OBJECT (sink, "queue is currently %d buffers long",
-      sink->bufqueue->len);
+      sink->bufqueue_len);
   switch (client->sync_method) {
     case GST_SYNC_METHOD_LATEST:
       /* no syncing, we are happy with whatever the client is going to get */
@@ -1630,13 +1719,13 @@ gst_multi_handle_sink_recover_client (GstMultiHandleSink * sink,
     case GST_RECOVER_POLICY_RESYNC_KEYFRAME:
       /* find keyframe in buffers, we search backwards to find the
        * closest keyframe relative to what this client already received. */
-      newbufpos = MIN (sink->bufqueue->len - 1,
+      newbufpos = MIN ((gint) sink->bufqueue_len - 1,
           get_buffers_max (sink, sink->units_soft_max) - 1);
 
       while (newbufpos >= 0) {
         GstBuffer *buf;
 
-        buf = g_array_index (sink->bufqueue, GstBuffer *, newbufpos);
+        buf = BUFQUEUE_AT (sink, newbufpos);
         if (is_sync_frame (sink, buf)) {
           /* found a buffer that is not a delta unit */
           break;
@@ -1654,8 +1743,8 @@ gst_multi_handle_sink_recover_client (GstMultiHandleSink * sink,
 
 /* Queue a buffer on the global queue.
  *
- * This function adds the buffer to the front of a GArray. It removes the
- * tail buffer if the max queue size is exceeded, unreffing the queued buffer.
+ * This function adds the buffer to the front of the ring. It removes the
+ * tail buffers if the max queue size is exceeded, unreffing the queued buffer.
  * Note that unreffing the buffer is not a problem as clients who
  * started writing out this buffer will still have a reference to it in the
  * mhclient->sending queue.
@@ -1670,6 +1759,59 @@ gst_multi_handle_sink_recover_client (GstMultiHandleSink * sink,
  * This is done by adding the client back into the write fd_set and signaling
  * the select thread that the fd_set changed.
  */
+/* how often the streaming thread refreshes the published stats snapshot */
+#define STATS_SNAPSHOT_INTERVAL G_USEC_PER_SEC
+
+/* Publish a snapshot of the per-client stats so that monitoring can read
+ * them from the stats property without ever taking the clients lock. We
+ * refresh at most once per interval from the streaming thread, which
+ * already holds the lock anyway, and only hold stats_lock for the pointer
+ * swap. Must be called with CLIENTS_LOCK. */
+static void
+gst_multi_handle_sink_update_stats_snapshot (GstMultiHandleSink * mhsink)
+{
+  GstStructure *s;
+  GValue array = G_VALUE_INIT;
+  GList *walk;
+  gint clients = 0;
+  gint64 now;
+
+  now = g_get_monotonic_time ();
+  if (now - mhsink->stats_snapshot_time < STATS_SNAPSHOT_INTERVAL)
+    return;
+  mhsink->stats_snapshot_time = now;
+
+  g_value_init (&array, GST_TYPE_ARRAY);
+  for (walk = mhsink->clients; walk; walk = walk->next) {
+    GstMultiHandleClient *mhclient = walk->data;
+    GValue v = G_VALUE_INIT;
+    GstStructure *cs;
+
+    cs = gst_structure_new ("multihandlesink-client-stats",
+        "id", G_TYPE_STRING, mhclient->debug,
+        "bytes-sent", G_TYPE_UINT64, mhclient->bytes_sent,
+        "buffers-lag", G_TYPE_INT, mhclient->bufpos,
+        "buffers-dropped", G_TYPE_UINT64, mhclient->dropped_buffers,
+        "connect-time", G_TYPE_UINT64, mhclient->connect_time, NULL);
+    g_value_init (&v, GST_TYPE_STRUCTURE);
+    g_value_take_boxed (&v, cs);
+    gst_value_array_append_and_take_value (&array, &v);
+    clients++;
+  }
+
+  s = gst_structure_new ("multihandlesink-stats",
+      "clients", G_TYPE_INT, clients,
+      "bytes-to-serve", G_TYPE_UINT64, mhsink->bytes_to_serve,
+      "bytes-served", G_TYPE_UINT64, mhsink->bytes_served, NULL);
+  gst_structure_take_value (s, "client-stats", &array);
+
+  g_mutex_lock (&mhsink->stats_lock);
+  if (mhsink->stats_snapshot)
+    gst_structure_free (mhsink->stats_snapshot);
+  mhsink->stats_snapshot = s;
+  g_mutex_unlock (&mhsink->stats_lock);
+}
+
 static void
 gst_multi_handle_sink_queue_buffer (GstMultiHandleSink * mhsink,
     GstBuffer * buffer)
@@ -1689,8 +1831,8 @@ gst_multi_handle_sink_queue_buffer (GstMultiHandleSink * mhsink,
 
   CLIENTS_LOCK (mhsink);
   /* add buffer to queue */
-  g_array_prepend_val (mhsink->bufqueue, buffer);
-  queuelen = mhsink->bufqueue->len;
+  gst_multi_handle_sink_queue_prepend (mhsink, buffer);
+  queuelen = mhsink->bufqueue_len;
 
   if (mhsink->units_max > 0)
     max_buffers = get_buffers_max (mhsink, mhsink->units_max);
@@ -1813,7 +1955,7 @@ restart:
         "extending queue to include sync point, now at %d, limit is %d",
         max_buffer_usage, limit);
     for (i = 0; i < limit; i++) {
-      buf = g_array_index (mhsink->bufqueue, GstBuffer *, i);
+      buf = BUFQUEUE_AT (mhsink, i);
       if (is_sync_frame (mhsink, buf)) {
         /* found a sync frame, now extend the buffer usage to
          * include at least this frame. */
@@ -1827,21 +1969,20 @@ restart:
   GST_LOG_OBJECT (sink, "len %d, usage %d", queuelen, max_buffer_usage);
 
   /* nobody is referencing units after max_buffer_usage so we can
-   * remove them from the queue. We remove them in reverse order as
-   * this is the most optimal for GArray. */
-  for (i = queuelen - 1; i > max_buffer_usage; i--) {
+   * remove them from the tail of the ring */
+  while (queuelen - 1 > max_buffer_usage) {
     GstBuffer *old;
 
     /* queue exceeded max size */
     queuelen--;
-    old = g_array_index (mhsink->bufqueue, GstBuffer *, i);
-    mhsink->bufqueue = g_array_remove_index (mhsink->bufqueue, i);
+    old = gst_multi_handle_sink_queue_drop_oldest (mhsink);
 
     /* unref tail buffer */
     gst_buffer_unref (old);
   }
   /* save for stats */
   mhsink->buffers_queued = max_buffer_usage + 1;
+  gst_multi_handle_sink_update_stats_snapshot (mhsink);
   CLIENTS_UNLOCK (sink);
 
   /* and send a signal to thread if handle_set changed */
@@ -2131,6 +2272,12 @@ gst_multi_handle_sink_get_property (GObject * object, guint prop_id,
       g_value_set_uint (value,
           g_hash_table_size (multihandlesink->handle_hash));
       break;
+    case PROP_STATS:
+      g_mutex_lock (&multihandlesink->stats_lock);
+      if (multihandlesink->stats_snapshot)
+        g_value_set_boxed (value, multihandlesink->stats_snapshot);
+      g_mutex_unlock (&multihandlesink->stats_lock);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2205,15 +2352,15 @@ gst_multi_handle_sink_stop (GstBaseSink * bsink)
   /* remove all queued buffers */
   if (mhsink->bufqueue) {
     GST_DEBUG_OBJECT (mhsink, "Emptying bufqueue with %d buffers",
-        mhsink->bufqueue->len);
-    for (i = mhsink->bufqueue->len - 1; i >= 0; --i) {
-      buf = g_array_index (mhsink->bufqueue, GstBuffer *, i);
+        mhsink->bufqueue_len);
+    while (mhsink->bufqueue_len > 0) {
+      i = mhsink->bufqueue_len - 1;
+      buf = gst_multi_handle_sink_queue_drop_oldest (mhsink);
       GST_LOG_OBJECT (mhsink, "Removing buffer %p (%d) with refcount %d", buf,
           i, GST_MINI_OBJECT_REFCOUNT (buf));
       gst_buffer_unref (buf);
-      mhsink->bufqueue = g_array_remove_index (mhsink->bufqueue, i);
     }
-    /* freeing the array is done in _finalize */
+    /* freeing the ring is done in _finalize */
   }
   GST_OBJECT_FLAG_UNSET (mhsink, GST_MULTI_HANDLE_SINK_OPEN);
 
@@ -180,6 +180,9 @@ gint gst_multi_handle_sink_setup_dscp_client (GstMultiHandleSink * sink, GstMult
 gint
 gst_multi_handle_sink_new_client_position (GstMultiHandleSink * sink,
     GstMultiHandleClient * client);
+GstBuffer *
+gst_multi_handle_sink_get_queued_buffer (GstMultiHandleSink * sink,
+    guint position);
 
 /**
  * GstMultiHandleSink:
@@ -197,6 +200,11 @@ struct _GstMultiHandleSink {
   GList *clients;       /* list of clients we are serving */
   guint clients_cookie; /* Cookie to detect changes to the clients list */
 
+  GMutex stats_lock;    /* only protects the published stats snapshot;
+                           readers never take clientslock */
+  GstStructure *stats_snapshot; /* last published per-client stats */
+  gint64 stats_snapshot_time;   /* monotonic time the snapshot was taken */
+
   GHashTable *handle_hash;  /* index of handle -> GstMultiHandleClient */
 
   GMainContext *main_context;
@@ -204,7 +212,12 @@ struct _GstMultiHandleSink {
 
   gint qos_dscp;
 
-  GArray *bufqueue;     /* global queue of buffers */
+  GstBuffer **bufqueue; /* global queue of buffers, a ring with the newest
+                           buffer first. Adding and trimming buffers is O(1),
+                           clients only keep a position into the ring */
+  guint bufqueue_size;  /* allocated ring slots, always a power of two */
+  guint bufqueue_head;  /* ring index of the newest buffer */
+  guint bufqueue_len;   /* number of queued buffers */
 
   gboolean running;     /* the thread state */
   GThread *thread;      /* the sender thread */
@@ -114,6 +114,13 @@
 #include <netinet/in.h>
 #endif
 
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <glib-unix.h>
+#endif
+
 #define NOT_IMPLEMENTED 0
 
 GST_DEBUG_CATEGORY_STATIC (multisocketsink_debug);
@@ -451,6 +458,7 @@ gst_multi_socket_sink_init (GstMultiSocketSink * this)
   this->cancellable = g_cancellable_new ();
   this->send_dispatched = DEFAULT_SEND_DISPATCHED;
   this->send_messages = DEFAULT_SEND_MESSAGES;
+  this->epoll_fd = -1;
 }
 
 static void
@@ -774,21 +782,56 @@ gst_buffer_get_cmsg_list (GstBuffer * buf, GSocketControlMessage ** msgs,
 
 #define CMSG_MAX 255
 
+/* maximum number of memories gathered into a single send_message call and
+ * maximum number of buffers we queue up per client before flushing them in
+ * one call */
+#define GATHER_VEC_MAX 64
+#define GATHER_BUFFERS_MAX 16
+
+static gboolean
+gst_buffer_has_cmsg (GstBuffer * buf)
+{
+  GSocketControlMessage *msg;
+
+  return gst_buffer_get_cmsg_list (buf, &msg, 1) > 0;
+}
+
+/* Gather the memories of as many buffers from @buffers as fit into our
+ * vectors and send them with a single send_message call. @bufoffset is the
+ * offset into the first buffer. Control messages of the first buffer are
+ * sent along, buffers carrying their own control messages are never merged
+ * with preceding ones so messages stay associated with their data.
+ *
+ * The caller accounts the returned byte count against the buffer sizes to
+ * find out which buffers were sent completely. */
 static gssize
 gst_multi_socket_sink_write (GstMultiSocketSink * sink,
-    GSocket * sock, GstBuffer * buffer, gsize bufoffset,
+    GSocket * sock, GSList * buffers, gsize bufoffset,
     GCancellable * cancellable, GError ** err)
 {
-  GstMapInfo maps[8];
-  GOutputVector vec[8];
-  guint mems_mapped;
+  GstMapInfo maps[GATHER_VEC_MAX];
+  GOutputVector vec[GATHER_VEC_MAX];
+  guint mems_mapped = 0;
   gssize wrote;
   GSocketControlMessage *cmsgs[CMSG_MAX];
   gsize msg_count;
+  GSList *walk;
 
-  mems_mapped = map_n_memory_output_vector (buffer, bufoffset, vec, maps, 8);
+  msg_count =
+      gst_buffer_get_cmsg_list (GST_BUFFER (buffers->data), cmsgs, CMSG_MAX);
 
-  msg_count = gst_buffer_get_cmsg_list (buffer, cmsgs, CMSG_MAX);
+  for (walk = buffers; walk && mems_mapped < GATHER_VEC_MAX; walk = walk->next) {
+    GstBuffer *buf = GST_BUFFER (walk->data);
+
+    /* don't merge a buffer with control messages into this call, it is
+     * sent separately once the preceding data is flushed */
+    if (walk != buffers && gst_buffer_has_cmsg (buf))
+      break;
+
+    mems_mapped += map_n_memory_output_vector (buf, walk == buffers ?
+        bufoffset : 0, vec + mems_mapped, maps + mems_mapped,
+        GATHER_VEC_MAX - mems_mapped);
+  }
 
   wrote =
       g_socket_send_message (sock, NULL, vec, mems_mapped, cmsgs, msg_count, 0,
@@ -806,13 +849,14 @@ gst_multi_socket_sink_write (GstMultiSocketSink * sink,
  * We first check to see if we need to send streamheaders. If so, we queue them.
  *
  * Then we run into the main loop that tries to send as many buffers as
- * possible. It will first exhaust the mhclient->sending queue and if the queue
- * is empty, it will pick a buffer from the global queue.
+ * possible. It will first fill the mhclient->sending queue with the client's
+ * backlog from the global queue, up to a gather limit.
  *
- * Sending the buffers from the mhclient->sending queue is basically writing
- * the bytes to the socket and maintaining a count of the bytes that were
- * sent. When the buffer is completely sent, it is removed from the
- * mhclient->sending queue and we try to pick a new buffer for sending.
+ * Sending the buffers from the mhclient->sending queue gathers the memories
+ * of the queued buffers into vectors and flushes them with a single
+ * send_message call, maintaining a count of the bytes that were sent. All
+ * buffers that were sent completely are removed from the mhclient->sending
+ * queue and we try to pick new buffers for sending.
  *
  * When the sending returns a partial buffer we stop sending more data as
  * the next send operation could block.
@@ -841,8 +885,10 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
 
   more = TRUE;
   do {
-    if (!mhclient->sending) {
-      /* client is not working on a buffer */
+    /* Fill the sending queue with as much of the client's backlog as we can
+     * gather into a single send_message call */
+    while (!mhclient->sending || (!flushing && mhclient->bufpos != -1
+            && g_slist_length (mhclient->sending) < GATHER_BUFFERS_MAX)) {
       if (mhclient->bufpos == -1) {
         /* client is too fast, remove from write queue until new buffer is
          * available */
@@ -857,6 +903,7 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
         /* client can pick a buffer from the global queue */
         GstBuffer *buf;
         GstClockTime timestamp;
+        gboolean was_sending = mhclient->sending != NULL;
 
         /* for new connections, we need to find a good spot in the
          * bufqueue to start streaming from */
@@ -876,11 +923,15 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
         }
 
         /* we flushed all remaining buffers, no need to get a new one */
-        if (mhclient->flushcount == 0)
+        if (mhclient->flushcount == 0) {
+          if (mhclient->sending)
+            break;
           goto flushed;
+        }
 
         /* grab buffer */
-        buf = g_array_index (mhsink->bufqueue, GstBuffer *, mhclient->bufpos);
+        buf = gst_multi_handle_sink_get_queued_buffer (mhsink,
+            mhclient->bufpos);
         mhclient->bufpos--;
 
         /* update stats */
@@ -900,21 +951,19 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
         /* queueing a buffer will ref it */
         mhsinkclass->client_queue_buffer (mhsink, mhclient, buf);
 
-        /* need to start from the first byte for this new buffer */
-        mhclient->bufoffset = 0;
+        /* need to start from the first byte for this new buffer, unless we
+         * are still in the middle of sending an earlier one */
+        if (!was_sending)
+          mhclient->bufoffset = 0;
       }
     }
 
     /* see if we need to send something */
     if (mhclient->sending) {
       gssize wrote;
-      GstBuffer *head;
-
-      /* pick first buffer from list */
-      head = GST_BUFFER (mhclient->sending->data);
 
-      wrote = gst_multi_socket_sink_write (sink, mhclient->handle.socket, head,
-          mhclient->bufoffset, sink->cancellable, &err);
+      wrote = gst_multi_socket_sink_write (sink, mhclient->handle.socket,
+          mhclient->sending, mhclient->bufoffset, sink->cancellable, &err);
 
       if (wrote < 0) {
         /* hmm error.. */
@@ -930,13 +979,30 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
           goto write_error;
         }
       } else {
-        if (wrote < (gst_buffer_get_size (head) - mhclient->bufoffset)) {
-          /* partial write, try again now */
-          GST_LOG_OBJECT (sink,
-              "partial write on %p of %" G_GSSIZE_FORMAT " bytes",
-              mhclient->handle.socket, wrote);
-          mhclient->bufoffset += wrote;
-        } else {
+        gssize left = wrote;
+        gboolean first = TRUE;
+
+        /* remove all buffers that were written completely */
+        while (mhclient->sending) {
+          GstBuffer *head = GST_BUFFER (mhclient->sending->data);
+          gssize size = gst_buffer_get_size (head) - mhclient->bufoffset;
+
+          /* a buffer with control messages is never merged into a
+           * preceding send, so even when it contributes no bytes it is
+           * only done after heading its own send_message call; stop here
+           * so the next call starts with it and carries its messages */
+          if (!first && gst_buffer_has_cmsg (head))
+            break;
+
+          if (left < size) {
+            /* partial write, try again now */
+            GST_LOG_OBJECT (sink,
+                "partial write on %p of %" G_GSSIZE_FORMAT " bytes",
+                mhclient->handle.socket, wrote);
+            mhclient->bufoffset += left;
+            break;
+          }
+
           if (sink->send_dispatched) {
             gst_pad_push_event (GST_BASE_SINK_PAD (mhsink),
                 gst_event_new_custom (GST_EVENT_CUSTOM_UPSTREAM,
@@ -949,6 +1015,8 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
           gst_buffer_unref (head);
           /* make sure we start from byte 0 for the next buffer */
           mhclient->bufoffset = 0;
+          left -= size;
+          first = FALSE;
         }
         /* update stats */
         mhclient->bytes_sent += wrote;
@@ -986,6 +1054,131 @@ write_error:
   }
 }
 
+#ifdef HAVE_SYS_EPOLL_H
+/* All client sockets live in one epoll set that is attached to the main
+ * context through a single source. Changing the condition of a client is
+ * an O(1) epoll_ctl call, and one context iteration polls one descriptor
+ * no matter how many clients are connected, instead of rebuilding a poll
+ * array over all client sockets on every iteration. */
+
+#define EPOLL_MAX_EVENTS 64
+
+static guint32
+epoll_events_from_condition (GIOCondition condition)
+{
+  guint32 events = 0;
+
+  if (condition & G_IO_IN)
+    events |= EPOLLIN;
+  if (condition & G_IO_OUT)
+    events |= EPOLLOUT;
+  if (condition & G_IO_PRI)
+    events |= EPOLLPRI;
+  return events;
+}
+
+static GIOCondition
+epoll_condition_from_events (guint32 events)
+{
+  GIOCondition condition = 0;
+
+  if (events & EPOLLIN)
+    condition |= G_IO_IN;
+  if (events & EPOLLOUT)
+    condition |= G_IO_OUT;
+  if (events & EPOLLPRI)
+    condition |= G_IO_PRI;
+  if (events & EPOLLERR)
+    condition |= G_IO_ERR;
+  if (events & EPOLLHUP)
+    condition |= G_IO_HUP;
+  return condition;
+}
+
+/* Register, update or remove a client in the epoll set. Must be called
+ * with the clients lock. A reference to the socket is held as long as it
+ * is registered and only released by the dispatcher after the current
+ * event batch, so events fetched before a removal never point to a dead
+ * socket. */
+static void
+gst_multi_socket_sink_epoll_update (GstMultiSocketSink * sink,
+    GstSocketClient * client, GIOCondition condition)
+{
+  GstMultiHandleClient *mhclient = (GstMultiHandleClient *) client;
+  GSocket *socket = mhclient->handle.socket;
+  gint fd = g_socket_get_fd (socket);
+  struct epoll_event event = { 0, };
+
+  if (condition == 0) {
+    if (client->condition != 0) {
+      if (epoll_ctl (sink->epoll_fd, EPOLL_CTL_DEL, fd, NULL) != 0)
+        GST_WARNING_OBJECT (sink, "%s failed to remove fd %d from epoll: %s",
+            mhclient->debug, fd, g_strerror (errno));
+      /* transfers the registration reference */
+      sink->epoll_release = g_slist_prepend (sink->epoll_release, socket);
+    }
+  } else {
+    event.events = epoll_events_from_condition (condition);
+    event.data.ptr = socket;
+
+    if (client->condition == 0) {
+      if (epoll_ctl (sink->epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0) {
+        g_object_ref (socket);
+      } else {
+        GST_WARNING_OBJECT (sink, "%s failed to add fd %d to epoll: %s",
+            mhclient->debug, fd, g_strerror (errno));
+        condition = 0;
+      }
+    } else {
+      if (epoll_ctl (sink->epoll_fd, EPOLL_CTL_MOD, fd, &event) != 0)
+        GST_WARNING_OBJECT (sink, "%s failed to update fd %d in epoll: %s",
+            mhclient->debug, fd, g_strerror (errno));
+    }
+  }
+  client->condition = condition;
+}
+
+/* drop the registration references of clients that were removed from the
+ * epoll set, now that no fetched events can refer to them anymore */
+static void
+gst_multi_socket_sink_epoll_drain_release (GstMultiSocketSink * sink)
+{
+  GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
+  GSList *release;
+
+  CLIENTS_LOCK (mhsink);
+  release = sink->epoll_release;
+  sink->epoll_release = NULL;
+  CLIENTS_UNLOCK (mhsink);
+
+  g_slist_free_full (release, g_object_unref);
+}
+
+static gboolean
+gst_multi_socket_sink_epoll_dispatch (gint fd, GIOCondition condition,
+    GstMultiSocketSink * sink)
+{
+  struct epoll_event events[EPOLL_MAX_EVENTS];
+  gint i, n;
+
+  do {
+    n = epoll_wait (sink->epoll_fd, events, EPOLL_MAX_EVENTS, 0);
+  } while (n < 0 && errno == EINTR);
+
+  for (i = 0; i < n; i++) {
+    GstMultiSinkHandle handle;
+
+    handle.socket = events[i].data.ptr;
+    gst_multi_socket_sink_socket_condition (handle,
+        epoll_condition_from_events (events[i].events), sink);
+  }
+
+  gst_multi_socket_sink_epoll_drain_release (sink);
+
+  return TRUE;
+}
+#endif /* HAVE_SYS_EPOLL_H */
+
 static void
 ensure_condition (GstMultiSocketSink * sink, GstSocketClient * client,
     GIOCondition condition)
@@ -995,6 +1188,13 @@ ensure_condition (GstMultiSocketSink * sink, GstSocketClient * client,
   if (client->condition == condition)
     return;
 
+#ifdef HAVE_SYS_EPOLL_H
+  if (sink->epoll_fd != -1) {
+    gst_multi_socket_sink_epoll_update (sink, client, condition);
+    return;
+  }
+#endif
+
   if (client->source) {
     g_source_destroy (client->source);
     g_source_unref (client->source);
@@ -1222,6 +1422,21 @@ gst_multi_socket_sink_start_pre (GstMultiHandleSink * mhsink)
 
   mssink->main_context = g_main_context_new ();
 
+#ifdef HAVE_SYS_EPOLL_H
+  mssink->epoll_fd = epoll_create1 (EPOLL_CLOEXEC);
+  if (mssink->epoll_fd != -1) {
+    mssink->epoll_source =
+        g_unix_fd_source_new (mssink->epoll_fd, G_IO_IN);
+    g_source_set_callback (mssink->epoll_source,
+        (GSourceFunc) gst_multi_socket_sink_epoll_dispatch,
+        gst_object_ref (mssink), (GDestroyNotify) gst_object_unref);
+    g_source_attach (mssink->epoll_source, mssink->main_context);
+  } else {
+    GST_WARNING_OBJECT (mssink, "failed to create epoll instance, "
+        "falling back to per-client sources: %s", g_strerror (errno));
+  }
+#endif
+
   CLIENTS_LOCK (mhsink);
   for (clients = mhsink->clients; clients; clients = clients->next) {
     GstSocketClient *client = clients->data;
@@ -1256,6 +1471,19 @@ gst_multi_socket_sink_stop_post (GstMultiHandleSink * mhsink)
 {
   GstMultiSocketSink *mssink = GST_MULTI_SOCKET_SINK (mhsink);
 
+#ifdef HAVE_SYS_EPOLL_H
+  if (mssink->epoll_source) {
+    g_source_destroy (mssink->epoll_source);
+    g_source_unref (mssink->epoll_source);
+    mssink->epoll_source = NULL;
+  }
+  if (mssink->epoll_fd != -1) {
+    close (mssink->epoll_fd);
+    mssink->epoll_fd = -1;
+  }
+  gst_multi_socket_sink_epoll_drain_release (mssink);
+#endif
+
   if (mssink->main_context) {
     g_main_context_unref (mssink->main_context);
     mssink->main_context = NULL;
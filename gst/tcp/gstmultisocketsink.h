@@ -70,6 +70,12 @@ struct _GstMultiSocketSink {
   GCancellable *cancellable;
   gboolean send_messages;
   gboolean send_dispatched;
+
+  /* epoll-based client dispatcher (where available), falls back to
+   * per-client GSources otherwise */
+  gint epoll_fd;
+  GSource *epoll_source;
+  GSList *epoll_release;
 };
 
 struct _GstMultiSocketSinkClass {
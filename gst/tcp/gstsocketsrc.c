@@ -57,8 +57,6 @@
 GST_DEBUG_CATEGORY_STATIC (socketsrc_debug);
 #define GST_CAT_DEFAULT socketsrc_debug
 
-#define MAX_READ_SIZE                   4 * 1024
-
 
 static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_SRC,
@@ -68,6 +66,11 @@ static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
 
 #define DEFAULT_SEND_MESSAGES FALSE
 
+/* Upper bound on the number of buffers batched into one buffer list by
+ * _create() when the kernel has more data queued than fits one buffer;
+ * bounds both memory use and the latency of the first buffer. */
+#define MAX_BATCHED_BUFFERS 16
+
 enum
 {
   PROP_0,
@@ -92,6 +95,10 @@ static void gst_socket_src_finalize (GObject * gobject);
 
 static GstCaps *gst_socketsrc_getcaps (GstBaseSrc * src, GstCaps * filter);
 static gboolean gst_socketsrc_event (GstBaseSrc * src, GstEvent * event);
+static gboolean gst_socket_src_decide_allocation (GstBaseSrc * bsrc,
+    GstQuery * query);
+static GstFlowReturn gst_socket_src_create (GstPushSrc * psrc,
+    GstBuffer ** outbuf);
 static GstFlowReturn gst_socket_src_fill (GstPushSrc * psrc,
     GstBuffer * outbuf);
 static gboolean gst_socket_src_unlock (GstBaseSrc * bsrc);
@@ -164,10 +171,11 @@ gst_socket_src_class_init (GstSocketSrcClass * klass)
 
   gstbasesrc_class->event = gst_socketsrc_event;
   gstbasesrc_class->get_caps = gst_socketsrc_getcaps;
+  gstbasesrc_class->decide_allocation = gst_socket_src_decide_allocation;
   gstbasesrc_class->unlock = gst_socket_src_unlock;
   gstbasesrc_class->unlock_stop = gst_socket_src_unlock_stop;
 
-  gstpush_src_class->fill = gst_socket_src_fill;
+  gstpush_src_class->create = gst_socket_src_create;
 
   GST_DEBUG_CATEGORY_INIT (socketsrc_debug, "socketsrc", 0, "Socket Source");
 }
@@ -272,6 +280,179 @@ gst_socketsrc_getcaps (GstBaseSrc * src, GstCaps * filter)
   return result;
 }
 
+/* Make sure there always is a buffer pool on the receive path, even when
+ * downstream does not propose one, and size the buffers (and with them the
+ * reads done by _fill()) from the socket receive buffer so one read can
+ * drain everything the kernel has queued for us. */
+static gboolean
+gst_socket_src_decide_allocation (GstBaseSrc * bsrc, GstQuery * query)
+{
+  GstSocketSrc *src = GST_SOCKET_SRC (bsrc);
+  GstBufferPool *pool = NULL;
+  guint size, min = 0, max = 0;
+  GstStructure *config;
+  GstCaps *caps = NULL;
+  GSocket *socket = NULL;
+  gsize read_size;
+
+  GST_OBJECT_LOCK (src);
+  if (src->socket)
+    socket = g_object_ref (src->socket);
+  GST_OBJECT_UNLOCK (src);
+
+  read_size = gst_tcp_socket_get_read_size (socket);
+  g_clear_object (&socket);
+
+  GST_DEBUG_OBJECT (src, "using a read size of %" G_GSIZE_FORMAT, read_size);
+
+  /* grow the blocksize so _fill() asks for buffers of the read size */
+  if (gst_base_src_get_blocksize (bsrc) < read_size)
+    gst_base_src_set_blocksize (bsrc, read_size);
+
+  gst_query_parse_allocation (query, &caps, NULL);
+
+  if (gst_query_get_n_allocation_pools (query) > 0) {
+    gst_query_parse_nth_allocation_pool (query, 0, &pool, &size, &min, &max);
+    size = MAX (size, read_size);
+  } else {
+    size = read_size;
+  }
+
+  if (pool == NULL)
+    pool = gst_buffer_pool_new ();
+
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, caps, size, min, max);
+  if (!gst_buffer_pool_set_config (pool, config))
+    GST_WARNING_OBJECT (src, "failed to set config on buffer pool");
+
+  if (gst_query_get_n_allocation_pools (query) > 0)
+    gst_query_set_nth_allocation_pool (query, 0, pool, size, min, max);
+  else
+    gst_query_add_allocation_pool (query, pool, size, min, max);
+
+  gst_object_unref (pool);
+
+  return GST_BASE_SRC_CLASS (parent_class)->decide_allocation (bsrc, query);
+}
+
+/* Drain data the kernel already has queued for us into additional pooled
+ * buffers without blocking, so one scheduling of the source thread can
+ * produce many buffers. Ownership of @outbuf stays with the caller; errors
+ * and EOS seen here are left for the next blocking receive to report. */
+static guint
+gst_socket_src_drain_available (GstSocketSrc * src, GstBufferList * list)
+{
+  GstBaseSrc *bsrc = GST_BASE_SRC (src);
+  guint blocksize = gst_base_src_get_blocksize (bsrc);
+  guint batched = 1;
+
+  while (batched < MAX_BATCHED_BUFFERS) {
+    GSocket *socket = NULL;
+    GSocketControlMessage **messages = NULL;
+    gint num_messages = 0;
+    gint flags = 0;
+    gint i;
+    GstBuffer *buf = NULL;
+    GstMapInfo map;
+    GInputVector ivec;
+    GError *err = NULL;
+    gssize avail, rret;
+
+    GST_OBJECT_LOCK (src);
+    if (src->socket)
+      socket = g_object_ref (src->socket);
+    GST_OBJECT_UNLOCK (src);
+
+    if (socket == NULL)
+      break;
+
+    avail = g_socket_get_available_bytes (socket);
+    if (avail <= 0) {
+      g_object_unref (socket);
+      break;
+    }
+
+    if (GST_BASE_SRC_CLASS (parent_class)->alloc (bsrc, -1, blocksize,
+            &buf) != GST_FLOW_OK) {
+      g_object_unref (socket);
+      break;
+    }
+
+    /* won't block: the kernel reported at least one byte available */
+    gst_buffer_map (buf, &map, GST_MAP_READWRITE);
+    ivec.buffer = map.data;
+    ivec.size = map.size;
+    rret =
+        g_socket_receive_message (socket, NULL, &ivec, 1, &messages,
+        &num_messages, &flags, src->cancellable, &err);
+    gst_buffer_unmap (buf, &map);
+
+    for (i = 0; i < num_messages; i++) {
+      gst_buffer_add_net_control_message_meta (buf, messages[i]);
+      g_object_unref (messages[i]);
+      messages[i] = NULL;
+    }
+    g_free (messages);
+    g_object_unref (socket);
+
+    if (rret <= 0) {
+      /* EOS or error: drop this buffer and let the next blocking receive
+       * run the connection-closed-by-peer/error handling in _fill() */
+      gst_buffer_unref (buf);
+      g_clear_error (&err);
+      break;
+    }
+
+    gst_buffer_resize (buf, 0, rret);
+    gst_buffer_list_add (list, buf);
+    batched++;
+  }
+
+  return batched;
+}
+
+static GstFlowReturn
+gst_socket_src_create (GstPushSrc * psrc, GstBuffer ** outbuf)
+{
+  GstSocketSrc *src = GST_SOCKET_SRC (psrc);
+  GstBaseSrc *bsrc = GST_BASE_SRC (psrc);
+  GstFlowReturn ret;
+  GstBuffer *buf = NULL;
+  GstBufferList *list;
+  guint batched;
+
+  ret = GST_BASE_SRC_CLASS (parent_class)->alloc (bsrc, -1,
+      gst_base_src_get_blocksize (bsrc), &buf);
+  if (ret != GST_FLOW_OK)
+    return ret;
+
+  ret = gst_socket_src_fill (psrc, buf);
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (buf);
+    return ret;
+  }
+
+  list = gst_buffer_list_new ();
+  gst_buffer_list_add (list, buf);
+  batched = gst_socket_src_drain_available (src, list);
+
+  if (batched == 1) {
+    /* nothing else was queued, push the single buffer as before */
+    *outbuf = gst_buffer_ref (gst_buffer_list_get (list, 0));
+    gst_buffer_list_unref (list);
+    return GST_FLOW_OK;
+  }
+
+  GST_LOG_OBJECT (src, "batched %u buffers into one buffer list", batched);
+
+  /* the base class pushes the whole list with one gst_pad_push_list() */
+  gst_base_src_submit_buffer_list (bsrc, list);
+  *outbuf = NULL;
+
+  return GST_FLOW_OK;
+}
+
 static GstFlowReturn
 gst_socket_src_fill (GstPushSrc * psrc, GstBuffer * outbuf)
 {
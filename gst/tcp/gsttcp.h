@@ -24,9 +24,55 @@
 #define __GST_TCP_HELP_H__
 
 #include <gst/gst.h>
+#include <gio/gio.h>
+#include <gio/gnetworking.h>
 
 #define TCP_HIGHEST_PORT        65535
 #define TCP_DEFAULT_HOST        "localhost"
 #define TCP_DEFAULT_PORT        4953
 
+/* read size used when the socket receive buffer size is not available */
+#define GST_TCP_DEFAULT_READ_SIZE  (4 * 1024)
+/* upper bound for sizing reads from the receive buffer, so a large
+ * SO_RCVBUF does not translate into overly large buffer allocations */
+#define GST_TCP_MAX_READ_SIZE      (1024 * 1024)
+
+/* Get the size to use for reads from @socket, based on the kernel receive
+ * buffer size. Reading up to SO_RCVBUF bytes at once means one buffer can
+ * drain everything the kernel has queued for us. */
+static inline gsize
+gst_tcp_socket_get_read_size (GSocket * socket)
+{
+  gint rcvbuf = 0;
+
+  if (socket == NULL
+      || !g_socket_get_option (socket, SOL_SOCKET, SO_RCVBUF, &rcvbuf, NULL)
+      || rcvbuf <= 0)
+    return GST_TCP_DEFAULT_READ_SIZE;
+
+  return CLAMP ((gsize) rcvbuf, GST_TCP_DEFAULT_READ_SIZE,
+      GST_TCP_MAX_READ_SIZE);
+}
+
+/* Create and activate a buffer pool of @buffer_size sized buffers for the
+ * receive path. Returns NULL if the pool could not be configured, in which
+ * case the caller should fall back to plain allocations. */
+static inline GstBufferPool *
+gst_tcp_create_read_buffer_pool (gsize buffer_size)
+{
+  GstBufferPool *pool;
+  GstStructure *config;
+
+  pool = gst_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, NULL, buffer_size, 0, 0);
+  if (!gst_buffer_pool_set_config (pool, config)
+      || !gst_buffer_pool_set_active (pool, TRUE)) {
+    gst_object_unref (pool);
+    return NULL;
+  }
+
+  return pool;
+}
+
 #endif /* __GST_TCP_HELP_H__ */
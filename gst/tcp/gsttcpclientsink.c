@@ -45,6 +45,13 @@
 #include "gsttcp.h"
 #include "gsttcpclientsink.h"
 
+#ifndef G_OS_WIN32
+#include <sys/ioctl.h>
+#endif
+#ifdef __linux__
+#include <linux/sockios.h>
+#endif
+
 /* TCPClientSink signals and args */
 enum
 {
@@ -60,7 +67,10 @@ enum
 {
   PROP_0,
   PROP_HOST,
-  PROP_PORT
+  PROP_PORT,
+  PROP_MAX_UNSENT_BYTES,
+  PROP_SEND_BUFFER_SIZE,
+  PROP_UNSENT_BYTES
 };
 
 static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
@@ -115,6 +125,55 @@ gst_tcp_client_sink_class_init (GstTCPClientSinkClass * klass)
           0, TCP_HIGHEST_PORT, TCP_DEFAULT_PORT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTCPClientSink:max-unsent-bytes:
+   *
+   * Enables a low-latency backpressure mode. Instead of letting the kernel
+   * buffer up to a full SO_SNDBUF of data invisibly, the sink sets
+   * TCP_NOTSENT_LOWAT to this value where supported, waits for the socket
+   * to become writable before each send and never hands the kernel more
+   * than this many bytes at once. On a congested link render then blocks
+   * with only a bounded amount of data queued in the kernel, so upstream
+   * leaky queues can drop instead of the latency accumulating in the
+   * socket. A value of 0 disables this and sends as before.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_UNSENT_BYTES,
+      g_param_spec_uint ("max-unsent-bytes", "Max unsent bytes",
+          "Maximum number of bytes to leave unsent in the kernel before "
+          "blocking upstream (0 = disabled)", 0, G_MAXUINT, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTCPClientSink:send-buffer-size:
+   *
+   * Size of the kernel send buffer (SO_SNDBUF) in bytes, applied when the
+   * connection is established. Smaller values bound how much data the
+   * kernel can queue on a congested link. A value of 0 leaves the kernel
+   * default untouched.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_SEND_BUFFER_SIZE,
+      g_param_spec_int ("send-buffer-size", "Send buffer size",
+          "Size of the kernel send buffer in bytes (0 = default)",
+          0, G_MAXINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTCPClientSink:unsent-bytes:
+   *
+   * Number of bytes currently queued in the kernel send buffer but not
+   * yet sent to the network, or 0 where the platform cannot report it.
+   * Useful for monitoring how far the socket is backed up.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_UNSENT_BYTES,
+      g_param_spec_uint ("unsent-bytes", "Unsent bytes",
+          "Number of bytes queued in the kernel but not yet sent",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_static_pad_template (gstelement_class, &sinktemplate);
 
   gst_element_class_set_static_metadata (gstelement_class,
@@ -169,6 +228,32 @@ gst_tcp_client_sink_setcaps (GstBaseSink * bsink, GstCaps * caps)
   return TRUE;
 }
 
+/* how much data is sitting in the kernel send queue, not yet handed to the
+ * network. SIOCOUTQNSD reports exactly that; SIOCOUTQ also includes data
+ * that was sent but not yet acked and is used as a fallback. */
+static guint
+gst_tcp_client_sink_get_unsent_bytes (GstTCPClientSink * sink)
+{
+#if defined (SIOCOUTQNSD) || defined (SIOCOUTQ)
+  gint value = 0;
+
+  if (sink->socket == NULL)
+    return 0;
+
+#if defined (SIOCOUTQNSD)
+  if (ioctl (g_socket_get_fd (sink->socket), SIOCOUTQNSD, &value) < 0)
+    return 0;
+#else
+  if (ioctl (g_socket_get_fd (sink->socket), SIOCOUTQ, &value) < 0)
+    return 0;
+#endif
+
+  return value > 0 ? (guint) value : 0;
+#else
+  return 0;
+#endif
+}
+
 static GstFlowReturn
 gst_tcp_client_sink_render (GstBaseSink * bsink, GstBuffer * buf)
 {
@@ -189,9 +274,21 @@ gst_tcp_client_sink_render (GstBaseSink * bsink, GstBuffer * buf)
 
   /* write buffer data */
   while (written < map.size) {
+    gsize to_write = map.size - written;
+
+    if (sink->max_unsent_bytes > 0) {
+      /* with TCP_NOTSENT_LOWAT set this only wakes up once the unsent
+       * queue has drained below the threshold, and capping the send size
+       * keeps us from refilling it beyond that in one go */
+      to_write = MIN (to_write, sink->max_unsent_bytes);
+      if (!g_socket_condition_wait (sink->socket, G_IO_OUT,
+              sink->cancellable, &err))
+        goto write_error;
+    }
+
     rret =
         g_socket_send (sink->socket, (gchar *) map.data + written,
-        map.size - written, sink->cancellable, &err);
+        to_write, sink->cancellable, &err);
     if (rret < 0)
       goto write_error;
     written += rret;
@@ -244,6 +341,13 @@ gst_tcp_client_sink_set_property (GObject * object, guint prop_id,
     case PROP_PORT:
       tcpclientsink->port = g_value_get_int (value);
       break;
+    case PROP_MAX_UNSENT_BYTES:
+      tcpclientsink->max_unsent_bytes = g_value_get_uint (value);
+      break;
+    case PROP_SEND_BUFFER_SIZE:
+      /* applied when the next connection is established */
+      tcpclientsink->send_buffer_size = g_value_get_int (value);
+      break;
 
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -267,6 +371,16 @@ gst_tcp_client_sink_get_property (GObject * object, guint prop_id,
     case PROP_PORT:
       g_value_set_int (value, tcpclientsink->port);
       break;
+    case PROP_MAX_UNSENT_BYTES:
+      g_value_set_uint (value, tcpclientsink->max_unsent_bytes);
+      break;
+    case PROP_SEND_BUFFER_SIZE:
+      g_value_set_int (value, tcpclientsink->send_buffer_size);
+      break;
+    case PROP_UNSENT_BYTES:
+      g_value_set_uint (value,
+          gst_tcp_client_sink_get_unsent_bytes (tcpclientsink));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -332,6 +446,29 @@ gst_tcp_client_sink_start (GstBaseSink * bsink)
 
   g_object_unref (saddr);
 
+  if (this->send_buffer_size > 0) {
+    if (!g_socket_set_option (this->socket, SOL_SOCKET, SO_SNDBUF,
+            this->send_buffer_size, &err)) {
+      GST_WARNING_OBJECT (this, "Failed to set SO_SNDBUF to %d: %s",
+          this->send_buffer_size, err->message);
+      g_clear_error (&err);
+    }
+  }
+
+  if (this->max_unsent_bytes > 0) {
+#ifdef TCP_NOTSENT_LOWAT
+    if (!g_socket_set_option (this->socket, IPPROTO_TCP, TCP_NOTSENT_LOWAT,
+            this->max_unsent_bytes, &err)) {
+      GST_WARNING_OBJECT (this, "Failed to set TCP_NOTSENT_LOWAT to %u: %s",
+          this->max_unsent_bytes, err->message);
+      g_clear_error (&err);
+    }
+#else
+    GST_WARNING_OBJECT (this, "TCP_NOTSENT_LOWAT not supported here, "
+        "only waiting for writability before sending");
+#endif
+  }
+
   GST_OBJECT_FLAG_SET (this, GST_TCP_CLIENT_SINK_OPEN);
 
   this->data_written = 0;
@@ -62,6 +62,10 @@ struct _GstTCPClientSink {
   GSocket *socket;
   GCancellable *cancellable;
 
+  /* low-latency backpressure mode, active when max_unsent_bytes > 0 */
+  guint max_unsent_bytes;
+  gint send_buffer_size;
+
   size_t data_written; /* how much bytes have we written ? */
 };
 
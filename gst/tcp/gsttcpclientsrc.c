@@ -49,7 +49,6 @@
 GST_DEBUG_CATEGORY_STATIC (tcpclientsrc_debug);
 #define GST_CAT_DEFAULT tcpclientsrc_debug
 
-#define MAX_READ_SIZE                   4 * 1024
 #define TCP_DEFAULT_TIMEOUT             0
 
 
@@ -154,6 +153,8 @@ gst_tcp_client_src_init (GstTCPClientSrc * this)
   this->timeout = TCP_DEFAULT_TIMEOUT;
   this->socket = NULL;
   this->cancellable = g_cancellable_new ();
+  this->pool = NULL;
+  this->read_size = GST_TCP_DEFAULT_READ_SIZE;
 
   GST_OBJECT_FLAG_UNSET (this, GST_TCP_CLIENT_SRC_OPEN);
 }
@@ -240,9 +241,13 @@ gst_tcp_client_src_create (GstPushSrc * psrc, GstBuffer ** outbuf)
   }
 
   if (avail > 0) {
-    read = MIN (avail, MAX_READ_SIZE);
-    *outbuf = gst_buffer_new_and_alloc (read);
+    read = MIN ((gsize) avail, src->read_size);
+    if (src->pool == NULL
+        || gst_buffer_pool_acquire_buffer (src->pool, outbuf,
+            NULL) != GST_FLOW_OK)
+      *outbuf = gst_buffer_new_and_alloc (read);
     gst_buffer_map (*outbuf, &map, GST_MAP_READWRITE);
+    read = MIN ((gsize) read, map.size);
     rret =
         g_socket_receive (src->socket, (gchar *) map.data, read,
         src->cancellable, &err);
@@ -427,6 +432,13 @@ gst_tcp_client_src_start (GstBaseSrc * bsrc)
 
   g_object_unref (saddr);
 
+  /* size reads from the receive buffer of the connected socket and set up
+   * a pool of buffers of that size for the receive path */
+  src->read_size = gst_tcp_socket_get_read_size (src->socket);
+  src->pool = gst_tcp_create_read_buffer_pool (src->read_size);
+  GST_DEBUG_OBJECT (src, "reading up to %" G_GSIZE_FORMAT " bytes per buffer",
+      src->read_size);
+
   return TRUE;
 
 no_socket:
@@ -487,6 +499,12 @@ gst_tcp_client_src_stop (GstBaseSrc * bsrc)
     src->socket = NULL;
   }
 
+  if (src->pool) {
+    gst_buffer_pool_set_active (src->pool, FALSE);
+    gst_object_unref (src->pool);
+    src->pool = NULL;
+  }
+
   GST_OBJECT_FLAG_UNSET (src, GST_TCP_CLIENT_SRC_OPEN);
 
   return TRUE;
@@ -60,6 +60,10 @@ struct _GstTCPClientSrc {
   /* socket */
   GSocket *socket;
   GCancellable *cancellable;
+
+  /* receive path, sized from the socket receive buffer */
+  GstBufferPool *pool;
+  gsize read_size;
 };
 
 struct _GstTCPClientSrcClass {
@@ -49,7 +49,6 @@ GST_DEBUG_CATEGORY_STATIC (tcpserversrc_debug);
 #define TCP_DEFAULT_LISTEN_HOST         NULL    /* listen on all interfaces */
 #define TCP_BACKLOG                     1       /* client connection queue */
 
-#define MAX_READ_SIZE                   4 * 1024
 
 static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_SRC,
@@ -148,6 +147,8 @@ gst_tcp_server_src_init (GstTCPServerSrc * src)
   src->server_socket = NULL;
   src->client_socket = NULL;
   src->cancellable = g_cancellable_new ();
+  src->pool = NULL;
+  src->read_size = GST_TCP_DEFAULT_READ_SIZE;
 
   GST_OBJECT_FLAG_UNSET (src, GST_TCP_SERVER_SRC_OPEN);
 }
@@ -200,6 +201,15 @@ gst_tcp_server_src_create (GstPushSrc * psrc, GstBuffer ** outbuf)
       GST_ERROR_OBJECT (src, "Failed to close socket: %s", err->message);
       g_clear_error (&err);
     }
+
+    /* size reads from the receive buffer of the accepted socket and set up
+     * a pool of buffers of that size for the receive path */
+    src->read_size = gst_tcp_socket_get_read_size (src->client_socket);
+    if (src->pool == NULL)
+      src->pool = gst_tcp_create_read_buffer_pool (src->read_size);
+    GST_DEBUG_OBJECT (src, "reading up to %" G_GSIZE_FORMAT
+        " bytes per buffer", src->read_size);
+
     /* now read from the socket. */
   }
 
@@ -239,9 +249,13 @@ gst_tcp_server_src_create (GstPushSrc * psrc, GstBuffer ** outbuf)
   }
 
   if (avail > 0) {
-    read = MIN (avail, MAX_READ_SIZE);
-    *outbuf = gst_buffer_new_and_alloc (read);
+    read = MIN ((gsize) avail, src->read_size);
+    if (src->pool == NULL
+        || gst_buffer_pool_acquire_buffer (src->pool, outbuf,
+            NULL) != GST_FLOW_OK)
+      *outbuf = gst_buffer_new_and_alloc (read);
     gst_buffer_map (*outbuf, &map, GST_MAP_READWRITE);
+    read = MIN (read, map.size);
     rret =
         g_socket_receive (src->client_socket, (gchar *) map.data, read,
         src->cancellable, &err);
@@ -523,6 +537,12 @@ gst_tcp_server_src_stop (GstBaseSrc * bsrc)
     src->client_socket = NULL;
   }
 
+  if (src->pool) {
+    gst_buffer_pool_set_active (src->pool, FALSE);
+    gst_object_unref (src->pool);
+    src->pool = NULL;
+  }
+
   if (src->server_socket) {
     GST_DEBUG_OBJECT (src, "closing socket");
 
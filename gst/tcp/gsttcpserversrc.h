@@ -61,6 +61,10 @@ struct _GstTCPServerSrc {
   GCancellable *cancellable;
   GSocket *server_socket;
   GSocket *client_socket;
+
+  /* receive path, sized from the socket receive buffer */
+  GstBufferPool *pool;
+  gsize read_size;
 };
 
 struct _GstTCPServerSrcClass {
@@ -5585,6 +5585,107 @@ sw_data_destroy (GstTypeFindData * sw_data)
   g_slice_free (GstTypeFindData, sw_data);
 }
 
+/*** compiled dispatch over all registered prefix patterns ***/
+
+typedef struct
+{
+  const guint8 *data;           /* static pattern bytes */
+  guint size;
+  guint probability;
+  GstCaps *caps;                /* own ref */
+  gboolean riff;                /* pattern sits at offset 8 behind RIFF/AVF0 */
+} TypeFindPattern;
+
+static GPtrArray *prefix_patterns;      /* all patterns, registration order */
+static GPtrArray *prefix_buckets[256];  /* patterns indexed by first byte */
+static guint prefix_peek_size;
+
+static void
+prefix_dispatch_add_pattern (GstTypeFindData * sw_data, gboolean riff)
+{
+  TypeFindPattern *pattern;
+
+  if (prefix_patterns == NULL)
+    prefix_patterns = g_ptr_array_new ();
+
+  /* keep an independent copy; the pattern bytes are string literals and the
+   * caps are shared with the factory via an extra ref */
+  pattern = g_slice_new (TypeFindPattern);
+  pattern->data = sw_data->data;
+  pattern->size = sw_data->size;
+  pattern->probability = sw_data->probability;
+  pattern->caps = gst_caps_ref (sw_data->caps);
+  pattern->riff = riff;
+  g_ptr_array_add (prefix_patterns, pattern);
+}
+
+static void
+prefix_dispatch_bucket_add (guint8 byte, TypeFindPattern * pattern)
+{
+  if (prefix_buckets[byte] == NULL)
+    prefix_buckets[byte] = g_ptr_array_new ();
+  g_ptr_array_add (prefix_buckets[byte], pattern);
+}
+
+/* sort the registered patterns into a first-byte table, so that matching a
+ * stream against all of them is one peek plus a scan of a short bucket */
+static void
+prefix_dispatch_compile (void)
+{
+  guint i;
+
+  if (prefix_patterns == NULL)
+    return;
+
+  for (i = 0; i < prefix_patterns->len; i++) {
+    TypeFindPattern *pattern = g_ptr_array_index (prefix_patterns, i);
+    guint need;
+
+    if (pattern->riff) {
+      prefix_dispatch_bucket_add ('R', pattern);
+      prefix_dispatch_bucket_add ('A', pattern);
+      need = 12;
+    } else {
+      prefix_dispatch_bucket_add (pattern->data[0], pattern);
+      need = pattern->size;
+    }
+    prefix_peek_size = MAX (prefix_peek_size, need);
+  }
+}
+
+static void
+prefix_dispatch_type_find (GstTypeFind * tf, gpointer unused)
+{
+  const GPtrArray *bucket;
+  const guint8 *data;
+  guint i;
+
+  if (prefix_peek_size == 0)
+    return;
+
+  /* one peek covering the longest pattern; if the stream is shorter than
+   * that, bail out and leave it to the individual typefinders */
+  data = gst_type_find_peek (tf, 0, prefix_peek_size);
+  if (data == NULL)
+    return;
+
+  bucket = prefix_buckets[data[0]];
+  if (bucket == NULL)
+    return;
+
+  for (i = 0; i < bucket->len; i++) {
+    TypeFindPattern *pattern = g_ptr_array_index (bucket, i);
+
+    if (pattern->riff) {
+      if ((memcmp (data, "RIFF", 4) == 0 || memcmp (data, "AVF0", 4) == 0)
+          && memcmp (data + 8, pattern->data, 4) == 0)
+        gst_type_find_suggest (tf, pattern->probability, pattern->caps);
+    } else if (memcmp (data, pattern->data, pattern->size) == 0) {
+      gst_type_find_suggest (tf, pattern->probability, pattern->caps);
+    }
+  }
+}
+
 #define TYPE_FIND_REGISTER_START_WITH(plugin,name,rank,ext,_data,_size,_probability)\
 G_BEGIN_DECLS{                                                          \
   GstTypeFindData *sw_data = g_slice_new (GstTypeFindData);             \
@@ -5596,6 +5697,8 @@ G_BEGIN_DECLS{                                                          \
                      ext, sw_data->caps, sw_data,                       \
                      (GDestroyNotify) (sw_data_destroy))) {             \
     sw_data_destroy (sw_data);                                          \
+  } else {                                                              \
+    prefix_dispatch_add_pattern (sw_data, FALSE);                       \
   }                                                                     \
 }G_END_DECLS
 
@@ -5625,6 +5728,8 @@ G_BEGIN_DECLS{                                                          \
                       ext, sw_data->caps, sw_data,                      \
                       (GDestroyNotify) (sw_data_destroy))) {            \
     sw_data_destroy (sw_data);                                          \
+  } else {                                                              \
+    prefix_dispatch_add_pattern (sw_data, TRUE);                        \
   }                                                                     \
 }G_END_DECLS
 
@@ -5895,7 +6000,7 @@ plugin_init (GstPlugin * plugin)
       GST_RANK_SECONDARY, msdos_type_find, "dll,exe,ocx,sys,scr,msstyles,cpl",
       MSDOS_CAPS, NULL, NULL);
   TYPE_FIND_REGISTER (plugin, "video/x-dirac", GST_RANK_PRIMARY,
-      dirac_type_find, NULL, DIRAC_CAPS, NULL, NULL);
+      dirac_type_find, "drc", DIRAC_CAPS, NULL, NULL);
   TYPE_FIND_REGISTER (plugin, "multipart/x-mixed-replace", GST_RANK_SECONDARY,
       multipart_type_find, NULL, MULTIPART_CAPS, NULL, NULL);
   TYPE_FIND_REGISTER (plugin, "application/x-mmsh", GST_RANK_SECONDARY,
@@ -5931,11 +6036,11 @@ plugin_init (GstPlugin * plugin)
       GST_RANK_SECONDARY, "psd", "8BPS\000\001\000\000\000\000", 10,
       GST_TYPE_FIND_LIKELY);
   TYPE_FIND_REGISTER (plugin, "image/vnd.wap.wbmp", GST_RANK_MARGINAL,
-      wbmp_typefind, NULL, NULL, NULL, NULL);
+      wbmp_typefind, "wbmp", NULL, NULL, NULL);
   TYPE_FIND_REGISTER (plugin, "application/x-yuv4mpeg", GST_RANK_SECONDARY,
-      y4m_typefind, NULL, NULL, NULL, NULL);
+      y4m_typefind, "y4m", NULL, NULL, NULL);
   TYPE_FIND_REGISTER (plugin, "image/x-icon", GST_RANK_MARGINAL,
-      windows_icon_typefind, NULL, NULL, NULL, NULL);
+      windows_icon_typefind, "ico,cur", NULL, NULL, NULL);
 
 #ifdef USE_GIO
   TYPE_FIND_REGISTER (plugin, "xdgmime-base", GST_RANK_MARGINAL,
@@ -5943,9 +6048,9 @@ plugin_init (GstPlugin * plugin)
 #endif
 
   TYPE_FIND_REGISTER (plugin, "image/x-degas", GST_RANK_MARGINAL,
-      degas_type_find, NULL, NULL, NULL, NULL);
+      degas_type_find, "pi1,pi2,pi3,pc1,pc2,pc3", NULL, NULL, NULL);
   TYPE_FIND_REGISTER (plugin, "application/octet-stream", GST_RANK_MARGINAL,
-      dvdiso_type_find, NULL, NULL, NULL, NULL);
+      dvdiso_type_find, "iso", NULL, NULL, NULL);
 
   TYPE_FIND_REGISTER (plugin, "application/x-ssa", GST_RANK_SECONDARY,
       ssa_type_find, "ssa,ass", NULL, NULL, NULL);
@@ -5959,6 +6064,17 @@ plugin_init (GstPlugin * plugin)
   TYPE_FIND_REGISTER (plugin, "audio/audible", GST_RANK_MARGINAL,
       aa_type_find, "aa,aax", AA_CAPS, NULL, NULL);
 
+  /* compile all prefix patterns registered above into a first-byte table
+   * and register the dispatch function above the other ranks: it matches a
+   * stream against every pattern with a single peek, and when a pattern with
+   * maximum probability hits, the typefind helpers stop before calling any
+   * of the remaining typefinders. The individual factories stay registered
+   * for their caps, extensions and ranks, and still handle streams shorter
+   * than the longest pattern. */
+  prefix_dispatch_compile ();
+  TYPE_FIND_REGISTER (plugin, "prefix-dispatch", GST_RANK_PRIMARY + 1,
+      prefix_dispatch_type_find, NULL, NULL, NULL, NULL);
+
   return TRUE;
 }
 
@@ -113,7 +113,8 @@ enum
   PROP_DROP_ONLY,
   PROP_AVERAGE_PERIOD,
   PROP_MAX_RATE,
-  PROP_RATE
+  PROP_RATE,
+  PROP_STATS
 };
 
 static GstStaticPadTemplate gst_video_rate_src_template =
@@ -275,6 +276,20 @@ gst_video_rate_class_init (GstVideoRateClass * klass)
           DEFAULT_RATE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_READY));
 
+  /**
+   * GstVideoRate:stats:
+   *
+   * A consistent snapshot of the "in", "out", "duplicate" and "drop"
+   * counters as a #GstStructure, taken atomically so the values match
+   * each other even while the element is processing buffers.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (object_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Frame count statistics", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (element_class,
       "Video rate adjuster", "Filter/Effect/Video",
       "Drops/duplicates/adjusts timestamps on video frames to make a perfect stream",
@@ -711,9 +726,9 @@ gst_video_rate_flush_prev (GstVideoRate * videorate, gboolean duplicate,
   if (!videorate->prevbuf)
     goto eos_before_buffers;
 
-  outbuf = gst_buffer_ref (videorate->prevbuf);
-  /* make sure we can write to the metadata */
-  outbuf = gst_buffer_make_writable (outbuf);
+  /* make a writable copy so we can retimestamp the duplicate; this only
+   * copies the buffer metadata, the memory blocks are shared with prevbuf */
+  outbuf = gst_buffer_copy (videorate->prevbuf);
 
   return gst_video_rate_push_buffer (videorate, outbuf, duplicate, next_intime);
 
@@ -1646,6 +1661,14 @@ gst_video_rate_get_property (GObject * object,
     case PROP_RATE:
       g_value_set_double (value, videorate->rate);
       break;
+    case PROP_STATS:
+      g_value_take_boxed (value,
+          gst_structure_new ("application/x-videorate-stats",
+              "in", G_TYPE_UINT64, videorate->in,
+              "out", G_TYPE_UINT64, videorate->out,
+              "duplicate", G_TYPE_UINT64, videorate->dup,
+              "drop", G_TYPE_UINT64, videorate->drop, NULL));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -266,7 +266,7 @@ gst_video_scale_class_init (GstVideoScaleClass * klass)
 
   g_object_class_install_property (gobject_class, PROP_N_THREADS,
       g_param_spec_uint ("n-threads", "Threads",
-          "Maximum number of threads to use", 0, G_MAXUINT,
+          "Maximum number of threads to use (0 = automatic)", 0, G_MAXUINT,
           DEFAULT_PROP_N_THREADS,
           G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
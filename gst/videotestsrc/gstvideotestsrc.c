@@ -126,6 +126,8 @@ static void gst_video_test_src_get_times (GstBaseSrc * basesrc,
     GstBuffer * buffer, GstClockTime * start, GstClockTime * end);
 static gboolean gst_video_test_src_decide_allocation (GstBaseSrc * bsrc,
     GstQuery * query);
+static GstFlowReturn gst_video_test_src_create (GstPushSrc * psrc,
+    GstBuffer ** buffer);
 static GstFlowReturn gst_video_test_src_fill (GstPushSrc * psrc,
     GstBuffer * buffer);
 static gboolean gst_video_test_src_start (GstBaseSrc * basesrc);
@@ -371,6 +373,7 @@ gst_video_test_src_class_init (GstVideoTestSrcClass * klass)
   gstbasesrc_class->stop = gst_video_test_src_stop;
   gstbasesrc_class->decide_allocation = gst_video_test_src_decide_allocation;
 
+  gstpushsrc_class->create = gst_video_test_src_create;
   gstpushsrc_class->fill = gst_video_test_src_fill;
 }
 
@@ -603,6 +606,11 @@ gst_video_test_src_set_property (GObject * object, guint prop_id,
 {
   GstVideoTestSrc *src = GST_VIDEO_TEST_SRC (object);
 
+  /* changing any property may change the rendered image */
+  GST_OBJECT_LOCK (src);
+  gst_buffer_replace (&src->cached_frame, NULL);
+  GST_OBJECT_UNLOCK (src);
+
   switch (prop_id) {
     case PROP_PATTERN:
       gst_video_test_src_set_pattern (src, g_value_get_enum (value));
@@ -930,6 +938,8 @@ gst_video_test_src_setcaps (GstBaseSrc * bsrc, GstCaps * caps)
   /* looks ok here */
   videotestsrc->info = info;
 
+  gst_buffer_replace (&videotestsrc->cached_frame, NULL);
+
   GST_DEBUG_OBJECT (videotestsrc, "size %dx%d, %d/%d fps",
       info.width, info.height, info.fps_n, info.fps_d);
 
@@ -1113,17 +1123,52 @@ gst_video_test_src_is_seekable (GstBaseSrc * psrc)
   return TRUE;
 }
 
+/* Returns TRUE if the current pattern renders the same image for every
+ * frame, so that a previously rendered frame can be reused. */
+static gboolean
+gst_video_test_src_pattern_is_static (GstVideoTestSrc * src)
+{
+  /* scrolling shifts the image every frame */
+  if (src->horizontal_speed != 0)
+    return FALSE;
+
+  switch (src->pattern_type) {
+    case GST_VIDEO_TEST_SRC_BLACK:
+    case GST_VIDEO_TEST_SRC_WHITE:
+    case GST_VIDEO_TEST_SRC_RED:
+    case GST_VIDEO_TEST_SRC_GREEN:
+    case GST_VIDEO_TEST_SRC_BLUE:
+    case GST_VIDEO_TEST_SRC_CHECKERS1:
+    case GST_VIDEO_TEST_SRC_CHECKERS2:
+    case GST_VIDEO_TEST_SRC_CHECKERS4:
+    case GST_VIDEO_TEST_SRC_CHECKERS8:
+    case GST_VIDEO_TEST_SRC_CIRCULAR:
+    case GST_VIDEO_TEST_SRC_SMPTE75:
+    case GST_VIDEO_TEST_SRC_GAMUT:
+    case GST_VIDEO_TEST_SRC_SOLID:
+    case GST_VIDEO_TEST_SRC_SMPTE100:
+    case GST_VIDEO_TEST_SRC_BAR:
+    case GST_VIDEO_TEST_SRC_GRADIENT:
+    case GST_VIDEO_TEST_SRC_COLORS:
+      return TRUE;
+    case GST_VIDEO_TEST_SRC_PINWHEEL:
+    case GST_VIDEO_TEST_SRC_SPOKES:
+      /* these rotate over time with the kt coefficient */
+      return src->kt == 0;
+    default:
+      return FALSE;
+  }
+}
+
 static GstFlowReturn
-gst_video_test_src_fill (GstPushSrc * psrc, GstBuffer * buffer)
+gst_video_test_src_do_fill (GstVideoTestSrc * src, GstBuffer * buffer,
+    gboolean render)
 {
-  GstVideoTestSrc *src;
   GstClockTime next_time;
   GstVideoFrame frame;
   gconstpointer pal;
   gsize palsize;
 
-  src = GST_VIDEO_TEST_SRC (psrc);
-
   if (G_UNLIKELY (GST_VIDEO_INFO_FORMAT (&src->info) ==
           GST_VIDEO_FORMAT_UNKNOWN))
     goto not_negotiated;
@@ -1140,23 +1185,25 @@ gst_video_test_src_fill (GstPushSrc * psrc, GstBuffer * buffer)
   GST_LOG_OBJECT (src,
       "creating buffer from pool for frame %d", (gint) src->n_frames);
 
-  if (!gst_video_frame_map (&frame, &src->info, buffer, GST_MAP_WRITE))
-    goto invalid_frame;
-
   GST_BUFFER_PTS (buffer) =
       src->accum_rtime + src->timestamp_offset + src->running_time;
   GST_BUFFER_DTS (buffer) = GST_CLOCK_TIME_NONE;
 
-  gst_object_sync_values (GST_OBJECT (psrc), GST_BUFFER_PTS (buffer));
+  gst_object_sync_values (GST_OBJECT (src), GST_BUFFER_PTS (buffer));
 
-  src->make_image (src, GST_BUFFER_PTS (buffer), &frame);
+  if (render) {
+    if (!gst_video_frame_map (&frame, &src->info, buffer, GST_MAP_WRITE))
+      goto invalid_frame;
 
-  if ((pal = gst_video_format_get_palette (GST_VIDEO_FRAME_FORMAT (&frame),
-              &palsize))) {
-    memcpy (GST_VIDEO_FRAME_PLANE_DATA (&frame, 1), pal, palsize);
-  }
+    src->make_image (src, GST_BUFFER_PTS (buffer), &frame);
 
-  gst_video_frame_unmap (&frame);
+    if ((pal = gst_video_format_get_palette (GST_VIDEO_FRAME_FORMAT (&frame),
+                &palsize))) {
+      memcpy (GST_VIDEO_FRAME_PLANE_DATA (&frame, 1), pal, palsize);
+    }
+
+    gst_video_frame_unmap (&frame);
+  }
 
   GST_DEBUG_OBJECT (src, "Timestamp: %" GST_TIME_FORMAT " = accumulated %"
       GST_TIME_FORMAT " + offset: %"
@@ -1205,6 +1252,71 @@ invalid_frame:
   }
 }
 
+static GstFlowReturn
+gst_video_test_src_fill (GstPushSrc * psrc, GstBuffer * buffer)
+{
+  return gst_video_test_src_do_fill (GST_VIDEO_TEST_SRC (psrc), buffer, TRUE);
+}
+
+static GstFlowReturn
+gst_video_test_src_create (GstPushSrc * psrc, GstBuffer ** buffer)
+{
+  GstVideoTestSrc *src = GST_VIDEO_TEST_SRC (psrc);
+  GstBuffer *buf = NULL;
+  GstFlowReturn ret;
+  gboolean use_cache;
+
+  /* checking for control bindings takes the object lock itself, so do it
+   * before we take the lock ourselves */
+  use_cache = !gst_object_has_active_control_bindings (GST_OBJECT (src));
+
+  GST_OBJECT_LOCK (src);
+  use_cache = use_cache && gst_video_test_src_pattern_is_static (src);
+  if (use_cache && src->cached_frame != NULL) {
+    /* shallow copy: shares the rendered memory but gets its own metadata.
+     * If downstream wants to write it will do a copy-on-write. */
+    buf = gst_buffer_copy (src->cached_frame);
+  }
+  GST_OBJECT_UNLOCK (src);
+
+  if (buf != NULL) {
+    GST_LOG_OBJECT (src, "reusing cached frame");
+    ret = gst_video_test_src_do_fill (src, buf, FALSE);
+    if (ret != GST_FLOW_OK) {
+      gst_buffer_unref (buf);
+      return ret;
+    }
+    *buffer = buf;
+    return GST_FLOW_OK;
+  }
+
+  ret = GST_BASE_SRC_CLASS (parent_class)->alloc (GST_BASE_SRC (src), -1,
+      gst_base_src_get_blocksize (GST_BASE_SRC (src)), &buf);
+  if (ret != GST_FLOW_OK)
+    return ret;
+
+  ret = gst_video_test_src_do_fill (src, buf, TRUE);
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (buf);
+    return ret;
+  }
+
+  if (use_cache) {
+    GstBuffer *copy;
+
+    /* deep copy so we don't hold on to a buffer from the pool */
+    copy = gst_buffer_copy_deep (buf);
+    GST_OBJECT_LOCK (src);
+    gst_buffer_replace (&src->cached_frame, copy);
+    GST_OBJECT_UNLOCK (src);
+    gst_buffer_unref (copy);
+  }
+
+  *buffer = buf;
+
+  return GST_FLOW_OK;
+}
+
 static gboolean
 gst_video_test_src_start (GstBaseSrc * basesrc)
 {
@@ -1246,6 +1358,10 @@ gst_video_test_src_stop (GstBaseSrc * basesrc)
   src->n_lines = 0;
   src->lines = NULL;
 
+  GST_OBJECT_LOCK (src);
+  gst_buffer_replace (&src->cached_frame, NULL);
+  GST_OBJECT_UNLOCK (src);
+
   return TRUE;
 }
 
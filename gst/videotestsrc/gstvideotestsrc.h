@@ -206,6 +206,9 @@ struct _GstVideoTestSrc {
   guint n_lines;
   gint offset;
   gpointer *lines;
+
+  /* rendered frame for static patterns, protected by the object lock */
+  GstBuffer *cached_frame;
 };
 
 struct _GstVideoTestSrcClass {
@@ -351,6 +351,31 @@ gst_volume_init (GstVolume * self)
   gst_base_transform_set_gap_aware (GST_BASE_TRANSFORM (self), TRUE);
 }
 
+/* Expand the per-frame volume array to one value per interleaved sample so
+ * that the single-channel vector kernels can be used for any channel count,
+ * instead of falling back to scalar per-sample loops. */
+static gdouble *
+volume_expand_volumes (GstVolume * self, gdouble * volume, guint num_samples,
+    guint channels)
+{
+  gdouble *dest;
+  guint i, j;
+
+  if (self->ch_volumes_count < num_samples * channels) {
+    self->ch_volumes = g_realloc (self->ch_volumes,
+        sizeof (gdouble) * num_samples * channels);
+    self->ch_volumes_count = num_samples * channels;
+  }
+
+  dest = self->ch_volumes;
+  for (i = 0; i < num_samples; i++) {
+    for (j = 0; j < channels; j++)
+      *dest++ = volume[i];
+  }
+
+  return self->ch_volumes;
+}
+
 static void
 volume_process_double (GstVolume * self, gpointer bytes, guint n_bytes)
 {
@@ -366,18 +391,13 @@ volume_process_controlled_double (GstVolume * self, gpointer bytes,
 {
   gdouble *data = (gdouble *) bytes;
   guint num_samples = n_bytes / (sizeof (gdouble) * channels);
-  guint i, j;
-  gdouble vol;
 
   if (channels == 1) {
     volume_orc_process_controlled_f64_1ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        *data++ *= vol;
-      }
-    }
+    volume = volume_expand_volumes (self, volume, num_samples, channels);
+    volume_orc_process_controlled_f64_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
@@ -396,20 +416,15 @@ volume_process_controlled_float (GstVolume * self, gpointer bytes,
 {
   gfloat *data = (gfloat *) bytes;
   guint num_samples = n_bytes / (sizeof (gfloat) * channels);
-  guint i, j;
-  gdouble vol;
 
   if (channels == 1) {
     volume_orc_process_controlled_f32_1ch (data, volume, num_samples);
   } else if (channels == 2) {
     volume_orc_process_controlled_f32_2ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        *data++ *= vol;
-      }
-    }
+    volume = volume_expand_volumes (self, volume, num_samples, channels);
+    volume_orc_process_controlled_f32_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
@@ -441,20 +456,14 @@ volume_process_controlled_int32_clamp (GstVolume * self, gpointer bytes,
     gdouble * volume, guint channels, guint n_bytes)
 {
   gint32 *data = (gint32 *) bytes;
-  guint i, j;
   guint num_samples = n_bytes / (sizeof (gint32) * channels);
-  gdouble vol, val;
 
   if (channels == 1) {
     volume_orc_process_controlled_int32_1ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        val = *data * vol;
-        *data++ = (gint32) CLAMP (val, VOLUME_MIN_INT32, VOLUME_MAX_INT32);
-      }
-    }
+    volume = volume_expand_volumes (self, volume, num_samples, channels);
+    volume_orc_process_controlled_int32_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
@@ -572,22 +581,16 @@ volume_process_controlled_int16_clamp (GstVolume * self, gpointer bytes,
     gdouble * volume, guint channels, guint n_bytes)
 {
   gint16 *data = (gint16 *) bytes;
-  guint i, j;
   guint num_samples = n_bytes / (sizeof (gint16) * channels);
-  gdouble vol, val;
 
   if (channels == 1) {
     volume_orc_process_controlled_int16_1ch (data, volume, num_samples);
   } else if (channels == 2) {
     volume_orc_process_controlled_int16_2ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        val = *data * vol;
-        *data++ = (gint16) CLAMP (val, VOLUME_MIN_INT16, VOLUME_MAX_INT16);
-      }
-    }
+    volume = volume_expand_volumes (self, volume, num_samples, channels);
+    volume_orc_process_controlled_int16_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
@@ -620,22 +623,16 @@ volume_process_controlled_int8_clamp (GstVolume * self, gpointer bytes,
     gdouble * volume, guint channels, guint n_bytes)
 {
   gint8 *data = (gint8 *) bytes;
-  guint i, j;
   guint num_samples = n_bytes / (sizeof (gint8) * channels);
-  gdouble val, vol;
 
   if (channels == 1) {
     volume_orc_process_controlled_int8_1ch (data, volume, num_samples);
   } else if (channels == 2) {
     volume_orc_process_controlled_int8_2ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        val = *data * vol;
-        *data++ = (gint8) CLAMP (val, VOLUME_MIN_INT8, VOLUME_MAX_INT8);
-      }
-    }
+    volume = volume_expand_volumes (self, volume, num_samples, channels);
+    volume_orc_process_controlled_int8_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
@@ -678,6 +675,10 @@ volume_stop (GstBaseTransform * base)
   self->mutes = NULL;
   self->mutes_count = 0;
 
+  g_free (self->ch_volumes);
+  self->ch_volumes = NULL;
+  self->ch_volumes_count = 0;
+
   return GST_CALL_PARENT_WITH_DEFAULT (GST_BASE_TRANSFORM_CLASS, stop, (base),
       TRUE);
 }
@@ -75,6 +75,9 @@ struct _GstVolume {
   guint mutes_count;
   gdouble *volumes;
   guint volumes_count;
+  /* volumes expanded to one value per interleaved sample */
+  gdouble *ch_volumes;
+  guint ch_volumes_count;
 };
 
 struct _GstVolumeClass {
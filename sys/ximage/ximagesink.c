@@ -223,6 +223,118 @@ gst_x_image_sink_xwindow_draw_borders (GstXImageSink * ximagesink,
   }
 }
 
+/* Maximum number of dirty bands we put separately; beyond that the
+ * bookkeeping costs more than just uploading the whole image */
+#define MAX_DIRTY_BANDS 8
+/* Merge bands separated by less than this many unchanged rows */
+#define DIRTY_BAND_MERGE_GAP 8
+
+static void
+add_dirty_band (gint * bands, gint * n_bands, gint first, gint last)
+{
+  if (*n_bands > 0 &&
+      first <= bands[2 * (*n_bands - 1) + 1] + DIRTY_BAND_MERGE_GAP) {
+    bands[2 * (*n_bands - 1) + 1] = MAX (bands[2 * (*n_bands - 1) + 1], last);
+  } else if (*n_bands < MAX_DIRTY_BANDS) {
+    bands[2 * *n_bands] = first;
+    bands[2 * *n_bands + 1] = last;
+    (*n_bands)++;
+  } else {
+    /* too fragmented, widen the last band to cover the rest */
+    bands[2 * (*n_bands - 1) + 1] = last;
+  }
+}
+
+/* Works out which horizontal bands of @ximage changed since the last frame
+ * we put, either from "dirty" GstVideoRegionOfInterestMeta attached to
+ * @buffer or, when no such meta is present, from a per-row hash diff
+ * against the previous frame. @bands receives up to #MAX_DIRTY_BANDS pairs
+ * of first/last row numbers in image coordinates. Returns the number of
+ * bands, 0 if nothing changed, or -1 when the whole image must be put.
+ * Called with x_lock taken. */
+static gint
+gst_x_image_sink_get_dirty_bands (GstXImageSink * ximagesink,
+    GstBuffer * buffer, XImage * ximage, gint * bands)
+{
+  static GQuark dirty_quark = 0;
+  GstMeta *meta;
+  gpointer state = NULL;
+  gboolean have_meta = FALSE;
+  guint32 *hashes = ximagesink->row_hashes;
+  gboolean first_frame, changed;
+  gint n_bands = 0, rows, stride, y, band_start;
+
+  if (buffer == NULL)
+    return -1;
+
+  if (dirty_quark == 0)
+    dirty_quark = g_quark_from_static_string ("dirty");
+
+  /* explicit dirty regions attached by upstream win over hashing; they may
+   * come in any order so we upload the single band spanning all of them */
+  while ((meta = gst_buffer_iterate_meta_filtered (buffer, &state,
+              GST_VIDEO_REGION_OF_INTEREST_META_API_TYPE))) {
+    GstVideoRegionOfInterestMeta *roi = (GstVideoRegionOfInterestMeta *) meta;
+
+    if (roi->roi_type != dirty_quark)
+      continue;
+
+    if (!have_meta) {
+      bands[0] = roi->y;
+      bands[1] = roi->y + roi->h - 1;
+      have_meta = TRUE;
+    } else {
+      bands[0] = MIN (bands[0], (gint) roi->y);
+      bands[1] = MAX (bands[1], (gint) (roi->y + roi->h - 1));
+    }
+  }
+  if (have_meta) {
+    /* rows changed behind our back, the hash cache is stale now */
+    ximagesink->n_row_hashes = 0;
+    return 1;
+  }
+
+  rows = ximage->height;
+  stride = ximage->bytes_per_line;
+
+  if (ximagesink->n_row_hashes != (guint) rows) {
+    g_free (ximagesink->row_hashes);
+    hashes = ximagesink->row_hashes = g_new (guint32, rows);
+    first_frame = TRUE;
+  } else {
+    first_frame = FALSE;
+  }
+  ximagesink->n_row_hashes = rows;
+
+  band_start = -1;
+  for (y = 0; y < rows; y++) {
+    const guint8 *row = (const guint8 *) ximage->data + y * stride;
+    guint32 hash = 2166136261u;
+    gint x;
+
+    /* FNV-1a, cheap enough to run over the whole frame */
+    for (x = 0; x < stride; x++)
+      hash = (hash ^ row[x]) * 16777619u;
+
+    changed = first_frame || hash != hashes[y];
+    hashes[y] = hash;
+
+    if (changed && band_start < 0) {
+      band_start = y;
+    } else if (!changed && band_start >= 0) {
+      add_dirty_band (bands, &n_bands, band_start, y - 1);
+      band_start = -1;
+    }
+  }
+  if (band_start >= 0)
+    add_dirty_band (bands, &n_bands, band_start, rows - 1);
+
+  if (first_frame)
+    return -1;
+
+  return n_bands;
+}
+
 /* This function puts a GstXImageBuffer on a GstXImageSink's window */
 static gboolean
 gst_x_image_sink_ximage_put (GstXImageSink * ximagesink, GstBuffer * ximage)
@@ -233,6 +345,9 @@ gst_x_image_sink_ximage_put (GstXImageSink * ximagesink, GstBuffer * ximage)
   GstVideoRectangle dst = { 0, };
   GstVideoRectangle result;
   gboolean draw_border = FALSE;
+  gboolean have_new_image = (ximage != NULL);
+  gint bands[2 * MAX_DIRTY_BANDS];
+  gint n_bands, i;
 
   /* We take the flow_lock. If expose is in there we don't want to run
      concurrently from the data flow thread */
@@ -298,25 +413,54 @@ gst_x_image_sink_ximage_put (GstXImageSink * ximagesink, GstBuffer * ximage)
         result);
     ximagesink->draw_border = FALSE;
   }
+
+  /* Work out which bands of the image actually changed. Expose redraws and
+   * border redraws always put everything, as does a geometry change since
+   * the window then no longer shows the previous frame where we left it. */
+  n_bands = gst_x_image_sink_get_dirty_bands (ximagesink,
+      have_new_image ? ximage : NULL, mem->ximage, bands);
+
+  if (draw_border ||
+      memcmp (&src, &ximagesink->last_src, sizeof (src)) != 0 ||
+      memcmp (&result, &ximagesink->last_result, sizeof (result)) != 0) {
+    ximagesink->last_src = src;
+    ximagesink->last_result = result;
+    n_bands = -1;
+  }
+
+  if (n_bands < 0) {
+    bands[0] = src.y;
+    bands[1] = src.y + result.h - 1;
+    n_bands = 1;
+  }
+
+  for (i = 0; i < n_bands; i++) {
+    gint y0 = MAX (bands[2 * i], src.y);
+    gint y1 = MIN (bands[2 * i + 1], src.y + result.h - 1);
+
+    if (y0 > y1)
+      continue;
+
 #ifdef HAVE_XSHM
-  if (ximagesink->xcontext->use_xshm) {
-    GST_LOG_OBJECT (ximagesink,
-        "XShmPutImage on %p, src: %d, %d - dest: %d, %d, dim: %dx%d, win %dx%d",
-        ximage, 0, 0, result.x, result.y, result.w, result.h,
-        ximagesink->xwindow->width, ximagesink->xwindow->height);
-    XShmPutImage (ximagesink->xcontext->disp, ximagesink->xwindow->win,
-        ximagesink->xwindow->gc, mem->ximage, src.x, src.y, result.x, result.y,
-        result.w, result.h, FALSE);
-  } else
+    if (ximagesink->xcontext->use_xshm) {
+      GST_LOG_OBJECT (ximagesink,
+          "XShmPutImage on %p, src: %d, %d - dest: %d, %d, dim: %dx%d, win %dx%d",
+          ximage, src.x, y0, result.x, result.y + (y0 - src.y), result.w,
+          y1 - y0 + 1, ximagesink->xwindow->width, ximagesink->xwindow->height);
+      XShmPutImage (ximagesink->xcontext->disp, ximagesink->xwindow->win,
+          ximagesink->xwindow->gc, mem->ximage, src.x, y0,
+          result.x, result.y + (y0 - src.y), result.w, y1 - y0 + 1, FALSE);
+    } else
 #endif /* HAVE_XSHM */
-  {
-    GST_LOG_OBJECT (ximagesink,
-        "XPutImage on %p, src: %d, %d - dest: %d, %d, dim: %dx%d, win %dx%d",
-        ximage, 0, 0, result.x, result.y, result.w, result.h,
-        ximagesink->xwindow->width, ximagesink->xwindow->height);
-    XPutImage (ximagesink->xcontext->disp, ximagesink->xwindow->win,
-        ximagesink->xwindow->gc, mem->ximage, src.x, src.y, result.x, result.y,
-        result.w, result.h);
+    {
+      GST_LOG_OBJECT (ximagesink,
+          "XPutImage on %p, src: %d, %d - dest: %d, %d, dim: %dx%d, win %dx%d",
+          ximage, src.x, y0, result.x, result.y + (y0 - src.y), result.w,
+          y1 - y0 + 1, ximagesink->xwindow->width, ximagesink->xwindow->height);
+      XPutImage (ximagesink->xcontext->disp, ximagesink->xwindow->win,
+          ximagesink->xwindow->gc, mem->ximage, src.x, y0,
+          result.x, result.y + (y0 - src.y), result.w, y1 - y0 + 1);
+    }
   }
 
   XSync (ximagesink->xcontext->disp, FALSE);
@@ -1834,6 +1978,10 @@ gst_x_image_sink_reset (GstXImageSink * ximagesink)
     ximagesink->cur_image = NULL;
   }
 
+  g_free (ximagesink->row_hashes);
+  ximagesink->row_hashes = NULL;
+  ximagesink->n_row_hashes = 0;
+
   g_mutex_lock (&ximagesink->flow_lock);
 
   if (ximagesink->pool) {
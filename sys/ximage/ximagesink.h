@@ -195,6 +195,13 @@ struct _GstXImageSink
   gboolean handle_expose;
   gboolean draw_border;
 
+  /* per-row hashes of the last frame we put, used to only upload the
+   * bands of the image that actually changed */
+  guint32 *row_hashes;
+  guint n_row_hashes;
+  GstVideoRectangle last_src;
+  GstVideoRectangle last_result;
+
   /* stream metadata */
   gchar *media_title;
 };
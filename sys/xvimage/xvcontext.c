@@ -711,6 +711,8 @@ gst_xvcontext_new (GstXvContextConfig * config, GError ** error)
   if (XShmQueryExtension (context->disp) &&
       gst_xvcontext_check_xshm_calls (context)) {
     context->use_xshm = TRUE;
+    context->shm_completion_type =
+        XShmGetEventBase (context->disp) + ShmCompletion;
     GST_DEBUG ("xvimagesink is using XShm extension");
   } else
 #endif /* HAVE_XSHM */
@@ -807,6 +809,41 @@ gst_xvcontext_set_synchronous (GstXvContext * context, gboolean synchronous)
   g_mutex_unlock (&context->lock);
 }
 
+/* Wait until at most @max_pending of the XvShmPutImage requests we issued
+ * are still being processed by the server, consuming the ShmCompletion
+ * events we asked for when putting the images. Must be called with the
+ * context lock taken. */
+void
+gst_xvcontext_drain_shm_puts (GstXvContext * context, guint max_pending)
+{
+#ifdef HAVE_XSHM
+  gint64 deadline;
+  XEvent ev;
+
+  if (context->pending_shm_puts <= max_pending)
+    return;
+
+  deadline = g_get_monotonic_time () + 100 * G_TIME_SPAN_MILLISECOND;
+
+  while (context->pending_shm_puts > max_pending) {
+    if (XCheckTypedEvent (context->disp, context->shm_completion_type, &ev)) {
+      context->pending_shm_puts--;
+      continue;
+    }
+    if (g_get_monotonic_time () >= deadline) {
+      /* the completion events might have been eaten by someone else
+       * dispatching on our display connection, resynchronize completely
+       * so that we don't wait here forever */
+      GST_WARNING ("no ShmCompletion event received, falling back to XSync");
+      XSync (context->disp, FALSE);
+      context->pending_shm_puts = 0;
+      break;
+    }
+    g_usleep (500);
+  }
+#endif /* HAVE_XSHM */
+}
+
 void
 gst_xvcontext_update_colorbalance (GstXvContext * context,
     GstXvContextConfig * config)
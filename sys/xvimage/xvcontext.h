@@ -146,6 +146,11 @@ struct _GstXvContext
 
   gboolean use_xshm;
 
+  /* X event type of ShmCompletion events on @disp and the number of
+   * XvShmPutImage requests the server has not completed yet */
+  gint shm_completion_type;
+  guint pending_shm_puts;
+
   XvPortID xv_port_id;
   guint nb_adaptors;
   gchar **adaptors;
@@ -201,6 +206,8 @@ void            gst_xvcontext_update_colorbalance       (GstXvContext * xvcontex
                                                          GstXvContextConfig * config);
 void            gst_xvcontext_set_colorimetry           (GstXvContext * xvcontext,
                                                          GstVideoColorimetry *colorimetry);
+void            gst_xvcontext_drain_shm_puts            (GstXvContext * xvcontext,
+                                                         guint max_pending);
 
 
 typedef struct _GstXWindow GstXWindow;
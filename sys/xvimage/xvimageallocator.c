@@ -164,6 +164,9 @@ gst_xvimage_allocator_free (GstAllocator * allocator, GstMemory * gmem)
     if (mem->SHMInfo.shmaddr != ((void *) -1)) {
       GST_DEBUG_OBJECT (allocator, "XServer ShmDetaching from 0x%x id 0x%lx",
           mem->SHMInfo.shmid, mem->SHMInfo.shmseg);
+      /* make sure the server is done reading from the segment before we
+       * detach and delete it */
+      gst_xvcontext_drain_shm_puts (context, 0);
       XShmDetach (context->disp, &mem->SHMInfo);
       XSync (context->disp, FALSE);
       shmdt (mem->SHMInfo.shmaddr);
@@ -641,6 +644,12 @@ gst_xvimage_memory_render (GstXvImageMemory * mem, GstVideoRectangle * src_crop,
   }
 #ifdef HAVE_XSHM
   if (context->use_xshm) {
+    /* Keep at most two frames in flight: the previous image can still be
+     * on its way to the screen while we queue the next one. Only when a
+     * third put would be outstanding do we wait for a ShmCompletion
+     * event, instead of stalling on a full XSync round trip per frame. */
+    gst_xvcontext_drain_shm_puts (context, 1);
+
     GST_LOG ("XvShmPutImage with image %dx%d and window %dx%d, from xvimage %p",
         src_crop->w, src_crop->h, window->render_rect.w, window->render_rect.h,
         mem);
@@ -650,7 +659,10 @@ gst_xvimage_memory_render (GstXvImageMemory * mem, GstVideoRectangle * src_crop,
         window->win,
         window->gc, xvimage,
         src_crop->x, src_crop->y, src_crop->w, src_crop->h,
-        dst_crop->x, dst_crop->y, dst_crop->w, dst_crop->h, FALSE);
+        dst_crop->x, dst_crop->y, dst_crop->w, dst_crop->h, TRUE);
+    context->pending_shm_puts++;
+
+    XFlush (context->disp);
   } else
 #endif /* HAVE_XSHM */
   {
@@ -660,8 +672,9 @@ gst_xvimage_memory_render (GstXvImageMemory * mem, GstVideoRectangle * src_crop,
         window->gc, xvimage,
         src_crop->x, src_crop->y, src_crop->w, src_crop->h,
         dst_crop->x, dst_crop->y, dst_crop->w, dst_crop->h);
+
+    XSync (context->disp, FALSE);
   }
-  XSync (context->disp, FALSE);
 
   g_mutex_unlock (&context->lock);
 }
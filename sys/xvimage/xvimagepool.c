@@ -28,6 +28,8 @@
 /* Debugging category */
 #include <gst/gstinfo.h>
 
+#include <string.h>
+
 /* Helper functions */
 #include <gst/video/video.h>
 #include <gst/video/gstvideometa.h>
@@ -190,6 +192,18 @@ xvimage_buffer_pool_alloc (GstBufferPool * pool, GstBuffer ** buffer,
         info->offset, info->stride);
   }
 
+  /* Buffers created without acquire params come from the preallocation done
+   * when the pool is activated. Fault their shm pages in now so the first
+   * frames don't pay for it while they are due on screen. */
+  if (params == NULL) {
+    GstMapInfo map;
+
+    if (gst_buffer_map (xvimage, &map, GST_MAP_WRITE)) {
+      memset (map.data, 0, map.size);
+      gst_buffer_unmap (xvimage, &map);
+    }
+  }
+
   *buffer = xvimage;
 
   return GST_FLOW_OK;
@@ -203,6 +217,17 @@ no_buffer:
   }
 }
 
+/* Returns TRUE when @pool was last configured with caps equal to @caps, so
+ * a renegotiation with identical geometry can keep using it, and the warm
+ * images it already created, instead of starting from scratch */
+gboolean
+gst_xvimage_buffer_pool_matches (GstBufferPool * pool, GstCaps * caps)
+{
+  GstXvImageBufferPool *xvpool = GST_XVIMAGE_BUFFER_POOL_CAST (pool);
+
+  return xvpool->caps != NULL && gst_caps_is_equal (xvpool->caps, caps);
+}
+
 GstBufferPool *
 gst_xvimage_buffer_pool_new (GstXvImageAllocator * allocator)
 {
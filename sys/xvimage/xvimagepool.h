@@ -61,6 +61,9 @@ GType gst_xvimage_buffer_pool_get_type (void);
 
 GstBufferPool *    gst_xvimage_buffer_pool_new     (GstXvImageAllocator *allocator);
 
+gboolean           gst_xvimage_buffer_pool_matches (GstBufferPool *pool,
+                                                    GstCaps *caps);
+
 G_END_DECLS
 
 #endif /*__GST_XVIMAGEPOOL_H__*/
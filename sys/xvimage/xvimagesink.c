@@ -561,6 +561,14 @@ gst_xv_image_sink_handle_xevents (GstXvImageSink * xvimagesink)
         break;
       }
       default:
+#ifdef HAVE_XSHM
+        /* Account for ShmCompletion events of our XvShmPutImage calls so
+         * the render code knows how many puts are still in flight */
+        if (xvimagesink->context->use_xshm &&
+            e.type == xvimagesink->context->shm_completion_type &&
+            xvimagesink->context->pending_shm_puts > 0)
+          xvimagesink->context->pending_shm_puts--;
+#endif /* HAVE_XSHM */
         break;
     }
   }
@@ -798,12 +806,20 @@ gst_xv_image_sink_setcaps (GstBaseSink * bsink, GstCaps * caps)
    * doesn't cover the same area */
   xvimagesink->redraw_border = TRUE;
 
-  /* create a new pool for the new configuration */
-  newpool = gst_xv_image_sink_create_pool (xvimagesink, caps, info.size, 2);
+  if (xvimagesink->pool != NULL &&
+      gst_xvimage_buffer_pool_matches (xvimagesink->pool, caps)) {
+    /* the geometry didn't change, keep the current pool and the warm
+     * images it has already created */
+    GST_DEBUG_OBJECT (xvimagesink,
+        "caps unchanged, keeping the current pool");
+    newpool = oldpool = NULL;
+  } else {
+    /* create a new pool for the new configuration */
+    newpool = gst_xv_image_sink_create_pool (xvimagesink, caps, info.size, 2);
 
-  /* we don't activate the internal pool yet as it may not be needed */
-  oldpool = xvimagesink->pool;
-  xvimagesink->pool = newpool;
+    oldpool = xvimagesink->pool;
+    xvimagesink->pool = newpool;
+  }
   g_mutex_unlock (&xvimagesink->flow_lock);
 
   /* deactivate and unref the old internal pool */
@@ -812,6 +828,13 @@ gst_xv_image_sink_setcaps (GstBaseSink * bsink, GstCaps * caps)
     gst_object_unref (oldpool);
   }
 
+  /* Activating the pool already preallocates and pre-warms its min_buffers
+   * images, so the first frames after (re)negotiation don't stall on shm
+   * segment creation and page faults. If upstream ends up using its own
+   * pool the images are simply kept around for the copy path. */
+  if (newpool != NULL && !gst_buffer_pool_set_active (newpool, TRUE))
+    GST_WARNING_OBJECT (xvimagesink, "failed to activate internal pool");
+
   return TRUE;
 
   /* ERRORS */
@@ -0,0 +1,132 @@
+/* GStreamer audio converter benchmark
+ * Copyright (C) 2017 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Sweeps a (source format x destination format x channel pair) matrix
+ * through gst_audio_converter_samples() and prints throughput in input
+ * samples per second, so format conversion and channel mixing
+ * regressions show up in numbers instead of in production. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <gst/audio/audio.h>
+
+#include "bench.h"
+
+#define BENCH_SECONDS 0.1
+#define BENCH_RATE 48000
+#define CHUNK_FRAMES 1024
+
+static const GstAudioFormat bench_formats[] = {
+  GST_AUDIO_FORMAT_S16,
+  GST_AUDIO_FORMAT_S32,
+  GST_AUDIO_FORMAT_F32,
+  GST_AUDIO_FORMAT_F64,
+};
+
+typedef struct
+{
+  gint in_channels, out_channels;
+} BenchChannels;
+
+static const BenchChannels bench_channels[] = {
+  {1, 2},
+  {2, 2},
+  {6, 2},
+};
+
+static void
+run_convert (GstAudioFormat in_format, GstAudioFormat out_format,
+    const BenchChannels * channels)
+{
+  GstAudioInfo in_info, out_info;
+  GstAudioConverter *convert;
+  gpointer in[1], out[1];
+  gdouble elapsed, samples;
+  gint64 start;
+  gchar *name;
+  guint chunks = 0;
+
+  gst_audio_info_set_format (&in_info, in_format, BENCH_RATE,
+      channels->in_channels, NULL);
+  gst_audio_info_set_format (&out_info, out_format, BENCH_RATE,
+      channels->out_channels, NULL);
+
+  convert = gst_audio_converter_new (GST_AUDIO_CONVERTER_FLAG_NONE,
+      &in_info, &out_info, NULL);
+  if (convert == NULL) {
+    g_print ("%-3s ch%d %-3s ch%d: not supported\n",
+        gst_audio_format_to_string (in_format), channels->in_channels,
+        gst_audio_format_to_string (out_format), channels->out_channels);
+    return;
+  }
+
+  in[0] = g_malloc0 (CHUNK_FRAMES * GST_AUDIO_INFO_BPF (&in_info));
+  out[0] = g_malloc0 (CHUNK_FRAMES * GST_AUDIO_INFO_BPF (&out_info));
+
+  start = g_get_monotonic_time ();
+  do {
+    gst_audio_converter_samples (convert, GST_AUDIO_CONVERTER_FLAG_NONE,
+        in, CHUNK_FRAMES, out, CHUNK_FRAMES);
+    chunks++;
+    elapsed = (g_get_monotonic_time () - start) / (gdouble) G_USEC_PER_SEC;
+  } while (elapsed < BENCH_SECONDS);
+
+  samples = (gdouble) chunks * CHUNK_FRAMES * channels->in_channels;
+
+  g_print ("%-3s ch%d %-3s ch%d: %10.0f samples/s %8.2f ns/sample\n",
+      gst_audio_format_to_string (in_format), channels->in_channels,
+      gst_audio_format_to_string (out_format), channels->out_channels,
+      samples / elapsed, elapsed * 1e9 / samples);
+
+  name = g_strdup_printf ("audioconvert %s ch%d %s ch%d",
+      gst_audio_format_to_string (in_format), channels->in_channels,
+      gst_audio_format_to_string (out_format), channels->out_channels);
+  bench_score (name, "samples/s", samples / elapsed);
+  g_free (name);
+
+  g_free (in[0]);
+  g_free (out[0]);
+  gst_audio_converter_free (convert);
+}
+
+int
+main (int argc, char **argv)
+{
+  guint i, j, c;
+
+  gst_init (&argc, &argv);
+  bench_begin ();
+
+  for (i = 0; i < G_N_ELEMENTS (bench_formats); i++) {
+    for (j = 0; j < G_N_ELEMENTS (bench_formats); j++) {
+      for (c = 0; c < G_N_ELEMENTS (bench_channels); c++) {
+        run_convert (bench_formats[i], bench_formats[j], &bench_channels[c]);
+      }
+    }
+  }
+
+  bench_end ();
+
+  return 0;
+}
@@ -0,0 +1,164 @@
+/* GStreamer audio resampler benchmark
+ * Copyright (C) 2017 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Sweeps a (method x quality x rate pair x channels x format) matrix
+ * through gst_audio_resampler_resample() and prints throughput in input
+ * samples per second and nanoseconds per sample, so quality settings can
+ * be picked from data and kernel regressions show up in numbers.
+ *
+ * The resampler picks the fastest inner-product kernel for the CPU it
+ * runs on. To compare SIMD variants, restrict the instruction sets Orc
+ * reports with the ORC_CODE environment variable between runs. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <gst/audio/audio.h>
+
+#include "bench.h"
+
+#define BENCH_SECONDS 0.1
+#define CHUNK_FRAMES 1024
+
+static const GstAudioFormat bench_formats[] = {
+  GST_AUDIO_FORMAT_S16,
+  GST_AUDIO_FORMAT_S32,
+  GST_AUDIO_FORMAT_F32,
+  GST_AUDIO_FORMAT_F64,
+};
+
+typedef struct
+{
+  gint in_rate, out_rate;
+} BenchRates;
+
+static const BenchRates bench_rates[] = {
+  {48000, 44100},
+  {48000, 16000},
+};
+
+static const gint bench_channels[] = { 1, 2, 6 };
+
+static const gchar *method_names[] = {
+  "nearest", "linear", "cubic", "blackman", "kaiser"
+};
+
+static void
+run_resample (GstAudioResamplerMethod method, guint quality,
+    const BenchRates * rates, gint channels, GstAudioFormat format)
+{
+  GstAudioResampler *resampler;
+  GstStructure *options;
+  const GstAudioFormatInfo *finfo;
+  gpointer in[1], out[1];
+  gsize in_frames, out_frames, consumed;
+  gdouble elapsed, samples;
+  gint64 start;
+  gint bpf;
+  gchar *name;
+  guint chunks = 0;
+
+  options = gst_structure_new_empty ("GstAudioResampler.options");
+  gst_audio_resampler_options_set_quality (method, quality,
+      rates->in_rate, rates->out_rate, options);
+
+  resampler = gst_audio_resampler_new (method, GST_AUDIO_RESAMPLER_FLAG_NONE,
+      format, channels, rates->in_rate, rates->out_rate, options);
+  gst_structure_free (options);
+  if (resampler == NULL) {
+    g_print ("%-8s q%-2u %6d->%-6d ch%d %-3s: not supported\n",
+        method_names[method], quality, rates->in_rate, rates->out_rate,
+        channels, gst_audio_format_to_string (format));
+    return;
+  }
+
+  finfo = gst_audio_format_get_info (format);
+  bpf = (GST_AUDIO_FORMAT_INFO_WIDTH (finfo) / 8) * channels;
+
+  in_frames = CHUNK_FRAMES;
+  out_frames = gst_audio_resampler_get_out_frames (resampler, in_frames);
+
+  in[0] = g_malloc0 (in_frames * bpf);
+  out[0] = g_malloc0 ((out_frames + 16) * bpf);
+
+  start = g_get_monotonic_time ();
+  do {
+    out_frames = gst_audio_resampler_get_out_frames (resampler, in_frames);
+    gst_audio_resampler_resample (resampler, in, in_frames, out, out_frames,
+        &consumed);
+    chunks++;
+    elapsed = (g_get_monotonic_time () - start) / (gdouble) G_USEC_PER_SEC;
+  } while (elapsed < BENCH_SECONDS);
+
+  samples = (gdouble) chunks * in_frames * channels;
+
+  g_print ("%-8s q%-2u %6d->%-6d ch%d %-3s: %10.0f samples/s %8.2f ns/sample\n",
+      method_names[method], quality, rates->in_rate, rates->out_rate,
+      channels, gst_audio_format_to_string (format), samples / elapsed,
+      elapsed * 1e9 / samples);
+
+  name = g_strdup_printf ("resample %s q%u %d-%d ch%d %s",
+      method_names[method], quality, rates->in_rate, rates->out_rate,
+      channels, gst_audio_format_to_string (format));
+  bench_score (name, "samples/s", samples / elapsed);
+  g_free (name);
+
+  g_free (in[0]);
+  g_free (out[0]);
+  gst_audio_resampler_free (resampler);
+}
+
+int
+main (int argc, char **argv)
+{
+  GstAudioResamplerMethod method;
+  guint quality, r, c, f;
+
+  gst_init (&argc, &argv);
+  bench_begin ();
+
+  for (method = GST_AUDIO_RESAMPLER_METHOD_NEAREST;
+      method <= GST_AUDIO_RESAMPLER_METHOD_KAISER; method++) {
+    gboolean sinc = method == GST_AUDIO_RESAMPLER_METHOD_BLACKMAN_NUTTALL ||
+        method == GST_AUDIO_RESAMPLER_METHOD_KAISER;
+
+    /* quality only changes the filter length of the sinc based methods,
+     * one run is representative for the others */
+    for (quality = sinc ? 0 : GST_AUDIO_RESAMPLER_QUALITY_DEFAULT;
+        quality <= (sinc ? GST_AUDIO_RESAMPLER_QUALITY_MAX :
+            GST_AUDIO_RESAMPLER_QUALITY_DEFAULT); quality++) {
+      for (r = 0; r < G_N_ELEMENTS (bench_rates); r++) {
+        for (c = 0; c < G_N_ELEMENTS (bench_channels); c++) {
+          for (f = 0; f < G_N_ELEMENTS (bench_formats); f++) {
+            run_resample (method, quality, &bench_rates[r],
+                bench_channels[c], bench_formats[f]);
+          }
+        }
+      }
+    }
+  }
+
+  bench_end ();
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+/* GStreamer benchmark helpers
+ * Copyright (C) 2017 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_BENCH_H__
+#define __GST_BENCH_H__
+
+/* Shared by the benchmarks in this directory: collects named scores and
+ * writes them as machine readable JSON so that runs can be compared with
+ * compare-benchmarks.py. Call bench_begin() after gst_init(), record one
+ * bench_score() per measured combination and finish with bench_end().
+ *
+ * The JSON file is only written when the BENCH_JSON environment variable
+ * holds an output path; without it the helpers do nothing and only the
+ * human readable output of the benchmark remains. */
+
+#include <stdlib.h>
+
+#include <gst/gst.h>
+
+static GString *bench_json;
+static gchar *bench_json_path;
+static guint bench_n_scores;
+
+static void
+bench_begin (void)
+{
+  const gchar *path = g_getenv ("BENCH_JSON");
+
+  if (path == NULL)
+    return;
+
+  bench_json_path = g_strdup (path);
+  bench_json = g_string_new ("{\n  \"results\": [");
+}
+
+/* records one result. @name must be stable across runs and unique within
+ * the benchmark, higher values must mean better. */
+static void
+bench_score (const gchar * name, const gchar * unit, gdouble value)
+{
+  gchar buf[G_ASCII_DTOSTR_BUF_SIZE];
+
+  if (bench_json == NULL)
+    return;
+
+  g_string_append_printf (bench_json,
+      "%s\n    { \"name\": \"%s\", \"unit\": \"%s\", \"value\": %s }",
+      bench_n_scores == 0 ? "" : ",", name, unit,
+      g_ascii_dtostr (buf, sizeof (buf), value));
+  bench_n_scores++;
+}
+
+static void
+bench_end (void)
+{
+  GError *error = NULL;
+
+  if (bench_json == NULL)
+    return;
+
+  g_string_append (bench_json, "\n  ]\n}\n");
+  if (!g_file_set_contents (bench_json_path, bench_json->str, -1, &error)) {
+    g_printerr ("Failed to write %s: %s\n", bench_json_path, error->message);
+    g_clear_error (&error);
+    exit (1);
+  }
+  g_print ("wrote %u results to %s\n", bench_n_scores, bench_json_path);
+
+  g_string_free (bench_json, TRUE);
+  bench_json = NULL;
+  g_free (bench_json_path);
+  bench_json_path = NULL;
+}
+
+#endif /* __GST_BENCH_H__ */
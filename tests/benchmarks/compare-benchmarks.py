@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+# GStreamer benchmark comparison tool
+#
+# Compares the JSON output of the benchmarks in this directory (written
+# when the BENCH_JSON environment variable holds an output path) against
+# a stored baseline and fails when any result regressed by more than the
+# allowed threshold, so throughput is gated the way correctness already
+# is by the unit tests.
+#
+# Typical use:
+#   BENCH_JSON=baseline.json ./audio-convert     # on the reference build
+#   BENCH_JSON=current.json ./audio-convert      # on the new build
+#   ./compare-benchmarks.py baseline.json current.json
+#
+# All recorded values are throughput style scores where higher is
+# better. Results that only exist on one side are reported but do not
+# fail the comparison.
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return {r['name']: r for r in data['results']}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compare benchmark results against a baseline')
+    parser.add_argument('baseline', help='baseline JSON file')
+    parser.add_argument('current', help='JSON file of the run to check')
+    parser.add_argument('--threshold', type=float, default=10.0, metavar='PCT',
+                        help='maximum allowed regression in percent '
+                             '(default: %(default)s)')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = []
+    for name in sorted(baseline):
+        if name not in current:
+            print('MISSING    %s (in baseline only)' % name)
+            continue
+        old = baseline[name]['value']
+        new = current[name]['value']
+        if old <= 0:
+            continue
+        delta = (new - old) * 100.0 / old
+        if delta < -args.threshold:
+            regressions.append((name, old, new, delta))
+            state = 'REGRESSION'
+        elif delta > args.threshold:
+            state = 'IMPROVED  '
+        else:
+            state = 'ok        '
+        print('%s %s: %.0f -> %.0f %s (%+.1f%%)'
+              % (state, name, old, new, baseline[name]['unit'], delta))
+
+    for name in sorted(current):
+        if name not in baseline:
+            print('NEW        %s (not in baseline)' % name)
+
+    if regressions:
+        print('\n%d result(s) regressed more than %.1f%%'
+              % (len(regressions), args.threshold))
+        return 1
+
+    print('\nno regressions above %.1f%%' % args.threshold)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,313 @@
+/* GStreamer playback startup latency benchmark
+ * Copyright (C) 2017 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Cycles playbin and playbin3 through NULL->PAUSED->PLAYING->NULL over a
+ * corpus of local assets and reports the latency distribution of each
+ * phase, plus the process fd and memory high-water marks, so startup and
+ * teardown regressions in the playback stack show up in numbers.
+ *
+ * By default a small audio-only and an audio+video Ogg asset are encoded
+ * into the temporary directory with elements from this module, so the
+ * benchmark is self-contained. Additional files can be put under the
+ * directory named by the BENCH_ASSET_DIR environment variable and are
+ * benchmarked as well. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <gst/gst.h>
+
+#include "bench.h"
+
+#define BENCH_CYCLES 20
+/* an iteration that does not reach PAUSED within this time is a failure */
+#define BENCH_PHASE_TIMEOUT (10 * GST_SECOND)
+
+static const gchar *factories[] = { "playbin", "playbin3" };
+
+typedef struct
+{
+  gdouble to_paused[BENCH_CYCLES];
+  gdouble to_playing[BENCH_CYCLES];
+  gdouble to_null[BENCH_CYCLES];
+  guint n;
+} CycleStats;
+
+static gint
+compare_double (gconstpointer a, gconstpointer b)
+{
+  gdouble da = *(const gdouble *) a, db = *(const gdouble *) b;
+
+  return (da > db) - (da < db);
+}
+
+static gdouble
+percentile (gdouble * values, guint n, gdouble p)
+{
+  guint idx;
+
+  if (n == 0)
+    return 0.0;
+  idx = (guint) (p * (n - 1) / 100.0 + 0.5);
+  return values[idx];
+}
+
+/* encodes a short asset with the given launch description, returns the
+ * file path or NULL when the needed elements are not available */
+static gchar *
+generate_asset (const gchar * name, const gchar * description)
+{
+  GstElement *pipeline;
+  GstBus *bus;
+  GstMessage *msg;
+  gchar *path, *launch;
+  GError *error = NULL;
+
+  path = g_build_filename (g_get_tmp_dir (), name, NULL);
+  launch = g_strdup_printf ("%s ! filesink location=\"%s\"", description,
+      path);
+  pipeline = gst_parse_launch (launch, &error);
+  g_free (launch);
+  if (pipeline == NULL) {
+    g_printerr ("could not generate %s: %s\n", name, error->message);
+    g_clear_error (&error);
+    g_free (path);
+    return NULL;
+  }
+  g_clear_error (&error);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, BENCH_PHASE_TIMEOUT,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  if (msg == NULL || GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR) {
+    g_printerr ("could not generate %s\n", name);
+    g_free (path);
+    path = NULL;
+  }
+  if (msg)
+    gst_message_unref (msg);
+  gst_object_unref (bus);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return path;
+}
+
+static gboolean
+wait_for_state (GstElement * pipeline, GstState state)
+{
+  GstStateChangeReturn sret;
+
+  sret = gst_element_set_state (pipeline, state);
+  if (sret == GST_STATE_CHANGE_FAILURE)
+    return FALSE;
+  sret = gst_element_get_state (pipeline, NULL, NULL, BENCH_PHASE_TIMEOUT);
+
+  return sret != GST_STATE_CHANGE_FAILURE && sret != GST_STATE_CHANGE_ASYNC;
+}
+
+static gboolean
+run_cycle (const gchar * factory, const gchar * uri, CycleStats * stats)
+{
+  GstElement *pipeline, *audio_sink, *video_sink;
+  gint64 t0, t1, t2, t3;
+  gboolean ok;
+
+  pipeline = gst_element_factory_make (factory, NULL);
+  if (pipeline == NULL)
+    return FALSE;
+
+  /* render to fakesinks so no output device is needed; keep sync enabled
+   * to exercise the same preroll paths as a real sink */
+  audio_sink = gst_element_factory_make ("fakesink", NULL);
+  video_sink = gst_element_factory_make ("fakesink", NULL);
+  g_object_set (audio_sink, "sync", TRUE, NULL);
+  g_object_set (video_sink, "sync", TRUE, NULL);
+  g_object_set (pipeline, "uri", uri, "audio-sink", audio_sink,
+      "video-sink", video_sink, NULL);
+
+  t0 = g_get_monotonic_time ();
+  ok = wait_for_state (pipeline, GST_STATE_PAUSED);
+  t1 = g_get_monotonic_time ();
+  if (ok)
+    ok = wait_for_state (pipeline, GST_STATE_PLAYING);
+  t2 = g_get_monotonic_time ();
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  t3 = g_get_monotonic_time ();
+  gst_object_unref (pipeline);
+
+  if (!ok)
+    return FALSE;
+
+  stats->to_paused[stats->n] = (t1 - t0) / 1000.0;
+  stats->to_playing[stats->n] = (t2 - t1) / 1000.0;
+  stats->to_null[stats->n] = (t3 - t2) / 1000.0;
+  stats->n++;
+
+  return TRUE;
+}
+
+/* reports one latency distribution; the recorded scores are cycles per
+ * second so that higher stays better for compare-benchmarks.py */
+static void
+report_phase (const gchar * factory, const gchar * asset, const gchar * phase,
+    gdouble * values, guint n)
+{
+  static const gdouble percentiles[] = { 50.0, 90.0, 99.0 };
+  guint i;
+
+  qsort (values, n, sizeof (gdouble), compare_double);
+
+  g_print ("%-8s %-16s %-10s:", factory, asset, phase);
+  for (i = 0; i < G_N_ELEMENTS (percentiles); i++) {
+    gdouble ms = percentile (values, n, percentiles[i]);
+    gchar *name;
+
+    g_print (" p%.0f %8.2f ms", percentiles[i], ms);
+    name = g_strdup_printf ("startup %s %s %s p%.0f", factory, asset, phase,
+        percentiles[i]);
+    bench_score (name, "cycles/s", ms > 0.0 ? 1000.0 / ms : 0.0);
+    g_free (name);
+  }
+  g_print ("\n");
+}
+
+/* fd count and VmHWM of the process, 0 when not available */
+static void
+read_resource_marks (guint * n_fds, guint * hwm_kb)
+{
+  GDir *dir;
+  gchar *status = NULL;
+
+  *n_fds = 0;
+  *hwm_kb = 0;
+
+  if ((dir = g_dir_open ("/proc/self/fd", 0, NULL))) {
+    while (g_dir_read_name (dir))
+      (*n_fds)++;
+    g_dir_close (dir);
+  }
+
+  if (g_file_get_contents ("/proc/self/status", &status, NULL, NULL)) {
+    gchar *line = strstr (status, "VmHWM:");
+
+    if (line)
+      *hwm_kb = (guint) strtoul (line + strlen ("VmHWM:"), NULL, 10);
+    g_free (status);
+  }
+}
+
+static void
+run_asset (const gchar * path)
+{
+  gchar *uri, *asset;
+  guint f, i;
+
+  uri = gst_filename_to_uri (path, NULL);
+  if (uri == NULL)
+    return;
+  asset = g_path_get_basename (path);
+
+  for (f = 0; f < G_N_ELEMENTS (factories); f++) {
+    CycleStats stats = { {0,}, {0,}, {0,}, 0 };
+
+    if (gst_element_factory_find (factories[f]) == NULL) {
+      g_print ("%-8s %-16s: not available\n", factories[f], asset);
+      continue;
+    }
+
+    for (i = 0; i < BENCH_CYCLES; i++) {
+      if (!run_cycle (factories[f], uri, &stats)) {
+        g_print ("%-8s %-16s: cycle failed\n", factories[f], asset);
+        break;
+      }
+    }
+    if (stats.n == 0)
+      continue;
+
+    report_phase (factories[f], asset, "to-paused", stats.to_paused, stats.n);
+    report_phase (factories[f], asset, "to-playing", stats.to_playing,
+        stats.n);
+    report_phase (factories[f], asset, "to-null", stats.to_null, stats.n);
+  }
+
+  g_free (asset);
+  g_free (uri);
+}
+
+int
+main (int argc, char **argv)
+{
+  const gchar *asset_dir;
+  GList *assets = NULL, *l;
+  guint n_fds, hwm_kb;
+  gchar *path;
+
+  gst_init (&argc, &argv);
+  bench_begin ();
+
+  /* self-contained corpus encoded with elements from this module */
+  path = generate_asset ("bench-startup-audio.ogg",
+      "audiotestsrc num-buffers=100 ! audioconvert ! vorbisenc ! oggmux");
+  if (path)
+    assets = g_list_append (assets, path);
+  path = generate_asset ("bench-startup-av.ogg",
+      "videotestsrc num-buffers=50 ! theoraenc ! oggmux name=mux "
+      "audiotestsrc num-buffers=100 ! audioconvert ! vorbisenc ! mux.");
+  if (path)
+    assets = g_list_append (assets, path);
+
+  /* plus whatever the user put into BENCH_ASSET_DIR */
+  if ((asset_dir = g_getenv ("BENCH_ASSET_DIR"))) {
+    GDir *dir = g_dir_open (asset_dir, 0, NULL);
+    const gchar *name;
+
+    if (dir) {
+      while ((name = g_dir_read_name (dir)))
+        assets = g_list_append (assets,
+            g_build_filename (asset_dir, name, NULL));
+      g_dir_close (dir);
+    }
+  }
+
+  for (l = assets; l; l = l->next)
+    run_asset (l->data);
+
+  /* resource high-water marks over the whole run; recorded inverted so
+   * that higher stays better for the comparison gate */
+  read_resource_marks (&n_fds, &hwm_kb);
+  if (n_fds > 0) {
+    g_print ("open fds: %u\n", n_fds);
+    bench_score ("startup fd high-water", "1/fds", 1.0 / n_fds);
+  }
+  if (hwm_kb > 0) {
+    g_print ("memory high-water: %u kB\n", hwm_kb);
+    bench_score ("startup rss high-water", "1/MB", 1024.0 / hwm_kb);
+  }
+
+  g_list_free_full (assets, g_free);
+  bench_end ();
+
+  return 0;
+}
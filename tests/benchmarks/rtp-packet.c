@@ -0,0 +1,483 @@
+/* GStreamer RTP packet-rate benchmark
+ * Copyright (C) 2017 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Drives the rtp library through synthetic packet runs at several MTUs
+ * and reports packets per second, nanoseconds per packet and GstMemory
+ * allocations per packet for three paths: packet allocation and header
+ * writing, payloading through GstRTPBasePayload and depayloading through
+ * GstRTPBaseDepayload. The packet count can be overridden with the first
+ * command line argument, the default is one million packets per run. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <gst/gst.h>
+#include <gst/rtp/gstrtpbuffer.h>
+#include <gst/rtp/gstrtpbasepayload.h>
+#include <gst/rtp/gstrtpbasedepayload.h>
+
+#include "bench.h"
+
+#define DEFAULT_PACKETS 1000000
+#define BENCH_CLOCK_RATE 90000
+
+static const guint bench_mtus[] = { 512, 1400, 9000 };
+
+/* counting allocator, installed as the default so every GstMemory
+ * allocation during a run is visible as allocations per packet */
+
+typedef struct
+{
+  GstAllocator parent;
+} BenchAllocator;
+
+typedef struct
+{
+  GstAllocatorClass parent_class;
+} BenchAllocatorClass;
+
+static guint64 bench_alloc_count;
+static GstAllocator *bench_sysmem;
+
+static GType bench_allocator_get_type (void);
+G_DEFINE_TYPE (BenchAllocator, bench_allocator, GST_TYPE_ALLOCATOR);
+
+static GstMemory *
+bench_allocator_alloc (GstAllocator * allocator, gsize size,
+    GstAllocationParams * params)
+{
+  bench_alloc_count++;
+  /* the returned memory belongs to the sysmem allocator, mapping and
+   * freeing never come back to this proxy */
+  return gst_allocator_alloc (bench_sysmem, size, params);
+}
+
+static void
+bench_allocator_free (GstAllocator * allocator, GstMemory * memory)
+{
+  /* never reached, the memory is owned by the sysmem allocator */
+}
+
+static void
+bench_allocator_class_init (BenchAllocatorClass * klass)
+{
+  GstAllocatorClass *allocator_class = GST_ALLOCATOR_CLASS (klass);
+
+  allocator_class->alloc = bench_allocator_alloc;
+  allocator_class->free = bench_allocator_free;
+}
+
+static void
+bench_allocator_init (BenchAllocator * allocator)
+{
+  GST_ALLOCATOR (allocator)->mem_type = "BenchProxy";
+}
+
+static void
+report (const gchar * name, guint mtu, guint packets, gdouble elapsed,
+    guint64 allocs)
+{
+  gchar *score_name;
+
+  g_print ("%-14s mtu %5u: %8.0f packets/sec, %7.1f ns/packet, "
+      "%.2f allocs/packet\n", name, mtu,
+      packets / elapsed, elapsed * 1e9 / packets,
+      (gdouble) allocs / packets);
+
+  score_name = g_strdup_printf ("rtp %s mtu%u", name, mtu);
+  bench_score (score_name, "packets/s", packets / elapsed);
+  g_free (score_name);
+}
+
+/* allocation, header writing and mapping of standalone packets */
+static void
+run_buffer_bench (guint mtu, guint packets)
+{
+  guint payload_len = gst_rtp_buffer_calc_payload_len (mtu, 0, 0);
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  GstBuffer *buf;
+  guint64 allocs;
+  gint64 start;
+  guint i;
+
+  allocs = bench_alloc_count;
+  start = g_get_monotonic_time ();
+
+  for (i = 0; i < packets; i++) {
+    buf = gst_rtp_buffer_new_allocate (payload_len, 0, 0);
+    gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtp);
+    gst_rtp_buffer_set_payload_type (&rtp, 96);
+    gst_rtp_buffer_set_seq (&rtp, i);
+    gst_rtp_buffer_set_timestamp (&rtp, i * 3000);
+    gst_rtp_buffer_set_ssrc (&rtp, 0xdeadbeef);
+    gst_rtp_buffer_unmap (&rtp);
+    gst_buffer_unref (buf);
+  }
+
+  report ("alloc+map", mtu, packets,
+      (g_get_monotonic_time () - start) / 1e6, bench_alloc_count - allocs);
+}
+
+/* minimal payloader that chunks its input into MTU sized packets */
+
+typedef struct
+{
+  GstRTPBasePayload payload;
+} BenchPay;
+
+typedef struct
+{
+  GstRTPBasePayloadClass parent_class;
+} BenchPayClass;
+
+static GType bench_pay_get_type (void);
+G_DEFINE_TYPE (BenchPay, bench_pay, GST_TYPE_RTP_BASE_PAYLOAD);
+
+static GstStaticPadTemplate bench_pay_sink_template =
+GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS_ANY);
+
+static GstStaticPadTemplate bench_pay_src_template =
+GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("application/x-rtp"));
+
+static GstFlowReturn
+bench_pay_handle_buffer (GstRTPBasePayload * payload, GstBuffer * buffer)
+{
+  guint max_payload =
+      gst_rtp_buffer_calc_payload_len (GST_RTP_BASE_PAYLOAD_MTU (payload),
+      0, 0);
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstMapInfo map;
+  gsize offset = 0;
+
+  if (!gst_pad_has_current_caps (GST_RTP_BASE_PAYLOAD_SRCPAD (payload))) {
+    if (!gst_rtp_base_payload_set_outcaps (payload, NULL)) {
+      gst_buffer_unref (buffer);
+      return GST_FLOW_NOT_NEGOTIATED;
+    }
+  }
+
+  gst_buffer_map (buffer, &map, GST_MAP_READ);
+  while (offset < map.size && ret == GST_FLOW_OK) {
+    guint towrite = MIN (max_payload, map.size - offset);
+    GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+    GstBuffer *outbuf;
+
+    outbuf = gst_rtp_buffer_new_allocate (towrite, 0, 0);
+    gst_rtp_buffer_map (outbuf, GST_MAP_WRITE, &rtp);
+    memcpy (gst_rtp_buffer_get_payload (&rtp), map.data + offset, towrite);
+    gst_rtp_buffer_unmap (&rtp);
+
+    GST_BUFFER_PTS (outbuf) = GST_BUFFER_PTS (buffer);
+    offset += towrite;
+
+    ret = gst_rtp_base_payload_push (payload, outbuf);
+  }
+  gst_buffer_unmap (buffer, &map);
+  gst_buffer_unref (buffer);
+
+  return ret;
+}
+
+static void
+bench_pay_class_init (BenchPayClass * klass)
+{
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstRTPBasePayloadClass *payload_class = GST_RTP_BASE_PAYLOAD_CLASS (klass);
+
+  gst_element_class_add_static_pad_template (element_class,
+      &bench_pay_sink_template);
+  gst_element_class_add_static_pad_template (element_class,
+      &bench_pay_src_template);
+
+  payload_class->handle_buffer = bench_pay_handle_buffer;
+}
+
+static void
+bench_pay_init (BenchPay * pay)
+{
+  gst_rtp_base_payload_set_options (GST_RTP_BASE_PAYLOAD (pay), "application",
+      TRUE, "X-BENCH", BENCH_CLOCK_RATE);
+}
+
+/* minimal depayloader that extracts the payload */
+
+typedef struct
+{
+  GstRTPBaseDepayload depayload;
+} BenchDepay;
+
+typedef struct
+{
+  GstRTPBaseDepayloadClass parent_class;
+} BenchDepayClass;
+
+static GType bench_depay_get_type (void);
+G_DEFINE_TYPE (BenchDepay, bench_depay, GST_TYPE_RTP_BASE_DEPAYLOAD);
+
+static GstStaticPadTemplate bench_depay_sink_template =
+GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("application/x-rtp"));
+
+static GstStaticPadTemplate bench_depay_src_template =
+GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS_ANY);
+
+static GstBuffer *
+bench_depay_process_rtp_packet (GstRTPBaseDepayload * depayload,
+    GstRTPBuffer * rtp)
+{
+  return gst_rtp_buffer_get_payload_buffer (rtp);
+}
+
+static void
+bench_depay_class_init (BenchDepayClass * klass)
+{
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstRTPBaseDepayloadClass *depayload_class =
+      GST_RTP_BASE_DEPAYLOAD_CLASS (klass);
+
+  gst_element_class_add_static_pad_template (element_class,
+      &bench_depay_sink_template);
+  gst_element_class_add_static_pad_template (element_class,
+      &bench_depay_src_template);
+
+  depayload_class->process_rtp_packet = bench_depay_process_rtp_packet;
+}
+
+static void
+bench_depay_init (BenchDepay * depay)
+{
+}
+
+/* manual source and sink pads around one element */
+
+static guint64 out_packets;
+
+static GstFlowReturn
+bench_sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  out_packets++;
+  gst_buffer_unref (buffer);
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+bench_sink_chain_list (GstPad * pad, GstObject * parent, GstBufferList * list)
+{
+  out_packets += gst_buffer_list_length (list);
+  gst_buffer_list_unref (list);
+  return GST_FLOW_OK;
+}
+
+static gboolean
+bench_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
+{
+  gst_event_unref (event);
+  return TRUE;
+}
+
+typedef struct
+{
+  GstElement *elem;
+  GstPad *srcpad;
+  GstPad *sinkpad;
+} BenchPipe;
+
+static void
+bench_pipe_setup (BenchPipe * pipe, GstElement * elem, GstCaps * caps)
+{
+  GstSegment segment;
+  GstPad *pad;
+
+  pipe->elem = elem;
+  gst_element_set_state (elem, GST_STATE_PLAYING);
+
+  pipe->srcpad = gst_pad_new ("src", GST_PAD_SRC);
+  pad = gst_element_get_static_pad (elem, "sink");
+  gst_pad_link (pipe->srcpad, pad);
+  gst_object_unref (pad);
+
+  pipe->sinkpad = gst_pad_new ("sink", GST_PAD_SINK);
+  gst_pad_set_chain_function (pipe->sinkpad, bench_sink_chain);
+  gst_pad_set_chain_list_function (pipe->sinkpad, bench_sink_chain_list);
+  gst_pad_set_event_function (pipe->sinkpad, bench_sink_event);
+  pad = gst_element_get_static_pad (elem, "src");
+  gst_pad_link (pad, pipe->sinkpad);
+  gst_object_unref (pad);
+
+  gst_pad_set_active (pipe->srcpad, TRUE);
+  gst_pad_set_active (pipe->sinkpad, TRUE);
+
+  gst_pad_push_event (pipe->srcpad, gst_event_new_stream_start ("bench"));
+  gst_pad_push_event (pipe->srcpad, gst_event_new_caps (caps));
+  gst_caps_unref (caps);
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  gst_pad_push_event (pipe->srcpad, gst_event_new_segment (&segment));
+}
+
+static void
+bench_pipe_teardown (BenchPipe * pipe)
+{
+  gst_element_set_state (pipe->elem, GST_STATE_NULL);
+  gst_object_unref (pipe->srcpad);
+  gst_object_unref (pipe->sinkpad);
+  gst_object_unref (pipe->elem);
+}
+
+/* payload path: input buffers are chunked into MTU sized packets and
+ * pushed through the base class */
+static void
+run_payload_bench (guint mtu, guint packets)
+{
+  BenchPipe pipe;
+  GstElement *pay;
+  guint payload_len = gst_rtp_buffer_calc_payload_len (mtu, 0, 0);
+  guint packets_per_buffer = 8;
+  guint64 allocs;
+  gint64 start;
+  guint i, buffers;
+
+  pay = g_object_new (bench_pay_get_type (), NULL);
+  g_object_set (pay, "mtu", mtu, NULL);
+  bench_pipe_setup (&pipe, pay,
+      gst_caps_new_empty_simple ("application/x-bench"));
+
+  buffers = packets / packets_per_buffer;
+  out_packets = 0;
+  allocs = bench_alloc_count;
+  start = g_get_monotonic_time ();
+
+  for (i = 0; i < buffers; i++) {
+    GstBuffer *buf;
+
+    buf = gst_buffer_new_allocate (NULL, payload_len * packets_per_buffer,
+        NULL);
+    GST_BUFFER_PTS (buf) = gst_util_uint64_scale (i, GST_SECOND, 100);
+    if (gst_pad_push (pipe.srcpad, buf) != GST_FLOW_OK)
+      break;
+  }
+
+  report ("payload", mtu, out_packets,
+      (g_get_monotonic_time () - start) / 1e6, bench_alloc_count - allocs);
+
+  bench_pipe_teardown (&pipe);
+}
+
+/* depayload path: prebuilt packets with increasing seqnums are pushed
+ * through the base class */
+static void
+run_depayload_bench (guint mtu, guint packets)
+{
+  BenchPipe pipe;
+  GstElement *depay;
+  guint payload_len = gst_rtp_buffer_calc_payload_len (mtu, 0, 0);
+  GstBuffer *templates[G_MAXUINT16 + 1];
+  guint n_templates = G_N_ELEMENTS (templates);
+  guint64 allocs;
+  gint64 start;
+  guint i;
+
+  depay = g_object_new (bench_depay_get_type (), NULL);
+  bench_pipe_setup (&pipe, depay,
+      gst_caps_new_simple ("application/x-rtp",
+          "clock-rate", G_TYPE_INT, BENCH_CLOCK_RATE, NULL));
+
+  /* one packet per possible seqnum so the stream stays continuous when
+   * the templates are reused in a cycle */
+  for (i = 0; i < n_templates; i++) {
+    GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+    GstBuffer *buf;
+
+    buf = gst_rtp_buffer_new_allocate (payload_len, 0, 0);
+    gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtp);
+    gst_rtp_buffer_set_payload_type (&rtp, 96);
+    gst_rtp_buffer_set_seq (&rtp, i);
+    gst_rtp_buffer_set_timestamp (&rtp, i * 3000);
+    gst_rtp_buffer_set_ssrc (&rtp, 0xdeadbeef);
+    gst_rtp_buffer_unmap (&rtp);
+    GST_BUFFER_PTS (buf) = gst_util_uint64_scale (i, GST_SECOND, 100);
+    templates[i] = buf;
+  }
+
+  out_packets = 0;
+  allocs = bench_alloc_count;
+  start = g_get_monotonic_time ();
+
+  for (i = 0; i < packets; i++) {
+    GstBuffer *buf = gst_buffer_ref (templates[i % n_templates]);
+
+    if (gst_pad_push (pipe.srcpad, buf) != GST_FLOW_OK)
+      break;
+  }
+
+  report ("depayload", mtu, out_packets,
+      (g_get_monotonic_time () - start) / 1e6, bench_alloc_count - allocs);
+
+  for (i = 0; i < n_templates; i++)
+    gst_buffer_unref (templates[i]);
+  bench_pipe_teardown (&pipe);
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  GstAllocator *proxy;
+  guint packets = DEFAULT_PACKETS;
+  guint i;
+
+  gst_init (&argc, &argv);
+  bench_begin ();
+
+  if (argc > 1)
+    packets = MAX (1, atoi (argv[1]));
+
+  /* route default allocations through the counting proxy */
+  bench_sysmem = gst_allocator_find (NULL);
+  proxy = g_object_new (bench_allocator_get_type (), NULL);
+  gst_allocator_set_default (proxy);
+
+  g_print ("%u packets per run\n", packets);
+
+  for (i = 0; i < G_N_ELEMENTS (bench_mtus); i++)
+    run_buffer_bench (bench_mtus[i], packets);
+  for (i = 0; i < G_N_ELEMENTS (bench_mtus); i++)
+    run_payload_bench (bench_mtus[i], packets);
+  for (i = 0; i < G_N_ELEMENTS (bench_mtus); i++)
+    run_depayload_bench (bench_mtus[i], packets);
+
+  gst_object_unref (bench_sysmem);
+
+  bench_end ();
+
+  return 0;
+}
@@ -0,0 +1,216 @@
+/* GStreamer video converter/scaler benchmark
+ * Copyright (C) 2017 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Sweeps a (source format x destination format x size x threads) matrix
+ * through gst_video_converter_frame() and a set of scaling cases through
+ * gst_video_scaler_2d(), printing throughput per combination so that
+ * conversion performance regressions show up in numbers instead of in
+ * production. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <gst/video/video.h>
+
+#include "bench.h"
+
+#define BENCH_SECONDS 0.5
+
+static const GstVideoFormat bench_formats[] = {
+  GST_VIDEO_FORMAT_I420,
+  GST_VIDEO_FORMAT_NV12,
+  GST_VIDEO_FORMAT_YUY2,
+  GST_VIDEO_FORMAT_BGRA,
+  GST_VIDEO_FORMAT_AYUV64,
+};
+
+typedef struct
+{
+  gint width, height;
+} BenchSize;
+
+static const BenchSize bench_sizes[] = {
+  {640, 360},
+  {1920, 1080},
+  {3840, 2160},
+};
+
+static const guint bench_threads[] = { 1, 2, 4 };
+
+static void
+make_frame (GstVideoInfo * info, GstVideoFrame * frame, GstBuffer ** buffer)
+{
+  *buffer = gst_buffer_new_allocate (NULL, GST_VIDEO_INFO_SIZE (info), NULL);
+  gst_buffer_memset (*buffer, 0, 0x80, GST_VIDEO_INFO_SIZE (info));
+  gst_video_frame_map (frame, info, *buffer, GST_MAP_READWRITE);
+}
+
+static void
+run_convert (GstVideoFormat in_format, GstVideoFormat out_format,
+    const BenchSize * size, guint n_threads)
+{
+  GstVideoInfo in_info, out_info;
+  GstVideoConverter *convert;
+  GstVideoFrame in_frame, out_frame;
+  GstBuffer *in_buffer, *out_buffer;
+  gdouble elapsed, mbsec;
+  gint64 start;
+  gchar *name;
+  guint frames = 0;
+
+  gst_video_info_set_format (&in_info, in_format, size->width, size->height);
+  gst_video_info_set_format (&out_info, out_format, size->width,
+      size->height);
+
+  convert = gst_video_converter_new (&in_info, &out_info,
+      gst_structure_new ("GstVideoConverter",
+          GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, n_threads, NULL));
+  if (convert == NULL) {
+    g_print ("%-8s %-8s %4dx%-4d t%u: not supported\n",
+        gst_video_format_to_string (in_format),
+        gst_video_format_to_string (out_format), size->width, size->height,
+        n_threads);
+    return;
+  }
+
+  make_frame (&in_info, &in_frame, &in_buffer);
+  make_frame (&out_info, &out_frame, &out_buffer);
+
+  start = g_get_monotonic_time ();
+  do {
+    gst_video_converter_frame (convert, &in_frame, &out_frame);
+    frames++;
+    elapsed = (g_get_monotonic_time () - start) / (gdouble) G_USEC_PER_SEC;
+  } while (elapsed < BENCH_SECONDS);
+
+  mbsec = (GST_VIDEO_INFO_SIZE (&in_info) +
+      GST_VIDEO_INFO_SIZE (&out_info)) * frames / elapsed / (1024.0 * 1024.0);
+
+  g_print ("%-8s %-8s %4dx%-4d t%u: %8.1f fps %9.1f MB/s\n",
+      gst_video_format_to_string (in_format),
+      gst_video_format_to_string (out_format), size->width, size->height,
+      n_threads, frames / elapsed, mbsec);
+
+  name = g_strdup_printf ("convert %s %s %dx%d t%u",
+      gst_video_format_to_string (in_format),
+      gst_video_format_to_string (out_format), size->width, size->height,
+      n_threads);
+  bench_score (name, "fps", frames / elapsed);
+  g_free (name);
+
+  gst_video_frame_unmap (&in_frame);
+  gst_video_frame_unmap (&out_frame);
+  gst_buffer_unref (in_buffer);
+  gst_buffer_unref (out_buffer);
+  gst_video_converter_free (convert);
+}
+
+static void
+run_scale (GstVideoFormat format, const BenchSize * in_size,
+    const BenchSize * out_size)
+{
+  GstVideoInfo in_info, out_info;
+  GstVideoScaler *hscale, *vscale;
+  GstVideoFrame in_frame, out_frame;
+  GstBuffer *in_buffer, *out_buffer;
+  gdouble elapsed, mbsec;
+  gint64 start;
+  gchar *name;
+  guint frames = 0;
+
+  gst_video_info_set_format (&in_info, format, in_size->width,
+      in_size->height);
+  gst_video_info_set_format (&out_info, format, out_size->width,
+      out_size->height);
+
+  hscale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_CUBIC,
+      GST_VIDEO_SCALER_FLAG_NONE, 4, in_size->width, out_size->width, NULL);
+  vscale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_CUBIC,
+      GST_VIDEO_SCALER_FLAG_NONE, 4, in_size->height, out_size->height, NULL);
+
+  make_frame (&in_info, &in_frame, &in_buffer);
+  make_frame (&out_info, &out_frame, &out_buffer);
+
+  start = g_get_monotonic_time ();
+  do {
+    gst_video_scaler_2d (hscale, vscale, format,
+        GST_VIDEO_FRAME_PLANE_DATA (&in_frame, 0),
+        GST_VIDEO_FRAME_PLANE_STRIDE (&in_frame, 0),
+        GST_VIDEO_FRAME_PLANE_DATA (&out_frame, 0),
+        GST_VIDEO_FRAME_PLANE_STRIDE (&out_frame, 0),
+        0, 0, out_size->width, out_size->height);
+    frames++;
+    elapsed = (g_get_monotonic_time () - start) / (gdouble) G_USEC_PER_SEC;
+  } while (elapsed < BENCH_SECONDS);
+
+  mbsec = (GST_VIDEO_INFO_SIZE (&in_info) +
+      GST_VIDEO_INFO_SIZE (&out_info)) * frames / elapsed / (1024.0 * 1024.0);
+
+  g_print ("scale %-8s %4dx%-4d -> %4dx%-4d: %8.1f fps %9.1f MB/s\n",
+      gst_video_format_to_string (format), in_size->width, in_size->height,
+      out_size->width, out_size->height, frames / elapsed, mbsec);
+
+  name = g_strdup_printf ("scale %s %dx%d %dx%d",
+      gst_video_format_to_string (format), in_size->width, in_size->height,
+      out_size->width, out_size->height);
+  bench_score (name, "MB/s", mbsec);
+  g_free (name);
+
+  gst_video_frame_unmap (&in_frame);
+  gst_video_frame_unmap (&out_frame);
+  gst_buffer_unref (in_buffer);
+  gst_buffer_unref (out_buffer);
+  gst_video_scaler_free (hscale);
+  gst_video_scaler_free (vscale);
+}
+
+int
+main (int argc, char **argv)
+{
+  guint i, j, s, t;
+
+  gst_init (&argc, &argv);
+  bench_begin ();
+
+  for (i = 0; i < G_N_ELEMENTS (bench_formats); i++) {
+    for (j = 0; j < G_N_ELEMENTS (bench_formats); j++) {
+      for (s = 0; s < G_N_ELEMENTS (bench_sizes); s++) {
+        for (t = 0; t < G_N_ELEMENTS (bench_threads); t++) {
+          run_convert (bench_formats[i], bench_formats[j], &bench_sizes[s],
+              bench_threads[t]);
+        }
+      }
+    }
+  }
+
+  for (s = 1; s < G_N_ELEMENTS (bench_sizes); s++) {
+    run_scale (GST_VIDEO_FORMAT_GRAY8, &bench_sizes[s], &bench_sizes[s - 1]);
+    run_scale (GST_VIDEO_FORMAT_YUY2, &bench_sizes[s], &bench_sizes[s - 1]);
+    run_scale (GST_VIDEO_FORMAT_NV12, &bench_sizes[s], &bench_sizes[s - 1]);
+    run_scale (GST_VIDEO_FORMAT_BGRA, &bench_sizes[s], &bench_sizes[s - 1]);
+  }
+
+  bench_end ();
+
+  return 0;
+}
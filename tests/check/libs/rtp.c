@@ -1353,6 +1353,76 @@ GST_START_TEST (test_rtp_buffer_empty_payload)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtp_buffer_parse_extensions)
+{
+  GstRTPBuffer rtp = { NULL };
+  GstRTPHeaderExtensionIndex idx;
+  const GstRTPHeaderExtensionEntry *entry;
+  GstBuffer *buf;
+  guint8 misc_data[4] = { 1, 2, 3, 4 };
+
+  /* one byte header extensions */
+  buf = gst_rtp_buffer_new_allocate (20, 0, 0);
+  gst_rtp_buffer_map (buf, GST_MAP_READWRITE, &rtp);
+
+  fail_unless (gst_rtp_buffer_parse_extensions (&rtp, &idx) == FALSE);
+  fail_unless (idx.n_entries == 0);
+
+  fail_unless (gst_rtp_buffer_add_extension_onebyte_header (&rtp, 5,
+          misc_data, 2) == TRUE);
+  fail_unless (gst_rtp_buffer_add_extension_onebyte_header (&rtp, 5,
+          misc_data, 4) == TRUE);
+  fail_unless (gst_rtp_buffer_add_extension_onebyte_header (&rtp, 6,
+          misc_data, 2) == TRUE);
+
+  fail_unless (gst_rtp_buffer_parse_extensions (&rtp, &idx) == TRUE);
+  fail_unless (idx.bits == 0xBEDE);
+  fail_unless (idx.n_entries == 3);
+
+  entry = gst_rtp_header_extension_index_get (&idx, 5, 0);
+  fail_unless (entry != NULL);
+  fail_unless (entry->size == 2);
+  fail_unless (memcmp (entry->data, misc_data, 2) == 0);
+  entry = gst_rtp_header_extension_index_get (&idx, 5, 1);
+  fail_unless (entry != NULL);
+  fail_unless (entry->size == 4);
+  fail_unless (memcmp (entry->data, misc_data, 4) == 0);
+  fail_unless (gst_rtp_header_extension_index_get (&idx, 5, 2) == NULL);
+  entry = gst_rtp_header_extension_index_get (&idx, 6, 0);
+  fail_unless (entry != NULL);
+  fail_unless (entry->size == 2);
+  fail_unless (gst_rtp_header_extension_index_get (&idx, 2, 0) == NULL);
+
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_unref (buf);
+
+  /* two bytes header extensions */
+  buf = gst_rtp_buffer_new_allocate (20, 0, 0);
+  gst_rtp_buffer_map (buf, GST_MAP_READWRITE, &rtp);
+
+  fail_unless (gst_rtp_buffer_add_extension_twobytes_header (&rtp, 0, 5,
+          misc_data, 2) == TRUE);
+  fail_unless (gst_rtp_buffer_add_extension_twobytes_header (&rtp, 0, 6,
+          misc_data, 4) == TRUE);
+
+  fail_unless (gst_rtp_buffer_parse_extensions (&rtp, &idx) == TRUE);
+  fail_unless (idx.n_entries == 2);
+
+  entry = gst_rtp_header_extension_index_get (&idx, 5, 0);
+  fail_unless (entry != NULL);
+  fail_unless (entry->size == 2);
+  fail_unless (memcmp (entry->data, misc_data, 2) == 0);
+  entry = gst_rtp_header_extension_index_get (&idx, 6, 0);
+  fail_unless (entry != NULL);
+  fail_unless (entry->size == 4);
+  fail_unless (memcmp (entry->data, misc_data, 4) == 0);
+
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_unref (buf);
+}
+
+GST_END_TEST;
+
 static Suite *
 rtp_suite (void)
 {
@@ -1385,6 +1455,7 @@ rtp_suite (void)
 
   tcase_add_test (tc_chain, test_rtp_buffer_get_payload_bytes);
   tcase_add_test (tc_chain, test_rtp_buffer_get_extension_bytes);
+  tcase_add_test (tc_chain, test_rtp_buffer_parse_extensions);
   tcase_add_test (tc_chain, test_rtp_buffer_empty_payload);
 
   //tcase_add_test (tc_chain, test_rtp_buffer_list);
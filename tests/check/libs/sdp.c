@@ -558,6 +558,32 @@ GST_START_TEST (caps_from_media_really_const)
   gst_sdp_message_free (message);
 }
 
+GST_END_TEST
+GST_START_TEST (parse_buffer_fast)
+{
+  GstSDPMessage *message, *message_fast;
+  glong length = -1;
+  gchar *serialized, *serialized_fast;
+
+  length = strlen (sdp);
+
+  /* the fast parser must produce the same message as the normal parser */
+  gst_sdp_message_new (&message);
+  gst_sdp_message_parse_buffer ((guint8 *) sdp, length, message);
+
+  gst_sdp_message_new (&message_fast);
+  gst_sdp_message_parse_buffer_fast ((guint8 *) sdp, length, message_fast);
+
+  serialized = gst_sdp_message_as_text (message);
+  serialized_fast = gst_sdp_message_as_text (message_fast);
+  fail_unless (g_strcmp0 (serialized, serialized_fast) == 0);
+  g_free (serialized);
+  g_free (serialized_fast);
+
+  gst_sdp_message_free (message);
+  gst_sdp_message_free (message_fast);
+}
+
 GST_END_TEST
 /*
  * End of test cases
@@ -579,6 +605,7 @@ sdp_suite (void)
   tcase_add_test (tc_chain, caps_from_media_rtcp_fb_all);
   tcase_add_test (tc_chain, media_from_caps_rtcp_fb_pt_100);
   tcase_add_test (tc_chain, media_from_caps_rtcp_fb_pt_101);
+  tcase_add_test (tc_chain, parse_buffer_fast);
 
   return s;
 }